@@ -0,0 +1,116 @@
+// Microbenchmark: number formatting in the runtime (see NUMBER FORMATTING in
+// src/runtime/core.c) against the sdscatprintf path it replaced.
+//
+//   gcc -O2 -I src/runtime -I deps bench/formatacao.c src/runtime/core.c deps/sds.c -ldl -lm -o formatacao
+//   ./formatacao [n]
+
+#include "basalto.h"
+#define STB_DS_IMPLEMENTATION
+#include "stb_ds.h"
+
+#include <time.h>
+
+static double agora(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+static unsigned long long estado = 88172645463325252ull;
+
+static unsigned long long aleatorio(void)
+{
+    estado ^= estado << 13;
+    estado ^= estado >> 7;
+    estado ^= estado << 17;
+    return estado;
+}
+
+static void relatar(const char *nome, double antes, double depois, long n, size_t bytes)
+{
+    printf("%-34s %8.1f ns/valor  (%zu bytes)\n", nome, (depois - antes) * 1e9 / n, bytes);
+}
+
+int main(int argc, char **argv)
+{
+    long n = argc > 1 ? atol(argv[1]) : 2000000;
+    long long *inteiros = malloc(n * sizeof(long long));
+    double *reais = malloc(n * sizeof(double));
+    for (long i = 0; i < n; i++)
+    {
+        // Mixed widths: small counters up to full 64-bit values
+        unsigned long long r = aleatorio();
+        inteiros[i] = (long long)(r >> (r & 63));
+        reais[i] = (double)(long long)(aleatorio() % 2000000000) / 1000.0 - 1e6;
+    }
+
+    // '${x}' on integers: one sds, n appends
+    double t0 = agora();
+    sds s = sdsempty();
+    for (long i = 0; i < n; i++)
+        s = sdscatprintf(s, "%lld", inteiros[i]);
+    double t1 = agora();
+    relatar("inteiro: sdscatprintf", t0, t1, n, sdslen(s));
+    sdsfree(s);
+
+    t0 = agora();
+    s = sdsempty();
+    for (long i = 0; i < n; i++)
+        s = bs_sds_anexar_inteiro(s, inteiros[i]);
+    t1 = agora();
+    relatar("inteiro: bs_sds_anexar_inteiro", t0, t1, n, sdslen(s));
+    sdsfree(s);
+
+    // '.texto()' on integers: one sds per value
+    t0 = agora();
+    size_t total = 0;
+    for (long i = 0; i < n; i++)
+    {
+        sds v = sdscatprintf(sdsempty(), "%lld", inteiros[i]);
+        total += sdslen(v);
+        sdsfree(v);
+    }
+    t1 = agora();
+    relatar("inteiro.texto(): sdscatprintf", t0, t1, n, total);
+
+    t0 = agora();
+    total = 0;
+    for (long i = 0; i < n; i++)
+    {
+        sds v = int64_to_string(inteiros[i]);
+        total += sdslen(v);
+        sdsfree(v);
+    }
+    t1 = agora();
+    relatar("inteiro.texto(): int64_to_string", t0, t1, n, total);
+
+    // '${x}' on reals
+    t0 = agora();
+    s = sdsempty();
+    for (long i = 0; i < n; i++)
+        s = sdscatprintf(s, "%f", reais[i]);
+    t1 = agora();
+    relatar("real: sdscatprintf", t0, t1, n, sdslen(s));
+    sds esperado = s;
+
+    t0 = agora();
+    s = sdsempty();
+    for (long i = 0; i < n; i++)
+        s = bs_sds_anexar_real(s, reais[i]);
+    t1 = agora();
+    relatar("real: bs_sds_anexar_real", t0, t1, n, sdslen(s));
+
+    // Both paths must produce the same text
+    if (sdscmp(s, esperado) != 0)
+    {
+        fprintf(stderr, "[Basalto] Erro: formatacao de real difere de printf.\n");
+        return 1;
+    }
+    sdsfree(s);
+    sdsfree(esperado);
+
+    free(inteiros);
+    free(reais);
+    return 0;
+}
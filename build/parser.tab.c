@@ -0,0 +1,3413 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison implementation for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* C LALR(1) parser skeleton written by Richard Stallman, by
+   simplifying the original so-called "semantic" parser.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+/* All symbols defined below should begin with yy or YY, to avoid
+   infringing on user name space.  This should be done even for local
+   variables, as they might otherwise be expanded by user macros.
+   There are some unavoidable exceptions within include files to
+   define necessary library symbols; they are noted "INFRINGES ON
+   USER NAME SPACE" below.  */
+
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
+
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
+
+/* Skeleton name.  */
+#define YYSKELETON_NAME "yacc.c"
+
+/* Pure parsers.  */
+#define YYPURE 0
+
+/* Push parsers.  */
+#define YYPUSH 0
+
+/* Pull parsers.  */
+#define YYPULL 1
+
+
+
+
+/* First part of user prologue.  */
+#line 1 "src/parser.y"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "ast.h"
+#include "symtable.h"
+
+extern int yylex();
+extern int yylineno;
+extern int yycol;
+extern FILE* yyin;
+
+void yyerror(const char *s);
+
+ASTNode* root_node = NULL;
+
+// Source of the "${...}" piece being parsed (for error messages), NULL for the file
+static const char* interp_piece = NULL;
+
+// Struct attributes (@soa, @compacto, @alinhado(64) ...) -> symbol table flags
+static void apply_struct_attrs(ASTNode* def, ASTNode* attrs) {
+    const char* struct_name = def->name;
+    for (int i = 0; i < arrlen(attrs->children); i++) {
+        ASTNode* attr_node = attrs->children[i];
+        const char* attr = attr_node->name;
+        int has_arg = arrlen(attr_node->children) > 0;
+        if (strcmp(attr, "alinhado") == 0) {
+            int n = has_arg ? attr_node->children[0]->int_value : 0;
+            if (!has_arg || n <= 0 || (n & (n - 1)) != 0) {
+                fprintf(stderr, "[Basalto] Erro: @alinhado(n) na estrutura '%s' exige uma potencia de 2.\n", struct_name);
+                exit(1);
+            }
+            def->int_value = n; // Minimum alignment in bytes
+            continue;
+        }
+        if (has_arg) {
+            fprintf(stderr, "[Basalto] Erro: atributo '@%s' nao recebe argumentos.\n", attr);
+            exit(1);
+        }
+        if (strcmp(attr, "soa") == 0) {
+            set_struct_flag(struct_name, STRUCT_FLAG_SOA);
+        } else if (strcmp(attr, "ordem_fixa") == 0) {
+            set_struct_flag(struct_name, STRUCT_FLAG_FIXED_ORDER);
+        } else if (strcmp(attr, "compacto") == 0) {
+            set_struct_flag(struct_name, STRUCT_FLAG_PACKED);
+        } else {
+            fprintf(stderr, "[Basalto] Erro: atributo desconhecido '@%s' na estrutura '%s'.\n", attr, struct_name);
+            exit(1);
+        }
+    }
+}
+
+#line 124 "build/parser.tab.c"
+
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
+
+#include "parser.tab.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_TOKEN_ID = 3,                   /* TOKEN_ID  */
+  YYSYMBOL_TOKEN_LIT_STRING = 4,           /* TOKEN_LIT_STRING  */
+  YYSYMBOL_TOKEN_LIT_INT = 5,              /* TOKEN_LIT_INT  */
+  YYSYMBOL_TOKEN_LIT_DOUBLE = 6,           /* TOKEN_LIT_DOUBLE  */
+  YYSYMBOL_TOKEN_LIT_FLOAT = 7,            /* TOKEN_LIT_FLOAT  */
+  YYSYMBOL_TOKEN_PROGRAMA = 8,             /* TOKEN_PROGRAMA  */
+  YYSYMBOL_TOKEN_BIBLIOTECA = 9,           /* TOKEN_BIBLIOTECA  */
+  YYSYMBOL_TOKEN_VAR = 10,                 /* TOKEN_VAR  */
+  YYSYMBOL_TOKEN_SE = 11,                  /* TOKEN_SE  */
+  YYSYMBOL_TOKEN_SENAO = 12,               /* TOKEN_SENAO  */
+  YYSYMBOL_TOKEN_EXTERNO = 13,             /* TOKEN_EXTERNO  */
+  YYSYMBOL_TOKEN_FUNCAO = 14,              /* TOKEN_FUNCAO  */
+  YYSYMBOL_TOKEN_SEMICOLON = 15,           /* TOKEN_SEMICOLON  */
+  YYSYMBOL_TOKEN_ENQUANTO = 16,            /* TOKEN_ENQUANTO  */
+  YYSYMBOL_TOKEN_CADA = 17,                /* TOKEN_CADA  */
+  YYSYMBOL_TOKEN_INFINITO = 18,            /* TOKEN_INFINITO  */
+  YYSYMBOL_TOKEN_PARAR = 19,               /* TOKEN_PARAR  */
+  YYSYMBOL_TOKEN_CONTINUAR = 20,           /* TOKEN_CONTINUAR  */
+  YYSYMBOL_TOKEN_DOTDOT = 21,              /* TOKEN_DOTDOT  */
+  YYSYMBOL_TOKEN_LER = 22,                 /* TOKEN_LER  */
+  YYSYMBOL_TOKEN_ESTRUTURA = 23,           /* TOKEN_ESTRUTURA  */
+  YYSYMBOL_TOKEN_ASSERT = 24,              /* TOKEN_ASSERT  */
+  YYSYMBOL_TOKEN_RETORNE = 25,             /* TOKEN_RETORNE  */
+  YYSYMBOL_TOKEN_NULL = 26,                /* TOKEN_NULL  */
+  YYSYMBOL_TOKEN_NEW = 27,                 /* TOKEN_NEW  */
+  YYSYMBOL_TOKEN_TRUE = 28,                /* TOKEN_TRUE  */
+  YYSYMBOL_TOKEN_FALSE = 29,               /* TOKEN_FALSE  */
+  YYSYMBOL_TOKEN_EMBED = 30,               /* TOKEN_EMBED  */
+  YYSYMBOL_TOKEN_INTERP = 31,              /* TOKEN_INTERP  */
+  YYSYMBOL_32_ = 32,                       /* '+'  */
+  YYSYMBOL_33_ = 33,                       /* '-'  */
+  YYSYMBOL_34_ = 34,                       /* '*'  */
+  YYSYMBOL_35_ = 35,                       /* '/'  */
+  YYSYMBOL_36_ = 36,                       /* '>'  */
+  YYSYMBOL_37_ = 37,                       /* '<'  */
+  YYSYMBOL_38_ = 38,                       /* '.'  */
+  YYSYMBOL_PROP_ACCESS = 39,               /* PROP_ACCESS  */
+  YYSYMBOL_METHOD_CALL = 40,               /* METHOD_CALL  */
+  YYSYMBOL_41_ = 41,                       /* '('  */
+  YYSYMBOL_42_ = 42,                       /* '{'  */
+  YYSYMBOL_43_ = 43,                       /* '}'  */
+  YYSYMBOL_44_ = 44,                       /* ')'  */
+  YYSYMBOL_45_ = 45,                       /* ':'  */
+  YYSYMBOL_46_ = 46,                       /* '='  */
+  YYSYMBOL_47_ = 47,                       /* ','  */
+  YYSYMBOL_48_ = 48,                       /* '@'  */
+  YYSYMBOL_49_ = 49,                       /* '['  */
+  YYSYMBOL_50_ = 50,                       /* ']'  */
+  YYSYMBOL_51_ = 51,                       /* '|'  */
+  YYSYMBOL_52_ = 52,                       /* '&'  */
+  YYSYMBOL_53_ = 53,                       /* '!'  */
+  YYSYMBOL_YYACCEPT = 54,                  /* $accept  */
+  YYSYMBOL_root = 55,                      /* root  */
+  YYSYMBOL_program = 56,                   /* program  */
+  YYSYMBOL_library = 57,                   /* library  */
+  YYSYMBOL_block = 58,                     /* block  */
+  YYSYMBOL_statements = 59,                /* statements  */
+  YYSYMBOL_statement = 60,                 /* statement  */
+  YYSYMBOL_var_decl = 61,                  /* var_decl  */
+  YYSYMBOL_struct_def = 62,                /* struct_def  */
+  YYSYMBOL_struct_attrs = 63,              /* struct_attrs  */
+  YYSYMBOL_field_list = 64,                /* field_list  */
+  YYSYMBOL_field_decl = 65,                /* field_decl  */
+  YYSYMBOL_type_def = 66,                  /* type_def  */
+  YYSYMBOL_assign_stmt = 67,               /* assign_stmt  */
+  YYSYMBOL_lvalue = 68,                    /* lvalue  */
+  YYSYMBOL_if_stmt = 69,                   /* if_stmt  */
+  YYSYMBOL_enquanto_stmt = 70,             /* enquanto_stmt  */
+  YYSYMBOL_expr = 71,                      /* expr  */
+  YYSYMBOL_logical_expr = 72,              /* logical_expr  */
+  YYSYMBOL_comparison_expr = 73,           /* comparison_expr  */
+  YYSYMBOL_term = 74,                      /* term  */
+  YYSYMBOL_factor = 75,                    /* factor  */
+  YYSYMBOL_cada_stmt = 76,                 /* cada_stmt  */
+  YYSYMBOL_infinito_stmt = 77,             /* infinito_stmt  */
+  YYSYMBOL_flow_stmt = 78,                 /* flow_stmt  */
+  YYSYMBOL_input_stmt = 79,                /* input_stmt  */
+  YYSYMBOL_assert_stmt = 80,               /* assert_stmt  */
+  YYSYMBOL_func_def = 81,                  /* func_def  */
+  YYSYMBOL_param_list = 82,                /* param_list  */
+  YYSYMBOL_param = 83,                     /* param  */
+  YYSYMBOL_return_stmt = 84,               /* return_stmt  */
+  YYSYMBOL_extern_block = 85,              /* extern_block  */
+  YYSYMBOL_extern_func_list = 86,          /* extern_func_list  */
+  YYSYMBOL_extern_func = 87,               /* extern_func  */
+  YYSYMBOL_opt_symbol_map = 88,            /* opt_symbol_map  */
+  YYSYMBOL_array_literal = 89,             /* array_literal  */
+  YYSYMBOL_expr_list = 90,                 /* expr_list  */
+  YYSYMBOL_arg_list = 91,                  /* arg_list  */
+  YYSYMBOL_prop_access = 92,               /* prop_access  */
+  YYSYMBOL_method_call = 93                /* method_call  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
+
+
+
+#ifdef short
+# undef short
+#endif
+
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
+
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
+#else
+typedef short yytype_uint8;
+#endif
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
+#else
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
+#endif
+
+#ifndef YYSIZE_T
+# ifdef __SIZE_TYPE__
+#  define YYSIZE_T __SIZE_TYPE__
+# elif defined size_t
+#  define YYSIZE_T size_t
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYSIZE_T size_t
+# else
+#  define YYSIZE_T unsigned
+# endif
+#endif
+
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int16 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
+
+#ifndef YY_
+# if defined YYENABLE_NLS && YYENABLE_NLS
+#  if ENABLE_NLS
+#   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
+#  endif
+# endif
+# ifndef YY_
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
+#endif
+
+/* Suppress unused-variable warnings by "using" E.  */
+#if ! defined lint || defined __GNUC__
+# define YY_USE(E) ((void) (E))
+#else
+# define YY_USE(E) /* empty */
+#endif
+
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
+#else
+# define YY_INITIAL_VALUE(Value) Value
+#endif
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if 1
+
+/* The parser invokes alloca or malloc; define the necessary symbols.  */
+
+# ifdef YYSTACK_USE_ALLOCA
+#  if YYSTACK_USE_ALLOCA
+#   ifdef __GNUC__
+#    define YYSTACK_ALLOC __builtin_alloca
+#   elif defined __BUILTIN_VA_ARG_INCR
+#    include <alloca.h> /* INFRINGES ON USER NAME SPACE */
+#   elif defined _AIX
+#    define YYSTACK_ALLOC __alloca
+#   elif defined _MSC_VER
+#    include <malloc.h> /* INFRINGES ON USER NAME SPACE */
+#    define alloca _alloca
+#   else
+#    define YYSTACK_ALLOC alloca
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
+#     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
+#     endif
+#    endif
+#   endif
+#  endif
+# endif
+
+# ifdef YYSTACK_ALLOC
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+    /* The OS might guarantee only one guard page at the bottom of the stack,
+       and a page size can be as small as 4096 bytes.  So we cannot safely
+       invoke alloca (N) if N exceeds 4096.  Use a slightly smaller number
+       to allow for a few compiler-allocated temporary stack slots.  */
+#   define YYSTACK_ALLOC_MAXIMUM 4032 /* reasonable circa 2006 */
+#  endif
+# else
+#  define YYSTACK_ALLOC YYMALLOC
+#  define YYSTACK_FREE YYFREE
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+#   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
+#  endif
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
+       && ! ((defined YYMALLOC || defined malloc) \
+             && (defined YYFREE || defined free)))
+#   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
+#   endif
+#  endif
+#  ifndef YYMALLOC
+#   define YYMALLOC malloc
+#   if ! defined malloc && ! defined EXIT_SUCCESS
+void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+#  ifndef YYFREE
+#   define YYFREE free
+#   if ! defined free && ! defined EXIT_SUCCESS
+void free (void *); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+# endif
+#endif /* 1 */
+
+#if (! defined yyoverflow \
+     && (! defined __cplusplus \
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+
+/* A type that is properly aligned for any stack member.  */
+union yyalloc
+{
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+};
+
+/* The size of the maximum gap between one aligned stack and the next.  */
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
+
+/* The size of an array large to enough to hold all stacks, each with
+   N elements.  */
+# define YYSTACK_BYTES(N) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
+      + YYSTACK_GAP_MAXIMUM)
+
+# define YYCOPY_NEEDED 1
+
+/* Relocate STACK from its old location to the new one.  The
+   local variables YYSIZE and YYSTACKSIZE give the old and new number of
+   elements in the stack, and YYPTR gives the new location of the
+   stack.  Advance YYPTR to a properly aligned location for the next
+   stack.  */
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
+
+#endif
+
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
+/* YYFINAL -- State number of the termination state.  */
+#define YYFINAL  30
+/* YYLAST -- Last index in YYTABLE.  */
+#define YYLAST   409
+
+/* YYNTOKENS -- Number of terminals.  */
+#define YYNTOKENS  54
+/* YYNNTS -- Number of nonterminals.  */
+#define YYNNTS  40
+/* YYNRULES -- Number of rules.  */
+#define YYNRULES  134
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  295
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   288
+
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
+{
+       0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,    53,     2,     2,     2,     2,    52,     2,
+      41,    44,    34,    32,    47,    33,    38,    35,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,    45,     2,
+      37,    46,    36,     2,    48,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,    49,     2,    50,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,    42,    51,    43,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
+       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
+      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
+      25,    26,    27,    28,    29,    30,    31,    39,    40
+};
+
+#if YYDEBUG
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
+{
+       0,    87,    87,    88,    89,    93,   101,   109,   113,   118,
+     123,   128,   133,   138,   143,   148,   153,   158,   163,   168,
+     173,   179,   180,   184,   185,   186,   187,   188,   189,   190,
+     191,   205,   211,   222,   232,   241,   255,   277,   284,   294,
+     298,   302,   306,   314,   318,   325,   334,   347,   357,   362,
+     372,   388,   392,   398,   405,   416,   427,   448,   475,   499,
+     505,   511,   517,   523,   529,   535,   541,   547,   553,   559,
+     565,   571,   577,   583,   589,   595,   599,   603,   607,   611,
+     615,   622,   630,   638,   647,   653,   660,   664,   668,   671,
+     675,   679,   684,   689,   695,   700,   711,   718,   728,   738,
+     748,   758,   766,   775,   782,   785,   791,   798,   809,   823,
+     827,   831,   835,   843,   851,   864,   868,   873,   892,   896,
+     900,   904,   911,   915,   922,   926,   930,   936,   945,   955,
+     964,   974,   987,   994,  1002
+};
+#endif
+
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if 1
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
+/* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
+   First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
+static const char *const yytname[] =
+{
+  "\"end of file\"", "error", "\"invalid token\"", "TOKEN_ID",
+  "TOKEN_LIT_STRING", "TOKEN_LIT_INT", "TOKEN_LIT_DOUBLE",
+  "TOKEN_LIT_FLOAT", "TOKEN_PROGRAMA", "TOKEN_BIBLIOTECA", "TOKEN_VAR",
+  "TOKEN_SE", "TOKEN_SENAO", "TOKEN_EXTERNO", "TOKEN_FUNCAO",
+  "TOKEN_SEMICOLON", "TOKEN_ENQUANTO", "TOKEN_CADA", "TOKEN_INFINITO",
+  "TOKEN_PARAR", "TOKEN_CONTINUAR", "TOKEN_DOTDOT", "TOKEN_LER",
+  "TOKEN_ESTRUTURA", "TOKEN_ASSERT", "TOKEN_RETORNE", "TOKEN_NULL",
+  "TOKEN_NEW", "TOKEN_TRUE", "TOKEN_FALSE", "TOKEN_EMBED", "TOKEN_INTERP",
+  "'+'", "'-'", "'*'", "'/'", "'>'", "'<'", "'.'", "PROP_ACCESS",
+  "METHOD_CALL", "'('", "'{'", "'}'", "')'", "':'", "'='", "','", "'@'",
+  "'['", "']'", "'|'", "'&'", "'!'", "$accept", "root", "program",
+  "library", "block", "statements", "statement", "var_decl", "struct_def",
+  "struct_attrs", "field_list", "field_decl", "type_def", "assign_stmt",
+  "lvalue", "if_stmt", "enquanto_stmt", "expr", "logical_expr",
+  "comparison_expr", "term", "factor", "cada_stmt", "infinito_stmt",
+  "flow_stmt", "input_stmt", "assert_stmt", "func_def", "param_list",
+  "param", "return_stmt", "extern_block", "extern_func_list",
+  "extern_func", "opt_symbol_map", "array_literal", "expr_list",
+  "arg_list", "prop_access", "method_call", YY_NULLPTR
+};
+
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
+{
+  return yytname[yysymbol];
+}
+#endif
+
+#define YYPACT_NINF (-180)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
+
+#define YYTABLE_NINF (-56)
+
+#define yytable_value_is_error(Yyn) \
+  0
+
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int16 yypact[] =
+{
+      56,    22,    26,   321,    10,  -180,  -180,    33,    33,   -17,
+    -180,  -180,  -180,  -180,    55,  -180,   111,  -180,  -180,   321,
+     321,     9,  -180,   148,   119,   181,    25,  -180,  -180,  -180,
+    -180,  -180,  -180,  -180,   117,   321,   321,    85,  -180,    25,
+      91,  -180,  -180,    32,    57,    96,   321,   321,    64,   112,
+     127,   132,   321,   321,   179,   321,   280,   143,  -180,    51,
+     -10,  -180,  -180,   321,  -180,   321,   321,   181,   181,   321,
+     181,   321,   181,   321,   321,    25,    25,   152,     6,    39,
+     198,   178,   222,   223,   186,   187,    33,   215,   216,   191,
+     194,   321,  -180,   224,  -180,   225,    37,  -180,   192,  -180,
+    -180,    45,  -180,  -180,  -180,   226,   227,   228,   229,   231,
+     232,   163,  -180,   321,   321,  -180,  -180,   119,   119,   181,
+     181,   181,   181,   311,   321,  -180,   234,   321,   321,   204,
+     321,   246,   210,   321,   249,  -180,  -180,  -180,   209,   321,
+     239,  -180,   252,   253,   321,   254,   321,  -180,    89,  -180,
+     -28,  -180,   130,   -25,    58,   136,     7,     3,    80,   217,
+     255,   135,    -4,   245,   218,  -180,     4,   221,  -180,   116,
+      12,  -180,   321,   321,  -180,  -180,   321,   321,  -180,   256,
+     233,   220,     3,   118,    33,  -180,   219,   150,  -180,    33,
+     360,   264,  -180,   266,   230,  -180,   268,   242,   151,   251,
+     161,   260,     3,    -6,   321,   321,   263,    41,     3,   235,
+     255,  -180,   105,    86,   244,   248,  -180,     2,   259,  -180,
+    -180,  -180,  -180,   113,   144,  -180,   162,  -180,    33,   274,
+    -180,  -180,  -180,     3,  -180,   321,   321,    33,   321,   296,
+       5,   250,  -180,  -180,  -180,     3,  -180,    -1,   262,  -180,
+     321,  -180,   237,    33,   298,   173,  -180,   276,  -180,  -180,
+       3,   272,   281,  -180,  -180,   286,   255,  -180,   321,    33,
+     321,    33,  -180,  -180,  -180,  -180,   166,   177,  -180,   288,
+    -180,   289,    33,   321,    33,     3,  -180,   291,  -180,   290,
+      33,   337,  -180,  -180,  -180
+};
+
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_uint8 yydefact[] =
+{
+       0,     0,     0,     0,     0,     2,     3,     0,     0,    79,
+      78,    75,    76,    77,     0,    90,     0,    91,    92,     0,
+       0,     0,     4,    59,    62,    71,    74,    88,    87,    86,
+       1,    20,     5,     6,     0,   126,     0,     0,    94,    93,
+       0,   120,   122,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,    39,   127,   124,     0,
+       0,    89,    96,     0,   121,     0,     0,    63,    64,     0,
+      65,     0,    66,     0,     0,    72,    73,   128,     0,    51,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     7,     0,    21,    15,     0,    23,     0,     9,
+      10,     0,    11,    12,    13,    14,    16,    17,    18,    19,
+      86,     0,    95,     0,     0,    84,   123,    60,    61,    67,
+      68,    69,    70,     0,     0,    85,     0,   126,     0,     0,
+       0,     0,     0,     0,     0,   103,   104,   105,     0,     0,
+       0,     8,     0,     0,     0,     0,     0,   129,     0,   125,
+       0,   132,     0,     0,   127,     0,     0,     0,     0,     0,
+     111,     0,     0,    89,     0,   113,     0,    37,    50,   128,
+       0,   130,   126,     0,    80,   133,   126,     0,    81,    95,
+      84,    43,     0,    34,     0,   116,     0,     0,   110,     0,
+       0,     0,   106,     0,     0,    41,     0,    85,     0,     0,
+       0,     0,     0,     0,     0,     0,    56,     0,     0,     0,
+       0,    58,    79,     0,     0,     0,    41,     0,     0,   131,
+      82,   134,    83,     0,     0,    44,     0,    31,     0,     0,
+     114,   115,   112,     0,   109,     0,     0,     0,     0,     0,
+       0,     0,    35,    40,    38,     0,    48,     0,     0,    33,
+       0,    57,     0,     0,     0,     0,   102,     0,   107,    36,
+       0,     0,     0,    47,    45,     0,   111,   108,     0,     0,
+       0,     0,    42,    49,    46,    32,     0,     0,    97,     0,
+     101,     0,     0,     0,     0,     0,    99,     0,    98,   119,
+       0,     0,   117,   100,   118
+};
+
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int16 yypgoto[] =
+{
+    -180,  -180,  -180,  -180,    -8,  -180,  -180,  -180,  -180,  -180,
+     126,  -180,  -179,  -180,  -180,  -180,  -180,    -2,    81,   158,
+      54,    20,  -180,  -180,  -180,  -180,  -180,  -180,    79,   141,
+    -180,  -180,  -180,  -180,  -180,  -180,  -180,  -125,  -180,   297
+};
+
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_int16 yydefgoto[] =
+{
+       0,     4,     5,     6,    32,    56,    93,    94,    95,    96,
+     217,   243,   183,    97,    98,    99,   100,    58,    23,    24,
+      25,    26,   102,   103,   104,   105,   106,   107,   187,   188,
+     108,   109,   207,   231,   292,    27,    43,    59,    28,    29
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int16 yytable[] =
+{
+      33,    22,   155,   203,   262,   241,   181,   194,   241,   224,
+      30,   114,     9,    10,    11,    12,    13,   173,    40,    42,
+     177,    34,   174,   223,    35,   178,     7,   124,   114,   232,
+       8,    14,    36,   124,    60,    15,    16,    17,    18,    39,
+     115,   190,    19,   191,   225,   242,   195,   198,   259,   263,
+      20,   200,   182,    78,   253,   229,   125,   180,    21,    41,
+     142,   116,   197,    54,     1,     2,   261,     9,    10,    11,
+      12,    13,    75,    76,    55,    31,   101,   126,   135,    63,
+     127,   272,    64,   145,   230,   143,    14,     3,   128,   140,
+      15,    16,    17,    18,   146,   112,    37,    19,   113,   111,
+      67,    68,    70,    72,   -54,    20,   289,   236,    65,   148,
+      69,   149,   150,    21,    38,     9,    10,    11,    12,    13,
+      57,   152,   153,   119,   184,   120,   156,   121,   122,    61,
+     237,    44,    45,   171,    14,    62,   172,   164,    15,    16,
+      17,    18,   168,    34,   170,    19,    35,   247,    66,   248,
+     235,    46,    47,    20,    36,    48,    49,   123,    71,   204,
+     245,    21,   -55,   246,   205,    50,     9,    10,    11,    12,
+      13,   199,    51,    73,   175,   201,   206,   176,    74,   189,
+     179,   211,    77,   113,   111,    14,    44,    45,   213,    15,
+      16,    17,    18,   123,   209,   219,    19,   210,   113,    44,
+      45,   129,   226,   227,    20,   221,   249,   147,   113,   250,
+     281,   158,    21,   210,   161,    52,    53,   269,   270,   130,
+     251,   282,   283,   117,   118,   131,   132,   133,   134,   256,
+     136,   137,   138,   254,   255,   139,   257,   154,   144,   141,
+     -25,   -24,   -28,   -26,   -27,   267,   -29,   -22,   265,   157,
+     159,   160,   162,   163,   165,   166,   167,   169,   186,   185,
+     192,   278,   196,   280,   208,   193,   277,   214,   279,   202,
+     215,   -30,   216,   218,   286,   228,   288,   252,   266,   -52,
+     233,   287,   293,    79,    10,    11,    12,    13,   -53,   238,
+      80,    81,   239,    82,    83,   260,    84,    85,    86,    87,
+      88,   220,    89,   244,    90,    91,    15,    16,    17,    18,
+     222,   258,   264,    19,     9,    10,    11,    12,    13,   268,
+     271,    20,   273,    92,     9,    10,    11,    12,    13,    21,
+     275,   274,   284,    14,   285,   290,   291,    15,    16,    17,
+      18,   294,   240,    14,    19,   276,     0,    15,    16,    17,
+      18,   234,    20,   110,    19,   151,     0,     0,     0,     0,
+      21,     0,    20,   212,    10,    11,    12,    13,     0,     0,
+      21,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,    14,     0,     0,     0,    15,    16,    17,    18,
+       0,     0,     0,    19,     0,     0,     0,     0,     0,     0,
+       0,    20,     0,     0,     0,     0,     0,     0,     0,    21
+};
+
+static const yytype_int16 yycheck[] =
+{
+       8,     3,   127,   182,     5,     3,     3,     3,     3,    15,
+       0,    21,     3,     4,     5,     6,     7,    45,    20,    21,
+      45,    38,    50,   202,    41,    50,     4,    21,    21,   208,
+       4,    22,    49,    21,    36,    26,    27,    28,    29,    19,
+      50,    45,    33,    47,    50,    43,    42,   172,    43,    50,
+      41,   176,    49,    55,   233,    14,    50,    50,    49,    50,
+      23,    63,    50,    38,     8,     9,   245,     3,     4,     5,
+       6,     7,    52,    53,    49,    42,    56,    38,    86,    47,
+      41,   260,    50,    38,    43,    48,    22,    31,    49,    91,
+      26,    27,    28,    29,    49,    44,    41,    33,    47,    41,
+      46,    47,    48,    49,    46,    41,   285,    21,    51,   111,
+      46,   113,   114,    49,     3,     3,     4,     5,     6,     7,
+       3,   123,   124,    69,    44,    71,   128,    73,    74,    44,
+      44,    51,    52,    44,    22,    44,    47,   139,    26,    27,
+      28,    29,   144,    38,   146,    33,    41,     3,    52,     5,
+      45,    32,    33,    41,    49,    36,    37,    41,    46,    41,
+      47,    49,    46,    50,    46,    46,     3,     4,     5,     6,
+       7,   173,    53,    46,    44,   177,   184,    47,    46,    44,
+      44,   189,     3,    47,    41,    22,    51,    52,   190,    26,
+      27,    28,    29,    41,    44,    44,    33,    47,    47,    51,
+      52,     3,   204,   205,    41,    44,    44,    44,    47,    47,
+      44,   130,    49,    47,   133,    34,    35,    44,    45,    41,
+     228,    44,    45,    65,    66,     3,     3,    41,    41,   237,
+      15,    15,    41,   235,   236,    41,   238,     3,    46,    15,
+      15,    15,    15,    15,    15,   253,    15,    15,   250,    45,
+       4,    41,     3,    44,    15,     3,     3,     3,     3,    42,
+      15,   269,    41,   271,    45,    47,   268,     3,   270,    49,
+       4,    15,    42,     5,   282,    12,   284,     3,    41,    46,
+      45,   283,   290,     3,     4,     5,     6,     7,    46,    45,
+      10,    11,    44,    13,    14,    45,    16,    17,    18,    19,
+      20,    50,    22,    44,    24,    25,    26,    27,    28,    29,
+      50,    15,    50,    33,     3,     4,     5,     6,     7,    21,
+      44,    41,    50,    43,     3,     4,     5,     6,     7,    49,
+      44,    50,    44,    22,    45,    44,    46,    26,    27,    28,
+      29,     4,   216,    22,    33,   266,    -1,    26,    27,    28,
+      29,   210,    41,    56,    33,    44,    -1,    -1,    -1,    -1,
+      49,    -1,    41,     3,     4,     5,     6,     7,    -1,    -1,
+      49,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    22,    -1,    -1,    -1,    26,    27,    28,    29,
+      -1,    -1,    -1,    33,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    41,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    49
+};
+
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
+{
+       0,     8,     9,    31,    55,    56,    57,     4,     4,     3,
+       4,     5,     6,     7,    22,    26,    27,    28,    29,    33,
+      41,    49,    71,    72,    73,    74,    75,    89,    92,    93,
+       0,    42,    58,    58,    38,    41,    49,    41,     3,    75,
+      71,    50,    71,    90,    51,    52,    32,    33,    36,    37,
+      46,    53,    34,    35,    38,    49,    59,     3,    71,    91,
+      71,    44,    44,    47,    50,    51,    52,    74,    74,    46,
+      74,    46,    74,    46,    46,    75,    75,     3,    71,     3,
+      10,    11,    13,    14,    16,    17,    18,    19,    20,    22,
+      24,    25,    43,    60,    61,    62,    63,    67,    68,    69,
+      70,    75,    76,    77,    78,    79,    80,    81,    84,    85,
+      93,    41,    44,    47,    21,    50,    71,    73,    73,    74,
+      74,    74,    74,    41,    21,    50,    38,    41,    49,     3,
+      41,     3,     3,    41,    41,    58,    15,    15,    41,    41,
+      71,    15,    23,    48,    46,    38,    49,    44,    71,    71,
+      71,    44,    71,    71,     3,    91,    71,    45,    72,     4,
+      41,    72,     3,    44,    71,    15,     3,     3,    71,     3,
+      71,    44,    47,    45,    50,    44,    47,    45,    50,    44,
+      50,     3,    49,    66,    44,    42,     3,    82,    83,    44,
+      45,    47,    15,    47,     3,    42,    41,    50,    91,    71,
+      91,    71,    49,    66,    41,    46,    58,    86,    45,    44,
+      47,    58,     3,    71,     3,     4,    42,    64,     5,    44,
+      50,    44,    50,    66,    15,    50,    71,    71,    12,    14,
+      43,    87,    66,    45,    83,    45,    21,    44,    45,    44,
+      64,     3,    43,    65,    44,    47,    50,     3,     5,    44,
+      47,    58,     3,    66,    71,    71,    58,    71,    15,    43,
+      45,    66,     5,    50,    50,    71,    41,    58,    21,    44,
+      45,    44,    66,    50,    50,    44,    82,    71,    58,    71,
+      58,    44,    44,    45,    44,    45,    58,    71,    58,    66,
+      44,    46,    88,    58,     4
+};
+
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
+{
+       0,    54,    55,    55,    55,    56,    57,    58,    59,    59,
+      59,    59,    59,    59,    59,    59,    59,    59,    59,    59,
+      59,    60,    60,    60,    60,    60,    60,    60,    60,    60,
+      60,    61,    61,    61,    61,    62,    62,    63,    63,    63,
+      64,    64,    65,    66,    66,    66,    66,    66,    66,    66,
+      67,    68,    68,    68,    68,    68,    69,    69,    70,    71,
+      72,    72,    72,    73,    73,    73,    73,    73,    73,    73,
+      73,    73,    74,    74,    74,    75,    75,    75,    75,    75,
+      75,    75,    75,    75,    75,    75,    75,    75,    75,    75,
+      75,    75,    75,    75,    75,    75,    75,    76,    76,    76,
+      76,    76,    76,    77,    78,    78,    79,    80,    81,    82,
+      82,    82,    83,    84,    85,    86,    86,    87,    88,    88,
+      89,    89,    90,    90,    91,    91,    91,    92,    92,    93,
+      93,    93,    93,    93,    93
+};
+
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     1,     1,     2,     3,     3,     3,     3,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       0,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       4,     6,     9,     7,     4,     6,     7,     3,     6,     0,
+       2,     0,     3,     1,     3,     5,     6,     5,     4,     6,
+       3,     1,     4,     4,     3,     3,     5,     7,     5,     1,
+       4,     4,     1,     3,     3,     3,     3,     4,     4,     4,
+       4,     1,     3,     3,     1,     1,     1,     1,     1,     1,
+       6,     6,     8,     8,     4,     4,     1,     1,     1,     3,
+       1,     1,     1,     2,     2,     4,     3,     9,    11,    11,
+      13,     9,     7,     2,     2,     2,     4,     7,     8,     3,
+       1,     0,     3,     3,     6,     2,     0,     8,     2,     0,
+       2,     3,     1,     3,     1,     3,     0,     3,     3,     5,
+       6,     8,     5,     6,     8
+};
+
+
+enum { YYENOMEM = -2 };
+
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
+
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
+
+
+#define YYRECOVERING()  (!!yyerrstatus)
+
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
+
+
+/* Enable debugging if requested.  */
+#if YYDEBUG
+
+# ifndef YYFPRINTF
+#  include <stdio.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYFPRINTF fprintf
+# endif
+
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
+static void
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
+{
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  if (!yyvaluep)
+    return;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
+
+static void
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
+{
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
+
+  yy_symbol_value_print (yyo, yykind, yyvaluep);
+  YYFPRINTF (yyo, ")");
+}
+
+/*------------------------------------------------------------------.
+| yy_stack_print -- Print the state stack from its BOTTOM up to its |
+| TOP (included).                                                   |
+`------------------------------------------------------------------*/
+
+static void
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
+{
+  YYFPRINTF (stderr, "Stack now");
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
+  YYFPRINTF (stderr, "\n");
+}
+
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
+
+
+/*------------------------------------------------.
+| Report that the YYRULE is going to be reduced.  |
+`------------------------------------------------*/
+
+static void
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule)
+{
+  int yylno = yyrline[yyrule];
+  int yynrhs = yyr2[yyrule];
+  int yyi;
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
+  /* The symbols being reduced.  */
+  for (yyi = 0; yyi < yynrhs; yyi++)
+    {
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)]);
+      YYFPRINTF (stderr, "\n");
+    }
+}
+
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule); \
+} while (0)
+
+/* Nonzero means print parse trace.  It is left uninitialized so that
+   multiple parsers can coexist.  */
+int yydebug;
+#else /* !YYDEBUG */
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
+# define YY_STACK_PRINT(Bottom, Top)
+# define YY_REDUCE_PRINT(Rule)
+#endif /* !YYDEBUG */
+
+
+/* YYINITDEPTH -- initial size of the parser's stacks.  */
+#ifndef YYINITDEPTH
+# define YYINITDEPTH 200
+#endif
+
+/* YYMAXDEPTH -- maximum size the stacks can grow to (effective only
+   if the built-in stack extension method is used).
+
+   Do not make this value too large; the results are undefined if
+   YYSTACK_ALLOC_MAXIMUM < YYSTACK_BYTES (YYMAXDEPTH)
+   evaluated with infinite-precision integer arithmetic.  */
+
+#ifndef YYMAXDEPTH
+# define YYMAXDEPTH 10000
+#endif
+
+
+/* Context of a parse error.  */
+typedef struct
+{
+  yy_state_t *yyssp;
+  yysymbol_kind_t yytoken;
+} yypcontext_t;
+
+/* Put in YYARG at most YYARGN of the expected tokens given the
+   current YYCTX, and return the number of tokens stored in YYARG.  If
+   YYARG is null, return the number of expected tokens (guaranteed to
+   be less than YYNTOKENS).  Return YYENOMEM on memory exhaustion.
+   Return 0 if there are more than YYARGN expected tokens, yet fill
+   YYARG up to YYARGN. */
+static int
+yypcontext_expected_tokens (const yypcontext_t *yyctx,
+                            yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  int yyn = yypact[+*yyctx->yyssp];
+  if (!yypact_value_is_default (yyn))
+    {
+      /* Start YYX at -YYN if negative to avoid negative indexes in
+         YYCHECK.  In other words, skip the first -YYN actions for
+         this state because they are default actions.  */
+      int yyxbegin = yyn < 0 ? -yyn : 0;
+      /* Stay within bounds of both yycheck and yytname.  */
+      int yychecklim = YYLAST - yyn + 1;
+      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
+      int yyx;
+      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
+        if (yycheck[yyx + yyn] == yyx && yyx != YYSYMBOL_YYerror
+            && !yytable_value_is_error (yytable[yyx + yyn]))
+          {
+            if (!yyarg)
+              ++yycount;
+            else if (yycount == yyargn)
+              return 0;
+            else
+              yyarg[yycount++] = YY_CAST (yysymbol_kind_t, yyx);
+          }
+    }
+  if (yyarg && yycount == 0 && 0 < yyargn)
+    yyarg[0] = YYSYMBOL_YYEMPTY;
+  return yycount;
+}
+
+
+
+
+#ifndef yystrlen
+# if defined __GLIBC__ && defined _STRING_H
+#  define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
+# else
+/* Return the length of YYSTR.  */
+static YYPTRDIFF_T
+yystrlen (const char *yystr)
+{
+  YYPTRDIFF_T yylen;
+  for (yylen = 0; yystr[yylen]; yylen++)
+    continue;
+  return yylen;
+}
+# endif
+#endif
+
+#ifndef yystpcpy
+# if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
+#  define yystpcpy stpcpy
+# else
+/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
+   YYDEST.  */
+static char *
+yystpcpy (char *yydest, const char *yysrc)
+{
+  char *yyd = yydest;
+  const char *yys = yysrc;
+
+  while ((*yyd++ = *yys++) != '\0')
+    continue;
+
+  return yyd - 1;
+}
+# endif
+#endif
+
+#ifndef yytnamerr
+/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
+   quotes and backslashes, so that it's suitable for yyerror.  The
+   heuristic is that double-quoting is unnecessary unless the string
+   contains an apostrophe, a comma, or backslash (other than
+   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
+   null, do not copy; instead, return the length of what the result
+   would have been.  */
+static YYPTRDIFF_T
+yytnamerr (char *yyres, const char *yystr)
+{
+  if (*yystr == '"')
+    {
+      YYPTRDIFF_T yyn = 0;
+      char const *yyp = yystr;
+      for (;;)
+        switch (*++yyp)
+          {
+          case '\'':
+          case ',':
+            goto do_not_strip_quotes;
+
+          case '\\':
+            if (*++yyp != '\\')
+              goto do_not_strip_quotes;
+            else
+              goto append;
+
+          append:
+          default:
+            if (yyres)
+              yyres[yyn] = *yyp;
+            yyn++;
+            break;
+
+          case '"':
+            if (yyres)
+              yyres[yyn] = '\0';
+            return yyn;
+          }
+    do_not_strip_quotes: ;
+    }
+
+  if (yyres)
+    return yystpcpy (yyres, yystr) - yyres;
+  else
+    return yystrlen (yystr);
+}
+#endif
+
+
+static int
+yy_syntax_error_arguments (const yypcontext_t *yyctx,
+                           yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  /* There are many possibilities here to consider:
+     - If this state is a consistent state with a default action, then
+       the only way this function was invoked is if the default action
+       is an error action.  In that case, don't check for expected
+       tokens because there are none.
+     - The only way there can be no lookahead present (in yychar) is if
+       this state is a consistent state with a default action.  Thus,
+       detecting the absence of a lookahead is sufficient to determine
+       that there is no unexpected or expected token to report.  In that
+       case, just report a simple "syntax error".
+     - Don't assume there isn't a lookahead just because this state is a
+       consistent state with a default action.  There might have been a
+       previous inconsistent state, consistent state with a non-default
+       action, or user semantic action that manipulated yychar.
+     - Of course, the expected token list depends on states to have
+       correct lookahead information, and it depends on the parser not
+       to perform extra reductions after fetching a lookahead from the
+       scanner and before detecting a syntax error.  Thus, state merging
+       (from LALR or IELR) and default reductions corrupt the expected
+       token list.  However, the list is correct for canonical LR with
+       one exception: it will still contain any token that will not be
+       accepted due to an error action in a later state.
+  */
+  if (yyctx->yytoken != YYSYMBOL_YYEMPTY)
+    {
+      int yyn;
+      if (yyarg)
+        yyarg[yycount] = yyctx->yytoken;
+      ++yycount;
+      yyn = yypcontext_expected_tokens (yyctx,
+                                        yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+      if (yyn == YYENOMEM)
+        return YYENOMEM;
+      else
+        yycount += yyn;
+    }
+  return yycount;
+}
+
+/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
+   about the unexpected token YYTOKEN for the state stack whose top is
+   YYSSP.
+
+   Return 0 if *YYMSG was successfully written.  Return -1 if *YYMSG is
+   not large enough to hold the message.  In that case, also set
+   *YYMSG_ALLOC to the required number of bytes.  Return YYENOMEM if the
+   required number of bytes is too large to store.  */
+static int
+yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
+                const yypcontext_t *yyctx)
+{
+  enum { YYARGS_MAX = 5 };
+  /* Internationalized format string. */
+  const char *yyformat = YY_NULLPTR;
+  /* Arguments of yyformat: reported tokens (one for the "unexpected",
+     one per "expected"). */
+  yysymbol_kind_t yyarg[YYARGS_MAX];
+  /* Cumulated lengths of YYARG.  */
+  YYPTRDIFF_T yysize = 0;
+
+  /* Actual size of YYARG. */
+  int yycount = yy_syntax_error_arguments (yyctx, yyarg, YYARGS_MAX);
+  if (yycount == YYENOMEM)
+    return YYENOMEM;
+
+  switch (yycount)
+    {
+#define YYCASE_(N, S)                       \
+      case N:                               \
+        yyformat = S;                       \
+        break
+    default: /* Avoid compiler warnings. */
+      YYCASE_(0, YY_("syntax error"));
+      YYCASE_(1, YY_("syntax error, unexpected %s"));
+      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
+      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
+      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
+      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
+#undef YYCASE_
+    }
+
+  /* Compute error message size.  Don't count the "%s"s, but reserve
+     room for the terminator.  */
+  yysize = yystrlen (yyformat) - 2 * yycount + 1;
+  {
+    int yyi;
+    for (yyi = 0; yyi < yycount; ++yyi)
+      {
+        YYPTRDIFF_T yysize1
+          = yysize + yytnamerr (YY_NULLPTR, yytname[yyarg[yyi]]);
+        if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
+          yysize = yysize1;
+        else
+          return YYENOMEM;
+      }
+  }
+
+  if (*yymsg_alloc < yysize)
+    {
+      *yymsg_alloc = 2 * yysize;
+      if (! (yysize <= *yymsg_alloc
+             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
+        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
+      return -1;
+    }
+
+  /* Avoid sprintf, as that infringes on the user's name space.
+     Don't have undefined behavior even if the translation
+     produced a string with the wrong number of "%s"s.  */
+  {
+    char *yyp = *yymsg;
+    int yyi = 0;
+    while ((*yyp = *yyformat) != '\0')
+      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
+        {
+          yyp += yytnamerr (yyp, yytname[yyarg[yyi++]]);
+          yyformat += 2;
+        }
+      else
+        {
+          ++yyp;
+          ++yyformat;
+        }
+  }
+  return 0;
+}
+
+
+/*-----------------------------------------------.
+| Release the memory associated to this symbol.  |
+`-----------------------------------------------*/
+
+static void
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep)
+{
+  YY_USE (yyvaluep);
+  if (!yymsg)
+    yymsg = "Deleting";
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/* Lookahead token kind.  */
+int yychar;
+
+/* The semantic value of the lookahead symbol.  */
+YYSTYPE yylval;
+/* Number of syntax errors so far.  */
+int yynerrs;
+
+
+
+
+/*----------.
+| yyparse.  |
+`----------*/
+
+int
+yyparse (void)
+{
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
+
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
+
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
+
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
+
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
+  /* The variables used to return semantic value and location from the
+     action routines.  */
+  YYSTYPE yyval;
+
+  /* Buffer for error messages, and its allocated size.  */
+  char yymsgbuf[128];
+  char *yymsg = yymsgbuf;
+  YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
+
+  /* The number of symbols on the RHS of the reduced rule.
+     Keep to zero when no symbol should be popped.  */
+  int yylen = 0;
+
+  YYDPRINTF ((stderr, "Starting parse\n"));
+
+  yychar = YYEMPTY; /* Cause a token to be read.  */
+
+  goto yysetstate;
+
+
+/*------------------------------------------------------------.
+| yynewstate -- push a new state, which is found in yystate.  |
+`------------------------------------------------------------*/
+yynewstate:
+  /* In all cases, when you get here, the value and location stacks
+     have just been pushed.  So pushing a state here evens the stacks.  */
+  yyssp++;
+
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
+
+  if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
+    {
+      /* Get the current used size of the three stacks, in elements.  */
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
+
+# if defined yyoverflow
+      {
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
+      }
+# else /* defined YYSTACK_RELOCATE */
+      /* Extend the stack our own way.  */
+      if (YYMAXDEPTH <= yystacksize)
+        YYNOMEM;
+      yystacksize *= 2;
+      if (YYMAXDEPTH < yystacksize)
+        yystacksize = YYMAXDEPTH;
+
+      {
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+#  undef YYSTACK_RELOCATE
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
+      }
+# endif
+
+      yyssp = yyss + yysize - 1;
+      yyvsp = yyvs + yysize - 1;
+
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
+
+      if (yyss + yystacksize - 1 <= yyssp)
+        YYABORT;
+    }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
+
+
+  if (yystate == YYFINAL)
+    YYACCEPT;
+
+  goto yybackup;
+
+
+/*-----------.
+| yybackup.  |
+`-----------*/
+yybackup:
+  /* Do appropriate processing given the current state.  Read a
+     lookahead token if we need one and don't already have one.  */
+
+  /* First try to decide what to do without reference to lookahead token.  */
+  yyn = yypact[yystate];
+  if (yypact_value_is_default (yyn))
+    goto yydefault;
+
+  /* Not known => get a lookahead token if don't already have one.  */
+
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
+  if (yychar == YYEMPTY)
+    {
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex ();
+    }
+
+  if (yychar <= YYEOF)
+    {
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
+      YYDPRINTF ((stderr, "Now at end of input.\n"));
+    }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
+  else
+    {
+      yytoken = YYTRANSLATE (yychar);
+      YY_SYMBOL_PRINT ("Next token is", yytoken, &yylval, &yylloc);
+    }
+
+  /* If the proper action on seeing token YYTOKEN is to reduce or to
+     detect an error, take that action.  */
+  yyn += yytoken;
+  if (yyn < 0 || YYLAST < yyn || yycheck[yyn] != yytoken)
+    goto yydefault;
+  yyn = yytable[yyn];
+  if (yyn <= 0)
+    {
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
+      yyn = -yyn;
+      goto yyreduce;
+    }
+
+  /* Count tokens shifted since error; after three, turn off error
+     status.  */
+  if (yyerrstatus)
+    yyerrstatus--;
+
+  /* Shift the lookahead token.  */
+  YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
+  yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
+  goto yynewstate;
+
+
+/*-----------------------------------------------------------.
+| yydefault -- do the default action for the current state.  |
+`-----------------------------------------------------------*/
+yydefault:
+  yyn = yydefact[yystate];
+  if (yyn == 0)
+    goto yyerrlab;
+  goto yyreduce;
+
+
+/*-----------------------------.
+| yyreduce -- do a reduction.  |
+`-----------------------------*/
+yyreduce:
+  /* yyn is the number of a rule to reduce with.  */
+  yylen = yyr2[yyn];
+
+  /* If YYLEN is nonzero, implement the default value of the action:
+     '$$ = $1'.
+
+     Otherwise, the following line sets YYVAL to garbage.
+     This behavior is undocumented and Bison
+     users should not rely upon it.  Assigning to YYVAL
+     unconditionally makes the parser a bit smaller, and it avoids a
+     GCC warning that YYVAL may be used uninitialized.  */
+  yyval = yyvsp[1-yylen];
+
+
+  YY_REDUCE_PRINT (yyn);
+  switch (yyn)
+    {
+  case 2: /* root: program  */
+#line 87 "src/parser.y"
+            { root_node = (yyvsp[0].node); }
+#line 1692 "build/parser.tab.c"
+    break;
+
+  case 3: /* root: library  */
+#line 88 "src/parser.y"
+              { root_node = (yyvsp[0].node); }
+#line 1698 "build/parser.tab.c"
+    break;
+
+  case 4: /* root: TOKEN_INTERP expr  */
+#line 89 "src/parser.y"
+                        { root_node = (yyvsp[0].node); }
+#line 1704 "build/parser.tab.c"
+    break;
+
+  case 5: /* program: TOKEN_PROGRAMA TOKEN_LIT_STRING block  */
+#line 93 "src/parser.y"
+                                          {
+        (yyval.node) = ast_new(NODE_PROGRAM);
+        (yyval.node)->name = sdsnew((yyvsp[-1].str));
+        ast_add_child((yyval.node), (yyvsp[0].node));
+    }
+#line 1714 "build/parser.tab.c"
+    break;
+
+  case 6: /* library: TOKEN_BIBLIOTECA TOKEN_LIT_STRING block  */
+#line 101 "src/parser.y"
+                                            {
+        (yyval.node) = ast_new(NODE_LIBRARY);
+        (yyval.node)->name = sdsnew((yyvsp[-1].str));
+        ast_add_child((yyval.node), (yyvsp[0].node));
+    }
+#line 1724 "build/parser.tab.c"
+    break;
+
+  case 7: /* block: '{' statements '}'  */
+#line 109 "src/parser.y"
+                       { (yyval.node) = (yyvsp[-1].node); }
+#line 1730 "build/parser.tab.c"
+    break;
+
+  case 8: /* statements: statements statement TOKEN_SEMICOLON  */
+#line 113 "src/parser.y"
+                                         {
+        /* Require semicolon after statements (var_decl, function calls) */
+        (yyval.node) = (yyvsp[-2].node);
+        ast_add_child((yyval.node), (yyvsp[-1].node));
+    }
+#line 1740 "build/parser.tab.c"
+    break;
+
+  case 9: /* statements: statements if_stmt  */
+#line 118 "src/parser.y"
+                         {
+        /* Control flow statements (if) don't need semicolons */
+        (yyval.node) = (yyvsp[-1].node);
+        ast_add_child((yyval.node), (yyvsp[0].node));
+    }
+#line 1750 "build/parser.tab.c"
+    break;
+
+  case 10: /* statements: statements enquanto_stmt  */
+#line 123 "src/parser.y"
+                               {
+        /* While loop statements don't need semicolons */
+        (yyval.node) = (yyvsp[-1].node);
+        ast_add_child((yyval.node), (yyvsp[0].node));
+    }
+#line 1760 "build/parser.tab.c"
+    break;
+
+  case 11: /* statements: statements cada_stmt  */
+#line 128 "src/parser.y"
+                           {
+        /* Loop statements don't need semicolons */
+        (yyval.node) = (yyvsp[-1].node);
+        ast_add_child((yyval.node), (yyvsp[0].node));
+    }
+#line 1770 "build/parser.tab.c"
+    break;
+
+  case 12: /* statements: statements infinito_stmt  */
+#line 133 "src/parser.y"
+                               {
+        /* Infinite loop statements don't need semicolons */
+        (yyval.node) = (yyvsp[-1].node);
+        ast_add_child((yyval.node), (yyvsp[0].node));
+    }
+#line 1780 "build/parser.tab.c"
+    break;
+
+  case 13: /* statements: statements flow_stmt  */
+#line 138 "src/parser.y"
+                           {
+        /* Flow control statements (break/continue) need semicolons */
+        (yyval.node) = (yyvsp[-1].node);
+        ast_add_child((yyval.node), (yyvsp[0].node));
+    }
+#line 1790 "build/parser.tab.c"
+    break;
+
+  case 14: /* statements: statements input_stmt  */
+#line 143 "src/parser.y"
+                            {
+        /* Input statements need semicolons */
+        (yyval.node) = (yyvsp[-1].node);
+        ast_add_child((yyval.node), (yyvsp[0].node));
+    }
+#line 1800 "build/parser.tab.c"
+    break;
+
+  case 15: /* statements: statements struct_def  */
+#line 148 "src/parser.y"
+                            {
+        /* Struct definitions don't need semicolons */
+        (yyval.node) = (yyvsp[-1].node);
+        ast_add_child((yyval.node), (yyvsp[0].node));
+    }
+#line 1810 "build/parser.tab.c"
+    break;
+
+  case 16: /* statements: statements assert_stmt  */
+#line 153 "src/parser.y"
+                             {
+        /* Assert statements need semicolons */
+        (yyval.node) = (yyvsp[-1].node);
+        ast_add_child((yyval.node), (yyvsp[0].node));
+    }
+#line 1820 "build/parser.tab.c"
+    break;
+
+  case 17: /* statements: statements func_def  */
+#line 158 "src/parser.y"
+                          {
+        /* Function definitions don't need semicolons */
+        (yyval.node) = (yyvsp[-1].node);
+        ast_add_child((yyval.node), (yyvsp[0].node));
+    }
+#line 1830 "build/parser.tab.c"
+    break;
+
+  case 18: /* statements: statements return_stmt  */
+#line 163 "src/parser.y"
+                             {
+        /* Return statements need semicolons */
+        (yyval.node) = (yyvsp[-1].node);
+        ast_add_child((yyval.node), (yyvsp[0].node));
+    }
+#line 1840 "build/parser.tab.c"
+    break;
+
+  case 19: /* statements: statements extern_block  */
+#line 168 "src/parser.y"
+                              {
+        /* Extern blocks don't need semicolons */
+        (yyval.node) = (yyvsp[-1].node);
+        ast_add_child((yyval.node), (yyvsp[0].node));
+    }
+#line 1850 "build/parser.tab.c"
+    break;
+
+  case 20: /* statements: %empty  */
+#line 173 "src/parser.y"
+                  {
+        (yyval.node) = ast_new(NODE_BLOCK);
+    }
+#line 1858 "build/parser.tab.c"
+    break;
+
+  case 22: /* statement: method_call  */
+#line 180 "src/parser.y"
+                  {
+        /* Method call as statement: arr.push(x); - must come before assign_stmt */
+        (yyval.node) = (yyvsp[0].node);
+    }
+#line 1867 "build/parser.tab.c"
+    break;
+
+  case 30: /* statement: TOKEN_ID '(' arg_list ')'  */
+#line 191 "src/parser.y"
+                                {
+         /* Function Call with arguments */
+         (yyval.node) = ast_new(NODE_FUNC_CALL);
+         (yyval.node)->name = sdsnew((yyvsp[-3].str));
+         // Add all arguments as children
+         if ((yyvsp[-1].node) && arrlen((yyvsp[-1].node)->children) > 0) {
+             for(int i=0; i<arrlen((yyvsp[-1].node)->children); i++) {
+                 ast_add_child((yyval.node), (yyvsp[-1].node)->children[i]);
+             }
+         }
+    }
+#line 1883 "build/parser.tab.c"
+    break;
+
+  case 31: /* var_decl: TOKEN_VAR TOKEN_ID ':' type_def '=' expr  */
+#line 205 "src/parser.y"
+                                             {
+        (yyval.node) = ast_new(NODE_VAR_DECL);
+        (yyval.node)->name = sdsnew((yyvsp[-4].str));
+        (yyval.node)->data_type = (yyvsp[-2].node)->string_value ? sdsnew((yyvsp[-2].node)->string_value) : sdsnew("void");
+        ast_add_child((yyval.node), (yyvsp[0].node));
+    }
+#line 1894 "build/parser.tab.c"
+    break;
+
+  case 32: /* var_decl: TOKEN_VAR TOKEN_ID ':' type_def '(' expr ',' expr ')'  */
+#line 211 "src/parser.y"
+                                                            {
+        /* Sized declaration: var m: matriz[real64](linhas, colunas) */
+        (yyval.node) = ast_new(NODE_VAR_DECL);
+        (yyval.node)->name = sdsnew((yyvsp[-7].str));
+        (yyval.node)->data_type = (yyvsp[-5].node)->string_value ? sdsnew((yyvsp[-5].node)->string_value) : sdsnew("void");
+        ASTNode* dims = ast_new(NODE_FUNC_CALL);
+        dims->name = sdsnew("matriz");
+        ast_add_child(dims, (yyvsp[-3].node));
+        ast_add_child(dims, (yyvsp[-1].node));
+        ast_add_child((yyval.node), dims);
+    }
+#line 1910 "build/parser.tab.c"
+    break;
+
+  case 33: /* var_decl: TOKEN_VAR TOKEN_ID ':' type_def '(' expr ')'  */
+#line 222 "src/parser.y"
+                                                   {
+        /* Sized declaration: var b: bits(n) */
+        (yyval.node) = ast_new(NODE_VAR_DECL);
+        (yyval.node)->name = sdsnew((yyvsp[-5].str));
+        (yyval.node)->data_type = (yyvsp[-3].node)->string_value ? sdsnew((yyvsp[-3].node)->string_value) : sdsnew("void");
+        ASTNode* size = ast_new(NODE_FUNC_CALL);
+        size->name = sdsnew((yyvsp[-3].node)->string_value ? (yyvsp[-3].node)->string_value : "bits");
+        ast_add_child(size, (yyvsp[-1].node));
+        ast_add_child((yyval.node), size);
+    }
+#line 1925 "build/parser.tab.c"
+    break;
+
+  case 34: /* var_decl: TOKEN_VAR TOKEN_ID ':' type_def  */
+#line 232 "src/parser.y"
+                                      {
+        /* Uninitialized variable declaration: var p: Player */
+        (yyval.node) = ast_new(NODE_VAR_DECL);
+        (yyval.node)->name = sdsnew((yyvsp[-2].str));
+        (yyval.node)->data_type = (yyvsp[0].node)->string_value ? sdsnew((yyvsp[0].node)->string_value) : sdsnew("void");
+    }
+#line 1936 "build/parser.tab.c"
+    break;
+
+  case 35: /* struct_def: struct_attrs TOKEN_ESTRUTURA TOKEN_ID '{' field_list '}'  */
+#line 241 "src/parser.y"
+                                                             {
+        (yyval.node) = ast_new(NODE_STRUCT_DEF);
+        (yyval.node)->name = sdsnew((yyvsp[-3].str));
+        register_struct((yyvsp[-3].str)); // SymTable
+        apply_struct_attrs((yyval.node), (yyvsp[-5].node));
+        // Add fields as children
+        if ((yyvsp[-1].node) && arrlen((yyvsp[-1].node)->children) > 0) {
+            for(int i=0; i<arrlen((yyvsp[-1].node)->children); i++) {
+                ASTNode* field = (yyvsp[-1].node)->children[i];
+                ast_add_child((yyval.node), field);
+                register_field((yyvsp[-3].str), field->name, field->data_type); // SymTable
+            }
+        }
+    }
+#line 1955 "build/parser.tab.c"
+    break;
+
+  case 36: /* struct_def: struct_attrs TOKEN_ESTRUTURA TOKEN_ID TOKEN_ID '{' field_list '}'  */
+#line 255 "src/parser.y"
+                                                                        {
+        /* Struct kind modifier: estrutura valor Ponto { ... } */
+        if (strcmp((yyvsp[-4].str), "valor") != 0) {
+            yyerror("expected 'valor' or a struct name after 'estrutura'");
+        }
+        (yyval.node) = ast_new(NODE_STRUCT_DEF);
+        (yyval.node)->name = sdsnew((yyvsp[-3].str));
+        (yyval.node)->string_value = sdsnew((yyvsp[-4].str)); // Kind ("valor")
+        register_struct((yyvsp[-3].str)); // SymTable
+        set_struct_flag((yyvsp[-3].str), STRUCT_FLAG_VALUE);
+        apply_struct_attrs((yyval.node), (yyvsp[-6].node));
+        if ((yyvsp[-1].node) && arrlen((yyvsp[-1].node)->children) > 0) {
+            for(int i=0; i<arrlen((yyvsp[-1].node)->children); i++) {
+                ASTNode* field = (yyvsp[-1].node)->children[i];
+                ast_add_child((yyval.node), field);
+                register_field((yyvsp[-3].str), field->name, field->data_type); // SymTable
+            }
+        }
+    }
+#line 1979 "build/parser.tab.c"
+    break;
+
+  case 37: /* struct_attrs: struct_attrs '@' TOKEN_ID  */
+#line 277 "src/parser.y"
+                              {
+        /* @soa */
+        (yyval.node) = (yyvsp[-2].node);
+        ASTNode* attr = ast_new(NODE_VAR_REF);
+        attr->name = sdsnew((yyvsp[0].str));
+        ast_add_child((yyval.node), attr);
+    }
+#line 1991 "build/parser.tab.c"
+    break;
+
+  case 38: /* struct_attrs: struct_attrs '@' TOKEN_ID '(' TOKEN_LIT_INT ')'  */
+#line 284 "src/parser.y"
+                                                      {
+        /* @alinhado(64) */
+        (yyval.node) = (yyvsp[-5].node);
+        ASTNode* attr = ast_new(NODE_VAR_REF);
+        attr->name = sdsnew((yyvsp[-3].str));
+        ASTNode* arg = ast_new(NODE_LITERAL_INT);
+        arg->int_value = (yyvsp[-1].integer);
+        ast_add_child(attr, arg);
+        ast_add_child((yyval.node), attr);
+    }
+#line 2006 "build/parser.tab.c"
+    break;
+
+  case 39: /* struct_attrs: %empty  */
+#line 294 "src/parser.y"
+                  { (yyval.node) = ast_new(NODE_BLOCK); }
+#line 2012 "build/parser.tab.c"
+    break;
+
+  case 40: /* field_list: field_list field_decl  */
+#line 298 "src/parser.y"
+                          {
+        (yyval.node) = (yyvsp[-1].node);
+        ast_add_child((yyval.node), (yyvsp[0].node));
+    }
+#line 2021 "build/parser.tab.c"
+    break;
+
+  case 41: /* field_list: %empty  */
+#line 302 "src/parser.y"
+                  { (yyval.node) = ast_new(NODE_BLOCK); }
+#line 2027 "build/parser.tab.c"
+    break;
+
+  case 42: /* field_decl: TOKEN_ID ':' type_def  */
+#line 306 "src/parser.y"
+                          {
+        (yyval.node) = ast_new(NODE_VAR_DECL);
+        (yyval.node)->name = sdsnew((yyvsp[-2].str));
+        (yyval.node)->data_type = (yyvsp[0].node)->string_value ? sdsnew((yyvsp[0].node)->string_value) : sdsnew("void");
+    }
+#line 2037 "build/parser.tab.c"
+    break;
+
+  case 43: /* type_def: TOKEN_ID  */
+#line 314 "src/parser.y"
+             {
+        (yyval.node) = ast_new(NODE_VAR_REF); // Reuse for type storage
+        (yyval.node)->string_value = sdsnew((yyvsp[0].str));
+    }
+#line 2046 "build/parser.tab.c"
+    break;
+
+  case 44: /* type_def: '[' type_def ']'  */
+#line 318 "src/parser.y"
+                       {
+        // Recursive: [type] or [[type]] or [[[type]]]...
+        (yyval.node) = ast_new(NODE_VAR_REF);
+        sds inner = (yyvsp[-1].node)->string_value ? sdsnew((yyvsp[-1].node)->string_value) : sdsnew("");
+        (yyval.node)->string_value = sdscat(sdsnew("["), inner);
+        (yyval.node)->string_value = sdscat((yyval.node)->string_value, "]");
+    }
+#line 2058 "build/parser.tab.c"
+    break;
+
+  case 45: /* type_def: '[' type_def TOKEN_SEMICOLON TOKEN_LIT_INT ']'  */
+#line 325 "src/parser.y"
+                                                     {
+        // Fixed-size array: [inteiro32; 16] (stored as "fixo[inteiro32;16]")
+        if ((yyvsp[-1].integer) <= 0) {
+            fprintf(stderr, "[Basalto] Erro: o tamanho de um array fixo deve ser positivo (recebeu %d).\n", (yyvsp[-1].integer));
+            exit(1);
+        }
+        (yyval.node) = ast_new(NODE_VAR_REF);
+        (yyval.node)->string_value = sdscatprintf(sdsempty(), "fixo[%s;%d]", (yyvsp[-3].node)->string_value ? (yyvsp[-3].node)->string_value : "", (yyvsp[-1].integer));
+    }
+#line 2072 "build/parser.tab.c"
+    break;
+
+  case 46: /* type_def: '[' type_def TOKEN_SEMICOLON TOKEN_ID TOKEN_LIT_INT ']'  */
+#line 334 "src/parser.y"
+                                                              {
+        // Small array: [Pessoa; ate 4] (stored as "pequeno[Pessoa;4]")
+        if (strcmp((yyvsp[-2].str), "ate") != 0) {
+            fprintf(stderr, "[Basalto] Erro: esperado '[T; N]' ou '[T; ate N]', encontrado '%s'.\n", (yyvsp[-2].str));
+            exit(1);
+        }
+        if ((yyvsp[-1].integer) <= 0) {
+            fprintf(stderr, "[Basalto] Erro: o tamanho de um array pequeno deve ser positivo (recebeu %d).\n", (yyvsp[-1].integer));
+            exit(1);
+        }
+        (yyval.node) = ast_new(NODE_VAR_REF);
+        (yyval.node)->string_value = sdscatprintf(sdsempty(), "pequeno[%s;%d]", (yyvsp[-4].node)->string_value ? (yyvsp[-4].node)->string_value : "", (yyvsp[-1].integer));
+    }
+#line 2090 "build/parser.tab.c"
+    break;
+
+  case 47: /* type_def: '[' type_def TOKEN_SEMICOLON TOKEN_ID ']'  */
+#line 347 "src/parser.y"
+                                                {
+        // Packed string array: [texto; compacto] (stored as "compacto[texto]")
+        if (strcmp((yyvsp[-1].str), "compacto") != 0 || !(yyvsp[-3].node)->string_value || strcmp((yyvsp[-3].node)->string_value, "texto") != 0) {
+            fprintf(stderr, "[Basalto] Erro: so '[texto; compacto]' e suportado, encontrado '[%s; %s]'.\n",
+                    (yyvsp[-3].node)->string_value ? (yyvsp[-3].node)->string_value : "", (yyvsp[-1].str));
+            exit(1);
+        }
+        (yyval.node) = ast_new(NODE_VAR_REF);
+        (yyval.node)->string_value = sdsnew("compacto[texto]");
+    }
+#line 2105 "build/parser.tab.c"
+    break;
+
+  case 48: /* type_def: TOKEN_ID '[' type_def ']'  */
+#line 357 "src/parser.y"
+                                {
+        // Parameterized type: fatia[inteiro32]
+        (yyval.node) = ast_new(NODE_VAR_REF);
+        (yyval.node)->string_value = sdscatprintf(sdsempty(), "%s[%s]", (yyvsp[-3].str), (yyvsp[-1].node)->string_value ? (yyvsp[-1].node)->string_value : "");
+    }
+#line 2115 "build/parser.tab.c"
+    break;
+
+  case 49: /* type_def: TOKEN_ID '[' type_def ',' type_def ']'  */
+#line 362 "src/parser.y"
+                                             {
+        // Two parameters: mapa[texto, inteiro32]
+        (yyval.node) = ast_new(NODE_VAR_REF);
+        (yyval.node)->string_value = sdscatprintf(sdsempty(), "%s[%s,%s]", (yyvsp[-5].str),
+                                        (yyvsp[-3].node)->string_value ? (yyvsp[-3].node)->string_value : "",
+                                        (yyvsp[-1].node)->string_value ? (yyvsp[-1].node)->string_value : "");
+    }
+#line 2127 "build/parser.tab.c"
+    break;
+
+  case 50: /* assign_stmt: lvalue '=' expr  */
+#line 372 "src/parser.y"
+                    {
+        (yyval.node) = ast_new(NODE_ASSIGN);
+        // For property access or array access, we need to store the full path
+        if ((yyvsp[-2].node)->type == NODE_PROP_ACCESS || (yyvsp[-2].node)->type == NODE_ARRAY_ACCESS) {
+            // Store property/array access as the lvalue
+            (yyval.node)->name = NULL; // Will be generated from child
+            ast_add_child((yyval.node), (yyvsp[-2].node)); // The property/array access node
+            ast_add_child((yyval.node), (yyvsp[0].node)); // Expression value
+        } else {
+            (yyval.node)->name = sdsnew((yyvsp[-2].node)->name); // Variable name
+            ast_add_child((yyval.node), (yyvsp[0].node));      // Expression value
+        }
+    }
+#line 2145 "build/parser.tab.c"
+    break;
+
+  case 51: /* lvalue: TOKEN_ID  */
+#line 388 "src/parser.y"
+             {
+        (yyval.node) = ast_new(NODE_VAR_REF);
+        (yyval.node)->name = sdsnew((yyvsp[0].str));
+    }
+#line 2154 "build/parser.tab.c"
+    break;
+
+  case 52: /* lvalue: TOKEN_ID '[' expr ']'  */
+#line 392 "src/parser.y"
+                            {
+        /* Array access as lvalue: arr[i] */
+        (yyval.node) = ast_new(NODE_ARRAY_ACCESS);
+        (yyval.node)->name = sdsnew((yyvsp[-3].str));
+        ast_add_child((yyval.node), (yyvsp[-1].node)); // Index expression
+    }
+#line 2165 "build/parser.tab.c"
+    break;
+
+  case 53: /* lvalue: factor '[' expr ']'  */
+#line 398 "src/parser.y"
+                          {
+        /* Nested array access as lvalue: arr[i][j] */
+        (yyval.node) = ast_new(NODE_ARRAY_ACCESS);
+        (yyval.node)->name = NULL;
+        ast_add_child((yyval.node), (yyvsp[-3].node)); // Base expression
+        ast_add_child((yyval.node), (yyvsp[-1].node)); // Index expression
+    }
+#line 2177 "build/parser.tab.c"
+    break;
+
+  case 54: /* lvalue: TOKEN_ID '.' TOKEN_ID  */
+#line 405 "src/parser.y"
+                            {
+        /* Property access as lvalue: p.x (for structs only, not method calls) */
+        /* Note: This only matches simple property access, not method calls */
+        (yyval.node) = ast_new(NODE_PROP_ACCESS);
+        (yyval.node)->name = sdsnew((yyvsp[-2].str));
+        (yyval.node)->data_type = sdsnew((yyvsp[0].str));
+        // Create a var_ref for the object
+        ASTNode* obj = ast_new(NODE_VAR_REF);
+        obj->name = sdsnew((yyvsp[-2].str));
+        ast_add_child((yyval.node), obj);
+    }
+#line 2193 "build/parser.tab.c"
+    break;
+
+  case 55: /* lvalue: factor '.' TOKEN_ID  */
+#line 416 "src/parser.y"
+                          {
+        /* Nested property access as lvalue: pts[i].x or a.pos.x */
+        (yyval.node) = ast_new(NODE_PROP_ACCESS);
+        (yyval.node)->name = NULL;
+        (yyval.node)->data_type = sdsnew((yyvsp[0].str));
+        ast_add_child((yyval.node), (yyvsp[-2].node)); // Object
+    }
+#line 2205 "build/parser.tab.c"
+    break;
+
+  case 56: /* if_stmt: TOKEN_SE '(' logical_expr ')' block  */
+#line 427 "src/parser.y"
+                                        {
+        (yyval.node) = ast_new(NODE_IF);
+        (yyval.node)->name = NULL;
+        // Store the full condition expression as first child
+        // Try to extract operator for simple comparisons (for backward compatibility with codegen)
+        if ((yyvsp[-2].node)->type == NODE_BINARY_OP && (yyvsp[-2].node)->data_type &&
+            (strcmp((yyvsp[-2].node)->data_type, ">") == 0 || strcmp((yyvsp[-2].node)->data_type, "<") == 0 ||
+             strcmp((yyvsp[-2].node)->data_type, ">=") == 0 || strcmp((yyvsp[-2].node)->data_type, "<=") == 0 ||
+             strcmp((yyvsp[-2].node)->data_type, "==") == 0 || strcmp((yyvsp[-2].node)->data_type, "!=") == 0) &&
+            arrlen((yyvsp[-2].node)->children) >= 2) {
+            // Simple comparison: extract operator and operands
+            (yyval.node)->data_type = sdsnew((yyvsp[-2].node)->data_type);
+            ast_add_child((yyval.node), (yyvsp[-2].node)->children[0]); // Left operand
+            ast_add_child((yyval.node), (yyvsp[-2].node)->children[1]); // Right operand
+        } else {
+            // Complex expression: store as-is
+            (yyval.node)->data_type = NULL;
+            ast_add_child((yyval.node), (yyvsp[-2].node)); // Full condition expression
+        }
+        ast_add_child((yyval.node), (yyvsp[0].node));      // If block
+    }
+#line 2231 "build/parser.tab.c"
+    break;
+
+  case 57: /* if_stmt: TOKEN_SE '(' logical_expr ')' block TOKEN_SENAO block  */
+#line 448 "src/parser.y"
+                                                            {
+        /* Matches: se ( logical_expr ) { ... } senao { ... } */
+        (yyval.node) = ast_new(NODE_IF);
+        (yyval.node)->name = NULL;
+        // Store the full condition expression as first child
+        // Try to extract operator for simple comparisons (for backward compatibility with codegen)
+        if ((yyvsp[-4].node)->type == NODE_BINARY_OP && (yyvsp[-4].node)->data_type &&
+            (strcmp((yyvsp[-4].node)->data_type, ">") == 0 || strcmp((yyvsp[-4].node)->data_type, "<") == 0 ||
+             strcmp((yyvsp[-4].node)->data_type, ">=") == 0 || strcmp((yyvsp[-4].node)->data_type, "<=") == 0 ||
+             strcmp((yyvsp[-4].node)->data_type, "==") == 0 || strcmp((yyvsp[-4].node)->data_type, "!=") == 0) &&
+            arrlen((yyvsp[-4].node)->children) >= 2) {
+            // Simple comparison: extract operator and operands
+            (yyval.node)->data_type = sdsnew((yyvsp[-4].node)->data_type);
+            ast_add_child((yyval.node), (yyvsp[-4].node)->children[0]); // Left operand
+            ast_add_child((yyval.node), (yyvsp[-4].node)->children[1]); // Right operand
+        } else {
+            // Complex expression: store as-is
+            (yyval.node)->data_type = NULL;
+            ast_add_child((yyval.node), (yyvsp[-4].node)); // Full condition expression
+        }
+        ast_add_child((yyval.node), (yyvsp[-2].node));      // If block
+        ast_add_child((yyval.node), (yyvsp[0].node));      // Else block
+    }
+#line 2259 "build/parser.tab.c"
+    break;
+
+  case 58: /* enquanto_stmt: TOKEN_ENQUANTO '(' logical_expr ')' block  */
+#line 475 "src/parser.y"
+                                              {
+        (yyval.node) = ast_new(NODE_ENQUANTO);
+        (yyval.node)->name = NULL;
+        // Store the full condition expression as first child
+        // Try to extract operator for simple comparisons (for backward compatibility with codegen)
+        if ((yyvsp[-2].node)->type == NODE_BINARY_OP && (yyvsp[-2].node)->data_type &&
+            (strcmp((yyvsp[-2].node)->data_type, ">") == 0 || strcmp((yyvsp[-2].node)->data_type, "<") == 0 ||
+             strcmp((yyvsp[-2].node)->data_type, ">=") == 0 || strcmp((yyvsp[-2].node)->data_type, "<=") == 0 ||
+             strcmp((yyvsp[-2].node)->data_type, "==") == 0 || strcmp((yyvsp[-2].node)->data_type, "!=") == 0) &&
+            arrlen((yyvsp[-2].node)->children) >= 2) {
+            // Simple comparison: extract operator and operands
+            (yyval.node)->data_type = sdsnew((yyvsp[-2].node)->data_type);
+            ast_add_child((yyval.node), (yyvsp[-2].node)->children[0]); // Left operand
+            ast_add_child((yyval.node), (yyvsp[-2].node)->children[1]); // Right operand
+        } else {
+            // Complex expression: store as-is
+            (yyval.node)->data_type = NULL;
+            ast_add_child((yyval.node), (yyvsp[-2].node)); // Full condition expression
+        }
+        ast_add_child((yyval.node), (yyvsp[0].node));      // Block
+    }
+#line 2285 "build/parser.tab.c"
+    break;
+
+  case 59: /* expr: logical_expr  */
+#line 499 "src/parser.y"
+                 {
+        (yyval.node) = (yyvsp[0].node);
+    }
+#line 2293 "build/parser.tab.c"
+    break;
+
+  case 60: /* logical_expr: logical_expr '|' '|' comparison_expr  */
+#line 505 "src/parser.y"
+                                         {
+        (yyval.node) = ast_new(NODE_BINARY_OP);
+        (yyval.node)->data_type = sdsnew("||");
+        ast_add_child((yyval.node), (yyvsp[-3].node)); // Left operand
+        ast_add_child((yyval.node), (yyvsp[0].node)); // Right operand
+    }
+#line 2304 "build/parser.tab.c"
+    break;
+
+  case 61: /* logical_expr: logical_expr '&' '&' comparison_expr  */
+#line 511 "src/parser.y"
+                                           {
+        (yyval.node) = ast_new(NODE_BINARY_OP);
+        (yyval.node)->data_type = sdsnew("&&");
+        ast_add_child((yyval.node), (yyvsp[-3].node)); // Left operand
+        ast_add_child((yyval.node), (yyvsp[0].node)); // Right operand
+    }
+#line 2315 "build/parser.tab.c"
+    break;
+
+  case 62: /* logical_expr: comparison_expr  */
+#line 517 "src/parser.y"
+                      {
+        (yyval.node) = (yyvsp[0].node);
+    }
+#line 2323 "build/parser.tab.c"
+    break;
+
+  case 63: /* comparison_expr: comparison_expr '+' term  */
+#line 523 "src/parser.y"
+                             {
+        (yyval.node) = ast_new(NODE_BINARY_OP);
+        (yyval.node)->data_type = sdsnew("+");
+        ast_add_child((yyval.node), (yyvsp[-2].node)); // Left operand
+        ast_add_child((yyval.node), (yyvsp[0].node)); // Right operand
+    }
+#line 2334 "build/parser.tab.c"
+    break;
+
+  case 64: /* comparison_expr: comparison_expr '-' term  */
+#line 529 "src/parser.y"
+                               {
+        (yyval.node) = ast_new(NODE_BINARY_OP);
+        (yyval.node)->data_type = sdsnew("-");
+        ast_add_child((yyval.node), (yyvsp[-2].node)); // Left operand
+        ast_add_child((yyval.node), (yyvsp[0].node)); // Right operand
+    }
+#line 2345 "build/parser.tab.c"
+    break;
+
+  case 65: /* comparison_expr: comparison_expr '>' term  */
+#line 535 "src/parser.y"
+                               {
+        (yyval.node) = ast_new(NODE_BINARY_OP);
+        (yyval.node)->data_type = sdsnew(">");
+        ast_add_child((yyval.node), (yyvsp[-2].node)); // Left operand
+        ast_add_child((yyval.node), (yyvsp[0].node)); // Right operand
+    }
+#line 2356 "build/parser.tab.c"
+    break;
+
+  case 66: /* comparison_expr: comparison_expr '<' term  */
+#line 541 "src/parser.y"
+                               {
+        (yyval.node) = ast_new(NODE_BINARY_OP);
+        (yyval.node)->data_type = sdsnew("<");
+        ast_add_child((yyval.node), (yyvsp[-2].node)); // Left operand
+        ast_add_child((yyval.node), (yyvsp[0].node)); // Right operand
+    }
+#line 2367 "build/parser.tab.c"
+    break;
+
+  case 67: /* comparison_expr: comparison_expr '>' '=' term  */
+#line 547 "src/parser.y"
+                                   {
+        (yyval.node) = ast_new(NODE_BINARY_OP);
+        (yyval.node)->data_type = sdsnew(">=");
+        ast_add_child((yyval.node), (yyvsp[-3].node)); // Left operand
+        ast_add_child((yyval.node), (yyvsp[0].node)); // Right operand
+    }
+#line 2378 "build/parser.tab.c"
+    break;
+
+  case 68: /* comparison_expr: comparison_expr '<' '=' term  */
+#line 553 "src/parser.y"
+                                   {
+        (yyval.node) = ast_new(NODE_BINARY_OP);
+        (yyval.node)->data_type = sdsnew("<=");
+        ast_add_child((yyval.node), (yyvsp[-3].node)); // Left operand
+        ast_add_child((yyval.node), (yyvsp[0].node)); // Right operand
+    }
+#line 2389 "build/parser.tab.c"
+    break;
+
+  case 69: /* comparison_expr: comparison_expr '=' '=' term  */
+#line 559 "src/parser.y"
+                                   {
+        (yyval.node) = ast_new(NODE_BINARY_OP);
+        (yyval.node)->data_type = sdsnew("==");
+        ast_add_child((yyval.node), (yyvsp[-3].node)); // Left operand
+        ast_add_child((yyval.node), (yyvsp[0].node)); // Right operand
+    }
+#line 2400 "build/parser.tab.c"
+    break;
+
+  case 70: /* comparison_expr: comparison_expr '!' '=' term  */
+#line 565 "src/parser.y"
+                                   {
+        (yyval.node) = ast_new(NODE_BINARY_OP);
+        (yyval.node)->data_type = sdsnew("!=");
+        ast_add_child((yyval.node), (yyvsp[-3].node)); // Left operand
+        ast_add_child((yyval.node), (yyvsp[0].node)); // Right operand
+    }
+#line 2411 "build/parser.tab.c"
+    break;
+
+  case 71: /* comparison_expr: term  */
+#line 571 "src/parser.y"
+           {
+        (yyval.node) = (yyvsp[0].node);
+    }
+#line 2419 "build/parser.tab.c"
+    break;
+
+  case 72: /* term: term '*' factor  */
+#line 577 "src/parser.y"
+                    {
+        (yyval.node) = ast_new(NODE_BINARY_OP);
+        (yyval.node)->data_type = sdsnew("*");
+        ast_add_child((yyval.node), (yyvsp[-2].node)); // Left operand
+        ast_add_child((yyval.node), (yyvsp[0].node)); // Right operand
+    }
+#line 2430 "build/parser.tab.c"
+    break;
+
+  case 73: /* term: term '/' factor  */
+#line 583 "src/parser.y"
+                      {
+        (yyval.node) = ast_new(NODE_BINARY_OP);
+        (yyval.node)->data_type = sdsnew("/");
+        ast_add_child((yyval.node), (yyvsp[-2].node)); // Left operand
+        ast_add_child((yyval.node), (yyvsp[0].node)); // Right operand
+    }
+#line 2441 "build/parser.tab.c"
+    break;
+
+  case 74: /* term: factor  */
+#line 589 "src/parser.y"
+             {
+        (yyval.node) = (yyvsp[0].node);
+    }
+#line 2449 "build/parser.tab.c"
+    break;
+
+  case 75: /* factor: TOKEN_LIT_INT  */
+#line 595 "src/parser.y"
+                  {
+        (yyval.node) = ast_new(NODE_LITERAL_INT);
+        (yyval.node)->int_value = (yyvsp[0].integer);
+    }
+#line 2458 "build/parser.tab.c"
+    break;
+
+  case 76: /* factor: TOKEN_LIT_DOUBLE  */
+#line 599 "src/parser.y"
+                       {
+        (yyval.node) = ast_new(NODE_LITERAL_DOUBLE);
+        (yyval.node)->double_value = (yyvsp[0].double_val);
+    }
+#line 2467 "build/parser.tab.c"
+    break;
+
+  case 77: /* factor: TOKEN_LIT_FLOAT  */
+#line 603 "src/parser.y"
+                      {
+        (yyval.node) = ast_new(NODE_LITERAL_FLOAT);
+        (yyval.node)->float_value = (yyvsp[0].float_val);
+    }
+#line 2476 "build/parser.tab.c"
+    break;
+
+  case 78: /* factor: TOKEN_LIT_STRING  */
+#line 607 "src/parser.y"
+                       {
+        (yyval.node) = ast_new(NODE_LITERAL_STRING);
+        (yyval.node)->string_value = sdsnew((yyvsp[0].str));
+    }
+#line 2485 "build/parser.tab.c"
+    break;
+
+  case 79: /* factor: TOKEN_ID  */
+#line 611 "src/parser.y"
+               {
+        (yyval.node) = ast_new(NODE_VAR_REF);
+        (yyval.node)->name = sdsnew((yyvsp[0].str));
+    }
+#line 2494 "build/parser.tab.c"
+    break;
+
+  case 80: /* factor: TOKEN_ID '[' expr TOKEN_DOTDOT expr ']'  */
+#line 615 "src/parser.y"
+                                              {
+        /* Array slice: arr[0..2] */
+        (yyval.node) = ast_new(NODE_ARRAY_ACCESS);
+        (yyval.node)->name = sdsnew((yyvsp[-5].str));
+        ast_add_child((yyval.node), (yyvsp[-3].node)); // Start index
+        ast_add_child((yyval.node), (yyvsp[-1].node)); // End index
+    }
+#line 2506 "build/parser.tab.c"
+    break;
+
+  case 81: /* factor: factor '[' expr TOKEN_DOTDOT expr ']'  */
+#line 622 "src/parser.y"
+                                            {
+        /* Nested array slice: arr[0][1..3] */
+        (yyval.node) = ast_new(NODE_ARRAY_ACCESS);
+        (yyval.node)->name = NULL; // Will be generated from child
+        ast_add_child((yyval.node), (yyvsp[-5].node)); // Base expression (could be another array access)
+        ast_add_child((yyval.node), (yyvsp[-3].node)); // Start index
+        ast_add_child((yyval.node), (yyvsp[-1].node)); // End index
+    }
+#line 2519 "build/parser.tab.c"
+    break;
+
+  case 82: /* factor: TOKEN_ID '[' expr TOKEN_DOTDOT expr ':' expr ']'  */
+#line 630 "src/parser.y"
+                                                       {
+        /* Slice with step: arr[0..8:2] */
+        (yyval.node) = ast_new(NODE_ARRAY_ACCESS);
+        (yyval.node)->name = sdsnew((yyvsp[-7].str));
+        ast_add_child((yyval.node), (yyvsp[-5].node)); // Start index
+        ast_add_child((yyval.node), (yyvsp[-3].node)); // End index
+        (yyval.node)->step = (yyvsp[-1].node);
+    }
+#line 2532 "build/parser.tab.c"
+    break;
+
+  case 83: /* factor: factor '[' expr TOKEN_DOTDOT expr ':' expr ']'  */
+#line 638 "src/parser.y"
+                                                     {
+        /* Nested slice with step: m[0][0..8:2] */
+        (yyval.node) = ast_new(NODE_ARRAY_ACCESS);
+        (yyval.node)->name = NULL;
+        ast_add_child((yyval.node), (yyvsp[-7].node));
+        ast_add_child((yyval.node), (yyvsp[-5].node));
+        ast_add_child((yyval.node), (yyvsp[-3].node));
+        (yyval.node)->step = (yyvsp[-1].node);
+    }
+#line 2546 "build/parser.tab.c"
+    break;
+
+  case 84: /* factor: TOKEN_ID '[' expr ']'  */
+#line 647 "src/parser.y"
+                            {
+        /* Array access: arr[0] */
+        (yyval.node) = ast_new(NODE_ARRAY_ACCESS);
+        (yyval.node)->name = sdsnew((yyvsp[-3].str));
+        ast_add_child((yyval.node), (yyvsp[-1].node)); // Index expression
+    }
+#line 2557 "build/parser.tab.c"
+    break;
+
+  case 85: /* factor: factor '[' expr ']'  */
+#line 653 "src/parser.y"
+                          {
+        /* Nested array access: arr[0][1] */
+        (yyval.node) = ast_new(NODE_ARRAY_ACCESS);
+        (yyval.node)->name = NULL; // Will be generated from child
+        ast_add_child((yyval.node), (yyvsp[-3].node)); // Base expression (could be another array access)
+        ast_add_child((yyval.node), (yyvsp[-1].node)); // Index expression
+    }
+#line 2569 "build/parser.tab.c"
+    break;
+
+  case 86: /* factor: method_call  */
+#line 660 "src/parser.y"
+                  {
+        /* Method calls must be checked before prop_access to avoid conflicts */
+        (yyval.node) = (yyvsp[0].node);
+    }
+#line 2578 "build/parser.tab.c"
+    break;
+
+  case 87: /* factor: prop_access  */
+#line 664 "src/parser.y"
+                  {
+        /* Property access: p.x (only if not followed by '(') */
+        (yyval.node) = (yyvsp[0].node);
+    }
+#line 2587 "build/parser.tab.c"
+    break;
+
+  case 88: /* factor: array_literal  */
+#line 668 "src/parser.y"
+                    {
+        (yyval.node) = (yyvsp[0].node);
+    }
+#line 2595 "build/parser.tab.c"
+    break;
+
+  case 89: /* factor: TOKEN_LER '(' ')'  */
+#line 671 "src/parser.y"
+                        {
+        /* Expression: var x = ler() */
+        (yyval.node) = ast_new(NODE_INPUT_VALUE);
+    }
+#line 2604 "build/parser.tab.c"
+    break;
+
+  case 90: /* factor: TOKEN_NULL  */
+#line 675 "src/parser.y"
+                 {
+        /* Null literal: nulo or NULL */
+        (yyval.node) = ast_new(NODE_LITERAL_NULL);
+    }
+#line 2613 "build/parser.tab.c"
+    break;
+
+  case 91: /* factor: TOKEN_TRUE  */
+#line 679 "src/parser.y"
+                 {
+        /* Boolean literal: verdadeiro */
+        (yyval.node) = ast_new(NODE_LITERAL_BOOL);
+        (yyval.node)->int_value = 1;
+    }
+#line 2623 "build/parser.tab.c"
+    break;
+
+  case 92: /* factor: TOKEN_FALSE  */
+#line 684 "src/parser.y"
+                  {
+        /* Boolean literal: falso */
+        (yyval.node) = ast_new(NODE_LITERAL_BOOL);
+        (yyval.node)->int_value = 0;
+    }
+#line 2633 "build/parser.tab.c"
+    break;
+
+  case 93: /* factor: '-' factor  */
+#line 689 "src/parser.y"
+                 {
+        /* Unary minus: -128, -3.14, etc. */
+        (yyval.node) = ast_new(NODE_UNARY_OP);
+        (yyval.node)->data_type = sdsnew("-");
+        ast_add_child((yyval.node), (yyvsp[0].node)); // The operand
+    }
+#line 2644 "build/parser.tab.c"
+    break;
+
+  case 94: /* factor: TOKEN_NEW TOKEN_ID  */
+#line 695 "src/parser.y"
+                         {
+        /* Heap allocation: nova Node */
+        (yyval.node) = ast_new(NODE_NEW);
+        (yyval.node)->data_type = sdsnew((yyvsp[0].str));
+    }
+#line 2654 "build/parser.tab.c"
+    break;
+
+  case 95: /* factor: TOKEN_ID '(' arg_list ')'  */
+#line 700 "src/parser.y"
+                                {
+        /* Function call as expression: formatar_texto("...") or merge(left, right) */
+        (yyval.node) = ast_new(NODE_FUNC_CALL);
+        (yyval.node)->name = sdsnew((yyvsp[-3].str));
+        // Add all arguments as children
+        if ((yyvsp[-1].node) && arrlen((yyvsp[-1].node)->children) > 0) {
+            for(int i=0; i<arrlen((yyvsp[-1].node)->children); i++) {
+                ast_add_child((yyval.node), (yyvsp[-1].node)->children[i]);
+            }
+        }
+    }
+#line 2670 "build/parser.tab.c"
+    break;
+
+  case 96: /* factor: '(' expr ')'  */
+#line 711 "src/parser.y"
+                   {
+        (yyval.node) = (yyvsp[-1].node);
+    }
+#line 2678 "build/parser.tab.c"
+    break;
+
+  case 97: /* cada_stmt: TOKEN_CADA '(' TOKEN_ID ':' expr TOKEN_DOTDOT expr ')' block  */
+#line 718 "src/parser.y"
+                                                                 {
+        (yyval.node) = ast_new(NODE_CADA);
+        (yyval.node)->cada_var = sdsnew((yyvsp[-6].str));
+        (yyval.node)->cada_type = sdsnew("inteiro32"); // Default type
+        (yyval.node)->start = (yyvsp[-4].node);
+        (yyval.node)->end = (yyvsp[-2].node);
+        (yyval.node)->step = NULL;
+        ast_add_child((yyval.node), (yyvsp[0].node)); // Block
+    }
+#line 2692 "build/parser.tab.c"
+    break;
+
+  case 98: /* cada_stmt: TOKEN_CADA '(' TOKEN_ID ':' expr TOKEN_DOTDOT expr ':' expr ')' block  */
+#line 728 "src/parser.y"
+                                                                            {
+        (yyval.node) = ast_new(NODE_CADA);
+        (yyval.node)->cada_var = sdsnew((yyvsp[-8].str));
+        (yyval.node)->cada_type = sdsnew("inteiro32"); // Default type
+        (yyval.node)->start = (yyvsp[-6].node);
+        (yyval.node)->end = (yyvsp[-4].node);
+        (yyval.node)->step = (yyvsp[-2].node); // Step expression
+        ast_add_child((yyval.node), (yyvsp[0].node)); // Block
+    }
+#line 2706 "build/parser.tab.c"
+    break;
+
+  case 99: /* cada_stmt: TOKEN_CADA '(' TOKEN_ID ':' TOKEN_ID ':' expr TOKEN_DOTDOT expr ')' block  */
+#line 738 "src/parser.y"
+                                                                                {
+        (yyval.node) = ast_new(NODE_CADA);
+        (yyval.node)->cada_var = sdsnew((yyvsp[-8].str));
+        (yyval.node)->cada_type = sdsnew((yyvsp[-6].str)); // Explicit type
+        (yyval.node)->start = (yyvsp[-4].node);
+        (yyval.node)->end = (yyvsp[-2].node);
+        (yyval.node)->step = NULL;
+        ast_add_child((yyval.node), (yyvsp[0].node)); // Block
+    }
+#line 2720 "build/parser.tab.c"
+    break;
+
+  case 100: /* cada_stmt: TOKEN_CADA '(' TOKEN_ID ':' TOKEN_ID ':' expr TOKEN_DOTDOT expr ':' expr ')' block  */
+#line 748 "src/parser.y"
+                                                                                         {
+        (yyval.node) = ast_new(NODE_CADA);
+        (yyval.node)->cada_var = sdsnew((yyvsp[-10].str));
+        (yyval.node)->cada_type = sdsnew((yyvsp[-8].str)); // Explicit type
+        (yyval.node)->start = (yyvsp[-6].node);
+        (yyval.node)->end = (yyvsp[-4].node);
+        (yyval.node)->step = (yyvsp[-2].node); // Step expression
+        ast_add_child((yyval.node), (yyvsp[0].node)); // Block
+    }
+#line 2734 "build/parser.tab.c"
+    break;
+
+  case 101: /* cada_stmt: TOKEN_CADA '(' TOKEN_ID ',' TOKEN_ID ':' expr ')' block  */
+#line 758 "src/parser.y"
+                                                              {
+        (yyval.node) = ast_new(NODE_CADA);
+        (yyval.node)->cada_var = sdsnew((yyvsp[-6].str)); // Key
+        (yyval.node)->name = sdsnew((yyvsp[-4].str));     // Value
+        (yyval.node)->start = (yyvsp[-2].node);            // Map
+        ast_add_child((yyval.node), (yyvsp[0].node));     // Block
+    }
+#line 2746 "build/parser.tab.c"
+    break;
+
+  case 102: /* cada_stmt: TOKEN_CADA '(' TOKEN_ID ':' expr ')' block  */
+#line 766 "src/parser.y"
+                                                 {
+        (yyval.node) = ast_new(NODE_CADA);
+        (yyval.node)->cada_var = sdsnew((yyvsp[-4].str));
+        (yyval.node)->start = (yyvsp[-2].node);            // Set
+        ast_add_child((yyval.node), (yyvsp[0].node));     // Block
+    }
+#line 2757 "build/parser.tab.c"
+    break;
+
+  case 103: /* infinito_stmt: TOKEN_INFINITO block  */
+#line 775 "src/parser.y"
+                         {
+        (yyval.node) = ast_new(NODE_INFINITO);
+        ast_add_child((yyval.node), (yyvsp[0].node));
+    }
+#line 2766 "build/parser.tab.c"
+    break;
+
+  case 104: /* flow_stmt: TOKEN_PARAR TOKEN_SEMICOLON  */
+#line 782 "src/parser.y"
+                                {
+        (yyval.node) = ast_new(NODE_BREAK);
+    }
+#line 2774 "build/parser.tab.c"
+    break;
+
+  case 105: /* flow_stmt: TOKEN_CONTINUAR TOKEN_SEMICOLON  */
+#line 785 "src/parser.y"
+                                      {
+        (yyval.node) = ast_new(NODE_CONTINUE);
+    }
+#line 2782 "build/parser.tab.c"
+    break;
+
+  case 106: /* input_stmt: TOKEN_LER '(' ')' TOKEN_SEMICOLON  */
+#line 791 "src/parser.y"
+                                      {
+        /* Statement: ler() - system pause */
+        (yyval.node) = ast_new(NODE_INPUT_PAUSE);
+    }
+#line 2791 "build/parser.tab.c"
+    break;
+
+  case 107: /* assert_stmt: TOKEN_ASSERT '(' expr ',' TOKEN_LIT_STRING ')' TOKEN_SEMICOLON  */
+#line 798 "src/parser.y"
+                                                                   {
+        (yyval.node) = ast_new(NODE_ASSERT);
+        (yyval.node)->string_value = sdsnew((yyvsp[-2].str)); // The error message
+        ast_add_child((yyval.node), (yyvsp[-4].node));         // The condition expression
+        // Store line number for the panic message
+        (yyval.node)->int_value = yylineno; 
+    }
+#line 2803 "build/parser.tab.c"
+    break;
+
+  case 108: /* func_def: TOKEN_FUNCAO TOKEN_ID '(' param_list ')' ':' type_def block  */
+#line 809 "src/parser.y"
+                                                                {
+        (yyval.node) = ast_new(NODE_FUNC_DEF);
+        (yyval.node)->name = sdsnew((yyvsp[-6].str));
+        (yyval.node)->data_type = (yyvsp[-1].node)->string_value ? sdsnew((yyvsp[-1].node)->string_value) : sdsnew("void");
+        
+        // Children: [Param1, Param2, ..., ParamN, Block]
+        for(int i=0; i<arrlen((yyvsp[-4].node)->children); i++) {
+            ast_add_child((yyval.node), (yyvsp[-4].node)->children[i]);
+        }
+        ast_add_child((yyval.node), (yyvsp[0].node)); // The body block is the last child
+    }
+#line 2819 "build/parser.tab.c"
+    break;
+
+  case 109: /* param_list: param_list ',' param  */
+#line 823 "src/parser.y"
+                         {
+        (yyval.node) = (yyvsp[-2].node);
+        ast_add_child((yyval.node), (yyvsp[0].node));
+    }
+#line 2828 "build/parser.tab.c"
+    break;
+
+  case 110: /* param_list: param  */
+#line 827 "src/parser.y"
+            {
+        (yyval.node) = ast_new(NODE_BLOCK); // Temp container
+        ast_add_child((yyval.node), (yyvsp[0].node));
+    }
+#line 2837 "build/parser.tab.c"
+    break;
+
+  case 111: /* param_list: %empty  */
+#line 831 "src/parser.y"
+                  { (yyval.node) = ast_new(NODE_BLOCK); }
+#line 2843 "build/parser.tab.c"
+    break;
+
+  case 112: /* param: TOKEN_ID ':' type_def  */
+#line 835 "src/parser.y"
+                          {
+        (yyval.node) = ast_new(NODE_VAR_DECL); // Reuse VAR_DECL for params
+        (yyval.node)->name = sdsnew((yyvsp[-2].str));
+        (yyval.node)->data_type = (yyvsp[0].node)->string_value ? sdsnew((yyvsp[0].node)->string_value) : sdsnew("void");
+    }
+#line 2853 "build/parser.tab.c"
+    break;
+
+  case 113: /* return_stmt: TOKEN_RETORNE expr TOKEN_SEMICOLON  */
+#line 843 "src/parser.y"
+                                       {
+        (yyval.node) = ast_new(NODE_RETURN);
+        ast_add_child((yyval.node), (yyvsp[-1].node));
+    }
+#line 2862 "build/parser.tab.c"
+    break;
+
+  case 114: /* extern_block: TOKEN_EXTERNO TOKEN_ID TOKEN_LIT_STRING '{' extern_func_list '}'  */
+#line 851 "src/parser.y"
+                                                                     {
+        (yyval.node) = ast_new(NODE_EXTERN_BLOCK);
+        (yyval.node)->name = sdsnew((yyvsp[-4].str));         // Namespace "math"
+        (yyval.node)->lib_name = sdsnew((yyvsp[-3].str));     // Lib "lib.so"
+        
+        // Add functions
+        for(int i=0; i<arrlen((yyvsp[-1].node)->children); i++) {
+            ast_add_child((yyval.node), (yyvsp[-1].node)->children[i]);
+        }
+    }
+#line 2877 "build/parser.tab.c"
+    break;
+
+  case 115: /* extern_func_list: extern_func_list extern_func  */
+#line 864 "src/parser.y"
+                                 {
+        (yyval.node) = (yyvsp[-1].node);
+        ast_add_child((yyval.node), (yyvsp[0].node));
+    }
+#line 2886 "build/parser.tab.c"
+    break;
+
+  case 116: /* extern_func_list: %empty  */
+#line 868 "src/parser.y"
+                  { (yyval.node) = ast_new(NODE_BLOCK); }
+#line 2892 "build/parser.tab.c"
+    break;
+
+  case 117: /* extern_func: TOKEN_FUNCAO TOKEN_ID '(' param_list ')' ':' type_def opt_symbol_map  */
+#line 873 "src/parser.y"
+                                                                         {
+        (yyval.node) = ast_new(NODE_FUNC_DEF);
+        (yyval.node)->name = sdsnew((yyvsp[-6].str));
+        (yyval.node)->data_type = (yyvsp[-1].node)->string_value ? sdsnew((yyvsp[-1].node)->string_value) : sdsnew("void");
+        
+        // If opt_symbol_map returns a string node, use it. Else NULL.
+        if ((yyvsp[0].node) && (yyvsp[0].node)->string_value) {
+            (yyval.node)->func_alias = sdsnew((yyvsp[0].node)->string_value);
+        }
+        
+        // Add params
+        for(int i=0; i<arrlen((yyvsp[-4].node)->children); i++) {
+            ast_add_child((yyval.node), (yyvsp[-4].node)->children[i]);
+        }
+        // No body child means it's external/prototype
+    }
+#line 2913 "build/parser.tab.c"
+    break;
+
+  case 118: /* opt_symbol_map: '=' TOKEN_LIT_STRING  */
+#line 892 "src/parser.y"
+                         { 
+        (yyval.node) = ast_new(NODE_LITERAL_STRING);
+        (yyval.node)->string_value = sdsnew((yyvsp[0].str));
+    }
+#line 2922 "build/parser.tab.c"
+    break;
+
+  case 119: /* opt_symbol_map: %empty  */
+#line 896 "src/parser.y"
+                  { (yyval.node) = NULL; }
+#line 2928 "build/parser.tab.c"
+    break;
+
+  case 120: /* array_literal: '[' ']'  */
+#line 900 "src/parser.y"
+            {
+        /* Empty array */
+        (yyval.node) = ast_new(NODE_ARRAY_LITERAL);
+    }
+#line 2937 "build/parser.tab.c"
+    break;
+
+  case 121: /* array_literal: '[' expr_list ']'  */
+#line 904 "src/parser.y"
+                        {
+        /* Array with elements */
+        (yyval.node) = (yyvsp[-1].node); // expr_list already has the children
+    }
+#line 2946 "build/parser.tab.c"
+    break;
+
+  case 122: /* expr_list: expr  */
+#line 911 "src/parser.y"
+         {
+        (yyval.node) = ast_new(NODE_ARRAY_LITERAL);
+        ast_add_child((yyval.node), (yyvsp[0].node));
+    }
+#line 2955 "build/parser.tab.c"
+    break;
+
+  case 123: /* expr_list: expr_list ',' expr  */
+#line 915 "src/parser.y"
+                         {
+        (yyval.node) = (yyvsp[-2].node);
+        ast_add_child((yyval.node), (yyvsp[0].node));
+    }
+#line 2964 "build/parser.tab.c"
+    break;
+
+  case 124: /* arg_list: expr  */
+#line 922 "src/parser.y"
+         {
+        (yyval.node) = ast_new(NODE_BLOCK); // Temp container for arguments
+        ast_add_child((yyval.node), (yyvsp[0].node));
+    }
+#line 2973 "build/parser.tab.c"
+    break;
+
+  case 125: /* arg_list: arg_list ',' expr  */
+#line 926 "src/parser.y"
+                        {
+        (yyval.node) = (yyvsp[-2].node);
+        ast_add_child((yyval.node), (yyvsp[0].node));
+    }
+#line 2982 "build/parser.tab.c"
+    break;
+
+  case 126: /* arg_list: %empty  */
+#line 930 "src/parser.y"
+                  { 
+        (yyval.node) = ast_new(NODE_BLOCK); // Empty argument list
+    }
+#line 2990 "build/parser.tab.c"
+    break;
+
+  case 127: /* prop_access: TOKEN_ID '.' TOKEN_ID  */
+#line 936 "src/parser.y"
+                          {
+        /* Simple property access: arr.len or p.x (without parentheses) */
+        (yyval.node) = ast_new(NODE_PROP_ACCESS);
+        (yyval.node)->name = sdsnew((yyvsp[-2].str));
+        (yyval.node)->data_type = sdsnew((yyvsp[0].str)); // Property Name
+        ASTNode* obj = ast_new(NODE_VAR_REF);
+        obj->name = sdsnew((yyvsp[-2].str));
+        ast_add_child((yyval.node), obj);      // Object
+    }
+#line 3004 "build/parser.tab.c"
+    break;
+
+  case 128: /* prop_access: factor '.' TOKEN_ID  */
+#line 945 "src/parser.y"
+                                            {
+        /* Complex property access: arr[0].len (without parentheses) */
+        (yyval.node) = ast_new(NODE_PROP_ACCESS);
+        (yyval.node)->name = NULL;
+        (yyval.node)->data_type = sdsnew((yyvsp[0].str)); // Property Name
+        ast_add_child((yyval.node), (yyvsp[-2].node));      // Object
+    }
+#line 3016 "build/parser.tab.c"
+    break;
+
+  case 129: /* method_call: TOKEN_ID '.' TOKEN_ID '(' ')'  */
+#line 955 "src/parser.y"
+                                  {
+        /* Method call with no arguments: arr.pop() or p.mover() */
+        (yyval.node) = ast_new(NODE_METHOD_CALL);
+        (yyval.node)->name = sdsnew((yyvsp[-4].str));
+        (yyval.node)->data_type = sdsnew((yyvsp[-2].str)); // Method name
+        ASTNode* obj = ast_new(NODE_VAR_REF);
+        obj->name = sdsnew((yyvsp[-4].str));
+        ast_add_child((yyval.node), obj); // Base expression
+    }
+#line 3030 "build/parser.tab.c"
+    break;
+
+  case 130: /* method_call: TOKEN_ID '.' TOKEN_ID '(' expr ')'  */
+#line 964 "src/parser.y"
+                                         {
+        /* Method call with one argument: arr.push(x) or p.mover(10) */
+        (yyval.node) = ast_new(NODE_METHOD_CALL);
+        (yyval.node)->name = sdsnew((yyvsp[-5].str));
+        (yyval.node)->data_type = sdsnew((yyvsp[-3].str)); // Method name
+        ASTNode* obj = ast_new(NODE_VAR_REF);
+        obj->name = sdsnew((yyvsp[-5].str));
+        ast_add_child((yyval.node), obj); // Base expression
+        ast_add_child((yyval.node), (yyvsp[-1].node)); // Argument
+    }
+#line 3045 "build/parser.tab.c"
+    break;
+
+  case 131: /* method_call: TOKEN_ID '.' TOKEN_ID '(' expr ',' arg_list ')'  */
+#line 974 "src/parser.y"
+                                                      {
+        /* Method call with several arguments: arr.inserir(i, x) or p.mover(dx, dy) */
+        (yyval.node) = ast_new(NODE_METHOD_CALL);
+        (yyval.node)->name = sdsnew((yyvsp[-7].str));
+        (yyval.node)->data_type = sdsnew((yyvsp[-5].str)); // Method name
+        ASTNode* obj = ast_new(NODE_VAR_REF);
+        obj->name = sdsnew((yyvsp[-7].str));
+        ast_add_child((yyval.node), obj); // Base expression
+        ast_add_child((yyval.node), (yyvsp[-3].node)); // First argument
+        for (int i = 0; i < arrlen((yyvsp[-1].node)->children); i++) {
+            ast_add_child((yyval.node), (yyvsp[-1].node)->children[i]);
+        }
+    }
+#line 3063 "build/parser.tab.c"
+    break;
+
+  case 132: /* method_call: factor '.' TOKEN_ID '(' ')'  */
+#line 987 "src/parser.y"
+                                  {
+        /* Method call on complex expression: arr[0].pop() */
+        (yyval.node) = ast_new(NODE_METHOD_CALL);
+        (yyval.node)->name = NULL;
+        (yyval.node)->data_type = sdsnew((yyvsp[-2].str)); // Method name
+        ast_add_child((yyval.node), (yyvsp[-4].node)); // Base expression
+    }
+#line 3075 "build/parser.tab.c"
+    break;
+
+  case 133: /* method_call: factor '.' TOKEN_ID '(' expr ')'  */
+#line 994 "src/parser.y"
+                                       {
+        /* Method call on complex expression with argument: arr[0].push(x) */
+        (yyval.node) = ast_new(NODE_METHOD_CALL);
+        (yyval.node)->name = NULL;
+        (yyval.node)->data_type = sdsnew((yyvsp[-3].str)); // Method name
+        ast_add_child((yyval.node), (yyvsp[-5].node)); // Base expression
+        ast_add_child((yyval.node), (yyvsp[-1].node)); // Argument
+    }
+#line 3088 "build/parser.tab.c"
+    break;
+
+  case 134: /* method_call: factor '.' TOKEN_ID '(' expr ',' arg_list ')'  */
+#line 1002 "src/parser.y"
+                                                    {
+        /* Method call on complex expression with several arguments: p.xs.inserir(i, x) */
+        (yyval.node) = ast_new(NODE_METHOD_CALL);
+        (yyval.node)->name = NULL;
+        (yyval.node)->data_type = sdsnew((yyvsp[-5].str)); // Method name
+        ast_add_child((yyval.node), (yyvsp[-7].node)); // Base expression
+        ast_add_child((yyval.node), (yyvsp[-3].node)); // First argument
+        for (int i = 0; i < arrlen((yyvsp[-1].node)->children); i++) {
+            ast_add_child((yyval.node), (yyvsp[-1].node)->children[i]);
+        }
+    }
+#line 3104 "build/parser.tab.c"
+    break;
+
+
+#line 3108 "build/parser.tab.c"
+
+      default: break;
+    }
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
+
+  YYPOPSTACK (yylen);
+  yylen = 0;
+
+  *++yyvsp = yyval;
+
+  /* Now 'shift' the result of the reduction.  Determine what state
+     that goes to, based on the state we popped back to and the rule
+     number reduced by.  */
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
+
+  goto yynewstate;
+
+
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
+yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
+  /* If not already recovering from an error, report this error.  */
+  if (!yyerrstatus)
+    {
+      ++yynerrs;
+      {
+        yypcontext_t yyctx
+          = {yyssp, yytoken};
+        char const *yymsgp = YY_("syntax error");
+        int yysyntax_error_status;
+        yysyntax_error_status = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+        if (yysyntax_error_status == 0)
+          yymsgp = yymsg;
+        else if (yysyntax_error_status == -1)
+          {
+            if (yymsg != yymsgbuf)
+              YYSTACK_FREE (yymsg);
+            yymsg = YY_CAST (char *,
+                             YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
+            if (yymsg)
+              {
+                yysyntax_error_status
+                  = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+                yymsgp = yymsg;
+              }
+            else
+              {
+                yymsg = yymsgbuf;
+                yymsg_alloc = sizeof yymsgbuf;
+                yysyntax_error_status = YYENOMEM;
+              }
+          }
+        yyerror (yymsgp);
+        if (yysyntax_error_status == YYENOMEM)
+          YYNOMEM;
+      }
+    }
+
+  if (yyerrstatus == 3)
+    {
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
+
+      if (yychar <= YYEOF)
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
+      else
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval);
+          yychar = YYEMPTY;
+        }
+    }
+
+  /* Else will try to reuse lookahead token after shifting the error
+     token.  */
+  goto yyerrlab1;
+
+
+/*---------------------------------------------------.
+| yyerrorlab -- error raised explicitly by YYERROR.  |
+`---------------------------------------------------*/
+yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
+
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYERROR.  */
+  YYPOPSTACK (yylen);
+  yylen = 0;
+  YY_STACK_PRINT (yyss, yyssp);
+  yystate = *yyssp;
+  goto yyerrlab1;
+
+
+/*-------------------------------------------------------------.
+| yyerrlab1 -- common code for both syntax error and YYERROR.  |
+`-------------------------------------------------------------*/
+yyerrlab1:
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
+
+  /* Pop stack until we find a state that shifts the error token.  */
+  for (;;)
+    {
+      yyn = yypact[yystate];
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
+
+      /* Pop the current state because it cannot handle the error token.  */
+      if (yyssp == yyss)
+        YYABORT;
+
+
+      yydestruct ("Error: popping",
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp);
+      YYPOPSTACK (1);
+      yystate = *yyssp;
+      YY_STACK_PRINT (yyss, yyssp);
+    }
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+
+  /* Shift the error token.  */
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
+
+  yystate = yyn;
+  goto yynewstate;
+
+
+/*-------------------------------------.
+| yyacceptlab -- YYACCEPT comes here.  |
+`-------------------------------------*/
+yyacceptlab:
+  yyresult = 0;
+  goto yyreturnlab;
+
+
+/*-----------------------------------.
+| yyabortlab -- YYABORT comes here.  |
+`-----------------------------------*/
+yyabortlab:
+  yyresult = 1;
+  goto yyreturnlab;
+
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
+yyexhaustedlab:
+  yyerror (YY_("memory exhausted"));
+  yyresult = 2;
+  goto yyreturnlab;
+
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYABORT or YYACCEPT.  */
+  YYPOPSTACK (yylen);
+  YY_STACK_PRINT (yyss, yyssp);
+  while (yyssp != yyss)
+    {
+      yydestruct ("Cleanup: popping",
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp);
+      YYPOPSTACK (1);
+    }
+#ifndef yyoverflow
+  if (yyss != yyssa)
+    YYSTACK_FREE (yyss);
+#endif
+  if (yymsg != yymsgbuf)
+    YYSTACK_FREE (yymsg);
+  return yyresult;
+}
+
+#line 1015 "src/parser.y"
+
+
+// Interpolated literals: each "${expr}" / "${expr:fmt}" piece of 'node' is
+// parsed as an expression and appended to its children, in order, so codegen
+// and every analysis see the calls, accesses and names inside the string.
+static void parse_literal_pieces(ASTNode* node) {
+    extern ASTNode* parse_interp_expr(const char* text);
+    for (const char* p = strstr(node->string_value, "${"); p; p = strstr(p, "${")) {
+        const char* start = p + 2;
+        const char* end = start;
+        int depth = 0;
+        while (*end && *end != '}' && !(*end == ':' && depth == 0)) {
+            if (*end == '[' || *end == '(') depth++;
+            if (*end == ']' || *end == ')') depth--;
+            end++;
+        }
+        sds text = sdsnewlen(start, end - start);
+        interp_piece = text;
+        ast_add_child(node, parse_interp_expr(text));
+        interp_piece = NULL;
+        sdsfree(text);
+        while (*end && *end != '}') end++;
+        p = end;
+    }
+}
+
+void parse_interpolations(ASTNode* node) {
+    if (!node) return;
+    if (node->type == NODE_LITERAL_STRING && node->string_value && arrlen(node->children) == 0) {
+        parse_literal_pieces(node);
+        return;
+    }
+    for (int i = 0; i < arrlen(node->children); i++) {
+        parse_interpolations(node->children[i]);
+    }
+    parse_interpolations(node->start);
+    parse_interpolations(node->end);
+    parse_interpolations(node->step);
+}
+
+void yyerror(const char *msg) {
+    if (interp_piece) {
+        fprintf(stderr, "[Basalto] Erro: expressao invalida em '${%s}': %s\n", interp_piece, msg);
+        exit(1);
+    }
+    extern int yycol;
+    fprintf(stderr, "\033[1;31mError:\033[0m %s\n", msg);
+    fprintf(stderr, "   at line %d, column %d\n", yylineno, yycol);
+
+    if (yyin) {
+        // Save current position
+        long saved_pos = ftell(yyin);
+        
+        // Rewind to find the line content
+        fseek(yyin, 0, SEEK_SET);
+        int current_line = 1;
+        char buffer[1024];
+        
+        while (fgets(buffer, sizeof(buffer), yyin)) {
+            if (current_line == yylineno) {
+                // Print code snippet
+                fprintf(stderr, "   | \n");
+                fprintf(stderr, "%3d | %s", current_line, buffer);
+                if (buffer[strlen(buffer)-1] != '\n') fprintf(stderr, "\n"); // Handle EOF without newline
+                
+                // Print pointer caret
+                fprintf(stderr, "   | ");
+                for(int i=1; i<yycol; i++) fprintf(stderr, " ");
+                fprintf(stderr, "\033[1;33m^\033[0m\n");
+                fprintf(stderr, "   | \n");
+                break;
+            }
+            current_line++;
+        }
+        
+        // Restore position
+        fseek(yyin, saved_pos, SEEK_SET);
+    }
+    // Don't exit immediately if you want to try Panic Mode recovery, 
+    // but for now, fail fast is good.
+    exit(1); 
+}
@@ -0,0 +1,119 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison interface for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+#ifndef YY_YY_BUILD_PARSER_TAB_H_INCLUDED
+# define YY_YY_BUILD_PARSER_TAB_H_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 0
+#endif
+#if YYDEBUG
+extern int yydebug;
+#endif
+
+/* Token kinds.  */
+#ifndef YYTOKENTYPE
+# define YYTOKENTYPE
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    TOKEN_ID = 258,                /* TOKEN_ID  */
+    TOKEN_LIT_STRING = 259,        /* TOKEN_LIT_STRING  */
+    TOKEN_LIT_INT = 260,           /* TOKEN_LIT_INT  */
+    TOKEN_LIT_DOUBLE = 261,        /* TOKEN_LIT_DOUBLE  */
+    TOKEN_LIT_FLOAT = 262,         /* TOKEN_LIT_FLOAT  */
+    TOKEN_PROGRAMA = 263,          /* TOKEN_PROGRAMA  */
+    TOKEN_BIBLIOTECA = 264,        /* TOKEN_BIBLIOTECA  */
+    TOKEN_VAR = 265,               /* TOKEN_VAR  */
+    TOKEN_SE = 266,                /* TOKEN_SE  */
+    TOKEN_SENAO = 267,             /* TOKEN_SENAO  */
+    TOKEN_EXTERNO = 268,           /* TOKEN_EXTERNO  */
+    TOKEN_FUNCAO = 269,            /* TOKEN_FUNCAO  */
+    TOKEN_SEMICOLON = 270,         /* TOKEN_SEMICOLON  */
+    TOKEN_ENQUANTO = 271,          /* TOKEN_ENQUANTO  */
+    TOKEN_CADA = 272,              /* TOKEN_CADA  */
+    TOKEN_INFINITO = 273,          /* TOKEN_INFINITO  */
+    TOKEN_PARAR = 274,             /* TOKEN_PARAR  */
+    TOKEN_CONTINUAR = 275,         /* TOKEN_CONTINUAR  */
+    TOKEN_DOTDOT = 276,            /* TOKEN_DOTDOT  */
+    TOKEN_LER = 277,               /* TOKEN_LER  */
+    TOKEN_ESTRUTURA = 278,         /* TOKEN_ESTRUTURA  */
+    TOKEN_ASSERT = 279,            /* TOKEN_ASSERT  */
+    TOKEN_RETORNE = 280,           /* TOKEN_RETORNE  */
+    TOKEN_NULL = 281,              /* TOKEN_NULL  */
+    TOKEN_NEW = 282,               /* TOKEN_NEW  */
+    TOKEN_TRUE = 283,              /* TOKEN_TRUE  */
+    TOKEN_FALSE = 284,             /* TOKEN_FALSE  */
+    TOKEN_EMBED = 285,             /* TOKEN_EMBED  */
+    TOKEN_INTERP = 286,            /* TOKEN_INTERP  */
+    PROP_ACCESS = 287,             /* PROP_ACCESS  */
+    METHOD_CALL = 288              /* METHOD_CALL  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
+#endif
+
+/* Value type.  */
+#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
+union YYSTYPE
+{
+#line 56 "src/parser.y"
+
+    int integer;
+    double double_val;
+    float float_val;
+    char* str;
+    struct ASTNode* node;
+
+#line 105 "build/parser.tab.h"
+
+};
+typedef union YYSTYPE YYSTYPE;
+# define YYSTYPE_IS_TRIVIAL 1
+# define YYSTYPE_IS_DECLARED 1
+#endif
+
+
+extern YYSTYPE yylval;
+
+
+int yyparse (void);
+
+
+#endif /* !YY_YY_BUILD_PARSER_TAB_H_INCLUDED  */
@@ -163,7 +163,7 @@ sds sdsdup(const sds s) {
 
 /* Free an sds string. No operation is performed if 's' is NULL. */
 void sdsfree(sds s) {
-    if (s == NULL) return;
+    if (s == NULL || SDS_IS_STATIC(s)) return;
     s_free((char*)s-sdsHdrSize(s[-1]));
 }
 
@@ -208,6 +208,14 @@ sds sdsMakeRoomFor(sds s, size_t addlen) {
     char type, oldtype = s[-1] & SDS_TYPE_MASK;
     int hdrlen;
 
+    /* Static strings are never written: grow a heap copy. */
+    if (SDS_IS_STATIC(s)) {
+        s = sdsnewlen(s, sdslen(s));
+        if (s == NULL) return NULL;
+        avail = sdsavail(s);
+        oldtype = s[-1] & SDS_TYPE_MASK;
+    }
+
     /* Return ASAP if there is enough space left. */
     if (avail >= addlen) return s;
 
@@ -425,6 +433,7 @@ sds sdscatsds(sds s, const sds t) {
 /* Destructively modify the sds string 's' to hold the specified binary
  * safe string pointed by 't' of length 'len' bytes. */
 sds sdscpylen(sds s, const char *t, size_t len) {
+    if (SDS_IS_STATIC(s)) return sdsnewlen(t, len);
     if (sdsalloc(s) < len) {
         s = sdsMakeRoomFor(s,len-sdslen(s));
         if (s == NULL) return NULL;
@@ -726,6 +735,7 @@ sds sdstrim(sds s, const char *cset) {
     char *end, *sp, *ep;
     size_t len;
 
+    if (SDS_IS_STATIC(s)) s = sdsdup(s);
     sp = s;
     ep = end = s+sdslen(s)-1;
     while(sp <= end && strchr(cset, *sp)) sp++;
@@ -1092,6 +1102,7 @@ err:
 sds sdsmapchars(sds s, const char *from, const char *to, size_t setlen) {
     size_t j, i, l = sdslen(s);
 
+    if (SDS_IS_STATIC(s)) s = sdsdup(s);
     for (j = 0; j < l; j++) {
         for (i = 0; i < setlen; i++) {
             if (s[j] == from[i]) {
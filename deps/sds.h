@@ -80,6 +80,12 @@ struct __attribute__ ((__packed__)) sdshdr64 {
 #define SDS_TYPE_64 4
 #define SDS_TYPE_MASK 7
 #define SDS_TYPE_BITS 3
+/* Basalto: header and bytes are static (string literals in .rodata). Never
+ * set on type 5, whose spare bits hold the length. sdsfree() skips these
+ * strings, and the functions returning an sds write to a heap copy instead
+ * (the in-place void ones, like sdsrange(), need an owned string). */
+#define SDS_STATIC 8
+#define SDS_IS_STATIC(s) (((s)[-1]&SDS_TYPE_MASK) != SDS_TYPE_5 && ((s)[-1]&SDS_STATIC))
 #define SDS_HDR_VAR(T,s) struct sdshdr##T *sh = (void*)((s)-(sizeof(struct sdshdr##T)));
 #define SDS_HDR(T,s) ((struct sdshdr##T *)((s)-(sizeof(struct sdshdr##T))))
 #define SDS_TYPE_5_LEN(f) ((f)>>SDS_TYPE_BITS)
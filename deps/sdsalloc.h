@@ -37,6 +37,16 @@
  * the include of your alternate allocator if needed (not needed in order
  * to use the default libc allocator). */
 
+#ifdef BASALTO_GC
+/* Basalto --gc: strings live in the collector's heap (see runtime/gc.c). */
+void *bs_gc_malloc_leaf(size_t size);
+void *bs_gc_realloc_leaf(void *ptr, size_t size);
+void bs_gc_free(void *ptr);
+#define s_malloc bs_gc_malloc_leaf
+#define s_realloc bs_gc_realloc_leaf
+#define s_free bs_gc_free
+#else
 #define s_malloc malloc
 #define s_realloc realloc
 #define s_free free
+#endif
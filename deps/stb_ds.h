@@ -1015,6 +1015,9 @@ static stbds_hash_index *stbds_make_hash_index(size_t slot_count, stbds_hash_ind
 
 size_t stbds_hash_string(char *str, size_t seed)
 {
+#ifdef STBDS_HASH_STRING
+  return STBDS_HASH_STRING(str, seed);
+#else
   size_t hash = seed;
   while (*str)
      hash = STBDS_ROTATE_LEFT(hash, 9) + (unsigned char) *str++;
@@ -1028,6 +1031,7 @@ size_t stbds_hash_string(char *str, size_t seed)
   hash += (hash << 6);
   hash ^= STBDS_ROTATE_RIGHT(hash,22);
   return hash+seed;
+#endif
 }
 
 #ifdef STBDS_SIPHASH_2_4
@@ -52,6 +52,10 @@ int main(int argc, char **argv)
         fclose(embed_h);
         return 1;
     }
+    if (!generate_embedded_header("src/runtime/gc.c", "SRC_GC_C", embed_h)) {
+        fclose(embed_h);
+        return 1;
+    }
     if (!generate_embedded_header("deps/sds.h", "SRC_SDS_H", embed_h)) {
         fclose(embed_h);
         return 1;
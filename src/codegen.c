@@ -1,11 +1,18 @@
 #include <stdio.h>
 #include <stdbool.h>
+#include <stdlib.h>
 #include <string.h>
 #include "ast.h"
 #include "symtable.h"
 
 extern StructRegistryEntry *type_registry;
 
+// Set by main.c when compiling with --gc
+extern bool gc_mode;
+
+// Set by main.c with --relatorio-layout
+extern bool layout_report;
+
 // Helper to count array brackets and extract base type
 static int count_array_depth(const char *type, const char **base_type)
 {
@@ -38,9 +45,297 @@ static int count_array_depth(const char *type, const char **base_type)
     return depth;
 }
 
+// Helper: is 'type' a slice view ("fatia[inteiro32]")?
+static bool is_fatia_type(const char *type)
+{
+    return type && strncmp(type, "fatia[", 6) == 0;
+}
+
+// Helper: is 'type' a contiguous matrix ("matriz[real64]")?
+static bool is_matriz_type(const char *type)
+{
+    return type && strncmp(type, "matriz[", 7) == 0;
+}
+
+// Helper: is 'type' a packed bitset ("bits")?
+static bool is_bits_type(const char *type)
+{
+    return type && strcmp(type, "bits") == 0;
+}
+
+// Helper: is 'type' a packed string array ("[texto; compacto]" is stored as "compacto[texto]")?
+static bool is_compacto_type(const char *type)
+{
+    return type && strncmp(type, "compacto[", 9) == 0;
+}
+
+// Helper: is 'type' a borrowed string view ("fatia_texto")?
+static bool is_fatia_texto_type(const char *type)
+{
+    return type && strcmp(type, "fatia_texto") == 0;
+}
+
+// Helper: is 'type' a string builder ("construtor_texto")?
+static bool is_construtor_type(const char *type)
+{
+    return type && strcmp(type, "construtor_texto") == 0;
+}
+
+// Helper: element type of a matrix type ("matriz[T]" -> "T"), NULL otherwise
+static sds matriz_element(const char *type)
+{
+    if (!is_matriz_type(type) || strlen(type) < 8)
+        return NULL;
+    return sdsnewlen(type + 7, strlen(type) - 8);
+}
+
+// Helper: is 'type' a fixed-size array ("[inteiro32; 16]" is stored as "fixo[inteiro32;16]")?
+static bool is_fixo_type(const char *type)
+{
+    return type && strncmp(type, "fixo[", 5) == 0;
+}
+
+// Helper: is 'type' a small array ("[Pessoa; ate 4]" is stored as "pequeno[Pessoa;4]")?
+static bool is_pequeno_type(const char *type)
+{
+    return type && strncmp(type, "pequeno[", 8) == 0;
+}
+
+// Source text of an expression (defined with the MAPS helpers)
+static sds codegen_to_sds(ASTNode *node);
+
+// Small array helpers used before their section (see SMALL ARRAYS)
+static sds pequeno_display(const char *type);
+static sds pequeno_ref(ASTNode *node);
+
+// String helpers used before their sections (see STRING VIEWS, PACKED STRING ARRAYS, STRING BUILDERS)
+static bool is_conversao_numero(const char *method);
+static const char *textos_array_kind(const char *type);
+static void codegen_as_fatia_texto(ASTNode *expr, FILE *file);
+static const char *texto_method_result(const char *type, const char *method);
+static void codegen_as_fatia_texto(ASTNode *expr, FILE *file);
+static void codegen_compacto_from(ASTNode *expr, FILE *file);
+static bool is_string_operand(ASTNode *node);
+static bool is_primitive_type(const char *type);
+
+// Input helper used before its section (see INPUT (ler))
+static bool is_ler_em_bloco(ASTNode *call);
+
+// Helper: compile-time length of a fixed-size array type (inline capacity of a small array)
+static int fixo_length(const char *type)
+{
+    const char *sep = strrchr(type, ';');
+    return sep ? atoi(sep + 1) : 0;
+}
+
+// Helper: element type of an array, slice, fixed or small array type
+// ("[T]" / "fatia[T]" / "fixo[T;N]" / "pequeno[T;N]" -> "T"), NULL otherwise
+static sds sequence_element(const char *type)
+{
+    if (!type)
+        return NULL;
+    size_t len = strlen(type);
+    if (type[0] == '[' && len >= 2)
+        return sdsnewlen(type + 1, len - 2);
+    if (is_fatia_type(type) && len >= 7)
+        return sdsnewlen(type + 6, len - 7);
+    if (is_fixo_type(type) && strrchr(type, ';'))
+        return sdsnewlen(type + 5, strrchr(type, ';') - (type + 5));
+    if (is_pequeno_type(type) && strrchr(type, ';'))
+        return sdsnewlen(type + 8, strrchr(type, ';') - (type + 8));
+    return NULL;
+}
+
+// Helper: is 'type' a hash map ("mapa[K,V]")?
+static bool is_mapa_type(const char *type)
+{
+    return type && strncmp(type, "mapa[", 5) == 0;
+}
+
+// Helper: is 'type' a hash set ("conjunto[T]")?
+static bool is_conjunto_type(const char *type)
+{
+    return type && strncmp(type, "conjunto[", 9) == 0;
+}
+
+// Helper: is 'type' a counting bag ("contador[T]", a map from T to inteiro64)?
+static bool is_contador_type(const char *type)
+{
+    return type && strncmp(type, "contador[", 9) == 0;
+}
+
+// Helper: is 'type' one of the stb_ds hash containers (mapa, conjunto, contador)?
+static bool is_hash_type(const char *type)
+{
+    return is_mapa_type(type) || is_conjunto_type(type) || is_contador_type(type);
+}
+
+// Helper: is 'type' a ring-buffer deque ("fila[T]")?
+static bool is_fila_type(const char *type)
+{
+    return type && strncmp(type, "fila[", 5) == 0;
+}
+
+// Helper: is 'type' a binary heap ("fila_prioridade[T]" or "fila_prioridade[T,ordem]")?
+static bool is_fila_prioridade_type(const char *type)
+{
+    return type && strncmp(type, "fila_prioridade[", 16) == 0;
+}
+
+// Helper: is 'name' a map, set, counter or queue parameter? Those are bound as
+// "T*": growing them may move the table, so the caller passes its variable by address
+static bool is_container_param(const char *name)
+{
+    const char *type = name ? scope_lookup(name) : NULL;
+    return type && type[strlen(type) - 1] == '*' &&
+           (is_hash_type(type) || is_fila_type(type) || is_fila_prioridade_type(type));
+}
+
+// Helper: element type (part 0) or ordering (part 1, NULL if absent) of a queue type
+static sds fila_part(const char *type, int part)
+{
+    if (!is_fila_type(type) && !is_fila_prioridade_type(type))
+        return NULL;
+    const char *start = strchr(type, '[') + 1;
+    const char *end = type + strlen(type) - 1; // Closing ']'
+    int depth = 0;
+    for (const char *c = start; c < end; c++)
+    {
+        if (*c == '[')
+            depth++;
+        else if (*c == ']')
+            depth--;
+        else if (*c == ',' && depth == 0)
+            return part == 0 ? sdsnewlen(start, c - start) : sdsnewlen(c + 1, end - (c + 1));
+    }
+    return part == 0 ? sdsnewlen(start, end - start) : NULL;
+}
+
+// Helper: key (part 0) or value (part 1) type of a hash container, NULL otherwise
+// ("mapa[K,V]" -> K / V, "contador[T]" -> T / inteiro64, "conjunto[T]" -> T / NULL)
+static sds mapa_part(const char *type, int part)
+{
+    if (!is_hash_type(type))
+        return NULL;
+    const char *start = strchr(type, '[') + 1;
+    const char *end = type + strlen(type) - 1; // Closing ']'
+    if (!is_mapa_type(type))
+    {
+        if (part == 0)
+            return sdsnewlen(start, end - start);
+        return is_contador_type(type) ? sdsnew("inteiro64") : NULL;
+    }
+    int depth = 0;
+    for (const char *c = start; c < end; c++)
+    {
+        if (*c == '[')
+            depth++;
+        else if (*c == ']')
+            depth--;
+        else if (*c == ',' && depth == 0)
+            return part == 0 ? sdsnewlen(start, c - start) : sdsnewlen(c + 1, end - (c + 1));
+    }
+    return NULL;
+}
+
+// Helper: C name of the entry struct of a hash container
+// ("mapa[texto,inteiro32]" -> "BsMapa_texto_inteiro32", "conjunto[inteiro32]" -> "BsConjunto_inteiro32")
+static sds mapa_c_name(const char *type)
+{
+    sds name = sdsnew(is_mapa_type(type) ? "BsMapa_" : is_conjunto_type(type) ? "BsConjunto_" : "BsContador_");
+    const char *end = type + strlen(type) - 1;
+    for (const char *c = strchr(type, '[') + 1; c < end; c++)
+    {
+        bool ident = (*c >= 'a' && *c <= 'z') || (*c >= 'A' && *c <= 'Z') || (*c >= '0' && *c <= '9') || *c == '_';
+        name = sdscatlen(name, ident ? c : "_", 1);
+    }
+    return name;
+}
+
+// Helper: C struct of a small array type ("pequeno[Pessoa;4]" -> "BsPequeno_Pessoa_4")
+static sds pequeno_c_name(const char *type)
+{
+    sds name = sdsnew("BsPequeno_");
+    const char *end = strrchr(type, ']');
+    for (const char *c = type + 8; c < end; c++)
+    {
+        bool ident = (*c >= 'a' && *c <= 'z') || (*c >= 'A' && *c <= 'Z') || (*c >= '0' && *c <= '9') || *c == '_';
+        name = sdscatlen(name, ident ? c : "_", 1);
+    }
+    return name;
+}
+
 // Helper to map VisualG types to C types
 const char *map_type(const char *type)
 {
+    // Slice views share one runtime type (see basalto.h)
+    if (is_fatia_type(type))
+    {
+        return "BsFatia";
+    }
+    if (is_matriz_type(type))
+    {
+        return "BsMatriz";
+    }
+    if (is_bits_type(type))
+    {
+        return "BsBits";
+    }
+    if (is_fatia_texto_type(type))
+    {
+        return "BsFatiaTexto";
+    }
+    if (is_compacto_type(type))
+    {
+        return "BsTextos*";
+    }
+    if (is_construtor_type(type))
+    {
+        return "BsConstrutor*";
+    }
+    // Small arrays are a per-type struct with inline storage (see SMALL ARRAYS)
+    if (is_pequeno_type(type))
+    {
+        static char pequeno_result[256];
+        sds name = pequeno_c_name(type);
+        snprintf(pequeno_result, sizeof(pequeno_result), "%s", name);
+        sdsfree(name);
+        return pequeno_result;
+    }
+    // Deques share one runtime header (see basalto.h); heaps are plain [T] buffers
+    if (is_fila_type(type))
+    {
+        return "BsFila*";
+    }
+    if (is_fila_prioridade_type(type))
+    {
+        sds elem = fila_part(type, 0);
+        sds array = sdscatprintf(sdsempty(), "[%s]", elem);
+        const char *result = map_type(array);
+        sdsfree(elem);
+        sdsfree(array);
+        return result;
+    }
+    // Maps, sets and counters are stb_ds hash maps: a pointer to their entries (see MAPS)
+    if (is_hash_type(type))
+    {
+        static char mapa_result[256];
+        sds name = mapa_c_name(type);
+        snprintf(mapa_result, sizeof(mapa_result), "%s*", name);
+        sdsfree(name);
+        return mapa_result;
+    }
+    // Fixed arrays are declared as 'T name[N]' (see fixo_declaration); elsewhere they decay to T*
+    if (is_fixo_type(type))
+    {
+        static char fixo_result[256];
+        sds elem = sequence_element(type);
+        bool reference = is_struct_type(elem) && !is_value_struct(elem);
+        snprintf(fixo_result, sizeof(fixo_result), "%s%s*", map_type(elem), reference ? "*" : "");
+        sdsfree(elem);
+        return fixo_result;
+    }
+
     // Check if it's an array type (starts with '[')
     if (type && type[0] == '[')
     {
@@ -53,6 +348,17 @@ const char *map_type(const char *type)
         // Build pointer type based on depth
         static char result[256];
         strcpy(result, c_base);
+        // @soa: the innermost array level is a column set ([Particula] -> Particula_soa)
+        if (is_soa_struct(base_type))
+        {
+            strcat(result, "_soa");
+            depth--;
+        }
+        // REFERENCE SEMANTICS: [Pessoa] holds Pessoa* elements; value structs are stored inline
+        else if (is_struct_type(base_type) && !is_value_struct(base_type))
+        {
+            strcat(result, "*");
+        }
         for (int i = 0; i < depth; i++)
         {
             strcat(result, "*");
@@ -84,7 +390,7 @@ const char *map_type(const char *type)
         {"real64", "double"},
         {"real_ext", "long double"},
 
-        {"booleano", "int"},
+        {"booleano", "_Bool"},
         {"texto", "char*"},
         {"caractere", "char"},
         {"ponteiro", "void*"},
@@ -100,7 +406,7 @@ const char *map_type(const char *type)
         {"n64", "unsigned long long"},
         {"n16", "unsigned short"},
 
-        {"bool", "int"},
+        {"bool", "_Bool"},
         {"r32", "float"},
         {"r64", "double"},
         {"r_ext", "long double"},
@@ -126,383 +432,4189 @@ const char *map_type(const char *type)
     return "void"; // fallback
 }
 
+// C type of a foreign ('externo') signature: booleano keeps the 'int' of C predicates
+static const char *ffi_type(const char *type)
+{
+    const char *c_type = map_type(type);
+    return strcmp(c_type, "_Bool") == 0 ? "int" : c_type;
+}
+
 // Forward declaration
 void codegen(ASTNode *node, FILE *file);
 
-// Helper to generate function signatures (e.g. "int sum(int a, int b)")
-void codegen_func_signature(ASTNode *node, FILE *file)
+// Function definitions by name (filled before any function body is generated)
+typedef struct
 {
-    // If return type is a struct, make it a pointer by default
-    // Heuristic: struct-returning functions often return pointers (especially with recursive structs)
-    const char *return_type = map_type(node->data_type);
-    // Check if it's a struct type by checking the type registry directly
-    int is_struct = 0;
-    if (node->data_type && type_registry)
+    char *key;      // Function name
+    ASTNode *value; // NODE_FUNC_DEF
+} FuncDefEntry;
+
+static FuncDefEntry *func_defs = NULL;
+static ASTNode *current_function = NULL; // NODE_FUNC_DEF whose body is being generated
+static bool library_mode = false;        // Generating a 'biblioteca': its functions are called through FFI
+
+// Struct definitions by name (filled at PASS 1, used for layout decisions)
+typedef struct
+{
+    char *key;      // Struct name
+    ASTNode *value; // NODE_STRUCT_DEF
+} StructDefEntry;
+
+static StructDefEntry *struct_defs = NULL;
+
+// Helpers instantiated on demand (per element type) while generating function
+// bodies. They are written here and emitted ahead of those bodies (see PASS 3).
+static FILE *helper_file = NULL;
+static struct
+{
+    char *key;
+    int value;
+} *helper_names = NULL;
+
+// Claims helper 'name': true the first time, when its code must be written to helper_file
+static bool helper_needed(const char *name)
+{
+    if (!helper_names)
+        sh_new_strdup(helper_names);
+    if (shgeti(helper_names, name) >= 0)
+        return false;
+    shput(helper_names, name, 1);
+    return true;
+}
+
+// Helper: Basalto type of an expression ("Ponto", "[inteiro32]"...), NULL if unknown
+// Pointer markers ('*') used by the symbol table are stripped.
+static const char *infer_type(ASTNode *node)
+{
+    if (!node)
+        return NULL;
+
+    switch (node->type)
     {
-        FieldEntry *fields = shget(type_registry, node->data_type);
-        if (fields != NULL)
+    case NODE_LITERAL_INT:
+        return "inteiro32";
+    case NODE_LITERAL_DOUBLE:
+        return "real64";
+    case NODE_LITERAL_FLOAT:
+        return "real32";
+    case NODE_LITERAL_STRING:
+        return "texto";
+    case NODE_LITERAL_BOOL:
+        return "booleano";
+    case NODE_NEW:
+        return node->data_type;
+    case NODE_FUNC_CALL:
+    {
+        ASTNode *func = node->name ? shget(func_defs, node->name) : NULL;
+        if (!func && node->name && strcmp(node->name, "bits") == 0)
+            return "bits";
+        if (!func && node->name && strcmp(node->name, "erro_conversao") == 0)
+            return "inteiro32";
+        if (is_ler_em_bloco(node))
+            return strcmp(node->name, "ler_linhas") == 0 ? "[texto]" : strcmp(node->name, "ler_reais") == 0 ? "[real64]" : "[inteiro64]";
+        return func ? func->data_type : NULL;
+    }
+    case NODE_VAR_REF:
+    {
+        char *type = node->name ? scope_lookup(node->name) : NULL;
+        if (!type)
+            return NULL;
+        size_t len = strlen(type);
+        if (len > 0 && type[len - 1] == '*')
         {
-            is_struct = 1;
+            sds base = sdsnewlen(type, len - 1);
+            return base;
         }
+        return type;
     }
-    // Also check if map_type returned the same string (fallback)
-    if (!is_struct && node->data_type && return_type && strcmp(return_type, node->data_type) == 0 && strcmp(return_type, "void") != 0)
+    case NODE_PROP_ACCESS:
+    {
+        const char *obj_type = arrlen(node->children) > 0 ? infer_type(node->children[0]) : NULL;
+        if (!obj_type || !node->data_type)
+            return NULL;
+        if (is_struct_type(obj_type))
+            return lookup_field_type(obj_type, node->data_type);
+        if ((obj_type[0] == '[' || is_fixo_type(obj_type) || is_pequeno_type(obj_type)) &&
+            (strcmp(node->data_type, "len") == 0 || strcmp(node->data_type, "capacidade") == 0))
+            return "inteiro64";
+        if (is_matriz_type(obj_type) && (strcmp(node->data_type, "linhas") == 0 || strcmp(node->data_type, "colunas") == 0))
+            return "inteiro64";
+        if ((is_bits_type(obj_type) || is_compacto_type(obj_type) || is_fatia_texto_type(obj_type) || is_construtor_type(obj_type) ||
+             strcmp(obj_type, "texto") == 0) &&
+            strcmp(node->data_type, "len") == 0)
+            return "inteiro64";
+        return NULL;
+    }
+    case NODE_ARRAY_ACCESS:
+    {
+        const char *array_type = NULL;
+        int index_count = arrlen(node->children);
+        if (node->name)
+        {
+            ASTNode base = {0};
+            base.type = NODE_VAR_REF;
+            base.name = node->name;
+            array_type = infer_type(&base);
+        }
+        else if (index_count > 0)
+        {
+            array_type = infer_type(node->children[0]);
+            index_count--;
+        }
+        if (is_bits_type(array_type) && index_count == 1)
+            return "booleano";
+        if (is_compacto_type(array_type) && index_count == 1)
+            return "fatia_texto";
+        // Matrix: m[i] is a row view, m[i][j] an element (through the view)
+        sds row_elem = matriz_element(array_type);
+        if (row_elem && index_count == 1)
+        {
+            sds row = sdscatprintf(sdsempty(), "fatia[%s]", row_elem);
+            sdsfree(row_elem);
+            return row;
+        }
+        sdsfree(row_elem);
+        // Element type: strip one bracket level
+        sds elem = sequence_element(array_type);
+        if (!elem)
+            return NULL;
+        if (index_count == 2)
+            return sdscatprintf(sdsempty(), "fatia[%s]", elem); // Slices are views
+        return elem;
+    }
+    case NODE_METHOD_CALL:
+    {
+        const char *obj_type = arrlen(node->children) > 0 ? infer_type(node->children[0]) : NULL;
+        if (node->data_type && strcmp(node->data_type, "texto") == 0)
+            return "texto";
+        if (node->data_type && is_conversao_numero(node->data_type))
+            return node->data_type;
+        if (node->data_type && textos_array_kind(obj_type) && strcmp(node->data_type, "inteiros") == 0)
+            return "[inteiro64]";
+        if (node->data_type && textos_array_kind(obj_type) && strcmp(node->data_type, "reais") == 0)
+            return "[real64]";
+        if (obj_type && obj_type[0] == '[' && node->data_type && strcmp(node->data_type, "pop") == 0)
+            return sdsnewlen(obj_type + 1, strlen(obj_type) - 2);
+        sds elem = sequence_element(obj_type);
+        if (elem && node->data_type && strcmp(node->data_type, "copiar") == 0)
+            return sdscatprintf(sdsempty(), "[%s]", elem);
+        if (elem && node->data_type && strcmp(node->data_type, "capacidade") == 0)
+            return "inteiro64";
+        if (is_pequeno_type(obj_type) && node->data_type && strcmp(node->data_type, "pop") == 0)
+            return elem;
+        if (is_pequeno_type(obj_type) && node->data_type && strcmp(node->data_type, "len") == 0)
+            return "inteiro64";
+        if (elem && node->data_type && (strcmp(node->data_type, "busca_binaria") == 0 || strcmp(node->data_type, "particionar") == 0))
+            return "inteiro64";
+        if ((is_fila_type(obj_type) || is_fila_prioridade_type(obj_type)) && node->data_type)
+        {
+            const char *m = node->data_type;
+            if (strcmp(m, "pop") == 0 || strcmp(m, "pop_frente") == 0 || strcmp(m, "frente") == 0 ||
+                strcmp(m, "fim") == 0 || strcmp(m, "topo") == 0)
+                return fila_part(obj_type, 0);
+            if (strcmp(m, "len") == 0)
+                return "inteiro64";
+            if (strcmp(m, "vazia") == 0)
+                return "booleano";
+        }
+        if (is_bits_type(obj_type) && node->data_type)
+        {
+            if (strcmp(node->data_type, "len") == 0 || strcmp(node->data_type, "contar") == 0 ||
+                strcmp(node->data_type, "proximo") == 0)
+                return "inteiro64";
+            if (strcmp(node->data_type, "copiar") == 0)
+                return "bits";
+        }
+        if ((is_compacto_type(obj_type) || is_fatia_texto_type(obj_type) || is_construtor_type(obj_type)) && node->data_type &&
+            strcmp(node->data_type, "len") == 0)
+            return "inteiro64";
+        if (is_compacto_type(obj_type) && node->data_type && strcmp(node->data_type, "pop") == 0)
+            return "fatia_texto";
+        if (is_compacto_type(obj_type) && node->data_type && strcmp(node->data_type, "copiar") == 0)
+            return obj_type;
+        if (node->data_type && texto_method_result(obj_type, node->data_type))
+            return texto_method_result(obj_type, node->data_type);
+        if (is_hash_type(obj_type) && node->data_type)
+        {
+            if (strcmp(node->data_type, "obter") == 0 || strcmp(node->data_type, "contar") == 0)
+                return mapa_part(obj_type, 1);
+            if (strcmp(node->data_type, "contem") == 0 || strcmp(node->data_type, "remover") == 0)
+                return "booleano";
+            if (strcmp(node->data_type, "len") == 0)
+                return "inteiro64";
+            if (strcmp(node->data_type, "uniao") == 0 || strcmp(node->data_type, "intersecao") == 0 ||
+                strcmp(node->data_type, "diferenca") == 0)
+                return obj_type;
+        }
+        return NULL;
+    }
+    default:
+        return NULL;
+    }
+}
+
+// Helper: Does this expression evaluate to a pointer to a struct (use '->')?
+// Reference structs are always pointers; value structs only when the symbol
+// table says so (e.g. 'eu' parameters). Unknown types keep the old default.
+static bool expr_is_struct_pointer(ASTNode *node)
+{
+    if (node->type == NODE_VAR_REF && node->name)
+    {
+        char *var_type = scope_lookup(node->name);
+        if (!var_type)
+            return false;
+        size_t len = strlen(var_type);
+        if (len > 0 && var_type[len - 1] == '*')
+            return true;
+        return is_struct_type(var_type) && !is_value_struct(var_type);
+    }
+    const char *type = infer_type(node);
+    if (type && is_value_struct(type))
+        return false;
+    // Fields holding a matrix, slice, ... are values too (img.px.colunas)
+    if (type && type[strlen(type) - 1] != '*' && !is_struct_type(type))
+        return false;
+    return true;
+}
+
+// --- STRUCT OF ARRAYS (@soa) ---
+// [T] of a @soa struct is a 'T_soa' value holding one stb_ds column per field.
+// arr[i].campo is lowered straight to the column (arr.campo[i]); whole elements
+// go through the T_soa_get/set/push/pop/len helpers emitted in PASS 1.
+
+// Helper: @soa element type of an array type ("[Particula]" -> "Particula"), NULL otherwise
+static sds soa_element(const char *array_type)
+{
+    if (!array_type || array_type[0] != '[' || array_type[1] == '[')
+        return NULL;
+    sds elem = sdsnewlen(array_type + 1, strlen(array_type) - 2);
+    if (is_soa_struct(elem))
+        return elem;
+    sdsfree(elem);
+    return NULL;
+}
+
+// Helper: is 'access' a single element access arr[i] into a @soa array?
+// On success returns the element type and splits the node into array and index.
+static sds soa_element_access(ASTNode *access, ASTNode **array, ASTNode **index)
+{
+    if (!access || access->type != NODE_ARRAY_ACCESS)
+        return NULL;
+    if (access->name && arrlen(access->children) == 1)
+    {
+        *array = ast_new(NODE_VAR_REF);
+        (*array)->name = sdsnew(access->name);
+        *index = access->children[0];
+    }
+    else if (!access->name && arrlen(access->children) == 2)
+    {
+        *array = access->children[0];
+        *index = access->children[1];
+    }
+    else
+    {
+        return NULL;
+    }
+    return soa_element(infer_type(*array));
+}
+
+// Helper: C type of a struct field as laid out in memory
+// ([Pessoa] -> Pessoa**, Node -> Node*, Ponto (valor) -> Ponto, texto -> char*)
+static sds field_c_type(const char *field_type)
+{
+    if (field_type[0] != '[' && is_struct_type(field_type) && !is_value_struct(field_type))
+        return sdscatprintf(sdsempty(), "%s*", field_type);
+    return sdsnew(map_type(field_type));
+}
+
+// Column layout: 'typedef struct T_soa { double *x; ... } T_soa;'
+static void codegen_soa_typedef(ASTNode *def, FILE *file)
+{
+    fprintf(file, "typedef struct %s_soa {\n", def->name);
+    for (int i = 0; i < arrlen(def->children); i++)
+    {
+        sds c_type = field_c_type(def->children[i]->data_type);
+        fprintf(file, "    %s *%s;\n", c_type, def->children[i]->name);
+        sdsfree(c_type);
+    }
+    fprintf(file, "} %s_soa;\n\n", def->name);
+}
+
+// Element helpers (need the complete element type, so emitted after all structs)
+static void codegen_soa_helpers(ASTNode *def, FILE *file)
+{
+    const char *t = def->name;
+    int n = arrlen(def->children);
+    // The first column carries the length (all columns grow together)
+    if (n > 0)
+        fprintf(file, "static inline long long %s_soa_len(%s_soa a) { return arrlen(a.%s); }\n",
+                t, t, def->children[0]->name);
+    else
+        fprintf(file, "static inline long long %s_soa_len(%s_soa a) { (void)a; return 0; }\n", t, t);
+
+    fprintf(file, "static inline %s %s_soa_get(%s_soa a, long long i) {\n    %s v;\n", t, t, t, t);
+    for (int i = 0; i < n; i++)
+        fprintf(file, "    v.%s = a.%s[i];\n", def->children[i]->name, def->children[i]->name);
+    fprintf(file, "    return v;\n}\n");
+
+    fprintf(file, "static inline void %s_soa_set(%s_soa *a, long long i, %s v) {\n", t, t, t);
+    for (int i = 0; i < n; i++)
+        fprintf(file, "    a->%s[i] = v.%s;\n", def->children[i]->name, def->children[i]->name);
+    fprintf(file, "}\n");
+
+    fprintf(file, "static inline void %s_soa_push(%s_soa *a, %s v) {\n", t, t, t);
+    for (int i = 0; i < n; i++)
+        fprintf(file, "    arrput(a->%s, v.%s);\n", def->children[i]->name, def->children[i]->name);
+    fprintf(file, "}\n");
+
+    fprintf(file, "static inline %s %s_soa_pop(%s_soa *a) {\n    %s v;\n", t, t, t, t);
+    for (int i = 0; i < n; i++)
+        fprintf(file, "    v.%s = arrpop(a->%s);\n", def->children[i]->name, def->children[i]->name);
+    fprintf(file, "    return v;\n}\n\n");
+}
+
+// --- MATRICES (matriz[T]) ---
+// A matriz[T] is one zeroed row-major buffer (BsMatriz in basalto.h) instead of
+// an array of row arrays: m[i][j] lowers to ((T *)m.dados)[i * m.colunas + j]
+// and m[i] is a fatia[T] over row i.
+
+// 'matriz(l, c)' / 'var m: matriz[T](l, c)' (a call unless the program defines 'matriz')
+static bool is_matriz_new(ASTNode *expr)
+{
+    return expr && expr->type == NODE_FUNC_CALL && expr->name && strcmp(expr->name, "matriz") == 0 &&
+           !shget(func_defs, "matriz");
+}
+
+static void codegen_matriz_new(const char *type, ASTNode *dims, FILE *file)
+{
+    if (arrlen(dims->children) != 2)
+    {
+        fprintf(stderr, "[Basalto] Erro: matriz(linhas, colunas) espera 2 argumentos, recebeu %d.\n", (int)arrlen(dims->children));
+        exit(1);
+    }
+    sds elem = matriz_element(type);
+    sds c_elem = field_c_type(elem);
+    // Numeric elements are never traced by the collector
+    bool leaf = !strchr(c_elem, '*') && !is_struct_type(elem);
+    fprintf(file, "bs_matriz(");
+    codegen(dims->children[0], file);
+    fprintf(file, ", ");
+    codegen(dims->children[1], file);
+    fprintf(file, ", sizeof(%s), %d)", c_elem, leaf ? 1 : 0);
+    sdsfree(elem);
+    sdsfree(c_elem);
+}
+
+// Is 'node' a row access m[i] of a matrix? Splits it into the matrix and the row index
+static bool matriz_row_access(ASTNode *node, ASTNode **matriz, ASTNode **row)
+{
+    if (!node || node->type != NODE_ARRAY_ACCESS)
+        return false;
+    ASTNode *base = NULL;
+    if (node->name && arrlen(node->children) == 1)
+    {
+        base = ast_new(NODE_VAR_REF);
+        base->name = sdsnew(node->name);
+        *row = node->children[0];
+    }
+    else if (!node->name && arrlen(node->children) == 2)
+    {
+        base = node->children[0];
+        *row = node->children[1];
+    }
+    if (!base || !is_matriz_type(infer_type(base)))
+        return false;
+    *matriz = base;
+    return true;
+}
+
+// Row view m[i]
+static void codegen_matriz_row(ASTNode *base, ASTNode *row, FILE *file)
+{
+    sds elem = matriz_element(infer_type(base));
+    sds c_elem = field_c_type(elem);
+    fprintf(file, "({ BsMatriz _mr = ");
+    codegen(base, file);
+    fprintf(file, "; BsFatia _linha = { (%s *)_mr.dados + (", c_elem);
+    codegen(row, file);
+    fprintf(file, ") * _mr.colunas, _mr.colunas, 1 }; _linha; })");
+    sdsfree(elem);
+    sdsfree(c_elem);
+}
+
+// Element m[i][j]
+static void codegen_matriz_index(ASTNode *base, ASTNode *row, ASTNode *col, FILE *file)
+{
+    sds elem = matriz_element(infer_type(base));
+    sds c_elem = field_c_type(elem);
+    fprintf(file, "((%s *)(", c_elem);
+    codegen(base, file);
+    fprintf(file, ").dados)[(");
+    codegen(row, file);
+    fprintf(file, ") * (");
+    codegen(base, file);
+    fprintf(file, ").colunas + (");
+    codegen(col, file);
+    fprintf(file, ")]");
+    sdsfree(elem);
+    sdsfree(c_elem);
+}
+
+// --- BITSETS (bits) ---
+// 'bits' packs one booleano per bit into 64-bit words (BsBits in basalto.h).
+// b[i] is a shift and a mask; counting, searching and the set operations run
+// a word at a time in the runtime (popcount, count-trailing-zeros, &, |, ^).
+
+// 'bits(n)' / 'var b: bits(n)' (a call unless the program defines 'bits')
+static bool is_bits_new(ASTNode *expr)
+{
+    return expr && expr->type == NODE_FUNC_CALL && expr->name && strcmp(expr->name, "bits") == 0 &&
+           !shget(func_defs, "bits");
+}
+
+static void codegen_bits_new(ASTNode *size, FILE *file)
+{
+    if (arrlen(size->children) != 1)
+    {
+        fprintf(stderr, "[Basalto] Erro: bits(n) espera 1 argumento, recebeu %d.\n", (int)arrlen(size->children));
+        exit(1);
+    }
+    fprintf(file, "bs_bits(");
+    codegen(size->children[0], file);
+    fprintf(file, ")");
+}
+
+// Is 'node' a single bit b[i]? Splits it into the bitset and the index
+static bool bits_access(ASTNode *node, ASTNode **bits, ASTNode **index)
+{
+    if (!node || node->type != NODE_ARRAY_ACCESS)
+        return false;
+    ASTNode *base = NULL;
+    if (node->name && arrlen(node->children) == 1)
+    {
+        base = ast_new(NODE_VAR_REF);
+        base->name = sdsnew(node->name);
+        *index = node->children[0];
+    }
+    else if (!node->name && arrlen(node->children) == 2)
+    {
+        base = node->children[0];
+        *index = node->children[1];
+    }
+    if (!base || !is_bits_type(infer_type(base)))
+        return false;
+    *bits = base;
+    return true;
+}
+
+static const struct
+{
+    const char *name;
+    int arity;
+    const char *runtime; // bs_bits_* function taking the bitset first
+    const char *extra;   // Trailing constant argument, if any
+} bits_methods[] = {
+    {"contar", 0, "bs_bits_contar", NULL},
+    {"proximo", 1, "bs_bits_proximo", NULL},
+    {"e", 1, "bs_bits_e", NULL},
+    {"ou", 1, "bs_bits_ou", NULL},
+    {"xou", 1, "bs_bits_xou", NULL},
+    {"inverter", 0, "bs_bits_inverter", NULL},
+    {"limpar", 0, "bs_bits_preencher", "0"},
+    {"preencher", 0, "bs_bits_preencher", "1"},
+    {"copiar", 0, "bs_bits_copiar", NULL},
+    {"len", 0, NULL, NULL},
+    {NULL, 0, NULL, NULL},
+};
+
+// Index of 'method' in bits_methods, -1 if it is not a bitset method
+static int bits_method_index(const char *method)
+{
+    for (int i = 0; bits_methods[i].name; i++)
+    {
+        if (strcmp(method, bits_methods[i].name) == 0)
+            return i;
+    }
+    return -1;
+}
+
+// b.contar() / b.proximo(i) / b.e(o) / b.ou(o) / b.xou(o) / b.inverter() /
+// b.limpar() / b.preencher() / b.copiar() / b.len
+static void codegen_bits_method(ASTNode *node, const char *method, FILE *file)
+{
+    int m = bits_method_index(method);
+    int argc = arrlen(node->children) - 1;
+    if (argc != bits_methods[m].arity)
+    {
+        fprintf(stderr, "[Basalto] Erro: '.%s' espera %d argumento(s), recebeu %d.\n", method, bits_methods[m].arity, argc);
+        exit(1);
+    }
+    if (!bits_methods[m].runtime)
+    {
+        fprintf(file, "(");
+        codegen(node->children[0], file);
+        fprintf(file, ").len");
+        return;
+    }
+    fprintf(file, "%s(", bits_methods[m].runtime);
+    codegen(node->children[0], file);
+    for (int i = 1; i <= argc; i++)
+    {
+        bool set_operation = strcmp(method, "proximo") != 0;
+        if (set_operation && !is_bits_type(infer_type(node->children[i])))
+        {
+            fprintf(stderr, "[Basalto] Erro: '.%s' espera outro 'bits'.\n", method);
+            exit(1);
+        }
+        fprintf(file, ", ");
+        codegen(node->children[i], file);
+    }
+    if (bits_methods[m].extra)
+        fprintf(file, ", %s", bits_methods[m].extra);
+    fprintf(file, ")");
+}
+
+// cada (i: b): indices of the set bits, found a word at a time
+static void codegen_bits_cada(ASTNode *node, FILE *file)
+{
+    static int bits_loop_counter = 0;
+    int id = bits_loop_counter++;
+
+    fprintf(file, "    BsBits _b%d = ", id);
+    codegen(node->start, file);
+    fprintf(file, ";\n");
+    fprintf(file, "    for (long long %s = bs_bits_proximo(_b%d, 0); %s >= 0; %s = bs_bits_proximo(_b%d, %s + 1)) {\n",
+            node->cada_var, id, node->cada_var, node->cada_var, id, node->cada_var);
+
+    scope_enter();
+    scope_bind(node->cada_var, "inteiro64");
+    if (arrlen(node->children) > 0)
+    {
+        codegen(node->children[0], file); // Block
+    }
+    scope_exit();
+    fprintf(file, "    }\n");
+}
+
+// --- SLICE VIEWS (fatia[T]) ---
+// xs[a..b] is an O(1) BsFatia (pointer, length, stride) into the array instead
+// of a copy; xs[a..b:p] keeps every p-th element of it. '.copiar()' makes an
+// owned array; storing a view into a '[T]' copies implicitly, and a '[T]' passed
+// where a 'fatia[T]' is expected is viewed whole.
+
+// View of 'base' (array or view) over [start, end); NULL bounds = everything
+static void codegen_fatia_view(ASTNode *base, ASTNode *start, ASTNode *end, FILE *file)
+{
+    const char *base_type = infer_type(base);
+    sds elem = sequence_element(base_type);
+    sds c_elem = field_c_type(elem);
+    if (is_fatia_type(base_type))
+    {
+        fprintf(file, "({ BsFatia _fb = ");
+        codegen(base, file);
+        fprintf(file, "; bs_fatia(_fb.dados, _fb.len, _fb.passo, sizeof(%s), ", c_elem);
+    }
+    else if (is_fixo_type(base_type))
+    {
+        fprintf(file, "({ %s *_fb = ", c_elem);
+        codegen(base, file);
+        fprintf(file, "; bs_fatia(_fb, %d, 1, sizeof(%s), ", fixo_length(base_type), c_elem);
+    }
+    else if (is_pequeno_type(base_type))
+    {
+        sds p = pequeno_ref(base);
+        fprintf(file, "({ %s *_fb = %s_dados(%s); long long _fn = (%s)->h.len; bs_fatia(_fb, _fn, 1, sizeof(%s), ",
+                c_elem, map_type(base_type), p, p, c_elem);
+        sdsfree(p);
+    }
+    else
+    {
+        fprintf(file, "({ %s *_fb = ", c_elem);
+        codegen(base, file);
+        fprintf(file, "; bs_fatia(_fb, arrlen(_fb), 1, sizeof(%s), ", c_elem);
+    }
+    if (start)
+        codegen(start, file);
+    else
+        fprintf(file, "0");
+    fprintf(file, ", ");
+    if (end)
+        codegen(end, file);
+    else if (is_fixo_type(base_type))
+        fprintf(file, "%d", fixo_length(base_type));
+    else if (is_pequeno_type(base_type))
+        fprintf(file, "_fn");
+    else
+        fprintf(file, "%s", is_fatia_type(base_type) ? "_fb.len" : "arrlen(_fb)");
+    fprintf(file, "); })");
+    sdsfree(elem);
+    sdsfree(c_elem);
+}
+
+// Element 'index' of the view 'base'
+static void codegen_fatia_index(ASTNode *base, ASTNode *index, FILE *file)
+{
+    sds elem = sequence_element(infer_type(base));
+    sds c_elem = field_c_type(elem);
+    if (base->type == NODE_VAR_REF)
+    {
+        // A plain variable: read twice, kept as a direct load
+        fprintf(file, "((%s *)(", c_elem);
+        codegen(base, file);
+        fprintf(file, ").dados)[(");
+        codegen(index, file);
+        fprintf(file, ") * (");
+        codegen(base, file);
+        fprintf(file, ").passo]");
+    }
+    else
+    {
+        // Any other view expression is evaluated once; the result stays an lvalue
+        fprintf(file, "(*({ BsFatia _fv = ");
+        codegen(base, file);
+        fprintf(file, "; (%s *)_fv.dados + (", c_elem);
+        codegen(index, file);
+        fprintf(file, ") * _fv.passo; }))");
+    }
+    sdsfree(elem);
+    sdsfree(c_elem);
+}
+
+// xs.copiar(): owned stb_ds copy of an array or view
+static void codegen_copiar(ASTNode *base, FILE *file)
+{
+    const char *base_type = infer_type(base);
+    sds elem = sequence_element(base_type);
+    sds c_elem = field_c_type(elem);
+    if (is_fatia_type(base_type))
+    {
+        fprintf(file, "({ BsFatia _fc = ");
+        codegen(base, file);
+        fprintf(file, "; %s *_c = NULL; arrsetlen(_c, _fc.len); ", c_elem);
+        fprintf(file, "for (long long _k = 0; _k < _fc.len; _k++) _c[_k] = ((%s *)_fc.dados)[_k * _fc.passo]; _c; })", c_elem);
+    }
+    else if (is_fixo_type(base_type))
+    {
+        int n = fixo_length(base_type);
+        fprintf(file, "({ %s *_fc = ", c_elem);
+        codegen(base, file);
+        fprintf(file, "; %s *_c = NULL; arrsetlen(_c, %d); memcpy(_c, _fc, sizeof(%s) * %d); _c; })", c_elem, n, c_elem, n);
+    }
+    else if (is_pequeno_type(base_type))
+    {
+        sds p = pequeno_ref(base);
+        fprintf(file, "({ %s *_pc = %s; %s *_c = NULL; arrsetlen(_c, _pc->h.len); ", map_type(base_type), p, c_elem);
+        fprintf(file, "if (_pc->h.len > 0) memcpy(_c, %s_dados(_pc), _pc->h.len * sizeof(%s)); _c; })", map_type(base_type), c_elem);
+        sdsfree(p);
+    }
+    else
+    {
+        fprintf(file, "({ %s *_fc = ", c_elem);
+        codegen(base, file);
+        fprintf(file, "; %s *_c = NULL; arrsetlen(_c, arrlen(_fc)); ", c_elem);
+        fprintf(file, "if (arrlen(_fc) > 0) memcpy(_c, _fc, arrlen(_fc) * sizeof(%s)); _c; })", c_elem);
+    }
+    sdsfree(elem);
+    sdsfree(c_elem);
+}
+
+// --- TEXTO ELEMENT STORES ---
+// s[i] = c changes only the string it is made through, whatever it was built
+// from. A holder that is stored into (a variable or array of the current body,
+// or a field name anywhere in the program) never shares its bytes: it copies a
+// string that may live elsewhere when it receives one, a string read out of it
+// is copied before being kept anywhere else, and such a parameter is copied on
+// entry. A literal is copied on the first store instead (bs_texto_possuir).
+static char **texto_escritos = NULL; // Holders stored into in the body being generated: "s", "xs[]"
+static char **campos_escritos = NULL; // texto fields stored into anywhere: "nome"
+
+static int name_in_list(char **names, const char *name);
+
+// Record the holder that 'node' (an s[i] = c) stores into
+static void collect_texto_escritas(ASTNode *node, char ***names, char ***fields)
+{
+    if (!node)
+        return;
+    if (node->type == NODE_ASSIGN && !node->name && arrlen(node->children) > 1 && node->children[0]->type == NODE_ARRAY_ACCESS)
+    {
+        ASTNode *access = node->children[0];
+        ASTNode *base = !access->name && arrlen(access->children) == 2 ? access->children[0] : NULL;
+        if (access->name && arrlen(access->children) == 1)
+            arrput(*names, access->name);
+        else if (base && base->type == NODE_VAR_REF && base->name)
+            arrput(*names, base->name);
+        else if (base && base->type == NODE_PROP_ACCESS && base->data_type && fields)
+            arrput(*fields, base->data_type);
+        else if (base && base->type == NODE_ARRAY_ACCESS && base->name && arrlen(base->children) == 1)
+            arrput(*names, sdscatprintf(sdsempty(), "%s[]", base->name));
+    }
+    for (int i = 0; i < arrlen(node->children); i++)
+        collect_texto_escritas(node->children[i], names, fields);
+    collect_texto_escritas(node->start, names, fields);
+    collect_texto_escritas(node->end, names, fields);
+    collect_texto_escritas(node->step, names, fields);
+}
+
+// Is 'expr' a texto read out of a holder that is stored into?
+static bool texto_escrito(ASTNode *expr)
+{
+    const char *type = infer_type(expr);
+    if (!type || strcmp(type, "texto") != 0)
+        return false;
+    if (expr->type == NODE_VAR_REF && expr->name)
+        return name_in_list(texto_escritos, expr->name);
+    if (expr->type == NODE_PROP_ACCESS && expr->data_type)
+        return name_in_list(campos_escritos, expr->data_type);
+    if (expr->type == NODE_ARRAY_ACCESS && expr->name && arrlen(expr->children) == 1)
+    {
+        sds key = sdscatprintf(sdsempty(), "%s[]", expr->name);
+        bool found = name_in_list(texto_escritos, key);
+        sdsfree(key);
+        return found;
+    }
+    return false;
+}
+
+static void codegen_converted(const char *target, ASTNode *expr, FILE *file);
+
+// 'value' stored into a texto holder; 'escrito' if the holder is stored into
+static void codegen_texto_guardado(bool escrito, const char *target, ASTNode *value, FILE *file)
+{
+    const char *type = infer_type(value);
+    // Concatenations and interpolations are new strings; literals go through bs_texto_possuir
+    bool copia = escrito && target && strcmp(target, "texto") == 0 && type && strcmp(type, "texto") == 0 &&
+                 value->type != NODE_LITERAL_STRING && value->type != NODE_BINARY_OP && !texto_escrito(value);
+    if (copia)
+        fprintf(file, "sdsdup(");
+    codegen_converted(target, value, file);
+    if (copia)
+        fprintf(file, ")");
+}
+
+// Value 'expr' stored into something of Basalto type 'target' (views <-> arrays)
+static void codegen_converted(const char *target, ASTNode *expr, FILE *file)
+{
+    const char *source = infer_type(expr);
+    if (is_matriz_new(expr))
+    {
+        if (!is_matriz_type(target))
+        {
+            fprintf(stderr, "[Basalto] Erro: matriz(linhas, colunas) so inicializa um 'matriz[T]'%s%s.\n",
+                    target ? ", nao '" : "", target ? target : "");
+            exit(1);
+        }
+        codegen_matriz_new(target, expr, file);
+    }
+    else if (is_bits_new(expr))
+    {
+        codegen_bits_new(expr, file);
+    }
+    else if (target && target[0] == '[' && (is_fatia_type(source) || is_fixo_type(source) || is_pequeno_type(source)))
+    {
+        codegen_copiar(expr, file);
+    }
+    else if (is_fatia_type(target) && source && (source[0] == '[' || is_fixo_type(source) || is_pequeno_type(source)))
+    {
+        codegen_fatia_view(expr, NULL, NULL, file);
+    }
+    else if (is_compacto_type(target) && !is_compacto_type(source))
+    {
+        codegen_compacto_from(expr, file);
+    }
+    else if (target && strcmp(target, "[texto]") == 0 && is_compacto_type(source))
+    {
+        // One sds per element out of the pool ('.copiar()' first would only copy twice)
+        if (expr->type == NODE_METHOD_CALL && expr->data_type && strcmp(expr->data_type, "copiar") == 0 &&
+            arrlen(expr->children) == 1)
+            expr = expr->children[0];
+        fprintf(file, "bs_textos_para_array(");
+        codegen(expr, file);
+        fprintf(file, ")");
+    }
+    else if (is_fatia_texto_type(target) && !is_fatia_texto_type(source))
+    {
+        codegen_as_fatia_texto(expr, file);
+    }
+    else if (target && strcmp(target, "texto") == 0 && texto_escrito(expr))
+    {
+        // Out of a holder that is stored into: the copy is what gets kept (see TEXTO ELEMENT STORES)
+        fprintf(file, "sdsdup(");
+        codegen(expr, file);
+        fprintf(file, ")");
+    }
+    else if (target && strcmp(target, "texto") == 0 && is_fatia_texto_type(source))
+    {
+        // Views become owned strings only when stored as 'texto'
+        fprintf(file, "fatia_texto_to_string(");
+        codegen(expr, file);
+        fprintf(file, ")");
+    }
+    else if (is_construtor_type(target) && !is_construtor_type(source))
+    {
+        // A builder starts from a copy of the string
+        fprintf(file, "bs_construtor_de(");
+        codegen_as_fatia_texto(expr, file);
+        fprintf(file, ")");
+    }
+    else if (target && strcmp(target, "texto") == 0 && is_construtor_type(source))
+    {
+        fprintf(file, "bs_construtor_texto(");
+        codegen(expr, file);
+        fprintf(file, ")");
+    }
+    else
+    {
+        codegen(expr, file);
+    }
+}
+
+// Element value for push/set: reference structs are copied out of their object
+static void codegen_soa_value(const char *elem, ASTNode *value, FILE *file)
+{
+    if (!is_value_struct(elem))
+    {
+        fprintf(file, "*(");
+        codegen(value, file);
+        fprintf(file, ")");
+    }
+    else
+    {
+        codegen(value, file);
+    }
+}
+
+// '[a, b]' / '[]' assigned to a @soa array: build the columns in a temporary
+static void codegen_soa_literal(const char *elem, ASTNode *literal, FILE *file)
+{
+    fprintf(file, "({ %s_soa _soa_tmp = {0};", elem);
+    for (int i = 0; i < arrlen(literal->children); i++)
+    {
+        fprintf(file, " %s_soa_push(&_soa_tmp, ", elem);
+        codegen_soa_value(elem, literal->children[i], file);
+        fprintf(file, ");");
+    }
+    fprintf(file, " _soa_tmp; })");
+}
+
+// --- ARRAY LITERALS ---
+// Literals made only of numeric constants become a 'static const' table in
+// .rodata copied in with one arrsetlen + memcpy. Any other literal reserves its
+// exact capacity first, so filling it never reallocates.
+
+static bool is_constant_literal(ASTNode *node)
+{
+    if (!node)
+        return false;
+    switch (node->type)
+    {
+    case NODE_LITERAL_INT:
+    case NODE_LITERAL_DOUBLE:
+    case NODE_LITERAL_FLOAT:
+    case NODE_LITERAL_BOOL:
+        return true;
+    case NODE_UNARY_OP:
+        return arrlen(node->children) > 0 && is_constant_literal(node->children[0]);
+    default:
+        return false;
+    }
+}
+
+// Fill the empty stb_ds array 'target' (C element type 'c_elem', NULL if unknown)
+static void codegen_array_fill(const char *target, const char *c_elem, ASTNode *literal, const char *indent, FILE *file)
+{
+    static int table_counter = 0;
+    int count = arrlen(literal->children);
+    if (count == 0)
+        return;
+
+    bool constant = c_elem && strcmp(c_elem, "sds") != 0 && !strchr(c_elem, '*');
+    for (int i = 0; constant && i < count; i++)
+        constant = is_constant_literal(literal->children[i]);
+
+    if (constant)
+    {
+        int id = table_counter++;
+        fprintf(file, "%s{\n", indent);
+        fprintf(file, "%s    static const %s bs_tabela_%d[%d] = {", indent, c_elem, id, count);
+        for (int i = 0; i < count; i++)
+        {
+            if (i > 0)
+                fprintf(file, ", ");
+            codegen(literal->children[i], file);
+        }
+        fprintf(file, "};\n");
+        fprintf(file, "%s    arrsetlen(%s, %d);\n", indent, target, count);
+        fprintf(file, "%s    memcpy(%s, bs_tabela_%d, sizeof(bs_tabela_%d));\n", indent, target, id, id);
+        fprintf(file, "%s}\n", indent);
+        return;
+    }
+
+    fprintf(file, "%sarrsetcap(%s, %d);\n", indent, target, count);
+    for (int i = 0; i < count; i++)
+    {
+        fprintf(file, "%sarrput(%s, ", indent, target);
+        codegen(literal->children[i], file);
+        fprintf(file, ");\n");
+    }
+}
+
+// --- ARRAY CAPACITY ---
+// Capacity methods on '[T]' map straight onto stb_ds:
+// reservar(n) -> arrsetcap, capacidade -> arrcap, redimensionar(n) -> arrsetlen
+// (new slots zeroed), limpar() -> arrsetlen 0 (capacity kept),
+// remover_rapido(i) -> arrdelswap, inserir(i, x) -> arrins, encolher() -> bs_arr_encolher.
+
+static const struct
+{
+    const char *name;
+    int arity;
+} capacity_methods[] = {
+    {"reservar", 1},
+    {"capacidade", 0},
+    {"redimensionar", 1},
+    {"limpar", 0},
+    {"remover_rapido", 1},
+    {"inserir", 2},
+    {"encolher", 0},
+};
+
+static int capacity_method_arity(const char *method)
+{
+    for (size_t i = 0; i < sizeof(capacity_methods) / sizeof(capacity_methods[0]); i++)
+    {
+        if (strcmp(capacity_methods[i].name, method) == 0)
+            return capacity_methods[i].arity;
+    }
+    return -1;
+}
+
+// Decided by the C type, so every spelling (natural64, n64, i64, byte, ...) counts
+static bool is_integer_type(const char *type)
+{
+    static const char *c_integers[] = {"signed char", "short", "int", "long", "long long",
+                                       "unsigned char", "unsigned short", "unsigned int", "unsigned long",
+                                       "unsigned long long", "size_t", "char", NULL};
+    if (!type)
+        return false;
+    const char *c_type = map_type(type);
+    for (int i = 0; c_integers[i]; i++)
+        if (strcmp(c_type, c_integers[i]) == 0)
+            return true;
+    return false;
+}
+
+// arr.metodo(args): children[0] is the array, the rest are arguments
+static void codegen_capacity_method(ASTNode *node, const char *method, FILE *file)
+{
+    ASTNode *arr = node->children[0];
+    const char *arr_type = infer_type(arr);
+    int arity = capacity_method_arity(method);
+    int argc = arrlen(node->children) - 1;
+
+    if (is_fatia_type(arr_type))
+    {
+        fprintf(stderr, "[Basalto] Erro: '.%s' nao existe em fatias ('%s'); use .copiar() para obter um array.\n", method, arr_type);
+        exit(1);
+    }
+    sds soa = soa_element(arr_type);
+    if (soa)
+    {
+        fprintf(stderr, "[Basalto] Erro: '.%s' nao e suportado em arrays @soa ('%s').\n", method, arr_type);
+        exit(1);
+    }
+    if (argc != arity)
+    {
+        fprintf(stderr, "[Basalto] Erro: '.%s' espera %d argumento(s), recebeu %d.\n", method, arity, argc);
+        exit(1);
+    }
+    if (arity > 0)
+    {
+        const char *index_type = infer_type(node->children[1]);
+        if (index_type && !is_integer_type(index_type))
+        {
+            fprintf(stderr, "[Basalto] Erro: '.%s' espera um inteiro, recebeu '%s'.\n", method, index_type);
+            exit(1);
+        }
+    }
+
+    if (strcmp(method, "capacidade") == 0)
+    {
+        fprintf(file, "arrcap(");
+        codegen(arr, file);
+        fprintf(file, ")");
+    }
+    else if (strcmp(method, "reservar") == 0)
+    {
+        fprintf(file, "arrsetcap(");
+        codegen(arr, file);
+        fprintf(file, ", ");
+        codegen(node->children[1], file);
+        fprintf(file, ")");
+    }
+    else if (strcmp(method, "limpar") == 0)
+    {
+        fprintf(file, "arrsetlen(");
+        codegen(arr, file);
+        fprintf(file, ", 0)");
+    }
+    else if (strcmp(method, "remover_rapido") == 0)
+    {
+        fprintf(file, "arrdelswap(");
+        codegen(arr, file);
+        fprintf(file, ", ");
+        codegen(node->children[1], file);
+        fprintf(file, ")");
+    }
+    else if (strcmp(method, "inserir") == 0)
+    {
+        // Index and value are evaluated before arrins grows the array (xs.inserir(xs.len, x))
+        sds elem = sequence_element(arr_type);
+        sds c_elem = field_c_type(elem);
+        fprintf(file, "({ ptrdiff_t _ii = ");
+        codegen(node->children[1], file);
+        fprintf(file, "; %s _iv = ", c_elem);
+        codegen_converted(elem, node->children[2], file);
+        fprintf(file, "; arrins(");
+        codegen(arr, file);
+        fprintf(file, ", _ii, _iv); })");
+        sdsfree(elem);
+        sdsfree(c_elem);
+    }
+    else if (strcmp(method, "redimensionar") == 0)
+    {
+        // Growing zeroes the new slots (stb_ds leaves them uninitialized);
+        // the array is evaluated once, through its address
+        sds c_arr = sdsnew(map_type(arr_type));
+        fprintf(file, "({ long long _rn = ");
+        codegen(node->children[1], file);
+        fprintf(file, "; %s* _ra = &(", c_arr);
+        codegen(arr, file);
+        fprintf(file, "); long long _rv = arrlen(*_ra); if (_rn < 0) _rn = 0; arrsetlen(*_ra, _rn); "
+                      "if (_rn > _rv) memset(*_ra + _rv, 0, (_rn - _rv) * sizeof(**_ra)); })");
+        sdsfree(c_arr);
+    }
+    else if (strcmp(method, "encolher") == 0)
+    {
+        codegen(arr, file);
+        fprintf(file, " = bs_arr_encolher(");
+        codegen(arr, file);
+        fprintf(file, ", sizeof(*");
+        codegen(arr, file);
+        fprintf(file, "))");
+    }
+}
+
+// --- FIXED ARRAYS ([T; N]) ---
+// '[T; N]' is a plain C array 'T name[N]': on the stack for locals and inline in
+// structs, with no allocator call. '.len' folds to N. A fixed array is viewed as
+// a fatia[T] (or copied into a '[T]') where one is expected; parameters decay to
+// T*, so callees work on the caller's elements.
+
+// Type as written in Basalto: "fixo[T;N]" -> "[T; N]"
+static sds fixo_display(const char *type)
+{
+    sds elem = sequence_element(type);
+    sds shown = sdscatprintf(sdsempty(), "[%s; %d]", elem, fixo_length(type));
+    sdsfree(elem);
+    return shown;
+}
+
+// 'T name[N]'
+static sds fixo_declaration(const char *type, const char *name)
+{
+    sds elem = sequence_element(type);
+    sds c_elem = field_c_type(elem);
+    sds decl = sdscatprintf(sdsempty(), "%s %s[%d]", c_elem, name, fixo_length(type));
+    sdsfree(elem);
+    sdsfree(c_elem);
+    return decl;
+}
+
+// push/pop/capacity only exist on stb_ds arrays
+static void check_fixo_method(const char *type, const char *method)
+{
+    if (!is_fixo_type(type))
+        return;
+    if (strcmp(method, "push") == 0 || strcmp(method, "pop") == 0 || capacity_method_arity(method) >= 0)
+    {
+        sds shown = fixo_display(type);
+        fprintf(stderr, "[Basalto] Erro: '%s' tem tamanho fixo; '.%s' so existe em arrays dinamicos.\n", shown, method);
+        exit(1);
+    }
+}
+
+// '{a, b, c}' for a literal stored into the fixed array type 'type'
+static void codegen_fixo_initializer(const char *type, ASTNode *literal, FILE *file)
+{
+    int count = arrlen(literal->children);
+    if (count > fixo_length(type))
+    {
+        sds shown = fixo_display(type);
+        fprintf(stderr, "[Basalto] Erro: %d valores para '%s'.\n", count, shown);
+        exit(1);
+    }
+    if (count == 0)
+    {
+        fprintf(file, "{0}");
+        return;
+    }
+    sds elem = sequence_element(type);
+    fprintf(file, "{");
+    for (int i = 0; i < count; i++)
+    {
+        if (i > 0)
+            fprintf(file, ", ");
+        codegen_converted(elem, literal->children[i], file);
+    }
+    fprintf(file, "}");
+    sdsfree(elem);
+}
+
+// Source of a copy into a fixed array must be another fixed array of the same type
+static void check_fixo_source(const char *type, ASTNode *value)
+{
+    const char *source = infer_type(value);
+    if (!source || strcmp(source, type) != 0)
+    {
+        sds shown = fixo_display(type);
+        fprintf(stderr, "[Basalto] Erro: '%s' so recebe uma lista [...] ou outro '%s'.\n", shown, shown);
+        exit(1);
+    }
+}
+
+// var name: [T; N] (= [..] | = other)
+static void codegen_fixo_decl(ASTNode *decl, FILE *file)
+{
+    const char *type = decl->data_type;
+    ASTNode *init = arrlen(decl->children) > 0 ? decl->children[0] : NULL;
+    sds declaration = fixo_declaration(type, decl->name);
+    if (!init)
+    {
+        fprintf(file, "    %s = {0};\n", declaration);
+    }
+    else if (init->type == NODE_ARRAY_LITERAL)
+    {
+        fprintf(file, "    %s = ", declaration);
+        codegen_fixo_initializer(type, init, file);
+        fprintf(file, ";\n");
+    }
+    else
+    {
+        check_fixo_source(type, init);
+        sds elem = sequence_element(type);
+        sds c_elem = field_c_type(elem);
+        fprintf(file, "    %s;\n    memcpy(%s, ", declaration, decl->name);
+        codegen(init, file);
+        fprintf(file, ", sizeof(%s) * %d);\n", c_elem, fixo_length(type));
+        sdsfree(elem);
+        sdsfree(c_elem);
+    }
+    sdsfree(declaration);
+}
+
+// name = [..] | name = other (C arrays are not assignable: copy the elements)
+static void codegen_fixo_assign(const char *name, const char *type, ASTNode *value, FILE *file)
+{
+    sds elem = sequence_element(type);
+    sds c_elem = field_c_type(elem);
+    int n = fixo_length(type);
+    if (value->type == NODE_ARRAY_LITERAL)
+    {
+        fprintf(file, "({ %s _fx[%d] = ", c_elem, n);
+        codegen_fixo_initializer(type, value, file);
+        fprintf(file, "; memcpy(%s, _fx, sizeof(_fx)); })", name);
+    }
+    else
+    {
+        check_fixo_source(type, value);
+        fprintf(file, "memcpy(%s, ", name);
+        codegen(value, file);
+        fprintf(file, ", sizeof(%s) * %d)", c_elem, n);
+    }
+    sdsfree(elem);
+    sdsfree(c_elem);
+}
+
+// Helper to generate function signatures (e.g. "int sum(int a, int b)")
+void codegen_func_signature(ASTNode *node, FILE *file)
+{
+    // C functions cannot return arrays
+    if (is_fixo_type(node->data_type) || is_pequeno_type(node->data_type))
+    {
+        sds shown = is_fixo_type(node->data_type) ? fixo_display(node->data_type) : pequeno_display(node->data_type);
+        fprintf(stderr, "[Basalto] Erro: '%s' nao pode retornar '%s'; retorne um '[T]' ou receba o array como parametro.\n", node->name, shown);
+        exit(1);
+    }
+    // If return type is a struct, make it a pointer by default
+    // Heuristic: struct-returning functions often return pointers (especially with recursive structs)
+    // A library exports the same C types an 'externo' block imports (booleano as int)
+    const char *return_type = library_mode ? ffi_type(node->data_type) : map_type(node->data_type);
+    // Check if it's a struct type by checking the type registry directly
+    int is_struct = 0;
+    if (node->data_type && type_registry)
+    {
+        FieldEntry *fields = shget(type_registry, node->data_type);
+        if (fields != NULL)
+        {
+            is_struct = 1;
+        }
+    }
+    // Also check if map_type returned the same string (fallback)
+    if (!is_struct && node->data_type && return_type && strcmp(return_type, node->data_type) == 0 && strcmp(return_type, "void") != 0)
+    {
+        is_struct = 1;
+    }
+    // Value structs (estrutura valor) are returned by copy
+    if (is_struct && node->data_type && is_value_struct(node->data_type))
+    {
+        is_struct = 0;
+    }
+    if (is_struct)
+    {
+        fprintf(file, "%s* %s(", return_type, node->name);
+    }
+    else
+    {
+        fprintf(file, "%s %s(", return_type, node->name);
+    }
+
+    // For extern functions, there's no body, so all children are params
+    // For regular functions, the last child is the body block
+    int total_children = arrlen(node->children);
+    int param_count = total_children;
+
+    // Check if last child is a body block (NODE_BLOCK)
+    if (total_children > 0 && node->children[total_children - 1]->type == NODE_BLOCK)
+    {
+        param_count = total_children - 1;
+    }
+
+    for (int i = 0; i < param_count; i++)
+    {
+        ASTNode *param = node->children[i];
+        if (i > 0)
+            fprintf(file, ", ");
+
+        const char *type = param->data_type;
+        const char *name = param->name;
+
+        // SMART POINTER LOGIC:
+        // 1. If param name is "eu" or "self" -> Pointer
+        // 2. If param type is a Struct -> Pointer (Pass by Reference)
+        // 3. Value structs (estrutura valor) are passed by copy unless rule 1 applies
+        if ((name && (strcmp(name, "eu") == 0 || strcmp(name, "self") == 0)) || (is_struct_type(type) && !is_value_struct(type)))
+        {
+            fprintf(file, "%s* %s", map_type(type), name);
+        }
+        else if (is_fixo_type(type))
+        {
+            // Decays to T*: the callee works on the caller's elements
+            sds declaration = fixo_declaration(type, name);
+            fprintf(file, "%s", declaration);
+            sdsfree(declaration);
+        }
+        else if (is_pequeno_type(type) || is_hash_type(type) || is_fila_type(type) || is_fila_prioridade_type(type))
+        {
+            // By address: the callee may push into the caller's array or grow its table
+            fprintf(file, "%s *%s", map_type(type), name);
+        }
+        else
+        {
+            fprintf(file, "%s %s", library_mode ? ffi_type(type) : map_type(type), name);
+        }
+    }
+    fprintf(file, ")");
+}
+
+// Helper to check if a string starts with a prefix
+static int starts_with(const char *str, const char *prefix)
+{
+    size_t prefix_len = strlen(prefix);
+    if (strlen(str) < prefix_len)
+        return 0;
+    return strncmp(str, prefix, prefix_len) == 0;
+}
+
+// Helper to escape a string for C string literal
+static void escape_string_for_c(const char *str, FILE *file)
+{
+    if (!str)
+    {
+        fprintf(file, "\"Assertion failed\"");
+        return;
+    }
+    fprintf(file, "\"");
+    for (const char *p = str; *p != '\0'; p++)
+    {
+        switch (*p)
+        {
+        case '"':
+            fprintf(file, "\\\"");
+            break;
+        case '\\':
+            fprintf(file, "\\\\");
+            break;
+        case '\n':
+            fprintf(file, "\\n");
+            break;
+        case '\t':
+            fprintf(file, "\\t");
+            break;
+        case '\r':
+            fprintf(file, "\\r");
+            break;
+        default:
+            fputc(*p, file);
+            break;
+        }
+    }
+    fprintf(file, "\"");
+}
+
+// Helper: is 'c' a valid identifier character (ASCII or UTF-8 byte)?
+static int is_ident_char(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || (unsigned char)c >= 0x80;
+}
+
+// Static text of a string literal as C string literal characters (without the
+// quotes), from '*cursor' up to the next "${" or the end
+static void codegen_literal_text(const char **cursor_ref, FILE *file)
+{
+    const char *cursor = *cursor_ref;
+    while (*cursor != '\0' && !starts_with(cursor, "${"))
+    {
+        // Handle escape sequences: \n, \t, \r, \\, \"
+        if (*cursor == '\\' && *(cursor + 1) != '\0')
+        {
+            cursor++; // Skip the backslash
+            switch (*cursor)
+            {
+            case 'n':
+                fprintf(file, "\\n");
+                break;
+            case 't':
+                fprintf(file, "\\t");
+                break;
+            case 'r':
+                fprintf(file, "\\r");
+                break;
+            case '\\':
+                fprintf(file, "\\\\");
+                break;
+            case '"':
+                fprintf(file, "\\\"");
+                break;
+            default:
+                // Unknown escape sequence, output as-is
+                fprintf(file, "\\%c", *cursor);
+                break;
+            }
+        }
+        // Escape C string characters
+        else if (*cursor == '"')
+            fprintf(file, "\\\"");
+        else if (*cursor == '\n')
+            fprintf(file, "\\n");
+        else if (*cursor == '\t')
+            fprintf(file, "\\t");
+        else if (*cursor == '\r')
+            fprintf(file, "\\r");
+        else
+            fputc(*cursor, file);
+        cursor++;
+    }
+    *cursor_ref = cursor;
+}
+
+// One "${expr}" or "${expr:fmt}" of a string literal, from '*cursor' (at the
+// "${") past its '}'. The expression itself is already parsed (the literal's
+// children); returns whether a format was given, copied into 'fmt_buffer'.
+static int interp_split(const char **cursor_ref, char fmt_buffer[64])
+{
+    const char *cursor = *cursor_ref + 2; // Skip "${"
+    int f_idx = 0;
+    int parsing_fmt = 0;
+    int depth = 0;
+    memset(fmt_buffer, 0, 64);
+
+    // Parse until '}'; a ':' inside brackets is a slice step (xs[0..8:2]), not a format
+    while (*cursor != '\0' && *cursor != '}')
+    {
+        if (!parsing_fmt && (*cursor == '[' || *cursor == '('))
+            depth++;
+        else if (!parsing_fmt && (*cursor == ']' || *cursor == ')'))
+            depth--;
+        if (*cursor == ':' && depth == 0)
+            parsing_fmt = 1;
+        else if (parsing_fmt && f_idx < 63)
+            fmt_buffer[f_idx++] = *cursor;
+        cursor++;
+    }
+    if (*cursor == '}')
+        cursor++;
+    *cursor_ref = cursor;
+    return parsing_fmt;
+}
+
+// --- STATIC STRING LITERALS ---
+// A literal without "${}" is one static sds (BS_TEXTO_FIXO in basalto.h):
+// header and bytes in .rodata, written once to helper_file and shared by every
+// occurrence with the same text, so using it allocates nothing. sdsfree skips
+// it and an append copies it first. Code generated outside function bodies
+// (no helper_file yet) gets a plain sdsnewlen.
+static struct
+{
+    char *key; // C text of the literal
+    int value; // Its _bs_lit id
+} *literal_ids = NULL;
+
+static void codegen_static_literal(const char *raw_str, FILE *file)
+{
+    char *text = NULL;
+    size_t text_len = 0;
+    FILE *mem = open_memstream(&text, &text_len);
+    const char *cursor = raw_str;
+    codegen_literal_text(&cursor, mem);
+    fclose(mem);
+
+    if (!helper_file)
+    {
+        fprintf(file, "sdsnewlen(\"%s\", sizeof(\"%s\") - 1)", text, text);
+        free(text);
+        return;
+    }
+    if (!literal_ids)
+        sh_new_strdup(literal_ids);
+    int id;
+    if (shgeti(literal_ids, text) >= 0)
+    {
+        id = shget(literal_ids, text);
+    }
+    else
+    {
+        id = shlen(literal_ids);
+        shput(literal_ids, text, id);
+        fprintf(helper_file, "BS_TEXTO_FIXO(_bs_lit%d, \"%s\");\n", id, text);
+    }
+    fprintf(file, "((sds)_bs_lit%d.buf)", id);
+    free(text);
+}
+
+// Runtime printer suffix for a sequence of numbers of C type 'c_elem'
+// (array_<suffix>_to_string / fatia_<suffix>_to_string), NULL if there is none
+static const char *array_printer(const char *c_elem)
+{
+    if (strcmp(c_elem, "long long") == 0)
+        return "int64";
+    if (strcmp(c_elem, "unsigned long long") == 0)
+        return "natural";
+    if (strcmp(c_elem, "double") == 0)
+        return "double";
+    if (strcmp(c_elem, "float") == 0)
+        return "float";
+    return NULL;
+}
+
+// matriz_<suffix>_to_string for a matrix of 'c_elem' (every numeric type and booleano)
+static const char *matriz_printer(const char *c_elem)
+{
+    static const char *printers[][2] = {
+        {"signed char", "int8"}, {"short", "int16"}, {"int", "int"}, {"long long", "int64"}, {"long", "int_arq"},
+        {"unsigned char", "byte"}, {"unsigned short", "natural16"}, {"unsigned int", "natural32"},
+        {"unsigned long long", "natural"}, {"unsigned long", "natural_arq"}, {"float", "float"},
+        {"double", "double"}, {"long double", "real_ext"}, {"_Bool", "bool"},
+    };
+    for (size_t i = 0; i < sizeof(printers) / sizeof(printers[0]); i++)
+        if (strcmp(c_elem, printers[i][0]) == 0)
+            return printers[i][1];
+    return NULL;
+}
+
+// The same for a view, fixed or small array (printed through a view):
+// fatia_<suffix>_to_string also covers int, bool and texto
+static const char *fatia_printer(const char *c_elem)
+{
+    if (strcmp(c_elem, "int") == 0)
+        return "int";
+    if (strcmp(c_elem, "_Bool") == 0)
+        return "bool";
+    if (strcmp(c_elem, "char*") == 0)
+        return "string";
+    return array_printer(c_elem);
+}
+
+// One "${...}" piece: append the value of 'expr' to the '_s' being built,
+// through printf when the piece has a format ("${x:.2f}")
+static void codegen_interp_piece(ASTNode *expr, const char *fmt, FILE *file)
+{
+    const char *type = infer_type(expr);
+    sds code = codegen_to_sds(expr);
+    sds view_elem = is_fatia_type(type) ? sequence_element(type) : NULL;
+    sds matriz_elem = matriz_element(type);
+    sds fixo_elem = (is_fixo_type(type) || is_pequeno_type(type)) ? sequence_element(type) : NULL;
+    const char *fixo_c = fixo_elem ? map_type(fixo_elem) : "";
+    if (fmt)
+    {
+        // User provided format: ".2f" becomes "%.2f"
+        fprintf(file, "_s = sdscatprintf(_s, \"%s%s\", %s); ", fmt[0] == '%' ? "" : "%", fmt, code);
+    }
+    else if (is_bits_type(type))
+    {
+        fprintf(file, "_s = sdscat(_s, bits_to_string(%s)); ", code);
+    }
+    else if (is_compacto_type(type))
+    {
+        fprintf(file, "_s = sdscat(_s, textos_to_string(%s)); ", code);
+    }
+    else if (is_fatia_texto_type(type) || is_construtor_type(type))
+    {
+        // String view or builder: its bytes, no intermediate sds
+        fprintf(file, "{ BsFatiaTexto _v = ");
+        codegen_as_fatia_texto(expr, file);
+        fprintf(file, "; _s = sdscatlen(_s, _v.dados, _v.len); } ");
+    }
+    else if (matriz_elem && matriz_printer(map_type(matriz_elem)))
+    {
+        fprintf(file, "_s = sdscat(_s, matriz_%s_to_string(%s)); ", matriz_printer(map_type(matriz_elem)), code);
+    }
+    else if (fixo_elem && is_pequeno_type(type) && fatia_printer(fixo_c))
+    {
+        // Small array: printed through a view of its live elements
+        sds ref = pequeno_ref(expr);
+        fprintf(file, "{ %s *_p = %s; _s = sdscat(_s, fatia_%s_to_string(bs_fatia(%s_dados(_p), _p->h.len, 1, sizeof(%s), 0, _p->h.len))); } ",
+                map_type(type), ref, fatia_printer(fixo_c), map_type(type), fixo_c);
+        sdsfree(ref);
+    }
+    else if (fixo_elem && fatia_printer(fixo_c))
+    {
+        // Fixed array: printed through a whole view
+        fprintf(file, "_s = sdscat(_s, fatia_%s_to_string(bs_fatia(%s, %d, 1, sizeof(%s), 0, %d))); ",
+                fatia_printer(fixo_c), code, fixo_length(type), fixo_c, fixo_length(type));
+    }
+    else if (view_elem && fatia_printer(map_type(view_elem)))
+    {
+        fprintf(file, "_s = sdscat(_s, fatia_%s_to_string(%s)); ", fatia_printer(map_type(view_elem)), code);
+    }
+    else if (view_elem || fixo_elem || matriz_elem)
+    {
+        fprintf(stderr, "[Basalto] Erro: '${%s}' nao pode ser impresso; elementos '%s' nao tem forma de texto.\n",
+                code, view_elem ? view_elem : fixo_elem ? fixo_elem : matriz_elem);
+        exit(1);
+    }
+    else if (type && type[0] == '[' && get_base_type(type))
+    {
+        // Arrays: one runtime printer per element type
+        char *base_type = get_base_type(type);
+        const char *c_base = map_type(base_type);
+        if (strcmp(c_base, "int") == 0)
+            fprintf(file, "_s = sdscat(_s, array_int_to_string(%s)); ", code);
+        else if (array_printer(c_base))
+            // Other numbers: formatted by bs_sds_anexar_* (see NUMBER FORMATTING)
+            fprintf(file, "_s = sdscat(_s, array_%s_to_string(%s)); ", array_printer(c_base), code);
+        else if (strcmp(c_base, "char*") == 0)
+            fprintf(file, "_s = sdscat(_s, array_string_to_string(%s)); ", code);
+        else if (strcmp(c_base, "_Bool") == 0)
+            fprintf(file, "_s = sdscat(_s, array_bool_to_string(%s)); ", code);
+        else if (strcmp(c_base, "BsFatiaTexto") == 0)
+            fprintf(file, "_s = sdscat(_s, array_fatia_texto_to_string(%s)); ", code);
+        else
+            // For other array types, fall back to print_any (may need more helpers later)
+            fprintf(file, "_s = sdscatprintf(_s, print_any(%s), %s); ", code, code);
+    }
+    else if (is_primitive_type(type))
+    {
+        // Number, booleano, caractere or texto: formatted in place (see NUMBER FORMATTING)
+        fprintf(file, "_s = bs_sds_anexar_valor(_s, %s); ", code);
+    }
+    else
+    {
+        // Auto-detection using _Generic: "print_any" returns the format string
+        // ("%d", "%f") from the type without evaluating the expression
+        fprintf(file, "_s = sdscatprintf(_s, print_any(%s), %s); ", code, code);
+    }
+    sdsfree(view_elem);
+    sdsfree(matriz_elem);
+    sdsfree(fixo_elem);
+    sdsfree(code);
+}
+
+// THE INTERPOLATION ENGINE
+// The parser stores one expression per "${...}" piece as the literal's children
+// (parse_interpolations), so each piece is generated like any other expression.
+static void codegen_string_literal(ASTNode *node, FILE *file)
+{
+    const char *raw_str = node->string_value;
+    if (!strstr(raw_str, "${"))
+    {
+        codegen_static_literal(raw_str, file);
+        return;
+    }
+
+    // 1. Start Statement Expression
+    // We create a temporary variable '_s' to build the string
+    fprintf(file, "({ sds _s = sdsempty(); ");
+
+    const char *cursor = raw_str;
+    int piece = 0;
+    while (*cursor != '\0')
+    {
+        // CASE A: Interpolation "${expr}"
+        if (starts_with(cursor, "${"))
+        {
+            char fmt_buffer[64]; // For options like :.2f
+            int parsing_fmt = interp_split(&cursor, fmt_buffer);
+            codegen_interp_piece(node->children[piece++], parsing_fmt ? fmt_buffer : NULL, file);
+        }
+        // CASE B: Static Text
+        else
+        {
+            // Optimization: Accumulate static text chunk
+            fprintf(file, "_s = sdscat(_s, \"");
+            codegen_literal_text(&cursor, file);
+            fprintf(file, "\"); ");
+        }
+    }
+
+    // 2. Return the string
+    fprintf(file, "_s; })");
+}
+
+// --- SORTING & SEARCH ---
+// xs.ordenar(), xs.ordenar_por(campo), xs.busca_binaria(x) and xs.particionar(p)
+// call helpers specialized per element type (bs_ordenar_<tipo>...), so every
+// comparison is inlined instead of going through a qsort callback:
+// - integer elements: LSD radix sort (one counting pass per byte);
+// - everything else: introsort (median-of-3 quicksort, heapsort past the depth
+//   limit, insertion sort for short runs) over the comparison BS_MENOR.
+
+static bool is_radix_c_type(const char *c_type)
+{
+    static const char *types[] = {"int", "long long", "short", "signed char", "long", "unsigned char",
+                                  "unsigned int", "unsigned long long", "unsigned short", "unsigned long", "size_t", NULL};
+    for (int i = 0; types[i]; i++)
+    {
+        if (strcmp(c_type, types[i]) == 0)
+            return true;
+    }
+    return false;
+}
+
+// Identifier-safe spelling of a type for helper names ("Pessoa*" -> "Pessoa")
+static sds helper_suffix(const char *type)
+{
+    sds suffix = sdsempty();
+    for (const char *c = type; *c; c++)
+        suffix = sdscatlen(suffix, is_ident_char(*c) ? c : "_", 1);
+    return suffix;
+}
+
+// "a < b" for two elements of Basalto type 'elem' (ordering of numbers, texto, booleano)
+static sds less_expr(const char *elem, const char *a, const char *b)
+{
+    if (strcmp(map_type(elem), "char*") == 0)
+        return sdscatprintf(sdsempty(), "(strcmp((%s) ? (%s) : \"\", (%s) ? (%s) : \"\") < 0)", a, a, b, b);
+    if (is_struct_type(elem) || elem[0] == '[' || is_fatia_type(elem) || is_fixo_type(elem) || is_matriz_type(elem))
+        return NULL;
+    return sdscatprintf(sdsempty(), "((%s) < (%s))", a, b);
+}
+
+static void write_radix_sort(const char *name, const char *c_elem)
+{
+    bool is_unsigned = strncmp(c_elem, "unsigned", 8) == 0 || strcmp(c_elem, "size_t") == 0;
+    FILE *f = helper_file;
+    fprintf(f, "// Radix sort (LSD, 8 bits per pass) for %s\n", c_elem);
+    fprintf(f, "static void %s(%s *a, ptrdiff_t n)\n{\n", name, c_elem);
+    fprintf(f, "    if (n < 64)\n    {\n");
+    fprintf(f, "        for (ptrdiff_t i = 1; i < n; i++)\n        {\n");
+    fprintf(f, "            %s v = a[i];\n            ptrdiff_t k = i;\n", c_elem);
+    fprintf(f, "            while (k > 0 && v < a[k - 1])\n            {\n                a[k] = a[k - 1];\n                k--;\n            }\n");
+    fprintf(f, "            a[k] = v;\n        }\n        return;\n    }\n");
+    fprintf(f, "    %s *tmp = malloc(sizeof(%s) * n);\n", c_elem, c_elem);
+    fprintf(f, "    if (!tmp)\n    {\n        fprintf(stderr, \"[Basalto] Out of memory!\\n\");\n        exit(1);\n    }\n");
+    fprintf(f, "    %s *src = a, *dst = tmp;\n", c_elem);
+    // The sign bit is flipped so negative numbers order before positive ones
+    fprintf(f, "    const unsigned long long flip = %s;\n",
+            is_unsigned ? "0" : "1ULL << (sizeof(*a) * 8 - 1)");
+    fprintf(f, "    for (unsigned shift = 0; shift < sizeof(*a) * 8; shift += 8)\n    {\n");
+    fprintf(f, "        size_t count[257] = {0};\n");
+    fprintf(f, "        for (ptrdiff_t i = 0; i < n; i++)\n");
+    fprintf(f, "            count[((((unsigned long long)src[i]) ^ flip) >> shift & 0xFF) + 1]++;\n");
+    fprintf(f, "        if (count[(((unsigned long long)src[0] ^ flip) >> shift & 0xFF) + 1] == (size_t)n)\n");
+    fprintf(f, "            continue; // Every key shares this byte\n");
+    fprintf(f, "        for (int b = 0; b < 256; b++)\n            count[b + 1] += count[b];\n");
+    fprintf(f, "        for (ptrdiff_t i = 0; i < n; i++)\n");
+    fprintf(f, "            dst[count[(((unsigned long long)src[i]) ^ flip) >> shift & 0xFF]++] = src[i];\n");
+    fprintf(f, "        %s *t = src;\n        src = dst;\n        dst = t;\n    }\n", c_elem);
+    fprintf(f, "    if (src != a)\n        memcpy(a, src, sizeof(%s) * n);\n", c_elem);
+    fprintf(f, "    free(tmp);\n}\n\n");
+}
+
+// Introsort over 'less' (written with the macro arguments bs_x and bs_y)
+static void write_intro_sort(const char *name, const char *c_elem, const char *less)
+{
+    FILE *f = helper_file;
+    fprintf(f, "#define BS_MENOR(bs_x, bs_y) %s\n", less);
+    fprintf(f, "static void %s_heap(%s *a, ptrdiff_t n)\n{\n", name, c_elem);
+    fprintf(f, "    for (ptrdiff_t start = n / 2, end = n; end > 1;)\n    {\n");
+    fprintf(f, "        ptrdiff_t root;\n");
+    fprintf(f, "        if (start > 0)\n            root = --start;\n");
+    fprintf(f, "        else\n        {\n            end--;\n            %s t = a[0];\n            a[0] = a[end];\n            a[end] = t;\n            root = 0;\n        }\n", c_elem);
+    fprintf(f, "        for (ptrdiff_t child; (child = 2 * root + 1) < end; root = child)\n        {\n");
+    fprintf(f, "            if (child + 1 < end && BS_MENOR(a[child], a[child + 1]))\n                child++;\n");
+    fprintf(f, "            if (!BS_MENOR(a[root], a[child]))\n                break;\n");
+    fprintf(f, "            %s t = a[root];\n            a[root] = a[child];\n            a[child] = t;\n        }\n    }\n}\n\n", c_elem);
+
+    fprintf(f, "static void %s_rec(%s *a, ptrdiff_t lo, ptrdiff_t hi, int depth)\n{\n", name, c_elem);
+    fprintf(f, "    while (hi - lo > 16)\n    {\n");
+    fprintf(f, "        if (depth-- == 0)\n        {\n            %s_heap(a + lo, hi - lo);\n            return;\n        }\n", name);
+    fprintf(f, "        ptrdiff_t mid = lo + (hi - 1 - lo) / 2;\n        %s t;\n", c_elem);
+    fprintf(f, "        if (BS_MENOR(a[mid], a[lo]))\n            t = a[mid], a[mid] = a[lo], a[lo] = t;\n");
+    fprintf(f, "        if (BS_MENOR(a[hi - 1], a[lo]))\n            t = a[hi - 1], a[hi - 1] = a[lo], a[lo] = t;\n");
+    fprintf(f, "        if (BS_MENOR(a[hi - 1], a[mid]))\n            t = a[hi - 1], a[hi - 1] = a[mid], a[mid] = t;\n");
+    fprintf(f, "        %s pivot = a[mid];\n", c_elem);
+    fprintf(f, "        ptrdiff_t i = lo - 1, j = hi;\n");
+    fprintf(f, "        for (;;)\n        {\n");
+    fprintf(f, "            do\n                i++;\n            while (BS_MENOR(a[i], pivot));\n");
+    fprintf(f, "            do\n                j--;\n            while (BS_MENOR(pivot, a[j]));\n");
+    fprintf(f, "            if (i >= j)\n                break;\n");
+    fprintf(f, "            t = a[i], a[i] = a[j], a[j] = t;\n        }\n");
+    fprintf(f, "        // Recurse into the smaller half, loop on the larger one\n");
+    fprintf(f, "        if (j + 1 - lo < hi - (j + 1))\n        {\n            %s_rec(a, lo, j + 1, depth);\n            lo = j + 1;\n        }\n", name);
+    fprintf(f, "        else\n        {\n            %s_rec(a, j + 1, hi, depth);\n            hi = j + 1;\n        }\n    }\n", name);
+    fprintf(f, "    for (ptrdiff_t i = lo + 1; i < hi; i++)\n    {\n");
+    fprintf(f, "        %s v = a[i];\n        ptrdiff_t k = i;\n", c_elem);
+    fprintf(f, "        while (k > lo && BS_MENOR(v, a[k - 1]))\n        {\n            a[k] = a[k - 1];\n            k--;\n        }\n");
+    fprintf(f, "        a[k] = v;\n    }\n}\n\n");
+
+    fprintf(f, "static void %s(%s *a, ptrdiff_t n)\n{\n", name, c_elem);
+    fprintf(f, "    int depth = 0;\n    for (ptrdiff_t m = n; m > 1; m >>= 1)\n        depth += 2;\n");
+    fprintf(f, "    %s_rec(a, 0, n, depth);\n}\n", name);
+    fprintf(f, "#undef BS_MENOR\n\n");
+}
+
+// Receiver of a sort/search method, evaluated once: opens
+// '({ T *_sd = ..; ptrdiff_t _sn = ..; ' and the caller passes '_sd, _sn'
+// then closes with '; })'
+static void codegen_sequence_bind(ASTNode *arr, const char *arr_type, FILE *file)
+{
+    sds elem = sequence_element(arr_type);
+    sds c_elem = field_c_type(elem);
+    if (is_fixo_type(arr_type))
+    {
+        fprintf(file, "({ %s* _sd = ", c_elem);
+        codegen(arr, file);
+        fprintf(file, "; ptrdiff_t _sn = %d; ", fixo_length(arr_type));
+    }
+    else if (is_pequeno_type(arr_type))
+    {
+        sds p = pequeno_ref(arr);
+        fprintf(file, "({ %s* _sp = %s; %s* _sd = %s_dados(_sp); ptrdiff_t _sn = _sp->h.len; ",
+                map_type(arr_type), p, c_elem, map_type(arr_type));
+        sdsfree(p);
+    }
+    else if (is_fatia_type(arr_type))
+    {
+        fprintf(file, "({ BsFatia _sv = ");
+        codegen(arr, file);
+        fprintf(file, "; %s* _sd = (%s*)bs_fatia_contigua(_sv); ptrdiff_t _sn = _sv.len; ", c_elem, c_elem);
+    }
+    else
+    {
+        fprintf(file, "({ %s* _sd = ", c_elem);
+        codegen(arr, file);
+        fprintf(file, "; ptrdiff_t _sn = arrlen(_sd); ");
+    }
+    sdsfree(elem);
+    sdsfree(c_elem);
+}
+
+// Field named by the argument of ordenar_por: a bare identifier or a string
+static const char *field_argument(ASTNode *arg)
+{
+    if (arg->type == NODE_VAR_REF && arg->name)
+        return arg->name;
+    if (arg->type == NODE_LITERAL_STRING && arg->string_value)
+        return arg->string_value;
+    return NULL;
+}
+
+static bool is_sort_method(const char *method)
+{
+    return strcmp(method, "ordenar") == 0 || strcmp(method, "ordenar_por") == 0 ||
+           strcmp(method, "busca_binaria") == 0 || strcmp(method, "particionar") == 0;
+}
+
+// arr.ordenar() / arr.ordenar_por(campo) / arr.busca_binaria(x) / arr.particionar(p)
+static void codegen_sort_method(ASTNode *node, const char *method, FILE *file)
+{
+    ASTNode *arr = node->children[0];
+    const char *arr_type = infer_type(arr);
+    int argc = arrlen(node->children) - 1;
+    int arity = strcmp(method, "ordenar") == 0 ? 0 : 1;
+    sds soa = soa_element(arr_type);
+    if (soa)
+    {
+        fprintf(stderr, "[Basalto] Erro: '.%s' nao e suportado em arrays @soa ('%s').\n", method, arr_type);
+        exit(1);
+    }
+    if (argc != arity)
+    {
+        fprintf(stderr, "[Basalto] Erro: '.%s' espera %d argumento(s), recebeu %d.\n", method, arity, argc);
+        exit(1);
+    }
+
+    sds elem = sequence_element(arr_type);
+    sds c_elem = field_c_type(elem);
+    sds suffix = helper_suffix(elem);
+    sds name = NULL;
+    bool by_reference = is_struct_type(elem) && !is_value_struct(elem);
+
+    if (strcmp(method, "ordenar_por") == 0)
+    {
+        const char *field = field_argument(node->children[1]);
+        const char *field_type = (field && is_struct_type(elem)) ? lookup_field_type(elem, field) : NULL;
+        if (!field_type)
+        {
+            fprintf(stderr, "[Basalto] Erro: '.ordenar_por' espera um campo de '%s'.\n", elem);
+            exit(1);
+        }
+        const char *access = by_reference ? "->" : ".";
+        sds x = sdscatprintf(sdsempty(), "(bs_x)%s%s", access, field);
+        sds y = sdscatprintf(sdsempty(), "(bs_y)%s%s", access, field);
+        sds less = less_expr(field_type, x, y);
+        if (!less)
+        {
+            fprintf(stderr, "[Basalto] Erro: o campo '%s' ('%s') nao pode ser ordenado.\n", field, field_type);
+            exit(1);
+        }
+        name = sdscatprintf(sdsempty(), "bs_ordenar_%s_por_%s", suffix, field);
+        if (helper_needed(name))
+            write_intro_sort(name, c_elem, less);
+        sdsfree(x);
+        sdsfree(y);
+        sdsfree(less);
+        codegen_sequence_bind(arr, arr_type, file);
+        fprintf(file, "%s(_sd, _sn); })", name);
+    }
+    else
+    {
+        // particionar(predicado) needs no ordering; every other form compares elements
+        ASTNode *arg = arity > 0 ? node->children[1] : NULL;
+        ASTNode *predicate = (strcmp(method, "particionar") == 0 && arg->type == NODE_VAR_REF && arg->name)
+                                 ? shget(func_defs, arg->name)
+                                 : NULL;
+        sds less = predicate ? NULL : less_expr(elem, "bs_x", "bs_y");
+        if (!predicate && !less)
+        {
+            fprintf(stderr, "[Basalto] Erro: '.%s' precisa de elementos comparaveis; '%s' nao e (use .ordenar_por(campo)).\n", method, elem);
+            exit(1);
+        }
+        if (strcmp(method, "ordenar") == 0)
+        {
+            name = sdscatprintf(sdsempty(), "bs_ordenar_%s", suffix);
+            if (helper_needed(name))
+            {
+                if (is_radix_c_type(c_elem))
+                    write_radix_sort(name, c_elem);
+                else
+                    write_intro_sort(name, c_elem, less);
+            }
+            codegen_sequence_bind(arr, arr_type, file);
+            fprintf(file, "%s(_sd, _sn); })", name);
+        }
+        else if (strcmp(method, "busca_binaria") == 0)
+        {
+            // Index of x in the sorted array, -1 if absent
+            name = sdscatprintf(sdsempty(), "bs_busca_%s", suffix);
+            if (helper_needed(name))
+            {
+                FILE *f = helper_file;
+                fprintf(f, "#define BS_MENOR(bs_x, bs_y) %s\n", less);
+                fprintf(f, "static long long %s(%s *a, ptrdiff_t n, %s x)\n{\n", name, c_elem, c_elem);
+                fprintf(f, "    ptrdiff_t lo = 0, hi = n;\n");
+                fprintf(f, "    while (lo < hi)\n    {\n        ptrdiff_t mid = lo + (hi - lo) / 2;\n");
+                fprintf(f, "        if (BS_MENOR(a[mid], x))\n            lo = mid + 1;\n        else\n            hi = mid;\n    }\n");
+                fprintf(f, "    return (lo < n && !BS_MENOR(x, a[lo])) ? lo : -1;\n}\n");
+                fprintf(f, "#undef BS_MENOR\n\n");
+            }
+            codegen_sequence_bind(arr, arr_type, file);
+            fprintf(file, "%s(_sd, _sn, ", name);
+            codegen_converted(elem, node->children[1], file);
+            fprintf(file, "); })");
+        }
+        else
+        {
+            // particionar(pivo): elements < pivo first; particionar(predicado): matching elements first.
+            // Returns how many ended up in front.
+            sds first = predicate ? sdscatprintf(sdsempty(), "%s(v)", arg->name) : sdscatprintf(sdsempty(), "BS_MENOR(v, p)");
+            name = predicate ? sdscatprintf(sdsempty(), "bs_particionar_%s_%s", suffix, arg->name)
+                             : sdscatprintf(sdsempty(), "bs_particionar_%s", suffix);
+            if (helper_needed(name))
+            {
+                FILE *f = helper_file;
+                if (less)
+                    fprintf(f, "#define BS_MENOR(bs_x, bs_y) %s\n", less);
+                fprintf(f, "#define BS_PRIMEIRO(v) %s\n", first);
+                fprintf(f, "static long long %s(%s *a, ptrdiff_t n, %s p)\n{\n", name, c_elem, c_elem);
+                fprintf(f, "    (void)p;\n    ptrdiff_t k = 0;\n");
+                fprintf(f, "    for (ptrdiff_t i = 0; i < n; i++)\n    {\n");
+                fprintf(f, "        if (BS_PRIMEIRO(a[i]))\n        {\n");
+                fprintf(f, "            %s t = a[i];\n            a[i] = a[k];\n            a[k++] = t;\n        }\n    }\n", c_elem);
+                fprintf(f, "    return k;\n}\n");
+                fprintf(f, "#undef BS_PRIMEIRO\n%s\n", less ? "#undef BS_MENOR\n" : "");
+            }
+            codegen_sequence_bind(arr, arr_type, file);
+            fprintf(file, "%s(_sd, _sn, ", name);
+            if (predicate)
+                fprintf(file, "(%s){0}", c_elem);
+            else
+                codegen_converted(elem, arg, file);
+            fprintf(file, "); })");
+            sdsfree(first);
+        }
+        sdsfree(less);
+    }
+    sdsfree(name);
+    sdsfree(suffix);
+    sdsfree(elem);
+    sdsfree(c_elem);
+}
+
+// --- MAPS ---
+// mapa[K, V] is an stb_ds hash map: a pointer to a contiguous array of
+// { key, value } entries (BsMapa_K_V) indexed by an open-addressing table.
+// - texto keys use the sh* API with arena-backed key storage, so keys are
+//   copied once into large blocks instead of one allocation each;
+// - every other key (integers, reals, references, value structs) uses hm*,
+//   which hashes the key bytes (4/8-byte keys take stb_ds's integer hash).
+// conjunto[T] uses the same table with key-only entries, and contador[T] is
+// a mapa[T, inteiro64] with counting methods.
+// An empty (NULL) container is valid: every operation below accepts it.
+
+static char **mapa_types = NULL; // Every distinct hash container type in the program
+
+static void register_mapa_types(const char *type)
+{
+    static const char *prefixes[] = {"mapa[", "conjunto[", "contador[", NULL};
+    for (int p = 0; type && prefixes[p]; p++)
+    {
+        for (const char *c = strstr(type, prefixes[p]); c; c = strstr(c + 1, prefixes[p]))
+        {
+            int depth = 0;
+            const char *end = strchr(c, '[');
+            for (; *end; end++)
+            {
+                if (*end == '[')
+                    depth++;
+                else if (*end == ']' && --depth == 0)
+                    break;
+            }
+            if (!*end)
+                continue;
+            sds found = sdsnewlen(c, end - c + 1);
+            sds key = mapa_part(found, 0);
+            if (!key)
+            {
+                fprintf(stderr, "[Basalto] Erro: '%s' precisa de chave e valor (mapa[K, V]).\n", found);
+                exit(1);
+            }
+            sdsfree(key);
+            if (name_in_list(mapa_types, found))
+                sdsfree(found);
+            else
+                arrput(mapa_types, found);
+        }
+    }
+}
+
+// Collect map types from declarations, parameters, fields and return types
+static void collect_mapa_types(ASTNode *node)
+{
+    if (!node)
+        return;
+    register_mapa_types(node->data_type);
+    if (node->type == NODE_VAR_REF)
+        register_mapa_types(node->string_value);
+    for (int i = 0; i < arrlen(node->children); i++)
+        collect_mapa_types(node->children[i]);
+    collect_mapa_types(node->start);
+    collect_mapa_types(node->end);
+    collect_mapa_types(node->step);
+}
+
+// 'typedef struct BsMapa_K_V BsMapa_K_V;' (entries may hold any struct)
+static void codegen_mapa_typedefs(FILE *file)
+{
+    for (int i = 0; i < arrlen(mapa_types); i++)
+    {
+        sds name = mapa_c_name(mapa_types[i]);
+        fprintf(file, "typedef struct %s %s;\n", name, name);
+        sdsfree(name);
+    }
+}
+
+// Entry layouts, once every struct they may embed is complete
+static void codegen_mapa_structs(FILE *file)
+{
+    for (int i = 0; i < arrlen(mapa_types); i++)
+    {
+        sds name = mapa_c_name(mapa_types[i]);
+        sds key = mapa_part(mapa_types[i], 0);
+        sds value = mapa_part(mapa_types[i], 1);
+        sds c_key = field_c_type(key);
+        fprintf(file, "struct %s {\n    %s key;\n", name, c_key);
+        if (value)
+        {
+            sds c_value = field_c_type(value);
+            fprintf(file, "    %s value;\n", c_value);
+            sdsfree(c_value);
+        }
+        fprintf(file, "};\n\n");
+        sdsfree(name);
+        sdsfree(key);
+        sdsfree(value);
+        sdsfree(c_key);
+    }
+}
+
+typedef struct
+{
+    const char *name;
+    int arity;
+} HashMethod;
+
+static const HashMethod mapa_methods[] = {
+    {"obter", 1},
+    {"definir", 2},
+    {"contem", 1},
+    {"remover", 1},
+    {"len", 0},
+    {"reservar", 1},
+    {"limpar", 0},
+    {NULL, 0},
+};
+
+// contador[T] also accepts every map method
+static const HashMethod contador_methods[] = {
+    {"adicionar", 1},
+    {"adicionar_todos", 1},
+    {"contar", 1},
+    {NULL, 0},
+};
+
+static const HashMethod conjunto_methods[] = {
+    {"inserir", 1},
+    {"inserir_todos", 1},
+    {"contem", 1},
+    {"remover", 1},
+    {"len", 0},
+    {"reservar", 1},
+    {"limpar", 0},
+    {"uniao", 1},
+    {"intersecao", 1},
+    {"diferenca", 1},
+    {NULL, 0},
+};
+
+static int hash_method_lookup(const HashMethod *methods, const char *method)
+{
+    for (int i = 0; methods[i].name; i++)
+    {
+        if (strcmp(method, methods[i].name) == 0)
+            return methods[i].arity;
+    }
+    return -1;
+}
+
+// Arity of a method of the hash container 'type', -1 if 'method' is not one
+static int mapa_method_arity(const char *type, const char *method)
+{
+    if (is_conjunto_type(type))
+        return hash_method_lookup(conjunto_methods, method);
+    if (is_contador_type(type) && hash_method_lookup(contador_methods, method) >= 0)
+        return hash_method_lookup(contador_methods, method);
+    return hash_method_lookup(mapa_methods, method);
+}
+
+// m.reservar(n): stb_ds has no public call to presize a map, so this helper
+// grows the entry array and rebuilds the index once for 'n' entries
+static void write_mapa_reservar(void)
+{
+    FILE *f = helper_file;
+    fprintf(f, "static void *bs_mapa_reservar(void *t, size_t elemsize, size_t n, int mode)\n{\n");
+    fprintf(f, "    if (t == NULL)\n        t = stbds_shmode_func(elemsize, mode);\n");
+    fprintf(f, "    char *raw = STBDS_HASH_TO_ARR(t, elemsize);\n");
+    fprintf(f, "    raw = stbds_arrgrowf(raw, elemsize, 0, n + 1);\n");
+    fprintf(f, "    stbds_hash_index *table = stbds_header(raw)->hash_table;\n");
+    fprintf(f, "    if (table == NULL)\n    {\n");
+    fprintf(f, "        table = stbds_header(raw)->hash_table = stbds_make_hash_index(STBDS_BUCKET_LENGTH, NULL);\n");
+    fprintf(f, "        table->string.mode = (unsigned char)mode;\n    }\n");
+    fprintf(f, "    size_t slots = table->slot_count;\n");
+    fprintf(f, "    while (slots - (slots >> 2) <= n)\n        slots *= 2;\n");
+    fprintf(f, "    if (slots != table->slot_count)\n    {\n");
+    fprintf(f, "        stbds_header(raw)->hash_table = stbds_make_hash_index(slots, table);\n");
+    fprintf(f, "        STBDS_FREE(NULL, table);\n    }\n");
+    fprintf(f, "    return STBDS_ARR_TO_HASH(raw, elemsize);\n}\n\n");
+}
+
+// Set/counter helpers, one per key type. Bulk variants keep the table in a
+// local for the whole loop instead of reloading it through the caller.
+static void write_hash_helper(const char *name, const char *op, const char *type)
+{
+    FILE *f = helper_file;
+    sds entry = mapa_c_name(type);
+    sds key = mapa_part(type, 0);
+    sds c_key = field_c_type(key);
+    bool texto = strcmp(map_type(key), "char*") == 0;
+    const char *api = texto ? "sh" : "hm";
+    const char *init = texto ? "    if (!t)\n        sh_new_arena(t);\n" : "";
+
+    if (strcmp(op, "adicionar") == 0 || strcmp(op, "adicionar_todos") == 0)
+    {
+        bool bulk = strcmp(op, "adicionar_todos") == 0;
+        if (bulk)
+            fprintf(f, "static void %s(%s **c, %s *xs, ptrdiff_t n)\n{\n", name, entry, c_key);
+        else
+            fprintf(f, "static void %s(%s **c, %s k)\n{\n", name, entry, c_key);
+        fprintf(f, "    %s *t = *c;\n%s", entry, init);
+        const char *indent = bulk ? "        " : "    ";
+        if (bulk)
+            fprintf(f, "    for (ptrdiff_t j = 0; j < n; j++)\n    {\n        %s k = xs[j];\n", c_key);
+        fprintf(f, "%sptrdiff_t i = %sgeti(t, k);\n", indent, api);
+        fprintf(f, "%sif (i >= 0)\n%s    t[i].value++;\n", indent, indent);
+        fprintf(f, "%selse\n%s    %sput(t, k, 1);\n", indent, indent, api);
+        if (bulk)
+            fprintf(f, "    }\n");
+        fprintf(f, "    *c = t;\n}\n\n");
+    }
+    else if (strcmp(op, "inserir_todos") == 0)
+    {
+        fprintf(f, "static void %s(%s **s, %s *xs, ptrdiff_t n)\n{\n", name, entry, c_key);
+        fprintf(f, "    %s *t = *s;\n%s", entry, init);
+        fprintf(f, "    for (ptrdiff_t i = 0; i < n; i++)\n    {\n");
+        fprintf(f, "        %s e = {xs[i]};\n        %sputs(t, e);\n    }\n", entry, api);
+        fprintf(f, "    *s = t;\n}\n\n");
+    }
+    else
+    {
+        // uniao / intersecao / diferenca: a new set
+        fprintf(f, "static %s *%s(%s *a, %s *b)\n{\n", entry, name, entry, entry);
+        fprintf(f, "    %s *t = NULL;\n%s", entry, init);
+        if (strcmp(op, "uniao") == 0)
+        {
+            fprintf(f, "    for (ptrdiff_t i = 0; i < %slen(a); i++)\n        %sputs(t, a[i]);\n", api, api);
+            fprintf(f, "    for (ptrdiff_t i = 0; i < %slen(b); i++)\n        %sputs(t, b[i]);\n", api, api);
+        }
+        else if (strcmp(op, "intersecao") == 0)
+        {
+            // Probe the larger set with the keys of the smaller one
+            fprintf(f, "    if (%slen(a) > %slen(b))\n    {\n        %s *x = a;\n        a = b;\n        b = x;\n    }\n", api, api, entry);
+            fprintf(f, "    for (ptrdiff_t i = 0; i < %slen(a); i++)\n", api);
+            fprintf(f, "        if (b && %sgeti(b, a[i].key) >= 0)\n            %sputs(t, a[i]);\n", api, api);
+        }
+        else
+        {
+            fprintf(f, "    for (ptrdiff_t i = 0; i < %slen(a); i++)\n", api);
+            fprintf(f, "        if (!b || %sgeti(b, a[i].key) < 0)\n            %sputs(t, a[i]);\n", api, api);
+        }
+        fprintf(f, "    return t;\n}\n\n");
+    }
+    sdsfree(entry);
+    sdsfree(key);
+    sdsfree(c_key);
+}
+
+// Source text of an expression (for receivers that must be repeated as lvalues)
+static sds codegen_to_sds(ASTNode *node)
+{
+    char *buf = NULL;
+    size_t len = 0;
+    FILE *mem = open_memstream(&buf, &len);
+    codegen(node, mem);
+    fclose(mem);
+    sds text = sdsnewlen(buf, len);
+    free(buf);
+    return text;
+}
+
+// m.obter(k) / m.definir(k, v) / m.contem(k) / m.remover(k) / m.len / m.reservar(n) / m.limpar()
+// s.inserir(x) / s.inserir_todos(xs) / s.uniao(t) / s.intersecao(t) / s.diferenca(t)
+// c.adicionar(x) / c.adicionar_todos(xs) / c.contar(x)
+static void codegen_mapa_method(ASTNode *node, const char *method, FILE *file)
+{
+    ASTNode *map = node->children[0];
+    const char *type = infer_type(map);
+    int argc = arrlen(node->children) - 1;
+    int arity = mapa_method_arity(type, method);
+    if (argc != arity)
+    {
+        fprintf(stderr, "[Basalto] Erro: '.%s' espera %d argumento(s), recebeu %d.\n", method, arity, argc);
+        exit(1);
+    }
+
+    sds key = mapa_part(type, 0);
+    sds value = mapa_part(type, 1);
+    sds c_key = field_c_type(key);
+    sds c_value = value ? field_c_type(value) : NULL;
+    sds entry = mapa_c_name(type);
+    sds suffix = helper_suffix(key);
+    bool texto = strcmp(map_type(key), "char*") == 0;
+    const char *api = texto ? "sh" : "hm";
+
+    // The map expression is an lvalue: stb_ds may move it on every call
+    sds m = codegen_to_sds(map);
+
+    if (strcmp(method, "obter") == 0 || strcmp(method, "contar") == 0)
+    {
+        // Absent keys yield the zero value
+        fprintf(file, "((%s) ? %sget((%s), ", m, api, m);
+        codegen_converted(key, node->children[1], file);
+        fprintf(file, ") : (%s){0})", c_value);
+    }
+    else if (strcmp(method, "definir") == 0)
+    {
+        // Key and value are evaluated first: put reassigns the map pointer,
+        // so m.definir(k, m.obter(k) + 1) must not read it mid-update
+        fprintf(file, "({ %s _mk = ", c_key);
+        codegen_converted(key, node->children[1], file);
+        fprintf(file, "; %s _mv = ", c_value);
+        codegen_converted(value, node->children[2], file);
+        fprintf(file, "; ");
+        if (texto)
+            fprintf(file, "if (!(%s)) sh_new_arena(%s); ", m, m);
+        fprintf(file, "%sput((%s), _mk, _mv); })", api, m);
+    }
+    else if (strcmp(method, "inserir") == 0)
+    {
+        fprintf(file, "({ %s _me = {", entry);
+        codegen_converted(key, node->children[1], file);
+        fprintf(file, "}; ");
+        if (texto)
+            fprintf(file, "if (!(%s)) sh_new_arena(%s); ", m, m);
+        fprintf(file, "%sputs((%s), _me); })", api, m);
+    }
+    else if (strcmp(method, "contem") == 0)
+    {
+        fprintf(file, "((%s) ? %sgeti((%s), ", m, api, m);
+        codegen_converted(key, node->children[1], file);
+        fprintf(file, ") >= 0 : 0)");
+    }
+    else if (strcmp(method, "remover") == 0)
+    {
+        // True if the key was present
+        fprintf(file, "((%s) ? %sdel((%s), ", m, api, m);
+        codegen_converted(key, node->children[1], file);
+        fprintf(file, ") : 0)");
+    }
+    else if (strcmp(method, "len") == 0)
+    {
+        fprintf(file, "%slen(%s)", api, m);
+    }
+    else if (strcmp(method, "reservar") == 0)
+    {
+        if (helper_needed("bs_mapa_reservar"))
+            write_mapa_reservar();
+        fprintf(file, "((%s) = bs_mapa_reservar((%s), sizeof *(%s), (size_t)(", m, m, m);
+        codegen(node->children[1], file);
+        fprintf(file, "), %s))", texto ? "STBDS_SH_ARENA" : "STBDS_SH_NONE");
+    }
+    else if (strcmp(method, "limpar") == 0)
+    {
+        // Releases entries, index and key arena
+        fprintf(file, "%sfree(%s)", api, m);
+    }
+    else if (strcmp(method, "adicionar") == 0)
+    {
+        sds name = sdscatprintf(sdsempty(), "bs_contador_adicionar_%s", suffix);
+        if (helper_needed(name))
+            write_hash_helper(name, method, type);
+        fprintf(file, "%s(&(%s), ", name, m);
+        codegen_converted(key, node->children[1], file);
+        fprintf(file, ")");
+        sdsfree(name);
+    }
+    else if (strcmp(method, "adicionar_todos") == 0 || strcmp(method, "inserir_todos") == 0)
+    {
+        // Bulk path from an array, fixed array or contiguous slice
+        ASTNode *source = node->children[1];
+        const char *source_type = infer_type(source);
+        sds elem = sequence_element(source_type);
+        sds soa = soa_element(source_type);
+        if (!elem || soa || strcmp(elem, key) != 0)
+        {
+            fprintf(stderr, "[Basalto] Erro: '.%s' espera um array de '%s', recebeu '%s'.\n",
+                    method, key, source_type ? source_type : "?");
+            exit(1);
+        }
+        sds name = sdscatprintf(sdsempty(), "bs_%s_%s_%s", is_conjunto_type(type) ? "conjunto" : "contador", method, suffix);
+        if (helper_needed(name))
+            write_hash_helper(name, method, type);
+        codegen_sequence_bind(source, source_type, file);
+        fprintf(file, "%s(&(%s), _sd, _sn); })", name, m);
+        sdsfree(name);
+        sdsfree(elem);
+    }
+    else
+    {
+        // uniao / intersecao / diferenca of two sets of the same type
+        ASTNode *other = node->children[1];
+        const char *other_type = infer_type(other);
+        if (!other_type || strcmp(other_type, type) != 0)
+        {
+            fprintf(stderr, "[Basalto] Erro: '.%s' espera outro '%s', recebeu '%s'.\n",
+                    method, type, other_type ? other_type : "?");
+            exit(1);
+        }
+        sds name = sdscatprintf(sdsempty(), "bs_conjunto_%s_%s", method, suffix);
+        if (helper_needed(name))
+            write_hash_helper(name, method, type);
+        fprintf(file, "%s(%s, ", name, m);
+        codegen(other, file);
+        fprintf(file, ")");
+        sdsfree(name);
+    }
+    sdsfree(m);
+    sdsfree(key);
+    sdsfree(value);
+    sdsfree(c_key);
+    sdsfree(c_value);
+    sdsfree(entry);
+    sdsfree(suffix);
+}
+
+// cada (k, v: mapa) / cada (x: conjunto): walks the entry array in insertion
+// order (removals move the last entry into the freed slot)
+static void codegen_mapa_cada(ASTNode *node, FILE *file)
+{
+    static int mapa_loop_counter = 0;
+    int id = mapa_loop_counter++;
+    const char *type = infer_type(node->start);
+    if (node->name ? !(is_mapa_type(type) || is_contador_type(type)) : !is_conjunto_type(type))
+    {
+        if (node->name)
+            fprintf(stderr, "[Basalto] Erro: 'cada (%s, %s: ...)' espera um mapa ou contador, recebeu '%s'.\n",
+                    node->cada_var, node->name, type ? type : "?");
+        else
+            fprintf(stderr, "[Basalto] Erro: 'cada (%s: ...)' espera um conjunto, recebeu '%s'.\n",
+                    node->cada_var, type ? type : "?");
+        exit(1);
+    }
+    sds key = mapa_part(type, 0);
+    sds value = mapa_part(type, 1);
+    sds c_key = field_c_type(key);
+
+    fprintf(file, "    %s _m%d = ", map_type(type), id);
+    codegen(node->start, file);
+    fprintf(file, ";\n");
+    fprintf(file, "    for (ptrdiff_t _mi%d = 0; _mi%d < hmlen(_m%d); _mi%d++) {\n", id, id, id, id);
+    fprintf(file, "    %s %s = _m%d[_mi%d].key;\n", c_key, node->cada_var, id, id);
+    fprintf(file, "    (void)%s;\n", node->cada_var);
+
+    scope_enter();
+    bool ref_key = is_struct_type(key) && !is_value_struct(key);
+    sds key_binding = ref_key ? sdscatprintf(sdsempty(), "%s*", key) : sdsdup(key);
+    scope_bind(node->cada_var, key_binding);
+    if (node->name)
+    {
+        sds c_value = field_c_type(value);
+        bool ref_value = is_struct_type(value) && !is_value_struct(value);
+        sds value_binding = ref_value ? sdscatprintf(sdsempty(), "%s*", value) : sdsdup(value);
+        fprintf(file, "    %s %s = _m%d[_mi%d].value;\n", c_value, node->name, id, id);
+        fprintf(file, "    (void)%s;\n", node->name);
+        scope_bind(node->name, value_binding);
+        sdsfree(c_value);
+    }
+    if (arrlen(node->children) > 0)
+    {
+        codegen(node->children[0], file); // Block
+    }
+    scope_exit();
+    fprintf(file, "    }\n");
+
+    sdsfree(key);
+    sdsfree(value);
+    sdsfree(c_key);
+}
+
+// --- QUEUES ---
+// fila[T]: a BsFila ring buffer (power-of-two capacity, O(1) at both ends).
+// fila_prioridade[T]: a binary min-heap in a plain [T] buffer. Its ordering is
+// fixed by the type, so the comparison is inlined into per-type helpers:
+// - fila_prioridade[T]: T itself (numbers, texto);
+// - fila_prioridade[T, campo]: a field of the struct T;
+// - fila_prioridade[T, menor]: a user function menor(a: T, b: T): booleano.
+
+static const struct
+{
+    const char *name;
+    int arity;
+    bool heap; // Also valid on fila_prioridade
+} fila_methods[] = {
+    {"push", 1, true},
+    {"pop", 0, true},
+    {"push_frente", 1, false},
+    {"pop_frente", 0, false},
+    {"frente", 0, false},
+    {"fim", 0, false},
+    {"topo", 0, true},
+    {"len", 0, true},
+    {"vazia", 0, true},
+    {"limpar", 0, true},
+    {"reservar", 1, true},
+    {NULL, 0, false},
+};
+
+// Arity of a queue method, -1 if 'method' is not one for 'type'
+static int fila_method_arity(const char *type, const char *method)
+{
+    bool heap = is_fila_prioridade_type(type);
+    for (int i = 0; fila_methods[i].name; i++)
+    {
+        if (strcmp(method, fila_methods[i].name) == 0 && (!heap || fila_methods[i].heap))
+            return fila_methods[i].arity;
+    }
+    return -1;
+}
+
+// BS_MENOR(bs_x, bs_y) of a priority queue type
+static sds heap_less(const char *type)
+{
+    sds elem = fila_part(type, 0);
+    sds order = fila_part(type, 1);
+    sds less = NULL;
+    if (!order)
+    {
+        less = less_expr(elem, "bs_x", "bs_y");
+        if (!less)
+        {
+            fprintf(stderr, "[Basalto] Erro: '%s' nao tem ordem natural; use fila_prioridade[%s, campo] "
+                            "ou fila_prioridade[%s, funcao_menor].\n", elem, elem, elem);
+            exit(1);
+        }
+    }
+    else if (is_struct_type(elem) && lookup_field_type(elem, order))
+    {
+        const char *access = (is_struct_type(elem) && !is_value_struct(elem)) ? "->" : ".";
+        sds x = sdscatprintf(sdsempty(), "(bs_x)%s%s", access, order);
+        sds y = sdscatprintf(sdsempty(), "(bs_y)%s%s", access, order);
+        less = less_expr(lookup_field_type(elem, order), x, y);
+        sdsfree(x);
+        sdsfree(y);
+        if (!less)
+        {
+            fprintf(stderr, "[Basalto] Erro: o campo '%s' de '%s' nao pode ser ordenado.\n", order, elem);
+            exit(1);
+        }
+    }
+    else if (shget(func_defs, order))
+    {
+        less = sdscatprintf(sdsempty(), "%s((bs_x), (bs_y))", order);
+    }
+    else
+    {
+        fprintf(stderr, "[Basalto] Erro: '%s' nao e campo de '%s' nem funcao (em '%s').\n", order, elem, type);
+        exit(1);
+    }
+    sdsfree(elem);
+    sdsfree(order);
+    return less;
+}
+
+// bs_heap_<tipo>_push / _pop: sift-up and sift-down with the ordering inlined
+static void write_heap_helpers(const char *name, const char *type)
+{
+    FILE *f = helper_file;
+    sds elem = fila_part(type, 0);
+    sds c_elem = field_c_type(elem);
+    sds less = heap_less(type);
+    fprintf(f, "#define BS_MENOR(bs_x, bs_y) %s\n", less);
+    fprintf(f, "static void %s_push(%s **h, %s v)\n{\n", name, c_elem, c_elem);
+    fprintf(f, "    arrput(*h, v);\n    %s *a = *h;\n    ptrdiff_t i = arrlen(a) - 1;\n", c_elem);
+    fprintf(f, "    while (i > 0)\n    {\n        ptrdiff_t p = (i - 1) / 2;\n");
+    fprintf(f, "        if (!BS_MENOR(v, a[p]))\n            break;\n");
+    fprintf(f, "        a[i] = a[p];\n        i = p;\n    }\n    a[i] = v;\n}\n\n");
+
+    fprintf(f, "static %s %s_pop(%s **h)\n{\n", c_elem, name, c_elem);
+    fprintf(f, "    %s *a = *h;\n    ptrdiff_t n = arrlen(a);\n", c_elem);
+    fprintf(f, "    if (n == 0)\n        bs_fila_vazia();\n");
+    fprintf(f, "    %s top = a[0];\n    %s last = a[--n];\n    arrsetlen(*h, n);\n", c_elem, c_elem);
+    fprintf(f, "    ptrdiff_t i = 0;\n    for (;;)\n    {\n");
+    fprintf(f, "        ptrdiff_t c = 2 * i + 1;\n        if (c >= n)\n            break;\n");
+    fprintf(f, "        if (c + 1 < n && BS_MENOR(a[c + 1], a[c]))\n            c++;\n");
+    fprintf(f, "        if (!BS_MENOR(a[c], last))\n            break;\n");
+    fprintf(f, "        a[i] = a[c];\n        i = c;\n    }\n");
+    fprintf(f, "    if (n > 0)\n        a[i] = last;\n    return top;\n}\n");
+    fprintf(f, "#undef BS_MENOR\n\n");
+    sdsfree(elem);
+    sdsfree(c_elem);
+    sdsfree(less);
+}
+
+// q.push(x) / q.pop() / q.push_frente(x) / q.pop_frente() / q.frente() / q.fim() /
+// q.topo() / q.len / q.vazia() / q.limpar() / q.reservar(n)
+static void codegen_fila_method(ASTNode *node, const char *method, FILE *file)
+{
+    ASTNode *queue = node->children[0];
+    const char *type = infer_type(queue);
+    int argc = arrlen(node->children) - 1;
+    int arity = fila_method_arity(type, method);
+    if (argc != arity)
+    {
+        fprintf(stderr, "[Basalto] Erro: '.%s' espera %d argumento(s), recebeu %d.\n", method, arity, argc);
+        exit(1);
+    }
+    sds elem = fila_part(type, 0);
+    sds c_elem = field_c_type(elem);
+    sds q = codegen_to_sds(queue);
+
+    if (is_fila_prioridade_type(type))
+    {
+        sds order = fila_part(type, 1);
+        sds suffix = helper_suffix(elem);
+        sds name = order ? sdscatprintf(sdsempty(), "bs_heap_%s_%s", suffix, order) : sdscatprintf(sdsempty(), "bs_heap_%s", suffix);
+        if ((strcmp(method, "push") == 0 || strcmp(method, "pop") == 0) && helper_needed(name))
+            write_heap_helpers(name, type);
+        if (strcmp(method, "push") == 0)
+        {
+            fprintf(file, "%s_push(&(%s), ", name, q);
+            codegen_converted(elem, node->children[1], file);
+            fprintf(file, ")");
+        }
+        else if (strcmp(method, "pop") == 0)
+            fprintf(file, "%s_pop(&(%s))", name, q);
+        else if (strcmp(method, "topo") == 0)
+            fprintf(file, "(*(arrlen(%s) ? &(%s)[0] : (bs_fila_vazia(), (%s *)0)))", q, q, c_elem);
+        else if (strcmp(method, "len") == 0)
+            fprintf(file, "arrlen(%s)", q);
+        else if (strcmp(method, "vazia") == 0)
+            fprintf(file, "(arrlen(%s) == 0)", q);
+        else if (strcmp(method, "limpar") == 0)
+            fprintf(file, "arrsetlen(%s, 0)", q);
+        else
+        {
+            fprintf(file, "arrsetcap(%s, ", q);
+            codegen(node->children[1], file);
+            fprintf(file, ")");
+        }
+        sdsfree(order);
+        sdsfree(suffix);
+        sdsfree(name);
+    }
+    else
+    {
+        const char *grow = "if (!(%s) || (%s)->len == (%s)->cap) (%s) = bs_fila_crescer((%s), sizeof(%s)); ";
+        const char *check = "if (!(%s) || !(%s)->len) bs_fila_vazia(); ";
+        if (strcmp(method, "push") == 0 || strcmp(method, "push_frente") == 0)
+        {
+            // The value is evaluated before the buffer may move
+            fprintf(file, "({ %s _fv = ", c_elem);
+            codegen_converted(elem, node->children[1], file);
+            fprintf(file, "; ");
+            fprintf(file, grow, q, q, q, q, q, c_elem);
+            if (strcmp(method, "push") == 0)
+                fprintf(file, "((%s *)(%s)->dados)[((%s)->cabeca + (%s)->len++) & ((%s)->cap - 1)] = _fv; })", c_elem, q, q, q, q);
+            else
+                fprintf(file, "(%s)->cabeca = ((%s)->cabeca - 1) & ((%s)->cap - 1); (%s)->len++; ((%s *)(%s)->dados)[(%s)->cabeca] = _fv; })",
+                        q, q, q, q, c_elem, q, q);
+        }
+        else if (strcmp(method, "pop") == 0 || strcmp(method, "fim") == 0)
+        {
+            fprintf(file, "({ ");
+            fprintf(file, check, q, q);
+            fprintf(file, "((%s *)(%s)->dados)[((%s)->cabeca + %s(%s)->len%s) & ((%s)->cap - 1)]; })",
+                    c_elem, q, q, strcmp(method, "pop") == 0 ? "--" : "", q, strcmp(method, "pop") == 0 ? "" : " - 1", q);
+        }
+        else if (strcmp(method, "pop_frente") == 0)
+        {
+            fprintf(file, "({ ");
+            fprintf(file, check, q, q);
+            fprintf(file, "%s _fv = ((%s *)(%s)->dados)[(%s)->cabeca]; ", c_elem, c_elem, q, q);
+            fprintf(file, "(%s)->cabeca = ((%s)->cabeca + 1) & ((%s)->cap - 1); (%s)->len--; _fv; })", q, q, q, q);
+        }
+        else if (strcmp(method, "frente") == 0 || strcmp(method, "topo") == 0)
+        {
+            fprintf(file, "({ ");
+            fprintf(file, check, q, q);
+            fprintf(file, "((%s *)(%s)->dados)[(%s)->cabeca]; })", c_elem, q, q);
+        }
+        else if (strcmp(method, "len") == 0)
+            fprintf(file, "((%s) ? (long long)(%s)->len : 0)", q, q);
+        else if (strcmp(method, "vazia") == 0)
+            fprintf(file, "(!(%s) || (%s)->len == 0)", q, q);
+        else if (strcmp(method, "limpar") == 0)
+            fprintf(file, "((%s) ? (void)((%s)->len = 0, (%s)->cabeca = 0) : (void)0)", q, q, q);
+        else
+        {
+            fprintf(file, "((%s) = bs_fila_reservar((%s), (size_t)(", q, q);
+            codegen(node->children[1], file);
+            fprintf(file, "), sizeof(%s)))", c_elem);
+        }
+    }
+    sdsfree(elem);
+    sdsfree(c_elem);
+    sdsfree(q);
+}
+
+// cada (x: fila): front to back
+static void codegen_fila_cada(ASTNode *node, FILE *file)
+{
+    static int fila_loop_counter = 0;
+    int id = fila_loop_counter++;
+    const char *type = infer_type(node->start);
+    sds elem = fila_part(type, 0);
+    sds c_elem = field_c_type(elem);
+
+    fprintf(file, "    BsFila *_f%d = ", id);
+    codegen(node->start, file);
+    fprintf(file, ";\n");
+    fprintf(file, "    for (size_t _fi%d = 0; _f%d && _fi%d < _f%d->len; _fi%d++) {\n", id, id, id, id, id);
+    fprintf(file, "    %s %s = ((%s *)_f%d->dados)[(_f%d->cabeca + _fi%d) & (_f%d->cap - 1)];\n",
+            c_elem, node->cada_var, c_elem, id, id, id, id);
+    fprintf(file, "    (void)%s;\n", node->cada_var);
+
+    scope_enter();
+    bool reference = is_struct_type(elem) && !is_value_struct(elem);
+    scope_bind(node->cada_var, reference ? sdscatprintf(sdsempty(), "%s*", elem) : sdsdup(elem));
+    if (arrlen(node->children) > 0)
+    {
+        codegen(node->children[0], file); // Block
+    }
+    scope_exit();
+    fprintf(file, "    }\n");
+    sdsfree(elem);
+    sdsfree(c_elem);
+}
+
+// --- STRING VIEWS (fatia_texto) ---
+// A fatia_texto is a BsFatiaTexto (pointer + length) into a texto, a
+// '[texto; compacto]' pool or a literal. '.sub', '.aparar' and '.dividir'
+// return views of the receiver's bytes, and '.comeca_com' / '.encontrar' /
+// '.contar' compare in place, so none of them copies ('.substituir' builds
+// its result in one exact-size allocation). Searching is SIMD in the runtime
+// (see STRING SEARCH in core.c). Every method works on both texto and
+// fatia_texto receivers and arguments.
+
+static const struct
+{
+    const char *name;
+    int arity;
+    const char *runtime; // bs_texto_* function taking the view first
+    const char *result;  // Basalto result type
+} texto_methods[] = {
+    {"sub", 2, "bs_texto_sub", "fatia_texto"},
+    {"aparar", 0, "bs_texto_aparar", "fatia_texto"},
+    {"dividir", 1, "bs_texto_dividir", "[fatia_texto]"},
+    {"comeca_com", 1, "bs_texto_comeca_com", "booleano"},
+    {"termina_com", 1, "bs_texto_termina_com", "booleano"},
+    {"encontrar", 1, "bs_texto_encontrar", "inteiro64"},
+    {"contar", 1, "bs_texto_contar", "inteiro64"},
+    {"substituir", 2, "bs_texto_substituir", "texto"},
+    {"hash", 0, "bs_texto_hash", "natural64"},
+    {"inteiros", 1, "bs_texto_inteiros", "[inteiro64]"},
+    {"reais", 1, "bs_texto_reais", "[real64]"},
+    {NULL, 0, NULL, NULL},
+};
+
+// Index of 'method' in texto_methods when 'type' is a string, -1 otherwise
+static int texto_method_index(const char *type, const char *method)
+{
+    if (!type || (strcmp(type, "texto") != 0 && !is_fatia_texto_type(type)))
+        return -1;
+    for (int i = 0; texto_methods[i].name; i++)
+    {
+        if (strcmp(method, texto_methods[i].name) == 0)
+            return i;
+    }
+    return -1;
+}
+
+// Basalto result type of a string method, NULL if 'method' is not one for 'type'
+static const char *texto_method_result(const char *type, const char *method)
+{
+    int m = texto_method_index(type, method);
+    return m >= 0 ? texto_methods[m].result : NULL;
+}
+
+// s.inteiro8() ... s.real_ext(): string -> number conversions (bs_texto_<tipo> in basalto.h)
+static bool is_conversao_numero(const char *method)
+{
+    static const char *tipos[] = {"inteiro8", "inteiro16", "inteiro32", "inteiro64", "inteiro_arq",
+                                  "real32", "real64", "real_ext", NULL};
+    for (int i = 0; tipos[i]; i++)
+    {
+        if (strcmp(method, tipos[i]) == 0)
+            return true;
+    }
+    return false;
+}
+
+// Runtime prefix of the bulk parsers for a string array type, NULL for other types
+static const char *textos_array_kind(const char *type)
+{
+    if (!type)
+        return NULL;
+    if (is_compacto_type(type))
+        return "textos";
+    if (strcmp(type, "[texto]") == 0)
+        return "array_texto";
+    if (strcmp(type, "[fatia_texto]") == 0)
+        return "array_fatia_texto";
+    return NULL;
+}
+
+// 'expr' (texto, fatia_texto, a builder or a literal) as a BsFatiaTexto, without copying
+static void codegen_as_fatia_texto(ASTNode *expr, FILE *file)
+{
+    const char *type = infer_type(expr);
+    if (is_fatia_texto_type(type))
+    {
+        codegen(expr, file);
+    }
+    else if (is_construtor_type(type))
+    {
+        fprintf(file, "bs_construtor_vista(");
+        codegen(expr, file);
+        fprintf(file, ")");
+    }
+    else if (expr->type == NODE_LITERAL_STRING && !strstr(expr->string_value, "${"))
+    {
+        // Literal: the bytes live in the C string table
+        const char *cursor = expr->string_value;
+        fprintf(file, "((BsFatiaTexto){ \"");
+        codegen_literal_text(&cursor, file);
+        fprintf(file, "\", sizeof(\"");
+        cursor = expr->string_value;
+        codegen_literal_text(&cursor, file);
+        fprintf(file, "\") - 1 })");
+    }
+    else if (!type || strcmp(type, "texto") == 0)
+    {
+        fprintf(file, "bs_fatia_texto_de(");
+        codegen(expr, file);
+        fprintf(file, ")");
+    }
+    else
+    {
+        fprintf(stderr, "[Basalto] Erro: esperado 'texto' ou 'fatia_texto', recebeu '%s'.\n", type);
+        exit(1);
+    }
+}
+
+// Compile-time bs_hash_bytes (basalto.h) for literals: keep the two in sync
+static uint64_t literal_hash_mix(uint64_t a, uint64_t b)
+{
+    __uint128_t r = (__uint128_t)a * b;
+    return (uint64_t)r ^ (uint64_t)(r >> 64);
+}
+
+static uint64_t literal_hash_ler(const unsigned char *p, int n)
+{
+    uint64_t v = 0;
+    if (n == 8)
+        memcpy(&v, p, 8);
+    else
+    {
+        uint32_t w;
+        memcpy(&w, p, 4);
+        v = w;
+    }
+    return v;
+}
+
+static uint64_t literal_hash(const char *dados, size_t len)
+{
+    const unsigned char *p = (const unsigned char *)dados;
+    uint64_t a, b, seed = 0;
+    seed ^= literal_hash_mix(seed ^ 0xa0761d6478bd642full, 0xe7037ed1a0b428dbull);
+    if (len <= 16)
+    {
+        if (len >= 4)
+        {
+            size_t meio = (len >> 3) << 2;
+            a = (literal_hash_ler(p, 4) << 32) | literal_hash_ler(p + meio, 4);
+            b = (literal_hash_ler(p + len - 4, 4) << 32) | literal_hash_ler(p + len - 4 - meio, 4);
+        }
+        else if (len > 0)
+        {
+            a = ((uint64_t)p[0] << 16) | ((uint64_t)p[len >> 1] << 8) | p[len - 1];
+            b = 0;
+        }
+        else
+        {
+            a = b = 0;
+        }
+    }
+    else
+    {
+        size_t i = len;
+        while (i > 16)
+        {
+            seed = literal_hash_mix(literal_hash_ler(p, 8) ^ 0xe7037ed1a0b428dbull, literal_hash_ler(p + 8, 8) ^ seed);
+            p += 16;
+            i -= 16;
+        }
+        a = literal_hash_ler(p + i - 16, 8);
+        b = literal_hash_ler(p + i - 8, 8);
+    }
+    __uint128_t r = (__uint128_t)(a ^ 0xe7037ed1a0b428dbull) * (b ^ seed);
+    return literal_hash_mix((uint64_t)r ^ 0xa0761d6478bd642full ^ len, (uint64_t)(r >> 64) ^ 0xe7037ed1a0b428dbull);
+}
+
+// s.sub(a, b) / s.aparar() / s.dividir(sep) / s.comeca_com(p) / s.termina_com(p) /
+// s.encontrar(p) / s.contar(p) / s.substituir(de, para) / s.hash()
+static void codegen_texto_method(ASTNode *node, const char *method, FILE *file)
+{
+    int m = texto_method_index(infer_type(node->children[0]), method);
+    int argc = arrlen(node->children) - 1;
+    if (argc != texto_methods[m].arity)
+    {
+        fprintf(stderr, "[Basalto] Erro: '.%s' espera %d argumento(s), recebeu %d.\n", method, texto_methods[m].arity, argc);
+        exit(1);
+    }
+    ASTNode *receiver = node->children[0];
+    if (strcmp(method, "hash") == 0 && receiver->type == NODE_LITERAL_STRING && !strpbrk(receiver->string_value, "\\$"))
+    {
+        // "literal".hash(): folded here (no escapes or interpolation to decode)
+        fprintf(file, "0x%016llxull", (unsigned long long)literal_hash(receiver->string_value, strlen(receiver->string_value)));
+        return;
+    }
+    fprintf(file, "%s(", texto_methods[m].runtime);
+    codegen_as_fatia_texto(node->children[0], file);
+    for (int i = 1; i <= argc; i++)
+    {
+        fprintf(file, ", ");
+        if (strcmp(method, "sub") == 0)
+            codegen(node->children[i], file);
+        else
+            codegen_as_fatia_texto(node->children[i], file);
+    }
+    fprintf(file, ")");
+}
+
+// a == b / a != b on two strings: lengths first, then memcmp (bs_texto_igual).
+// Literals carry their length as a sizeof. Returns false (nothing emitted) when
+// this is not a string comparison.
+static bool codegen_texto_comparacao(const char *op, ASTNode *left, ASTNode *right, FILE *file)
+{
+    if ((strcmp(op, "==") != 0 && strcmp(op, "!=") != 0) || !is_string_operand(left) || !is_string_operand(right))
+        return false;
+    fprintf(file, "%sbs_texto_igual(", strcmp(op, "!=") == 0 ? "!" : "");
+    codegen_as_fatia_texto(left, file);
+    fprintf(file, ", ");
+    codegen_as_fatia_texto(right, file);
+    fprintf(file, ")");
+    return true;
+}
+
+// --- INPUT (ler) ---
+// Every form reads stdin through the runtime's block buffer (INPUT HELPERS in
+// core.c): 'x = ler()' parses one value and drops the rest of the line, the
+// bulk calls parse whole streams of tokens or lines.
+
+// 'ler()' assigned to a value of 'type'
+static void codegen_input_value(const char *type, FILE *file)
+{
+    const char *c_type = type ? map_type(type) : "int";
+    if (strcmp(c_type, "long long") == 0 || strcmp(c_type, "long") == 0)
+        fprintf(file, "read_long()");
+    else if (strcmp(c_type, "float") == 0)
+        fprintf(file, "read_float()");
+    else if (strcmp(c_type, "double") == 0)
+        fprintf(file, "read_double()");
+    else if (strcmp(c_type, "long double") == 0)
+        fprintf(file, "({ sds _l = read_string(); long double _x = bs_texto_real_ext(bs_fatia_texto_de(_l)); sdsfree(_l); _x; })");
+    else if (strcmp(c_type, "char*") == 0)
+        fprintf(file, "read_string()");
+    else
+        fprintf(file, "read_int()");
+}
+
+// ler_inteiros(n) / ler_reais(n) / ler_linhas() (calls unless the program defines them)
+static bool is_ler_em_bloco(ASTNode *call)
+{
+    if (call->type != NODE_FUNC_CALL || !call->name || shget(func_defs, call->name))
+        return false;
+    return strcmp(call->name, "ler_inteiros") == 0 || strcmp(call->name, "ler_reais") == 0 ||
+           strcmp(call->name, "ler_linhas") == 0;
+}
+
+static void codegen_ler_em_bloco(ASTNode *call, FILE *file)
+{
+    int argc = arrlen(call->children);
+    int max_args = strcmp(call->name, "ler_linhas") == 0 ? 0 : 1;
+    if (argc > max_args)
+    {
+        fprintf(stderr, "[Basalto] Erro: '%s' espera no maximo %d argumento(s), recebeu %d.\n", call->name, max_args, argc);
+        exit(1);
+    }
+    fprintf(file, "bs_%s(", call->name);
+    if (argc > 0)
+        codegen(call->children[0], file);
+    else if (max_args > 0)
+        fprintf(file, "-1"); // Up to EOF
+    fprintf(file, ")");
+}
+
+// --- PACKED STRING ARRAYS ([texto; compacto]) ---
+// '[texto; compacto]' is a BsTextos (see basalto.h): every element back to back
+// in one byte pool plus the end offset of each one, so pushing a string costs
+// a memcpy instead of an sds allocation. xs[i] is a fatia_texto view into the
+// pool: indexing, printing and 'cada' never build an sds, and a view becomes an
+// owned string only through '.texto()' or when stored into a 'texto'.
+
+// Arity of a packed string array method, -1 if 'method' is not one
+// (reservar also takes an optional byte count)
+static int compacto_method_arity(const char *method)
+{
+    if (strcmp(method, "push") == 0 || strcmp(method, "reservar") == 0)
+        return 1;
+    if (strcmp(method, "len") == 0 || strcmp(method, "limpar") == 0 || strcmp(method, "pop") == 0 ||
+        strcmp(method, "copiar") == 0)
+        return 0;
+    return -1;
+}
+
+// The pool only grows at the end: no other array method applies
+static void check_compacto_method(const char *type, const char *method)
+{
+    if (!is_compacto_type(type) || compacto_method_arity(method) >= 0 || strcmp(method, "inteiros") == 0 ||
+        strcmp(method, "reais") == 0)
+        return;
+    fprintf(stderr, "[Basalto] Erro: '.%s' nao existe em '[texto; compacto]'; use um '[texto]' para isso.\n", method);
+    exit(1);
+}
+
+// xs.push(s) / xs.pop() / xs.len / xs.limpar() / xs.copiar() / xs.reservar(n) / xs.reservar(n, bytes)
+static void codegen_compacto_method(ASTNode *node, const char *method, FILE *file)
+{
+    int argc = arrlen(node->children) - 1;
+    int arity = compacto_method_arity(method);
+    if (argc != arity && !(strcmp(method, "reservar") == 0 && argc == 2))
+    {
+        fprintf(stderr, "[Basalto] Erro: '.%s' espera %d argumento(s), recebeu %d.\n", method, arity, argc);
+        exit(1);
+    }
+    sds t = codegen_to_sds(node->children[0]);
+    if (strcmp(method, "push") == 0)
+    {
+        ASTNode *value = node->children[1];
+        bool view = is_fatia_texto_type(infer_type(value));
+        fprintf(file, "((%s) = bs_textos_push_%s((%s), ", t, view ? "fatia" : "texto", t);
+        if (view)
+            codegen(value, file);
+        else
+            codegen_converted("texto", value, file);
+        fprintf(file, "))");
+    }
+    else if (strcmp(method, "len") == 0)
+        fprintf(file, "bs_textos_len(%s)", t);
+    else if (strcmp(method, "limpar") == 0)
+        fprintf(file, "bs_textos_limpar(%s)", t);
+    else if (strcmp(method, "pop") == 0)
+        fprintf(file, "bs_textos_pop(%s)", t);
+    else if (strcmp(method, "copiar") == 0)
+        fprintf(file, "bs_textos_copiar(%s)", t);
+    else
+    {
+        fprintf(file, "((%s) = bs_textos_reservar((%s), ", t, t);
+        codegen(node->children[1], file);
+        fprintf(file, ", ");
+        if (argc == 2)
+            codegen(node->children[2], file);
+        else
+            fprintf(file, "0");
+        fprintf(file, "))");
+    }
+    sdsfree(t);
+}
+
+// A [texto] or a list literal stored into a '[texto; compacto]': packed copy
+static void codegen_compacto_from(ASTNode *expr, FILE *file)
+{
+    const char *source = infer_type(expr);
+    if (expr->type == NODE_ARRAY_LITERAL)
+    {
+        fprintf(file, "({ BsTextos *_tl = bs_textos_reservar(NULL, %d, 0); ", (int)arrlen(expr->children));
+        for (int i = 0; i < arrlen(expr->children); i++)
+        {
+            ASTNode *item = expr->children[i];
+            bool view = is_fatia_texto_type(infer_type(item));
+            fprintf(file, "_tl = bs_textos_push_%s(_tl, ", view ? "fatia" : "texto");
+            if (view)
+                codegen(item, file);
+            else
+                codegen_converted("texto", item, file);
+            fprintf(file, "); ");
+        }
+        fprintf(file, "_tl; })");
+    }
+    else if (source && strcmp(source, "[texto]") == 0)
+    {
+        fprintf(file, "bs_textos_de(");
+        codegen(expr, file);
+        fprintf(file, ")");
+    }
+    else if (!source)
+    {
+        codegen(expr, file);
+    }
+    else
+    {
+        fprintf(stderr, "[Basalto] Erro: '[texto; compacto]' espera um '[texto]' ou uma lista literal, recebeu '%s'.\n", source);
+        exit(1);
+    }
+}
+
+// cada (s: xs): each element as a view, first to last
+static void codegen_compacto_cada(ASTNode *node, FILE *file)
+{
+    static int compacto_loop_counter = 0;
+    int id = compacto_loop_counter++;
+
+    fprintf(file, "    BsTextos *_t%d = ", id);
+    codegen(node->start, file);
+    fprintf(file, ";\n");
+    fprintf(file, "    for (long long _ti%d = 0; _ti%d < bs_textos_len(_t%d); _ti%d++) {\n", id, id, id, id);
+    fprintf(file, "    BsFatiaTexto %s = bs_textos_em(_t%d, _ti%d);\n", node->cada_var, id, id);
+    fprintf(file, "    (void)%s;\n", node->cada_var);
+
+    scope_enter();
+    scope_bind(node->cada_var, "fatia_texto");
+    if (arrlen(node->children) > 0)
+    {
+        codegen(node->children[0], file); // Block
+    }
+    scope_exit();
+    fprintf(file, "    }\n");
+}
+
+// --- STRING BUILDERS (construtor_texto) ---
+// 'construtor_texto' is a BsConstrutor* (see basalto.h): one byte buffer that
+// doubles as it fills. sb.anexar(x) takes a texto, a fatia_texto, another
+// builder or any primitive: numbers are formatted straight into the buffer and
+// an interpolated literal is appended piece by piece, so no temporary sds is
+// built. sb.texto() copies the result out at its exact size.
+//
+// 'a + b' on strings copies every piece of the chain into one exact-size sds
+// (bs_texto_juntar) and never modifies an operand. A loop whose only use of a
+// texto is 's = s + ...' keeps it in a hidden builder instead (see
+// codegen_acumuladores): copied in before the loop, appended to by each of
+// those statements and stored back once after it.
+
+// Arity of a string builder method, -1 if 'method' is not one
+static int construtor_method_arity(const char *method)
+{
+    if (strcmp(method, "anexar") == 0 || strcmp(method, "reservar") == 0)
+        return 1;
+    if (strcmp(method, "len") == 0 || strcmp(method, "limpar") == 0)
+        return 0;
+    return -1;
+}
+
+// Helper: is 'type' a number, booleano, caractere or texto (a single print_any value)?
+static bool is_primitive_type(const char *type)
+{
+    static const char *c_types[] = {"int", "long long", "short", "signed char", "long", "unsigned char", "unsigned int",
+                                    "unsigned long long", "unsigned short", "unsigned long", "size_t", "float", "double",
+                                    "long double", "_Bool", "char*", "char", NULL};
+    if (!type)
+        return false;
+    const char *c_type = map_type(type);
+    for (int i = 0; c_types[i]; i++)
+    {
+        if (strcmp(c_type, c_types[i]) == 0)
+            return true;
+    }
+    return false;
+}
+
+// Helper: does 'node' evaluate to a string (texto, fatia_texto, or a '+' chain with one)?
+static bool is_string_operand(ASTNode *node)
+{
+    if (node->type == NODE_LITERAL_STRING)
+        return true;
+    if (node->type == NODE_BINARY_OP && node->data_type && strcmp(node->data_type, "+") == 0 && arrlen(node->children) >= 2)
+        return is_string_operand(node->children[0]) || is_string_operand(node->children[1]);
+    const char *type = infer_type(node);
+    return type && (strcmp(map_type(type), "char*") == 0 || is_fatia_texto_type(type));
+}
+
+// Pieces of a string '+' chain, left to right ("a + b + c" -> a, b, c)
+static void concat_leaves(ASTNode *node, ASTNode ***leaves)
+{
+    if (node->type == NODE_BINARY_OP && node->data_type && strcmp(node->data_type, "+") == 0 &&
+        arrlen(node->children) >= 2 && is_string_operand(node))
+    {
+        concat_leaves(node->children[0], leaves);
+        concat_leaves(node->children[1], leaves);
+    }
+    else
+    {
+        arrput(*leaves, node);
+    }
+}
+
+// Append 'value' to the builder 'c' (a C lvalue): an expression that stores the builder back
+static void codegen_construtor_anexar(const char *c, ASTNode *value, FILE *file)
+{
+    // x.texto() of a number: formatted in place instead (both go through _Generic)
+    if (value->type == NODE_METHOD_CALL && value->data_type && strcmp(value->data_type, "texto") == 0 && arrlen(value->children) == 1 &&
+        (!infer_type(value->children[0]) || is_primitive_type(infer_type(value->children[0]))))
+        value = value->children[0];
+    const char *type = infer_type(value);
+    if (value->type == NODE_LITERAL_STRING && strstr(value->string_value, "${"))
+    {
+        // Interpolated literal: the static text and every plain value go straight in
+        fprintf(file, "({ BsConstrutor *_cb = (%s); ", c);
+        const char *cursor = value->string_value;
+        int piece = 0;
+        while (*cursor != '\0')
+        {
+            if (starts_with(cursor, "${"))
+            {
+                char fmt_buffer[64];
+                int has_fmt = interp_split(&cursor, fmt_buffer);
+                ASTNode *expr = value->children[piece++];
+                const char *expr_type = infer_type(expr);
+                if (!has_fmt && (!expr_type || is_primitive_type(expr_type)))
+                {
+                    fprintf(file, "_cb = bs_construtor_anexar_valor(_cb, ");
+                    codegen(expr, file);
+                    fprintf(file, "); ");
+                }
+                else if (!has_fmt && (is_fatia_texto_type(expr_type) || is_construtor_type(expr_type)))
+                {
+                    fprintf(file, "_cb = bs_construtor_anexar_fatia(_cb, ");
+                    codegen_as_fatia_texto(expr, file);
+                    fprintf(file, "); ");
+                }
+                else
+                {
+                    // Formats, arrays, ...: through the interpolation engine
+                    fprintf(file, "_cb = bs_construtor_anexar_texto(_cb, ({ sds _s = sdsempty(); ");
+                    codegen_interp_piece(expr, has_fmt ? fmt_buffer : NULL, file);
+                    fprintf(file, "_s; })); ");
+                }
+            }
+            else
+            {
+                const char *start = cursor;
+                fprintf(file, "_cb = bs_construtor_anexar(_cb, \"");
+                codegen_literal_text(&cursor, file);
+                fprintf(file, "\", sizeof(\"");
+                codegen_literal_text(&start, file);
+                fprintf(file, "\") - 1); ");
+            }
+        }
+        fprintf(file, "(%s) = _cb; })", c);
+    }
+    else if (value->type == NODE_LITERAL_STRING || is_fatia_texto_type(type) || is_construtor_type(type))
+    {
+        fprintf(file, "((%s) = bs_construtor_anexar_fatia((%s), ", c, c);
+        codegen_as_fatia_texto(value, file);
+        fprintf(file, "))");
+    }
+    else if (!type || is_primitive_type(type))
+    {
+        fprintf(file, "((%s) = bs_construtor_anexar_valor((%s), ", c, c);
+        codegen(value, file);
+        fprintf(file, "))");
+    }
+    else
+    {
+        fprintf(stderr, "[Basalto] Erro: '.anexar' espera texto ou um valor primitivo, recebeu '%s'.\n", type);
+        exit(1);
+    }
+}
+
+// sb.anexar(x) / sb.len / sb.limpar() / sb.reservar(n)
+static void codegen_construtor_method(ASTNode *node, const char *method, FILE *file)
+{
+    int argc = arrlen(node->children) - 1;
+    int arity = construtor_method_arity(method);
+    if (argc != arity)
+    {
+        fprintf(stderr, "[Basalto] Erro: '.%s' espera %d argumento(s), recebeu %d.\n", method, arity, argc);
+        exit(1);
+    }
+    sds c = codegen_to_sds(node->children[0]);
+    if (strcmp(method, "anexar") == 0)
+        codegen_construtor_anexar(c, node->children[1], file);
+    else if (strcmp(method, "len") == 0)
+        fprintf(file, "bs_construtor_len(%s)", c);
+    else if (strcmp(method, "limpar") == 0)
+        fprintf(file, "bs_construtor_limpar(%s)", c);
+    else
+    {
+        fprintf(file, "((%s) = bs_construtor_reservar((%s), ", c, c);
+        codegen(node->children[1], file);
+        fprintf(file, "))");
+    }
+    sdsfree(c);
+}
+
+typedef struct
+{
+    char *key;   // texto variable
+    char *value; // Builder standing in for it
+} AcumuladorEntry;
+static AcumuladorEntry *acumuladores = NULL;
+static ASTNode *acumulador_loop = NULL; // Loop being generated by codegen_acumuladores
+
+// 's = s + ...' (the chain starts with the assigned variable); any variable when 'name' is NULL
+static bool is_acumulacao(ASTNode *node, const char *name)
+{
+    if (node->type != NODE_ASSIGN || !node->name || arrlen(node->children) != 1 || (name && strcmp(node->name, name) != 0))
+        return false;
+    ASTNode *value = node->children[0];
+    if (value->type != NODE_BINARY_OP || !is_string_operand(value))
+        return false;
+    ASTNode **leaves = NULL;
+    concat_leaves(value, &leaves);
+    bool found = arrlen(leaves) > 1 && leaves[0]->type == NODE_VAR_REF && leaves[0]->name &&
+                 strcmp(leaves[0]->name, node->name) == 0;
+    arrfree(leaves);
+    return found;
+}
+
+// Nodes under 'node' naming 'name' (uses, shadowing declarations, "${...}"
+// pieces), plus the 's = s + ...' statements among them; flags any 'retorne'
+static void acumulacao_usos(ASTNode *node, const char *name, int *usos, int *acumulacoes, bool *retorno)
+{
+    if (!node)
+        return;
+    if (node->type == NODE_RETURN)
+        *retorno = true;
+    if ((node->name && strcmp(node->name, name) == 0) || (node->cada_var && strcmp(node->cada_var, name) == 0))
+        (*usos)++;
+    if (is_acumulacao(node, name))
+        (*acumulacoes)++;
+    for (int i = 0; i < arrlen(node->children); i++)
+        acumulacao_usos(node->children[i], name, usos, acumulacoes, retorno);
+    acumulacao_usos(node->start, name, usos, acumulacoes, retorno);
+    acumulacao_usos(node->end, name, usos, acumulacoes, retorno);
+    acumulacao_usos(node->step, name, usos, acumulacoes, retorno);
+}
+
+// texto variables declared outside 'node' that a 's = s + ...' under it extends
+static void acumulacao_candidatos(ASTNode *node, char ***names)
+{
+    if (!node)
+        return;
+    if (is_acumulacao(node, NULL) && !shget(acumuladores, node->name) && !name_in_list(*names, node->name))
+    {
+        const char *type = scope_lookup(node->name);
+        if (type && strcmp(type, "texto") == 0)
+            arrput(*names, node->name);
+    }
+    for (int i = 0; i < arrlen(node->children); i++)
+        acumulacao_candidatos(node->children[i], names);
+}
+
+// A loop that only extends some texto 's' with 's = s + ...': generated inside
+// a block that moves 's' into a builder and back. False when there is none.
+static bool codegen_acumuladores(ASTNode *loop, FILE *file)
+{
+    if (loop == acumulador_loop)
+        return false;
+    char **candidates = NULL;
+    char **names = NULL;
+    acumulacao_candidatos(loop, &candidates);
+    for (int i = 0; i < arrlen(candidates); i++)
+    {
+        // Every use must be one of those statements (each names 's' twice)
+        int usos = 0, acumulacoes = 0;
+        bool retorno = false;
+        acumulacao_usos(loop, candidates[i], &usos, &acumulacoes, &retorno);
+        if (!retorno && acumulacoes > 0 && usos == 2 * acumulacoes)
+            arrput(names, candidates[i]);
+    }
+    arrfree(candidates);
+    if (arrlen(names) == 0)
+        return false;
+
+    static int acumulador_counter = 0;
+    fprintf(file, "    {\n");
+    for (int i = 0; i < arrlen(names); i++)
+    {
+        sds builder = sdscatprintf(sdsempty(), "_acc%d", acumulador_counter++);
+        fprintf(file, "    BsConstrutor *%s = bs_construtor_de(bs_fatia_texto_de(%s));\n", builder, names[i]);
+        shput(acumuladores, names[i], builder);
+    }
+
+    ASTNode *outer = acumulador_loop;
+    acumulador_loop = loop;
+    codegen(loop, file);
+    acumulador_loop = outer;
+
+    for (int i = 0; i < arrlen(names); i++)
+    {
+        char *builder = shget(acumuladores, names[i]);
+        fprintf(file, "    %s = bs_construtor_texto(%s);\n", names[i], builder);
+        fprintf(file, "    bs_construtor_liberar(%s);\n", builder);
+        (void)shdel(acumuladores, names[i]);
+        sdsfree(builder);
+    }
+    fprintf(file, "    }\n");
+    arrfree(names);
+    return true;
+}
+
+// 's = s + a + b' inside such a loop: a and b appended to the builder
+static void codegen_acumulacao(ASTNode *node, const char *builder, FILE *file)
+{
+    ASTNode **leaves = NULL;
+    concat_leaves(node->children[0], &leaves);
+    for (int i = 1; i < arrlen(leaves); i++)
+    {
+        fprintf(file, "    ");
+        codegen_construtor_anexar(builder, leaves[i], file);
+        fprintf(file, ";\n");
+    }
+    arrfree(leaves);
+}
+
+// --- SMALL ARRAYS ([T; ate N]) ---
+// '[T; ate N]' keeps up to N elements inline, in a BsPequeno_T_N struct that
+// lives in the stack frame or inside the owning struct, and moves them to one
+// heap buffer only when it grows past N. Codegen works on the struct's address:
+// locals and fields pass '&(xs)', parameters already are pointers. Elements are
+// reached through NAME_dados(p), so indexing, slicing, sorting and the array
+// methods all apply.
+
+static char **pequeno_types = NULL; // Every distinct small array type in the program
+
+static void register_pequeno_types(const char *type)
+{
+    for (const char *c = type ? strstr(type, "pequeno[") : NULL; c; c = strstr(c + 1, "pequeno["))
+    {
+        int depth = 0;
+        const char *end = c + 7;
+        for (; *end; end++)
+        {
+            if (*end == '[')
+                depth++;
+            else if (*end == ']' && --depth == 0)
+                break;
+        }
+        if (!*end)
+            continue;
+        sds found = sdsnewlen(c, end - c + 1);
+        if (name_in_list(pequeno_types, found))
+            sdsfree(found);
+        else
+            arrput(pequeno_types, found);
+    }
+}
+
+// Collect small array types from declarations, parameters, fields and return types
+static void collect_pequeno_types(ASTNode *node)
+{
+    if (!node)
+        return;
+    register_pequeno_types(node->data_type);
+    if (node->type == NODE_VAR_REF)
+        register_pequeno_types(node->string_value);
+    for (int i = 0; i < arrlen(node->children); i++)
+        collect_pequeno_types(node->children[i]);
+    collect_pequeno_types(node->start);
+    collect_pequeno_types(node->end);
+    collect_pequeno_types(node->step);
+}
+
+// Type as written in Basalto: "pequeno[T;N]" -> "[T; ate N]"
+static sds pequeno_display(const char *type)
+{
+    sds elem = sequence_element(type);
+    sds shown = sdscatprintf(sdsempty(), "[%s; ate %d]", elem, fixo_length(type));
+    sdsfree(elem);
+    return shown;
+}
+
+static void codegen_pequeno_typedefs(FILE *file)
+{
+    for (int i = 0; i < arrlen(pequeno_types); i++)
+    {
+        sds name = pequeno_c_name(pequeno_types[i]);
+        fprintf(file, "typedef struct %s %s;\n", name, name);
+        sdsfree(name);
+    }
+}
+
+// Struct and element helpers of every small array type (after the value structs they may hold)
+static void codegen_pequeno_structs(FILE *file)
+{
+    for (int i = 0; i < arrlen(pequeno_types); i++)
+    {
+        const char *type = pequeno_types[i];
+        sds name = pequeno_c_name(type);
+        sds elem = sequence_element(type);
+        sds c_elem = field_c_type(elem);
+        int n = fixo_length(type);
+        const char *t = c_elem;
+
+        fprintf(file, "struct %s {\n    BsPequeno h;\n    %s local[%d];\n};\n", name, t, n);
+        fprintf(file, "static inline %s *%s_dados(%s *p) { return p->h.heap ? (%s *)p->h.heap : p->local; }\n", t, name, name, t);
+        fprintf(file, "static inline void %s_push(%s *p, %s v)\n{\n", name, name, t);
+        fprintf(file, "    if (p->h.len == bs_pequeno_cap(&p->h, %d))\n", n);
+        fprintf(file, "        bs_pequeno_reservar(&p->h, p->local, %d, p->h.len + 1, sizeof(%s));\n", n, t);
+        fprintf(file, "    %s_dados(p)[p->h.len++] = v;\n}\n", name);
+        fprintf(file, "static inline %s %s_pop(%s *p) { return %s_dados(p)[--p->h.len]; }\n", t, name, name, name);
+        fprintf(file, "static inline void %s_inserir(%s *p, long long i, %s v)\n{\n", name, name, t);
+        fprintf(file, "    %s_push(p, v);\n    %s *d = %s_dados(p);\n", name, t, name);
+        fprintf(file, "    memmove(d + i + 1, d + i, (size_t)(p->h.len - 1 - i) * sizeof(%s));\n    d[i] = v;\n}\n", t);
+        fprintf(file, "static inline void %s_remover_rapido(%s *p, long long i)\n{\n", name, name);
+        fprintf(file, "    %s *d = %s_dados(p);\n    d[i] = d[--p->h.len];\n}\n", t, name);
+        fprintf(file, "static inline void %s_redimensionar(%s *p, long long n)\n{\n", name, name);
+        fprintf(file, "    if (n < 0)\n        n = 0;\n");
+        fprintf(file, "    bs_pequeno_reservar(&p->h, p->local, %d, n, sizeof(%s));\n", n, t);
+        fprintf(file, "    if (n > p->h.len)\n        memset(%s_dados(p) + p->h.len, 0, (size_t)(n - p->h.len) * sizeof(%s));\n", name, t);
+        fprintf(file, "    p->h.len = n;\n}\n");
+        // The source may be this array's own elements
+        fprintf(file, "static inline void %s_de(%s *p, %s *src, long long n)\n{\n", name, name, t);
+        fprintf(file, "    bs_pequeno_reservar(&p->h, p->local, %d, n, sizeof(%s));\n", n, t);
+        fprintf(file, "    if (n > 0)\n        memmove(%s_dados(p), src, (size_t)n * sizeof(%s));\n", name, t);
+        fprintf(file, "    p->h.len = n;\n}\n\n");
+        sdsfree(name);
+        sdsfree(elem);
+        sdsfree(c_elem);
+    }
+}
+
+// Address of a small array: parameters already hold one
+static sds pequeno_ref(ASTNode *node)
+{
+    if (node->type == NODE_VAR_REF && node->name)
+    {
+        const char *bound = scope_lookup(node->name);
+        if (bound && bound[strlen(bound) - 1] == '*')
+            return sdsnew(node->name);
+    }
+    sds expr = codegen_to_sds(node);
+    sds ref = sdscatprintf(sdsempty(), "&(%s)", expr);
+    sdsfree(expr);
+    return ref;
+}
+
+// Argument 'index' (0-based) of a call to 'func_name' for a parameter of 'param_type'
+// (NULL if unknown): small arrays, maps, sets, counters and queues go by address,
+// fixed arrays must have the same length, everything else goes through the usual conversions
+static void codegen_call_arg(const char *func_name, const char *param_type, ASTNode *arg, int index, FILE *file)
+{
+    bool container = is_hash_type(param_type) || is_fila_type(param_type) || is_fila_prioridade_type(param_type);
+    bool exact = container || is_pequeno_type(param_type) || is_fixo_type(param_type);
+    if (!exact)
+    {
+        codegen_converted(param_type, arg, file);
+        return;
+    }
+    if (is_fixo_type(param_type) && arg->type == NODE_ARRAY_LITERAL && arrlen(arg->children) == fixo_length(param_type))
+    {
+        // f([1, 2, 3]) for a [T; 3]: a temporary C array
+        sds elem = sequence_element(param_type);
+        sds c_elem = field_c_type(elem);
+        fprintf(file, "(%s[]){ ", c_elem);
+        for (int i = 0; i < arrlen(arg->children); i++)
+        {
+            if (i > 0)
+                fprintf(file, ", ");
+            codegen_converted(elem, arg->children[i], file);
+        }
+        fprintf(file, " }");
+        sdsfree(elem);
+        sdsfree(c_elem);
+        return;
+    }
+    const char *arg_type = infer_type(arg);
+    if (!arg_type || strcmp(arg_type, param_type) != 0)
+    {
+        sds shown = is_fixo_type(param_type) ? fixo_display(param_type)
+                    : is_pequeno_type(param_type) ? pequeno_display(param_type) : sdsnew(param_type);
+        sds given = is_fixo_type(arg_type) ? fixo_display(arg_type)
+                    : is_pequeno_type(arg_type) ? pequeno_display(arg_type) : sdsnew(arg_type ? arg_type : "?");
+        fprintf(stderr, "[Basalto] Erro: '%s' espera um '%s' como argumento %d, recebeu '%s'.\n", func_name, shown, index + 1, given);
+        exit(1);
+    }
+    if (is_fixo_type(param_type))
+    {
+        codegen_converted(param_type, arg, file);
+        return;
+    }
+    if (container && arg->type != NODE_VAR_REF && arg->type != NODE_PROP_ACCESS && arg->type != NODE_ARRAY_ACCESS)
+    {
+        // A temporary (f() returning a map): give it an address for the call
+        sds expr = codegen_to_sds(arg);
+        fprintf(file, "&(%s){%s}", map_type(param_type), expr);
+        sdsfree(expr);
+        return;
+    }
+    sds ref = pequeno_ref(arg);
+    fprintf(file, "%s", ref);
+    sdsfree(ref);
+}
+
+// Arity of an array method on a small array, -1 if there is none
+static int pequeno_method_arity(const char *method)
+{
+    if (strcmp(method, "len") == 0 || strcmp(method, "pop") == 0)
+        return 0;
+    if (strcmp(method, "push") == 0)
+        return 1;
+    return capacity_method_arity(method);
+}
+
+// xs.len / xs.push(x) / xs.pop() and the ARRAY CAPACITY methods
+static void codegen_pequeno_method(ASTNode *node, const char *method, FILE *file)
+{
+    ASTNode *arr = node->children[0];
+    const char *type = infer_type(arr);
+    int arity = pequeno_method_arity(method);
+    int argc = arrlen(node->children) - 1;
+    if (argc != arity)
+    {
+        fprintf(stderr, "[Basalto] Erro: '.%s' espera %d argumento(s), recebeu %d.\n", method, arity, argc);
+        exit(1);
+    }
+    sds name = pequeno_c_name(type);
+    sds elem = sequence_element(type);
+    sds c_elem = field_c_type(elem);
+    sds p = pequeno_ref(arr);
+    int n = fixo_length(type);
+
+    if (strcmp(method, "len") == 0)
+        fprintf(file, "(%s)->h.len", p);
+    else if (strcmp(method, "capacidade") == 0)
+        fprintf(file, "bs_pequeno_cap(&(%s)->h, %d)", p, n);
+    else if (strcmp(method, "limpar") == 0)
+        fprintf(file, "((%s)->h.len = 0)", p);
+    else if (strcmp(method, "pop") == 0)
+        fprintf(file, "%s_pop(%s)", name, p);
+    else if (strcmp(method, "encolher") == 0)
+        fprintf(file, "bs_pequeno_encolher(&(%s)->h, (%s)->local, %d, sizeof(%s))", p, p, n, c_elem);
+    else if (strcmp(method, "reservar") == 0)
+    {
+        fprintf(file, "bs_pequeno_reservar(&(%s)->h, (%s)->local, %d, ", p, p, n);
+        codegen(node->children[1], file);
+        fprintf(file, ", sizeof(%s))", c_elem);
+    }
+    else
+    {
+        // push, inserir, remover_rapido, redimensionar: NAME_metodo(p, args)
+        fprintf(file, "%s_%s(%s", name, method, p);
+        for (int i = 1; i <= argc; i++)
+        {
+            fprintf(file, ", ");
+            bool value = strcmp(method, "push") == 0 || (strcmp(method, "inserir") == 0 && i == 2);
+            if (value)
+                codegen_converted(elem, node->children[i], file);
+            else
+                codegen(node->children[i], file);
+        }
+        fprintf(file, ")");
+    }
+    sdsfree(name);
+    sdsfree(elem);
+    sdsfree(c_elem);
+    sdsfree(p);
+}
+
+// target = value: a list literal or any sequence of the same element type (copied)
+static void codegen_pequeno_assign(ASTNode *target, const char *type, ASTNode *value, FILE *file)
+{
+    sds name = pequeno_c_name(type);
+    sds elem = sequence_element(type);
+    sds c_elem = field_c_type(elem);
+    sds p = pequeno_ref(target);
+    if (value->type == NODE_ARRAY_LITERAL && arrlen(value->children) == 0)
+    {
+        fprintf(file, "((%s)->h.len = 0)", p);
+    }
+    else if (value->type == NODE_ARRAY_LITERAL)
+    {
+        fprintf(file, "%s_de(%s, (%s[]){", name, p, c_elem);
+        for (int i = 0; i < arrlen(value->children); i++)
+        {
+            if (i > 0)
+                fprintf(file, ", ");
+            codegen_converted(elem, value->children[i], file);
+        }
+        fprintf(file, "}, %d)", (int)arrlen(value->children));
+    }
+    else
+    {
+        const char *source = infer_type(value);
+        sds source_elem = sequence_element(source);
+        if (!source_elem || strcmp(source_elem, elem) != 0 || soa_element(source))
+        {
+            sds shown = pequeno_display(type);
+            fprintf(stderr, "[Basalto] Erro: '%s' so recebe uma lista [...] ou um array de '%s'.\n", shown, elem);
+            exit(1);
+        }
+        codegen_sequence_bind(value, source, file);
+        fprintf(file, "%s_de(%s, _sd, _sn); })", name, p);
+        sdsfree(source_elem);
+    }
+    sdsfree(name);
+    sdsfree(elem);
+    sdsfree(c_elem);
+    sdsfree(p);
+}
+
+// var xs: [T; ate N] (= [..] | = sequence): literals that fit are a plain initializer
+static void codegen_pequeno_decl(ASTNode *decl, FILE *file)
+{
+    const char *type = decl->data_type;
+    ASTNode *init = arrlen(decl->children) > 0 ? decl->children[0] : NULL;
+    sds name = pequeno_c_name(type);
+    sds elem = sequence_element(type);
+    int count = init && init->type == NODE_ARRAY_LITERAL ? (int)arrlen(init->children) : -1;
+    if (count > 0 && count <= fixo_length(type))
+    {
+        fprintf(file, "    %s %s = { { NULL, %d, 0 }, { ", name, decl->name, count);
+        for (int i = 0; i < count; i++)
+        {
+            if (i > 0)
+                fprintf(file, ", ");
+            codegen_converted(elem, init->children[i], file);
+        }
+        fprintf(file, " } };\n");
+    }
+    else
+    {
+        fprintf(file, "    %s %s = {0};\n", name, decl->name);
+        if (init && count != 0)
+        {
+            ASTNode *target = ast_new(NODE_VAR_REF);
+            target->name = sdsnew(decl->name);
+            fprintf(file, "    ");
+            codegen_pequeno_assign(target, type, init, file);
+            fprintf(file, ";\n");
+        }
+    }
+    sdsfree(name);
+    sdsfree(elem);
+}
+
+// --- ESCAPE ANALYSIS ---
+// A 'nova' struct bound to a local that is never stored into a field or array,
+// never returned and never handed to code that could keep it can live on the
+// stack instead of the heap. The analysis is per function body and name based:
+// any escaping use of a name disqualifies every declaration with that name.
+
+// Per-function parameter summary: flags[i] != 0 if parameter i may escape
+typedef struct
+{
+    char *key;  // Function name
+    int *value; // stb_ds array of flags, one per parameter
+} ParamEscapeEntry;
+
+static ParamEscapeEntry *param_escapes = NULL;
+static char **current_escapes = NULL; // Escaping names of the body being generated
+
+// Declared types seen by the analysis (it runs before the body binds its scope)
+typedef struct
+{
+    char *key;   // Variable name
+    char *value; // Declared type
+} EscapeTypeEntry;
+
+static EscapeTypeEntry *escape_types = NULL;
+
+static int func_param_count(ASTNode *func)
+{
+    int count = arrlen(func->children);
+    if (count > 0 && func->children[count - 1]->type == NODE_BLOCK)
+        count--;
+    return count;
+}
+
+static int name_in_list(char **names, const char *name)
+{
+    for (int i = 0; i < arrlen(names); i++)
+        if (strcmp(names[i], name) == 0)
+            return 1;
+    return 0;
+}
+
+static void mark_escape(ASTNode *value, char ***names)
+{
+    if (value && value->type == NODE_VAR_REF && value->name && !name_in_list(*names, value->name))
+        arrput(*names, value->name);
+}
+
+// Start a body's analysis: only its parameters (if any) are known
+static void escape_types_reset(ASTNode *func)
+{
+    shfree(escape_types);
+    for (int p = 0; func && p < func_param_count(func); p++)
+        shput(escape_types, func->children[p]->name, func->children[p]->data_type);
+}
+
+// x.m(...) is a user function call (UFCS) only when x is a user struct;
+// on arrays and other built-ins, m is a container method
+static int is_struct_receiver(ASTNode *obj)
+{
+    const char *type = NULL;
+    if (obj && obj->type == NODE_VAR_REF && obj->name)
+    {
+        type = shget(escape_types, obj->name);
+        if (!type)
+            type = scope_lookup(obj->name);
+    }
+    return type && shgeti(type_registry, type) >= 0;
+}
+
+// Argument 'index' of a call to 'func_name' escapes unless the callee is known not to keep it
+static void mark_call_arg(const char *func_name, int index, ASTNode *arg, char ***names)
+{
+    int *flags = func_name ? shget(param_escapes, func_name) : NULL;
+    if (!flags || index >= arrlen(flags) || flags[index])
+        mark_escape(arg, names);
+}
+
+static void collect_escapes(ASTNode *node, char ***names)
+{
+    if (!node)
+        return;
+
+    switch (node->type)
+    {
+    case NODE_VAR_DECL:
+        if (node->name && node->data_type)
+            shput(escape_types, node->name, node->data_type);
+        for (int i = 0; i < arrlen(node->children); i++)
+            mark_escape(node->children[i], names);
+        break;
+    case NODE_RETURN:
+    case NODE_ARRAY_LITERAL:
+        for (int i = 0; i < arrlen(node->children); i++)
+            mark_escape(node->children[i], names);
+        break;
+    case NODE_ASSIGN:
+        // Value is the last child (a prop/array lvalue comes first)
+        if (arrlen(node->children) > 0)
+            mark_escape(node->children[arrlen(node->children) - 1], names);
+        break;
+    case NODE_FUNC_CALL:
+        if (strcmp(node->name, "escreval") != 0 && strcmp(node->name, "escreva") != 0)
+        {
+            for (int i = 0; i < arrlen(node->children); i++)
+                mark_call_arg(node->name, i, node->children[i], names);
+        }
+        break;
+    case NODE_METHOD_CALL:
+    {
+        const char *method = node->data_type ? node->data_type : "";
+        ASTNode *obj = arrlen(node->children) > 0 ? node->children[0] : NULL;
+        char *obj_type = (obj && obj->type == NODE_VAR_REF) ? scope_lookup(obj->name) : NULL;
+        int is_module = obj_type && strcmp(obj_type, "MODULE") == 0;
+
+        if (!is_module && shget(param_escapes, method) && is_struct_receiver(obj))
+        {
+            // Uniform call syntax: p.mover(10) -> mover(p, 10)
+            for (int i = 0; i < arrlen(node->children); i++)
+                mark_call_arg(method, i, node->children[i], names);
+        }
+        else
+        {
+            // Array methods (push), FFI calls: arguments are kept by someone else
+            for (int i = 1; i < arrlen(node->children); i++)
+                mark_escape(node->children[i], names);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+
+    for (int i = 0; i < arrlen(node->children); i++)
+        collect_escapes(node->children[i], names);
+    collect_escapes(node->start, names);
+    collect_escapes(node->end, names);
+    collect_escapes(node->step, names);
+}
+
+// Fixpoint over all functions: a parameter escapes if its body lets it escape
+static void analyze_param_escapes(ASTNode *content_block)
+{
+    for (int i = 0; i < arrlen(content_block->children); i++)
+    {
+        ASTNode *func = content_block->children[i];
+        if (func->type != NODE_FUNC_DEF || func_param_count(func) == arrlen(func->children))
+            continue; // Not a function with a body
+        int *flags = NULL;
+        for (int p = 0; p < func_param_count(func); p++)
+            arrput(flags, 0);
+        shput(param_escapes, func->name, flags);
+    }
+
+    int changed = 1;
+    while (changed)
+    {
+        changed = 0;
+        for (int i = 0; i < arrlen(content_block->children); i++)
+        {
+            ASTNode *func = content_block->children[i];
+            int *flags = func->type == NODE_FUNC_DEF ? shget(param_escapes, func->name) : NULL;
+            if (!flags)
+                continue;
+
+            char **names = NULL;
+            escape_types_reset(func);
+            collect_escapes(func->children[arrlen(func->children) - 1], &names);
+            for (int p = 0; p < arrlen(flags); p++)
+            {
+                if (!flags[p] && name_in_list(names, func->children[p]->name))
+                {
+                    flags[p] = 1;
+                    changed = 1;
+                }
+            }
+            arrfree(names);
+        }
+    }
+}
+
+// A 'var x: T = nova T' whose name never escapes the current body
+static int is_stack_candidate(ASTNode *decl)
+{
+    if (arrlen(decl->children) == 0 || decl->children[0]->type != NODE_NEW)
+        return 0;
+    if (!decl->children[0]->data_type || strcmp(decl->children[0]->data_type, decl->data_type) != 0)
+        return 0;
+    return !name_in_list(current_escapes, decl->name);
+}
+
+// Helper: emit offsetof() entries for every traced field of 'struct_name'.
+// Value struct fields are stored inline, so their own pointer fields are
+// reached through a nested member path (offsetof(Outer, pos.nome)).
+static void codegen_gc_offsets(const char *outer, const char *path, const char *struct_name, int *count, FILE *file)
+{
+    FieldEntry *fields = shget(type_registry, struct_name);
+    for (int i = 0; i < shlen(fields); i++)
+    {
+        const char *field_type = fields[i].value;
+        sds member = path ? sdscatprintf(sdsempty(), "%s.%s", path, fields[i].key) : sdsnew(fields[i].key);
+        sds soa = field_type ? soa_element(field_type) : NULL;
+        if (field_type && is_value_struct(field_type))
+        {
+            codegen_gc_offsets(outer, member, field_type, count, file);
+        }
+        else if (field_type && (is_fixo_type(field_type) || is_pequeno_type(field_type)))
+        {
+            // [T; N] field: each traced element in place ([T; ate N] also traces its heap buffer)
+            if (is_pequeno_type(field_type))
+            {
+                fprintf(file, "%soffsetof(%s, %s.h.heap)", *count > 0 ? ", " : " ", outer, member);
+                (*count)++;
+            }
+            sds elem = sequence_element(field_type);
+            bool traced = elem[0] == '[' || is_fatia_type(elem) || is_matriz_type(elem) || is_bits_type(elem) || is_hash_type(elem) || is_fila_type(elem) || is_fila_prioridade_type(elem) ||
+                          is_compacto_type(elem) || is_fatia_texto_type(elem) || is_construtor_type(elem) ||
+                          (is_struct_type(elem) && !is_value_struct(elem)) || strcmp(map_type(elem), "char*") == 0;
+            for (int k = 0; k < fixo_length(field_type); k++)
+            {
+                sds slot = sdscatprintf(sdsempty(), is_pequeno_type(field_type) ? "%s.local[%d]" : "%s[%d]", member, k);
+                if (is_value_struct(elem))
+                {
+                    codegen_gc_offsets(outer, slot, elem, count, file);
+                }
+                else if (traced)
+                {
+                    fprintf(file, "%soffsetof(%s, %s)", *count > 0 ? ", " : " ", outer, slot);
+                    (*count)++;
+                }
+                sdsfree(slot);
+            }
+            sdsfree(elem);
+        }
+        else if (soa)
+        {
+            // @soa array field: every column is its own buffer
+            FieldEntry *columns = shget(type_registry, soa);
+            for (int c = 0; c < shlen(columns); c++)
+            {
+                fprintf(file, "%soffsetof(%s, %s.%s)", *count > 0 ? ", " : " ", outer, member, columns[c].key);
+                (*count)++;
+            }
+        }
+        else if (field_type && (field_type[0] == '[' || is_fatia_type(field_type) || is_matriz_type(field_type) || is_bits_type(field_type) || is_hash_type(field_type) ||
+                                is_fila_type(field_type) || is_fila_prioridade_type(field_type) || is_compacto_type(field_type) ||
+                                is_fatia_texto_type(field_type) || is_construtor_type(field_type) || is_struct_type(field_type) ||
+                                strcmp(map_type(field_type), "char*") == 0 || strcmp(map_type(field_type), "void*") == 0))
+        {
+            fprintf(file, "%soffsetof(%s, %s)", *count > 0 ? ", " : " ", outer, member);
+            (*count)++;
+        }
+        sdsfree(member);
+        sdsfree(soa);
+    }
+}
+
+// --- STRUCT LAYOUT ---
+// Fields are emitted by decreasing alignment (stable, so equal alignments keep
+// declaration order), which removes most of the padding between mixed-size
+// fields. @ordem_fixa keeps declaration order for structs shared with C code,
+// @compacto drops padding entirely and @alinhado(n) raises the struct alignment.
+// Sizes are those of the host C compiler, which also compiles the output.
+
+static void struct_layout(ASTNode *def, int *order, size_t *size, size_t *align, size_t *padding);
+
+// @alinhado(n) of a struct, 0 if none
+static int struct_alignment(const char *struct_name)
+{
+    ASTNode *def = struct_name ? shget(struct_defs, struct_name) : NULL;
+    return def ? def->int_value : 0;
+}
+
+// Size and alignment of a field of Basalto type 'field_type' as stored in a struct
+static void field_layout(const char *field_type, size_t *size, size_t *align)
+{
+    typedef struct
     {
-        is_struct = 1;
-    }
-    if (is_struct)
+        const char *c_type;
+        size_t size;
+        size_t align;
+    } CTypeLayout;
+    static const CTypeLayout layouts[] = {
+        {"int", sizeof(int), _Alignof(int)},
+        {"long long", sizeof(long long), _Alignof(long long)},
+        {"short", sizeof(short), _Alignof(short)},
+        {"signed char", sizeof(signed char), _Alignof(signed char)},
+        {"long", sizeof(long), _Alignof(long)},
+        {"unsigned char", sizeof(unsigned char), _Alignof(unsigned char)},
+        {"unsigned int", sizeof(unsigned int), _Alignof(unsigned int)},
+        {"unsigned long long", sizeof(unsigned long long), _Alignof(unsigned long long)},
+        {"unsigned short", sizeof(unsigned short), _Alignof(unsigned short)},
+        {"unsigned long", sizeof(unsigned long), _Alignof(unsigned long)},
+        {"size_t", sizeof(size_t), _Alignof(size_t)},
+        {"float", sizeof(float), _Alignof(float)},
+        {"double", sizeof(double), _Alignof(double)},
+        {"long double", sizeof(long double), _Alignof(long double)},
+        {"char", sizeof(char), _Alignof(char)},
+        {"BsFatia", sizeof(void *) + 2 * sizeof(long long), _Alignof(long long)},  // dados, len, passo
+        {"BsMatriz", sizeof(void *) + 2 * sizeof(long long), _Alignof(long long)}, // dados, linhas, colunas
+        {"BsBits", sizeof(void *) + sizeof(long long), _Alignof(long long)},       // palavras, len
+        {"BsFatiaTexto", sizeof(void *) + sizeof(long long), _Alignof(long long)}, // dados, len
+        {"_Bool", sizeof(_Bool), _Alignof(_Bool)},
+        {NULL, 0, 0}};
+
+    *size = sizeof(void *);
+    *align = _Alignof(void *);
+
+    sds soa = soa_element(field_type);
+    if (soa)
     {
-        fprintf(file, "%s* %s(", return_type, node->name);
+        // One column pointer per field
+        *size = sizeof(void *) * shlen(shget(type_registry, soa));
+        sdsfree(soa);
+        return;
     }
-    else
+    if (is_fixo_type(field_type))
     {
-        fprintf(file, "%s %s(", return_type, node->name);
+        // N inline elements
+        sds elem = sequence_element(field_type);
+        field_layout(elem, size, align);
+        *size *= fixo_length(field_type);
+        sdsfree(elem);
+        return;
     }
-
-    // For extern functions, there's no body, so all children are params
-    // For regular functions, the last child is the body block
-    int total_children = arrlen(node->children);
-    int param_count = total_children;
-
-    // Check if last child is a body block (NODE_BLOCK)
-    if (total_children > 0 && node->children[total_children - 1]->type == NODE_BLOCK)
+    if (is_pequeno_type(field_type))
     {
-        param_count = total_children - 1;
+        // BsPequeno header (heap, len, cap) followed by N inline elements
+        sds elem = sequence_element(field_type);
+        size_t elem_size, elem_align;
+        field_layout(elem, &elem_size, &elem_align);
+        size_t header = sizeof(void *) + 2 * sizeof(long long);
+        *align = elem_align > _Alignof(long long) ? elem_align : _Alignof(long long);
+        size_t end = (header + elem_align - 1) / elem_align * elem_align + elem_size * fixo_length(field_type);
+        *size = (end + *align - 1) / *align * *align;
+        sdsfree(elem);
+        return;
     }
-
-    for (int i = 0; i < param_count; i++)
+    if (field_type[0] == '[' || (is_struct_type(field_type) && !is_value_struct(field_type)))
+        return; // stb_ds array or reference: a pointer
+    if (is_value_struct(field_type))
     {
-        ASTNode *param = node->children[i];
-        if (i > 0)
-            fprintf(file, ", ");
-
-        const char *type = param->data_type;
-        const char *name = param->name;
-
-        // SMART POINTER LOGIC:
-        // 1. If param name is "eu" or "self" -> Pointer
-        // 2. If param type is a Struct -> Pointer (Pass by Reference)
-        if ((name && (strcmp(name, "eu") == 0 || strcmp(name, "self") == 0)) || is_struct_type(type))
+        ASTNode *def = shget(struct_defs, field_type);
+        if (def)
         {
-            fprintf(file, "%s* %s", map_type(type), name);
+            size_t padding;
+            struct_layout(def, NULL, size, align, &padding);
         }
-        else
+        return;
+    }
+    const char *c_type = map_type(field_type);
+    for (int i = 0; layouts[i].c_type; i++)
+    {
+        if (strcmp(c_type, layouts[i].c_type) == 0)
         {
-            fprintf(file, "%s %s", map_type(type), name);
+            *size = layouts[i].size;
+            *align = layouts[i].align;
+            return;
         }
     }
-    fprintf(file, ")");
+    // texto, ponteiro and unknown types: pointer sized
 }
 
-// Helper to check if a string starts with a prefix
-static int starts_with(const char *str, const char *prefix)
+// Emission order of the fields of 'def' (stb_ds array of child indices)
+static int *struct_field_order(ASTNode *def)
 {
-    size_t prefix_len = strlen(prefix);
-    if (strlen(str) < prefix_len)
-        return 0;
-    return strncmp(str, prefix, prefix_len) == 0;
+    int *order = NULL;
+    for (int i = 0; i < arrlen(def->children); i++)
+        arrput(order, i);
+    if (has_struct_flag(def->name, STRUCT_FLAG_FIXED_ORDER))
+        return order;
+
+    // Stable insertion sort by decreasing alignment
+    for (int i = 1; i < arrlen(order); i++)
+    {
+        int current = order[i];
+        size_t size, align;
+        field_layout(def->children[current]->data_type, &size, &align);
+        int j = i - 1;
+        while (j >= 0)
+        {
+            size_t other_size, other_align;
+            field_layout(def->children[order[j]]->data_type, &other_size, &other_align);
+            if (other_align >= align)
+                break;
+            order[j + 1] = order[j];
+            j--;
+        }
+        order[j + 1] = current;
+    }
+    return order;
 }
 
-// Helper to escape a string for C string literal
-static void escape_string_for_c(const char *str, FILE *file)
+// C layout of 'def' when its fields are emitted in 'order' (NULL = the compiler's order)
+static void struct_layout(ASTNode *def, int *order, size_t *size, size_t *align, size_t *padding)
 {
-    if (!str)
-    {
-        fprintf(file, "\"Assertion failed\"");
-        return;
-    }
-    fprintf(file, "\"");
-    for (const char *p = str; *p != '\0'; p++)
+    int *own_order = order ? NULL : struct_field_order(def);
+    int *fields = order ? order : own_order;
+    bool packed = has_struct_flag(def->name, STRUCT_FLAG_PACKED);
+    size_t offset = 0;
+    *align = 1;
+    *padding = 0;
+    for (int i = 0; i < arrlen(fields); i++)
     {
-        switch (*p)
+        size_t field_size, field_align;
+        field_layout(def->children[fields[i]]->data_type, &field_size, &field_align);
+        if (!packed)
         {
-        case '"':
-            fprintf(file, "\\\"");
-            break;
-        case '\\':
-            fprintf(file, "\\\\");
-            break;
-        case '\n':
-            fprintf(file, "\\n");
-            break;
-        case '\t':
-            fprintf(file, "\\t");
-            break;
-        case '\r':
-            fprintf(file, "\\r");
-            break;
-        default:
-            fputc(*p, file);
-            break;
+            size_t aligned = (offset + field_align - 1) / field_align * field_align;
+            *padding += aligned - offset;
+            offset = aligned;
+            if (field_align > *align)
+                *align = field_align;
         }
+        offset += field_size;
     }
-    fprintf(file, "\"");
+    if ((size_t)def->int_value > *align)
+        *align = (size_t)def->int_value; // @alinhado(n)
+    *size = (offset + *align - 1) / *align * *align;
+    *padding += *size - offset;
+    arrfree(own_order);
 }
 
-// THE INTERPOLATION ENGINE
-static void codegen_string_literal(const char *raw_str, FILE *file)
+// --relatorio-layout: size, padding and cache-line footprint of a struct
+static void report_struct_layout(ASTNode *def)
 {
-    // 1. Start Statement Expression
-    // We create a temporary variable '_s' to build the string
-    fprintf(file, "({ sds _s = sdsempty(); ");
-
-    const char *cursor = raw_str;
-    while (*cursor != '\0')
+    int *order = struct_field_order(def);
+    size_t size, align, padding;
+    struct_layout(def, order, &size, &align, &padding);
+
+    const char *mode = has_struct_flag(def->name, STRUCT_FLAG_FIXED_ORDER) ? "ordem fixa" : "reordenada";
+    if (has_struct_flag(def->name, STRUCT_FLAG_PACKED))
+        mode = "compacta";
+    size_t lines = (size + 63) / 64;
+    printf("[Basalto] Layout de '%s' (%s): %zu bytes, alinhamento %zu, preenchimento %zu bytes, %zu linha(s) de cache de 64 B\n",
+           def->name, mode, size, align, padding, lines ? lines : 1);
+
+    size_t offset = 0;
+    bool packed = has_struct_flag(def->name, STRUCT_FLAG_PACKED);
+    for (int i = 0; i < arrlen(order); i++)
     {
+        ASTNode *field = def->children[order[i]];
+        size_t field_size, field_align;
+        field_layout(field->data_type, &field_size, &field_align);
+        if (!packed)
+            offset = (offset + field_align - 1) / field_align * field_align;
+        sds shown = is_fixo_type(field->data_type) ? fixo_display(field->data_type) : sdsnew(field->data_type);
+        printf("    +%-4zu %-16s %-16s %zu bytes\n", offset, field->name, shown, field_size);
+        sdsfree(shown);
+        offset += field_size;
+    }
 
-        // CASE A: Interpolation "${expr}"
-        if (starts_with(cursor, "${"))
-        {
-            cursor += 2; // Skip "${"
-
-            // Capture the expression content
-            char expr_buffer[128] = {0};
-            char fmt_buffer[64] = {0}; // For options like :.2f
-            int e_idx = 0;
-            int f_idx = 0;
-            int parsing_fmt = 0;
-
-            // Parse until '}'
-            while (*cursor != '\0' && *cursor != '}')
-            {
-                if (*cursor == ':')
-                {
-                    parsing_fmt = 1;
-                    cursor++;
-                    continue;
-                }
-
-                if (!parsing_fmt)
-                {
-                    if (e_idx < 127)
-                        expr_buffer[e_idx++] = *cursor;
-                }
-                else
-                {
-                    if (f_idx < 63)
-                        fmt_buffer[f_idx++] = *cursor;
-                }
-                cursor++;
-            }
-            if (*cursor == '}')
-                cursor++;
-
-            // Replace 'nulo' with 'NULL' in expr_buffer first
-            char *nulo_pos = strstr(expr_buffer, "nulo");
-            while (nulo_pos)
-            {
-                // Replace "nulo" (4 chars) with "NULL" (4 chars) - same length, easy!
-                memcpy(nulo_pos, "NULL", 4);
-                nulo_pos = strstr(nulo_pos + 4, "nulo");
-            }
-
-            // Handle Property Access (self.x or var.field) inside expression
-            // We need to convert to '->' if the object is a pointer
-            // Also handle array methods like .len -> arrlen()
-            char final_expr[256] = {0};
-            
-            // Check for .len pattern (array method) - handle both .len and ->len
-            char *len_pos = strstr(expr_buffer, ".len");
-            if (!len_pos)
-                len_pos = strstr(expr_buffer, "->len");
-            
-            if (len_pos)
-            {
-                // Replace .len or ->len with arrlen()
-                char saved_char = *len_pos;
-                *len_pos = '\0'; // Terminate at .len or ->len
-                snprintf(final_expr, 255, "arrlen(%s)", expr_buffer);
-                *len_pos = saved_char; // Restore for safety (though we won't use it)
-            }
-            else
-            {
-                // Find last . or -> before any [
-                char *last_dot = strrchr(expr_buffer, '.');
-                char *last_arrow = strrchr(expr_buffer, '>');
-                char *last_bracket = strrchr(expr_buffer, ']');
-                
-                // Check if we have array access followed by property access
-                // e.g., p->filhos[i].nome
-                if (last_bracket && (last_dot || last_arrow))
-                {
-                    // Determine which operator was used
-                    char *prop_op = NULL;
-                    if (last_arrow && (!last_dot || last_arrow > last_dot))
-                    {
-                        prop_op = last_arrow - 1; // Points to '-'
-                        if (*prop_op == '-' && last_arrow > expr_buffer && last_arrow[-1] == '-')
-                        {
-                            // Found -> operator
-                            *prop_op = '\0'; // Terminate before ->
-                            char *obj = expr_buffer;
-                            char *prop = last_arrow + 1;
-                            snprintf(final_expr, 255, "%s->%s", obj, prop);
-                        }
-                    }
-                    else if (last_dot)
-                    {
-                        // Array access with . operator: use -> for struct arrays
-                        *last_dot = '\0';
-                        char *obj = expr_buffer;
-                        char *prop = last_dot + 1;
-                        snprintf(final_expr, 255, "%s->%s", obj, prop);
-                    }
-                    else
-                    {
-                        strcpy(final_expr, expr_buffer);
-                    }
-                }
-                else
-                {
-                    char *dot = strchr(expr_buffer, '.');
-                    if (dot)
-                    {
-                        *dot = '\0';
-                        char *obj = expr_buffer;
-                        char *prop = dot + 1;
-                        
-                        if (strcmp(obj, "self") == 0 || strcmp(obj, "eu") == 0)
-                        {
-                            snprintf(final_expr, 255, "%s->%s", obj, prop);
-                        }
-                        else
-                        {
-                            // Check if obj is a pointer type in symbol table
-                            char *var_type = scope_lookup(obj);
-                            int is_ptr = 0;
-                            if (var_type)
-                            {
-                                size_t len = strlen(var_type);
-                                if (len > 0 && var_type[len - 1] == '*')
-                                {
-                                    is_ptr = 1;
-                                }
-                            }
-                            if (is_ptr)
-                            {
-                                snprintf(final_expr, 255, "%s->%s", obj, prop);
-                            }
-                            else
-                            {
-                                snprintf(final_expr, 255, "%s.%s", obj, prop);
-                            }
-                        }
-                    }
-                    else
-                    {
-                        strcpy(final_expr, expr_buffer);
-                    }
-                }
-            }
+    // What the declaration order would have cost
+    if (!has_struct_flag(def->name, STRUCT_FLAG_FIXED_ORDER) && !packed)
+    {
+        int *declared = NULL;
+        for (int i = 0; i < arrlen(def->children); i++)
+            arrput(declared, i);
+        size_t declared_size, declared_align, declared_padding;
+        struct_layout(def, declared, &declared_size, &declared_align, &declared_padding);
+        if (declared_size != size)
+            printf("    (na ordem declarada: %zu bytes, preenchimento %zu bytes)\n", declared_size, declared_padding);
+        arrfree(declared);
+    }
+    if (size > 0 && size % 64 != 0 && 64 % size != 0)
+        printf("    aviso: elementos consecutivos em [%s] cruzam linhas de cache\n", def->name);
+    arrfree(order);
+}
 
-            // Generate Append Code
-            if (parsing_fmt)
-            {
-                // User provided format (e.g. .2f)
-                char final_fmt[64];
-                // If user wrote ".2f", we make it "%.2f"
-                if (fmt_buffer[0] == '%')
-                    snprintf(final_fmt, 64, "%s", fmt_buffer);
-                else
-                    snprintf(final_fmt, 64, "%%%s", fmt_buffer);
+// Method call on a @soa element: arr[i].mover(dt). Receivers taken by pointer
+// work on a gathered copy that is scattered back after the call.
+static void codegen_soa_method_call(ASTNode *node, const char *elem, ASTNode *array, ASTNode *index, FILE *file)
+{
+    const char *method = node->data_type;
+    ASTNode *callee = shget(func_defs, method);
+    bool has_result = callee && callee->data_type && strcmp(callee->data_type, "vazio") != 0;
+    bool receiver_by_value = false;
+    if (callee && func_param_count(callee) > 0)
+    {
+        ASTNode *receiver = callee->children[0];
+        receiver_by_value = receiver->name && strcmp(receiver->name, "eu") != 0 &&
+                            strcmp(receiver->name, "self") != 0 && is_value_struct(receiver->data_type);
+    }
 
-                fprintf(file, "_s = sdscatprintf(_s, \"%s\", %s); ", final_fmt, final_expr);
-            }
-            else
-            {
-                // Check if the variable is an array type
-                char *var_type = scope_lookup(final_expr);
-                if (var_type && var_type[0] == '[')
-                {
-                    // Get the base type of the array
-                    char *base_type = get_base_type(var_type);
-                    if (base_type)
-                    {
-                        const char *c_base = map_type(base_type);
-                        if (strcmp(c_base, "int") == 0 || strcmp(base_type, "inteiro32") == 0 || strcmp(base_type, "i32") == 0)
-                        {
-                            // Use int array helper function
-                            fprintf(file, "_s = sdscat(_s, array_int_to_string(%s)); ", final_expr);
-                        }
-                        else if (strcmp(c_base, "char*") == 0 || strcmp(base_type, "texto") == 0)
-                        {
-                            // Use string array helper function
-                            fprintf(file, "_s = sdscat(_s, array_string_to_string(%s)); ", final_expr);
-                        }
-                        else
-                        {
-                            // For other array types, fall back to print_any (may need more helpers later)
-                            fprintf(file, "_s = sdscatprintf(_s, print_any(%s), %s); ", final_expr, final_expr);
-                        }
-                    }
-                    else
-                    {
-                        // Couldn't determine base type, fall back to print_any
-                        fprintf(file, "_s = sdscatprintf(_s, print_any(%s), %s); ", final_expr, final_expr);
-                    }
-                }
-                else
-                {
-                    // Auto-detection using _Generic
-                    // "print_any" returns the format string ("%d", "%f") based on type
-                    fprintf(file, "_s = sdscatprintf(_s, print_any(%s), %s); ", final_expr, final_expr);
-                }
-            }
-        }
-        // CASE B: Static Text
-        else
-        {
-            // Optimization: Accumulate static text chunk
-            fprintf(file, "_s = sdscat(_s, \"");
-            while (*cursor != '\0' && !starts_with(cursor, "${"))
-            {
-                // Handle escape sequences: \n, \t, \r, \\, \"
-                if (*cursor == '\\' && *(cursor + 1) != '\0')
-                {
-                    cursor++; // Skip the backslash
-                    switch (*cursor)
-                    {
-                    case 'n':
-                        fprintf(file, "\\n");
-                        break;
-                    case 't':
-                        fprintf(file, "\\t");
-                        break;
-                    case 'r':
-                        fprintf(file, "\\r");
-                        break;
-                    case '\\':
-                        fprintf(file, "\\\\");
-                        break;
-                    case '"':
-                        fprintf(file, "\\\"");
-                        break;
-                    default:
-                        // Unknown escape sequence, output as-is
-                        fprintf(file, "\\%c", *cursor);
-                        break;
-                    }
-                    cursor++;
-                }
-                // Escape C string characters
-                else if (*cursor == '"')
-                    fprintf(file, "\\\"");
-                else if (*cursor == '\n')
-                    fprintf(file, "\\n");
-                else if (*cursor == '\t')
-                    fprintf(file, "\\t");
-                else if (*cursor == '\r')
-                    fprintf(file, "\\r");
-                else
-                    fputc(*cursor, file);
-                cursor++;
-            }
-            fprintf(file, "\"); ");
-        }
+    if (receiver_by_value)
+    {
+        fprintf(file, "%s(%s_soa_get(", method, elem);
+        codegen(array, file);
+        fprintf(file, ", ");
+        codegen(index, file);
+        fprintf(file, ")");
+    }
+    else
+    {
+        fprintf(file, "({ %s_soa *_soa_a = &(", elem);
+        codegen(array, file);
+        fprintf(file, "); long long _soa_i = ");
+        codegen(index, file);
+        fprintf(file, "; %s _soa_e = %s_soa_get(*_soa_a, _soa_i); ", elem, elem);
+        fprintf(file, "%s%s(&_soa_e", has_result ? "__auto_type _soa_r = " : "", method);
+    }
+    for (int i = 1; i < arrlen(node->children); i++)
+    {
+        fprintf(file, ", ");
+        codegen(node->children[i], file);
+    }
+    fprintf(file, ")");
+    if (!receiver_by_value)
+    {
+        fprintf(file, "; %s_soa_set(_soa_a, _soa_i, _soa_e);%s })", elem, has_result ? " _soa_r;" : "");
     }
+}
 
-    // 2. Return the string
-    fprintf(file, "_s; })");
+// Helper: calls used as statements need indentation and a semicolon
+// (builtins such as escreval print their own)
+static bool is_call_statement(ASTNode *node)
+{
+    if (node->type == NODE_METHOD_CALL)
+        return true;
+    return node->type == NODE_FUNC_CALL && node->name && shget(func_defs, node->name);
 }
 
 void codegen_block(ASTNode *node, FILE *file)
@@ -514,7 +4626,7 @@ void codegen_block(ASTNode *node, FILE *file)
     {
         ASTNode *child = node->children[i];
         // Method calls used as statements need indentation and semicolon
-        if (child->type == NODE_METHOD_CALL)
+        if (is_call_statement(child))
         {
             fprintf(file, "    ");
             codegen(child, file);
@@ -535,12 +4647,18 @@ void codegen(ASTNode *node, FILE *file)
     if (!node)
         return;
 
+    // Loops extending a texto with 's = s + ...' build it in place (see STRING BUILDERS)
+    if ((node->type == NODE_CADA || node->type == NODE_ENQUANTO || node->type == NODE_INFINITO) &&
+        codegen_acumuladores(node, file))
+        return;
+
     switch (node->type)
     {
     case NODE_PROGRAM:
     case NODE_LIBRARY:
     {
         bool is_library = (node->type == NODE_LIBRARY);
+        library_mode = is_library;
         scope_enter(); // Global Scope
 
         // --- 0. PREAMBLE (Same for both) ---
@@ -653,20 +4771,114 @@ void codegen(ASTNode *node, FILE *file)
             }
             else
             {
-                fprintf(file, "\nint main(int argc, char** argv) {\n");
-                fprintf(file, "    return 0;\n");
-                fprintf(file, "}\n");
+                fprintf(file, "\nint main(int argc, char** argv) {\n");
+                fprintf(file, "    return 0;\n");
+                fprintf(file, "}\n");
+            }
+            scope_exit();
+            break;
+        }
+
+        // --- PASS 1: STRUCT DEFINITIONS ---
+        // Forward declarations first (allows recursive pointers between any structs)
+        for (int i = 0; i < arrlen(content_block->children); i++)
+        {
+            ASTNode *child = content_block->children[i];
+            if (child->type == NODE_STRUCT_DEF)
+            {
+                shput(struct_defs, child->name, child);
+                fprintf(file, "typedef struct %s %s;\n", child->name, child->name);
+            }
+        }
+        collect_mapa_types(content_block);
+        codegen_mapa_typedefs(file);
+        collect_pequeno_types(content_block);
+        codegen_pequeno_typedefs(file);
+        fprintf(file, "\n");
+
+        // @soa column sets only hold pointers, so they can precede every struct body
+        for (int i = 0; i < arrlen(content_block->children); i++)
+        {
+            ASTNode *child = content_block->children[i];
+            if (child->type == NODE_STRUCT_DEF && is_soa_struct(child->name))
+            {
+                codegen_soa_typedef(child, file);
+            }
+        }
+
+        // Value structs are embedded by value, so each must be complete before
+        // any struct that contains it: emit them in dependency order
+        ASTNode **pending_values = NULL;
+        for (int i = 0; i < arrlen(content_block->children); i++)
+        {
+            ASTNode *child = content_block->children[i];
+            if (child->type == NODE_STRUCT_DEF && is_value_struct(child->name))
+            {
+                arrput(pending_values, child);
+            }
+        }
+        char **emitted_values = NULL;
+        while (arrlen(pending_values) > 0)
+        {
+            int progress = 0;
+            for (int i = 0; i < arrlen(pending_values); i++)
+            {
+                ASTNode *def = pending_values[i];
+                int ready = 1;
+                for (int j = 0; j < arrlen(def->children); j++)
+                {
+                    const char *field_type = def->children[j]->data_type;
+                    if (field_type && is_value_struct(field_type) && !name_in_list(emitted_values, field_type))
+                    {
+                        ready = 0;
+                    }
+                }
+                if (ready)
+                {
+                    codegen(def, file);
+                    arrput(emitted_values, def->name);
+                    arrdel(pending_values, i);
+                    progress = 1;
+                    break;
+                }
+            }
+            if (!progress)
+            {
+                fprintf(stderr, "[Basalto] Erro: estrutura valor '%s' contem a si mesma.\n", pending_values[0]->name);
+                exit(1);
+            }
+        }
+        arrfree(pending_values);
+        arrfree(emitted_values);
+        codegen_pequeno_structs(file);
+
+        for (int i = 0; i < arrlen(content_block->children); i++)
+        {
+            ASTNode *child = content_block->children[i];
+            if (child->type == NODE_STRUCT_DEF && !is_value_struct(child->name))
+            {
+                codegen(child, file);
+            }
+        }
+        codegen_mapa_structs(file);
+
+        for (int i = 0; i < arrlen(content_block->children); i++)
+        {
+            ASTNode *child = content_block->children[i];
+            if (child->type == NODE_STRUCT_DEF && is_soa_struct(child->name))
+            {
+                codegen_soa_helpers(child, file);
             }
-            scope_exit();
-            break;
         }
 
-        // --- PASS 1: STRUCT DEFINITIONS ---
-        for (int i = 0; i < arrlen(content_block->children); i++)
+        if (layout_report)
         {
-            if (content_block->children[i]->type == NODE_STRUCT_DEF)
+            for (int i = 0; i < arrlen(content_block->children); i++)
             {
-                codegen(content_block->children[i], file);
+                if (content_block->children[i]->type == NODE_STRUCT_DEF)
+                {
+                    report_struct_layout(content_block->children[i]);
+                }
             }
         }
 
@@ -683,14 +4895,14 @@ void codegen(ASTNode *node, FILE *file)
                     ASTNode *func = child->children[j];
 
                     // Pointer: ret_type (*name)(params)
-                    fprintf(file, "    %s (*%s)(", map_type(func->data_type), func->name);
+                    fprintf(file, "    %s (*%s)(", ffi_type(func->data_type), func->name);
 
                     int param_count = arrlen(func->children);
                     for (int k = 0; k < param_count; k++)
                     {
                         if (k > 0)
                             fprintf(file, ", ");
-                        fprintf(file, "%s", map_type(func->children[k]->data_type));
+                        fprintf(file, "%s", ffi_type(func->children[k]->data_type));
                     }
                     fprintf(file, ");\n");
                 }
@@ -701,6 +4913,18 @@ void codegen(ASTNode *node, FILE *file)
             }
         }
 
+        // --- PASS 1C: FUNCTION TABLE & ESCAPE SUMMARIES (which parameters a function may keep) ---
+        for (int i = 0; i < arrlen(content_block->children); i++)
+        {
+            if (content_block->children[i]->type == NODE_FUNC_DEF)
+            {
+                shput(func_defs, content_block->children[i]->name, content_block->children[i]);
+            }
+        }
+        analyze_param_escapes(content_block);
+        collect_texto_escritas(content_block, &texto_escritos, &campos_escritos);
+        arrfree(texto_escritos);
+
         // --- PASS 2: FUNCTION PROTOTYPES ---
         for (int i = 0; i < arrlen(content_block->children); i++)
         {
@@ -713,6 +4937,18 @@ void codegen(ASTNode *node, FILE *file)
         fprintf(file, "\n");
 
         // --- PASS 3: FUNCTION IMPLEMENTATIONS ---
+        // Function bodies and main are buffered so the helpers they instantiate
+        // (sorting, ...) can be written ahead of them.
+        FILE *out = file;
+        char *body_buf = NULL, *helper_buf = NULL;
+        size_t body_len = 0, helper_len = 0;
+        file = open_memstream(&body_buf, &body_len);
+        helper_file = open_memstream(&helper_buf, &helper_len);
+        if (!file || !helper_file)
+        {
+            fprintf(stderr, "[Basalto] Erro: sem memoria para gerar o codigo.\n");
+            exit(1);
+        }
         for (int i = 0; i < arrlen(content_block->children); i++)
         {
             if (content_block->children[i]->type == NODE_FUNC_DEF)
@@ -730,6 +4966,11 @@ void codegen(ASTNode *node, FILE *file)
         else
         {
             fprintf(file, "\nint main(int argc, char** argv) {\n");
+            if (gc_mode)
+            {
+                // Stack roots are scanned from here up to the innermost frame
+                fprintf(file, "    bs_gc_init(__builtin_frame_address(0));\n");
+            }
         }
         scope_enter(); // Scope for Main/Init
 
@@ -769,6 +5010,20 @@ void codegen(ASTNode *node, FILE *file)
             }
         }
 
+        // Escape analysis for the main body
+        arrfree(current_escapes);
+        arrfree(texto_escritos);
+        escape_types_reset(NULL);
+        for (int i = 0; i < arrlen(content_block->children); i++)
+        {
+            ASTNode *child = content_block->children[i];
+            if (child->type != NODE_STRUCT_DEF && child->type != NODE_FUNC_DEF && child->type != NODE_EXTERN_BLOCK)
+            {
+                collect_escapes(child, &current_escapes);
+                collect_texto_escritas(child, &texto_escritos, NULL);
+            }
+        }
+
         // Generate Statements
         for (int i = 0; i < arrlen(content_block->children); i++)
         {
@@ -776,7 +5031,7 @@ void codegen(ASTNode *node, FILE *file)
             // Skip definitions, only generate statements
             if (child->type != NODE_STRUCT_DEF && child->type != NODE_FUNC_DEF && child->type != NODE_EXTERN_BLOCK)
             {
-                if (child->type == NODE_METHOD_CALL)
+                if (is_call_statement(child))
                 {
                     fprintf(file, "    ");
                     codegen(child, file);
@@ -800,6 +5055,17 @@ void codegen(ASTNode *node, FILE *file)
             fprintf(file, "}\n");
         }
 
+        fclose(file);
+        fclose(helper_file);
+        helper_file = NULL;
+        file = out;
+        fwrite(helper_buf, 1, helper_len, file);
+        fwrite(body_buf, 1, body_len, file);
+        free(helper_buf);
+        free(body_buf);
+        shfree(helper_names);
+        shfree(literal_ids);
+
         scope_exit(); // Exit Global Scope
     }
     break;
@@ -818,9 +5084,26 @@ void codegen(ASTNode *node, FILE *file)
         }
         int is_texto = (strcmp(var_type, "char*") == 0);
         int is_struct = is_struct_type(node->data_type);
+        int is_value = is_struct && is_value_struct(node->data_type);
 
         // Register variable in symbol table
-        if (is_struct)
+        if (is_value)
+        {
+            // Value struct: the variable IS the object (no "*" suffix)
+            scope_bind(node->name, node->data_type);
+            fprintf(file, "    %s %s = ", var_type, node->name);
+            if (arrlen(node->children) > 0)
+            {
+                codegen(node->children[0], file);
+            }
+            else
+            {
+                fprintf(file, "(%s){0}", var_type);
+            }
+            fprintf(file, ";\n");
+            return;
+        }
+        else if (is_struct)
         {
             // Struct: Always a pointer. Store with "*" suffix for tracking
             char ptr_type[256];
@@ -832,6 +5115,76 @@ void codegen(ASTNode *node, FILE *file)
             scope_bind(node->name, node->data_type);
         }
 
+        if (is_fixo_type(node->data_type))
+        {
+            // [T; N]: a C array in this frame
+            codegen_fixo_decl(node, file);
+            return;
+        }
+        if (is_pequeno_type(node->data_type))
+        {
+            // [T; ate N]: inline elements in this frame (see SMALL ARRAYS)
+            codegen_pequeno_decl(node, file);
+            return;
+        }
+
+        if ((is_hash_type(node->data_type) || is_fila_type(node->data_type) || is_fila_prioridade_type(node->data_type)) &&
+            arrlen(node->children) == 0)
+        {
+            // Maps, sets, counters and queues start empty (NULL)
+            fprintf(file, "    %s %s = NULL;\n", var_type, node->name);
+            return;
+        }
+        if (is_bits_type(node->data_type) && arrlen(node->children) == 0)
+        {
+            fprintf(file, "    BsBits %s = {0};\n", node->name);
+            return;
+        }
+        if (is_compacto_type(node->data_type))
+        {
+            // Packed strings start empty (NULL) or copy their initializer into one pool
+            fprintf(file, "    BsTextos* %s = ", node->name);
+            if (arrlen(node->children) > 0)
+                codegen_converted(node->data_type, node->children[0], file);
+            else
+                fprintf(file, "NULL");
+            fprintf(file, ";\n");
+            return;
+        }
+        if (is_construtor_type(node->data_type))
+        {
+            // Builders are allocated up front, so a callee appending to one shares it
+            fprintf(file, "    BsConstrutor* %s = ", node->name);
+            if (arrlen(node->children) > 0)
+                codegen_converted(node->data_type, node->children[0], file);
+            else
+                fprintf(file, "bs_construtor_reservar(NULL, 0)");
+            fprintf(file, ";\n");
+            return;
+        }
+
+        sds soa_elem = soa_element(node->data_type);
+        if (soa_elem)
+        {
+            // @soa array: a zeroed column set, literals are pushed column by column
+            fprintf(file, "    %s %s = ", var_type, node->name);
+            if (arrlen(node->children) > 0 && node->children[0]->type == NODE_ARRAY_LITERAL)
+            {
+                codegen_soa_literal(soa_elem, node->children[0], file);
+            }
+            else if (arrlen(node->children) > 0)
+            {
+                codegen(node->children[0], file);
+            }
+            else
+            {
+                fprintf(file, "{0}");
+            }
+            fprintf(file, ";\n");
+            sdsfree(soa_elem);
+            return;
+        }
+
         if (is_texto)
         {
             // For texto (char*), use sds type
@@ -841,6 +5194,13 @@ void codegen(ASTNode *node, FILE *file)
                 fprintf(file, " = ");
             }
         }
+        else if (is_struct && is_stack_candidate(node))
+        {
+            // 'nova' that never escapes: zeroed storage in this frame, same pointer semantics
+            fprintf(file, "    %s _stack_%s = {0};\n", var_type, node->name);
+            fprintf(file, "    %s* %s = &_stack_%s;\n", var_type, node->name, node->name);
+            return;
+        }
         else if (is_struct)
         {
             // Struct: ALWAYS a pointer. Initialize to NULL if no value.
@@ -883,32 +5243,7 @@ void codegen(ASTNode *node, FILE *file)
             // Check if init value is NODE_INPUT_VALUE
             if (init_node->type == NODE_INPUT_VALUE)
             {
-                const char *type = map_type(node->data_type);
-                // Map Type -> Specific Function
-                if (strcmp(type, "int") == 0)
-                {
-                    fprintf(file, "read_int()");
-                }
-                else if (strcmp(type, "long long") == 0)
-                {
-                    fprintf(file, "read_long()");
-                }
-                else if (strcmp(type, "float") == 0)
-                {
-                    fprintf(file, "read_float()");
-                }
-                else if (strcmp(type, "double") == 0)
-                {
-                    fprintf(file, "read_double()");
-                }
-                else if (strcmp(type, "char*") == 0)
-                {
-                    fprintf(file, "read_string()");
-                }
-                else
-                {
-                    fprintf(file, "read_int()"); // fallback
-                }
+                codegen_input_value(node->data_type, file);
             }
             else if (init_node->type == NODE_LITERAL_STRING)
             {
@@ -941,7 +5276,7 @@ void codegen(ASTNode *node, FILE *file)
                 }
                 else
                 {
-                    codegen(init_node, file);
+                    codegen_converted(node->data_type, init_node, file);
                 }
             }
             else if (init_node->type == NODE_ARRAY_LITERAL)
@@ -962,6 +5297,14 @@ void codegen(ASTNode *node, FILE *file)
                 if (depth > 1)
                 {
                     // Nested array: each child is itself an array literal
+                    // For [[inteiro32]] each row is a [inteiro32] -> int*
+                    sds inner_type = sequence_element(type_str);
+                    sds row_elem = sequence_element(inner_type);
+                    sds c_row_elem = field_c_type(row_elem);
+                    if (arrlen(init_node->children) > 0)
+                    {
+                        fprintf(file, "    arrsetcap(%s, %d);\n", node->name, (int)arrlen(init_node->children));
+                    }
                     for (int i = 0; i < arrlen(init_node->children); i++)
                     {
                         ASTNode *row = init_node->children[i];
@@ -969,28 +5312,10 @@ void codegen(ASTNode *node, FILE *file)
                         {
                             // Create row array
                             fprintf(file, "    {\n");
-                            // Get inner type (remove one bracket level)
-                            // For [[inteiro32]], we want [inteiro32] -> int*
-                            // Extract base type from inner array type
-                            const char *base_type;
-                            sds inner_type = sdsnew(type_str);
-                            if (inner_type[0] == '[' && inner_type[strlen(inner_type) - 1] == ']')
-                            {
-                                inner_type[strlen(inner_type) - 1] = '\0';
-                                memmove(inner_type, inner_type + 1, strlen(inner_type));
-                            }
-                            // inner_type is now [inteiro32], extract base type
-                            count_array_depth(inner_type, &base_type);
-                            const char *c_base = map_type(base_type);
-                            fprintf(file, "        %s* row_%d = NULL;\n", c_base, i);
-                            sdsfree(inner_type);
-
-                            for (int j = 0; j < arrlen(row->children); j++)
-                            {
-                                fprintf(file, "        arrput(row_%d, ", i);
-                                codegen(row->children[j], file);
-                                fprintf(file, ");\n");
-                            }
+                            char row_name[32];
+                            snprintf(row_name, sizeof(row_name), "row_%d", i);
+                            fprintf(file, "        %s* %s = NULL;\n", c_row_elem, row_name);
+                            codegen_array_fill(row_name, c_row_elem, row, "        ", file);
                             fprintf(file, "        arrput(%s, row_%d);\n", node->name, i);
                             fprintf(file, "    }\n");
                         }
@@ -1002,22 +5327,25 @@ void codegen(ASTNode *node, FILE *file)
                             fprintf(file, ");\n");
                         }
                     }
+                    sdsfree(inner_type);
+                    sdsfree(row_elem);
+                    sdsfree(c_row_elem);
                 }
                 else
                 {
-                    // 1D array: simple initialization
-                    for (int i = 0; i < arrlen(init_node->children); i++)
-                    {
-                        fprintf(file, "    arrput(%s, ", node->name);
-                        codegen(init_node->children[i], file);
-                        fprintf(file, ");\n");
-                    }
+                    // 1D array: one static table copy, or exact-capacity puts
+                    sds elem = sequence_element(type_str);
+                    sds c_elem = elem ? field_c_type(elem) : NULL;
+                    codegen_array_fill(node->name, c_elem, init_node, "    ", file);
+                    sdsfree(elem);
+                    sdsfree(c_elem);
                 }
                 return; // Already printed semicolon
             }
             else
             {
-                codegen(init_node, file);
+                // Views and arrays convert into each other (see SLICE VIEWS)
+                codegen_texto_guardado(name_in_list(texto_escritos, node->name), node->data_type, init_node, file);
             }
         }
         fprintf(file, ";\n");
@@ -1025,10 +5353,16 @@ void codegen(ASTNode *node, FILE *file)
 
     case NODE_ASSIGN:
         // x = expr or p.x = expr or arr[i] = expr
+        if (node->name && shget(acumuladores, node->name) && is_acumulacao(node, node->name))
+        {
+            codegen_acumulacao(node, shget(acumuladores, node->name), file);
+            break;
+        }
         fprintf(file, "    ");
 
-        // Check if this is a property access assignment
-        if (arrlen(node->children) > 0 && node->children[0]->type == NODE_PROP_ACCESS)
+        // Check if this is a property access assignment (the parser leaves 'name'
+        // unset for p.x = ..; with a name, a prop access child is the value: x = p.y)
+        if (!node->name && arrlen(node->children) > 0 && node->children[0]->type == NODE_PROP_ACCESS)
         {
             // Property access assignment: p.x = expr
             ASTNode *prop = node->children[0];
@@ -1053,16 +5387,38 @@ void codegen(ASTNode *node, FILE *file)
                 }
             }
 
+            if (is_pequeno_type(infer_type(prop)) && arrlen(node->children) > 1)
+            {
+                // Small array field: copy the elements in
+                codegen_pequeno_assign(prop, infer_type(prop), node->children[1], file);
+                fprintf(file, ";\n");
+                break;
+            }
+            if (is_fixo_type(infer_type(prop)) && arrlen(node->children) > 1)
+            {
+                // Fixed array field: copy the elements in (C arrays are not assignable)
+                sds target = codegen_to_sds(prop);
+                codegen_fixo_assign(target, infer_type(prop), node->children[1], file);
+                fprintf(file, ";\n");
+                sdsfree(target);
+                break;
+            }
             codegen(prop, file);
             fprintf(file, " = ");
             // Value is in children[1] (children[0] is the property access)
             if (arrlen(node->children) > 1)
             {
                 ASTNode *value_node = node->children[1];
+                sds soa_elem = value_node->type == NODE_ARRAY_LITERAL ? soa_element(infer_type(prop)) : NULL;
                 if (value_node->type == NODE_INPUT_VALUE)
                 {
-                    // For property access, we can't easily determine type, use default
-                    fprintf(file, "read_int()");
+                    codegen_input_value(infer_type(prop), file);
+                }
+                else if (soa_elem)
+                {
+                    // @soa array field: fresh column set
+                    codegen_soa_literal(soa_elem, value_node, file);
+                    sdsfree(soa_elem);
                 }
                 else if (value_node->type == NODE_ARRAY_LITERAL && arrlen(value_node->children) == 0)
                 {
@@ -1224,14 +5580,66 @@ void codegen(ASTNode *node, FILE *file)
                     {
                         fprintf(file, "&");
                     }
-                    codegen(value_node, file);
+                    codegen_texto_guardado(name_in_list(campos_escritos, prop->data_type), infer_type(prop), value_node, file);
                 }
             }
         }
-        else if (arrlen(node->children) > 0 && node->children[0]->type == NODE_ARRAY_ACCESS)
+        else if (!node->name && arrlen(node->children) > 0 && node->children[0]->type == NODE_ARRAY_ACCESS)
         {
             // Array access assignment: arr[i] = expr
             ASTNode *arr_access = node->children[0];
+            ASTNode *soa_array = NULL;
+            ASTNode *soa_index = NULL;
+            sds soa_elem = soa_element_access(arr_access, &soa_array, &soa_index);
+            if (soa_elem && arrlen(node->children) > 1)
+            {
+                // @soa: scatter the element into its columns
+                fprintf(file, "%s_soa_set(&", soa_elem);
+                codegen(soa_array, file);
+                fprintf(file, ", ");
+                codegen(soa_index, file);
+                fprintf(file, ", ");
+                codegen_soa_value(soa_elem, node->children[1], file);
+                fprintf(file, ");\n");
+                sdsfree(soa_elem);
+                break;
+            }
+            ASTNode *bits = NULL;
+            ASTNode *bit = NULL;
+            if (bits_access(arr_access, &bits, &bit) && arrlen(node->children) > 1)
+            {
+                // b[i] = v: read-modify-write of the bit's word
+                fprintf(file, "bs_bits_escrever(");
+                codegen(bits, file);
+                fprintf(file, ", ");
+                codegen(bit, file);
+                fprintf(file, ", ");
+                codegen(node->children[1], file);
+                fprintf(file, ");\n");
+                break;
+            }
+            const char *packed = arr_access->name ? scope_lookup(arr_access->name)
+                                 : arrlen(arr_access->children) > 1 ? infer_type(arr_access->children[0]) : NULL;
+            if (is_compacto_type(packed))
+            {
+                fprintf(stderr, "[Basalto] Erro: elementos de '[texto; compacto]' nao podem ser alterados; use .push() para acrescentar.\n");
+                exit(1);
+            }
+            const char *store_base = NULL;
+            if (arr_access->name && arrlen(arr_access->children) == 1)
+                store_base = packed;
+            else if (!arr_access->name && arrlen(arr_access->children) == 2)
+                store_base = infer_type(arr_access->children[0]);
+            if (store_base && strcmp(store_base, "texto") == 0)
+            {
+                // s[i] = c writes in place: own the bytes first (literals live in .rodata)
+                fprintf(file, "bs_texto_possuir(&(");
+                if (arr_access->name)
+                    fprintf(file, "%s", arr_access->name);
+                else
+                    codegen(arr_access->children[0], file);
+                fprintf(file, "));\n");
+            }
             codegen(arr_access, file);
             fprintf(file, " = ");
             // Value is in children[1] (children[0] is the array access)
@@ -1240,61 +5648,60 @@ void codegen(ASTNode *node, FILE *file)
                 ASTNode *value_node = node->children[1];
                 if (value_node->type == NODE_INPUT_VALUE)
                 {
-                    fprintf(file, "read_int()");
+                    codegen_input_value(infer_type(arr_access), file);
                 }
                 else
                 {
-                    codegen(value_node, file);
+                    bool escrito = false;
+                    if (arr_access->name && arrlen(arr_access->children) == 1)
+                    {
+                        sds key = sdscatprintf(sdsempty(), "%s[]", arr_access->name);
+                        escrito = name_in_list(texto_escritos, key);
+                        sdsfree(key);
+                    }
+                    codegen_texto_guardado(escrito, infer_type(arr_access), value_node, file);
                 }
             }
         }
         else
         {
             // Regular variable assignment: x = expr
-            fprintf(file, "%s = ", node->name);
-            if (arrlen(node->children) > 0)
+            if (is_fixo_type(scope_lookup(node->name)) && arrlen(node->children) > 0)
+            {
+                codegen_fixo_assign(node->name, scope_lookup(node->name), node->children[0], file);
+                fprintf(file, ";\n");
+                break;
+            }
+            if (is_pequeno_type(scope_lookup(node->name)) && arrlen(node->children) > 0)
+            {
+                ASTNode *target = ast_new(NODE_VAR_REF);
+                target->name = sdsnew(node->name);
+                codegen_pequeno_assign(target, scope_lookup(node->name), node->children[0], file);
+                fprintf(file, ";\n");
+                break;
+            }
+            fprintf(file, is_container_param(node->name) ? "(*%s) = " : "%s = ", node->name);
+            sds soa_elem = NULL;
+            if (arrlen(node->children) > 0 && node->children[0]->type == NODE_ARRAY_LITERAL)
+            {
+                soa_elem = soa_element(scope_lookup(node->name));
+            }
+            if (soa_elem)
+            {
+                codegen_soa_literal(soa_elem, node->children[0], file);
+                sdsfree(soa_elem);
+            }
+            else if (arrlen(node->children) > 0)
             {
                 ASTNode *value_node = node->children[0];
                 if (value_node->type == NODE_INPUT_VALUE)
                 {
                     // Use Symbol Table to lookup variable type
-                    char *var_type = scope_lookup(node->name);
-                    if (var_type)
-                    {
-                        const char *c_type = map_type(var_type);
-                        if (strcmp(c_type, "int") == 0)
-                        {
-                            fprintf(file, "read_int()");
-                        }
-                        else if (strcmp(c_type, "long long") == 0)
-                        {
-                            fprintf(file, "read_long()");
-                        }
-                        else if (strcmp(c_type, "float") == 0)
-                        {
-                            fprintf(file, "read_float()");
-                        }
-                        else if (strcmp(c_type, "double") == 0)
-                        {
-                            fprintf(file, "read_double()");
-                        }
-                        else if (strcmp(c_type, "char*") == 0)
-                        {
-                            fprintf(file, "read_string()");
-                        }
-                        else
-                        {
-                            fprintf(file, "read_int()");
-                        }
-                    }
-                    else
-                    {
-                        fprintf(file, "read_int()");
-                    }
+                    codegen_input_value(scope_lookup(node->name), file);
                 }
                 else
                 {
-                    codegen(value_node, file);
+                    codegen_texto_guardado(name_in_list(texto_escritos, node->name), scope_lookup(node->name), value_node, file);
                 }
             }
         }
@@ -1342,13 +5749,10 @@ void codegen(ASTNode *node, FILE *file)
         {
             // Format 1: Simple comparison (expr op expr)
             const char *op = node->data_type;
-            if (arrlen(node->children) > 0)
+            if (!codegen_texto_comparacao(op, node->children[0], node->children[1], file))
             {
                 codegen(node->children[0], file); // Left-hand expression
-            }
-            fprintf(file, " %s ", op);
-            if (arrlen(node->children) > 1)
-            {
+                fprintf(file, " %s ", op);
                 codegen(node->children[1], file); // Right-hand expression
             }
             fprintf(file, ") ");
@@ -1417,13 +5821,10 @@ void codegen(ASTNode *node, FILE *file)
         {
             // Format 1: Simple comparison (expr op expr)
             const char *op_while = node->data_type;
-            if (arrlen(node->children) > 0)
+            if (!codegen_texto_comparacao(op_while, node->children[0], node->children[1], file))
             {
                 codegen(node->children[0], file); // Left-hand expression
-            }
-            fprintf(file, " %s ", op_while);
-            if (arrlen(node->children) > 1)
-            {
+                fprintf(file, " %s ", op_while);
                 codegen(node->children[1], file); // Right-hand expression
             }
             fprintf(file, ") ");
@@ -1457,8 +5858,24 @@ void codegen(ASTNode *node, FILE *file)
             if (arrlen(node->children) > 0 && node->children[0]->type == NODE_LITERAL_STRING)
             {
                 fprintf(file, "    printf(\"%%s\\n\", ");
-                codegen_string_literal(node->children[0]->string_value, file);
+                codegen_string_literal(node->children[0], file);
+                fprintf(file, ");\n");
+            }
+            else if (arrlen(node->children) > 0 &&
+                     (is_fatia_texto_type(infer_type(node->children[0])) || is_construtor_type(infer_type(node->children[0]))))
+            {
+                // String view or builder: printed in place
+                fprintf(file, "    { BsFatiaTexto _v = ");
+                codegen_as_fatia_texto(node->children[0], file);
+                fprintf(file, "; printf(\"%%.*s\\n\", (int)_v.len, _v.dados); }\n");
+            }
+            else if (arrlen(node->children) > 0 && is_primitive_type(infer_type(node->children[0])))
+            {
+                // Number, booleano, caractere or texto: formatted without printf
+                fprintf(file, "    bs_escrever_valor(");
+                codegen(node->children[0], file);
                 fprintf(file, ");\n");
+                fprintf(file, "    printf(\"\\n\");\n");
             }
             else
             {
@@ -1485,7 +5902,20 @@ void codegen(ASTNode *node, FILE *file)
             if (arrlen(node->children) > 0 && node->children[0]->type == NODE_LITERAL_STRING)
             {
                 fprintf(file, "    printf(\"%%s\", ");
-                codegen_string_literal(node->children[0]->string_value, file);
+                codegen_string_literal(node->children[0], file);
+                fprintf(file, ");\n");
+            }
+            else if (arrlen(node->children) > 0 &&
+                     (is_fatia_texto_type(infer_type(node->children[0])) || is_construtor_type(infer_type(node->children[0]))))
+            {
+                fprintf(file, "    { BsFatiaTexto _v = ");
+                codegen_as_fatia_texto(node->children[0], file);
+                fprintf(file, "; printf(\"%%.*s\", (int)_v.len, _v.dados); }\n");
+            }
+            else if (arrlen(node->children) > 0 && is_primitive_type(infer_type(node->children[0])))
+            {
+                fprintf(file, "    bs_escrever_valor(");
+                codegen(node->children[0], file);
                 fprintf(file, ");\n");
             }
             else
@@ -1504,16 +5934,28 @@ void codegen(ASTNode *node, FILE *file)
                 fprintf(file, ");\n");
             }
         }
+        else if (is_ler_em_bloco(node))
+        {
+            codegen_ler_em_bloco(node, file);
+        }
+        else if (strcmp(node->name, "erro_conversao") == 0 && !shget(func_defs, "erro_conversao"))
+        {
+            // Outcome of the last string -> number conversion (see STRING TO PRIMITIVE)
+            fprintf(file, "bs_erro_conversao");
+        }
         else
         {
             // Generic function call
             fprintf(file, "%s(", node->name);
-            // Arguments
+            ASTNode *callee = shget(func_defs, node->name);
+            int callee_params = callee ? func_param_count(callee) : 0;
+            // Arguments (converted to the parameter type when known: views <-> arrays)
             for (int i = 0; i < arrlen(node->children); i++)
             {
                 if (i > 0)
                     fprintf(file, ", ");
-                codegen(node->children[i], file);
+                const char *param_type = i < callee_params ? callee->children[i]->data_type : NULL;
+                codegen_call_arg(node->name, param_type, node->children[i], i, file);
             }
             fprintf(file, ")");
         }
@@ -1532,7 +5974,7 @@ void codegen(ASTNode *node, FILE *file)
         break;
 
     case NODE_LITERAL_STRING:
-        codegen_string_literal(node->string_value, file);
+        codegen_string_literal(node, file);
         break;
 
     case NODE_LITERAL_NULL:
@@ -1546,11 +5988,38 @@ void codegen(ASTNode *node, FILE *file)
     case NODE_NEW:
         // nova Node -> (Node*)calloc(1, sizeof(Node))
         // calloc is better than malloc because it zeros memory (sets fields to NULL)
-        fprintf(file, "(%s*)calloc(1, sizeof(%s))", node->data_type, node->data_type);
+        if (is_value_struct(node->data_type))
+        {
+            // estrutura valor: 'nova' is just a zeroed value
+            fprintf(file, "((%s){0})", node->data_type);
+        }
+        else if (gc_mode && struct_alignment(node->data_type) > 16)
+        {
+            fprintf(file, "(%s*)bs_gc_alloc_aligned(sizeof(%s), %d, &bs_gc_layout_%s)",
+                    node->data_type, node->data_type, struct_alignment(node->data_type), node->data_type);
+        }
+        else if (gc_mode)
+        {
+            // --gc: zeroed object in the collector's heap, traced via its layout
+            fprintf(file, "(%s*)bs_gc_alloc(sizeof(%s), &bs_gc_layout_%s)", node->data_type, node->data_type, node->data_type);
+        }
+        else if (struct_alignment(node->data_type) > 16)
+        {
+            // @alinhado(n) beyond malloc's guarantee (sizeof is already a multiple of n)
+            fprintf(file, "(%s*)bs_alloc_aligned(sizeof(%s), %d)",
+                    node->data_type, node->data_type, struct_alignment(node->data_type));
+        }
+        else
+        {
+            fprintf(file, "(%s*)calloc(1, sizeof(%s))", node->data_type, node->data_type);
+        }
         break;
 
     case NODE_VAR_REF:
-        fprintf(file, "%s", node->name);
+        if (is_container_param(node->name))
+            fprintf(file, "(*%s)", node->name);
+        else
+            fprintf(file, "%s", node->name);
         break;
 
     case NODE_UNARY_OP:
@@ -1573,93 +6042,28 @@ void codegen(ASTNode *node, FILE *file)
         const char *bin_op = node->data_type ? node->data_type : "+";
 
         // Check if this is string concatenation (texto + texto or texto + string literal)
-        int is_string_concat = 0;
-        if (strcmp(bin_op, "+") == 0 && arrlen(node->children) >= 2)
-        {
-            ASTNode *left = node->children[0];
-            ASTNode *right = node->children[1];
-
-            // Check if left is a texto variable or string literal
-            int left_is_string = (left->type == NODE_LITERAL_STRING) ||
-                                 (left->type == NODE_VAR_REF && left->name && scope_lookup(left->name) && strcmp(map_type(scope_lookup(left->name)), "char*") == 0);
-
-            // Check if right is a string literal
-            int right_is_string = (right->type == NODE_LITERAL_STRING) ||
-                                  (right->type == NODE_VAR_REF && right->name && scope_lookup(right->name) && strcmp(map_type(scope_lookup(right->name)), "char*") == 0);
-
-            if (left_is_string || right_is_string)
-            {
-                is_string_concat = 1;
-            }
-        }
+        int is_string_concat = strcmp(bin_op, "+") == 0 && arrlen(node->children) >= 2 && is_string_operand(node);
 
         if (is_string_concat)
         {
-            // String concatenation: use sdscat()
-            fprintf(file, "sdscat(");
-            if (arrlen(node->children) > 0)
-            {
-                codegen(node->children[0], file);
-            }
-            fprintf(file, ", ");
-            if (arrlen(node->children) > 1)
+            // String concatenation: the whole chain copied once into a new sds (see STRING BUILDERS)
+            ASTNode **leaves = NULL;
+            concat_leaves(node, &leaves);
+            fprintf(file, "bs_texto_juntar(%d, (BsFatiaTexto[]){ ", (int)arrlen(leaves));
+            for (int i = 0; i < arrlen(leaves); i++)
             {
-                codegen(node->children[1], file);
+                if (i > 0)
+                    fprintf(file, ", ");
+                codegen_as_fatia_texto(leaves[i], file);
             }
-            fprintf(file, ")");
+            fprintf(file, " })");
+            arrfree(leaves);
         }
         else
         {
-            // Check if this is a string comparison (both operands are strings)
-            int is_string_comp = 0;
-            if ((strcmp(bin_op, "==") == 0 || strcmp(bin_op, "!=") == 0) && arrlen(node->children) >= 2)
-            {
-                ASTNode *left = node->children[0];
-                ASTNode *right = node->children[1];
-
-                int left_is_string = (left->type == NODE_LITERAL_STRING) ||
-                                     (left->type == NODE_VAR_REF && left->name && scope_lookup(left->name) && strcmp(map_type(scope_lookup(left->name)), "char*") == 0);
-
-                int right_is_string = (right->type == NODE_LITERAL_STRING) ||
-                                      (right->type == NODE_VAR_REF && right->name && scope_lookup(right->name) && strcmp(map_type(scope_lookup(right->name)), "char*") == 0);
-
-                if (left_is_string && right_is_string)
-                {
-                    is_string_comp = 1;
-                }
-            }
-
-            if (is_string_comp)
+            if (arrlen(node->children) >= 2 && codegen_texto_comparacao(bin_op, node->children[0], node->children[1], file))
             {
-                // String comparison: use strcmp()
-                if (strcmp(bin_op, "==") == 0)
-                {
-                    fprintf(file, "(strcmp(");
-                    if (arrlen(node->children) > 0)
-                    {
-                        codegen(node->children[0], file);
-                    }
-                    fprintf(file, ", ");
-                    if (arrlen(node->children) > 1)
-                    {
-                        codegen(node->children[1], file);
-                    }
-                    fprintf(file, ") == 0)");
-                }
-                else if (strcmp(bin_op, "!=") == 0)
-                {
-                    fprintf(file, "(strcmp(");
-                    if (arrlen(node->children) > 0)
-                    {
-                        codegen(node->children[0], file);
-                    }
-                    fprintf(file, ", ");
-                    if (arrlen(node->children) > 1)
-                    {
-                        codegen(node->children[1], file);
-                    }
-                    fprintf(file, ") != 0)");
-                }
+                // String comparison (see STRING VIEWS)
             }
             else
             {
@@ -1697,6 +6101,30 @@ void codegen(ASTNode *node, FILE *file)
         break;
 
     case NODE_CADA:
+        if (!node->name && !node->end && is_fila_type(infer_type(node->start)))
+        {
+            // cada (x: fila)
+            codegen_fila_cada(node, file);
+            break;
+        }
+        if (!node->name && !node->end && is_bits_type(infer_type(node->start)))
+        {
+            // cada (i: bits)
+            codegen_bits_cada(node, file);
+            break;
+        }
+        if (!node->name && !node->end && is_compacto_type(infer_type(node->start)))
+        {
+            // cada (s: [texto; compacto])
+            codegen_compacto_cada(node, file);
+            break;
+        }
+        if (node->name || !node->end)
+        {
+            // cada (k, v: mapa) / cada (x: conjunto)
+            codegen_mapa_cada(node, file);
+            break;
+        }
         // "cada (i : 0..10)" -> "for (int i = 0; i < 10; i += 1)"
         // 1. Resolve Type (int, double, etc.)
         const char *c_type = map_type(node->cada_type ? node->cada_type : "inteiro32");
@@ -1775,9 +6203,9 @@ void codegen(ASTNode *node, FILE *file)
             }
             else if (first->type == NODE_NEW && first->data_type)
             {
-                // Array of structs: [nova Pessoa] -> Pessoa**
+                // Array of structs: [nova Pessoa] -> Pessoa** (value structs stay inline: Ponto*)
                 elem_type = first->data_type;
-                is_struct_array = true;
+                is_struct_array = !is_value_struct(first->data_type);
             }
         }
 
@@ -1790,147 +6218,230 @@ void codegen(ASTNode *node, FILE *file)
         {
             fprintf(file, "        %s* temp_arr_%d = NULL;\n", elem_type, temp_id);
         }
-        for (int i = 0; i < arrlen(node->children); i++)
-        {
-            fprintf(file, "        arrput(temp_arr_%d, ", temp_id);
-            codegen(node->children[i], file);
-            fprintf(file, ");\n");
-        }
+        char temp_name[32];
+        snprintf(temp_name, sizeof(temp_name), "temp_arr_%d", temp_id);
+        codegen_array_fill(temp_name, is_struct_array ? NULL : elem_type, node, "        ", file);
         fprintf(file, "        temp_arr_%d;\n", temp_id);
         fprintf(file, "    })");
         break;
 
     case NODE_ARRAY_ACCESS:
         // arr[0] or arr[0][1] or arr[0..2] (slice)
-        if (node->name)
+        ASTNode *element_array = NULL;
+        ASTNode *element_index = NULL;
+        sds element_soa = soa_element_access(node, &element_array, &element_index);
+        if (element_soa)
+        {
+            // @soa: gather the element from its columns (a copy)
+            if (!is_value_struct(element_soa))
+            {
+                fprintf(stderr, "[Basalto] Erro: elementos de '[%s]' (@soa) nao sao objetos; use arr[i].campo.\n", element_soa);
+                exit(1);
+            }
+            fprintf(file, "%s_soa_get(", element_soa);
+            codegen(element_array, file);
+            fprintf(file, ", ");
+            codegen(element_index, file);
+            fprintf(file, ")");
+            sdsfree(element_soa);
+        }
+        else
         {
-            // Check if this is a slice (2 children) or single access (1 child)
-            if (arrlen(node->children) == 2)
+            // arr[i] keeps the array in 'name'; nested forms (arr[0][1], p.xs[1..3]) in children[0]
+            ASTNode *base = NULL;
+            ASTNode **bounds = node->children;
+            int bound_count = arrlen(node->children);
+            if (node->name)
+            {
+                base = ast_new(NODE_VAR_REF);
+                base->name = sdsnew(node->name);
+            }
+            else if (bound_count >= 2)
+            {
+                base = node->children[0];
+                bounds++;
+                bound_count--;
+            }
+            const char *base_type = base ? infer_type(base) : NULL;
+            sds elem = sequence_element(base_type);
+            ASTNode *matriz = NULL;
+            ASTNode *matriz_row = NULL;
+
+            if (bound_count == 1 && matriz_row_access(base, &matriz, &matriz_row))
+            {
+                // m[i][j] -> one flat load, no row view
+                codegen_matriz_index(matriz, matriz_row, bounds[0], file);
+                sdsfree(elem);
+                break;
+            }
+            if (is_bits_type(base_type))
             {
-                // Array slice: arr[0..2]
-                const char *array_name = node->name;
-                char *array_type = scope_lookup(array_name);
-                
-                if (array_type && array_type[0] == '[')
+                if (bound_count != 1)
                 {
-                    char *base_type = get_base_type(array_type);
-                    const char *c_base = map_type(base_type);
-                    
-                    // Generate code to create a new array with sliced elements
-                    static int slice_counter = 0;
-                    int slice_id = slice_counter++;
-                    
-                    fprintf(file, "({\n");
-                    fprintf(file, "        %s* slice_arr_%d = NULL;\n", c_base, slice_id);
-                    fprintf(file, "        int start_idx_%d = ", slice_id);
-                    codegen(node->children[0], file); // Start index
-                    fprintf(file, ";\n");
-                    fprintf(file, "        int end_idx_%d = ", slice_id);
-                    codegen(node->children[1], file); // End index
-                    fprintf(file, ";\n");
-                    fprintf(file, "        int len_%d = arrlen(%s);\n", slice_id, array_name);
-                    fprintf(file, "        if (start_idx_%d < 0) start_idx_%d = 0;\n", slice_id, slice_id);
-                    fprintf(file, "        if (end_idx_%d > len_%d) end_idx_%d = len_%d;\n", slice_id, slice_id, slice_id, slice_id);
-                    fprintf(file, "        if (start_idx_%d < end_idx_%d) {\n", slice_id, slice_id);
-                    fprintf(file, "            for (int i_%d = start_idx_%d; i_%d < end_idx_%d; i_%d++) {\n", slice_id, slice_id, slice_id, slice_id, slice_id);
-                    fprintf(file, "                arrput(slice_arr_%d, %s[i_%d]);\n", slice_id, array_name, slice_id);
-                    fprintf(file, "            }\n");
-                    fprintf(file, "        }\n");
-                    fprintf(file, "        slice_arr_%d;\n", slice_id);
-                    fprintf(file, "    })");
+                    fprintf(stderr, "[Basalto] Erro: 'bits' nao pode ser fatiado.\n");
+                    exit(1);
                 }
-                else
+                fprintf(file, "bs_bits_ler(");
+                codegen(base, file);
+                fprintf(file, ", ");
+                codegen(bounds[0], file);
+                fprintf(file, ")");
+                sdsfree(elem);
+                break;
+            }
+            if (is_compacto_type(base_type))
+            {
+                if (bound_count != 1)
                 {
-                    // Fallback if type not found
-                    fprintf(file, "%s[", array_name);
-                    codegen(node->children[0], file);
-                    fprintf(file, "]");
+                    fprintf(stderr, "[Basalto] Erro: '[texto; compacto]' nao pode ser fatiado.\n");
+                    exit(1);
                 }
+                fprintf(file, "bs_textos_em(");
+                codegen(base, file);
+                fprintf(file, ", ");
+                codegen(bounds[0], file);
+                fprintf(file, ")");
+                sdsfree(elem);
+                break;
             }
-            else
+            if (is_matriz_type(base_type))
             {
-                // Simple access: arr[0]
-                fprintf(file, "%s[", node->name);
-                if (arrlen(node->children) > 0)
+                if (bound_count != 1)
                 {
-                    codegen(node->children[0], file); // Index
+                    fprintf(stderr, "[Basalto] Erro: matrizes nao podem ser fatiadas; fatie uma linha (m[i][a..b]).\n");
+                    exit(1);
                 }
-                fprintf(file, "]");
+                codegen_matriz_row(base, bounds[0], file);
+                sdsfree(elem);
+                break;
             }
-        }
-        else if (arrlen(node->children) >= 2)
-        {
-            // Check if this is a nested slice (3 children) or nested access (2 children)
-            if (arrlen(node->children) == 3)
+            if (bound_count == 2 && elem && is_soa_struct(elem))
             {
-                // Nested array slice: arr[0][1..3]
-                codegen(node->children[0], file); // Base (could be another array access)
-                fprintf(file, "[");
-                codegen(node->children[1], file); // Start index
-                fprintf(file, "..");
-                codegen(node->children[2], file); // End index
+                fprintf(stderr, "[Basalto] Erro: arrays @soa ('[%s]') nao podem ser fatiados.\n", elem);
+                exit(1);
+            }
+            if (node->step && !(bound_count == 2 && elem))
+            {
+                fprintf(stderr, "[Basalto] Erro: so arrays e fatias aceitam passo (xs[a..b:p]), recebeu '%s'.\n",
+                        base_type ? base_type : "?");
+                exit(1);
+            }
+            if (bound_count == 2 && elem && node->step)
+            {
+                // Slice with step: arr[0..8:2] -> the same view, striding over it
+                fprintf(file, "bs_fatia_passo(");
+                codegen_fatia_view(base, bounds[0], bounds[1], file);
+                fprintf(file, ", ");
+                codegen(node->step, file);
+                fprintf(file, ")");
+            }
+            else if (bound_count == 2 && elem)
+            {
+                // Slice: arr[0..2] -> O(1) view (see SLICE VIEWS)
+                codegen_fatia_view(base, bounds[0], bounds[1], file);
+            }
+            else if (bound_count == 1 && is_fatia_type(base_type))
+            {
+                codegen_fatia_index(base, bounds[0], file);
+            }
+            else if (bound_count == 1 && is_pequeno_type(base_type))
+            {
+                // Inline or spilled: NAME_dados(p)[i] is an lvalue either way
+                sds p = pequeno_ref(base);
+                fprintf(file, "%s_dados(%s)[", map_type(base_type), p);
+                codegen(bounds[0], file);
                 fprintf(file, "]");
-                // TODO: Implement nested slice if needed
-                // For now, treat as error or generate placeholder
+                sdsfree(p);
             }
-            else
+            else if (base && bound_count >= 1)
             {
-                // Nested access: arr[0][1]
-                codegen(node->children[0], file); // Base (could be another array access)
+                // Simple access: arr[0], arr[0][1] (unknown slices keep the old fallback)
+                codegen(base, file);
                 fprintf(file, "[");
-                codegen(node->children[1], file); // Index
+                codegen(bounds[0], file);
                 fprintf(file, "]");
             }
+            sdsfree(elem);
         }
         break;
 
     case NODE_STRUCT_DEF:
-        // 1. Forward Declaration (Allows recursive pointers)
-        fprintf(file, "typedef struct %s %s;\n", node->name, node->name);
+        // 1. Forward Declaration: emitted for every struct up front (see PASS 1)
 
-        // 2. Struct Definition
-        fprintf(file, "struct %s {\n", node->name);
+        // 2. Struct Definition (fields in layout order, see STRUCT LAYOUT)
+        fprintf(file, "struct ");
+        if (has_struct_flag(node->name, STRUCT_FLAG_PACKED))
+        {
+            fprintf(file, "__attribute__((packed)) ");
+        }
+        if (node->int_value > 0)
+        {
+            fprintf(file, "__attribute__((aligned(%d))) ", node->int_value);
+        }
+        fprintf(file, "%s {\n", node->name);
         if (arrlen(node->children) > 0)
         {
-            for (int i = 0; i < arrlen(node->children); i++)
+            int *field_order = struct_field_order(node);
+            for (int k = 0; k < arrlen(field_order); k++)
             {
-                ASTNode *field = node->children[i];
+                ASTNode *field = node->children[field_order[k]];
                 if (field && field->name && field->data_type)
                 {
                     // Check if it's an array type first
-                    if (field->data_type[0] == '[')
+                    if (is_pequeno_type(field->data_type) && is_value_struct(node->name))
                     {
-                        // Array type: [Type] -> Type* (for stb_ds dynamic arrays)
-                        const char *base_type;
-                        count_array_depth(field->data_type, &base_type);
-                        
-                        // Check if base type is a struct
-                        if (is_struct_type(base_type))
-                        {
-                            // Array of structs: [Pessoa] -> Pessoa**
-                            fprintf(file, "    %s** %s;\n", base_type, field->name);
-                        }
-                        else
-                        {
-                            // Array of primitives: [inteiro32] -> int*
-                            fprintf(file, "    %s* %s;\n", map_type(base_type), field->name);
-                        }
+                        // Copying the value would share the spilled heap buffer
+                        sds shown = pequeno_display(field->data_type);
+                        fprintf(stderr, "[Basalto] Erro: 'estrutura valor %s' nao pode ter o campo '%s: %s'; use '[T; N]' ou uma estrutura comum.\n",
+                                node->name, field->name, shown);
+                        exit(1);
+                    }
+                    if (is_fixo_type(field->data_type))
+                    {
+                        // [T; N]: stored inline
+                        sds declaration = fixo_declaration(field->data_type, field->name);
+                        fprintf(file, "    %s;\n", declaration);
+                        sdsfree(declaration);
+                    }
+                    else if (field->data_type[0] == '[')
+                    {
+                        // Array type: [inteiro32] -> int*, [Pessoa] -> Pessoa**, [Ponto] (valor) -> Ponto*
+                        fprintf(file, "    %s %s;\n", map_type(field->data_type), field->name);
                     }
                     // 3. Auto-Pointer Logic for non-array structs
-                    else if (is_struct_type(field->data_type))
+                    else if (is_struct_type(field->data_type) && !is_value_struct(field->data_type))
                     {
                         // It's a struct (e.g., "Node"). Make it "Node* next;"
                         fprintf(file, "    %s* %s;\n", field->data_type, field->name);
                     }
                     else
                     {
-                        // Primitive (e.g., "int"). Keep as is.
+                        // Primitive (e.g., "int") or value struct stored inline. Keep as is.
                         fprintf(file, "    %s %s;\n", map_type(field->data_type), field->name);
                     }
                 }
             }
+            arrfree(field_order);
         }
         fprintf(file, "};\n\n");
+
+        // 3. GC Layout: offsets of every field the collector must trace
+        if (gc_mode)
+        {
+            int pointer_fields = 0;
+            fprintf(file, "static const size_t bs_gc_offsets_%s[] = {", node->name);
+            codegen_gc_offsets(node->name, NULL, node->name, &pointer_fields, file);
+            if (pointer_fields > 0 && has_struct_flag(node->name, STRUCT_FLAG_PACKED))
+            {
+                // Objects are traced precisely, but arrays and the stack are scanned word by word
+                fprintf(stderr, "[Basalto] Aviso: '%s' e @compacto e guarda ponteiros; com --gc, guarde-a apenas em objetos 'nova'.\n", node->name);
+            }
+            // C99 forbids empty initializers: pad with a dummy entry (count stays 0)
+            fprintf(file, "%s };\n", pointer_fields > 0 ? "" : " 0");
+            // Unused for structs that only live on the stack, inline or in @soa columns
+            fprintf(file, "static const BsGcLayout bs_gc_layout_%s __attribute__((unused)) = { \"%s\", %d, bs_gc_offsets_%s };\n\n",
+                    node->name, node->name, pointer_fields, node->name);
+        }
         break;
 
     case NODE_PROP_ACCESS:
@@ -1948,13 +6459,73 @@ void codegen(ASTNode *node, FILE *file)
                                (obj->type == NODE_PROP_ACCESS) ||
                                (obj->type == NODE_VAR_REF && obj->name);
             
-            if (strcmp(prop_name, "len") == 0 && obj_is_array)
+            ASTNode *soa_array = NULL;
+            ASTNode *soa_index = NULL;
+            sds soa_elem = soa_element(infer_type(obj));
+
+            if (strcmp(prop_name, "len") == 0 && soa_elem)
+            {
+                // .len on a @soa array
+                fprintf(file, "%s_soa_len(", soa_elem);
+                codegen(obj, file);
+                fprintf(file, ")");
+            }
+            else if ((strcmp(prop_name, "len") == 0 || strcmp(prop_name, "capacidade") == 0) && is_pequeno_type(infer_type(obj)))
+            {
+                // .len / .capacidade on a small array
+                codegen_pequeno_method(node, prop_name, file);
+            }
+            else if (strcmp(prop_name, "len") == 0 && is_fixo_type(infer_type(obj)))
+            {
+                // .len on a fixed array: folded to N
+                fprintf(file, "%d", fixo_length(infer_type(obj)));
+            }
+            else if (strcmp(prop_name, "len") == 0 && (is_fila_type(infer_type(obj)) || is_fila_prioridade_type(infer_type(obj))))
+            {
+                // .len on a queue
+                codegen_fila_method(node, prop_name, file);
+            }
+            else if (strcmp(prop_name, "len") == 0 && is_hash_type(infer_type(obj)))
+            {
+                // .len on a map, set or counter -> hmlen()
+                codegen_mapa_method(node, prop_name, file);
+            }
+            else if (strcmp(prop_name, "len") == 0 && is_compacto_type(infer_type(obj)))
+            {
+                // .len on a packed string array
+                codegen_compacto_method(node, prop_name, file);
+            }
+            else if (strcmp(prop_name, "len") == 0 && is_construtor_type(infer_type(obj)))
+            {
+                // .len on a string builder
+                codegen_construtor_method(node, prop_name, file);
+            }
+            else if (strcmp(prop_name, "len") == 0 &&
+                     (is_fatia_type(infer_type(obj)) || is_bits_type(infer_type(obj)) || is_fatia_texto_type(infer_type(obj))))
+            {
+                // .len on a slice view, bitset or string view
+                fprintf(file, "(");
+                codegen(obj, file);
+                fprintf(file, ").len");
+            }
+            else if (strcmp(prop_name, "len") == 0 && infer_type(obj) && strcmp(infer_type(obj), "texto") == 0)
+            {
+                // .len on a texto: the length sds already stores
+                codegen_as_fatia_texto(obj, file);
+                fprintf(file, ".len");
+            }
+            else if (strcmp(prop_name, "len") == 0 && obj_is_array)
             {
                 // .len on an array -> arrlen()
                 fprintf(file, "arrlen(");
                 codegen(obj, file);
                 fprintf(file, ")");
             }
+            else if (strcmp(prop_name, "capacidade") == 0 && sequence_element(infer_type(obj)))
+            {
+                // .capacidade on an array -> arrcap()
+                codegen_capacity_method(node, prop_name, file);
+            }
             else if (strcmp(prop_name, "push") == 0 || strcmp(prop_name, "pop") == 0)
             {
                 if (strcmp(prop_name, "pop") == 0)
@@ -1966,6 +6537,14 @@ void codegen(ASTNode *node, FILE *file)
                 }
                 // push is handled as method call, not here
             }
+            else if (soa_element_access(obj, &soa_array, &soa_index))
+            {
+                // @soa: arr[i].campo -> arr.campo[i] (reads straight from the column)
+                codegen(soa_array, file);
+                fprintf(file, ".%s[", node->data_type);
+                codegen(soa_index, file);
+                fprintf(file, "]");
+            }
             else
             {
                 // Regular property access
@@ -1995,19 +6574,27 @@ void codegen(ASTNode *node, FILE *file)
                         {
                             const char *base_type;
                             count_array_depth(array_type, &base_type);
-                            if (is_struct_type(base_type))
+                            // Value structs are stored inline: arr[i] is the object itself
+                            if (is_struct_type(base_type) && !is_value_struct(base_type))
                             {
                                 is_pointer = true;
                             }
                         }
+                        else if (is_fixo_type(array_type) || is_pequeno_type(array_type) || is_fatia_type(array_type))
+                        {
+                            // [P; N], [P; ate N] and fatia[P] hold P* like [P]
+                            sds elem = sequence_element(array_type);
+                            is_pointer = is_struct_type(elem) && !is_value_struct(elem);
+                            sdsfree(elem);
+                        }
                     }
                     else if (arrlen(obj->children) > 0)
                     {
                         // Nested array access or property access: p->filhos[i]
                         // The base could be a property access that returns an array of structs
-                        // For now, assume it's a pointer if we can't determine
+                        // Assume it's a pointer unless the element type is a known value struct
                         // This handles cases like p->filhos[i].nome
-                        is_pointer = true;
+                        is_pointer = expr_is_struct_pointer(obj);
                     }
                 }
                 // Case 3: If obj is a property access (nested), check if the previous access returned a pointer
@@ -2016,7 +6603,8 @@ void codegen(ASTNode *node, FILE *file)
                 {
                     // Nested property access like n1.next.val
                     // n1.next accesses a struct field which is a pointer, so n1.next is a pointer -> use ->
-                    is_pointer = true;
+                    // Value struct fields (a.pos.x) are inline -> use .
+                    is_pointer = expr_is_struct_pointer(obj);
                 }
                 // Case 4: If obj is a var_ref, check if it's a pointer type
                 else if (obj->type == NODE_VAR_REF && obj->name)
@@ -2040,7 +6628,7 @@ void codegen(ASTNode *node, FILE *file)
                             {
                                 base_type[len - 1] = '\0';
                             }
-                            if (is_struct_type(base_type))
+                            if (is_struct_type(base_type) && !is_value_struct(base_type))
                             {
                                 is_pointer = true;
                             }
@@ -2082,87 +6670,7 @@ void codegen(ASTNode *node, FILE *file)
             {
                 codegen(node->children[0], file);
             }
-            fprintf(file, "), signed char: int8_to_string, short: int16_to_string, int: int32_to_string, long long: int64_to_string, long: int_arq_to_string, float: float32_to_string, double: float64_to_string, long double: float_ext_to_string, char*: char_to_string)(");
-            if (node->name)
-            {
-                fprintf(file, "%s", node->name);
-            }
-            else if (arrlen(node->children) > 0)
-            {
-                codegen(node->children[0], file);
-            }
-            fprintf(file, ")");
-        }
-        // 2. Integer conversion methods (explicit sizes)
-        else if (strcmp(method, "inteiro8") == 0)
-        {
-            fprintf(file, "string_to_int8(");
-            if (node->name)
-            {
-                fprintf(file, "%s", node->name);
-            }
-            else if (arrlen(node->children) > 0)
-            {
-                codegen(node->children[0], file);
-            }
-            fprintf(file, ")");
-        }
-        else if (strcmp(method, "inteiro16") == 0)
-        {
-            fprintf(file, "string_to_int16(");
-            if (node->name)
-            {
-                fprintf(file, "%s", node->name);
-            }
-            else if (arrlen(node->children) > 0)
-            {
-                codegen(node->children[0], file);
-            }
-            fprintf(file, ")");
-        }
-        else if (strcmp(method, "inteiro32") == 0)
-        {
-            fprintf(file, "string_to_int32(");
-            if (node->name)
-            {
-                fprintf(file, "%s", node->name);
-            }
-            else if (arrlen(node->children) > 0)
-            {
-                codegen(node->children[0], file);
-            }
-            fprintf(file, ")");
-        }
-        else if (strcmp(method, "inteiro64") == 0)
-        {
-            fprintf(file, "string_to_int64(");
-            if (node->name)
-            {
-                fprintf(file, "%s", node->name);
-            }
-            else if (arrlen(node->children) > 0)
-            {
-                codegen(node->children[0], file);
-            }
-            fprintf(file, ")");
-        }
-        else if (strcmp(method, "inteiro_arq") == 0)
-        {
-            fprintf(file, "string_to_int_arq(");
-            if (node->name)
-            {
-                fprintf(file, "%s", node->name);
-            }
-            else if (arrlen(node->children) > 0)
-            {
-                codegen(node->children[0], file);
-            }
-            fprintf(file, ")");
-        }
-        // 3. Real conversion methods (explicit sizes)
-        else if (strcmp(method, "real32") == 0)
-        {
-            fprintf(file, "string_to_real32(");
+            fprintf(file, "), signed char: int8_to_string, short: int16_to_string, int: int32_to_string, long long: int64_to_string, long: int_arq_to_string, float: float32_to_string, double: float64_to_string, long double: float_ext_to_string, char*: char_to_string, BsFatiaTexto: fatia_texto_to_string, BsConstrutor*: bs_construtor_texto)(");
             if (node->name)
             {
                 fprintf(file, "%s", node->name);
@@ -2173,30 +6681,19 @@ void codegen(ASTNode *node, FILE *file)
             }
             fprintf(file, ")");
         }
-        else if (strcmp(method, "real64") == 0)
+        // 2. s.inteiro32(), s.real64(), ...: parsed from a view (see STRING TO PRIMITIVE)
+        else if (is_conversao_numero(method) && arrlen(node->children) == 1)
         {
-            fprintf(file, "string_to_real64(");
-            if (node->name)
-            {
-                fprintf(file, "%s", node->name);
-            }
-            else if (arrlen(node->children) > 0)
-            {
-                codegen(node->children[0], file);
-            }
+            fprintf(file, "bs_texto_%s(", method);
+            codegen_as_fatia_texto(node->children[0], file);
             fprintf(file, ")");
         }
-        else if (strcmp(method, "real_ext") == 0)
+        // 3. xs.inteiros() / xs.reais() on a string array: every element parsed in one call
+        else if ((strcmp(method, "inteiros") == 0 || strcmp(method, "reais") == 0) && arrlen(node->children) == 1 &&
+                 textos_array_kind(infer_type(node->children[0])))
         {
-            fprintf(file, "string_to_real_ext(");
-            if (node->name)
-            {
-                fprintf(file, "%s", node->name);
-            }
-            else if (arrlen(node->children) > 0)
-            {
-                codegen(node->children[0], file);
-            }
+            fprintf(file, "bs_%s_%s(", textos_array_kind(infer_type(node->children[0])), method);
+            codegen(node->children[0], file);
             fprintf(file, ")");
         }
         // --- EXISTING LOGIC ---
@@ -2215,7 +6712,41 @@ void codegen(ASTNode *node, FILE *file)
 
             bool is_extern_module = (base_type && strcmp(base_type, "MODULE") == 0);
 
-            if (is_extern_module)
+            // @soa arrays: len/push/pop go through the column helpers
+            ASTNode *soa_obj = arrlen(node->children) > 0 ? node->children[0] : NULL;
+            sds soa_elem = (!is_extern_module && soa_obj) ? soa_element(infer_type(soa_obj)) : NULL;
+            bool soa_method = soa_elem && (strcmp(method, "len") == 0 || strcmp(method, "push") == 0 || strcmp(method, "pop") == 0);
+            if (!is_extern_module && soa_obj)
+            {
+                check_fixo_method(infer_type(soa_obj), method);
+                check_compacto_method(infer_type(soa_obj), method);
+            }
+
+            if (soa_method)
+            {
+                if (strcmp(method, "pop") == 0 && !is_value_struct(soa_elem))
+                {
+                    fprintf(stderr, "[Basalto] Erro: elementos de '[%s]' (@soa) nao sao objetos; use arr[i].campo.\n", soa_elem);
+                    exit(1);
+                }
+                if (strcmp(method, "len") == 0)
+                {
+                    fprintf(file, "%s_soa_len(", soa_elem);
+                }
+                else
+                {
+                    fprintf(file, "%s_soa_%s(&", soa_elem, method);
+                }
+                codegen(soa_obj, file);
+                if (strcmp(method, "push") == 0 && arrlen(node->children) > 1)
+                {
+                    fprintf(file, ", ");
+                    codegen_soa_value(soa_elem, node->children[1], file);
+                }
+                fprintf(file, ")");
+                sdsfree(soa_elem);
+            }
+            else if (is_extern_module)
             {
                 // Extern module namespace call: mat.seno(x) -> mat.seno(x)
                 if (node->name)
@@ -2239,6 +6770,82 @@ void codegen(ASTNode *node, FILE *file)
                 }
                 fprintf(file, ")");
             }
+            else if (soa_obj && is_pequeno_type(infer_type(soa_obj)) && pequeno_method_arity(method) >= 0)
+            {
+                // xs.push(x), xs.len(), xs.reservar(n), ... on a small array (see SMALL ARRAYS)
+                codegen_pequeno_method(node, method, file);
+            }
+            else if (soa_obj && is_fixo_type(infer_type(soa_obj)) && strcmp(method, "len") == 0)
+            {
+                // xs.len() on a fixed array: folded to N
+                fprintf(file, "%d", fixo_length(infer_type(soa_obj)));
+            }
+            else if (soa_obj && capacity_method_arity(method) >= 0 && sequence_element(infer_type(soa_obj)))
+            {
+                // xs.reservar(n), xs.inserir(i, x), ... (see ARRAY CAPACITY)
+                codegen_capacity_method(node, method, file);
+            }
+            else if (soa_obj && (is_fila_type(infer_type(soa_obj)) || is_fila_prioridade_type(infer_type(soa_obj))) &&
+                     fila_method_arity(infer_type(soa_obj), method) >= 0)
+            {
+                // q.push(x), q.pop_frente(), h.topo(), ... (see QUEUES)
+                codegen_fila_method(node, method, file);
+            }
+            else if (soa_obj && is_compacto_type(infer_type(soa_obj)) && compacto_method_arity(method) >= 0)
+            {
+                // xs.push(s), xs.len(), xs.limpar(), xs.reservar(n) on packed strings (see PACKED STRING ARRAYS)
+                codegen_compacto_method(node, method, file);
+            }
+            else if (soa_obj && is_construtor_type(infer_type(soa_obj)) && construtor_method_arity(method) >= 0)
+            {
+                // sb.anexar(x), sb.reservar(n), sb.len(), sb.limpar() (see STRING BUILDERS)
+                codegen_construtor_method(node, method, file);
+            }
+            else if (soa_obj && texto_method_index(infer_type(soa_obj), method) >= 0)
+            {
+                // s.sub(a, b), s.dividir(sep), s.encontrar(p), ... (see STRING VIEWS)
+                codegen_texto_method(node, method, file);
+            }
+            else if (strcmp(method, "len") == 0 && soa_obj && is_fatia_texto_type(infer_type(soa_obj)))
+            {
+                // view.len
+                fprintf(file, "(");
+                codegen(soa_obj, file);
+                fprintf(file, ").len");
+            }
+            else if (strcmp(method, "len") == 0 && soa_obj && infer_type(soa_obj) && strcmp(infer_type(soa_obj), "texto") == 0)
+            {
+                // s.len(): the length sds already stores
+                codegen_as_fatia_texto(soa_obj, file);
+                fprintf(file, ".len");
+            }
+            else if (soa_obj && is_bits_type(infer_type(soa_obj)) && bits_method_index(method) >= 0)
+            {
+                // b.contar(), b.proximo(i), b.ou(o), ... (see BITSETS)
+                codegen_bits_method(node, method, file);
+            }
+            else if (soa_obj && is_hash_type(infer_type(soa_obj)) && mapa_method_arity(infer_type(soa_obj), method) >= 0)
+            {
+                // m.obter(k), m.definir(k, v), s.uniao(t), c.adicionar(x), ... (see MAPS)
+                codegen_mapa_method(node, method, file);
+            }
+            else if (soa_obj && is_sort_method(method) && (sequence_element(infer_type(soa_obj)) || soa_elem))
+            {
+                // xs.ordenar(), xs.busca_binaria(x), ... (see SORTING & SEARCH)
+                codegen_sort_method(node, method, file);
+            }
+            else if (strcmp(method, "len") == 0 && soa_obj && is_fatia_type(infer_type(soa_obj)))
+            {
+                // view.len
+                fprintf(file, "(");
+                codegen(soa_obj, file);
+                fprintf(file, ").len");
+            }
+            else if (strcmp(method, "copiar") == 0 && soa_obj && sequence_element(infer_type(soa_obj)))
+            {
+                // xs.copiar() / view.copiar() -> owned array
+                codegen_copiar(soa_obj, file);
+            }
             else if (strcmp(method, "len") == 0)
             {
                 // arr.len -> arrlen(arr)
@@ -2329,7 +6936,7 @@ void codegen(ASTNode *node, FILE *file)
                     }
                     else
                     {
-                        codegen(value_node, file);
+                        codegen_converted(sequence_element(infer_type(node->children[0])), value_node, file);
                     }
                 }
                 fprintf(file, ")");
@@ -2351,6 +6958,15 @@ void codegen(ASTNode *node, FILE *file)
             else
             {
                 // Struct Method Call: p.mover(10) -> mover(&p, 10) or mover(p, 10) if p is already a pointer
+                ASTNode *elem_array = NULL;
+                ASTNode *elem_index = NULL;
+                sds elem_soa = arrlen(node->children) > 0 ? soa_element_access(node->children[0], &elem_array, &elem_index) : NULL;
+                if (elem_soa)
+                {
+                    codegen_soa_method_call(node, elem_soa, elem_array, elem_index, file);
+                    sdsfree(elem_soa);
+                    break;
+                }
                 fprintf(file, "%s(", method);
 
                 // Check if object is already a pointer (REFERENCE SEMANTICS)
@@ -2365,7 +6981,7 @@ void codegen(ASTNode *node, FILE *file)
                         {
                             obj_is_pointer = true;
                         }
-                        else if (is_struct_type(obj_type))
+                        else if (is_struct_type(obj_type) && !is_value_struct(obj_type))
                         {
                             // REFERENCE SEMANTICS: Structs are always pointers
                             obj_is_pointer = true;
@@ -2382,7 +6998,7 @@ void codegen(ASTNode *node, FILE *file)
                         {
                             obj_is_pointer = true;
                         }
-                        else if (is_struct_type(obj_type))
+                        else if (is_struct_type(obj_type) && !is_value_struct(obj_type))
                         {
                             // REFERENCE SEMANTICS: Structs are always pointers
                             obj_is_pointer = true;
@@ -2390,8 +7006,24 @@ void codegen(ASTNode *node, FILE *file)
                     }
                 }
 
+                else if (arrlen(node->children) > 0)
+                {
+                    // arr[i].mover(): pointer unless the element is a value struct
+                    obj_is_pointer = expr_is_struct_pointer(node->children[0]);
+                }
+
+                // Value structs are passed by copy unless the method takes 'eu'/'self'
+                ASTNode *callee = shget(func_defs, method);
+                bool receiver_by_value = false;
+                if (!obj_is_pointer && callee && func_param_count(callee) > 0)
+                {
+                    ASTNode *receiver = callee->children[0];
+                    receiver_by_value = receiver->name && strcmp(receiver->name, "eu") != 0 &&
+                                        strcmp(receiver->name, "self") != 0 && is_value_struct(receiver->data_type);
+                }
+
                 // Print the object (first child is the object)
-                if (!obj_is_pointer)
+                if (!obj_is_pointer && !receiver_by_value)
                 {
                     fprintf(file, "&"); // Take address only if not already a pointer
                 }
@@ -2407,10 +7039,12 @@ void codegen(ASTNode *node, FILE *file)
                 // Print other arguments
                 // Note: children[0] is the object. Arguments start at index 1.
                 int arg_start_idx = 1;
+                int callee_params = callee ? func_param_count(callee) : 0;
                 for (int i = arg_start_idx; i < arrlen(node->children); i++)
                 {
                     fprintf(file, ", ");
-                    codegen(node->children[i], file);
+                    const char *param_type = i < callee_params ? callee->children[i]->data_type : NULL;
+                    codegen_call_arg(method, param_type, node->children[i], i, file);
                 }
                 fprintf(file, ")");
             }
@@ -2480,6 +7114,14 @@ void codegen(ASTNode *node, FILE *file)
         // body is already set above
         fprintf(file, "{\n");
         scope_enter(); // Function Scope
+        current_function = node;
+
+        // Escape analysis for this body (decides which 'nova' can use the stack)
+        arrfree(current_escapes);
+        escape_types_reset(node);
+        collect_escapes(body, &current_escapes);
+        arrfree(texto_escritos);
+        collect_texto_escritas(body, &texto_escritos, NULL);
 
         // 1. Register Parameters in Symbol Table with Smart Pointer Logic
         int param_count = total_children - 1;
@@ -2490,7 +7132,8 @@ void codegen(ASTNode *node, FILE *file)
             const char *name = p->name;
 
             // If param is struct or "eu"/"self", bind as pointer type in symbol table
-            if ((name && (strcmp(name, "eu") == 0 || strcmp(name, "self") == 0)) || is_struct_type(type))
+            if ((name && (strcmp(name, "eu") == 0 || strcmp(name, "self") == 0)) || (is_struct_type(type) && !is_value_struct(type)) ||
+                is_pequeno_type(type) || is_hash_type(type) || is_fila_type(type) || is_fila_prioridade_type(type))
             {
                 // It is a pointer in C! Bind as "Type*"
                 char ptr_type[256];
@@ -2501,6 +7144,16 @@ void codegen(ASTNode *node, FILE *file)
             {
                 scope_bind(name, type);
             }
+            if (library_mode && type && strcmp(map_type(type), "_Bool") == 0)
+            {
+                // Exported as int: any nonzero the C caller passes is verdadeiro
+                fprintf(file, "    %s = (%s != 0);\n", name, name);
+            }
+            if (type && strcmp(type, "texto") == 0 && name_in_list(texto_escritos, name))
+            {
+                // Stored into below: the caller's string stays as it was
+                fprintf(file, "    %s = sdsdup(%s);\n", name, name);
+            }
         }
 
         // 2. Generate Body Children (manually unwrap the block)
@@ -2509,7 +7162,7 @@ void codegen(ASTNode *node, FILE *file)
             for (int i = 0; i < arrlen(body->children); i++)
             {
                 ASTNode *child = body->children[i];
-                if (child->type == NODE_METHOD_CALL)
+                if (is_call_statement(child))
                 {
                     fprintf(file, "    ");
                     codegen(child, file);
@@ -2523,6 +7176,7 @@ void codegen(ASTNode *node, FILE *file)
         }
 
         scope_exit();
+        current_function = NULL;
         fprintf(file, "}\n\n");
         break;
 
@@ -2535,7 +7189,10 @@ void codegen(ASTNode *node, FILE *file)
             // If so, we need to handle the type mismatch
             // For now, just generate the return value - the compiler will error if types don't match
             // The real fix is to update function signatures, but that requires two-pass codegen
-            codegen(ret_value, file);
+            if (ret_value->type == NODE_VAR_REF && texto_escrito(ret_value))
+                codegen(ret_value, file); // A local's own copy: nothing else holds it
+            else
+                codegen_converted(current_function ? current_function->data_type : NULL, ret_value, file);
         }
         fprintf(file, ";\n");
         break;
@@ -1,16 +1,18 @@
 #ifndef EMBEDDED_FILES_H
 #define EMBEDDED_FILES_H
 
-const char *SRC_BASALTO_H = "#ifndef BASALTO_CORE_H\n#define BASALTO_CORE_H\n\n#include <stdio.h>\n#include <stdlib.h>\n#include <string.h>\n#include <stdarg.h>\n#include <dlfcn.h>\n#include \"sds.h\"\n\n// Macro must be in header so it expands in the user code\n#define print_any(x) _Generic((x), \\\n    int: \"%d\", \\\n    long: \"%ld\", \\\n    long long: \"%lld\", \\\n    unsigned int: \"%u\", \\\n    unsigned long: \"%lu\", \\\n    short: \"%hd\", \\\n    float: \"%f\", \\\n    double: \"%lf\", \\\n    char*: \"%s\", \\\n    char: \"%c\", \\\n    default: \"%d\")\n\n// Input\nvoid flush_input();\nint read_int();\nlong long read_long();\nfloat read_float();\ndouble read_double();\nchar* read_string();\nvoid wait_enter();\n\n// Conversions\nsds int8_to_string(signed char x);\nsds int16_to_string(short x);\nsds int32_to_string(int x);\nsds int64_to_string(long long x);\nsds int_arq_to_string(long x);\nsds float32_to_string(float x);\nsds float64_to_string(double x);\nsds float_ext_to_string(long double x);\nsds char_to_string(char* x);\nsds array_int_to_string(int* arr);\nsds array_string_to_string(char** arr);\n\n// String Parsing\nsigned char string_to_int8(char* s);\nshort string_to_int16(char* s);\nint string_to_int32(char* s);\nlong long string_to_int64(char* s);\nlong string_to_int_arq(char* s);\nfloat string_to_real32(char* s);\ndouble string_to_real64(char* s);\nlong double string_to_real_ext(char* s);\n\n// --- MEMORY MANAGEMENT (Arena) ---\nvoid* bs_alloc(size_t size);\nvoid bs_free_all();\n\n#endif\n";
+const char *SRC_BASALTO_H = "#ifndef BASALTO_CORE_H\n#define BASALTO_CORE_H\n\n#include <stdio.h>\n#include <stdlib.h>\n#include <string.h>\n#include <stdarg.h>\n#include <stddef.h>\n#include <stdint.h>\n#include <limits.h>\n#include <dlfcn.h>\n#include \"sds.h\"\n\n// Macro must be in header so it expands in the user code\n#define print_any(x) _Generic((x), \\\n    int: \"%d\", \\\n    long: \"%ld\", \\\n    long long: \"%lld\", \\\n    unsigned int: \"%u\", \\\n    unsigned long: \"%lu\", \\\n    unsigned long long: \"%llu\", \\\n    long double: \"%Lf\", \\\n    short: \"%hd\", \\\n    float: \"%f\", \\\n    double: \"%lf\", \\\n    char*: \"%s\", \\\n    char: \"%c\", \\\n    default: \"%d\")\n\n// Input (buffered stdin, see INPUT HELPERS in core.c)\nvoid flush_input();\nint read_int();\nlong long read_long();\nfloat read_float();\ndouble read_double();\nchar* read_string();\nvoid wait_enter();\nlong long* bs_ler_inteiros(long long n);\ndouble* bs_ler_reais(long long n);\nchar** bs_ler_linhas(void);\n\n// Conversions\nsds int8_to_string(signed char x);\nsds int16_to_string(short x);\nsds int32_to_string(int x);\nsds int64_to_string(long long x);\nsds int_arq_to_string(long x);\nsds float32_to_string(float x);\nsds float64_to_string(double x);\nsds float_ext_to_string(long double x);\nsds char_to_string(char* x);\nsds array_int_to_string(int* arr);\nsds array_int64_to_string(long long* arr);\nsds array_natural_to_string(unsigned long long* arr);\nsds array_double_to_string(double* arr);\nsds array_float_to_string(float* arr);\nsds array_string_to_string(char** arr);\nsds array_bool_to_string(_Bool* arr);\n\n// --- NUMBER FORMATTING ---\n// Hand-written %lld / %llu / %f: the same text printf produces, without parsing\n// a format string. bs_formatar_* write into 'buf' (BS_NUMERO_MAX bytes) and\n// return the length; the sds forms append in place, the escrever forms go to\n// stdout. Used by '.texto()', interpolation, array printing and escreva(l).\n#define BS_NUMERO_MAX 320\nint bs_formatar_inteiro(char* buf, long long x);\nint bs_formatar_natural(char* buf, unsigned long long x);\nint bs_formatar_real(char* buf, double x);\n\nsds bs_sds_anexar_inteiro(sds s, long long x);\nsds bs_sds_anexar_natural(sds s, unsigned long long x);\nsds bs_sds_anexar_real(sds s, double x);\nsds bs_sds_anexar_real_ext(sds s, long double x);\nsds bs_sds_anexar_texto(sds s, const char* x);\nsds bs_sds_anexar_caractere(sds s, char x);\n\nvoid bs_escrever_inteiro(long long x);\nvoid bs_escrever_natural(unsigned long long x);\nvoid bs_escrever_real(double x);\nvoid bs_escrever_real_ext(long double x);\nvoid bs_escrever_texto(const char* x);\nvoid bs_escrever_caractere(char x);\n\n// \"${x}\" for a primitive x (same dispatch as print_any)\n#define bs_sds_anexar_valor(s, x) _Generic((x), \\\n    char*: bs_sds_anexar_texto, \\\n    char: bs_sds_anexar_caractere, \\\n    unsigned int: bs_sds_anexar_natural, \\\n    unsigned long: bs_sds_anexar_natural, \\\n    unsigned long long: bs_sds_anexar_natural, \\\n    float: bs_sds_anexar_real, \\\n    double: bs_sds_anexar_real, \\\n    long double: bs_sds_anexar_real_ext, \\\n    default: bs_sds_anexar_inteiro)((s), (x))\n\n// escreva(x) for a primitive x\n#define bs_escrever_valor(x) _Generic((x), \\\n    char*: bs_escrever_texto, \\\n    char: bs_escrever_caractere, \\\n    unsigned int: bs_escrever_natural, \\\n    unsigned long: bs_escrever_natural, \\\n    unsigned long long: bs_escrever_natural, \\\n    float: bs_escrever_real, \\\n    double: bs_escrever_real, \\\n    long double: bs_escrever_real_ext, \\\n    default: bs_escrever_inteiro)(x)\n\n// --- STATIC STRING LITERALS ---\n// A texto literal without \"${}\": sds header and bytes emitted once, in .rodata.\n// The layout is sds's sdshdr32; SDS_STATIC (sds.h) keeps sdsfree and appends\n// from ever writing to it. Codegen refers to it as (sds)NAME.buf.\n#define BS_TEXTO_FIXO(nome, literal) \\\n    static const struct __attribute__((__packed__)) { \\\n        uint32_t len; \\\n        uint32_t alloc; \\\n        unsigned char flags; \\\n        char buf[sizeof(literal)]; \\\n    } nome = { sizeof(literal) - 1, sizeof(literal) - 1, SDS_TYPE_32 | SDS_STATIC, literal }\n\n// Before a store into the bytes (s[i] = c): a static literal is copied to the\n// heap first, so the write never lands in .rodata.\nstatic inline void bs_texto_possuir(sds* s)\n{\n    if (*s && SDS_IS_STATIC(*s))\n        *s = sdsdup(*s);\n}\n\n// --- SLICE VIEWS (fatia[T]) ---\n// Borrowed window into an array, created in O(1): element i lives at\n// ((T*)dados)[i * passo]. Writes go to the underlying array.\ntypedef struct BsFatia {\n    void* dados;\n    long long len;\n    long long passo;\n} BsFatia;\n\n// View of [inicio, fim) over 'len' elements of 'tam' bytes (bounds are clamped)\nstatic inline BsFatia bs_fatia(void* dados, long long len, long long passo, size_t tam, long long inicio, long long fim)\n{\n    if (fim > len) fim = len;\n    if (inicio < 0) inicio = 0;\n    if (inicio > fim) inicio = fim;\n    BsFatia f = { (char*)dados + inicio * passo * (long long)tam, fim - inicio, passo };\n    return f;\n}\n\n// Every 'passo'-th element of a view (xs[a..b:p]), still without copying\nstatic inline BsFatia bs_fatia_passo(BsFatia f, long long passo)\n{\n    if (passo < 1)\n    {\n        fprintf(stderr, \"[Basalto] Erro: o passo de uma fatia deve ser positivo (recebeu %lld).\\n\", passo);\n        exit(1);\n    }\n    BsFatia r = { f.dados, (f.len + passo - 1) / passo, f.passo * passo };\n    return r;\n}\n\n// Elements of a view as a plain C array (sorting needs passo == 1)\nstatic inline void* bs_fatia_contigua(BsFatia f)\n{\n    if (f.passo != 1 && f.len > 1)\n    {\n        fprintf(stderr, \"[Basalto] Erro: a fatia precisa ser contigua (passo 1).\\n\");\n        exit(1);\n    }\n    return f.dados;\n}\n\nsds fatia_int_to_string(BsFatia f);\nsds fatia_int64_to_string(BsFatia f);\nsds fatia_natural_to_string(BsFatia f);\nsds fatia_double_to_string(BsFatia f);\nsds fatia_float_to_string(BsFatia f);\nsds fatia_bool_to_string(BsFatia f);\nsds fatia_string_to_string(BsFatia f);\n\n// --- MATRICES (matriz[T]) ---\n// One row-major buffer: element (i, j) lives at ((T*)dados)[i * colunas + j].\n// Copies share the buffer; row i is a BsFatia over it.\ntypedef struct BsMatriz {\n    void* dados;\n    long long linhas;\n    long long colunas;\n} BsMatriz;\n\n// Zeroed linhas x colunas matrix of 'tam'-byte elements ('folha': elements hold no pointers)\nBsMatriz bs_matriz(long long linhas, long long colunas, size_t tam, int folha);\nsds matriz_int8_to_string(BsMatriz m);\nsds matriz_int16_to_string(BsMatriz m);\nsds matriz_int_to_string(BsMatriz m);\nsds matriz_int64_to_string(BsMatriz m);\nsds matriz_int_arq_to_string(BsMatriz m);\nsds matriz_byte_to_string(BsMatriz m);\nsds matriz_natural16_to_string(BsMatriz m);\nsds matriz_natural32_to_string(BsMatriz m);\nsds matriz_natural_to_string(BsMatriz m);\nsds matriz_natural_arq_to_string(BsMatriz m);\nsds matriz_float_to_string(BsMatriz m);\nsds matriz_double_to_string(BsMatriz m);\nsds matriz_real_ext_to_string(BsMatriz m);\nsds matriz_bool_to_string(BsMatriz m);\n\n// --- BITSETS (bits) ---\n// Packed booleans: bit i is bit (i % 64) of palavras[i / 64]. Set operations\n// run a 64-bit word at a time; bits past 'len' in the last word stay zero.\n// Copies share the buffer (like BsMatriz).\ntypedef struct BsBits {\n    uint64_t* palavras;\n    long long len;\n} BsBits;\n\n// 'len' zeroed bits\nBsBits bs_bits(long long len);\n\nstatic inline _Bool bs_bits_ler(BsBits b, long long i)\n{\n    return (b.palavras[i >> 6] >> (i & 63)) & 1;\n}\n\nstatic inline void bs_bits_escrever(BsBits b, long long i, _Bool v)\n{\n    uint64_t mascara = (uint64_t)1 << (i & 63);\n    b.palavras[i >> 6] = (b.palavras[i >> 6] & ~mascara) | (-(uint64_t)v & mascara);\n}\n\nlong long bs_bits_contar(BsBits b);\n// Index of the first set bit at or after 'inicio', -1 if none\nlong long bs_bits_proximo(BsBits b, long long inicio);\n// In place: a = a & b, a | b, a ^ b (same length required)\nvoid bs_bits_e(BsBits a, BsBits b);\nvoid bs_bits_ou(BsBits a, BsBits b);\nvoid bs_bits_xou(BsBits a, BsBits b);\nvoid bs_bits_inverter(BsBits b);\nvoid bs_bits_preencher(BsBits b, _Bool v);\nBsBits bs_bits_copiar(BsBits b);\nsds bits_to_string(BsBits b);\n\n// --- DEQUES (fila[T]) ---\n// Ring buffer: element i lives at ((T*)dados)[(cabeca + i) & (cap - 1)].\n// cap is 0 or a power of two, so wrapping is a mask instead of a division.\ntypedef struct BsFila {\n    char* dados;\n    size_t cabeca;\n    size_t len;\n    size_t cap;\n} BsFila;\n\n// Room for 'n' elements of 'tam' bytes (allocates the queue when NULL)\nBsFila* bs_fila_reservar(BsFila* f, size_t n, size_t tam);\n// Room for one more element\nBsFila* bs_fila_crescer(BsFila* f, size_t tam);\n// Aborts: pop/peek on an empty queue\nvoid bs_fila_vazia(void);\n\n// --- SMALL ARRAYS ([T; ate N]) ---\n// Codegen emits one struct per (T, N): { BsPequeno h; T local[N]; }. Up to N\n// elements stay inline in 'local'; growing past that moves them to a heap\n// buffer once, and 'heap' then holds them until the array is shrunk.\ntypedef struct BsPequeno {\n    void* heap;      // NULL while the elements are inline\n    long long len;\n    long long cap;   // Elements that fit in 'heap'\n} BsPequeno;\n\nstatic inline long long bs_pequeno_cap(const BsPequeno* h, long long n_local)\n{\n    return h->heap ? h->cap : n_local;\n}\n\n// Room for 'n' elements of 'tam' bytes ('local' holds 'n_local' of them)\nvoid bs_pequeno_reservar(BsPequeno* h, void* local, long long n_local, long long n, size_t tam);\n// Trim the heap buffer to the length, moving back inline when it fits\nvoid bs_pequeno_encolher(BsPequeno* h, void* local, long long n_local, size_t tam);\n\n// --- STRING VIEWS (fatia_texto) ---\n// Borrowed bytes of a string: not NUL-terminated and never freed. '.texto()'\n// copies them into an owned sds. A view of a texto is valid until that texto\n// is modified.\ntypedef struct BsFatiaTexto {\n    const char* dados;\n    long long len;\n} BsFatiaTexto;\n\nsds fatia_texto_to_string(BsFatiaTexto v);\nsds array_fatia_texto_to_string(BsFatiaTexto* arr);\n\n// Whole texto as a view (nulo is the empty string)\nstatic inline BsFatiaTexto bs_fatia_texto_de(sds s)\n{\n    BsFatiaTexto v = { s ? s : \"\", s ? (long long)sdslen(s) : 0 };\n    return v;\n}\n\n// v.sub(a, b): bytes [a, b) (bounds are clamped)\nstatic inline BsFatiaTexto bs_texto_sub(BsFatiaTexto v, long long inicio, long long fim)\n{\n    if (fim > v.len) fim = v.len;\n    if (inicio < 0) inicio = 0;\n    if (inicio > fim) inicio = fim;\n    BsFatiaTexto r = { v.dados + inicio, fim - inicio };\n    return r;\n}\n\nstatic inline _Bool bs_texto_comeca_com(BsFatiaTexto v, BsFatiaTexto p)\n{\n    return p.len <= v.len && memcmp(v.dados, p.dados, (size_t)p.len) == 0;\n}\n\nstatic inline _Bool bs_texto_termina_com(BsFatiaTexto v, BsFatiaTexto p)\n{\n    return p.len <= v.len && memcmp(v.dados + (v.len - p.len), p.dados, (size_t)p.len) == 0;\n}\n\n// a == b: lengths first (O(1) for texto), bytes only when they match\nstatic inline _Bool bs_texto_igual(BsFatiaTexto a, BsFatiaTexto b)\n{\n    return a.len == b.len && (a.dados == b.dados || memcmp(a.dados, b.dados, (size_t)a.len) == 0);\n}\n\n// --- STRING HASHING ---\n// wyhash-style 64-bit hash: each step folds a 64x64->128 bit multiply, 16\n// bytes at a time. '.hash()' uses seed 0 (stable across runs); the texto-keyed\n// maps use it with their own seed through STBDS_HASH_STRING. codegen.c folds\n// the hash of literals with a copy of this function: keep the two in sync.\nstatic inline uint64_t bs_hash_mix(uint64_t a, uint64_t b)\n{\n    __uint128_t r = (__uint128_t)a * b;\n    return (uint64_t)r ^ (uint64_t)(r >> 64);\n}\n\nstatic inline uint64_t bs_hash_ler64(const unsigned char* p)\n{\n    uint64_t v;\n    memcpy(&v, p, 8);\n    return v;\n}\n\nstatic inline uint64_t bs_hash_ler32(const unsigned char* p)\n{\n    uint32_t v;\n    memcpy(&v, p, 4);\n    return v;\n}\n\nstatic inline uint64_t bs_hash_bytes(const void* dados, size_t len, uint64_t seed)\n{\n    const unsigned char* p = (const unsigned char*)dados;\n    uint64_t a, b;\n    seed ^= bs_hash_mix(seed ^ 0xa0761d6478bd642full, 0xe7037ed1a0b428dbull);\n    if (len <= 16)\n    {\n        if (len >= 4)\n        {\n            // Two overlapping 4-byte reads from each end cover 4..16 bytes\n            size_t meio = (len >> 3) << 2;\n            a = (bs_hash_ler32(p) << 32) | bs_hash_ler32(p + meio);\n            b = (bs_hash_ler32(p + len - 4) << 32) | bs_hash_ler32(p + len - 4 - meio);\n        }\n        else if (len > 0)\n        {\n            a = ((uint64_t)p[0] << 16) | ((uint64_t)p[len >> 1] << 8) | p[len - 1];\n            b = 0;\n        }\n        else\n        {\n            a = b = 0;\n        }\n    }\n    else\n    {\n        size_t i = len;\n        while (i > 16)\n        {\n            seed = bs_hash_mix(bs_hash_ler64(p) ^ 0xe7037ed1a0b428dbull, bs_hash_ler64(p + 8) ^ seed);\n            p += 16;\n            i -= 16;\n        }\n        // Last 16 bytes (may overlap the final block)\n        a = bs_hash_ler64(p + i - 16);\n        b = bs_hash_ler64(p + i - 8);\n    }\n    __uint128_t r = (__uint128_t)(a ^ 0xe7037ed1a0b428dbull) * (b ^ seed);\n    return bs_hash_mix((uint64_t)r ^ 0xa0761d6478bd642full ^ len, (uint64_t)(r >> 64) ^ 0xe7037ed1a0b428dbull);\n}\n\n// s.hash()\nstatic inline unsigned long long bs_texto_hash(BsFatiaTexto v)\n{\n    return bs_hash_bytes(v.dados, (size_t)v.len, 0);\n}\n\n// Texto-keyed maps ('sh' tables in stb_ds) hash their keys with bs_hash_bytes\n#define STBDS_HASH_STRING(str, seed) ((size_t)bs_hash_bytes((str), strlen(str), (seed)))\n\n// a + b + c: the pieces copied into one exact-size sds (no operand is modified)\nsds bs_texto_juntar(int n, const BsFatiaTexto* partes);\n// Without leading and trailing whitespace\nBsFatiaTexto bs_texto_aparar(BsFatiaTexto v);\n// Index of the first occurrence of 'agulha', -1 if none (SIMD, see core.c)\nlong long bs_texto_encontrar(BsFatiaTexto v, BsFatiaTexto agulha);\n// Non-overlapping occurrences of 'agulha'\nlong long bs_texto_contar(BsFatiaTexto v, BsFatiaTexto agulha);\n// Owned copy with every 'de' replaced by 'para'\nsds bs_texto_substituir(BsFatiaTexto v, BsFatiaTexto de, BsFatiaTexto para);\n// Views of the pieces between each 'sep' (a [fatia_texto]; the bytes are not copied)\nBsFatiaTexto* bs_texto_dividir(BsFatiaTexto v, BsFatiaTexto sep);\n\n// --- PACKED STRING ARRAYS ([texto; compacto]) ---\n// Every element lives back to back in one byte pool; element i is\n// bytes[fim[i - 1] .. fim[i]) (fim[-1] = 0). A push appends to the pool and\n// one offset, so n strings cost two growable buffers instead of n sds\n// allocations. Views of elements stay valid until the next push.\ntypedef struct BsTextos {\n    char* bytes;\n    long long* fim;\n    long long len;\n    long long cap;       // Offsets that fit in 'fim'\n    long long cap_bytes; // Bytes that fit in 'bytes'\n} BsTextos;\n\nstatic inline long long bs_textos_len(const BsTextos* t)\n{\n    return t ? t->len : 0;\n}\n\nstatic inline BsFatiaTexto bs_textos_em(const BsTextos* t, long long i)\n{\n    long long inicio = i > 0 ? t->fim[i - 1] : 0;\n    BsFatiaTexto v = { t->bytes + inicio, t->fim[i] - inicio };\n    return v;\n}\n\n// Room for 'n' elements and 'bytes' bytes of text (allocates the array when NULL)\nBsTextos* bs_textos_reservar(BsTextos* t, long long n, long long bytes);\n// Append 'n' bytes of 's' as a new element\nBsTextos* bs_textos_push(BsTextos* t, const char* s, long long n);\n// Packed copy of a [texto]\nBsTextos* bs_textos_de(char** arr);\n// Independent copy (xs.copiar())\nBsTextos* bs_textos_copiar(const BsTextos* t);\n// Unpacked copy: a [texto] with its own sds per element\nchar** bs_textos_para_array(const BsTextos* t);\n// Remove the last element; the view stays valid until the next push\nBsFatiaTexto bs_textos_pop(BsTextos* t);\nsds textos_to_string(const BsTextos* t);\n\nstatic inline BsTextos* bs_textos_push_texto(BsTextos* t, sds s)\n{\n    return bs_textos_push(t, s, s ? (long long)sdslen(s) : 0);\n}\n\nstatic inline BsTextos* bs_textos_push_fatia(BsTextos* t, BsFatiaTexto v)\n{\n    return bs_textos_push(t, v.dados, v.len);\n}\n\nstatic inline void bs_textos_limpar(BsTextos* t)\n{\n    if (t)\n        t->len = 0;\n}\n\n// --- STRING BUILDERS (construtor_texto) ---\n// One growable byte buffer for building a texto piece by piece. The capacity\n// doubles, so n appends copy O(n) bytes in total, and numbers are formatted\n// straight into the free tail instead of through a temporary sds. '.texto()'\n// copies the bytes into an exact-size sds; the builder stays usable.\ntypedef struct BsConstrutor {\n    char* dados;\n    long long len;\n    long long cap;\n} BsConstrutor;\n\n// Room for 'n' bytes in total (allocates the builder when NULL)\nBsConstrutor* bs_construtor_reservar(BsConstrutor* c, long long n);\n// Room for 'n' more bytes, doubling the capacity\nBsConstrutor* bs_construtor_crescer(BsConstrutor* c, long long n);\n// Builder holding a copy of 'v', with room to grow\nBsConstrutor* bs_construtor_de(BsFatiaTexto v);\nsds bs_construtor_texto(const BsConstrutor* c);\nvoid bs_construtor_liberar(BsConstrutor* c);\nBsConstrutor* bs_construtor_anexar_inteiro(BsConstrutor* c, long long x);\nBsConstrutor* bs_construtor_anexar_natural(BsConstrutor* c, unsigned long long x);\nBsConstrutor* bs_construtor_anexar_real(BsConstrutor* c, double x);\nBsConstrutor* bs_construtor_anexar_real_ext(BsConstrutor* c, long double x);\n\nstatic inline long long bs_construtor_len(const BsConstrutor* c)\n{\n    return c ? c->len : 0;\n}\n\n// The bytes built so far, valid until the next append\nstatic inline BsFatiaTexto bs_construtor_vista(const BsConstrutor* c)\n{\n    BsFatiaTexto v = { c ? c->dados : \"\", c ? c->len : 0 };\n    return v;\n}\n\nstatic inline BsConstrutor* bs_construtor_anexar(BsConstrutor* c, const char* s, long long n)\n{\n    if (!c || c->len + n > c->cap)\n        c = bs_construtor_crescer(c, n);\n    if (n > 0)\n        memcpy(c->dados + c->len, s, (size_t)n);\n    c->len += n;\n    return c;\n}\n\nstatic inline BsConstrutor* bs_construtor_anexar_texto(BsConstrutor* c, sds s)\n{\n    return bs_construtor_anexar(c, s, s ? (long long)sdslen(s) : 0);\n}\n\nstatic inline BsConstrutor* bs_construtor_anexar_fatia(BsConstrutor* c, BsFatiaTexto v)\n{\n    return bs_construtor_anexar(c, v.dados, v.len);\n}\n\nstatic inline BsConstrutor* bs_construtor_anexar_caractere(BsConstrutor* c, char x)\n{\n    return bs_construtor_anexar(c, &x, 1);\n}\n\nstatic inline void bs_construtor_limpar(BsConstrutor* c)\n{\n    if (c)\n        c->len = 0;\n}\n\n// sb.anexar(x) for any primitive: formatted like the interpolation does\n#define bs_construtor_anexar_valor(c, x) _Generic((x), \\\n    char*: bs_construtor_anexar_texto, \\\n    BsFatiaTexto: bs_construtor_anexar_fatia, \\\n    char: bs_construtor_anexar_caractere, \\\n    unsigned long: bs_construtor_anexar_natural, \\\n    unsigned long long: bs_construtor_anexar_natural, \\\n    float: bs_construtor_anexar_real, \\\n    double: bs_construtor_anexar_real, \\\n    long double: bs_construtor_anexar_real_ext, \\\n    default: bs_construtor_anexar_inteiro)((c), (x))\n\n// --- DYNAMIC ARRAYS ---\n// xs.encolher(): trim the stb_ds buffer to its length (returns the new array)\nvoid* bs_arr_encolher(void* arr, size_t tam);\n\n// --- STRING TO PRIMITIVE ---\n// s.inteiro32(), s.real64(), ...: decimal parsing on a view (8 digits per step,\n// see core.c). Whitespace around the number is allowed. Each conversion leaves\n// its outcome in bs_erro_conversao ('erro_conversao()' in Basalto).\n#define BS_CONVERSAO_OK 0\n#define BS_CONVERSAO_INVALIDO 1 // Not a number: the value is the parsed prefix\n#define BS_CONVERSAO_ESTOURO 2  // Out of range: the value is the nearest limit\nextern int bs_erro_conversao;\n\nlong long bs_texto_para_inteiro(BsFatiaTexto v, long long min, long long max);\ndouble bs_texto_para_real(BsFatiaTexto v);\nlong double bs_texto_para_real_ext(BsFatiaTexto v);\nfloat bs_texto_real32(BsFatiaTexto v);\n\nstatic inline signed char bs_texto_inteiro8(BsFatiaTexto v) { return (signed char)bs_texto_para_inteiro(v, INT8_MIN, INT8_MAX); }\nstatic inline short bs_texto_inteiro16(BsFatiaTexto v) { return (short)bs_texto_para_inteiro(v, INT16_MIN, INT16_MAX); }\nstatic inline int bs_texto_inteiro32(BsFatiaTexto v) { return (int)bs_texto_para_inteiro(v, INT32_MIN, INT32_MAX); }\nstatic inline long long bs_texto_inteiro64(BsFatiaTexto v) { return bs_texto_para_inteiro(v, INT64_MIN, INT64_MAX); }\nstatic inline long bs_texto_inteiro_arq(BsFatiaTexto v) { return (long)bs_texto_para_inteiro(v, LONG_MIN, LONG_MAX); }\nstatic inline double bs_texto_real64(BsFatiaTexto v) { return bs_texto_para_real(v); }\nstatic inline long double bs_texto_real_ext(BsFatiaTexto v) { return bs_texto_para_real_ext(v); }\n\n// Bulk: s.inteiros(sep) / s.reais(sep) split and parse in one pass; on string\n// arrays, xs.inteiros() / xs.reais() parse every element. New stb_ds arrays.\nlong long* bs_texto_inteiros(BsFatiaTexto v, BsFatiaTexto sep);\ndouble* bs_texto_reais(BsFatiaTexto v, BsFatiaTexto sep);\nlong long* bs_array_texto_inteiros(char** xs);\ndouble* bs_array_texto_reais(char** xs);\nlong long* bs_array_fatia_texto_inteiros(BsFatiaTexto* xs);\ndouble* bs_array_fatia_texto_reais(BsFatiaTexto* xs);\nlong long* bs_textos_inteiros(const BsTextos* t);\ndouble* bs_textos_reais(const BsTextos* t);\n\n// C strings\nsigned char string_to_int8(char* s);\nshort string_to_int16(char* s);\nint string_to_int32(char* s);\nlong long string_to_int64(char* s);\nlong string_to_int_arq(char* s);\nfloat string_to_real32(char* s);\ndouble string_to_real64(char* s);\nlong double string_to_real_ext(char* s);\n\n// --- MEMORY MANAGEMENT (Arena) ---\nvoid* bs_alloc(size_t size);\n// Zeroed, untracked, beyond malloc's alignment\nvoid* bs_alloc_aligned(size_t size, size_t alignment);\nvoid bs_free_all();\n\n// --- MEMORY MANAGEMENT (Tracing GC, basalto --gc) ---\n// Pointer-field offsets of a struct, emitted by codegen for every 'estrutura'\ntypedef struct BsGcLayout {\n    const char* name;\n    size_t count;\n    const size_t* offsets;\n} BsGcLayout;\n\nextern const BsGcLayout bs_gc_leaf;\n\nvoid bs_gc_init(void* stack_bottom);\nvoid bs_gc_collect(void);\nvoid* bs_gc_alloc(size_t size, const BsGcLayout* layout);\nvoid* bs_gc_alloc_aligned(size_t size, size_t align, const BsGcLayout* layout);\nvoid* bs_gc_realloc(void* ptr, size_t size);\nvoid* bs_gc_malloc_leaf(size_t size);\nvoid* bs_gc_realloc_leaf(void* ptr, size_t size);\nvoid bs_gc_free(void* ptr);\n\n#ifdef BASALTO_GC\n// Route stb_ds buffers through the collector (must precede stb_ds.h)\n#define STBDS_REALLOC(c, p, s) bs_gc_realloc(p, s)\n#define STBDS_FREE(c, p) bs_gc_free(p)\n#endif\n\n#endif\n";
 
-const char *SRC_CORE_C = "#include <stdio.h>\n#include <stdlib.h>\n#include <string.h>\n#include <stdarg.h>\n#include <math.h>\n\n#include \"stb_ds.h\"\n#include \"sds.h\"\n\n// --- ARENA MEMORY MANAGER ---\ntypedef struct Allocation\n{\n    void *ptr;\n    struct Allocation *next;\n} Allocation;\n\nstatic Allocation *arena_head = NULL;\n\nvoid *bs_alloc(size_t size)\n{\n    // 1. Allocate object (zero-initialized)\n    void *ptr = calloc(1, size);\n    if (!ptr)\n    {\n        fprintf(stderr, \"[Basalto] Out of memory!\\n\");\n        exit(1);\n    }\n\n    // 2. Track it\n    Allocation *node = malloc(sizeof(Allocation));\n    if (!node)\n    {\n        free(ptr);\n        fprintf(stderr, \"[Basalto] Out of memory (tracker)!\\n\");\n        exit(1);\n    }\n    node->ptr = ptr;\n    node->next = arena_head;\n\n    // 3. Link it\n    arena_head = node;\n\n    return ptr;\n}\n\nvoid bs_free_all()\n{\n    Allocation *current = arena_head;\n    while (current)\n    {\n        Allocation *next = current->next;\n        free(current->ptr);\n        free(current);\n        current = next;\n    }\n    arena_head = NULL;\n}\n\n// --- INPUT HELPERS ---\n\nvoid flush_input()\n{\n    int c;\n    while ((c = getchar()) != '\\n' && c != EOF)\n        ;\n}\n\nint read_int()\n{\n    int x;\n    scanf(\"%d\", &x);\n    flush_input();\n    return x;\n}\n\nlong long read_long()\n{\n    long long x;\n    scanf(\"%lld\", &x);\n    flush_input();\n    return x;\n}\n\nfloat read_float()\n{\n    float x;\n    scanf(\"%f\", &x);\n    flush_input();\n    return x;\n}\n\ndouble read_double()\n{\n    double x;\n    scanf(\"%lf\", &x);\n    flush_input();\n    return x;\n}\n\nchar *read_string()\n{\n    sds s = sdsempty();\n    int c;\n    while ((c = getchar()) != '\\n' && c != EOF)\n    {\n        char ch = c;\n        s = sdscatlen(s, &ch, 1);\n    }\n    return s;\n}\n\nvoid wait_enter()\n{\n    flush_input();\n}\n\n// --- CONVERSION HELPERS ---\n\nsds int8_to_string(signed char x) { return sdscatprintf(sdsempty(), \"%d\", x); }\nsds int16_to_string(short x) { return sdscatprintf(sdsempty(), \"%d\", x); }\nsds int32_to_string(int x) { return sdscatprintf(sdsempty(), \"%d\", x); }\nsds int64_to_string(long long x) { return sdscatprintf(sdsempty(), \"%lld\", x); }\nsds int_arq_to_string(long x) { return sdscatprintf(sdsempty(), \"%ld\", x); }\nsds float32_to_string(float x) { return sdscatprintf(sdsempty(), \"%f\", x); }\nsds float64_to_string(double x) { return sdscatprintf(sdsempty(), \"%f\", x); }\nsds float_ext_to_string(long double x) { return sdscatprintf(sdsempty(), \"%Lf\", x); }\nsds char_to_string(char *x) { return sdsnew(x); }\n\nsds array_int_to_string(int *arr)\n{\n    if (!arr || arrlen(arr) == 0)\n        return sdsnew(\"[]\");\n    sds result = sdsnew(\"[\");\n    for (int i = 0; i < arrlen(arr); i++)\n    {\n        if (i > 0)\n            result = sdscat(result, \", \");\n        result = sdscatprintf(result, \"%d\", arr[i]);\n    }\n    result = sdscat(result, \"]\");\n    return result;\n}\n\nsds array_string_to_string(char **arr)\n{\n    if (!arr || arrlen(arr) == 0)\n        return sdsnew(\"[]\");\n    sds result = sdsnew(\"[\");\n    for (int i = 0; i < arrlen(arr); i++)\n    {\n        if (i > 0)\n            result = sdscat(result, \", \");\n        result = sdscat(result, \"\\\"\");\n        if (arr[i])\n            result = sdscat(result, arr[i]);\n        result = sdscat(result, \"\\\"\");\n    }\n    result = sdscat(result, \"]\");\n    return result;\n}\n\n// --- STRING TO PRIMITIVE ---\n\nsigned char string_to_int8(char *s) { return (signed char)atoi(s); }\nshort string_to_int16(char *s) { return (short)atoi(s); }\nint string_to_int32(char *s) { return atoi(s); }\nlong long string_to_int64(char *s) { return atoll(s); }\nlong string_to_int_arq(char *s) { return atol(s); }\nfloat string_to_real32(char *s) { return (float)atof(s); }\ndouble string_to_real64(char *s) { return atof(s); }\nlong double string_to_real_ext(char *s) { return (long double)atof(s); }\n\n// --- MATH IMPLEMENTATION ---\ndouble bs_sin(double x) { return sin(x); }\ndouble bs_cos(double x) { return cos(x); }\ndouble bs_tan(double x) { return tan(x); }\ndouble bs_asin(double x) { return asin(x); }\ndouble bs_acos(double x) { return acos(x); }\ndouble bs_atan(double x) { return atan(x); }\ndouble bs_sqrt(double x) { return sqrt(x); }\ndouble bs_pow(double b, double e) { return pow(b, e); }\ndouble bs_log(double x) { return log(x); }\ndouble bs_exp(double x) { return exp(x); }\ndouble bs_floor(double x) { return floor(x); }\ndouble bs_ceil(double x) { return ceil(x); }\ndouble bs_round(double x) { return round(x); }\ndouble bs_abs(double x) { return fabs(x); }";
+const char *SRC_CORE_C = "#define _GNU_SOURCE // memmem\n#include <stdio.h>\n#include <stdlib.h>\n#include <string.h>\n#include <stdarg.h>\n#include <math.h>\n#include <errno.h>\n#include <float.h>\n#include <limits.h>\n#include <unistd.h>\n\n#include \"basalto.h\"\n#include \"stb_ds.h\"\n#include \"sds.h\"\n\n// --- ARENA MEMORY MANAGER ---\ntypedef struct Allocation\n{\n    void *ptr;\n    struct Allocation *next;\n} Allocation;\n\nstatic Allocation *arena_head = NULL;\n\n// Link 'ptr' into the arena so bs_free_all releases it\nstatic void arena_track(void *ptr)\n{\n    Allocation *node = malloc(sizeof(Allocation));\n    if (!node)\n    {\n        free(ptr);\n        fprintf(stderr, \"[Basalto] Out of memory (tracker)!\\n\");\n        exit(1);\n    }\n    node->ptr = ptr;\n    node->next = arena_head;\n    arena_head = node;\n}\n\nvoid *bs_alloc(size_t size)\n{\n    // 1. Allocate object (zero-initialized)\n    void *ptr = calloc(1, size);\n    if (!ptr)\n    {\n        fprintf(stderr, \"[Basalto] Out of memory!\\n\");\n        exit(1);\n    }\n\n    // 2. Track it\n    arena_track(ptr);\n    return ptr;\n}\n\n// nova on an @alinhado(n) struct, n > 16 (size is already a multiple of n)\nvoid *bs_alloc_aligned(size_t size, size_t alignment)\n{\n    void *ptr = aligned_alloc(alignment, size);\n    if (!ptr)\n    {\n        fprintf(stderr, \"[Basalto] Out of memory!\\n\");\n        exit(1);\n    }\n    memset(ptr, 0, size);\n    // aligned_alloc memory is released with free() like the rest of the arena\n    arena_track(ptr);\n    return ptr;\n}\n\nvoid bs_free_all()\n{\n    Allocation *current = arena_head;\n    while (current)\n    {\n        Allocation *next = current->next;\n        free(current->ptr);\n        free(current);\n        current = next;\n    }\n    arena_head = NULL;\n}\n\n// --- NUMBER FORMATTING ---\n\n// \"00\" \"01\" ... \"99\": two digits per division\nstatic const char digitos_pares[201] =\n    \"00010203040506070809101112131415161718192021222324252627282930313233343536373839\"\n    \"40414243444546474849505152535455565758596061626364656667686970717273747576777879\"\n    \"8081828384858687888990919293949596979899\";\n\nstatic int contar_digitos(unsigned long long x)\n{\n    int n = 1;\n    while (x >= 100)\n    {\n        x /= 100;\n        n += 2;\n    }\n    return n + (x >= 10);\n}\n\n// Writes the digits of x back to front, ending just before 'fim'\nstatic void escrever_digitos(char *fim, unsigned long long x)\n{\n    while (x >= 100)\n    {\n        unsigned i = (unsigned)(x % 100) * 2;\n        x /= 100;\n        *--fim = digitos_pares[i + 1];\n        *--fim = digitos_pares[i];\n    }\n    if (x >= 10)\n    {\n        *--fim = digitos_pares[x * 2 + 1];\n        *--fim = digitos_pares[x * 2];\n    }\n    else\n    {\n        *--fim = (char)('0' + x);\n    }\n}\n\nint bs_formatar_natural(char *buf, unsigned long long x)\n{\n    int n = contar_digitos(x);\n    escrever_digitos(buf + n, x);\n    buf[n] = '\\0';\n    return n;\n}\n\nint bs_formatar_inteiro(char *buf, long long x)\n{\n    if (x >= 0)\n        return bs_formatar_natural(buf, (unsigned long long)x);\n    buf[0] = '-';\n    return 1 + bs_formatar_natural(buf + 1, 0ull - (unsigned long long)x);\n}\n\n// printf(\"%f\"): six decimals, rounded half to even from the exact binary value.\n// Below 2^63 the integer part fits a 64-bit word and the fraction m / 2^k is\n// scaled by 10^6 exactly in 128 bits; NaN, infinities and larger values go\n// through snprintf.\nint bs_formatar_real(char *buf, double x)\n{\n    double a = fabs(x);\n    if (!(a < 9.2e18))\n        return snprintf(buf, BS_NUMERO_MAX, \"%f\", x);\n\n    char *p = buf;\n    if (signbit(x))\n        *p++ = '-';\n    unsigned long long inteiro = (unsigned long long)a;\n    double fracao = a - (double)inteiro; // Exact\n    unsigned long long micro = 0;\n    int e;\n    double m = frexp(fracao, &e);\n    if (fracao > 0 && e >= -30) // Below 2^-31 the six decimals round to 0\n    {\n        unsigned long long mantissa = (unsigned long long)(m * 9007199254740992.0); // m * 2^53, exact\n        int k = 53 - e;\n        __uint128_t v = (__uint128_t)mantissa * 1000000u;\n        __uint128_t resto = v & (((__uint128_t)1 << k) - 1);\n        __uint128_t meio = (__uint128_t)1 << (k - 1);\n        micro = (unsigned long long)(v >> k);\n        if (resto > meio || (resto == meio && (micro & 1)))\n            micro++;\n        if (micro == 1000000)\n        {\n            micro = 0;\n            inteiro++;\n        }\n    }\n    p += bs_formatar_natural(p, inteiro);\n    *p++ = '.';\n    for (int i = 5; i >= 0; i--)\n    {\n        p[i] = (char)('0' + micro % 10);\n        micro /= 10;\n    }\n    p[6] = '\\0';\n    return (int)(p + 6 - buf);\n}\n\nsds bs_sds_anexar_natural(sds s, unsigned long long x)\n{\n    s = sdsMakeRoomFor(s, 20);\n    int n = bs_formatar_natural(s + sdslen(s), x);\n    sdsIncrLen(s, n);\n    return s;\n}\n\nsds bs_sds_anexar_inteiro(sds s, long long x)\n{\n    s = sdsMakeRoomFor(s, 21);\n    int n = bs_formatar_inteiro(s + sdslen(s), x);\n    sdsIncrLen(s, n);\n    return s;\n}\n\nsds bs_sds_anexar_real(sds s, double x)\n{\n    char buf[BS_NUMERO_MAX];\n    int n = bs_formatar_real(buf, x);\n    return sdscatlen(s, buf, (size_t)n);\n}\n\nsds bs_sds_anexar_real_ext(sds s, long double x) { return sdscatprintf(s, \"%Lf\", x); }\nsds bs_sds_anexar_texto(sds s, const char *x) { return sdscat(s, x ? x : \"(null)\"); }\nsds bs_sds_anexar_caractere(sds s, char x) { return sdscatlen(s, &x, 1); }\n\nvoid bs_escrever_natural(unsigned long long x)\n{\n    char buf[BS_NUMERO_MAX];\n    fwrite(buf, 1, (size_t)bs_formatar_natural(buf, x), stdout);\n}\n\nvoid bs_escrever_inteiro(long long x)\n{\n    char buf[BS_NUMERO_MAX];\n    fwrite(buf, 1, (size_t)bs_formatar_inteiro(buf, x), stdout);\n}\n\nvoid bs_escrever_real(double x)\n{\n    char buf[BS_NUMERO_MAX];\n    fwrite(buf, 1, (size_t)bs_formatar_real(buf, x), stdout);\n}\n\nvoid bs_escrever_real_ext(long double x) { printf(\"%Lf\", x); }\nvoid bs_escrever_texto(const char *x) { fputs(x ? x : \"(null)\", stdout); }\nvoid bs_escrever_caractere(char x) { putchar(x); }\n\n// --- CONVERSION HELPERS ---\n\nstatic sds inteiro_texto(long long x)\n{\n    char buf[BS_NUMERO_MAX];\n    return sdsnewlen(buf, (size_t)bs_formatar_inteiro(buf, x));\n}\n\nstatic sds real_texto(double x)\n{\n    char buf[BS_NUMERO_MAX];\n    return sdsnewlen(buf, (size_t)bs_formatar_real(buf, x));\n}\n\nsds int8_to_string(signed char x) { return inteiro_texto(x); }\nsds int16_to_string(short x) { return inteiro_texto(x); }\nsds int32_to_string(int x) { return inteiro_texto(x); }\nsds int64_to_string(long long x) { return inteiro_texto(x); }\nsds int_arq_to_string(long x) { return inteiro_texto(x); }\nsds float32_to_string(float x) { return real_texto(x); }\nsds float64_to_string(double x) { return real_texto(x); }\nsds float_ext_to_string(long double x) { return sdscatprintf(sdsempty(), \"%Lf\", x); }\nsds char_to_string(char *x) { return sdsnew(x); }\n\n// '[a, b, c]' for a [T] of numbers (or booleans, printed as 0/1)\n#define ARRAY_TO_STRING(nome, tipo, anexar)          \\\n    sds nome(tipo *arr)                              \\\n    {                                                \\\n        if (!arr || arrlen(arr) == 0)                \\\n            return sdsnew(\"[]\");                     \\\n        sds result = sdsnew(\"[\");                    \\\n        for (ptrdiff_t i = 0; i < arrlen(arr); i++)  \\\n        {                                            \\\n            if (i > 0)                               \\\n                result = sdscat(result, \", \");       \\\n            result = anexar(result, arr[i]);         \\\n        }                                            \\\n        result = sdscat(result, \"]\");                \\\n        return result;                               \\\n    }\n\nARRAY_TO_STRING(array_int_to_string, int, bs_sds_anexar_inteiro)\nARRAY_TO_STRING(array_int64_to_string, long long, bs_sds_anexar_inteiro)\nARRAY_TO_STRING(array_natural_to_string, unsigned long long, bs_sds_anexar_natural)\nARRAY_TO_STRING(array_double_to_string, double, bs_sds_anexar_real)\nARRAY_TO_STRING(array_float_to_string, float, bs_sds_anexar_real)\nARRAY_TO_STRING(array_bool_to_string, _Bool, bs_sds_anexar_inteiro)\n\nsds array_string_to_string(char **arr)\n{\n    if (!arr || arrlen(arr) == 0)\n        return sdsnew(\"[]\");\n    sds result = sdsnew(\"[\");\n    for (int i = 0; i < arrlen(arr); i++)\n    {\n        if (i > 0)\n            result = sdscat(result, \", \");\n        result = sdscat(result, \"\\\"\");\n        if (arr[i])\n            result = sdscat(result, arr[i]);\n        result = sdscat(result, \"\\\"\");\n    }\n    result = sdscat(result, \"]\");\n    return result;\n}\n\n// The same for a view: element i at ((T *)dados)[i * passo]\n#define FATIA_TO_STRING(nome, tipo, anexar)                                 \\\n    sds nome(BsFatia f)                                                     \\\n    {                                                                       \\\n        sds result = sdsnew(\"[\");                                           \\\n        for (long long i = 0; i < f.len; i++)                               \\\n        {                                                                   \\\n            if (i > 0)                                                      \\\n                result = sdscat(result, \", \");                              \\\n            result = anexar(result, ((tipo *)f.dados)[i * f.passo]);        \\\n        }                                                                   \\\n        result = sdscat(result, \"]\");                                       \\\n        return result;                                                      \\\n    }\n\nFATIA_TO_STRING(fatia_int_to_string, int, bs_sds_anexar_inteiro)\nFATIA_TO_STRING(fatia_int64_to_string, long long, bs_sds_anexar_inteiro)\nFATIA_TO_STRING(fatia_natural_to_string, unsigned long long, bs_sds_anexar_natural)\nFATIA_TO_STRING(fatia_double_to_string, double, bs_sds_anexar_real)\nFATIA_TO_STRING(fatia_float_to_string, float, bs_sds_anexar_real)\nFATIA_TO_STRING(fatia_bool_to_string, _Bool, bs_sds_anexar_inteiro)\n\nsds fatia_string_to_string(BsFatia f)\n{\n    sds result = sdsnew(\"[\");\n    for (long long i = 0; i < f.len; i++)\n    {\n        char *item = ((char **)f.dados)[i * f.passo];\n        if (i > 0)\n            result = sdscat(result, \", \");\n        result = sdscat(result, \"\\\"\");\n        if (item)\n            result = sdscat(result, item);\n        result = sdscat(result, \"\\\"\");\n    }\n    result = sdscat(result, \"]\");\n    return result;\n}\n\n// --- MATRICES ---\n\nBsMatriz bs_matriz(long long linhas, long long colunas, size_t tam, int folha)\n{\n    if (linhas < 0 || colunas < 0)\n    {\n        fprintf(stderr, \"[Basalto] Erro: matriz com dimensoes invalidas (%lld x %lld).\\n\", linhas, colunas);\n        exit(1);\n    }\n    if (colunas > 0 && (size_t)linhas > SIZE_MAX / tam / (size_t)colunas)\n    {\n        fprintf(stderr, \"[Basalto] Erro: matriz grande demais (%lld x %lld).\\n\", linhas, colunas);\n        exit(1);\n    }\n    size_t bytes = (size_t)linhas * (size_t)colunas * tam;\n#ifdef BASALTO_GC\n    void *dados = bs_gc_alloc(bytes ? bytes : 1, folha ? &bs_gc_leaf : NULL);\n#else\n    (void)folha;\n    void *dados = bs_alloc(bytes ? bytes : 1);\n#endif\n    BsMatriz m = {dados, linhas, colunas};\n    return m;\n}\n\n// One row per line: \"[1, 2]\\n[3, 4]\"\n#define MATRIZ_TO_STRING(nome, tipo, anexar)                                \\\n    sds nome(BsMatriz m)                                                    \\\n    {                                                                       \\\n        sds result = sdsempty();                                            \\\n        for (long long i = 0; i < m.linhas; i++)                            \\\n        {                                                                   \\\n            result = sdscat(result, i > 0 ? \"\\n[\" : \"[\");                   \\\n            for (long long j = 0; j < m.colunas; j++)                       \\\n            {                                                               \\\n                if (j > 0)                                                  \\\n                    result = sdscat(result, \", \");                          \\\n                result = anexar(result, ((tipo *)m.dados)[i * m.colunas + j]); \\\n            }                                                               \\\n            result = sdscat(result, \"]\");                                   \\\n        }                                                                   \\\n        return result;                                                      \\\n    }\n\nMATRIZ_TO_STRING(matriz_int8_to_string, signed char, bs_sds_anexar_inteiro)\nMATRIZ_TO_STRING(matriz_int16_to_string, short, bs_sds_anexar_inteiro)\nMATRIZ_TO_STRING(matriz_int_to_string, int, bs_sds_anexar_inteiro)\nMATRIZ_TO_STRING(matriz_int64_to_string, long long, bs_sds_anexar_inteiro)\nMATRIZ_TO_STRING(matriz_int_arq_to_string, long, bs_sds_anexar_inteiro)\nMATRIZ_TO_STRING(matriz_byte_to_string, unsigned char, bs_sds_anexar_natural)\nMATRIZ_TO_STRING(matriz_natural16_to_string, unsigned short, bs_sds_anexar_natural)\nMATRIZ_TO_STRING(matriz_natural32_to_string, unsigned int, bs_sds_anexar_natural)\nMATRIZ_TO_STRING(matriz_natural_to_string, unsigned long long, bs_sds_anexar_natural)\nMATRIZ_TO_STRING(matriz_natural_arq_to_string, unsigned long, bs_sds_anexar_natural)\nMATRIZ_TO_STRING(matriz_float_to_string, float, bs_sds_anexar_real)\nMATRIZ_TO_STRING(matriz_double_to_string, double, bs_sds_anexar_real)\nMATRIZ_TO_STRING(matriz_real_ext_to_string, long double, bs_sds_anexar_real_ext)\nMATRIZ_TO_STRING(matriz_bool_to_string, _Bool, bs_sds_anexar_inteiro)\n\n// --- BITSETS ---\n\n#define BITS_PALAVRAS(len) (((len) + 63) / 64)\n\nBsBits bs_bits(long long len)\n{\n    if (len < 0)\n    {\n        fprintf(stderr, \"[Basalto] Erro: bits com tamanho invalido (%lld).\\n\", len);\n        exit(1);\n    }\n    size_t bytes = (size_t)BITS_PALAVRAS(len) * sizeof(uint64_t);\n#ifdef BASALTO_GC\n    uint64_t *palavras = bs_gc_alloc(bytes ? bytes : 1, &bs_gc_leaf);\n#else\n    uint64_t *palavras = bs_alloc(bytes ? bytes : 1);\n#endif\n    BsBits b = {palavras, len};\n    return b;\n}\n\nlong long bs_bits_contar(BsBits b)\n{\n    long long total = 0;\n    for (long long w = 0; w < BITS_PALAVRAS(b.len); w++)\n        total += __builtin_popcountll(b.palavras[w]);\n    return total;\n}\n\nlong long bs_bits_proximo(BsBits b, long long inicio)\n{\n    if (inicio < 0)\n        inicio = 0;\n    if (inicio >= b.len)\n        return -1;\n    long long w = inicio >> 6;\n    // Drop the bits below 'inicio' in its own word, then skip whole empty words\n    uint64_t palavra = b.palavras[w] & (~(uint64_t)0 << (inicio & 63));\n    while (palavra == 0)\n    {\n        if (++w >= BITS_PALAVRAS(b.len))\n            return -1;\n        palavra = b.palavras[w];\n    }\n    return w * 64 + __builtin_ctzll(palavra);\n}\n\nstatic void bits_mesmo_tamanho(BsBits a, BsBits b)\n{\n    if (a.len != b.len)\n    {\n        fprintf(stderr, \"[Basalto] Erro: operacao entre bits de tamanhos diferentes (%lld e %lld).\\n\", a.len, b.len);\n        exit(1);\n    }\n}\n\n// Clear the bits of the last word that lie past 'len'\nstatic void bits_aparar(BsBits b)\n{\n    if (b.len & 63)\n        b.palavras[b.len >> 6] &= ((uint64_t)1 << (b.len & 63)) - 1;\n}\n\nvoid bs_bits_e(BsBits a, BsBits b)\n{\n    bits_mesmo_tamanho(a, b);\n    for (long long w = 0; w < BITS_PALAVRAS(a.len); w++)\n        a.palavras[w] &= b.palavras[w];\n}\n\nvoid bs_bits_ou(BsBits a, BsBits b)\n{\n    bits_mesmo_tamanho(a, b);\n    for (long long w = 0; w < BITS_PALAVRAS(a.len); w++)\n        a.palavras[w] |= b.palavras[w];\n}\n\nvoid bs_bits_xou(BsBits a, BsBits b)\n{\n    bits_mesmo_tamanho(a, b);\n    for (long long w = 0; w < BITS_PALAVRAS(a.len); w++)\n        a.palavras[w] ^= b.palavras[w];\n}\n\nvoid bs_bits_inverter(BsBits b)\n{\n    for (long long w = 0; w < BITS_PALAVRAS(b.len); w++)\n        b.palavras[w] = ~b.palavras[w];\n    bits_aparar(b);\n}\n\nvoid bs_bits_preencher(BsBits b, _Bool v)\n{\n    memset(b.palavras, v ? 0xff : 0, (size_t)BITS_PALAVRAS(b.len) * sizeof(uint64_t));\n    bits_aparar(b);\n}\n\nBsBits bs_bits_copiar(BsBits b)\n{\n    BsBits c = bs_bits(b.len);\n    memcpy(c.palavras, b.palavras, (size_t)BITS_PALAVRAS(b.len) * sizeof(uint64_t));\n    return c;\n}\n\n// \"0110...\" (bit 0 first)\nsds bits_to_string(BsBits b)\n{\n    sds result = sdsnewlen(NULL, (size_t)b.len);\n    for (long long i = 0; i < b.len; i++)\n        result[i] = bs_bits_ler(b, i) ? '1' : '0';\n    return result;\n}\n\n// --- DYNAMIC ARRAYS ---\n\n// stb_ds only ever grows a buffer; reallocate it down to exactly 'length' elements\nvoid *bs_arr_encolher(void *arr, size_t tam)\n{\n    if (!arr || stbds_header(arr)->capacity == stbds_header(arr)->length)\n        return arr;\n    size_t len = stbds_header(arr)->length;\n    stbds_array_header *h = STBDS_REALLOC(NULL, stbds_header(arr), sizeof(stbds_array_header) + len * tam);\n    if (!h)\n    {\n        fprintf(stderr, \"[Basalto] Out of memory!\\n\");\n        exit(1);\n    }\n    h->capacity = len;\n    return h + 1;\n}\n\n// --- SMALL ARRAYS ---\n\nvoid bs_pequeno_reservar(BsPequeno *h, void *local, long long n_local, long long n, size_t tam)\n{\n    long long cap = bs_pequeno_cap(h, n_local);\n    if (n <= cap)\n        return;\n    // Same growth as stb_ds: at least double\n    if (n < 2 * cap)\n        n = 2 * cap;\n    void *heap = STBDS_REALLOC(NULL, h->heap, (size_t)n * tam);\n    if (!heap)\n    {\n        fprintf(stderr, \"[Basalto] Out of memory!\\n\");\n        exit(1);\n    }\n    if (!h->heap)\n        memcpy(heap, local, (size_t)h->len * tam);\n    h->heap = heap;\n    h->cap = n;\n}\n\nvoid bs_pequeno_encolher(BsPequeno *h, void *local, long long n_local, size_t tam)\n{\n    if (!h->heap || h->cap == h->len)\n        return;\n    if (h->len <= n_local)\n    {\n        memcpy(local, h->heap, (size_t)h->len * tam);\n        STBDS_FREE(NULL, h->heap);\n        h->heap = NULL;\n        h->cap = 0;\n        return;\n    }\n    void *heap = STBDS_REALLOC(NULL, h->heap, (size_t)h->len * tam);\n    if (!heap)\n    {\n        fprintf(stderr, \"[Basalto] Out of memory!\\n\");\n        exit(1);\n    }\n    h->heap = heap;\n    h->cap = h->len;\n}\n\n// --- DEQUES ---\n\nBsFila *bs_fila_reservar(BsFila *f, size_t n, size_t tam)\n{\n    if (!f)\n    {\n        f = STBDS_REALLOC(NULL, NULL, sizeof(BsFila));\n        if (!f)\n        {\n            fprintf(stderr, \"[Basalto] Out of memory!\\n\");\n            exit(1);\n        }\n        memset(f, 0, sizeof(BsFila));\n    }\n    if (n <= f->cap)\n        return f;\n\n    size_t cap = f->cap ? f->cap : 8;\n    while (cap < n)\n        cap *= 2;\n    char *dados = STBDS_REALLOC(NULL, f->dados, cap * tam);\n    if (!dados)\n    {\n        fprintf(stderr, \"[Basalto] Out of memory!\\n\");\n        exit(1);\n    }\n    // The part that wrapped around to the front moves just past the old end\n    size_t fim = f->cabeca + f->len;\n    if (fim > f->cap)\n        memcpy(dados + f->cap * tam, dados, (fim - f->cap) * tam);\n    f->dados = dados;\n    f->cap = cap;\n    return f;\n}\n\nBsFila *bs_fila_crescer(BsFila *f, size_t tam)\n{\n    return bs_fila_reservar(f, f ? f->len + 1 : 1, tam);\n}\n\nvoid bs_fila_vazia(void)\n{\n    fprintf(stderr, \"[Basalto] Erro: fila vazia.\\n\");\n    exit(1);\n}\n\n// --- STRING VIEWS ---\n\nsds fatia_texto_to_string(BsFatiaTexto v) { return sdsnewlen(v.dados, (size_t)v.len); }\n\nsds array_fatia_texto_to_string(BsFatiaTexto *arr)\n{\n    sds result = sdsnew(\"[\");\n    for (long long i = 0; i < arrlen(arr); i++)\n    {\n        if (i > 0)\n            result = sdscat(result, \", \");\n        result = sdscat(result, \"\\\"\");\n        result = sdscatlen(result, arr[i].dados, (size_t)arr[i].len);\n        result = sdscat(result, \"\\\"\");\n    }\n    result = sdscat(result, \"]\");\n    return result;\n}\n\nsds bs_texto_juntar(int n, const BsFatiaTexto *partes)\n{\n    size_t total = 0;\n    for (int i = 0; i < n; i++)\n        total += (size_t)partes[i].len;\n    sds result = sdsnewlen(NULL, total);\n    char *p = result;\n    for (int i = 0; i < n; i++)\n    {\n        memcpy(p, partes[i].dados, (size_t)partes[i].len);\n        p += partes[i].len;\n    }\n    return result;\n}\n\nstatic int texto_espaco(char c)\n{\n    return c == ' ' || c == '\\t' || c == '\\n' || c == '\\r' || c == '\\v' || c == '\\f';\n}\n\nBsFatiaTexto bs_texto_aparar(BsFatiaTexto v)\n{\n    while (v.len > 0 && texto_espaco(v.dados[0]))\n    {\n        v.dados++;\n        v.len--;\n    }\n    while (v.len > 0 && texto_espaco(v.dados[v.len - 1]))\n        v.len--;\n    return v;\n}\n\n// --- STRING SEARCH ---\n// Needles of 2..BUSCA_CURTA bytes use the first/last byte filter: compare\n// p[0] and p[m - 1] against 16 (SSE2) or 32 (AVX2) positions at once and\n// memcmp only the candidates where both match. Single bytes go to memchr and\n// longer needles to memmem (two-way, linear in the worst case). AVX2 is picked\n// at run time through cpuid; other targets use the scalar loops.\n\n#define BUSCA_CURTA 32\n\n#if defined(__x86_64__)\n#include <immintrin.h>\n\nstatic int busca_avx2(void)\n{\n    static int suportado = -1;\n    if (suportado < 0)\n        suportado = __builtin_cpu_supports(\"avx2\") ? 1 : 0;\n    return suportado;\n}\n#endif\n\n// First/last byte filter without SIMD (tail of the vector loops, other targets)\nstatic long long busca_escalar(const char *s, long long n, const char *p, long long m)\n{\n    for (long long i = 0; i + m <= n; i++)\n    {\n        const char *c = memchr(s + i, p[0], (size_t)(n - m + 1 - i));\n        if (!c)\n            return -1;\n        i = c - s;\n        if (s[i + m - 1] == p[m - 1] && memcmp(s + i + 1, p + 1, (size_t)(m - 2)) == 0)\n            return i;\n    }\n    return -1;\n}\n\n#if defined(__x86_64__)\nstatic long long busca_sse2(const char *s, long long n, const char *p, long long m)\n{\n    const __m128i primeiro = _mm_set1_epi8(p[0]);\n    const __m128i ultimo = _mm_set1_epi8(p[m - 1]);\n    long long i = 0;\n    for (; i + m - 1 + 16 <= n; i += 16)\n    {\n        __m128i a = _mm_loadu_si128((const __m128i *)(s + i));\n        __m128i b = _mm_loadu_si128((const __m128i *)(s + i + m - 1));\n        unsigned mascara = (unsigned)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, primeiro), _mm_cmpeq_epi8(b, ultimo)));\n        while (mascara)\n        {\n            int bit = __builtin_ctz(mascara);\n            if (memcmp(s + i + bit + 1, p + 1, (size_t)(m - 2)) == 0)\n                return i + bit;\n            mascara &= mascara - 1;\n        }\n    }\n    long long resto = busca_escalar(s + i, n - i, p, m);\n    return resto < 0 ? -1 : i + resto;\n}\n\n__attribute__((target(\"avx2\"))) static long long busca_avx2_filtro(const char *s, long long n, const char *p, long long m)\n{\n    const __m256i primeiro = _mm256_set1_epi8(p[0]);\n    const __m256i ultimo = _mm256_set1_epi8(p[m - 1]);\n    long long i = 0;\n    for (; i + m - 1 + 32 <= n; i += 32)\n    {\n        __m256i a = _mm256_loadu_si256((const __m256i *)(s + i));\n        __m256i b = _mm256_loadu_si256((const __m256i *)(s + i + m - 1));\n        unsigned mascara = (unsigned)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, primeiro), _mm256_cmpeq_epi8(b, ultimo)));\n        while (mascara)\n        {\n            int bit = __builtin_ctz(mascara);\n            if (memcmp(s + i + bit + 1, p + 1, (size_t)(m - 2)) == 0)\n                return i + bit;\n            mascara &= mascara - 1;\n        }\n    }\n    long long resto = busca_sse2(s + i, n - i, p, m);\n    return resto < 0 ? -1 : i + resto;\n}\n\n// Occurrences of byte 'c', 16 or 32 at a time (popcount of the match masks)\nstatic long long conta_byte_sse2(const char *s, long long n, char c)\n{\n    const __m128i alvo = _mm_set1_epi8(c);\n    long long total = 0, i = 0;\n    for (; i + 16 <= n; i += 16)\n        total += __builtin_popcount((unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(s + i)), alvo)));\n    for (; i < n; i++)\n        total += s[i] == c;\n    return total;\n}\n\n__attribute__((target(\"avx2,popcnt\"))) static long long conta_byte_avx2(const char *s, long long n, char c)\n{\n    const __m256i alvo = _mm256_set1_epi8(c);\n    long long total = 0, i = 0;\n    for (; i + 32 <= n; i += 32)\n        total += __builtin_popcount((unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(s + i)), alvo)));\n    return total + conta_byte_sse2(s + i, n - i, c);\n}\n#endif\n\nstatic long long busca(const char *s, long long n, const char *p, long long m)\n{\n    if (m == 0)\n        return 0;\n    if (m > n)\n        return -1;\n    if (m == 1)\n    {\n        const char *c = memchr(s, p[0], (size_t)n);\n        return c ? c - s : -1;\n    }\n    if (m > BUSCA_CURTA)\n    {\n        const char *c = memmem(s, (size_t)n, p, (size_t)m);\n        return c ? c - s : -1;\n    }\n#if defined(__x86_64__)\n    if (busca_avx2())\n        return busca_avx2_filtro(s, n, p, m);\n    return busca_sse2(s, n, p, m);\n#else\n    return busca_escalar(s, n, p, m);\n#endif\n}\n\nstatic long long conta_byte(const char *s, long long n, char c)\n{\n#if defined(__x86_64__)\n    if (busca_avx2())\n        return conta_byte_avx2(s, n, c);\n    return conta_byte_sse2(s, n, c);\n#else\n    long long total = 0;\n    for (long long i = 0; i < n; i++)\n        total += s[i] == c;\n    return total;\n#endif\n}\n\nlong long bs_texto_encontrar(BsFatiaTexto v, BsFatiaTexto agulha)\n{\n    return busca(v.dados, v.len, agulha.dados, agulha.len);\n}\n\nlong long bs_texto_contar(BsFatiaTexto v, BsFatiaTexto agulha)\n{\n    if (agulha.len == 0)\n        return 0;\n    if (agulha.len == 1)\n        return conta_byte(v.dados, v.len, agulha.dados[0]);\n    long long total = 0;\n    for (long long i = busca(v.dados, v.len, agulha.dados, agulha.len); i >= 0;)\n    {\n        total++;\n        v = bs_texto_sub(v, i + agulha.len, v.len);\n        i = busca(v.dados, v.len, agulha.dados, agulha.len);\n    }\n    return total;\n}\n\nsds bs_texto_substituir(BsFatiaTexto v, BsFatiaTexto de, BsFatiaTexto para)\n{\n    long long vezes = bs_texto_contar(v, de);\n    if (vezes == 0)\n        return sdsnewlen(v.dados, (size_t)v.len);\n    // Exact size up front: one allocation, no regrowth\n    sds result = sdsnewlen(NULL, (size_t)(v.len + vezes * (para.len - de.len)));\n    char *fim = result;\n    for (long long i = busca(v.dados, v.len, de.dados, de.len); i >= 0; i = busca(v.dados, v.len, de.dados, de.len))\n    {\n        memcpy(fim, v.dados, (size_t)i);\n        memcpy(fim + i, para.dados, (size_t)para.len);\n        fim += i + para.len;\n        v = bs_texto_sub(v, i + de.len, v.len);\n    }\n    memcpy(fim, v.dados, (size_t)v.len);\n    return result;\n}\n\nBsFatiaTexto *bs_texto_dividir(BsFatiaTexto v, BsFatiaTexto sep)\n{\n    BsFatiaTexto *partes = NULL;\n    if (sep.len == 0)\n    {\n        arrput(partes, v);\n        return partes;\n    }\n    for (;;)\n    {\n        long long i = bs_texto_encontrar(v, sep);\n        if (i < 0)\n            break;\n        arrput(partes, bs_texto_sub(v, 0, i));\n        v = bs_texto_sub(v, i + sep.len, v.len);\n    }\n    arrput(partes, v);\n    return partes;\n}\n\n// --- PACKED STRING ARRAYS ---\n\n// Byte pools and offsets hold no pointers: leaves for the collector\nstatic void *bytes_realloc(void *ptr, size_t size)\n{\n#ifdef BASALTO_GC\n    return bs_gc_realloc_leaf(ptr, size);\n#else\n    void *fresh = realloc(ptr, size);\n    if (!fresh)\n    {\n        fprintf(stderr, \"[Basalto] Out of memory!\\n\");\n        exit(1);\n    }\n    return fresh;\n#endif\n}\n\nBsTextos *bs_textos_reservar(BsTextos *t, long long n, long long bytes)\n{\n    if (!t)\n    {\n        t = STBDS_REALLOC(NULL, NULL, sizeof(BsTextos));\n        if (!t)\n        {\n            fprintf(stderr, \"[Basalto] Out of memory!\\n\");\n            exit(1);\n        }\n        memset(t, 0, sizeof(BsTextos));\n    }\n    if (n > t->cap)\n    {\n        long long cap = t->cap ? t->cap : 16;\n        while (cap < n)\n            cap *= 2;\n        t->fim = bytes_realloc(t->fim, (size_t)cap * sizeof(long long));\n        t->cap = cap;\n    }\n    if (bytes > t->cap_bytes || !t->bytes)\n    {\n        long long cap = t->cap_bytes ? t->cap_bytes : 256;\n        while (cap < bytes)\n            cap *= 2;\n        t->bytes = bytes_realloc(t->bytes, (size_t)cap);\n        t->cap_bytes = cap;\n    }\n    return t;\n}\n\nBsTextos *bs_textos_push(BsTextos *t, const char *s, long long n)\n{\n    long long usados = t && t->len > 0 ? t->fim[t->len - 1] : 0;\n    if (!t || t->len == t->cap || usados + n > t->cap_bytes)\n    {\n        // xs.push(xs[i]): the source lives in the pool that is about to move\n        long long dentro = t && t->bytes && s >= t->bytes && s < t->bytes + usados ? s - t->bytes : -1;\n        t = bs_textos_reservar(t, t ? t->len + 1 : 1, usados + n);\n        if (dentro >= 0)\n            s = t->bytes + dentro;\n    }\n    if (n > 0)\n        memcpy(t->bytes + usados, s, (size_t)n);\n    t->fim[t->len++] = usados + n;\n    return t;\n}\n\nBsTextos *bs_textos_de(char **arr)\n{\n    long long bytes = 0;\n    for (long long i = 0; i < arrlen(arr); i++)\n        bytes += arr[i] ? (long long)sdslen(arr[i]) : 0;\n    BsTextos *t = bs_textos_reservar(NULL, arrlen(arr), bytes);\n    for (long long i = 0; i < arrlen(arr); i++)\n        t = bs_textos_push_texto(t, arr[i]);\n    return t;\n}\n\nBsTextos *bs_textos_copiar(const BsTextos *t)\n{\n    long long n = bs_textos_len(t);\n    long long bytes = n > 0 ? t->fim[n - 1] : 0;\n    BsTextos *c = bs_textos_reservar(NULL, n, bytes);\n    if (n > 0)\n    {\n        memcpy(c->bytes, t->bytes, (size_t)bytes);\n        memcpy(c->fim, t->fim, (size_t)n * sizeof(long long));\n    }\n    c->len = n;\n    return c;\n}\n\nchar **bs_textos_para_array(const BsTextos *t)\n{\n    char **arr = NULL;\n    long long n = bs_textos_len(t);\n    arrsetcap(arr, n);\n    for (long long i = 0; i < n; i++)\n    {\n        BsFatiaTexto v = bs_textos_em(t, i);\n        arrput(arr, sdsnewlen(v.dados, (size_t)v.len));\n    }\n    return arr;\n}\n\nBsFatiaTexto bs_textos_pop(BsTextos *t)\n{\n    if (bs_textos_len(t) == 0)\n    {\n        fprintf(stderr, \"[Basalto] Erro: pop em '[texto; compacto]' vazio.\\n\");\n        exit(1);\n    }\n    BsFatiaTexto v = bs_textos_em(t, t->len - 1);\n    t->len--;\n    return v;\n}\n\nsds textos_to_string(const BsTextos *t)\n{\n    sds result = sdsnew(\"[\");\n    for (long long i = 0; i < bs_textos_len(t); i++)\n    {\n        BsFatiaTexto v = bs_textos_em(t, i);\n        if (i > 0)\n            result = sdscat(result, \", \");\n        result = sdscat(result, \"\\\"\");\n        result = sdscatlen(result, v.dados, (size_t)v.len);\n        result = sdscat(result, \"\\\"\");\n    }\n    result = sdscat(result, \"]\");\n    return result;\n}\n\n// --- STRING BUILDERS ---\n\nBsConstrutor *bs_construtor_reservar(BsConstrutor *c, long long n)\n{\n    if (!c)\n    {\n        c = STBDS_REALLOC(NULL, NULL, sizeof(BsConstrutor));\n        if (!c)\n        {\n            fprintf(stderr, \"[Basalto] Out of memory!\\n\");\n            exit(1);\n        }\n        memset(c, 0, sizeof(BsConstrutor));\n    }\n    if (n > c->cap)\n    {\n        c->dados = bytes_realloc(c->dados, (size_t)n);\n        c->cap = n;\n    }\n    return c;\n}\n\nBsConstrutor *bs_construtor_crescer(BsConstrutor *c, long long n)\n{\n    long long usados = c ? c->len : 0;\n    long long cap = c && c->cap ? c->cap : 64;\n    while (cap < usados + n)\n        cap *= 2;\n    return bs_construtor_reservar(c, cap);\n}\n\nBsConstrutor *bs_construtor_de(BsFatiaTexto v)\n{\n    BsConstrutor *c = bs_construtor_crescer(NULL, v.len * 2);\n    return bs_construtor_anexar(c, v.dados, v.len);\n}\n\nsds bs_construtor_texto(const BsConstrutor *c)\n{\n    return c && c->len > 0 ? sdsnewlen(c->dados, (size_t)c->len) : sdsempty();\n}\n\nvoid bs_construtor_liberar(BsConstrutor *c)\n{\n    if (!c)\n        return;\n#ifdef BASALTO_GC\n    bs_gc_free(c->dados);\n#else\n    free(c->dados);\n#endif\n    STBDS_FREE(NULL, c);\n}\n\n// Numbers are formatted straight into the free tail (see NUMBER FORMATTING)\nBsConstrutor *bs_construtor_anexar_inteiro(BsConstrutor *c, long long x)\n{\n    if (!c || c->cap - c->len < 21)\n        c = bs_construtor_crescer(c, 21);\n    c->len += bs_formatar_inteiro(c->dados + c->len, x);\n    return c;\n}\n\nBsConstrutor *bs_construtor_anexar_natural(BsConstrutor *c, unsigned long long x)\n{\n    if (!c || c->cap - c->len < 21)\n        c = bs_construtor_crescer(c, 21);\n    c->len += bs_formatar_natural(c->dados + c->len, x);\n    return c;\n}\n\nBsConstrutor *bs_construtor_anexar_real(BsConstrutor *c, double x)\n{\n    char buf[BS_NUMERO_MAX];\n    int n = bs_formatar_real(buf, x);\n    return bs_construtor_anexar(c, buf, n);\n}\n\n// printf straight into the free tail, growing once if it does not fit\nstatic BsConstrutor *construtor_printf(BsConstrutor *c, const char *fmt, ...)\n{\n    if (!c || c->cap - c->len < 32)\n        c = bs_construtor_crescer(c, 32);\n    for (;;)\n    {\n        long long livre = c->cap - c->len;\n        va_list args;\n        va_start(args, fmt);\n        int n = vsnprintf(c->dados + c->len, (size_t)livre, fmt, args);\n        va_end(args);\n        if (n < livre)\n        {\n            c->len += n;\n            return c;\n        }\n        c = bs_construtor_crescer(c, n + 1);\n    }\n}\n\nBsConstrutor *bs_construtor_anexar_real_ext(BsConstrutor *c, long double x) { return construtor_printf(c, \"%Lf\", x); }\n\n// --- STRING TO PRIMITIVE ---\n// Hand-rolled decimal parsing on views (no NUL terminator, no copy). Leading\n// and trailing whitespace is skipped. The outcome of the last conversion is\n// left in bs_erro_conversao (BS_CONVERSAO_*): on invalid input the value is\n// the parsed prefix (as atoi did), on overflow the nearest representable one.\n\nint bs_erro_conversao = BS_CONVERSAO_OK;\n\nstatic inline int e_espaco(char c)\n{\n    return c == ' ' || (c >= '\\t' && c <= '\\r');\n}\n\nstatic inline int e_digito(char c)\n{\n    return (unsigned char)(c - '0') < 10;\n}\n\n// SWAR: are the 8 bytes in 'v' all ASCII digits?\nstatic inline int oito_digitos(uint64_t v)\n{\n    return (((v & 0xF0F0F0F0F0F0F0F0ull) | (((v + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) ==\n            0x3333333333333333ull);\n}\n\n// SWAR: value of 8 ASCII digits (little-endian load), three multiplies\nstatic inline uint32_t valor_oito_digitos(uint64_t v)\n{\n    v -= 0x3030303030303030ull;\n    v = (v * 10) + (v >> 8);\n    v = (((v & 0x000000FF000000FFull) * (100 + (1000000ull << 32))) +\n         (((v >> 16) & 0x000000FF000000FFull) * (1 + (10000ull << 32)))) >> 32;\n    return (uint32_t)v;\n}\n\n// Accumulates the digits at *p into *x (8 at a time while it can); returns\n// how many were read. *estouro is set once *x no longer fits 64 bits.\nstatic long long ler_digitos(const char **p, const char *fim, unsigned long long *x, int *estouro)\n{\n    const char *inicio = *p;\n    const char *q = *p;\n#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__\n    while (fim - q >= 8)\n    {\n        uint64_t v;\n        memcpy(&v, q, 8);\n        if (!oito_digitos(v))\n            break;\n        uint32_t d = valor_oito_digitos(v);\n        if (*x > (ULLONG_MAX - d) / 100000000ull)\n            *estouro = 1;\n        else\n            *x = *x * 100000000ull + d;\n        q += 8;\n    }\n#endif\n    while (q < fim && e_digito(*q))\n    {\n        unsigned d = (unsigned)(*q - '0');\n        if (*x > (ULLONG_MAX - d) / 10)\n            *estouro = 1;\n        else\n            *x = *x * 10 + d;\n        q++;\n    }\n    *p = q;\n    return q - inicio;\n}\n\nlong long bs_texto_para_inteiro(BsFatiaTexto v, long long min, long long max)\n{\n    const char *p = v.dados;\n    const char *fim = v.dados + v.len;\n    while (p < fim && e_espaco(*p))\n        p++;\n    int negativo = 0;\n    if (p < fim && (*p == '-' || *p == '+'))\n        negativo = *p++ == '-';\n\n    unsigned long long x = 0;\n    int estouro = 0;\n    long long digitos = ler_digitos(&p, fim, &x, &estouro);\n    while (p < fim && e_espaco(*p))\n        p++;\n    bs_erro_conversao = (digitos == 0 || p != fim) ? BS_CONVERSAO_INVALIDO : BS_CONVERSAO_OK;\n\n    // Range check in unsigned: |min| does not fit a long long when min is INT64_MIN\n    unsigned long long limite = negativo ? (unsigned long long)(-(min + 1)) + 1 : (unsigned long long)max;\n    if (estouro || x > limite)\n    {\n        bs_erro_conversao = BS_CONVERSAO_ESTOURO;\n        return negativo ? min : max;\n    }\n    return negativo ? (long long)(0ull - x) : (long long)x;\n}\n\n// A plain decimal [sign] digits [. digits] [e [sign] digits] read into an integer\n// mantissa and a power of ten. 'exato' is 0 once the mantissa overflows 64 bits.\ntypedef struct\n{\n    unsigned long long mantissa;\n    long long expoente;\n    int negativo;\n    int exato;\n} Decimal;\n\nstatic int ler_decimal(const char *p, const char *fim, Decimal *d)\n{\n    d->mantissa = 0;\n    d->expoente = 0;\n    d->negativo = 0;\n    d->exato = 1;\n    if (p < fim && (*p == '-' || *p == '+'))\n        d->negativo = *p++ == '-';\n\n    int estouro = 0;\n    long long inteiros = ler_digitos(&p, fim, &d->mantissa, &estouro);\n    long long fracao = 0;\n    if (p < fim && *p == '.')\n    {\n        p++;\n        fracao = ler_digitos(&p, fim, &d->mantissa, &estouro);\n    }\n    if (inteiros + fracao == 0)\n        return 0;\n    d->expoente = -fracao;\n    if (p < fim && (*p == 'e' || *p == 'E'))\n    {\n        p++;\n        int negativo = 0;\n        if (p < fim && (*p == '-' || *p == '+'))\n            negativo = *p++ == '-';\n        unsigned long long e = 0;\n        int grande = 0;\n        if (ler_digitos(&p, fim, &e, &grande) == 0)\n            return 0;\n        if (grande || e > 100000)\n            d->exato = 0;\n        else\n            d->expoente += negativo ? -(long long)e : (long long)e;\n    }\n    if (estouro)\n        d->exato = 0;\n    return p == fim;\n}\n\nstatic const double potencias_dez[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,\n                                       1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};\n\n// Everything off the fast path: strtod/strtold on a NUL-terminated copy\nstatic long double real_lento(const char *p, long long n, int estendido)\n{\n    char pilha[128];\n    char *buf = n < (long long)sizeof(pilha) ? pilha : malloc((size_t)n + 1);\n    memcpy(buf, p, (size_t)n);\n    buf[n] = '\\0';\n    char *fim;\n    errno = 0;\n    long double r = estendido ? strtold(buf, &fim) : (long double)strtod(buf, &fim);\n    if (fim == buf || *fim != '\\0')\n        bs_erro_conversao = BS_CONVERSAO_INVALIDO;\n    else if (errno == ERANGE && isinf(r))\n        bs_erro_conversao = BS_CONVERSAO_ESTOURO;\n    else\n        bs_erro_conversao = BS_CONVERSAO_OK;\n    if (buf != pilha)\n        free(buf);\n    return r;\n}\n\nstatic long double texto_para_real(BsFatiaTexto v, int estendido)\n{\n    const char *p = v.dados;\n    const char *fim = v.dados + v.len;\n    while (p < fim && e_espaco(*p))\n        p++;\n    while (fim > p && e_espaco(fim[-1]))\n        fim--;\n\n    // Clinger's fast path: a mantissa below 2^53 times an exact power of ten\n    // (<= 10^22) is one correctly rounded multiply or divide\n    Decimal d;\n    if (!estendido && ler_decimal(p, fim, &d) && d.exato && d.mantissa <= (1ull << 53) &&\n        d.expoente >= -22 && d.expoente <= 22)\n    {\n        double m = (double)d.mantissa;\n        double r = d.expoente < 0 ? m / potencias_dez[-d.expoente] : m * potencias_dez[d.expoente];\n        bs_erro_conversao = BS_CONVERSAO_OK;\n        return d.negativo ? -r : r;\n    }\n    return real_lento(p, fim - p, estendido);\n}\n\ndouble bs_texto_para_real(BsFatiaTexto v) { return (double)texto_para_real(v, 0); }\nlong double bs_texto_para_real_ext(BsFatiaTexto v) { return texto_para_real(v, 1); }\n\nfloat bs_texto_real32(BsFatiaTexto v)\n{\n    double r = bs_texto_para_real(v);\n    if (bs_erro_conversao == BS_CONVERSAO_OK && isfinite(r) && fabs(r) > FLT_MAX)\n        bs_erro_conversao = BS_CONVERSAO_ESTOURO;\n    return (float)r;\n}\n\n// C strings (FFI and older generated code)\nstatic BsFatiaTexto fatia_c(const char *s)\n{\n    BsFatiaTexto v = { s ? s : \"\", s ? (long long)strlen(s) : 0 };\n    return v;\n}\n\nsigned char string_to_int8(char *s) { return bs_texto_inteiro8(fatia_c(s)); }\nshort string_to_int16(char *s) { return bs_texto_inteiro16(fatia_c(s)); }\nint string_to_int32(char *s) { return bs_texto_inteiro32(fatia_c(s)); }\nlong long string_to_int64(char *s) { return bs_texto_inteiro64(fatia_c(s)); }\nlong string_to_int_arq(char *s) { return bs_texto_inteiro_arq(fatia_c(s)); }\nfloat string_to_real32(char *s) { return bs_texto_real32(fatia_c(s)); }\ndouble string_to_real64(char *s) { return bs_texto_para_real(fatia_c(s)); }\nlong double string_to_real_ext(char *s) { return bs_texto_para_real_ext(fatia_c(s)); }\n\n// --- BULK PARSING ---\n// One call per buffer or array; bs_erro_conversao keeps the first error.\n\nstatic long long inteiro64_de(BsFatiaTexto v) { return bs_texto_para_inteiro(v, INT64_MIN, INT64_MAX); }\n\n// Next piece of 'v' up to 'sep' (a trailing empty piece, as after a final newline, is not one)\nstatic int proxima_peca(BsFatiaTexto *v, BsFatiaTexto sep, BsFatiaTexto *peca)\n{\n    if (v->len == 0)\n        return 0;\n    long long i = sep.len ? bs_texto_encontrar(*v, sep) : -1;\n    *peca = i < 0 ? *v : bs_texto_sub(*v, 0, i);\n    *v = i < 0 ? bs_texto_sub(*v, v->len, v->len) : bs_texto_sub(*v, i + sep.len, v->len);\n    return 1;\n}\n\n// Parses every element into a new stb_ds array of 'tipo'\n#define ANALISAR_TODOS(nome, tipo, param, n, elemento, converter) \\\n    tipo *nome(param) \\\n    { \\\n        tipo *r = NULL; \\\n        int erro = BS_CONVERSAO_OK; \\\n        arrsetlen(r, (n)); \\\n        for (long long i = 0; i < (long long)(n); i++) \\\n        { \\\n            r[i] = converter(elemento); \\\n            if (erro == BS_CONVERSAO_OK) \\\n                erro = bs_erro_conversao; \\\n        } \\\n        bs_erro_conversao = erro; \\\n        return r; \\\n    }\n\nANALISAR_TODOS(bs_array_texto_inteiros, long long, char **xs, arrlen(xs), bs_fatia_texto_de(xs[i]), inteiro64_de)\nANALISAR_TODOS(bs_array_texto_reais, double, char **xs, arrlen(xs), bs_fatia_texto_de(xs[i]), bs_texto_para_real)\nANALISAR_TODOS(bs_array_fatia_texto_inteiros, long long, BsFatiaTexto *xs, arrlen(xs), xs[i], inteiro64_de)\nANALISAR_TODOS(bs_array_fatia_texto_reais, double, BsFatiaTexto *xs, arrlen(xs), xs[i], bs_texto_para_real)\nANALISAR_TODOS(bs_textos_inteiros, long long, const BsTextos *t, bs_textos_len(t), bs_textos_em(t, i), inteiro64_de)\nANALISAR_TODOS(bs_textos_reais, double, const BsTextos *t, bs_textos_len(t), bs_textos_em(t, i), bs_texto_para_real)\n\nlong long *bs_texto_inteiros(BsFatiaTexto v, BsFatiaTexto sep)\n{\n    long long *r = NULL;\n    int erro = BS_CONVERSAO_OK;\n    BsFatiaTexto peca;\n    while (proxima_peca(&v, sep, &peca))\n    {\n        arrput(r, inteiro64_de(peca));\n        if (erro == BS_CONVERSAO_OK)\n            erro = bs_erro_conversao;\n    }\n    bs_erro_conversao = erro;\n    return r;\n}\n\ndouble *bs_texto_reais(BsFatiaTexto v, BsFatiaTexto sep)\n{\n    double *r = NULL;\n    int erro = BS_CONVERSAO_OK;\n    BsFatiaTexto peca;\n    while (proxima_peca(&v, sep, &peca))\n    {\n        arrput(r, bs_texto_para_real(peca));\n        if (erro == BS_CONVERSAO_OK)\n            erro = bs_erro_conversao;\n    }\n    bs_erro_conversao = erro;\n    return r;\n}\n\n// --- INPUT HELPERS ---\n// ler() reads stdin through one 64 KiB block buffer filled with read(2):\n// tokens and lines are parsed straight out of it, and the unread tail moves\n// to the front before each refill so a token never straddles two reads.\n// stdout is flushed before blocking, so prompts without '\\n' still show up.\n\n#define ENTRADA_BLOCO (1 << 16)\n\nstatic char entrada[ENTRADA_BLOCO];\nstatic size_t entrada_inicio = 0; // Next unread byte\nstatic size_t entrada_fim = 0;    // End of the buffered bytes\nstatic int entrada_eof = 0;\n\n// Reads more input behind the unread bytes; 0 at EOF (or when the buffer is full)\nstatic int entrada_encher(void)\n{\n    if (entrada_eof)\n        return 0;\n    if (entrada_inicio > 0)\n    {\n        memmove(entrada, entrada + entrada_inicio, entrada_fim - entrada_inicio);\n        entrada_fim -= entrada_inicio;\n        entrada_inicio = 0;\n    }\n    if (entrada_fim == sizeof(entrada))\n        return 0;\n    fflush(stdout);\n    ssize_t n;\n    do\n        n = read(STDIN_FILENO, entrada + entrada_fim, sizeof(entrada) - entrada_fim);\n    while (n < 0 && errno == EINTR);\n    if (n <= 0)\n    {\n        entrada_eof = 1;\n        return 0;\n    }\n    entrada_fim += (size_t)n;\n    return 1;\n}\n\n// Next whitespace-separated token, as a view valid until the next read (empty at EOF)\nstatic BsFatiaTexto entrada_token(void)\n{\n    for (;;)\n    {\n        while (entrada_inicio < entrada_fim && e_espaco(entrada[entrada_inicio]))\n            entrada_inicio++;\n        if (entrada_inicio < entrada_fim || !entrada_encher())\n            break;\n    }\n    size_t i = entrada_inicio;\n    for (;;)\n    {\n        while (i < entrada_fim && !e_espaco(entrada[i]))\n            i++;\n        if (i < entrada_fim)\n            break;\n        size_t lidos = i - entrada_inicio;\n        if (!entrada_encher())\n            break;\n        i = entrada_inicio + lidos;\n    }\n    BsFatiaTexto token = { entrada + entrada_inicio, (long long)(i - entrada_inicio) };\n    entrada_inicio = i;\n    return token;\n}\n\n// Next line without its '\\n' appended to 's'; 0 at EOF with nothing read\nstatic int entrada_linha(sds *s)\n{\n    if (entrada_inicio == entrada_fim && !entrada_encher())\n        return 0;\n    for (;;)\n    {\n        char *nl = memchr(entrada + entrada_inicio, '\\n', entrada_fim - entrada_inicio);\n        size_t fim = nl ? (size_t)(nl - entrada) : entrada_fim;\n        *s = sdscatlen(*s, entrada + entrada_inicio, fim - entrada_inicio);\n        entrada_inicio = fim;\n        if (nl)\n        {\n            entrada_inicio++;\n            return 1;\n        }\n        if (!entrada_encher())\n            return 1;\n    }\n}\n\nvoid flush_input()\n{\n    for (;;)\n    {\n        char *nl = memchr(entrada + entrada_inicio, '\\n', entrada_fim - entrada_inicio);\n        if (nl)\n        {\n            entrada_inicio = (size_t)(nl - entrada) + 1;\n            return;\n        }\n        entrada_inicio = entrada_fim;\n        if (!entrada_encher())\n            return;\n    }\n}\n\n// A number per line, as with scanf + flush_input: the rest of the line is dropped\nint read_int()\n{\n    int x = bs_texto_inteiro32(entrada_token());\n    flush_input();\n    return x;\n}\n\nlong long read_long()\n{\n    long long x = bs_texto_inteiro64(entrada_token());\n    flush_input();\n    return x;\n}\n\nfloat read_float()\n{\n    float x = bs_texto_real32(entrada_token());\n    flush_input();\n    return x;\n}\n\ndouble read_double()\n{\n    double x = bs_texto_para_real(entrada_token());\n    flush_input();\n    return x;\n}\n\nchar *read_string()\n{\n    sds s = sdsempty();\n    entrada_linha(&s);\n    return s;\n}\n\nvoid wait_enter()\n{\n    flush_input();\n}\n\n// ler_inteiros(n) / ler_reais(n): the next n tokens (n < 0: up to EOF), fewer at EOF\nlong long *bs_ler_inteiros(long long n)\n{\n    long long *r = NULL;\n    int erro = BS_CONVERSAO_OK;\n    if (n > 0)\n        arrsetcap(r, n);\n    for (long long i = 0; n < 0 || i < n; i++)\n    {\n        BsFatiaTexto token = entrada_token();\n        if (token.len == 0)\n            break;\n        arrput(r, bs_texto_inteiro64(token));\n        if (erro == BS_CONVERSAO_OK)\n            erro = bs_erro_conversao;\n    }\n    bs_erro_conversao = erro;\n    return r;\n}\n\ndouble *bs_ler_reais(long long n)\n{\n    double *r = NULL;\n    int erro = BS_CONVERSAO_OK;\n    if (n > 0)\n        arrsetcap(r, n);\n    for (long long i = 0; n < 0 || i < n; i++)\n    {\n        BsFatiaTexto token = entrada_token();\n        if (token.len == 0)\n            break;\n        arrput(r, bs_texto_para_real(token));\n        if (erro == BS_CONVERSAO_OK)\n            erro = bs_erro_conversao;\n    }\n    bs_erro_conversao = erro;\n    return r;\n}\n\n// ler_linhas(): every remaining line\nchar **bs_ler_linhas(void)\n{\n    char **linhas = NULL;\n    for (;;)\n    {\n        sds s = sdsempty();\n        if (!entrada_linha(&s))\n        {\n            sdsfree(s);\n            return linhas;\n        }\n        arrput(linhas, s);\n    }\n}\n\n// --- MATH IMPLEMENTATION ---\ndouble bs_sin(double x) { return sin(x); }\ndouble bs_cos(double x) { return cos(x); }\ndouble bs_tan(double x) { return tan(x); }\ndouble bs_asin(double x) { return asin(x); }\ndouble bs_acos(double x) { return acos(x); }\ndouble bs_atan(double x) { return atan(x); }\ndouble bs_sqrt(double x) { return sqrt(x); }\ndouble bs_pow(double b, double e) { return pow(b, e); }\ndouble bs_log(double x) { return log(x); }\ndouble bs_exp(double x) { return exp(x); }\ndouble bs_floor(double x) { return floor(x); }\ndouble bs_ceil(double x) { return ceil(x); }\ndouble bs_round(double x) { return round(x); }\ndouble bs_abs(double x) { return fabs(x); }";
 
-const char *SRC_SDS_H = "/* SDSLib 2.0 -- A C dynamic strings library\n *\n * Copyright (c) 2006-2015, Salvatore Sanfilippo <antirez at gmail dot com>\n * Copyright (c) 2015, Oran Agra\n * Copyright (c) 2015, Redis Labs, Inc\n * All rights reserved.\n *\n * Redistribution and use in source and binary forms, with or without\n * modification, are permitted provided that the following conditions are met:\n *\n *   * Redistributions of source code must retain the above copyright notice,\n *     this list of conditions and the following disclaimer.\n *   * Redistributions in binary form must reproduce the above copyright\n *     notice, this list of conditions and the following disclaimer in the\n *     documentation and/or other materials provided with the distribution.\n *   * Neither the name of Redis nor the names of its contributors may be used\n *     to endorse or promote products derived from this software without\n *     specific prior written permission.\n *\n * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS \"AS IS\"\n * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE\n * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE\n * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE\n * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR\n * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF\n * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS\n * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)\n * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE\n * POSSIBILITY OF SUCH DAMAGE.\n */\n\n#ifndef __SDS_H\n#define __SDS_H\n\n#define SDS_MAX_PREALLOC (1024*1024)\nextern const char *SDS_NOINIT;\n\n#include <sys/types.h>\n#include <stdarg.h>\n#include <stdint.h>\n\ntypedef char *sds;\n\n/* Note: sdshdr5 is never used, we just access the flags byte directly.\n * However is here to document the layout of type 5 SDS strings. */\nstruct __attribute__ ((__packed__)) sdshdr5 {\n    unsigned char flags; /* 3 lsb of type, and 5 msb of string length */\n    char buf[];\n};\nstruct __attribute__ ((__packed__)) sdshdr8 {\n    uint8_t len; /* used */\n    uint8_t alloc; /* excluding the header and null terminator */\n    unsigned char flags; /* 3 lsb of type, 5 unused bits */\n    char buf[];\n};\nstruct __attribute__ ((__packed__)) sdshdr16 {\n    uint16_t len; /* used */\n    uint16_t alloc; /* excluding the header and null terminator */\n    unsigned char flags; /* 3 lsb of type, 5 unused bits */\n    char buf[];\n};\nstruct __attribute__ ((__packed__)) sdshdr32 {\n    uint32_t len; /* used */\n    uint32_t alloc; /* excluding the header and null terminator */\n    unsigned char flags; /* 3 lsb of type, 5 unused bits */\n    char buf[];\n};\nstruct __attribute__ ((__packed__)) sdshdr64 {\n    uint64_t len; /* used */\n    uint64_t alloc; /* excluding the header and null terminator */\n    unsigned char flags; /* 3 lsb of type, 5 unused bits */\n    char buf[];\n};\n\n#define SDS_TYPE_5  0\n#define SDS_TYPE_8  1\n#define SDS_TYPE_16 2\n#define SDS_TYPE_32 3\n#define SDS_TYPE_64 4\n#define SDS_TYPE_MASK 7\n#define SDS_TYPE_BITS 3\n#define SDS_HDR_VAR(T,s) struct sdshdr##T *sh = (void*)((s)-(sizeof(struct sdshdr##T)));\n#define SDS_HDR(T,s) ((struct sdshdr##T *)((s)-(sizeof(struct sdshdr##T))))\n#define SDS_TYPE_5_LEN(f) ((f)>>SDS_TYPE_BITS)\n\nstatic inline size_t sdslen(const sds s) {\n    unsigned char flags = s[-1];\n    switch(flags&SDS_TYPE_MASK) {\n        case SDS_TYPE_5:\n            return SDS_TYPE_5_LEN(flags);\n        case SDS_TYPE_8:\n            return SDS_HDR(8,s)->len;\n        case SDS_TYPE_16:\n            return SDS_HDR(16,s)->len;\n        case SDS_TYPE_32:\n            return SDS_HDR(32,s)->len;\n        case SDS_TYPE_64:\n            return SDS_HDR(64,s)->len;\n    }\n    return 0;\n}\n\nstatic inline size_t sdsavail(const sds s) {\n    unsigned char flags = s[-1];\n    switch(flags&SDS_TYPE_MASK) {\n        case SDS_TYPE_5: {\n            return 0;\n        }\n        case SDS_TYPE_8: {\n            SDS_HDR_VAR(8,s);\n            return sh->alloc - sh->len;\n        }\n        case SDS_TYPE_16: {\n            SDS_HDR_VAR(16,s);\n            return sh->alloc - sh->len;\n        }\n        case SDS_TYPE_32: {\n            SDS_HDR_VAR(32,s);\n            return sh->alloc - sh->len;\n        }\n        case SDS_TYPE_64: {\n            SDS_HDR_VAR(64,s);\n            return sh->alloc - sh->len;\n        }\n    }\n    return 0;\n}\n\nstatic inline void sdssetlen(sds s, size_t newlen) {\n    unsigned char flags = s[-1];\n    switch(flags&SDS_TYPE_MASK) {\n        case SDS_TYPE_5:\n            {\n                unsigned char *fp = ((unsigned char*)s)-1;\n                *fp = SDS_TYPE_5 | (newlen << SDS_TYPE_BITS);\n            }\n            break;\n        case SDS_TYPE_8:\n            SDS_HDR(8,s)->len = newlen;\n            break;\n        case SDS_TYPE_16:\n            SDS_HDR(16,s)->len = newlen;\n            break;\n        case SDS_TYPE_32:\n            SDS_HDR(32,s)->len = newlen;\n            break;\n        case SDS_TYPE_64:\n            SDS_HDR(64,s)->len = newlen;\n            break;\n    }\n}\n\nstatic inline void sdsinclen(sds s, size_t inc) {\n    unsigned char flags = s[-1];\n    switch(flags&SDS_TYPE_MASK) {\n        case SDS_TYPE_5:\n            {\n                unsigned char *fp = ((unsigned char*)s)-1;\n                unsigned char newlen = SDS_TYPE_5_LEN(flags)+inc;\n                *fp = SDS_TYPE_5 | (newlen << SDS_TYPE_BITS);\n            }\n            break;\n        case SDS_TYPE_8:\n            SDS_HDR(8,s)->len += inc;\n            break;\n        case SDS_TYPE_16:\n            SDS_HDR(16,s)->len += inc;\n            break;\n        case SDS_TYPE_32:\n            SDS_HDR(32,s)->len += inc;\n            break;\n        case SDS_TYPE_64:\n            SDS_HDR(64,s)->len += inc;\n            break;\n    }\n}\n\n/* sdsalloc() = sdsavail() + sdslen() */\nstatic inline size_t sdsalloc(const sds s) {\n    unsigned char flags = s[-1];\n    switch(flags&SDS_TYPE_MASK) {\n        case SDS_TYPE_5:\n            return SDS_TYPE_5_LEN(flags);\n        case SDS_TYPE_8:\n            return SDS_HDR(8,s)->alloc;\n        case SDS_TYPE_16:\n            return SDS_HDR(16,s)->alloc;\n        case SDS_TYPE_32:\n            return SDS_HDR(32,s)->alloc;\n        case SDS_TYPE_64:\n            return SDS_HDR(64,s)->alloc;\n    }\n    return 0;\n}\n\nstatic inline void sdssetalloc(sds s, size_t newlen) {\n    unsigned char flags = s[-1];\n    switch(flags&SDS_TYPE_MASK) {\n        case SDS_TYPE_5:\n            /* Nothing to do, this type has no total allocation info. */\n            break;\n        case SDS_TYPE_8:\n            SDS_HDR(8,s)->alloc = newlen;\n            break;\n        case SDS_TYPE_16:\n            SDS_HDR(16,s)->alloc = newlen;\n            break;\n        case SDS_TYPE_32:\n            SDS_HDR(32,s)->alloc = newlen;\n            break;\n        case SDS_TYPE_64:\n            SDS_HDR(64,s)->alloc = newlen;\n            break;\n    }\n}\n\nsds sdsnewlen(const void *init, size_t initlen);\nsds sdsnew(const char *init);\nsds sdsempty(void);\nsds sdsdup(const sds s);\nvoid sdsfree(sds s);\nsds sdsgrowzero(sds s, size_t len);\nsds sdscatlen(sds s, const void *t, size_t len);\nsds sdscat(sds s, const char *t);\nsds sdscatsds(sds s, const sds t);\nsds sdscpylen(sds s, const char *t, size_t len);\nsds sdscpy(sds s, const char *t);\n\nsds sdscatvprintf(sds s, const char *fmt, va_list ap);\n#ifdef __GNUC__\nsds sdscatprintf(sds s, const char *fmt, ...)\n    __attribute__((format(printf, 2, 3)));\n#else\nsds sdscatprintf(sds s, const char *fmt, ...);\n#endif\n\nsds sdscatfmt(sds s, char const *fmt, ...);\nsds sdstrim(sds s, const char *cset);\nvoid sdsrange(sds s, ssize_t start, ssize_t end);\nvoid sdsupdatelen(sds s);\nvoid sdsclear(sds s);\nint sdscmp(const sds s1, const sds s2);\nsds *sdssplitlen(const char *s, ssize_t len, const char *sep, int seplen, int *count);\nvoid sdsfreesplitres(sds *tokens, int count);\nvoid sdstolower(sds s);\nvoid sdstoupper(sds s);\nsds sdsfromlonglong(long long value);\nsds sdscatrepr(sds s, const char *p, size_t len);\nsds *sdssplitargs(const char *line, int *argc);\nsds sdsmapchars(sds s, const char *from, const char *to, size_t setlen);\nsds sdsjoin(char **argv, int argc, char *sep);\nsds sdsjoinsds(sds *argv, int argc, const char *sep, size_t seplen);\n\n/* Low level functions exposed to the user API */\nsds sdsMakeRoomFor(sds s, size_t addlen);\nvoid sdsIncrLen(sds s, ssize_t incr);\nsds sdsRemoveFreeSpace(sds s);\nsize_t sdsAllocSize(sds s);\nvoid *sdsAllocPtr(sds s);\n\n/* Export the allocator used by SDS to the program using SDS.\n * Sometimes the program SDS is linked to, may use a different set of\n * allocators, but may want to allocate or free things that SDS will\n * respectively free or allocate. */\nvoid *sds_malloc(size_t size);\nvoid *sds_realloc(void *ptr, size_t size);\nvoid sds_free(void *ptr);\n\n#ifdef REDIS_TEST\nint sdsTest(int argc, char *argv[]);\n#endif\n\n#endif\n";
+const char *SRC_GC_C = "#include <stdio.h>\n#include <stdlib.h>\n#include <string.h>\n#include <stdint.h>\n#include <setjmp.h>\n#include <time.h>\n\n#include \"basalto.h\"\n\n// --- TRACING GARBAGE COLLECTOR (--gc) ---\n// Mark-sweep collector used when a program is compiled with `basalto --gc`.\n// - 'nova' objects carry a layout emitted by codegen, so only their pointer\n//   fields (structs, arrays, texto) are traced.\n// - stb_ds buffers are scanned conservatively (element types are unknown here).\n// - sds buffers are leaves: they never hold pointers.\n// - Roots come from a conservative scan of the C stack and the registers.\n\ntypedef struct GcObject\n{\n    struct GcObject *next;\n    struct GcObject *prev;\n    const BsGcLayout *layout; // NULL = scan every word, &bs_gc_leaf = never scan\n    size_t size;\n    void *block; // Start of the underlying allocation (differs for over-aligned objects)\n    int marked;\n} GcObject;\n\n// Payloads keep malloc's alignment guarantees\n#define GC_HEADER_SIZE ((sizeof(GcObject) + 15) & ~(size_t)15)\n#define GC_PAYLOAD(obj) ((void *)((char *)(obj) + GC_HEADER_SIZE))\n#define GC_OBJECT(ptr) ((GcObject *)((char *)(ptr) - GC_HEADER_SIZE))\n\nconst BsGcLayout bs_gc_leaf = {\"leaf\", 0, NULL};\n\nstatic GcObject *gc_objects = NULL;\nstatic void *gc_stack_bottom = NULL;\nstatic void *gc_pinned = NULL; // Buffer being resized, kept alive during a collection\n\n// Heap accounting & triggers\nstatic size_t gc_live_bytes = 0;       // Bytes owned by the collector right now\nstatic size_t gc_since_collect = 0;    // Bytes allocated since the last cycle\nstatic size_t gc_threshold = 0;        // Next cycle starts past this many new bytes\nstatic size_t gc_heap_min = 8u << 20;  // BASALTO_GC_HEAP_MIN (bytes)\nstatic size_t gc_growth = 100;         // BASALTO_GC_GROWTH (% of live heap)\n\n// Pause-time statistics (BASALTO_GC_STATS=1 prints them at exit)\nstatic size_t gc_cycles = 0;\nstatic size_t gc_freed_bytes = 0;\nstatic double gc_pause_total_ms = 0.0;\nstatic double gc_pause_max_ms = 0.0;\n\n// Sorted view of the heap, rebuilt at each cycle to resolve interior pointers\nstatic GcObject **gc_index = NULL;\nstatic size_t gc_index_len = 0;\n\n// Explicit mark stack (avoids recursion on long linked lists)\nstatic GcObject **gc_mark_stack = NULL;\nstatic size_t gc_mark_len = 0;\nstatic size_t gc_mark_cap = 0;\n\nstatic void gc_report(void)\n{\n    fprintf(stderr, \"[Basalto GC] ciclos: %zu | pausa total: %.3f ms | pausa max: %.3f ms | vivo: %zu bytes | liberado: %zu bytes\\n\",\n            gc_cycles, gc_pause_total_ms, gc_pause_max_ms, gc_live_bytes, gc_freed_bytes);\n}\n\nstatic size_t gc_env_size(const char *name, size_t fallback)\n{\n    const char *value = getenv(name);\n    if (!value || !*value)\n        return fallback;\n    return (size_t)strtoull(value, NULL, 10);\n}\n\nvoid bs_gc_init(void *stack_bottom)\n{\n    gc_stack_bottom = stack_bottom;\n    gc_heap_min = gc_env_size(\"BASALTO_GC_HEAP_MIN\", gc_heap_min);\n    gc_growth = gc_env_size(\"BASALTO_GC_GROWTH\", gc_growth);\n    gc_threshold = gc_heap_min;\n\n    const char *stats = getenv(\"BASALTO_GC_STATS\");\n    if (stats && *stats && strcmp(stats, \"0\") != 0)\n        atexit(gc_report);\n}\n\n// --- MARK PHASE ---\n\nstatic int gc_compare_objects(const void *a, const void *b)\n{\n    uintptr_t x = (uintptr_t) * (GcObject *const *)a;\n    uintptr_t y = (uintptr_t) * (GcObject *const *)b;\n    return (x > y) - (x < y);\n}\n\nstatic void gc_build_index(void)\n{\n    size_t count = 0;\n    for (GcObject *obj = gc_objects; obj; obj = obj->next)\n        count++;\n\n    free(gc_index);\n    gc_index = malloc(count * sizeof(GcObject *) + 1);\n    if (!gc_index)\n    {\n        fprintf(stderr, \"[Basalto] Out of memory (gc index)!\\n\");\n        exit(1);\n    }\n    gc_index_len = 0;\n    for (GcObject *obj = gc_objects; obj; obj = obj->next)\n        gc_index[gc_index_len++] = obj;\n    qsort(gc_index, gc_index_len, sizeof(GcObject *), gc_compare_objects);\n}\n\n// Find the object whose payload contains 'ptr' (interior pointers included)\nstatic GcObject *gc_find(const void *ptr)\n{\n    uintptr_t p = (uintptr_t)ptr;\n    size_t lo = 0, hi = gc_index_len;\n    while (lo < hi)\n    {\n        size_t mid = lo + (hi - lo) / 2;\n        if ((uintptr_t)GC_PAYLOAD(gc_index[mid]) <= p)\n            lo = mid + 1;\n        else\n            hi = mid;\n    }\n    if (lo == 0)\n        return NULL;\n\n    GcObject *obj = gc_index[lo - 1];\n    uintptr_t start = (uintptr_t)GC_PAYLOAD(obj);\n    if (p < start + obj->size)\n        return obj;\n    return NULL;\n}\n\nstatic void gc_mark_value(const void *ptr)\n{\n    if (!ptr)\n        return;\n    GcObject *obj = gc_find(ptr);\n    if (!obj || obj->marked)\n        return;\n\n    obj->marked = 1;\n    if (obj->layout == &bs_gc_leaf)\n        return;\n\n    if (gc_mark_len == gc_mark_cap)\n    {\n        gc_mark_cap = gc_mark_cap ? gc_mark_cap * 2 : 256;\n        gc_mark_stack = realloc(gc_mark_stack, gc_mark_cap * sizeof(GcObject *));\n        if (!gc_mark_stack)\n        {\n            fprintf(stderr, \"[Basalto] Out of memory (gc mark stack)!\\n\");\n            exit(1);\n        }\n    }\n    gc_mark_stack[gc_mark_len++] = obj;\n}\n\nstatic void gc_scan_range(const void *from, const void *to)\n{\n    uintptr_t lo = (uintptr_t)from & ~(uintptr_t)(sizeof(void *) - 1);\n    for (uintptr_t p = lo; p + sizeof(void *) <= (uintptr_t)to; p += sizeof(void *))\n        gc_mark_value(*(void **)p);\n}\n\nstatic void gc_drain(void)\n{\n    while (gc_mark_len > 0)\n    {\n        GcObject *obj = gc_mark_stack[--gc_mark_len];\n        char *payload = GC_PAYLOAD(obj);\n\n        if (obj->layout)\n        {\n            // Precise: only the pointer fields known by the compiler\n            for (size_t i = 0; i < obj->layout->count; i++)\n                gc_mark_value(*(void **)(payload + obj->layout->offsets[i]));\n        }\n        else\n        {\n            gc_scan_range(payload, payload + obj->size);\n        }\n    }\n}\n\nstatic void __attribute__((noinline)) gc_mark_roots(void)\n{\n    // Spill callee-saved registers onto the stack so the scan sees them\n    jmp_buf regs;\n    setjmp(regs);\n\n    volatile char marker = 0;\n    const void *top = (const void *)&marker;\n    if ((uintptr_t)top < (uintptr_t)gc_stack_bottom)\n        gc_scan_range(top, gc_stack_bottom);\n    else\n        gc_scan_range(gc_stack_bottom, top);\n    gc_scan_range(&regs, (char *)&regs + sizeof(regs));\n\n    gc_mark_value(gc_pinned);\n    gc_drain();\n}\n\n// --- SWEEP PHASE ---\n\nstatic void gc_unlink(GcObject *obj)\n{\n    if (obj->prev)\n        obj->prev->next = obj->next;\n    else\n        gc_objects = obj->next;\n    if (obj->next)\n        obj->next->prev = obj->prev;\n    gc_live_bytes -= obj->size;\n}\n\nstatic void gc_sweep(void)\n{\n    GcObject *obj = gc_objects;\n    while (obj)\n    {\n        GcObject *next = obj->next;\n        if (obj->marked)\n        {\n            obj->marked = 0;\n        }\n        else\n        {\n            gc_unlink(obj);\n            gc_freed_bytes += obj->size;\n            free(obj->block);\n        }\n        obj = next;\n    }\n}\n\nvoid bs_gc_collect(void)\n{\n    if (!gc_stack_bottom)\n        return; // bs_gc_init not called (library mode): nothing is safe to free\n\n    clock_t start = clock();\n\n    gc_build_index();\n    gc_mark_roots();\n    gc_sweep();\n\n    free(gc_index);\n    gc_index = NULL;\n    gc_index_len = 0;\n\n    // Next trigger grows with the surviving heap\n    size_t next = gc_live_bytes / 100 * gc_growth;\n    gc_threshold = next > gc_heap_min ? next : gc_heap_min;\n    gc_since_collect = 0;\n\n    double pause_ms = (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC;\n    gc_cycles++;\n    gc_pause_total_ms += pause_ms;\n    if (pause_ms > gc_pause_max_ms)\n        gc_pause_max_ms = pause_ms;\n}\n\n// --- ALLOCATION ---\n\nstatic void gc_maybe_collect(size_t size)\n{\n    if (gc_since_collect + size > gc_threshold)\n        bs_gc_collect();\n}\n\nstatic GcObject *gc_new_object(size_t size, const BsGcLayout *layout, size_t align)\n{\n    void *block;\n    GcObject *obj;\n    if (align <= 16)\n    {\n        block = calloc(1, GC_HEADER_SIZE + size);\n        obj = block;\n    }\n    else\n    {\n        // @alinhado(n): pad in front of the header so the payload lands on 'align'\n        size_t front = (GC_HEADER_SIZE + align - 1) / align * align;\n        size_t total = (front + size + align - 1) / align * align;\n        block = aligned_alloc(align, total);\n        if (block)\n            memset(block, 0, total);\n        obj = (GcObject *)((char *)block + front - GC_HEADER_SIZE);\n    }\n    if (!block)\n    {\n        fprintf(stderr, \"[Basalto] Out of memory!\\n\");\n        exit(1);\n    }\n    obj->block = block;\n    obj->layout = layout;\n    obj->size = size;\n    obj->next = gc_objects;\n    if (gc_objects)\n        gc_objects->prev = obj;\n    gc_objects = obj;\n\n    gc_live_bytes += size;\n    gc_since_collect += size;\n    return obj;\n}\n\nvoid *bs_gc_alloc(size_t size, const BsGcLayout *layout)\n{\n    gc_maybe_collect(size);\n    return GC_PAYLOAD(gc_new_object(size, layout, 16));\n}\n\n// 'nova' of an @alinhado(n) struct with n > 16\nvoid *bs_gc_alloc_aligned(size_t size, size_t align, const BsGcLayout *layout)\n{\n    gc_maybe_collect(size);\n    return GC_PAYLOAD(gc_new_object(size, layout, align));\n}\n\nstatic void *gc_resize(void *ptr, size_t size, const BsGcLayout *layout)\n{\n    if (!ptr)\n        return bs_gc_alloc(size, layout);\n\n    gc_pinned = ptr;\n    gc_maybe_collect(size);\n    gc_pinned = NULL;\n\n    GcObject *old = GC_OBJECT(ptr);\n    void *fresh = GC_PAYLOAD(gc_new_object(size, old->layout, 16));\n    memcpy(fresh, ptr, old->size < size ? old->size : size);\n    bs_gc_free(ptr);\n    return fresh;\n}\n\n// stb_ds buffers: traced conservatively\nvoid *bs_gc_realloc(void *ptr, size_t size)\n{\n    return gc_resize(ptr, size, NULL);\n}\n\n// sds buffers: never contain pointers\nvoid *bs_gc_malloc_leaf(size_t size)\n{\n    return bs_gc_alloc(size, &bs_gc_leaf);\n}\n\nvoid *bs_gc_realloc_leaf(void *ptr, size_t size)\n{\n    return gc_resize(ptr, size, &bs_gc_leaf);\n}\n\nvoid bs_gc_free(void *ptr)\n{\n    if (!ptr)\n        return;\n    GcObject *obj = GC_OBJECT(ptr);\n    gc_unlink(obj);\n    free(obj->block);\n}\n";
 
-const char *SRC_SDS_C = "/* SDSLib 2.0 -- A C dynamic strings library\n *\n * Copyright (c) 2006-2015, Salvatore Sanfilippo <antirez at gmail dot com>\n * Copyright (c) 2015, Oran Agra\n * Copyright (c) 2015, Redis Labs, Inc\n * All rights reserved.\n *\n * Redistribution and use in source and binary forms, with or without\n * modification, are permitted provided that the following conditions are met:\n *\n *   * Redistributions of source code must retain the above copyright notice,\n *     this list of conditions and the following disclaimer.\n *   * Redistributions in binary form must reproduce the above copyright\n *     notice, this list of conditions and the following disclaimer in the\n *     documentation and/or other materials provided with the distribution.\n *   * Neither the name of Redis nor the names of its contributors may be used\n *     to endorse or promote products derived from this software without\n *     specific prior written permission.\n *\n * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS \"AS IS\"\n * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE\n * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE\n * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE\n * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR\n * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF\n * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS\n * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)\n * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE\n * POSSIBILITY OF SUCH DAMAGE.\n */\n\n#include <stdio.h>\n#include <stdlib.h>\n#include <string.h>\n#include <ctype.h>\n#include <assert.h>\n#include <limits.h>\n#include \"sds.h\"\n#include \"sdsalloc.h\"\n\nconst char *SDS_NOINIT = \"SDS_NOINIT\";\n\nstatic inline int sdsHdrSize(char type) {\n    switch(type&SDS_TYPE_MASK) {\n        case SDS_TYPE_5:\n            return sizeof(struct sdshdr5);\n        case SDS_TYPE_8:\n            return sizeof(struct sdshdr8);\n        case SDS_TYPE_16:\n            return sizeof(struct sdshdr16);\n        case SDS_TYPE_32:\n            return sizeof(struct sdshdr32);\n        case SDS_TYPE_64:\n            return sizeof(struct sdshdr64);\n    }\n    return 0;\n}\n\nstatic inline char sdsReqType(size_t string_size) {\n    if (string_size < 1<<5)\n        return SDS_TYPE_5;\n    if (string_size < 1<<8)\n        return SDS_TYPE_8;\n    if (string_size < 1<<16)\n        return SDS_TYPE_16;\n#if (LONG_MAX == LLONG_MAX)\n    if (string_size < 1ll<<32)\n        return SDS_TYPE_32;\n    return SDS_TYPE_64;\n#else\n    return SDS_TYPE_32;\n#endif\n}\n\n/* Create a new sds string with the content specified by the 'init' pointer\n * and 'initlen'.\n * If NULL is used for 'init' the string is initialized with zero bytes.\n * If SDS_NOINIT is used, the buffer is left uninitialized;\n *\n * The string is always null-terminated (all the sds strings are, always) so\n * even if you create an sds string with:\n *\n * mystring = sdsnewlen(\"abc\",3);\n *\n * You can print the string with printf() as there is an implicit \\0 at the\n * end of the string. However the string is binary safe and can contain\n * \\0 characters in the middle, as the length is stored in the sds header. */\nsds sdsnewlen(const void *init, size_t initlen) {\n    void *sh;\n    sds s;\n    char type = sdsReqType(initlen);\n    /* Empty strings are usually created in order to append. Use type 8\n     * since type 5 is not good at this. */\n    if (type == SDS_TYPE_5 && initlen == 0) type = SDS_TYPE_8;\n    int hdrlen = sdsHdrSize(type);\n    unsigned char *fp; /* flags pointer. */\n\n    sh = s_malloc(hdrlen+initlen+1);\n    if (sh == NULL) return NULL;\n    if (init==SDS_NOINIT)\n        init = NULL;\n    else if (!init)\n        memset(sh, 0, hdrlen+initlen+1);\n    s = (char*)sh+hdrlen;\n    fp = ((unsigned char*)s)-1;\n    switch(type) {\n        case SDS_TYPE_5: {\n            *fp = type | (initlen << SDS_TYPE_BITS);\n            break;\n        }\n        case SDS_TYPE_8: {\n            SDS_HDR_VAR(8,s);\n            sh->len = initlen;\n            sh->alloc = initlen;\n            *fp = type;\n            break;\n        }\n        case SDS_TYPE_16: {\n            SDS_HDR_VAR(16,s);\n            sh->len = initlen;\n            sh->alloc = initlen;\n            *fp = type;\n            break;\n        }\n        case SDS_TYPE_32: {\n            SDS_HDR_VAR(32,s);\n            sh->len = initlen;\n            sh->alloc = initlen;\n            *fp = type;\n            break;\n        }\n        case SDS_TYPE_64: {\n            SDS_HDR_VAR(64,s);\n            sh->len = initlen;\n            sh->alloc = initlen;\n            *fp = type;\n            break;\n        }\n    }\n    if (initlen && init)\n        memcpy(s, init, initlen);\n    s[initlen] = '\\0';\n    return s;\n}\n\n/* Create an empty (zero length) sds string. Even in this case the string\n * always has an implicit null term. */\nsds sdsempty(void) {\n    return sdsnewlen(\"\",0);\n}\n\n/* Create a new sds string starting from a null terminated C string. */\nsds sdsnew(const char *init) {\n    size_t initlen = (init == NULL) ? 0 : strlen(init);\n    return sdsnewlen(init, initlen);\n}\n\n/* Duplicate an sds string. */\nsds sdsdup(const sds s) {\n    return sdsnewlen(s, sdslen(s));\n}\n\n/* Free an sds string. No operation is performed if 's' is NULL. */\nvoid sdsfree(sds s) {\n    if (s == NULL) return;\n    s_free((char*)s-sdsHdrSize(s[-1]));\n}\n\n/* Set the sds string length to the length as obtained with strlen(), so\n * considering as content only up to the first null term character.\n *\n * This function is useful when the sds string is hacked manually in some\n * way, like in the following example:\n *\n * s = sdsnew(\"foobar\");\n * s[2] = '\\0';\n * sdsupdatelen(s);\n * printf(\"%d\\n\", sdslen(s));\n *\n * The output will be \"2\", but if we comment out the call to sdsupdatelen()\n * the output will be \"6\" as the string was modified but the logical length\n * remains 6 bytes. */\nvoid sdsupdatelen(sds s) {\n    size_t reallen = strlen(s);\n    sdssetlen(s, reallen);\n}\n\n/* Modify an sds string in-place to make it empty (zero length).\n * However all the existing buffer is not discarded but set as free space\n * so that next append operations will not require allocations up to the\n * number of bytes previously available. */\nvoid sdsclear(sds s) {\n    sdssetlen(s, 0);\n    s[0] = '\\0';\n}\n\n/* Enlarge the free space at the end of the sds string so that the caller\n * is sure that after calling this function can overwrite up to addlen\n * bytes after the end of the string, plus one more byte for nul term.\n *\n * Note: this does not change the *length* of the sds string as returned\n * by sdslen(), but only the free buffer space we have. */\nsds sdsMakeRoomFor(sds s, size_t addlen) {\n    void *sh, *newsh;\n    size_t avail = sdsavail(s);\n    size_t len, newlen, reqlen;\n    char type, oldtype = s[-1] & SDS_TYPE_MASK;\n    int hdrlen;\n\n    /* Return ASAP if there is enough space left. */\n    if (avail >= addlen) return s;\n\n    len = sdslen(s);\n    sh = (char*)s-sdsHdrSize(oldtype);\n    reqlen = newlen = (len+addlen);\n    if (newlen < SDS_MAX_PREALLOC)\n        newlen *= 2;\n    else\n        newlen += SDS_MAX_PREALLOC;\n\n    type = sdsReqType(newlen);\n\n    /* Don't use type 5: the user is appending to the string and type 5 is\n     * not able to remember empty space, so sdsMakeRoomFor() must be called\n     * at every appending operation. */\n    if (type == SDS_TYPE_5) type = SDS_TYPE_8;\n\n    hdrlen = sdsHdrSize(type);\n    assert(hdrlen + newlen + 1 > reqlen); /* Catch size_t overflow */\n    if (oldtype==type) {\n        newsh = s_realloc(sh, hdrlen+newlen+1);\n        if (newsh == NULL) return NULL;\n        s = (char*)newsh+hdrlen;\n    } else {\n        /* Since the header size changes, need to move the string forward,\n         * and can't use realloc */\n        newsh = s_malloc(hdrlen+newlen+1);\n        if (newsh == NULL) return NULL;\n        memcpy((char*)newsh+hdrlen, s, len+1);\n        s_free(sh);\n        s = (char*)newsh+hdrlen;\n        s[-1] = type;\n        sdssetlen(s, len);\n    }\n    sdssetalloc(s, newlen);\n    return s;\n}\n\n/* Reallocate the sds string so that it has no free space at the end. The\n * contained string remains not altered, but next concatenation operations\n * will require a reallocation.\n *\n * After the call, the passed sds string is no longer valid and all the\n * references must be substituted with the new pointer returned by the call. */\nsds sdsRemoveFreeSpace(sds s) {\n    void *sh, *newsh;\n    char type, oldtype = s[-1] & SDS_TYPE_MASK;\n    int hdrlen, oldhdrlen = sdsHdrSize(oldtype);\n    size_t len = sdslen(s);\n    size_t avail = sdsavail(s);\n    sh = (char*)s-oldhdrlen;\n\n    /* Return ASAP if there is no space left. */\n    if (avail == 0) return s;\n\n    /* Check what would be the minimum SDS header that is just good enough to\n     * fit this string. */\n    type = sdsReqType(len);\n    hdrlen = sdsHdrSize(type);\n\n    /* If the type is the same, or at least a large enough type is still\n     * required, we just realloc(), letting the allocator to do the copy\n     * only if really needed. Otherwise if the change is huge, we manually\n     * reallocate the string to use the different header type. */\n    if (oldtype==type || type > SDS_TYPE_8) {\n        newsh = s_realloc(sh, oldhdrlen+len+1);\n        if (newsh == NULL) return NULL;\n        s = (char*)newsh+oldhdrlen;\n    } else {\n        newsh = s_malloc(hdrlen+len+1);\n        if (newsh == NULL) return NULL;\n        memcpy((char*)newsh+hdrlen, s, len+1);\n        s_free(sh);\n        s = (char*)newsh+hdrlen;\n        s[-1] = type;\n        sdssetlen(s, len);\n    }\n    sdssetalloc(s, len);\n    return s;\n}\n\n/* Return the total size of the allocation of the specified sds string,\n * including:\n * 1) The sds header before the pointer.\n * 2) The string.\n * 3) The free buffer at the end if any.\n * 4) The implicit null term.\n */\nsize_t sdsAllocSize(sds s) {\n    size_t alloc = sdsalloc(s);\n    return sdsHdrSize(s[-1])+alloc+1;\n}\n\n/* Return the pointer of the actual SDS allocation (normally SDS strings\n * are referenced by the start of the string buffer). */\nvoid *sdsAllocPtr(sds s) {\n    return (void*) (s-sdsHdrSize(s[-1]));\n}\n\n/* Increment the sds length and decrements the left free space at the\n * end of the string according to 'incr'. Also set the null term\n * in the new end of the string.\n *\n * This function is used in order to fix the string length after the\n * user calls sdsMakeRoomFor(), writes something after the end of\n * the current string, and finally needs to set the new length.\n *\n * Note: it is possible to use a negative increment in order to\n * right-trim the string.\n *\n * Usage example:\n *\n * Using sdsIncrLen() and sdsMakeRoomFor() it is possible to mount the\n * following schema, to cat bytes coming from the kernel to the end of an\n * sds string without copying into an intermediate buffer:\n *\n * oldlen = sdslen(s);\n * s = sdsMakeRoomFor(s, BUFFER_SIZE);\n * nread = read(fd, s+oldlen, BUFFER_SIZE);\n * ... check for nread <= 0 and handle it ...\n * sdsIncrLen(s, nread);\n */\nvoid sdsIncrLen(sds s, ssize_t incr) {\n    unsigned char flags = s[-1];\n    size_t len;\n    switch(flags&SDS_TYPE_MASK) {\n        case SDS_TYPE_5: {\n            unsigned char *fp = ((unsigned char*)s)-1;\n            unsigned char oldlen = SDS_TYPE_5_LEN(flags);\n            assert((incr > 0 && oldlen+incr < 32) || (incr < 0 && oldlen >= (unsigned int)(-incr)));\n            *fp = SDS_TYPE_5 | ((oldlen+incr) << SDS_TYPE_BITS);\n            len = oldlen+incr;\n            break;\n        }\n        case SDS_TYPE_8: {\n            SDS_HDR_VAR(8,s);\n            assert((incr >= 0 && sh->alloc-sh->len >= incr) || (incr < 0 && sh->len >= (unsigned int)(-incr)));\n            len = (sh->len += incr);\n            break;\n        }\n        case SDS_TYPE_16: {\n            SDS_HDR_VAR(16,s);\n            assert((incr >= 0 && sh->alloc-sh->len >= incr) || (incr < 0 && sh->len >= (unsigned int)(-incr)));\n            len = (sh->len += incr);\n            break;\n        }\n        case SDS_TYPE_32: {\n            SDS_HDR_VAR(32,s);\n            assert((incr >= 0 && sh->alloc-sh->len >= (unsigned int)incr) || (incr < 0 && sh->len >= (unsigned int)(-incr)));\n            len = (sh->len += incr);\n            break;\n        }\n        case SDS_TYPE_64: {\n            SDS_HDR_VAR(64,s);\n            assert((incr >= 0 && sh->alloc-sh->len >= (uint64_t)incr) || (incr < 0 && sh->len >= (uint64_t)(-incr)));\n            len = (sh->len += incr);\n            break;\n        }\n        default: len = 0; /* Just to avoid compilation warnings. */\n    }\n    s[len] = '\\0';\n}\n\n/* Grow the sds to have the specified length. Bytes that were not part of\n * the original length of the sds will be set to zero.\n *\n * if the specified length is smaller than the current length, no operation\n * is performed. */\nsds sdsgrowzero(sds s, size_t len) {\n    size_t curlen = sdslen(s);\n\n    if (len <= curlen) return s;\n    s = sdsMakeRoomFor(s,len-curlen);\n    if (s == NULL) return NULL;\n\n    /* Make sure added region doesn't contain garbage */\n    memset(s+curlen,0,(len-curlen+1)); /* also set trailing \\0 byte */\n    sdssetlen(s, len);\n    return s;\n}\n\n/* Append the specified binary-safe string pointed by 't' of 'len' bytes to the\n * end of the specified sds string 's'.\n *\n * After the call, the passed sds string is no longer valid and all the\n * references must be substituted with the new pointer returned by the call. */\nsds sdscatlen(sds s, const void *t, size_t len) {\n    size_t curlen = sdslen(s);\n\n    s = sdsMakeRoomFor(s,len);\n    if (s == NULL) return NULL;\n    memcpy(s+curlen, t, len);\n    sdssetlen(s, curlen+len);\n    s[curlen+len] = '\\0';\n    return s;\n}\n\n/* Append the specified null termianted C string to the sds string 's'.\n *\n * After the call, the passed sds string is no longer valid and all the\n * references must be substituted with the new pointer returned by the call. */\nsds sdscat(sds s, const char *t) {\n    return sdscatlen(s, t, strlen(t));\n}\n\n/* Append the specified sds 't' to the existing sds 's'.\n *\n * After the call, the modified sds string is no longer valid and all the\n * references must be substituted with the new pointer returned by the call. */\nsds sdscatsds(sds s, const sds t) {\n    return sdscatlen(s, t, sdslen(t));\n}\n\n/* Destructively modify the sds string 's' to hold the specified binary\n * safe string pointed by 't' of length 'len' bytes. */\nsds sdscpylen(sds s, const char *t, size_t len) {\n    if (sdsalloc(s) < len) {\n        s = sdsMakeRoomFor(s,len-sdslen(s));\n        if (s == NULL) return NULL;\n    }\n    memcpy(s, t, len);\n    s[len] = '\\0';\n    sdssetlen(s, len);\n    return s;\n}\n\n/* Like sdscpylen() but 't' must be a null-terminated string so that the length\n * of the string is obtained with strlen(). */\nsds sdscpy(sds s, const char *t) {\n    return sdscpylen(s, t, strlen(t));\n}\n\n/* Helper for sdscatlonglong() doing the actual number -> string\n * conversion. 's' must point to a string with room for at least\n * SDS_LLSTR_SIZE bytes.\n *\n * The function returns the length of the null-terminated string\n * representation stored at 's'. */\n#define SDS_LLSTR_SIZE 21\nint sdsll2str(char *s, long long value) {\n    char *p, aux;\n    unsigned long long v;\n    size_t l;\n\n    /* Generate the string representation, this method produces\n     * an reversed string. */\n    if (value < 0) {\n        /* Since v is unsigned, if value==LLONG_MIN then\n         * -LLONG_MIN will overflow. */\n        if (value != LLONG_MIN) {\n            v = -value;\n        } else {\n            v = ((unsigned long long)LLONG_MAX) + 1;\n        }\n    } else {\n        v = value;\n    }\n\n    p = s;\n    do {\n        *p++ = '0'+(v%10);\n        v /= 10;\n    } while(v);\n    if (value < 0) *p++ = '-';\n\n    /* Compute length and add null term. */\n    l = p-s;\n    *p = '\\0';\n\n    /* Reverse the string. */\n    p--;\n    while(s < p) {\n        aux = *s;\n        *s = *p;\n        *p = aux;\n        s++;\n        p--;\n    }\n    return l;\n}\n\n/* Identical sdsll2str(), but for unsigned long long type. */\nint sdsull2str(char *s, unsigned long long v) {\n    char *p, aux;\n    size_t l;\n\n    /* Generate the string representation, this method produces\n     * an reversed string. */\n    p = s;\n    do {\n        *p++ = '0'+(v%10);\n        v /= 10;\n    } while(v);\n\n    /* Compute length and add null term. */\n    l = p-s;\n    *p = '\\0';\n\n    /* Reverse the string. */\n    p--;\n    while(s < p) {\n        aux = *s;\n        *s = *p;\n        *p = aux;\n        s++;\n        p--;\n    }\n    return l;\n}\n\n/* Create an sds string from a long long value. It is much faster than:\n *\n * sdscatprintf(sdsempty(),\"%lld\\n\", value);\n */\nsds sdsfromlonglong(long long value) {\n    char buf[SDS_LLSTR_SIZE];\n    int len = sdsll2str(buf,value);\n\n    return sdsnewlen(buf,len);\n}\n\n/* Like sdscatprintf() but gets va_list instead of being variadic. */\nsds sdscatvprintf(sds s, const char *fmt, va_list ap) {\n    va_list cpy;\n    char staticbuf[1024], *buf = staticbuf, *t;\n    size_t buflen = strlen(fmt)*2;\n    int bufstrlen;\n\n    /* We try to start using a static buffer for speed.\n     * If not possible we revert to heap allocation. */\n    if (buflen > sizeof(staticbuf)) {\n        buf = s_malloc(buflen);\n        if (buf == NULL) return NULL;\n    } else {\n        buflen = sizeof(staticbuf);\n    }\n\n    /* Alloc enough space for buffer and \\0 after failing to\n     * fit the string in the current buffer size. */\n    while(1) {\n        va_copy(cpy,ap);\n        bufstrlen = vsnprintf(buf, buflen, fmt, cpy);\n        va_end(cpy);\n        if (bufstrlen < 0) {\n            if (buf != staticbuf) s_free(buf);\n            return NULL;\n        }\n        if (((size_t)bufstrlen) >= buflen) {\n            if (buf != staticbuf) s_free(buf);\n            buflen = ((size_t)bufstrlen) + 1;\n            buf = s_malloc(buflen);\n            if (buf == NULL) return NULL;\n            continue;\n        }\n        break;\n    }\n\n    /* Finally concat the obtained string to the SDS string and return it. */\n    t = sdscatlen(s, buf, bufstrlen);\n    if (buf != staticbuf) s_free(buf);\n    return t;\n}\n\n/* Append to the sds string 's' a string obtained using printf-alike format\n * specifier.\n *\n * After the call, the modified sds string is no longer valid and all the\n * references must be substituted with the new pointer returned by the call.\n *\n * Example:\n *\n * s = sdsnew(\"Sum is: \");\n * s = sdscatprintf(s,\"%d+%d = %d\",a,b,a+b).\n *\n * Often you need to create a string from scratch with the printf-alike\n * format. When this is the need, just use sdsempty() as the target string:\n *\n * s = sdscatprintf(sdsempty(), \"... your format ...\", args);\n */\nsds sdscatprintf(sds s, const char *fmt, ...) {\n    va_list ap;\n    char *t;\n    va_start(ap, fmt);\n    t = sdscatvprintf(s,fmt,ap);\n    va_end(ap);\n    return t;\n}\n\n/* This function is similar to sdscatprintf, but much faster as it does\n * not rely on sprintf() family functions implemented by the libc that\n * are often very slow. Moreover directly handling the sds string as\n * new data is concatenated provides a performance improvement.\n *\n * However this function only handles an incompatible subset of printf-alike\n * format specifiers:\n *\n * %s - C String\n * %S - SDS string\n * %i - signed int\n * %I - 64 bit signed integer (long long, int64_t)\n * %u - unsigned int\n * %U - 64 bit unsigned integer (unsigned long long, uint64_t)\n * %% - Verbatim \"%\" character.\n */\nsds sdscatfmt(sds s, char const *fmt, ...) {\n    size_t initlen = sdslen(s);\n    const char *f = fmt;\n    long i;\n    va_list ap;\n\n    /* To avoid continuous reallocations, let's start with a buffer that\n     * can hold at least two times the format string itself. It's not the\n     * best heuristic but seems to work in practice. */\n    s = sdsMakeRoomFor(s, initlen + strlen(fmt)*2);\n    va_start(ap,fmt);\n    f = fmt;    /* Next format specifier byte to process. */\n    i = initlen; /* Position of the next byte to write to dest str. */\n    while(*f) {\n        char next, *str;\n        size_t l;\n        long long num;\n        unsigned long long unum;\n\n        /* Make sure there is always space for at least 1 char. */\n        if (sdsavail(s)==0) {\n            s = sdsMakeRoomFor(s,1);\n        }\n\n        switch(*f) {\n        case '%':\n            next = *(f+1);\n            if (next == '\\0') break;\n            f++;\n            switch(next) {\n            case 's':\n            case 'S':\n                str = va_arg(ap,char*);\n                l = (next == 's') ? strlen(str) : sdslen(str);\n                if (sdsavail(s) < l) {\n                    s = sdsMakeRoomFor(s,l);\n                }\n                memcpy(s+i,str,l);\n                sdsinclen(s,l);\n                i += l;\n                break;\n            case 'i':\n            case 'I':\n                if (next == 'i')\n                    num = va_arg(ap,int);\n                else\n                    num = va_arg(ap,long long);\n                {\n                    char buf[SDS_LLSTR_SIZE];\n                    l = sdsll2str(buf,num);\n                    if (sdsavail(s) < l) {\n                        s = sdsMakeRoomFor(s,l);\n                    }\n                    memcpy(s+i,buf,l);\n                    sdsinclen(s,l);\n                    i += l;\n                }\n                break;\n            case 'u':\n            case 'U':\n                if (next == 'u')\n                    unum = va_arg(ap,unsigned int);\n                else\n                    unum = va_arg(ap,unsigned long long);\n                {\n                    char buf[SDS_LLSTR_SIZE];\n                    l = sdsull2str(buf,unum);\n                    if (sdsavail(s) < l) {\n                        s = sdsMakeRoomFor(s,l);\n                    }\n                    memcpy(s+i,buf,l);\n                    sdsinclen(s,l);\n                    i += l;\n                }\n                break;\n            default: /* Handle %% and generally %<unknown>. */\n                s[i++] = next;\n                sdsinclen(s,1);\n                break;\n            }\n            break;\n        default:\n            s[i++] = *f;\n            sdsinclen(s,1);\n            break;\n        }\n        f++;\n    }\n    va_end(ap);\n\n    /* Add null-term */\n    s[i] = '\\0';\n    return s;\n}\n\n/* Remove the part of the string from left and from right composed just of\n * contiguous characters found in 'cset', that is a null terminated C string.\n *\n * After the call, the modified sds string is no longer valid and all the\n * references must be substituted with the new pointer returned by the call.\n *\n * Example:\n *\n * s = sdsnew(\"AA...AA.a.aa.aHelloWorld     :::\");\n * s = sdstrim(s,\"Aa. :\");\n * printf(\"%s\\n\", s);\n *\n * Output will be just \"HelloWorld\".\n */\nsds sdstrim(sds s, const char *cset) {\n    char *end, *sp, *ep;\n    size_t len;\n\n    sp = s;\n    ep = end = s+sdslen(s)-1;\n    while(sp <= end && strchr(cset, *sp)) sp++;\n    while(ep > sp && strchr(cset, *ep)) ep--;\n    len = (ep-sp)+1;\n    if (s != sp) memmove(s, sp, len);\n    s[len] = '\\0';\n    sdssetlen(s,len);\n    return s;\n}\n\n/* Turn the string into a smaller (or equal) string containing only the\n * substring specified by the 'start' and 'end' indexes.\n *\n * start and end can be negative, where -1 means the last character of the\n * string, -2 the penultimate character, and so forth.\n *\n * The interval is inclusive, so the start and end characters will be part\n * of the resulting string.\n *\n * The string is modified in-place.\n *\n * Example:\n *\n * s = sdsnew(\"Hello World\");\n * sdsrange(s,1,-1); => \"ello World\"\n */\nvoid sdsrange(sds s, ssize_t start, ssize_t end) {\n    size_t newlen, len = sdslen(s);\n\n    if (len == 0) return;\n    if (start < 0) {\n        start = len+start;\n        if (start < 0) start = 0;\n    }\n    if (end < 0) {\n        end = len+end;\n        if (end < 0) end = 0;\n    }\n    newlen = (start > end) ? 0 : (end-start)+1;\n    if (newlen != 0) {\n        if (start >= (ssize_t)len) {\n            newlen = 0;\n        } else if (end >= (ssize_t)len) {\n            end = len-1;\n            newlen = (end-start)+1;\n        }\n    }\n    if (start && newlen) memmove(s, s+start, newlen);\n    s[newlen] = 0;\n    sdssetlen(s,newlen);\n}\n\n/* Apply tolower() to every character of the sds string 's'. */\nvoid sdstolower(sds s) {\n    size_t len = sdslen(s), j;\n\n    for (j = 0; j < len; j++) s[j] = tolower(s[j]);\n}\n\n/* Apply toupper() to every character of the sds string 's'. */\nvoid sdstoupper(sds s) {\n    size_t len = sdslen(s), j;\n\n    for (j = 0; j < len; j++) s[j] = toupper(s[j]);\n}\n\n/* Compare two sds strings s1 and s2 with memcmp().\n *\n * Return value:\n *\n *     positive if s1 > s2.\n *     negative if s1 < s2.\n *     0 if s1 and s2 are exactly the same binary string.\n *\n * If two strings share exactly the same prefix, but one of the two has\n * additional characters, the longer string is considered to be greater than\n * the smaller one. */\nint sdscmp(const sds s1, const sds s2) {\n    size_t l1, l2, minlen;\n    int cmp;\n\n    l1 = sdslen(s1);\n    l2 = sdslen(s2);\n    minlen = (l1 < l2) ? l1 : l2;\n    cmp = memcmp(s1,s2,minlen);\n    if (cmp == 0) return l1>l2? 1: (l1<l2? -1: 0);\n    return cmp;\n}\n\n/* Split 's' with separator in 'sep'. An array\n * of sds strings is returned. *count will be set\n * by reference to the number of tokens returned.\n *\n * On out of memory, zero length string, zero length\n * separator, NULL is returned.\n *\n * Note that 'sep' is able to split a string using\n * a multi-character separator. For example\n * sdssplit(\"foo_-_bar\",\"_-_\"); will return two\n * elements \"foo\" and \"bar\".\n *\n * This version of the function is binary-safe but\n * requires length arguments. sdssplit() is just the\n * same function but for zero-terminated strings.\n */\nsds *sdssplitlen(const char *s, ssize_t len, const char *sep, int seplen, int *count) {\n    int elements = 0, slots = 5;\n    long start = 0, j;\n    sds *tokens;\n\n    if (seplen < 1 || len <= 0) {\n        *count = 0;\n        return NULL;\n    }\n\n    tokens = s_malloc(sizeof(sds)*slots);\n    if (tokens == NULL) return NULL;\n\n    for (j = 0; j < (len-(seplen-1)); j++) {\n        /* make sure there is room for the next element and the final one */\n        if (slots < elements+2) {\n            sds *newtokens;\n\n            slots *= 2;\n            newtokens = s_realloc(tokens,sizeof(sds)*slots);\n            if (newtokens == NULL) goto cleanup;\n            tokens = newtokens;\n        }\n        /* search the separator */\n        if ((seplen == 1 && *(s+j) == sep[0]) || (memcmp(s+j,sep,seplen) == 0)) {\n            tokens[elements] = sdsnewlen(s+start,j-start);\n            if (tokens[elements] == NULL) goto cleanup;\n            elements++;\n            start = j+seplen;\n            j = j+seplen-1; /* skip the separator */\n        }\n    }\n    /* Add the final element. We are sure there is room in the tokens array. */\n    tokens[elements] = sdsnewlen(s+start,len-start);\n    if (tokens[elements] == NULL) goto cleanup;\n    elements++;\n    *count = elements;\n    return tokens;\n\ncleanup:\n    {\n        int i;\n        for (i = 0; i < elements; i++) sdsfree(tokens[i]);\n        s_free(tokens);\n        *count = 0;\n        return NULL;\n    }\n}\n\n/* Free the result returned by sdssplitlen(), or do nothing if 'tokens' is NULL. */\nvoid sdsfreesplitres(sds *tokens, int count) {\n    if (!tokens) return;\n    while(count--)\n        sdsfree(tokens[count]);\n    s_free(tokens);\n}\n\n/* Append to the sds string \"s\" an escaped string representation where\n * all the non-printable characters (tested with isprint()) are turned into\n * escapes in the form \"\\n\\r\\a....\" or \"\\x<hex-number>\".\n *\n * After the call, the modified sds string is no longer valid and all the\n * references must be substituted with the new pointer returned by the call. */\nsds sdscatrepr(sds s, const char *p, size_t len) {\n    s = sdscatlen(s,\"\\\"\",1);\n    while(len--) {\n        switch(*p) {\n        case '\\\\':\n        case '\"':\n            s = sdscatprintf(s,\"\\\\%c\",*p);\n            break;\n        case '\\n': s = sdscatlen(s,\"\\\\n\",2); break;\n        case '\\r': s = sdscatlen(s,\"\\\\r\",2); break;\n        case '\\t': s = sdscatlen(s,\"\\\\t\",2); break;\n        case '\\a': s = sdscatlen(s,\"\\\\a\",2); break;\n        case '\\b': s = sdscatlen(s,\"\\\\b\",2); break;\n        default:\n            if (isprint(*p))\n                s = sdscatprintf(s,\"%c\",*p);\n            else\n                s = sdscatprintf(s,\"\\\\x%02x\",(unsigned char)*p);\n            break;\n        }\n        p++;\n    }\n    return sdscatlen(s,\"\\\"\",1);\n}\n\n/* Helper function for sdssplitargs() that returns non zero if 'c'\n * is a valid hex digit. */\nint is_hex_digit(char c) {\n    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') ||\n           (c >= 'A' && c <= 'F');\n}\n\n/* Helper function for sdssplitargs() that converts a hex digit into an\n * integer from 0 to 15 */\nint hex_digit_to_int(char c) {\n    switch(c) {\n    case '0': return 0;\n    case '1': return 1;\n    case '2': return 2;\n    case '3': return 3;\n    case '4': return 4;\n    case '5': return 5;\n    case '6': return 6;\n    case '7': return 7;\n    case '8': return 8;\n    case '9': return 9;\n    case 'a': case 'A': return 10;\n    case 'b': case 'B': return 11;\n    case 'c': case 'C': return 12;\n    case 'd': case 'D': return 13;\n    case 'e': case 'E': return 14;\n    case 'f': case 'F': return 15;\n    default: return 0;\n    }\n}\n\n/* Split a line into arguments, where every argument can be in the\n * following programming-language REPL-alike form:\n *\n * foo bar \"newline are supported\\n\" and \"\\xff\\x00otherstuff\"\n *\n * The number of arguments is stored into *argc, and an array\n * of sds is returned.\n *\n * The caller should free the resulting array of sds strings with\n * sdsfreesplitres().\n *\n * Note that sdscatrepr() is able to convert back a string into\n * a quoted string in the same format sdssplitargs() is able to parse.\n *\n * The function returns the allocated tokens on success, even when the\n * input string is empty, or NULL if the input contains unbalanced\n * quotes or closed quotes followed by non space characters\n * as in: \"foo\"bar or \"foo'\n */\nsds *sdssplitargs(const char *line, int *argc) {\n    const char *p = line;\n    char *current = NULL;\n    char **vector = NULL;\n\n    *argc = 0;\n    while(1) {\n        /* skip blanks */\n        while(*p && isspace(*p)) p++;\n        if (*p) {\n            /* get a token */\n            int inq=0;  /* set to 1 if we are in \"quotes\" */\n            int insq=0; /* set to 1 if we are in 'single quotes' */\n            int done=0;\n\n            if (current == NULL) current = sdsempty();\n            while(!done) {\n                if (inq) {\n                    if (*p == '\\\\' && *(p+1) == 'x' &&\n                                             is_hex_digit(*(p+2)) &&\n                                             is_hex_digit(*(p+3)))\n                    {\n                        unsigned char byte;\n\n                        byte = (hex_digit_to_int(*(p+2))*16)+\n                                hex_digit_to_int(*(p+3));\n                        current = sdscatlen(current,(char*)&byte,1);\n                        p += 3;\n                    } else if (*p == '\\\\' && *(p+1)) {\n                        char c;\n\n                        p++;\n                        switch(*p) {\n                        case 'n': c = '\\n'; break;\n                        case 'r': c = '\\r'; break;\n                        case 't': c = '\\t'; break;\n                        case 'b': c = '\\b'; break;\n                        case 'a': c = '\\a'; break;\n                        default: c = *p; break;\n                        }\n                        current = sdscatlen(current,&c,1);\n                    } else if (*p == '\"') {\n                        /* closing quote must be followed by a space or\n                         * nothing at all. */\n                        if (*(p+1) && !isspace(*(p+1))) goto err;\n                        done=1;\n                    } else if (!*p) {\n                        /* unterminated quotes */\n                        goto err;\n                    } else {\n                        current = sdscatlen(current,p,1);\n                    }\n                } else if (insq) {\n                    if (*p == '\\\\' && *(p+1) == '\\'') {\n                        p++;\n                        current = sdscatlen(current,\"'\",1);\n                    } else if (*p == '\\'') {\n                        /* closing quote must be followed by a space or\n                         * nothing at all. */\n                        if (*(p+1) && !isspace(*(p+1))) goto err;\n                        done=1;\n                    } else if (!*p) {\n                        /* unterminated quotes */\n                        goto err;\n                    } else {\n                        current = sdscatlen(current,p,1);\n                    }\n                } else {\n                    switch(*p) {\n                    case ' ':\n                    case '\\n':\n                    case '\\r':\n                    case '\\t':\n                    case '\\0':\n                        done=1;\n                        break;\n                    case '\"':\n                        inq=1;\n                        break;\n                    case '\\'':\n                        insq=1;\n                        break;\n                    default:\n                        current = sdscatlen(current,p,1);\n                        break;\n                    }\n                }\n                if (*p) p++;\n            }\n            /* add the token to the vector */\n            vector = s_realloc(vector,((*argc)+1)*sizeof(char*));\n            vector[*argc] = current;\n            (*argc)++;\n            current = NULL;\n        } else {\n            /* Even on empty input string return something not NULL. */\n            if (vector == NULL) vector = s_malloc(sizeof(void*));\n            return vector;\n        }\n    }\n\nerr:\n    while((*argc)--)\n        sdsfree(vector[*argc]);\n    s_free(vector);\n    if (current) sdsfree(current);\n    *argc = 0;\n    return NULL;\n}\n\n/* Modify the string substituting all the occurrences of the set of\n * characters specified in the 'from' string to the corresponding character\n * in the 'to' array.\n *\n * For instance: sdsmapchars(mystring, \"ho\", \"01\", 2)\n * will have the effect of turning the string \"hello\" into \"0ell1\".\n *\n * The function returns the sds string pointer, that is always the same\n * as the input pointer since no resize is needed. */\nsds sdsmapchars(sds s, const char *from, const char *to, size_t setlen) {\n    size_t j, i, l = sdslen(s);\n\n    for (j = 0; j < l; j++) {\n        for (i = 0; i < setlen; i++) {\n            if (s[j] == from[i]) {\n                s[j] = to[i];\n                break;\n            }\n        }\n    }\n    return s;\n}\n\n/* Join an array of C strings using the specified separator (also a C string).\n * Returns the result as an sds string. */\nsds sdsjoin(char **argv, int argc, char *sep) {\n    sds join = sdsempty();\n    int j;\n\n    for (j = 0; j < argc; j++) {\n        join = sdscat(join, argv[j]);\n        if (j != argc-1) join = sdscat(join,sep);\n    }\n    return join;\n}\n\n/* Like sdsjoin, but joins an array of SDS strings. */\nsds sdsjoinsds(sds *argv, int argc, const char *sep, size_t seplen) {\n    sds join = sdsempty();\n    int j;\n\n    for (j = 0; j < argc; j++) {\n        join = sdscatsds(join, argv[j]);\n        if (j != argc-1) join = sdscatlen(join,sep,seplen);\n    }\n    return join;\n}\n\n/* Wrappers to the allocators used by SDS. Note that SDS will actually\n * just use the macros defined into sdsalloc.h in order to avoid to pay\n * the overhead of function calls. Here we define these wrappers only for\n * the programs SDS is linked to, if they want to touch the SDS internals\n * even if they use a different allocator. */\nvoid *sds_malloc(size_t size) { return s_malloc(size); }\nvoid *sds_realloc(void *ptr, size_t size) { return s_realloc(ptr,size); }\nvoid sds_free(void *ptr) { s_free(ptr); }\n\n#if defined(SDS_TEST_MAIN)\n#include <stdio.h>\n#include \"testhelp.h\"\n#include \"limits.h\"\n\n#define UNUSED(x) (void)(x)\nint sdsTest(void) {\n    {\n        sds x = sdsnew(\"foo\"), y;\n\n        test_cond(\"Create a string and obtain the length\",\n            sdslen(x) == 3 && memcmp(x,\"foo\\0\",4) == 0)\n\n        sdsfree(x);\n        x = sdsnewlen(\"foo\",2);\n        test_cond(\"Create a string with specified length\",\n            sdslen(x) == 2 && memcmp(x,\"fo\\0\",3) == 0)\n\n        x = sdscat(x,\"bar\");\n        test_cond(\"Strings concatenation\",\n            sdslen(x) == 5 && memcmp(x,\"fobar\\0\",6) == 0);\n\n        x = sdscpy(x,\"a\");\n        test_cond(\"sdscpy() against an originally longer string\",\n            sdslen(x) == 1 && memcmp(x,\"a\\0\",2) == 0)\n\n        x = sdscpy(x,\"xyzxxxxxxxxxxyyyyyyyyyykkkkkkkkkk\");\n        test_cond(\"sdscpy() against an originally shorter string\",\n            sdslen(x) == 33 &&\n            memcmp(x,\"xyzxxxxxxxxxxyyyyyyyyyykkkkkkkkkk\\0\",33) == 0)\n\n        sdsfree(x);\n        x = sdscatprintf(sdsempty(),\"%d\",123);\n        test_cond(\"sdscatprintf() seems working in the base case\",\n            sdslen(x) == 3 && memcmp(x,\"123\\0\",4) == 0)\n\n        sdsfree(x);\n        x = sdscatprintf(sdsempty(),\"a%cb\",0);\n        test_cond(\"sdscatprintf() seems working with \\\\0 inside of result\",\n            sdslen(x) == 3 && memcmp(x,\"a\\0\"\"b\\0\",4) == 0)\n\n        {\n            sdsfree(x);\n            char etalon[1024*1024];\n            for (size_t i = 0; i < sizeof(etalon); i++) {\n                etalon[i] = '0';\n            }\n            x = sdscatprintf(sdsempty(),\"%0*d\",(int)sizeof(etalon),0);\n            test_cond(\"sdscatprintf() can print 1MB\",\n                sdslen(x) == sizeof(etalon) && memcmp(x,etalon,sizeof(etalon)) == 0)\n        }\n\n        sdsfree(x);\n        x = sdsnew(\"--\");\n        x = sdscatfmt(x, \"Hello %s World %I,%I--\", \"Hi!\", LLONG_MIN,LLONG_MAX);\n        test_cond(\"sdscatfmt() seems working in the base case\",\n            sdslen(x) == 60 &&\n            memcmp(x,\"--Hello Hi! World -9223372036854775808,\"\n                     \"9223372036854775807--\",60) == 0)\n        printf(\"[%s]\\n\",x);\n\n        sdsfree(x);\n        x = sdsnew(\"--\");\n        x = sdscatfmt(x, \"%u,%U--\", UINT_MAX, ULLONG_MAX);\n        test_cond(\"sdscatfmt() seems working with unsigned numbers\",\n            sdslen(x) == 35 &&\n            memcmp(x,\"--4294967295,18446744073709551615--\",35) == 0)\n\n        sdsfree(x);\n        x = sdsnew(\" x \");\n        sdstrim(x,\" x\");\n        test_cond(\"sdstrim() works when all chars match\",\n            sdslen(x) == 0)\n\n        sdsfree(x);\n        x = sdsnew(\" x \");\n        sdstrim(x,\" \");\n        test_cond(\"sdstrim() works when a single char remains\",\n            sdslen(x) == 1 && x[0] == 'x')\n\n        sdsfree(x);\n        x = sdsnew(\"xxciaoyyy\");\n        sdstrim(x,\"xy\");\n        test_cond(\"sdstrim() correctly trims characters\",\n            sdslen(x) == 4 && memcmp(x,\"ciao\\0\",5) == 0)\n\n        y = sdsdup(x);\n        sdsrange(y,1,1);\n        test_cond(\"sdsrange(...,1,1)\",\n            sdslen(y) == 1 && memcmp(y,\"i\\0\",2) == 0)\n\n        sdsfree(y);\n        y = sdsdup(x);\n        sdsrange(y,1,-1);\n        test_cond(\"sdsrange(...,1,-1)\",\n            sdslen(y) == 3 && memcmp(y,\"iao\\0\",4) == 0)\n\n        sdsfree(y);\n        y = sdsdup(x);\n        sdsrange(y,-2,-1);\n        test_cond(\"sdsrange(...,-2,-1)\",\n            sdslen(y) == 2 && memcmp(y,\"ao\\0\",3) == 0)\n\n        sdsfree(y);\n        y = sdsdup(x);\n        sdsrange(y,2,1);\n        test_cond(\"sdsrange(...,2,1)\",\n            sdslen(y) == 0 && memcmp(y,\"\\0\",1) == 0)\n\n        sdsfree(y);\n        y = sdsdup(x);\n        sdsrange(y,1,100);\n        test_cond(\"sdsrange(...,1,100)\",\n            sdslen(y) == 3 && memcmp(y,\"iao\\0\",4) == 0)\n\n        sdsfree(y);\n        y = sdsdup(x);\n        sdsrange(y,100,100);\n        test_cond(\"sdsrange(...,100,100)\",\n            sdslen(y) == 0 && memcmp(y,\"\\0\",1) == 0)\n\n        sdsfree(y);\n        sdsfree(x);\n        x = sdsnew(\"foo\");\n        y = sdsnew(\"foa\");\n        test_cond(\"sdscmp(foo,foa)\", sdscmp(x,y) > 0)\n\n        sdsfree(y);\n        sdsfree(x);\n        x = sdsnew(\"bar\");\n        y = sdsnew(\"bar\");\n        test_cond(\"sdscmp(bar,bar)\", sdscmp(x,y) == 0)\n\n        sdsfree(y);\n        sdsfree(x);\n        x = sdsnew(\"aar\");\n        y = sdsnew(\"bar\");\n        test_cond(\"sdscmp(bar,bar)\", sdscmp(x,y) < 0)\n\n        sdsfree(y);\n        sdsfree(x);\n        x = sdsnewlen(\"\\a\\n\\0foo\\r\",7);\n        y = sdscatrepr(sdsempty(),x,sdslen(x));\n        test_cond(\"sdscatrepr(...data...)\",\n            memcmp(y,\"\\\"\\\\a\\\\n\\\\x00foo\\\\r\\\"\",15) == 0)\n\n        {\n            char *p;\n            int step = 10, j, i;\n\n            sdsfree(x);\n            sdsfree(y);\n            x = sdsnew(\"0\");\n            test_cond(\"sdsnew() free/len buffers\", sdslen(x) == 1 && sdsavail(x) == 0);\n\n            /* Run the test a few times in order to hit the first two\n             * SDS header types. */\n            for (i = 0; i < 10; i++) {\n                int oldlen = sdslen(x);\n                x = sdsMakeRoomFor(x,step);\n                int type = x[-1]&SDS_TYPE_MASK;\n\n                test_cond(\"sdsMakeRoomFor() len\", sdslen(x) == oldlen);\n                if (type != SDS_TYPE_5) {\n                    test_cond(\"sdsMakeRoomFor() free\", sdsavail(x) >= step);\n                }\n                p = x+oldlen;\n                for (j = 0; j < step; j++) {\n                    p[j] = 'A'+j;\n                }\n                sdsIncrLen(x,step);\n            }\n            test_cond(\"sdsMakeRoomFor() content\",\n                memcmp(\"0ABCDEFGHIJABCDEFGHIJABCDEFGHIJABCDEFGHIJABCDEFGHIJABCDEFGHIJABCDEFGHIJABCDEFGHIJABCDEFGHIJABCDEFGHIJ\",x,101) == 0);\n            test_cond(\"sdsMakeRoomFor() final length\",sdslen(x)==101);\n\n            sdsfree(x);\n        }\n    }\n    test_report()\n    return 0;\n}\n#endif\n\n#ifdef SDS_TEST_MAIN\nint main(void) {\n    return sdsTest();\n}\n#endif\n";
+const char *SRC_SDS_H = "/* SDSLib 2.0 -- A C dynamic strings library\n *\n * Copyright (c) 2006-2015, Salvatore Sanfilippo <antirez at gmail dot com>\n * Copyright (c) 2015, Oran Agra\n * Copyright (c) 2015, Redis Labs, Inc\n * All rights reserved.\n *\n * Redistribution and use in source and binary forms, with or without\n * modification, are permitted provided that the following conditions are met:\n *\n *   * Redistributions of source code must retain the above copyright notice,\n *     this list of conditions and the following disclaimer.\n *   * Redistributions in binary form must reproduce the above copyright\n *     notice, this list of conditions and the following disclaimer in the\n *     documentation and/or other materials provided with the distribution.\n *   * Neither the name of Redis nor the names of its contributors may be used\n *     to endorse or promote products derived from this software without\n *     specific prior written permission.\n *\n * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS \"AS IS\"\n * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE\n * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE\n * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE\n * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR\n * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF\n * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS\n * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)\n * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE\n * POSSIBILITY OF SUCH DAMAGE.\n */\n\n#ifndef __SDS_H\n#define __SDS_H\n\n#define SDS_MAX_PREALLOC (1024*1024)\nextern const char *SDS_NOINIT;\n\n#include <sys/types.h>\n#include <stdarg.h>\n#include <stdint.h>\n\ntypedef char *sds;\n\n/* Note: sdshdr5 is never used, we just access the flags byte directly.\n * However is here to document the layout of type 5 SDS strings. */\nstruct __attribute__ ((__packed__)) sdshdr5 {\n    unsigned char flags; /* 3 lsb of type, and 5 msb of string length */\n    char buf[];\n};\nstruct __attribute__ ((__packed__)) sdshdr8 {\n    uint8_t len; /* used */\n    uint8_t alloc; /* excluding the header and null terminator */\n    unsigned char flags; /* 3 lsb of type, 5 unused bits */\n    char buf[];\n};\nstruct __attribute__ ((__packed__)) sdshdr16 {\n    uint16_t len; /* used */\n    uint16_t alloc; /* excluding the header and null terminator */\n    unsigned char flags; /* 3 lsb of type, 5 unused bits */\n    char buf[];\n};\nstruct __attribute__ ((__packed__)) sdshdr32 {\n    uint32_t len; /* used */\n    uint32_t alloc; /* excluding the header and null terminator */\n    unsigned char flags; /* 3 lsb of type, 5 unused bits */\n    char buf[];\n};\nstruct __attribute__ ((__packed__)) sdshdr64 {\n    uint64_t len; /* used */\n    uint64_t alloc; /* excluding the header and null terminator */\n    unsigned char flags; /* 3 lsb of type, 5 unused bits */\n    char buf[];\n};\n\n#define SDS_TYPE_5  0\n#define SDS_TYPE_8  1\n#define SDS_TYPE_16 2\n#define SDS_TYPE_32 3\n#define SDS_TYPE_64 4\n#define SDS_TYPE_MASK 7\n#define SDS_TYPE_BITS 3\n/* Basalto: header and bytes are static (string literals in .rodata). Never\n * set on type 5, whose spare bits hold the length. sdsfree() skips these\n * strings, and the functions returning an sds write to a heap copy instead\n * (the in-place void ones, like sdsrange(), need an owned string). */\n#define SDS_STATIC 8\n#define SDS_IS_STATIC(s) (((s)[-1]&SDS_TYPE_MASK) != SDS_TYPE_5 && ((s)[-1]&SDS_STATIC))\n#define SDS_HDR_VAR(T,s) struct sdshdr##T *sh = (void*)((s)-(sizeof(struct sdshdr##T)));\n#define SDS_HDR(T,s) ((struct sdshdr##T *)((s)-(sizeof(struct sdshdr##T))))\n#define SDS_TYPE_5_LEN(f) ((f)>>SDS_TYPE_BITS)\n\nstatic inline size_t sdslen(const sds s) {\n    unsigned char flags = s[-1];\n    switch(flags&SDS_TYPE_MASK) {\n        case SDS_TYPE_5:\n            return SDS_TYPE_5_LEN(flags);\n        case SDS_TYPE_8:\n            return SDS_HDR(8,s)->len;\n        case SDS_TYPE_16:\n            return SDS_HDR(16,s)->len;\n        case SDS_TYPE_32:\n            return SDS_HDR(32,s)->len;\n        case SDS_TYPE_64:\n            return SDS_HDR(64,s)->len;\n    }\n    return 0;\n}\n\nstatic inline size_t sdsavail(const sds s) {\n    unsigned char flags = s[-1];\n    switch(flags&SDS_TYPE_MASK) {\n        case SDS_TYPE_5: {\n            return 0;\n        }\n        case SDS_TYPE_8: {\n            SDS_HDR_VAR(8,s);\n            return sh->alloc - sh->len;\n        }\n        case SDS_TYPE_16: {\n            SDS_HDR_VAR(16,s);\n            return sh->alloc - sh->len;\n        }\n        case SDS_TYPE_32: {\n            SDS_HDR_VAR(32,s);\n            return sh->alloc - sh->len;\n        }\n        case SDS_TYPE_64: {\n            SDS_HDR_VAR(64,s);\n            return sh->alloc - sh->len;\n        }\n    }\n    return 0;\n}\n\nstatic inline void sdssetlen(sds s, size_t newlen) {\n    unsigned char flags = s[-1];\n    switch(flags&SDS_TYPE_MASK) {\n        case SDS_TYPE_5:\n            {\n                unsigned char *fp = ((unsigned char*)s)-1;\n                *fp = SDS_TYPE_5 | (newlen << SDS_TYPE_BITS);\n            }\n            break;\n        case SDS_TYPE_8:\n            SDS_HDR(8,s)->len = newlen;\n            break;\n        case SDS_TYPE_16:\n            SDS_HDR(16,s)->len = newlen;\n            break;\n        case SDS_TYPE_32:\n            SDS_HDR(32,s)->len = newlen;\n            break;\n        case SDS_TYPE_64:\n            SDS_HDR(64,s)->len = newlen;\n            break;\n    }\n}\n\nstatic inline void sdsinclen(sds s, size_t inc) {\n    unsigned char flags = s[-1];\n    switch(flags&SDS_TYPE_MASK) {\n        case SDS_TYPE_5:\n            {\n                unsigned char *fp = ((unsigned char*)s)-1;\n                unsigned char newlen = SDS_TYPE_5_LEN(flags)+inc;\n                *fp = SDS_TYPE_5 | (newlen << SDS_TYPE_BITS);\n            }\n            break;\n        case SDS_TYPE_8:\n            SDS_HDR(8,s)->len += inc;\n            break;\n        case SDS_TYPE_16:\n            SDS_HDR(16,s)->len += inc;\n            break;\n        case SDS_TYPE_32:\n            SDS_HDR(32,s)->len += inc;\n            break;\n        case SDS_TYPE_64:\n            SDS_HDR(64,s)->len += inc;\n            break;\n    }\n}\n\n/* sdsalloc() = sdsavail() + sdslen() */\nstatic inline size_t sdsalloc(const sds s) {\n    unsigned char flags = s[-1];\n    switch(flags&SDS_TYPE_MASK) {\n        case SDS_TYPE_5:\n            return SDS_TYPE_5_LEN(flags);\n        case SDS_TYPE_8:\n            return SDS_HDR(8,s)->alloc;\n        case SDS_TYPE_16:\n            return SDS_HDR(16,s)->alloc;\n        case SDS_TYPE_32:\n            return SDS_HDR(32,s)->alloc;\n        case SDS_TYPE_64:\n            return SDS_HDR(64,s)->alloc;\n    }\n    return 0;\n}\n\nstatic inline void sdssetalloc(sds s, size_t newlen) {\n    unsigned char flags = s[-1];\n    switch(flags&SDS_TYPE_MASK) {\n        case SDS_TYPE_5:\n            /* Nothing to do, this type has no total allocation info. */\n            break;\n        case SDS_TYPE_8:\n            SDS_HDR(8,s)->alloc = newlen;\n            break;\n        case SDS_TYPE_16:\n            SDS_HDR(16,s)->alloc = newlen;\n            break;\n        case SDS_TYPE_32:\n            SDS_HDR(32,s)->alloc = newlen;\n            break;\n        case SDS_TYPE_64:\n            SDS_HDR(64,s)->alloc = newlen;\n            break;\n    }\n}\n\nsds sdsnewlen(const void *init, size_t initlen);\nsds sdsnew(const char *init);\nsds sdsempty(void);\nsds sdsdup(const sds s);\nvoid sdsfree(sds s);\nsds sdsgrowzero(sds s, size_t len);\nsds sdscatlen(sds s, const void *t, size_t len);\nsds sdscat(sds s, const char *t);\nsds sdscatsds(sds s, const sds t);\nsds sdscpylen(sds s, const char *t, size_t len);\nsds sdscpy(sds s, const char *t);\n\nsds sdscatvprintf(sds s, const char *fmt, va_list ap);\n#ifdef __GNUC__\nsds sdscatprintf(sds s, const char *fmt, ...)\n    __attribute__((format(printf, 2, 3)));\n#else\nsds sdscatprintf(sds s, const char *fmt, ...);\n#endif\n\nsds sdscatfmt(sds s, char const *fmt, ...);\nsds sdstrim(sds s, const char *cset);\nvoid sdsrange(sds s, ssize_t start, ssize_t end);\nvoid sdsupdatelen(sds s);\nvoid sdsclear(sds s);\nint sdscmp(const sds s1, const sds s2);\nsds *sdssplitlen(const char *s, ssize_t len, const char *sep, int seplen, int *count);\nvoid sdsfreesplitres(sds *tokens, int count);\nvoid sdstolower(sds s);\nvoid sdstoupper(sds s);\nsds sdsfromlonglong(long long value);\nsds sdscatrepr(sds s, const char *p, size_t len);\nsds *sdssplitargs(const char *line, int *argc);\nsds sdsmapchars(sds s, const char *from, const char *to, size_t setlen);\nsds sdsjoin(char **argv, int argc, char *sep);\nsds sdsjoinsds(sds *argv, int argc, const char *sep, size_t seplen);\n\n/* Low level functions exposed to the user API */\nsds sdsMakeRoomFor(sds s, size_t addlen);\nvoid sdsIncrLen(sds s, ssize_t incr);\nsds sdsRemoveFreeSpace(sds s);\nsize_t sdsAllocSize(sds s);\nvoid *sdsAllocPtr(sds s);\n\n/* Export the allocator used by SDS to the program using SDS.\n * Sometimes the program SDS is linked to, may use a different set of\n * allocators, but may want to allocate or free things that SDS will\n * respectively free or allocate. */\nvoid *sds_malloc(size_t size);\nvoid *sds_realloc(void *ptr, size_t size);\nvoid sds_free(void *ptr);\n\n#ifdef REDIS_TEST\nint sdsTest(int argc, char *argv[]);\n#endif\n\n#endif\n";
 
-const char *SRC_STB_DS_H = "/* stb_ds.h - v0.67 - public domain data structures - Sean Barrett 2019\n\n   This is a single-header-file library that provides easy-to-use\n   dynamic arrays and hash tables for C (also works in C++).\n\n   For a gentle introduction:\n      http://nothings.org/stb_ds\n\n   To use this library, do this in *one* C or C++ file:\n      #define STB_DS_IMPLEMENTATION\n      #include \"stb_ds.h\"\n\nTABLE OF CONTENTS\n\n  Table of Contents\n  Compile-time options\n  License\n  Documentation\n  Notes\n  Notes - Dynamic arrays\n  Notes - Hash maps\n  Credits\n\nCOMPILE-TIME OPTIONS\n\n  #define STBDS_NO_SHORT_NAMES\n\n     This flag needs to be set globally.\n\n     By default stb_ds exposes shorter function names that are not qualified\n     with the \"stbds_\" prefix. If these names conflict with the names in your\n     code, define this flag.\n\n  #define STBDS_SIPHASH_2_4\n\n     This flag only needs to be set in the file containing #define STB_DS_IMPLEMENTATION.\n\n     By default stb_ds.h hashes using a weaker variant of SipHash and a custom hash for\n     4- and 8-byte keys. On 64-bit platforms, you can define the above flag to force\n     stb_ds.h to use specification-compliant SipHash-2-4 for all keys. Doing so makes\n     hash table insertion about 20% slower on 4- and 8-byte keys, 5% slower on\n     64-byte keys, and 10% slower on 256-byte keys on my test computer.\n\n  #define STBDS_REALLOC(context,ptr,size) better_realloc\n  #define STBDS_FREE(context,ptr)         better_free\n\n     These defines only need to be set in the file containing #define STB_DS_IMPLEMENTATION.\n\n     By default stb_ds uses stdlib realloc() and free() for memory management. You can\n     substitute your own functions instead by defining these symbols. You must either\n     define both, or neither. Note that at the moment, 'context' will always be NULL.\n     @TODO add an array/hash initialization function that takes a memory context pointer.\n\n  #define STBDS_UNIT_TESTS\n\n     Defines a function stbds_unit_tests() that checks the functioning of the data structures.\n\n  Note that on older versions of gcc (e.g. 5.x.x) you may need to build with '-std=c++0x'\n     (or equivalentally '-std=c++11') when using anonymous structures as seen on the web\n     page or in STBDS_UNIT_TESTS.\n\nLICENSE\n\n  Placed in the public domain and also MIT licensed.\n  See end of file for detailed license information.\n\nDOCUMENTATION\n\n  Dynamic Arrays\n\n    Non-function interface:\n\n      Declare an empty dynamic array of type T\n        T* foo = NULL;\n\n      Access the i'th item of a dynamic array 'foo' of type T, T* foo:\n        foo[i]\n\n    Functions (actually macros)\n\n      arrfree:\n        void arrfree(T*);\n          Frees the array.\n\n      arrlen:\n        ptrdiff_t arrlen(T*);\n          Returns the number of elements in the array.\n\n      arrlenu:\n        size_t arrlenu(T*);\n          Returns the number of elements in the array as an unsigned type.\n\n      arrpop:\n        T arrpop(T* a)\n          Removes the final element of the array and returns it.\n\n      arrput:\n        T arrput(T* a, T b);\n          Appends the item b to the end of array a. Returns b.\n\n      arrins:\n        T arrins(T* a, int p, T b);\n          Inserts the item b into the middle of array a, into a[p],\n          moving the rest of the array over. Returns b.\n\n      arrinsn:\n        void arrinsn(T* a, int p, int n);\n          Inserts n uninitialized items into array a starting at a[p],\n          moving the rest of the array over.\n\n      arraddnptr:\n        T* arraddnptr(T* a, int n)\n          Appends n uninitialized items onto array at the end.\n          Returns a pointer to the first uninitialized item added.\n\n      arraddnindex:\n        size_t arraddnindex(T* a, int n)\n          Appends n uninitialized items onto array at the end.\n          Returns the index of the first uninitialized item added.\n\n      arrdel:\n        void arrdel(T* a, int p);\n          Deletes the element at a[p], moving the rest of the array over.\n\n      arrdeln:\n        void arrdeln(T* a, int p, int n);\n          Deletes n elements starting at a[p], moving the rest of the array over.\n\n      arrdelswap:\n        void arrdelswap(T* a, int p);\n          Deletes the element at a[p], replacing it with the element from\n          the end of the array. O(1) performance.\n\n      arrsetlen:\n        void arrsetlen(T* a, int n);\n          Changes the length of the array to n. Allocates uninitialized\n          slots at the end if necessary.\n\n      arrsetcap:\n        size_t arrsetcap(T* a, int n);\n          Sets the length of allocated storage to at least n. It will not\n          change the length of the array.\n\n      arrcap:\n        size_t arrcap(T* a);\n          Returns the number of total elements the array can contain without\n          needing to be reallocated.\n\n  Hash maps & String hash maps\n\n    Given T is a structure type: struct { TK key; TV value; }. Note that some\n    functions do not require TV value and can have other fields. For string\n    hash maps, TK must be 'char *'.\n\n    Special interface:\n\n      stbds_rand_seed:\n        void stbds_rand_seed(size_t seed);\n          For security against adversarially chosen data, you should seed the\n          library with a strong random number. Or at least seed it with time().\n\n      stbds_hash_string:\n        size_t stbds_hash_string(char *str, size_t seed);\n          Returns a hash value for a string.\n\n      stbds_hash_bytes:\n        size_t stbds_hash_bytes(void *p, size_t len, size_t seed);\n          These functions hash an arbitrary number of bytes. The function\n          uses a custom hash for 4- and 8-byte data, and a weakened version\n          of SipHash for everything else. On 64-bit platforms you can get\n          specification-compliant SipHash-2-4 on all data by defining\n          STBDS_SIPHASH_2_4, at a significant cost in speed.\n\n    Non-function interface:\n\n      Declare an empty hash map of type T\n        T* foo = NULL;\n\n      Access the i'th entry in a hash table T* foo:\n        foo[i]\n\n    Function interface (actually macros):\n\n      hmfree\n      shfree\n        void hmfree(T*);\n        void shfree(T*);\n          Frees the hashmap and sets the pointer to NULL.\n\n      hmlen\n      shlen\n        ptrdiff_t hmlen(T*)\n        ptrdiff_t shlen(T*)\n          Returns the number of elements in the hashmap.\n\n      hmlenu\n      shlenu\n        size_t hmlenu(T*)\n        size_t shlenu(T*)\n          Returns the number of elements in the hashmap.\n\n      hmgeti\n      shgeti\n      hmgeti_ts\n        ptrdiff_t hmgeti(T*, TK key)\n        ptrdiff_t shgeti(T*, char* key)\n        ptrdiff_t hmgeti_ts(T*, TK key, ptrdiff_t tempvar)\n          Returns the index in the hashmap which has the key 'key', or -1\n          if the key is not present.\n\n      hmget\n      hmget_ts\n      shget\n        TV hmget(T*, TK key)\n        TV shget(T*, char* key)\n        TV hmget_ts(T*, TK key, ptrdiff_t tempvar)\n          Returns the value corresponding to 'key' in the hashmap.\n          The structure must have a 'value' field\n\n      hmgets\n      shgets\n        T hmgets(T*, TK key)\n        T shgets(T*, char* key)\n          Returns the structure corresponding to 'key' in the hashmap.\n\n      hmgetp\n      shgetp\n      hmgetp_ts\n      hmgetp_null\n      shgetp_null\n        T* hmgetp(T*, TK key)\n        T* shgetp(T*, char* key)\n        T* hmgetp_ts(T*, TK key, ptrdiff_t tempvar)\n        T* hmgetp_null(T*, TK key)\n        T* shgetp_null(T*, char *key)\n          Returns a pointer to the structure corresponding to 'key' in\n          the hashmap. Functions ending in \"_null\" return NULL if the key\n          is not present in the hashmap; the others return a pointer to a\n          structure holding the default value (but not the searched-for key).\n\n      hmdefault\n      shdefault\n        TV hmdefault(T*, TV value)\n        TV shdefault(T*, TV value)\n          Sets the default value for the hashmap, the value which will be\n          returned by hmget/shget if the key is not present.\n\n      hmdefaults\n      shdefaults\n        TV hmdefaults(T*, T item)\n        TV shdefaults(T*, T item)\n          Sets the default struct for the hashmap, the contents which will be\n          returned by hmgets/shgets if the key is not present.\n\n      hmput\n      shput\n        TV hmput(T*, TK key, TV value)\n        TV shput(T*, char* key, TV value)\n          Inserts a <key,value> pair into the hashmap. If the key is already\n          present in the hashmap, updates its value.\n\n      hmputs\n      shputs\n        T hmputs(T*, T item)\n        T shputs(T*, T item)\n          Inserts a struct with T.key into the hashmap. If the struct is already\n          present in the hashmap, updates it.\n\n      hmdel\n      shdel\n        int hmdel(T*, TK key)\n        int shdel(T*, char* key)\n          If 'key' is in the hashmap, deletes its entry and returns 1.\n          Otherwise returns 0.\n\n    Function interface (actually macros) for strings only:\n\n      sh_new_strdup\n        void sh_new_strdup(T*);\n          Overwrites the existing pointer with a newly allocated\n          string hashmap which will automatically allocate and free\n          each string key using realloc/free\n\n      sh_new_arena\n        void sh_new_arena(T*);\n          Overwrites the existing pointer with a newly allocated\n          string hashmap which will automatically allocate each string\n          key to a string arena. Every string key ever used by this\n          hash table remains in the arena until the arena is freed.\n          Additionally, any key which is deleted and reinserted will\n          be allocated multiple times in the string arena.\n\nNOTES\n\n  * These data structures are realloc'd when they grow, and the macro\n    \"functions\" write to the provided pointer. This means: (a) the pointer\n    must be an lvalue, and (b) the pointer to the data structure is not\n    stable, and you must maintain it the same as you would a realloc'd\n    pointer. For example, if you pass a pointer to a dynamic array to a\n    function which updates it, the function must return back the new\n    pointer to the caller. This is the price of trying to do this in C.\n\n  * The following are the only functions that are thread-safe on a single data\n    structure, i.e. can be run in multiple threads simultaneously on the same\n    data structure\n        hmlen        shlen\n        hmlenu       shlenu\n        hmget_ts     shget_ts\n        hmgeti_ts    shgeti_ts\n        hmgets_ts    shgets_ts\n\n  * You iterate over the contents of a dynamic array and a hashmap in exactly\n    the same way, using arrlen/hmlen/shlen:\n\n      for (i=0; i < arrlen(foo); ++i)\n         ... foo[i] ...\n\n  * All operations except arrins/arrdel are O(1) amortized, but individual\n    operations can be slow, so these data structures may not be suitable\n    for real time use. Dynamic arrays double in capacity as needed, so\n    elements are copied an average of once. Hash tables double/halve\n    their size as needed, with appropriate hysteresis to maintain O(1)\n    performance.\n\nNOTES - DYNAMIC ARRAY\n\n  * If you know how long a dynamic array is going to be in advance, you can avoid\n    extra memory allocations by using arrsetlen to allocate it to that length in\n    advance and use foo[n] while filling it out, or arrsetcap to allocate the memory\n    for that length and use arrput/arrpush as normal.\n\n  * Unlike some other versions of the dynamic array, this version should\n    be safe to use with strict-aliasing optimizations.\n\nNOTES - HASH MAP\n\n  * For compilers other than GCC and clang (e.g. Visual Studio), for hmput/hmget/hmdel\n    and variants, the key must be an lvalue (so the macro can take the address of it).\n    Extensions are used that eliminate this requirement if you're using C99 and later\n    in GCC or clang, or if you're using C++ in GCC. But note that this can make your\n    code less portable.\n\n  * To test for presence of a key in a hashmap, just do 'hmgeti(foo,key) >= 0'.\n\n  * The iteration order of your data in the hashmap is determined solely by the\n    order of insertions and deletions. In particular, if you never delete, new\n    keys are always added at the end of the array. This will be consistent\n    across all platforms and versions of the library. However, you should not\n    attempt to serialize the internal hash table, as the hash is not consistent\n    between different platforms, and may change with future versions of the library.\n\n  * Use sh_new_arena() for string hashmaps that you never delete from. Initialize\n    with NULL if you're managing the memory for your strings, or your strings are\n    never freed (at least until the hashmap is freed). Otherwise, use sh_new_strdup().\n    @TODO: make an arena variant that garbage collects the strings with a trivial\n    copy collector into a new arena whenever the table shrinks / rebuilds. Since\n    current arena recommendation is to only use arena if it never deletes, then\n    this can just replace current arena implementation.\n\n  * If adversarial input is a serious concern and you're on a 64-bit platform,\n    enable STBDS_SIPHASH_2_4 (see the 'Compile-time options' section), and pass\n    a strong random number to stbds_rand_seed.\n\n  * The default value for the hash table is stored in foo[-1], so if you\n    use code like 'hmget(T,k)->value = 5' you can accidentally overwrite\n    the value stored by hmdefault if 'k' is not present.\n\nCREDITS\n\n  Sean Barrett -- library, idea for dynamic array API/implementation\n  Per Vognsen  -- idea for hash table API/implementation\n  Rafael Sachetto -- arrpop()\n  github:HeroicKatora -- arraddn() reworking\n\n  Bugfixes:\n    Andy Durdin\n    Shane Liesegang\n    Vinh Truong\n    Andreas Molzer\n    github:hashitaku\n    github:srdjanstipic\n    Macoy Madson\n    Andreas Vennstrom\n    Tobias Mansfield-Williams\n*/\n\n#ifdef STBDS_UNIT_TESTS\n#define _CRT_SECURE_NO_WARNINGS\n#endif\n\n#ifndef INCLUDE_STB_DS_H\n#define INCLUDE_STB_DS_H\n\n#include <stddef.h>\n#include <string.h>\n\n#ifndef STBDS_NO_SHORT_NAMES\n#define arrlen      stbds_arrlen\n#define arrlenu     stbds_arrlenu\n#define arrput      stbds_arrput\n#define arrpush     stbds_arrput\n#define arrpop      stbds_arrpop\n#define arrfree     stbds_arrfree\n#define arraddn     stbds_arraddn // deprecated, use one of the following instead:\n#define arraddnptr  stbds_arraddnptr\n#define arraddnindex stbds_arraddnindex\n#define arrsetlen   stbds_arrsetlen\n#define arrlast     stbds_arrlast\n#define arrins      stbds_arrins\n#define arrinsn     stbds_arrinsn\n#define arrdel      stbds_arrdel\n#define arrdeln     stbds_arrdeln\n#define arrdelswap  stbds_arrdelswap\n#define arrcap      stbds_arrcap\n#define arrsetcap   stbds_arrsetcap\n\n#define hmput       stbds_hmput\n#define hmputs      stbds_hmputs\n#define hmget       stbds_hmget\n#define hmget_ts    stbds_hmget_ts\n#define hmgets      stbds_hmgets\n#define hmgetp      stbds_hmgetp\n#define hmgetp_ts   stbds_hmgetp_ts\n#define hmgetp_null stbds_hmgetp_null\n#define hmgeti      stbds_hmgeti\n#define hmgeti_ts   stbds_hmgeti_ts\n#define hmdel       stbds_hmdel\n#define hmlen       stbds_hmlen\n#define hmlenu      stbds_hmlenu\n#define hmfree      stbds_hmfree\n#define hmdefault   stbds_hmdefault\n#define hmdefaults  stbds_hmdefaults\n\n#define shput       stbds_shput\n#define shputi      stbds_shputi\n#define shputs      stbds_shputs\n#define shget       stbds_shget\n#define shgeti      stbds_shgeti\n#define shgets      stbds_shgets\n#define shgetp      stbds_shgetp\n#define shgetp_null stbds_shgetp_null\n#define shdel       stbds_shdel\n#define shlen       stbds_shlen\n#define shlenu      stbds_shlenu\n#define shfree      stbds_shfree\n#define shdefault   stbds_shdefault\n#define shdefaults  stbds_shdefaults\n#define sh_new_arena  stbds_sh_new_arena\n#define sh_new_strdup stbds_sh_new_strdup\n\n#define stralloc    stbds_stralloc\n#define strreset    stbds_strreset\n#endif\n\n#if defined(STBDS_REALLOC) && !defined(STBDS_FREE) || !defined(STBDS_REALLOC) && defined(STBDS_FREE)\n#error \"You must define both STBDS_REALLOC and STBDS_FREE, or neither.\"\n#endif\n#if !defined(STBDS_REALLOC) && !defined(STBDS_FREE)\n#include <stdlib.h>\n#define STBDS_REALLOC(c,p,s) realloc(p,s)\n#define STBDS_FREE(c,p)      free(p)\n#endif\n\n#ifdef _MSC_VER\n#define STBDS_NOTUSED(v)  (void)(v)\n#else\n#define STBDS_NOTUSED(v)  (void)sizeof(v)\n#endif\n\n#ifdef __cplusplus\nextern \"C\" {\n#endif\n\n// for security against attackers, seed the library with a random number, at least time() but stronger is better\nextern void stbds_rand_seed(size_t seed);\n\n// these are the hash functions used internally if you want to test them or use them for other purposes\nextern size_t stbds_hash_bytes(void *p, size_t len, size_t seed);\nextern size_t stbds_hash_string(char *str, size_t seed);\n\n// this is a simple string arena allocator, initialize with e.g. 'stbds_string_arena my_arena={0}'.\ntypedef struct stbds_string_arena stbds_string_arena;\nextern char * stbds_stralloc(stbds_string_arena *a, char *str);\nextern void   stbds_strreset(stbds_string_arena *a);\n\n// have to #define STBDS_UNIT_TESTS to call this\nextern void stbds_unit_tests(void);\n\n///////////////\n//\n// Everything below here is implementation details\n//\n\nextern void * stbds_arrgrowf(void *a, size_t elemsize, size_t addlen, size_t min_cap);\nextern void   stbds_arrfreef(void *a);\nextern void   stbds_hmfree_func(void *p, size_t elemsize);\nextern void * stbds_hmget_key(void *a, size_t elemsize, void *key, size_t keysize, int mode);\nextern void * stbds_hmget_key_ts(void *a, size_t elemsize, void *key, size_t keysize, ptrdiff_t *temp, int mode);\nextern void * stbds_hmput_default(void *a, size_t elemsize);\nextern void * stbds_hmput_key(void *a, size_t elemsize, void *key, size_t keysize, int mode);\nextern void * stbds_hmdel_key(void *a, size_t elemsize, void *key, size_t keysize, size_t keyoffset, int mode);\nextern void * stbds_shmode_func(size_t elemsize, int mode);\n\n#ifdef __cplusplus\n}\n#endif\n\n#if defined(__GNUC__) || defined(__clang__)\n#define STBDS_HAS_TYPEOF\n#ifdef __cplusplus\n//#define STBDS_HAS_LITERAL_ARRAY  // this is currently broken for clang\n#endif\n#endif\n\n#if !defined(__cplusplus)\n#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L\n#define STBDS_HAS_LITERAL_ARRAY\n#endif\n#endif\n\n// this macro takes the address of the argument, but on gcc/clang can accept rvalues\n#if defined(STBDS_HAS_LITERAL_ARRAY) && defined(STBDS_HAS_TYPEOF)\n  #if __clang__\n  #define STBDS_ADDRESSOF(typevar, value)     ((__typeof__(typevar)[1]){value}) // literal array decays to pointer to value\n  #else\n  #define STBDS_ADDRESSOF(typevar, value)     ((typeof(typevar)[1]){value}) // literal array decays to pointer to value\n  #endif\n#else\n#define STBDS_ADDRESSOF(typevar, value)     &(value)\n#endif\n\n#define STBDS_OFFSETOF(var,field)           ((char *) &(var)->field - (char *) (var))\n\n#define stbds_header(t)  ((stbds_array_header *) (t) - 1)\n#define stbds_temp(t)    stbds_header(t)->temp\n#define stbds_temp_key(t) (*(char **) stbds_header(t)->hash_table)\n\n#define stbds_arrsetcap(a,n)   (stbds_arrgrow(a,0,n))\n#define stbds_arrsetlen(a,n)   ((stbds_arrcap(a) < (size_t) (n) ? stbds_arrsetcap((a),(size_t)(n)),0 : 0), (a) ? stbds_header(a)->length = (size_t) (n) : 0)\n#define stbds_arrcap(a)        ((a) ? stbds_header(a)->capacity : 0)\n#define stbds_arrlen(a)        ((a) ? (ptrdiff_t) stbds_header(a)->length : 0)\n#define stbds_arrlenu(a)       ((a) ?             stbds_header(a)->length : 0)\n#define stbds_arrput(a,v)      (stbds_arrmaybegrow(a,1), (a)[stbds_header(a)->length++] = (v))\n#define stbds_arrpush          stbds_arrput  // synonym\n#define stbds_arrpop(a)        (stbds_header(a)->length--, (a)[stbds_header(a)->length])\n#define stbds_arraddn(a,n)     ((void)(stbds_arraddnindex(a, n)))    // deprecated, use one of the following instead:\n#define stbds_arraddnptr(a,n)  (stbds_arrmaybegrow(a,n), (n) ? (stbds_header(a)->length += (n), &(a)[stbds_header(a)->length-(n)]) : (a))\n#define stbds_arraddnindex(a,n)(stbds_arrmaybegrow(a,n), (n) ? (stbds_header(a)->length += (n), stbds_header(a)->length-(n)) : stbds_arrlen(a))\n#define stbds_arraddnoff       stbds_arraddnindex\n#define stbds_arrlast(a)       ((a)[stbds_header(a)->length-1])\n#define stbds_arrfree(a)       ((void) ((a) ? STBDS_FREE(NULL,stbds_header(a)) : (void)0), (a)=NULL)\n#define stbds_arrdel(a,i)      stbds_arrdeln(a,i,1)\n#define stbds_arrdeln(a,i,n)   (memmove(&(a)[i], &(a)[(i)+(n)], sizeof *(a) * (stbds_header(a)->length-(n)-(i))), stbds_header(a)->length -= (n))\n#define stbds_arrdelswap(a,i)  ((a)[i] = stbds_arrlast(a), stbds_header(a)->length -= 1)\n#define stbds_arrinsn(a,i,n)   (stbds_arraddn((a),(n)), memmove(&(a)[(i)+(n)], &(a)[i], sizeof *(a) * (stbds_header(a)->length-(n)-(i))))\n#define stbds_arrins(a,i,v)    (stbds_arrinsn((a),(i),1), (a)[i]=(v))\n\n#define stbds_arrmaybegrow(a,n)  ((!(a) || stbds_header(a)->length + (n) > stbds_header(a)->capacity) \\\n                                  ? (stbds_arrgrow(a,n,0),0) : 0)\n\n#define stbds_arrgrow(a,b,c)   ((a) = stbds_arrgrowf_wrapper((a), sizeof *(a), (b), (c)))\n\n#define stbds_hmput(t, k, v) \\\n    ((t) = stbds_hmput_key_wrapper((t), sizeof *(t), (void*) STBDS_ADDRESSOF((t)->key, (k)), sizeof (t)->key, 0),   \\\n     (t)[stbds_temp((t)-1)].key = (k),    \\\n     (t)[stbds_temp((t)-1)].value = (v))\n\n#define stbds_hmputs(t, s) \\\n    ((t) = stbds_hmput_key_wrapper((t), sizeof *(t), &(s).key, sizeof (s).key, STBDS_HM_BINARY), \\\n     (t)[stbds_temp((t)-1)] = (s))\n\n#define stbds_hmgeti(t,k) \\\n    ((t) = stbds_hmget_key_wrapper((t), sizeof *(t), (void*) STBDS_ADDRESSOF((t)->key, (k)), sizeof (t)->key, STBDS_HM_BINARY), \\\n      stbds_temp((t)-1))\n\n#define stbds_hmgeti_ts(t,k,temp) \\\n    ((t) = stbds_hmget_key_ts_wrapper((t), sizeof *(t), (void*) STBDS_ADDRESSOF((t)->key, (k)), sizeof (t)->key, &(temp), STBDS_HM_BINARY), \\\n      (temp))\n\n#define stbds_hmgetp(t, k) \\\n    ((void) stbds_hmgeti(t,k), &(t)[stbds_temp((t)-1)])\n\n#define stbds_hmgetp_ts(t, k, temp) \\\n    ((void) stbds_hmgeti_ts(t,k,temp), &(t)[temp])\n\n#define stbds_hmdel(t,k) \\\n    (((t) = stbds_hmdel_key_wrapper((t),sizeof *(t), (void*) STBDS_ADDRESSOF((t)->key, (k)), sizeof (t)->key, STBDS_OFFSETOF((t),key), STBDS_HM_BINARY)),(t)?stbds_temp((t)-1):0)\n\n#define stbds_hmdefault(t, v) \\\n    ((t) = stbds_hmput_default_wrapper((t), sizeof *(t)), (t)[-1].value = (v))\n\n#define stbds_hmdefaults(t, s) \\\n    ((t) = stbds_hmput_default_wrapper((t), sizeof *(t)), (t)[-1] = (s))\n\n#define stbds_hmfree(p)        \\\n    ((void) ((p) != NULL ? stbds_hmfree_func((p)-1,sizeof*(p)),0 : 0),(p)=NULL)\n\n#define stbds_hmgets(t, k)    (*stbds_hmgetp(t,k))\n#define stbds_hmget(t, k)     (stbds_hmgetp(t,k)->value)\n#define stbds_hmget_ts(t, k, temp)  (stbds_hmgetp_ts(t,k,temp)->value)\n#define stbds_hmlen(t)        ((t) ? (ptrdiff_t) stbds_header((t)-1)->length-1 : 0)\n#define stbds_hmlenu(t)       ((t) ?             stbds_header((t)-1)->length-1 : 0)\n#define stbds_hmgetp_null(t,k)  (stbds_hmgeti(t,k) == -1 ? NULL : &(t)[stbds_temp((t)-1)])\n\n#define stbds_shput(t, k, v) \\\n    ((t) = stbds_hmput_key_wrapper((t), sizeof *(t), (void*) (k), sizeof (t)->key, STBDS_HM_STRING),   \\\n     (t)[stbds_temp((t)-1)].value = (v))\n\n#define stbds_shputi(t, k, v) \\\n    ((t) = stbds_hmput_key_wrapper((t), sizeof *(t), (void*) (k), sizeof (t)->key, STBDS_HM_STRING),   \\\n     (t)[stbds_temp((t)-1)].value = (v), stbds_temp((t)-1))\n\n#define stbds_shputs(t, s) \\\n    ((t) = stbds_hmput_key_wrapper((t), sizeof *(t), (void*) (s).key, sizeof (s).key, STBDS_HM_STRING), \\\n     (t)[stbds_temp((t)-1)] = (s), \\\n     (t)[stbds_temp((t)-1)].key = stbds_temp_key((t)-1)) // above line overwrites whole structure, so must rewrite key here if it was allocated internally\n\n#define stbds_pshput(t, p) \\\n    ((t) = stbds_hmput_key_wrapper((t), sizeof *(t), (void*) (p)->key, sizeof (p)->key, STBDS_HM_PTR_TO_STRING), \\\n     (t)[stbds_temp((t)-1)] = (p))\n\n#define stbds_shgeti(t,k) \\\n     ((t) = stbds_hmget_key_wrapper((t), sizeof *(t), (void*) (k), sizeof (t)->key, STBDS_HM_STRING), \\\n      stbds_temp((t)-1))\n\n#define stbds_pshgeti(t,k) \\\n     ((t) = stbds_hmget_key_wrapper((t), sizeof *(t), (void*) (k), sizeof (*(t))->key, STBDS_HM_PTR_TO_STRING), \\\n      stbds_temp((t)-1))\n\n#define stbds_shgetp(t, k) \\\n    ((void) stbds_shgeti(t,k), &(t)[stbds_temp((t)-1)])\n\n#define stbds_pshget(t, k) \\\n    ((void) stbds_pshgeti(t,k), (t)[stbds_temp((t)-1)])\n\n#define stbds_shdel(t,k) \\\n    (((t) = stbds_hmdel_key_wrapper((t),sizeof *(t), (void*) (k), sizeof (t)->key, STBDS_OFFSETOF((t),key), STBDS_HM_STRING)),(t)?stbds_temp((t)-1):0)\n#define stbds_pshdel(t,k) \\\n    (((t) = stbds_hmdel_key_wrapper((t),sizeof *(t), (void*) (k), sizeof (*(t))->key, STBDS_OFFSETOF(*(t),key), STBDS_HM_PTR_TO_STRING)),(t)?stbds_temp((t)-1):0)\n\n#define stbds_sh_new_arena(t)  \\\n    ((t) = stbds_shmode_func_wrapper(t, sizeof *(t), STBDS_SH_ARENA))\n#define stbds_sh_new_strdup(t) \\\n    ((t) = stbds_shmode_func_wrapper(t, sizeof *(t), STBDS_SH_STRDUP))\n\n#define stbds_shdefault(t, v)  stbds_hmdefault(t,v)\n#define stbds_shdefaults(t, s) stbds_hmdefaults(t,s)\n\n#define stbds_shfree       stbds_hmfree\n#define stbds_shlenu       stbds_hmlenu\n\n#define stbds_shgets(t, k) (*stbds_shgetp(t,k))\n#define stbds_shget(t, k)  (stbds_shgetp(t,k)->value)\n#define stbds_shgetp_null(t,k)  (stbds_shgeti(t,k) == -1 ? NULL : &(t)[stbds_temp((t)-1)])\n#define stbds_shlen        stbds_hmlen\n\ntypedef struct\n{\n  size_t      length;\n  size_t      capacity;\n  void      * hash_table;\n  ptrdiff_t   temp;\n} stbds_array_header;\n\ntypedef struct stbds_string_block\n{\n  struct stbds_string_block *next;\n  char storage[8];\n} stbds_string_block;\n\nstruct stbds_string_arena\n{\n  stbds_string_block *storage;\n  size_t remaining;\n  unsigned char block;\n  unsigned char mode;  // this isn't used by the string arena itself\n};\n\n#define STBDS_HM_BINARY         0\n#define STBDS_HM_STRING         1\n\nenum\n{\n   STBDS_SH_NONE,\n   STBDS_SH_DEFAULT,\n   STBDS_SH_STRDUP,\n   STBDS_SH_ARENA\n};\n\n#ifdef __cplusplus\n// in C we use implicit assignment from these void*-returning functions to T*.\n// in C++ these templates make the same code work\ntemplate<class T> static T * stbds_arrgrowf_wrapper(T *a, size_t elemsize, size_t addlen, size_t min_cap) {\n  return (T*)stbds_arrgrowf((void *)a, elemsize, addlen, min_cap);\n}\ntemplate<class T> static T * stbds_hmget_key_wrapper(T *a, size_t elemsize, void *key, size_t keysize, int mode) {\n  return (T*)stbds_hmget_key((void*)a, elemsize, key, keysize, mode);\n}\ntemplate<class T> static T * stbds_hmget_key_ts_wrapper(T *a, size_t elemsize, void *key, size_t keysize, ptrdiff_t *temp, int mode) {\n  return (T*)stbds_hmget_key_ts((void*)a, elemsize, key, keysize, temp, mode);\n}\ntemplate<class T> static T * stbds_hmput_default_wrapper(T *a, size_t elemsize) {\n  return (T*)stbds_hmput_default((void *)a, elemsize);\n}\ntemplate<class T> static T * stbds_hmput_key_wrapper(T *a, size_t elemsize, void *key, size_t keysize, int mode) {\n  return (T*)stbds_hmput_key((void*)a, elemsize, key, keysize, mode);\n}\ntemplate<class T> static T * stbds_hmdel_key_wrapper(T *a, size_t elemsize, void *key, size_t keysize, size_t keyoffset, int mode){\n  return (T*)stbds_hmdel_key((void*)a, elemsize, key, keysize, keyoffset, mode);\n}\ntemplate<class T> static T * stbds_shmode_func_wrapper(T *, size_t elemsize, int mode) {\n  return (T*)stbds_shmode_func(elemsize, mode);\n}\n#else\n#define stbds_arrgrowf_wrapper            stbds_arrgrowf\n#define stbds_hmget_key_wrapper           stbds_hmget_key\n#define stbds_hmget_key_ts_wrapper        stbds_hmget_key_ts\n#define stbds_hmput_default_wrapper       stbds_hmput_default\n#define stbds_hmput_key_wrapper           stbds_hmput_key\n#define stbds_hmdel_key_wrapper           stbds_hmdel_key\n#define stbds_shmode_func_wrapper(t,e,m)  stbds_shmode_func(e,m)\n#endif\n\n#endif // INCLUDE_STB_DS_H\n\n\n//////////////////////////////////////////////////////////////////////////////\n//\n//   IMPLEMENTATION\n//\n\n#ifdef STB_DS_IMPLEMENTATION\n#include <assert.h>\n#include <string.h>\n\n#ifndef STBDS_ASSERT\n#define STBDS_ASSERT_WAS_UNDEFINED\n#define STBDS_ASSERT(x)   ((void) 0)\n#endif\n\n#ifdef STBDS_STATISTICS\n#define STBDS_STATS(x)   x\nsize_t stbds_array_grow;\nsize_t stbds_hash_grow;\nsize_t stbds_hash_shrink;\nsize_t stbds_hash_rebuild;\nsize_t stbds_hash_probes;\nsize_t stbds_hash_alloc;\nsize_t stbds_rehash_probes;\nsize_t stbds_rehash_items;\n#else\n#define STBDS_STATS(x)\n#endif\n\n//\n// stbds_arr implementation\n//\n\n//int *prev_allocs[65536];\n//int num_prev;\n\nvoid *stbds_arrgrowf(void *a, size_t elemsize, size_t addlen, size_t min_cap)\n{\n  stbds_array_header temp={0}; // force debugging\n  void *b;\n  size_t min_len = stbds_arrlen(a) + addlen;\n  (void) sizeof(temp);\n\n  // compute the minimum capacity needed\n  if (min_len > min_cap)\n    min_cap = min_len;\n\n  if (min_cap <= stbds_arrcap(a))\n    return a;\n\n  // increase needed capacity to guarantee O(1) amortized\n  if (min_cap < 2 * stbds_arrcap(a))\n    min_cap = 2 * stbds_arrcap(a);\n  else if (min_cap < 4)\n    min_cap = 4;\n\n  //if (num_prev < 65536) if (a) prev_allocs[num_prev++] = (int *) ((char *) a+1);\n  //if (num_prev == 2201)\n  //  num_prev = num_prev;\n  b = STBDS_REALLOC(NULL, (a) ? stbds_header(a) : 0, elemsize * min_cap + sizeof(stbds_array_header));\n  //if (num_prev < 65536) prev_allocs[num_prev++] = (int *) (char *) b;\n  b = (char *) b + sizeof(stbds_array_header);\n  if (a == NULL) {\n    stbds_header(b)->length = 0;\n    stbds_header(b)->hash_table = 0;\n    stbds_header(b)->temp = 0;\n  } else {\n    STBDS_STATS(++stbds_array_grow);\n  }\n  stbds_header(b)->capacity = min_cap;\n\n  return b;\n}\n\nvoid stbds_arrfreef(void *a)\n{\n  STBDS_FREE(NULL, stbds_header(a));\n}\n\n//\n// stbds_hm hash table implementation\n//\n\n#ifdef STBDS_INTERNAL_SMALL_BUCKET\n#define STBDS_BUCKET_LENGTH      4\n#else\n#define STBDS_BUCKET_LENGTH      8\n#endif\n\n#define STBDS_BUCKET_SHIFT      (STBDS_BUCKET_LENGTH == 8 ? 3 : 2)\n#define STBDS_BUCKET_MASK       (STBDS_BUCKET_LENGTH-1)\n#define STBDS_CACHE_LINE_SIZE   64\n\n#define STBDS_ALIGN_FWD(n,a)   (((n) + (a) - 1) & ~((a)-1))\n\ntypedef struct\n{\n   size_t    hash [STBDS_BUCKET_LENGTH];\n   ptrdiff_t index[STBDS_BUCKET_LENGTH];\n} stbds_hash_bucket; // in 32-bit, this is one 64-byte cache line; in 64-bit, each array is one 64-byte cache line\n\ntypedef struct\n{\n  char * temp_key; // this MUST be the first field of the hash table\n  size_t slot_count;\n  size_t used_count;\n  size_t used_count_threshold;\n  size_t used_count_shrink_threshold;\n  size_t tombstone_count;\n  size_t tombstone_count_threshold;\n  size_t seed;\n  size_t slot_count_log2;\n  stbds_string_arena string;\n  stbds_hash_bucket *storage; // not a separate allocation, just 64-byte aligned storage after this struct\n} stbds_hash_index;\n\n#define STBDS_INDEX_EMPTY    -1\n#define STBDS_INDEX_DELETED  -2\n#define STBDS_INDEX_IN_USE(x)  ((x) >= 0)\n\n#define STBDS_HASH_EMPTY      0\n#define STBDS_HASH_DELETED    1\n\nstatic size_t stbds_hash_seed=0x31415926;\n\nvoid stbds_rand_seed(size_t seed)\n{\n  stbds_hash_seed = seed;\n}\n\n#define stbds_load_32_or_64(var, temp, v32, v64_hi, v64_lo)                                          \\\n  temp = v64_lo ^ v32, temp <<= 16, temp <<= 16, temp >>= 16, temp >>= 16, /* discard if 32-bit */   \\\n  var = v64_hi, var <<= 16, var <<= 16,                                    /* discard if 32-bit */   \\\n  var ^= temp ^ v32\n\n#define STBDS_SIZE_T_BITS           ((sizeof (size_t)) * 8)\n\nstatic size_t stbds_probe_position(size_t hash, size_t slot_count, size_t slot_log2)\n{\n  size_t pos;\n  STBDS_NOTUSED(slot_log2);\n  pos = hash & (slot_count-1);\n  #ifdef STBDS_INTERNAL_BUCKET_START\n  pos &= ~STBDS_BUCKET_MASK;\n  #endif\n  return pos;\n}\n\nstatic size_t stbds_log2(size_t slot_count)\n{\n  size_t n=0;\n  while (slot_count > 1) {\n    slot_count >>= 1;\n    ++n;\n  }\n  return n;\n}\n\nstatic stbds_hash_index *stbds_make_hash_index(size_t slot_count, stbds_hash_index *ot)\n{\n  stbds_hash_index *t;\n  t = (stbds_hash_index *) STBDS_REALLOC(NULL,0,(slot_count >> STBDS_BUCKET_SHIFT) * sizeof(stbds_hash_bucket) + sizeof(stbds_hash_index) + STBDS_CACHE_LINE_SIZE-1);\n  t->storage = (stbds_hash_bucket *) STBDS_ALIGN_FWD((size_t) (t+1), STBDS_CACHE_LINE_SIZE);\n  t->slot_count = slot_count;\n  t->slot_count_log2 = stbds_log2(slot_count);\n  t->tombstone_count = 0;\n  t->used_count = 0;\n\n  #if 0 // A1\n  t->used_count_threshold        = slot_count*12/16; // if 12/16th of table is occupied, grow\n  t->tombstone_count_threshold   = slot_count* 2/16; // if tombstones are 2/16th of table, rebuild\n  t->used_count_shrink_threshold = slot_count* 4/16; // if table is only 4/16th full, shrink\n  #elif 1 // A2\n  //t->used_count_threshold        = slot_count*12/16; // if 12/16th of table is occupied, grow\n  //t->tombstone_count_threshold   = slot_count* 3/16; // if tombstones are 3/16th of table, rebuild\n  //t->used_count_shrink_threshold = slot_count* 4/16; // if table is only 4/16th full, shrink\n\n  // compute without overflowing\n  t->used_count_threshold        = slot_count - (slot_count>>2);\n  t->tombstone_count_threshold   = (slot_count>>3) + (slot_count>>4);\n  t->used_count_shrink_threshold = slot_count >> 2;\n\n  #elif 0 // B1\n  t->used_count_threshold        = slot_count*13/16; // if 13/16th of table is occupied, grow\n  t->tombstone_count_threshold   = slot_count* 2/16; // if tombstones are 2/16th of table, rebuild\n  t->used_count_shrink_threshold = slot_count* 5/16; // if table is only 5/16th full, shrink\n  #else // C1\n  t->used_count_threshold        = slot_count*14/16; // if 14/16th of table is occupied, grow\n  t->tombstone_count_threshold   = slot_count* 2/16; // if tombstones are 2/16th of table, rebuild\n  t->used_count_shrink_threshold = slot_count* 6/16; // if table is only 6/16th full, shrink\n  #endif\n  // Following statistics were measured on a Core i7-6700 @ 4.00Ghz, compiled with clang 7.0.1 -O2\n    // Note that the larger tables have high variance as they were run fewer times\n  //     A1            A2          B1           C1\n  //    0.10ms :     0.10ms :     0.10ms :     0.11ms :      2,000 inserts creating 2K table\n  //    0.96ms :     0.95ms :     0.97ms :     1.04ms :     20,000 inserts creating 20K table\n  //   14.48ms :    14.46ms :    10.63ms :    11.00ms :    200,000 inserts creating 200K table\n  //  195.74ms :   196.35ms :   203.69ms :   214.92ms :  2,000,000 inserts creating 2M table\n  // 2193.88ms :  2209.22ms :  2285.54ms :  2437.17ms : 20,000,000 inserts creating 20M table\n  //   65.27ms :    53.77ms :    65.33ms :    65.47ms : 500,000 inserts & deletes in 2K table\n  //   72.78ms :    62.45ms :    71.95ms :    72.85ms : 500,000 inserts & deletes in 20K table\n  //   89.47ms :    77.72ms :    96.49ms :    96.75ms : 500,000 inserts & deletes in 200K table\n  //   97.58ms :    98.14ms :    97.18ms :    97.53ms : 500,000 inserts & deletes in 2M table\n  //  118.61ms :   119.62ms :   120.16ms :   118.86ms : 500,000 inserts & deletes in 20M table\n  //  192.11ms :   194.39ms :   196.38ms :   195.73ms : 500,000 inserts & deletes in 200M table\n\n  if (slot_count <= STBDS_BUCKET_LENGTH)\n    t->used_count_shrink_threshold = 0;\n  // to avoid infinite loop, we need to guarantee that at least one slot is empty and will terminate probes\n  STBDS_ASSERT(t->used_count_threshold + t->tombstone_count_threshold < t->slot_count);\n  STBDS_STATS(++stbds_hash_alloc);\n  if (ot) {\n    t->string = ot->string;\n    // reuse old seed so we can reuse old hashes so below \"copy out old data\" doesn't do any hashing\n    t->seed = ot->seed;\n  } else {\n    size_t a,b,temp;\n    memset(&t->string, 0, sizeof(t->string));\n    t->seed = stbds_hash_seed;\n    // LCG\n    // in 32-bit, a =          2147001325   b =  715136305\n    // in 64-bit, a = 2862933555777941757   b = 3037000493\n    stbds_load_32_or_64(a,temp, 2147001325, 0x27bb2ee6, 0x87b0b0fd);\n    stbds_load_32_or_64(b,temp,  715136305,          0, 0xb504f32d);\n    stbds_hash_seed = stbds_hash_seed  * a + b;\n  }\n\n  {\n    size_t i,j;\n    for (i=0; i < slot_count >> STBDS_BUCKET_SHIFT; ++i) {\n      stbds_hash_bucket *b = &t->storage[i];\n      for (j=0; j < STBDS_BUCKET_LENGTH; ++j)\n        b->hash[j] = STBDS_HASH_EMPTY;\n      for (j=0; j < STBDS_BUCKET_LENGTH; ++j)\n        b->index[j] = STBDS_INDEX_EMPTY;\n    }\n  }\n\n  // copy out the old data, if any\n  if (ot) {\n    size_t i,j;\n    t->used_count = ot->used_count;\n    for (i=0; i < ot->slot_count >> STBDS_BUCKET_SHIFT; ++i) {\n      stbds_hash_bucket *ob = &ot->storage[i];\n      for (j=0; j < STBDS_BUCKET_LENGTH; ++j) {\n        if (STBDS_INDEX_IN_USE(ob->index[j])) {\n          size_t hash = ob->hash[j];\n          size_t pos = stbds_probe_position(hash, t->slot_count, t->slot_count_log2);\n          size_t step = STBDS_BUCKET_LENGTH;\n          STBDS_STATS(++stbds_rehash_items);\n          for (;;) {\n            size_t limit,z;\n            stbds_hash_bucket *bucket;\n            bucket = &t->storage[pos >> STBDS_BUCKET_SHIFT];\n            STBDS_STATS(++stbds_rehash_probes);\n\n            for (z=pos & STBDS_BUCKET_MASK; z < STBDS_BUCKET_LENGTH; ++z) {\n              if (bucket->hash[z] == 0) {\n                bucket->hash[z] = hash;\n                bucket->index[z] = ob->index[j];\n                goto done;\n              }\n            }\n\n            limit = pos & STBDS_BUCKET_MASK;\n            for (z = 0; z < limit; ++z) {\n              if (bucket->hash[z] == 0) {\n                bucket->hash[z] = hash;\n                bucket->index[z] = ob->index[j];\n                goto done;\n              }\n            }\n\n            pos += step;                  // quadratic probing\n            step += STBDS_BUCKET_LENGTH;\n            pos &= (t->slot_count-1);\n          }\n        }\n       done:\n        ;\n      }\n    }\n  }\n\n  return t;\n}\n\n#define STBDS_ROTATE_LEFT(val, n)   (((val) << (n)) | ((val) >> (STBDS_SIZE_T_BITS - (n))))\n#define STBDS_ROTATE_RIGHT(val, n)  (((val) >> (n)) | ((val) << (STBDS_SIZE_T_BITS - (n))))\n\nsize_t stbds_hash_string(char *str, size_t seed)\n{\n  size_t hash = seed;\n  while (*str)\n     hash = STBDS_ROTATE_LEFT(hash, 9) + (unsigned char) *str++;\n\n  // Thomas Wang 64-to-32 bit mix function, hopefully also works in 32 bits\n  hash ^= seed;\n  hash = (~hash) + (hash << 18);\n  hash ^= hash ^ STBDS_ROTATE_RIGHT(hash,31);\n  hash = hash * 21;\n  hash ^= hash ^ STBDS_ROTATE_RIGHT(hash,11);\n  hash += (hash << 6);\n  hash ^= STBDS_ROTATE_RIGHT(hash,22);\n  return hash+seed;\n}\n\n#ifdef STBDS_SIPHASH_2_4\n#define STBDS_SIPHASH_C_ROUNDS 2\n#define STBDS_SIPHASH_D_ROUNDS 4\ntypedef int STBDS_SIPHASH_2_4_can_only_be_used_in_64_bit_builds[sizeof(size_t) == 8 ? 1 : -1];\n#endif\n\n#ifndef STBDS_SIPHASH_C_ROUNDS\n#define STBDS_SIPHASH_C_ROUNDS 1\n#endif\n#ifndef STBDS_SIPHASH_D_ROUNDS\n#define STBDS_SIPHASH_D_ROUNDS 1\n#endif\n\n#ifdef _MSC_VER\n#pragma warning(push)\n#pragma warning(disable:4127) // conditional expression is constant, for do..while(0) and sizeof()==\n#endif\n\nstatic size_t stbds_siphash_bytes(void *p, size_t len, size_t seed)\n{\n  unsigned char *d = (unsigned char *) p;\n  size_t i,j;\n  size_t v0,v1,v2,v3, data;\n\n  // hash that works on 32- or 64-bit registers without knowing which we have\n  // (computes different results on 32-bit and 64-bit platform)\n  // derived from siphash, but on 32-bit platforms very different as it uses 4 32-bit state not 4 64-bit\n  v0 = ((((size_t) 0x736f6d65 << 16) << 16) + 0x70736575) ^  seed;\n  v1 = ((((size_t) 0x646f7261 << 16) << 16) + 0x6e646f6d) ^ ~seed;\n  v2 = ((((size_t) 0x6c796765 << 16) << 16) + 0x6e657261) ^  seed;\n  v3 = ((((size_t) 0x74656462 << 16) << 16) + 0x79746573) ^ ~seed;\n\n  #ifdef STBDS_TEST_SIPHASH_2_4\n  // hardcoded with key material in the siphash test vectors\n  v0 ^= 0x0706050403020100ull ^  seed;\n  v1 ^= 0x0f0e0d0c0b0a0908ull ^ ~seed;\n  v2 ^= 0x0706050403020100ull ^  seed;\n  v3 ^= 0x0f0e0d0c0b0a0908ull ^ ~seed;\n  #endif\n\n  #define STBDS_SIPROUND() \\\n    do {                   \\\n      v0 += v1; v1 = STBDS_ROTATE_LEFT(v1, 13);  v1 ^= v0; v0 = STBDS_ROTATE_LEFT(v0,STBDS_SIZE_T_BITS/2); \\\n      v2 += v3; v3 = STBDS_ROTATE_LEFT(v3, 16);  v3 ^= v2;                                                 \\\n      v2 += v1; v1 = STBDS_ROTATE_LEFT(v1, 17);  v1 ^= v2; v2 = STBDS_ROTATE_LEFT(v2,STBDS_SIZE_T_BITS/2); \\\n      v0 += v3; v3 = STBDS_ROTATE_LEFT(v3, 21);  v3 ^= v0;                                                 \\\n    } while (0)\n\n  for (i=0; i+sizeof(size_t) <= len; i += sizeof(size_t), d += sizeof(size_t)) {\n    data = d[0] | (d[1] << 8) | (d[2] << 16) | (d[3] << 24);\n    data |= (size_t) (d[4] | (d[5] << 8) | (d[6] << 16) | (d[7] << 24)) << 16 << 16; // discarded if size_t == 4\n\n    v3 ^= data;\n    for (j=0; j < STBDS_SIPHASH_C_ROUNDS; ++j)\n      STBDS_SIPROUND();\n    v0 ^= data;\n  }\n  data = len << (STBDS_SIZE_T_BITS-8);\n  switch (len - i) {\n    case 7: data |= ((size_t) d[6] << 24) << 24; // fall through\n    case 6: data |= ((size_t) d[5] << 20) << 20; // fall through\n    case 5: data |= ((size_t) d[4] << 16) << 16; // fall through\n    case 4: data |= (d[3] << 24); // fall through\n    case 3: data |= (d[2] << 16); // fall through\n    case 2: data |= (d[1] << 8); // fall through\n    case 1: data |= d[0]; // fall through\n    case 0: break;\n  }\n  v3 ^= data;\n  for (j=0; j < STBDS_SIPHASH_C_ROUNDS; ++j)\n    STBDS_SIPROUND();\n  v0 ^= data;\n  v2 ^= 0xff;\n  for (j=0; j < STBDS_SIPHASH_D_ROUNDS; ++j)\n    STBDS_SIPROUND();\n\n#ifdef STBDS_SIPHASH_2_4\n  return v0^v1^v2^v3;\n#else\n  return v1^v2^v3; // slightly stronger since v0^v3 in above cancels out final round operation? I tweeted at the authors of SipHash about this but they didn't reply\n#endif\n}\n\nsize_t stbds_hash_bytes(void *p, size_t len, size_t seed)\n{\n#ifdef STBDS_SIPHASH_2_4\n  return stbds_siphash_bytes(p,len,seed);\n#else\n  unsigned char *d = (unsigned char *) p;\n\n  if (len == 4) {\n    unsigned int hash = d[0] | (d[1] << 8) | (d[2] << 16) | (d[3] << 24);\n    #if 0\n    // HASH32-A  Bob Jenkin's hash function w/o large constants\n    hash ^= seed;\n    hash -= (hash<<6);\n    hash ^= (hash>>17);\n    hash -= (hash<<9);\n    hash ^= seed;\n    hash ^= (hash<<4);\n    hash -= (hash<<3);\n    hash ^= (hash<<10);\n    hash ^= (hash>>15);\n    #elif 1\n    // HASH32-BB  Bob Jenkin's presumably-accidental version of Thomas Wang hash with rotates turned into shifts.\n    // Note that converting these back to rotates makes it run a lot slower, presumably due to collisions, so I'm\n    // not really sure what's going on.\n    hash ^= seed;\n    hash = (hash ^ 61) ^ (hash >> 16);\n    hash = hash + (hash << 3);\n    hash = hash ^ (hash >> 4);\n    hash = hash * 0x27d4eb2d;\n    hash ^= seed;\n    hash = hash ^ (hash >> 15);\n    #else  // HASH32-C   -  Murmur3\n    hash ^= seed;\n    hash *= 0xcc9e2d51;\n    hash = (hash << 17) | (hash >> 15);\n    hash *= 0x1b873593;\n    hash ^= seed;\n    hash = (hash << 19) | (hash >> 13);\n    hash = hash*5 + 0xe6546b64;\n    hash ^= hash >> 16;\n    hash *= 0x85ebca6b;\n    hash ^= seed;\n    hash ^= hash >> 13;\n    hash *= 0xc2b2ae35;\n    hash ^= hash >> 16;\n    #endif\n    // Following statistics were measured on a Core i7-6700 @ 4.00Ghz, compiled with clang 7.0.1 -O2\n    // Note that the larger tables have high variance as they were run fewer times\n    //  HASH32-A   //  HASH32-BB  //  HASH32-C\n    //    0.10ms   //    0.10ms   //    0.10ms :      2,000 inserts creating 2K table\n    //    0.96ms   //    0.95ms   //    0.99ms :     20,000 inserts creating 20K table\n    //   14.69ms   //   14.43ms   //   14.97ms :    200,000 inserts creating 200K table\n    //  199.99ms   //  195.36ms   //  202.05ms :  2,000,000 inserts creating 2M table\n    // 2234.84ms   // 2187.74ms   // 2240.38ms : 20,000,000 inserts creating 20M table\n    //   55.68ms   //   53.72ms   //   57.31ms : 500,000 inserts & deletes in 2K table\n    //   63.43ms   //   61.99ms   //   65.73ms : 500,000 inserts & deletes in 20K table\n    //   80.04ms   //   77.96ms   //   81.83ms : 500,000 inserts & deletes in 200K table\n    //  100.42ms   //   97.40ms   //  102.39ms : 500,000 inserts & deletes in 2M table\n    //  119.71ms   //  120.59ms   //  121.63ms : 500,000 inserts & deletes in 20M table\n    //  185.28ms   //  195.15ms   //  187.74ms : 500,000 inserts & deletes in 200M table\n    //   15.58ms   //   14.79ms   //   15.52ms : 200,000 inserts creating 200K table with varying key spacing\n\n    return (((size_t) hash << 16 << 16) | hash) ^ seed;\n  } else if (len == 8 && sizeof(size_t) == 8) {\n    size_t hash = d[0] | (d[1] << 8) | (d[2] << 16) | (d[3] << 24);\n    hash |= (size_t) (d[4] | (d[5] << 8) | (d[6] << 16) | (d[7] << 24)) << 16 << 16; // avoid warning if size_t == 4\n    hash ^= seed;\n    hash = (~hash) + (hash << 21);\n    hash ^= STBDS_ROTATE_RIGHT(hash,24);\n    hash *= 265;\n    hash ^= STBDS_ROTATE_RIGHT(hash,14);\n    hash ^= seed;\n    hash *= 21;\n    hash ^= STBDS_ROTATE_RIGHT(hash,28);\n    hash += (hash << 31);\n    hash = (~hash) + (hash << 18);\n    return hash;\n  } else {\n    return stbds_siphash_bytes(p,len,seed);\n  }\n#endif\n}\n#ifdef _MSC_VER\n#pragma warning(pop)\n#endif\n\n\nstatic int stbds_is_key_equal(void *a, size_t elemsize, void *key, size_t keysize, size_t keyoffset, int mode, size_t i)\n{\n  if (mode >= STBDS_HM_STRING)\n    return 0==strcmp((char *) key, * (char **) ((char *) a + elemsize*i + keyoffset));\n  else\n    return 0==memcmp(key, (char *) a + elemsize*i + keyoffset, keysize);\n}\n\n#define STBDS_HASH_TO_ARR(x,elemsize) ((char*) (x) - (elemsize))\n#define STBDS_ARR_TO_HASH(x,elemsize) ((char*) (x) + (elemsize))\n\n#define stbds_hash_table(a)  ((stbds_hash_index *) stbds_header(a)->hash_table)\n\nvoid stbds_hmfree_func(void *a, size_t elemsize)\n{\n  if (a == NULL) return;\n  if (stbds_hash_table(a) != NULL) {\n    if (stbds_hash_table(a)->string.mode == STBDS_SH_STRDUP) {\n      size_t i;\n      // skip 0th element, which is default\n      for (i=1; i < stbds_header(a)->length; ++i)\n        STBDS_FREE(NULL, *(char**) ((char *) a + elemsize*i));\n    }\n    stbds_strreset(&stbds_hash_table(a)->string);\n  }\n  STBDS_FREE(NULL, stbds_header(a)->hash_table);\n  STBDS_FREE(NULL, stbds_header(a));\n}\n\nstatic ptrdiff_t stbds_hm_find_slot(void *a, size_t elemsize, void *key, size_t keysize, size_t keyoffset, int mode)\n{\n  void *raw_a = STBDS_HASH_TO_ARR(a,elemsize);\n  stbds_hash_index *table = stbds_hash_table(raw_a);\n  size_t hash = mode >= STBDS_HM_STRING ? stbds_hash_string((char*)key,table->seed) : stbds_hash_bytes(key, keysize,table->seed);\n  size_t step = STBDS_BUCKET_LENGTH;\n  size_t limit,i;\n  size_t pos;\n  stbds_hash_bucket *bucket;\n\n  if (hash < 2) hash += 2; // stored hash values are forbidden from being 0, so we can detect empty slots\n\n  pos = stbds_probe_position(hash, table->slot_count, table->slot_count_log2);\n\n  for (;;) {\n    STBDS_STATS(++stbds_hash_probes);\n    bucket = &table->storage[pos >> STBDS_BUCKET_SHIFT];\n\n    // start searching from pos to end of bucket, this should help performance on small hash tables that fit in cache\n    for (i=pos & STBDS_BUCKET_MASK; i < STBDS_BUCKET_LENGTH; ++i) {\n      if (bucket->hash[i] == hash) {\n        if (stbds_is_key_equal(a, elemsize, key, keysize, keyoffset, mode, bucket->index[i])) {\n          return (pos & ~STBDS_BUCKET_MASK)+i;\n        }\n      } else if (bucket->hash[i] == STBDS_HASH_EMPTY) {\n        return -1;\n      }\n    }\n\n    // search from beginning of bucket to pos\n    limit = pos & STBDS_BUCKET_MASK;\n    for (i = 0; i < limit; ++i) {\n      if (bucket->hash[i] == hash) {\n        if (stbds_is_key_equal(a, elemsize, key, keysize, keyoffset, mode, bucket->index[i])) {\n          return (pos & ~STBDS_BUCKET_MASK)+i;\n        }\n      } else if (bucket->hash[i] == STBDS_HASH_EMPTY) {\n        return -1;\n      }\n    }\n\n    // quadratic probing\n    pos += step;\n    step += STBDS_BUCKET_LENGTH;\n    pos &= (table->slot_count-1);\n  }\n  /* NOTREACHED */\n}\n\nvoid * stbds_hmget_key_ts(void *a, size_t elemsize, void *key, size_t keysize, ptrdiff_t *temp, int mode)\n{\n  size_t keyoffset = 0;\n  if (a == NULL) {\n    // make it non-empty so we can return a temp\n    a = stbds_arrgrowf(0, elemsize, 0, 1);\n    stbds_header(a)->length += 1;\n    memset(a, 0, elemsize);\n    *temp = STBDS_INDEX_EMPTY;\n    // adjust a to point after the default element\n    return STBDS_ARR_TO_HASH(a,elemsize);\n  } else {\n    stbds_hash_index *table;\n    void *raw_a = STBDS_HASH_TO_ARR(a,elemsize);\n    // adjust a to point to the default element\n    table = (stbds_hash_index *) stbds_header(raw_a)->hash_table;\n    if (table == 0) {\n      *temp = -1;\n    } else {\n      ptrdiff_t slot = stbds_hm_find_slot(a, elemsize, key, keysize, keyoffset, mode);\n      if (slot < 0) {\n        *temp = STBDS_INDEX_EMPTY;\n      } else {\n        stbds_hash_bucket *b = &table->storage[slot >> STBDS_BUCKET_SHIFT];\n        *temp = b->index[slot & STBDS_BUCKET_MASK];\n      }\n    }\n    return a;\n  }\n}\n\nvoid * stbds_hmget_key(void *a, size_t elemsize, void *key, size_t keysize, int mode)\n{\n  ptrdiff_t temp;\n  void *p = stbds_hmget_key_ts(a, elemsize, key, keysize, &temp, mode);\n  stbds_temp(STBDS_HASH_TO_ARR(p,elemsize)) = temp;\n  return p;\n}\n\nvoid * stbds_hmput_default(void *a, size_t elemsize)\n{\n  // three cases:\n  //   a is NULL <- allocate\n  //   a has a hash table but no entries, because of shmode <- grow\n  //   a has entries <- do nothing\n  if (a == NULL || stbds_header(STBDS_HASH_TO_ARR(a,elemsize))->length == 0) {\n    a = stbds_arrgrowf(a ? STBDS_HASH_TO_ARR(a,elemsize) : NULL, elemsize, 0, 1);\n    stbds_header(a)->length += 1;\n    memset(a, 0, elemsize);\n    a=STBDS_ARR_TO_HASH(a,elemsize);\n  }\n  return a;\n}\n\nstatic char *stbds_strdup(char *str);\n\nvoid *stbds_hmput_key(void *a, size_t elemsize, void *key, size_t keysize, int mode)\n{\n  size_t keyoffset=0;\n  void *raw_a;\n  stbds_hash_index *table;\n\n  if (a == NULL) {\n    a = stbds_arrgrowf(0, elemsize, 0, 1);\n    memset(a, 0, elemsize);\n    stbds_header(a)->length += 1;\n    // adjust a to point AFTER the default element\n    a = STBDS_ARR_TO_HASH(a,elemsize);\n  }\n\n  // adjust a to point to the default element\n  raw_a = a;\n  a = STBDS_HASH_TO_ARR(a,elemsize);\n\n  table = (stbds_hash_index *) stbds_header(a)->hash_table;\n\n  if (table == NULL || table->used_count >= table->used_count_threshold) {\n    stbds_hash_index *nt;\n    size_t slot_count;\n\n    slot_count = (table == NULL) ? STBDS_BUCKET_LENGTH : table->slot_count*2;\n    nt = stbds_make_hash_index(slot_count, table);\n    if (table)\n      STBDS_FREE(NULL, table);\n    else\n      nt->string.mode = mode >= STBDS_HM_STRING ? STBDS_SH_DEFAULT : 0;\n    stbds_header(a)->hash_table = table = nt;\n    STBDS_STATS(++stbds_hash_grow);\n  }\n\n  // we iterate hash table explicitly because we want to track if we saw a tombstone\n  {\n    size_t hash = mode >= STBDS_HM_STRING ? stbds_hash_string((char*)key,table->seed) : stbds_hash_bytes(key, keysize,table->seed);\n    size_t step = STBDS_BUCKET_LENGTH;\n    size_t pos;\n    ptrdiff_t tombstone = -1;\n    stbds_hash_bucket *bucket;\n\n    // stored hash values are forbidden from being 0, so we can detect empty slots to early out quickly\n    if (hash < 2) hash += 2;\n\n    pos = stbds_probe_position(hash, table->slot_count, table->slot_count_log2);\n\n    for (;;) {\n      size_t limit, i;\n      STBDS_STATS(++stbds_hash_probes);\n      bucket = &table->storage[pos >> STBDS_BUCKET_SHIFT];\n\n      // start searching from pos to end of bucket\n      for (i=pos & STBDS_BUCKET_MASK; i < STBDS_BUCKET_LENGTH; ++i) {\n        if (bucket->hash[i] == hash) {\n          if (stbds_is_key_equal(raw_a, elemsize, key, keysize, keyoffset, mode, bucket->index[i])) {\n            stbds_temp(a) = bucket->index[i];\n            if (mode >= STBDS_HM_STRING)\n              stbds_temp_key(a) = * (char **) ((char *) raw_a + elemsize*bucket->index[i] + keyoffset);\n            return STBDS_ARR_TO_HASH(a,elemsize);\n          }\n        } else if (bucket->hash[i] == 0) {\n          pos = (pos & ~STBDS_BUCKET_MASK) + i;\n          goto found_empty_slot;\n        } else if (tombstone < 0) {\n          if (bucket->index[i] == STBDS_INDEX_DELETED)\n            tombstone = (ptrdiff_t) ((pos & ~STBDS_BUCKET_MASK) + i);\n        }\n      }\n\n      // search from beginning of bucket to pos\n      limit = pos & STBDS_BUCKET_MASK;\n      for (i = 0; i < limit; ++i) {\n        if (bucket->hash[i] == hash) {\n          if (stbds_is_key_equal(raw_a, elemsize, key, keysize, keyoffset, mode, bucket->index[i])) {\n            stbds_temp(a) = bucket->index[i];\n            return STBDS_ARR_TO_HASH(a,elemsize);\n          }\n        } else if (bucket->hash[i] == 0) {\n          pos = (pos & ~STBDS_BUCKET_MASK) + i;\n          goto found_empty_slot;\n        } else if (tombstone < 0) {\n          if (bucket->index[i] == STBDS_INDEX_DELETED)\n            tombstone = (ptrdiff_t) ((pos & ~STBDS_BUCKET_MASK) + i);\n        }\n      }\n\n      // quadratic probing\n      pos += step;\n      step += STBDS_BUCKET_LENGTH;\n      pos &= (table->slot_count-1);\n    }\n   found_empty_slot:\n    if (tombstone >= 0) {\n      pos = tombstone;\n      --table->tombstone_count;\n    }\n    ++table->used_count;\n\n    {\n      ptrdiff_t i = (ptrdiff_t) stbds_arrlen(a);\n      // we want to do stbds_arraddn(1), but we can't use the macros since we don't have something of the right type\n      if ((size_t) i+1 > stbds_arrcap(a))\n        *(void **) &a = stbds_arrgrowf(a, elemsize, 1, 0);\n      raw_a = STBDS_ARR_TO_HASH(a,elemsize);\n\n      STBDS_ASSERT((size_t) i+1 <= stbds_arrcap(a));\n      stbds_header(a)->length = i+1;\n      bucket = &table->storage[pos >> STBDS_BUCKET_SHIFT];\n      bucket->hash[pos & STBDS_BUCKET_MASK] = hash;\n      bucket->index[pos & STBDS_BUCKET_MASK] = i-1;\n      stbds_temp(a) = i-1;\n\n      switch (table->string.mode) {\n         case STBDS_SH_STRDUP:  stbds_temp_key(a) = *(char **) ((char *) a + elemsize*i) = stbds_strdup((char*) key); break;\n         case STBDS_SH_ARENA:   stbds_temp_key(a) = *(char **) ((char *) a + elemsize*i) = stbds_stralloc(&table->string, (char*)key); break;\n         case STBDS_SH_DEFAULT: stbds_temp_key(a) = *(char **) ((char *) a + elemsize*i) = (char *) key; break;\n         default:                memcpy((char *) a + elemsize*i, key, keysize); break;\n      }\n    }\n    return STBDS_ARR_TO_HASH(a,elemsize);\n  }\n}\n\nvoid * stbds_shmode_func(size_t elemsize, int mode)\n{\n  void *a = stbds_arrgrowf(0, elemsize, 0, 1);\n  stbds_hash_index *h;\n  memset(a, 0, elemsize);\n  stbds_header(a)->length = 1;\n  stbds_header(a)->hash_table = h = (stbds_hash_index *) stbds_make_hash_index(STBDS_BUCKET_LENGTH, NULL);\n  h->string.mode = (unsigned char) mode;\n  return STBDS_ARR_TO_HASH(a,elemsize);\n}\n\nvoid * stbds_hmdel_key(void *a, size_t elemsize, void *key, size_t keysize, size_t keyoffset, int mode)\n{\n  if (a == NULL) {\n    return 0;\n  } else {\n    stbds_hash_index *table;\n    void *raw_a = STBDS_HASH_TO_ARR(a,elemsize);\n    table = (stbds_hash_index *) stbds_header(raw_a)->hash_table;\n    stbds_temp(raw_a) = 0;\n    if (table == 0) {\n      return a;\n    } else {\n      ptrdiff_t slot;\n      slot = stbds_hm_find_slot(a, elemsize, key, keysize, keyoffset, mode);\n      if (slot < 0)\n        return a;\n      else {\n        stbds_hash_bucket *b = &table->storage[slot >> STBDS_BUCKET_SHIFT];\n        int i = slot & STBDS_BUCKET_MASK;\n        ptrdiff_t old_index = b->index[i];\n        ptrdiff_t final_index = (ptrdiff_t) stbds_arrlen(raw_a)-1-1; // minus one for the raw_a vs a, and minus one for 'last'\n        STBDS_ASSERT(slot < (ptrdiff_t) table->slot_count);\n        --table->used_count;\n        ++table->tombstone_count;\n        stbds_temp(raw_a) = 1;\n        STBDS_ASSERT(table->used_count >= 0);\n        //STBDS_ASSERT(table->tombstone_count < table->slot_count/4);\n        b->hash[i] = STBDS_HASH_DELETED;\n        b->index[i] = STBDS_INDEX_DELETED;\n\n        if (mode == STBDS_HM_STRING && table->string.mode == STBDS_SH_STRDUP)\n          STBDS_FREE(NULL, *(char**) ((char *) a+elemsize*old_index));\n\n        // if indices are the same, memcpy is a no-op, but back-pointer-fixup will fail, so skip\n        if (old_index != final_index) {\n          // swap delete\n          memmove((char*) a + elemsize*old_index, (char*) a + elemsize*final_index, elemsize);\n\n          // now find the slot for the last element\n          if (mode == STBDS_HM_STRING)\n            slot = stbds_hm_find_slot(a, elemsize, *(char**) ((char *) a+elemsize*old_index + keyoffset), keysize, keyoffset, mode);\n          else\n            slot = stbds_hm_find_slot(a, elemsize,  (char* ) a+elemsize*old_index + keyoffset, keysize, keyoffset, mode);\n          STBDS_ASSERT(slot >= 0);\n          b = &table->storage[slot >> STBDS_BUCKET_SHIFT];\n          i = slot & STBDS_BUCKET_MASK;\n          STBDS_ASSERT(b->index[i] == final_index);\n          b->index[i] = old_index;\n        }\n        stbds_header(raw_a)->length -= 1;\n\n        if (table->used_count < table->used_count_shrink_threshold && table->slot_count > STBDS_BUCKET_LENGTH) {\n          stbds_header(raw_a)->hash_table = stbds_make_hash_index(table->slot_count>>1, table);\n          STBDS_FREE(NULL, table);\n          STBDS_STATS(++stbds_hash_shrink);\n        } else if (table->tombstone_count > table->tombstone_count_threshold) {\n          stbds_header(raw_a)->hash_table = stbds_make_hash_index(table->slot_count   , table);\n          STBDS_FREE(NULL, table);\n          STBDS_STATS(++stbds_hash_rebuild);\n        }\n\n        return a;\n      }\n    }\n  }\n  /* NOTREACHED */\n}\n\nstatic char *stbds_strdup(char *str)\n{\n  // to keep replaceable allocator simple, we don't want to use strdup.\n  // rolling our own also avoids problem of strdup vs _strdup\n  size_t len = strlen(str)+1;\n  char *p = (char*) STBDS_REALLOC(NULL, 0, len);\n  memmove(p, str, len);\n  return p;\n}\n\n#ifndef STBDS_STRING_ARENA_BLOCKSIZE_MIN\n#define STBDS_STRING_ARENA_BLOCKSIZE_MIN  512u\n#endif\n#ifndef STBDS_STRING_ARENA_BLOCKSIZE_MAX\n#define STBDS_STRING_ARENA_BLOCKSIZE_MAX  (1u<<20)\n#endif\n\nchar *stbds_stralloc(stbds_string_arena *a, char *str)\n{\n  char *p;\n  size_t len = strlen(str)+1;\n  if (len > a->remaining) {\n    // compute the next blocksize\n    size_t blocksize = a->block;\n\n    // size is 512, 512, 1024, 1024, 2048, 2048, 4096, 4096, etc., so that\n    // there are log(SIZE) allocations to free when we destroy the table\n    blocksize = (size_t) (STBDS_STRING_ARENA_BLOCKSIZE_MIN) << (blocksize>>1);\n\n    // if size is under 1M, advance to next blocktype\n    if (blocksize < (size_t)(STBDS_STRING_ARENA_BLOCKSIZE_MAX))\n      ++a->block;\n\n    if (len > blocksize) {\n      // if string is larger than blocksize, then just allocate the full size.\n      // note that we still advance string_block so block size will continue\n      // increasing, so e.g. if somebody only calls this with 1000-long strings,\n      // eventually the arena will start doubling and handling those as well\n      stbds_string_block *sb = (stbds_string_block *) STBDS_REALLOC(NULL, 0, sizeof(*sb)-8 + len);\n      memmove(sb->storage, str, len);\n      if (a->storage) {\n        // insert it after the first element, so that we don't waste the space there\n        sb->next = a->storage->next;\n        a->storage->next = sb;\n      } else {\n        sb->next = 0;\n        a->storage = sb;\n        a->remaining = 0; // this is redundant, but good for clarity\n      }\n      return sb->storage;\n    } else {\n      stbds_string_block *sb = (stbds_string_block *) STBDS_REALLOC(NULL, 0, sizeof(*sb)-8 + blocksize);\n      sb->next = a->storage;\n      a->storage = sb;\n      a->remaining = blocksize;\n    }\n  }\n\n  STBDS_ASSERT(len <= a->remaining);\n  p = a->storage->storage + a->remaining - len;\n  a->remaining -= len;\n  memmove(p, str, len);\n  return p;\n}\n\nvoid stbds_strreset(stbds_string_arena *a)\n{\n  stbds_string_block *x,*y;\n  x = a->storage;\n  while (x) {\n    y = x->next;\n    STBDS_FREE(NULL, x);\n    x = y;\n  }\n  memset(a, 0, sizeof(*a));\n}\n\n#endif\n\n//////////////////////////////////////////////////////////////////////////////\n//\n//   UNIT TESTS\n//\n\n#ifdef STBDS_UNIT_TESTS\n#include <stdio.h>\n#ifdef STBDS_ASSERT_WAS_UNDEFINED\n#undef STBDS_ASSERT\n#endif\n#ifndef STBDS_ASSERT\n#define STBDS_ASSERT assert\n#include <assert.h>\n#endif\n\ntypedef struct { int key,b,c,d; } stbds_struct;\ntypedef struct { int key[2],b,c,d; } stbds_struct2;\n\nstatic char buffer[256];\nchar *strkey(int n)\n{\n#if defined(_WIN32) && defined(__STDC_WANT_SECURE_LIB__)\n   sprintf_s(buffer, sizeof(buffer), \"test_%d\", n);\n#else\n   sprintf(buffer, \"test_%d\", n);\n#endif\n   return buffer;\n}\n\nvoid stbds_unit_tests(void)\n{\n#if defined(_MSC_VER) && _MSC_VER <= 1200 && defined(__cplusplus)\n  // VC6 C++ doesn't like the template<> trick on unnamed structures, so do nothing!\n  STBDS_ASSERT(0);\n#else\n  const int testsize = 100000;\n  const int testsize2 = testsize/20;\n  int *arr=NULL;\n  struct { int   key;        int value; }  *intmap  = NULL;\n  struct { char *key;        int value; }  *strmap  = NULL, s;\n  struct { stbds_struct key; int value; }  *map     = NULL;\n  stbds_struct                             *map2    = NULL;\n  stbds_struct2                            *map3    = NULL;\n  stbds_string_arena                        sa      = { 0 };\n  int key3[2] = { 1,2 };\n  ptrdiff_t temp;\n\n  int i,j;\n\n  STBDS_ASSERT(arrlen(arr)==0);\n  for (i=0; i < 20000; i += 50) {\n    for (j=0; j < i; ++j)\n      arrpush(arr,j);\n    arrfree(arr);\n  }\n\n  for (i=0; i < 4; ++i) {\n    arrpush(arr,1); arrpush(arr,2); arrpush(arr,3); arrpush(arr,4);\n    arrdel(arr,i);\n    arrfree(arr);\n    arrpush(arr,1); arrpush(arr,2); arrpush(arr,3); arrpush(arr,4);\n    arrdelswap(arr,i);\n    arrfree(arr);\n  }\n\n  for (i=0; i < 5; ++i) {\n    arrpush(arr,1); arrpush(arr,2); arrpush(arr,3); arrpush(arr,4);\n    stbds_arrins(arr,i,5);\n    STBDS_ASSERT(arr[i] == 5);\n    if (i < 4)\n      STBDS_ASSERT(arr[4] == 4);\n    arrfree(arr);\n  }\n\n  i = 1;\n  STBDS_ASSERT(hmgeti(intmap,i) == -1);\n  hmdefault(intmap, -2);\n  STBDS_ASSERT(hmgeti(intmap, i) == -1);\n  STBDS_ASSERT(hmget (intmap, i) == -2);\n  for (i=0; i < testsize; i+=2)\n    hmput(intmap, i, i*5);\n  for (i=0; i < testsize; i+=1) {\n    if (i & 1) STBDS_ASSERT(hmget(intmap, i) == -2 );\n    else       STBDS_ASSERT(hmget(intmap, i) == i*5);\n    if (i & 1) STBDS_ASSERT(hmget_ts(intmap, i, temp) == -2 );\n    else       STBDS_ASSERT(hmget_ts(intmap, i, temp) == i*5);\n  }\n  for (i=0; i < testsize; i+=2)\n    hmput(intmap, i, i*3);\n  for (i=0; i < testsize; i+=1)\n    if (i & 1) STBDS_ASSERT(hmget(intmap, i) == -2 );\n    else       STBDS_ASSERT(hmget(intmap, i) == i*3);\n  for (i=2; i < testsize; i+=4)\n    hmdel(intmap, i); // delete half the entries\n  for (i=0; i < testsize; i+=1)\n    if (i & 3) STBDS_ASSERT(hmget(intmap, i) == -2 );\n    else       STBDS_ASSERT(hmget(intmap, i) == i*3);\n  for (i=0; i < testsize; i+=1)\n    hmdel(intmap, i); // delete the rest of the entries\n  for (i=0; i < testsize; i+=1)\n    STBDS_ASSERT(hmget(intmap, i) == -2 );\n  hmfree(intmap);\n  for (i=0; i < testsize; i+=2)\n    hmput(intmap, i, i*3);\n  hmfree(intmap);\n\n  #if defined(__clang__) || defined(__GNUC__)\n  #ifndef __cplusplus\n  intmap = NULL;\n  hmput(intmap, 15, 7);\n  hmput(intmap, 11, 3);\n  hmput(intmap,  9, 5);\n  STBDS_ASSERT(hmget(intmap, 9) == 5);\n  STBDS_ASSERT(hmget(intmap, 11) == 3);\n  STBDS_ASSERT(hmget(intmap, 15) == 7);\n  #endif\n  #endif\n\n  for (i=0; i < testsize; ++i)\n    stralloc(&sa, strkey(i));\n  strreset(&sa);\n\n  {\n    s.key = \"a\", s.value = 1;\n    shputs(strmap, s);\n    STBDS_ASSERT(*strmap[0].key == 'a');\n    STBDS_ASSERT(strmap[0].key == s.key);\n    STBDS_ASSERT(strmap[0].value == s.value);\n    shfree(strmap);\n  }\n\n  {\n    s.key = \"a\", s.value = 1;\n    sh_new_strdup(strmap);\n    shputs(strmap, s);\n    STBDS_ASSERT(*strmap[0].key == 'a');\n    STBDS_ASSERT(strmap[0].key != s.key);\n    STBDS_ASSERT(strmap[0].value == s.value);\n    shfree(strmap);\n  }\n\n  {\n    s.key = \"a\", s.value = 1;\n    sh_new_arena(strmap);\n    shputs(strmap, s);\n    STBDS_ASSERT(*strmap[0].key == 'a');\n    STBDS_ASSERT(strmap[0].key != s.key);\n    STBDS_ASSERT(strmap[0].value == s.value);\n    shfree(strmap);\n  }\n\n  for (j=0; j < 2; ++j) {\n    STBDS_ASSERT(shgeti(strmap,\"foo\") == -1);\n    if (j == 0)\n      sh_new_strdup(strmap);\n    else\n      sh_new_arena(strmap);\n    STBDS_ASSERT(shgeti(strmap,\"foo\") == -1);\n    shdefault(strmap, -2);\n    STBDS_ASSERT(shgeti(strmap,\"foo\") == -1);\n    for (i=0; i < testsize; i+=2)\n      shput(strmap, strkey(i), i*3);\n    for (i=0; i < testsize; i+=1)\n      if (i & 1) STBDS_ASSERT(shget(strmap, strkey(i)) == -2 );\n      else       STBDS_ASSERT(shget(strmap, strkey(i)) == i*3);\n    for (i=2; i < testsize; i+=4)\n      shdel(strmap, strkey(i)); // delete half the entries\n    for (i=0; i < testsize; i+=1)\n      if (i & 3) STBDS_ASSERT(shget(strmap, strkey(i)) == -2 );\n      else       STBDS_ASSERT(shget(strmap, strkey(i)) == i*3);\n    for (i=0; i < testsize; i+=1)\n      shdel(strmap, strkey(i)); // delete the rest of the entries\n    for (i=0; i < testsize; i+=1)\n      STBDS_ASSERT(shget(strmap, strkey(i)) == -2 );\n    shfree(strmap);\n  }\n\n  {\n    struct { char *key; char value; } *hash = NULL;\n    char name[4] = \"jen\";\n    shput(hash, \"bob\"   , 'h');\n    shput(hash, \"sally\" , 'e');\n    shput(hash, \"fred\"  , 'l');\n    shput(hash, \"jen\"   , 'x');\n    shput(hash, \"doug\"  , 'o');\n\n    shput(hash, name    , 'l');\n    shfree(hash);\n  }\n\n  for (i=0; i < testsize; i += 2) {\n    stbds_struct s = { i,i*2,i*3,i*4 };\n    hmput(map, s, i*5);\n  }\n\n  for (i=0; i < testsize; i += 1) {\n    stbds_struct s = { i,i*2,i*3  ,i*4 };\n    stbds_struct t = { i,i*2,i*3+1,i*4 };\n    if (i & 1) STBDS_ASSERT(hmget(map, s) == 0);\n    else       STBDS_ASSERT(hmget(map, s) == i*5);\n    if (i & 1) STBDS_ASSERT(hmget_ts(map, s, temp) == 0);\n    else       STBDS_ASSERT(hmget_ts(map, s, temp) == i*5);\n    //STBDS_ASSERT(hmget(map, t.key) == 0);\n  }\n\n  for (i=0; i < testsize; i += 2) {\n    stbds_struct s = { i,i*2,i*3,i*4 };\n    hmputs(map2, s);\n  }\n  hmfree(map);\n\n  for (i=0; i < testsize; i += 1) {\n    stbds_struct s = { i,i*2,i*3,i*4 };\n    stbds_struct t = { i,i*2,i*3+1,i*4 };\n    if (i & 1) STBDS_ASSERT(hmgets(map2, s.key).d == 0);\n    else       STBDS_ASSERT(hmgets(map2, s.key).d == i*4);\n    //STBDS_ASSERT(hmgetp(map2, t.key) == 0);\n  }\n  hmfree(map2);\n\n  for (i=0; i < testsize; i += 2) {\n    stbds_struct2 s = { { i,i*2 }, i*3,i*4, i*5 };\n    hmputs(map3, s);\n  }\n  for (i=0; i < testsize; i += 1) {\n    stbds_struct2 s = { { i,i*2}, i*3, i*4, i*5 };\n    stbds_struct2 t = { { i,i*2}, i*3+1, i*4, i*5 };\n    if (i & 1) STBDS_ASSERT(hmgets(map3, s.key).d == 0);\n    else       STBDS_ASSERT(hmgets(map3, s.key).d == i*5);\n    //STBDS_ASSERT(hmgetp(map3, t.key) == 0);\n  }\n#endif\n}\n#endif\n\n\n/*\n------------------------------------------------------------------------------\nThis software is available under 2 licenses -- choose whichever you prefer.\n------------------------------------------------------------------------------\nALTERNATIVE A - MIT License\nCopyright (c) 2019 Sean Barrett\nPermission is hereby granted, free of charge, to any person obtaining a copy of\nthis software and associated documentation files (the \"Software\"), to deal in\nthe Software without restriction, including without limitation the rights to\nuse, copy, modify, merge, publish, distribute, sublicense, and/or sell copies\nof the Software, and to permit persons to whom the Software is furnished to do\nso, subject to the following conditions:\nThe above copyright notice and this permission notice shall be included in all\ncopies or substantial portions of the Software.\nTHE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR\nIMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,\nFITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE\nAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER\nLIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,\nOUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE\nSOFTWARE.\n------------------------------------------------------------------------------\nALTERNATIVE B - Public Domain (www.unlicense.org)\nThis is free and unencumbered software released into the public domain.\nAnyone is free to copy, modify, publish, use, compile, sell, or distribute this\nsoftware, either in source code form or as a compiled binary, for any purpose,\ncommercial or non-commercial, and by any means.\nIn jurisdictions that recognize copyright laws, the author or authors of this\nsoftware dedicate any and all copyright interest in the software to the public\ndomain. We make this dedication for the benefit of the public at large and to\nthe detriment of our heirs and successors. We intend this dedication to be an\novert act of relinquishment in perpetuity of all present and future rights to\nthis software under copyright law.\nTHE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR\nIMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,\nFITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE\nAUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN\nACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION\nWITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.\n------------------------------------------------------------------------------\n*/";
+const char *SRC_SDS_C = "/* SDSLib 2.0 -- A C dynamic strings library\n *\n * Copyright (c) 2006-2015, Salvatore Sanfilippo <antirez at gmail dot com>\n * Copyright (c) 2015, Oran Agra\n * Copyright (c) 2015, Redis Labs, Inc\n * All rights reserved.\n *\n * Redistribution and use in source and binary forms, with or without\n * modification, are permitted provided that the following conditions are met:\n *\n *   * Redistributions of source code must retain the above copyright notice,\n *     this list of conditions and the following disclaimer.\n *   * Redistributions in binary form must reproduce the above copyright\n *     notice, this list of conditions and the following disclaimer in the\n *     documentation and/or other materials provided with the distribution.\n *   * Neither the name of Redis nor the names of its contributors may be used\n *     to endorse or promote products derived from this software without\n *     specific prior written permission.\n *\n * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS \"AS IS\"\n * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE\n * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE\n * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE\n * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR\n * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF\n * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS\n * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)\n * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE\n * POSSIBILITY OF SUCH DAMAGE.\n */\n\n#include <stdio.h>\n#include <stdlib.h>\n#include <string.h>\n#include <ctype.h>\n#include <assert.h>\n#include <limits.h>\n#include \"sds.h\"\n#include \"sdsalloc.h\"\n\nconst char *SDS_NOINIT = \"SDS_NOINIT\";\n\nstatic inline int sdsHdrSize(char type) {\n    switch(type&SDS_TYPE_MASK) {\n        case SDS_TYPE_5:\n            return sizeof(struct sdshdr5);\n        case SDS_TYPE_8:\n            return sizeof(struct sdshdr8);\n        case SDS_TYPE_16:\n            return sizeof(struct sdshdr16);\n        case SDS_TYPE_32:\n            return sizeof(struct sdshdr32);\n        case SDS_TYPE_64:\n            return sizeof(struct sdshdr64);\n    }\n    return 0;\n}\n\nstatic inline char sdsReqType(size_t string_size) {\n    if (string_size < 1<<5)\n        return SDS_TYPE_5;\n    if (string_size < 1<<8)\n        return SDS_TYPE_8;\n    if (string_size < 1<<16)\n        return SDS_TYPE_16;\n#if (LONG_MAX == LLONG_MAX)\n    if (string_size < 1ll<<32)\n        return SDS_TYPE_32;\n    return SDS_TYPE_64;\n#else\n    return SDS_TYPE_32;\n#endif\n}\n\n/* Create a new sds string with the content specified by the 'init' pointer\n * and 'initlen'.\n * If NULL is used for 'init' the string is initialized with zero bytes.\n * If SDS_NOINIT is used, the buffer is left uninitialized;\n *\n * The string is always null-terminated (all the sds strings are, always) so\n * even if you create an sds string with:\n *\n * mystring = sdsnewlen(\"abc\",3);\n *\n * You can print the string with printf() as there is an implicit \\0 at the\n * end of the string. However the string is binary safe and can contain\n * \\0 characters in the middle, as the length is stored in the sds header. */\nsds sdsnewlen(const void *init, size_t initlen) {\n    void *sh;\n    sds s;\n    char type = sdsReqType(initlen);\n    /* Empty strings are usually created in order to append. Use type 8\n     * since type 5 is not good at this. */\n    if (type == SDS_TYPE_5 && initlen == 0) type = SDS_TYPE_8;\n    int hdrlen = sdsHdrSize(type);\n    unsigned char *fp; /* flags pointer. */\n\n    sh = s_malloc(hdrlen+initlen+1);\n    if (sh == NULL) return NULL;\n    if (init==SDS_NOINIT)\n        init = NULL;\n    else if (!init)\n        memset(sh, 0, hdrlen+initlen+1);\n    s = (char*)sh+hdrlen;\n    fp = ((unsigned char*)s)-1;\n    switch(type) {\n        case SDS_TYPE_5: {\n            *fp = type | (initlen << SDS_TYPE_BITS);\n            break;\n        }\n        case SDS_TYPE_8: {\n            SDS_HDR_VAR(8,s);\n            sh->len = initlen;\n            sh->alloc = initlen;\n            *fp = type;\n            break;\n        }\n        case SDS_TYPE_16: {\n            SDS_HDR_VAR(16,s);\n            sh->len = initlen;\n            sh->alloc = initlen;\n            *fp = type;\n            break;\n        }\n        case SDS_TYPE_32: {\n            SDS_HDR_VAR(32,s);\n            sh->len = initlen;\n            sh->alloc = initlen;\n            *fp = type;\n            break;\n        }\n        case SDS_TYPE_64: {\n            SDS_HDR_VAR(64,s);\n            sh->len = initlen;\n            sh->alloc = initlen;\n            *fp = type;\n            break;\n        }\n    }\n    if (initlen && init)\n        memcpy(s, init, initlen);\n    s[initlen] = '\\0';\n    return s;\n}\n\n/* Create an empty (zero length) sds string. Even in this case the string\n * always has an implicit null term. */\nsds sdsempty(void) {\n    return sdsnewlen(\"\",0);\n}\n\n/* Create a new sds string starting from a null terminated C string. */\nsds sdsnew(const char *init) {\n    size_t initlen = (init == NULL) ? 0 : strlen(init);\n    return sdsnewlen(init, initlen);\n}\n\n/* Duplicate an sds string. */\nsds sdsdup(const sds s) {\n    return sdsnewlen(s, sdslen(s));\n}\n\n/* Free an sds string. No operation is performed if 's' is NULL. */\nvoid sdsfree(sds s) {\n    if (s == NULL || SDS_IS_STATIC(s)) return;\n    s_free((char*)s-sdsHdrSize(s[-1]));\n}\n\n/* Set the sds string length to the length as obtained with strlen(), so\n * considering as content only up to the first null term character.\n *\n * This function is useful when the sds string is hacked manually in some\n * way, like in the following example:\n *\n * s = sdsnew(\"foobar\");\n * s[2] = '\\0';\n * sdsupdatelen(s);\n * printf(\"%d\\n\", sdslen(s));\n *\n * The output will be \"2\", but if we comment out the call to sdsupdatelen()\n * the output will be \"6\" as the string was modified but the logical length\n * remains 6 bytes. */\nvoid sdsupdatelen(sds s) {\n    size_t reallen = strlen(s);\n    sdssetlen(s, reallen);\n}\n\n/* Modify an sds string in-place to make it empty (zero length).\n * However all the existing buffer is not discarded but set as free space\n * so that next append operations will not require allocations up to the\n * number of bytes previously available. */\nvoid sdsclear(sds s) {\n    sdssetlen(s, 0);\n    s[0] = '\\0';\n}\n\n/* Enlarge the free space at the end of the sds string so that the caller\n * is sure that after calling this function can overwrite up to addlen\n * bytes after the end of the string, plus one more byte for nul term.\n *\n * Note: this does not change the *length* of the sds string as returned\n * by sdslen(), but only the free buffer space we have. */\nsds sdsMakeRoomFor(sds s, size_t addlen) {\n    void *sh, *newsh;\n    size_t avail = sdsavail(s);\n    size_t len, newlen, reqlen;\n    char type, oldtype = s[-1] & SDS_TYPE_MASK;\n    int hdrlen;\n\n    /* Static strings are never written: grow a heap copy. */\n    if (SDS_IS_STATIC(s)) {\n        s = sdsnewlen(s, sdslen(s));\n        if (s == NULL) return NULL;\n        avail = sdsavail(s);\n        oldtype = s[-1] & SDS_TYPE_MASK;\n    }\n\n    /* Return ASAP if there is enough space left. */\n    if (avail >= addlen) return s;\n\n    len = sdslen(s);\n    sh = (char*)s-sdsHdrSize(oldtype);\n    reqlen = newlen = (len+addlen);\n    if (newlen < SDS_MAX_PREALLOC)\n        newlen *= 2;\n    else\n        newlen += SDS_MAX_PREALLOC;\n\n    type = sdsReqType(newlen);\n\n    /* Don't use type 5: the user is appending to the string and type 5 is\n     * not able to remember empty space, so sdsMakeRoomFor() must be called\n     * at every appending operation. */\n    if (type == SDS_TYPE_5) type = SDS_TYPE_8;\n\n    hdrlen = sdsHdrSize(type);\n    assert(hdrlen + newlen + 1 > reqlen); /* Catch size_t overflow */\n    if (oldtype==type) {\n        newsh = s_realloc(sh, hdrlen+newlen+1);\n        if (newsh == NULL) return NULL;\n        s = (char*)newsh+hdrlen;\n    } else {\n        /* Since the header size changes, need to move the string forward,\n         * and can't use realloc */\n        newsh = s_malloc(hdrlen+newlen+1);\n        if (newsh == NULL) return NULL;\n        memcpy((char*)newsh+hdrlen, s, len+1);\n        s_free(sh);\n        s = (char*)newsh+hdrlen;\n        s[-1] = type;\n        sdssetlen(s, len);\n    }\n    sdssetalloc(s, newlen);\n    return s;\n}\n\n/* Reallocate the sds string so that it has no free space at the end. The\n * contained string remains not altered, but next concatenation operations\n * will require a reallocation.\n *\n * After the call, the passed sds string is no longer valid and all the\n * references must be substituted with the new pointer returned by the call. */\nsds sdsRemoveFreeSpace(sds s) {\n    void *sh, *newsh;\n    char type, oldtype = s[-1] & SDS_TYPE_MASK;\n    int hdrlen, oldhdrlen = sdsHdrSize(oldtype);\n    size_t len = sdslen(s);\n    size_t avail = sdsavail(s);\n    sh = (char*)s-oldhdrlen;\n\n    /* Return ASAP if there is no space left. */\n    if (avail == 0) return s;\n\n    /* Check what would be the minimum SDS header that is just good enough to\n     * fit this string. */\n    type = sdsReqType(len);\n    hdrlen = sdsHdrSize(type);\n\n    /* If the type is the same, or at least a large enough type is still\n     * required, we just realloc(), letting the allocator to do the copy\n     * only if really needed. Otherwise if the change is huge, we manually\n     * reallocate the string to use the different header type. */\n    if (oldtype==type || type > SDS_TYPE_8) {\n        newsh = s_realloc(sh, oldhdrlen+len+1);\n        if (newsh == NULL) return NULL;\n        s = (char*)newsh+oldhdrlen;\n    } else {\n        newsh = s_malloc(hdrlen+len+1);\n        if (newsh == NULL) return NULL;\n        memcpy((char*)newsh+hdrlen, s, len+1);\n        s_free(sh);\n        s = (char*)newsh+hdrlen;\n        s[-1] = type;\n        sdssetlen(s, len);\n    }\n    sdssetalloc(s, len);\n    return s;\n}\n\n/* Return the total size of the allocation of the specified sds string,\n * including:\n * 1) The sds header before the pointer.\n * 2) The string.\n * 3) The free buffer at the end if any.\n * 4) The implicit null term.\n */\nsize_t sdsAllocSize(sds s) {\n    size_t alloc = sdsalloc(s);\n    return sdsHdrSize(s[-1])+alloc+1;\n}\n\n/* Return the pointer of the actual SDS allocation (normally SDS strings\n * are referenced by the start of the string buffer). */\nvoid *sdsAllocPtr(sds s) {\n    return (void*) (s-sdsHdrSize(s[-1]));\n}\n\n/* Increment the sds length and decrements the left free space at the\n * end of the string according to 'incr'. Also set the null term\n * in the new end of the string.\n *\n * This function is used in order to fix the string length after the\n * user calls sdsMakeRoomFor(), writes something after the end of\n * the current string, and finally needs to set the new length.\n *\n * Note: it is possible to use a negative increment in order to\n * right-trim the string.\n *\n * Usage example:\n *\n * Using sdsIncrLen() and sdsMakeRoomFor() it is possible to mount the\n * following schema, to cat bytes coming from the kernel to the end of an\n * sds string without copying into an intermediate buffer:\n *\n * oldlen = sdslen(s);\n * s = sdsMakeRoomFor(s, BUFFER_SIZE);\n * nread = read(fd, s+oldlen, BUFFER_SIZE);\n * ... check for nread <= 0 and handle it ...\n * sdsIncrLen(s, nread);\n */\nvoid sdsIncrLen(sds s, ssize_t incr) {\n    unsigned char flags = s[-1];\n    size_t len;\n    switch(flags&SDS_TYPE_MASK) {\n        case SDS_TYPE_5: {\n            unsigned char *fp = ((unsigned char*)s)-1;\n            unsigned char oldlen = SDS_TYPE_5_LEN(flags);\n            assert((incr > 0 && oldlen+incr < 32) || (incr < 0 && oldlen >= (unsigned int)(-incr)));\n            *fp = SDS_TYPE_5 | ((oldlen+incr) << SDS_TYPE_BITS);\n            len = oldlen+incr;\n            break;\n        }\n        case SDS_TYPE_8: {\n            SDS_HDR_VAR(8,s);\n            assert((incr >= 0 && sh->alloc-sh->len >= incr) || (incr < 0 && sh->len >= (unsigned int)(-incr)));\n            len = (sh->len += incr);\n            break;\n        }\n        case SDS_TYPE_16: {\n            SDS_HDR_VAR(16,s);\n            assert((incr >= 0 && sh->alloc-sh->len >= incr) || (incr < 0 && sh->len >= (unsigned int)(-incr)));\n            len = (sh->len += incr);\n            break;\n        }\n        case SDS_TYPE_32: {\n            SDS_HDR_VAR(32,s);\n            assert((incr >= 0 && sh->alloc-sh->len >= (unsigned int)incr) || (incr < 0 && sh->len >= (unsigned int)(-incr)));\n            len = (sh->len += incr);\n            break;\n        }\n        case SDS_TYPE_64: {\n            SDS_HDR_VAR(64,s);\n            assert((incr >= 0 && sh->alloc-sh->len >= (uint64_t)incr) || (incr < 0 && sh->len >= (uint64_t)(-incr)));\n            len = (sh->len += incr);\n            break;\n        }\n        default: len = 0; /* Just to avoid compilation warnings. */\n    }\n    s[len] = '\\0';\n}\n\n/* Grow the sds to have the specified length. Bytes that were not part of\n * the original length of the sds will be set to zero.\n *\n * if the specified length is smaller than the current length, no operation\n * is performed. */\nsds sdsgrowzero(sds s, size_t len) {\n    size_t curlen = sdslen(s);\n\n    if (len <= curlen) return s;\n    s = sdsMakeRoomFor(s,len-curlen);\n    if (s == NULL) return NULL;\n\n    /* Make sure added region doesn't contain garbage */\n    memset(s+curlen,0,(len-curlen+1)); /* also set trailing \\0 byte */\n    sdssetlen(s, len);\n    return s;\n}\n\n/* Append the specified binary-safe string pointed by 't' of 'len' bytes to the\n * end of the specified sds string 's'.\n *\n * After the call, the passed sds string is no longer valid and all the\n * references must be substituted with the new pointer returned by the call. */\nsds sdscatlen(sds s, const void *t, size_t len) {\n    size_t curlen = sdslen(s);\n\n    s = sdsMakeRoomFor(s,len);\n    if (s == NULL) return NULL;\n    memcpy(s+curlen, t, len);\n    sdssetlen(s, curlen+len);\n    s[curlen+len] = '\\0';\n    return s;\n}\n\n/* Append the specified null termianted C string to the sds string 's'.\n *\n * After the call, the passed sds string is no longer valid and all the\n * references must be substituted with the new pointer returned by the call. */\nsds sdscat(sds s, const char *t) {\n    return sdscatlen(s, t, strlen(t));\n}\n\n/* Append the specified sds 't' to the existing sds 's'.\n *\n * After the call, the modified sds string is no longer valid and all the\n * references must be substituted with the new pointer returned by the call. */\nsds sdscatsds(sds s, const sds t) {\n    return sdscatlen(s, t, sdslen(t));\n}\n\n/* Destructively modify the sds string 's' to hold the specified binary\n * safe string pointed by 't' of length 'len' bytes. */\nsds sdscpylen(sds s, const char *t, size_t len) {\n    if (SDS_IS_STATIC(s)) return sdsnewlen(t, len);\n    if (sdsalloc(s) < len) {\n        s = sdsMakeRoomFor(s,len-sdslen(s));\n        if (s == NULL) return NULL;\n    }\n    memcpy(s, t, len);\n    s[len] = '\\0';\n    sdssetlen(s, len);\n    return s;\n}\n\n/* Like sdscpylen() but 't' must be a null-terminated string so that the length\n * of the string is obtained with strlen(). */\nsds sdscpy(sds s, const char *t) {\n    return sdscpylen(s, t, strlen(t));\n}\n\n/* Helper for sdscatlonglong() doing the actual number -> string\n * conversion. 's' must point to a string with room for at least\n * SDS_LLSTR_SIZE bytes.\n *\n * The function returns the length of the null-terminated string\n * representation stored at 's'. */\n#define SDS_LLSTR_SIZE 21\nint sdsll2str(char *s, long long value) {\n    char *p, aux;\n    unsigned long long v;\n    size_t l;\n\n    /* Generate the string representation, this method produces\n     * an reversed string. */\n    if (value < 0) {\n        /* Since v is unsigned, if value==LLONG_MIN then\n         * -LLONG_MIN will overflow. */\n        if (value != LLONG_MIN) {\n            v = -value;\n        } else {\n            v = ((unsigned long long)LLONG_MAX) + 1;\n        }\n    } else {\n        v = value;\n    }\n\n    p = s;\n    do {\n        *p++ = '0'+(v%10);\n        v /= 10;\n    } while(v);\n    if (value < 0) *p++ = '-';\n\n    /* Compute length and add null term. */\n    l = p-s;\n    *p = '\\0';\n\n    /* Reverse the string. */\n    p--;\n    while(s < p) {\n        aux = *s;\n        *s = *p;\n        *p = aux;\n        s++;\n        p--;\n    }\n    return l;\n}\n\n/* Identical sdsll2str(), but for unsigned long long type. */\nint sdsull2str(char *s, unsigned long long v) {\n    char *p, aux;\n    size_t l;\n\n    /* Generate the string representation, this method produces\n     * an reversed string. */\n    p = s;\n    do {\n        *p++ = '0'+(v%10);\n        v /= 10;\n    } while(v);\n\n    /* Compute length and add null term. */\n    l = p-s;\n    *p = '\\0';\n\n    /* Reverse the string. */\n    p--;\n    while(s < p) {\n        aux = *s;\n        *s = *p;\n        *p = aux;\n        s++;\n        p--;\n    }\n    return l;\n}\n\n/* Create an sds string from a long long value. It is much faster than:\n *\n * sdscatprintf(sdsempty(),\"%lld\\n\", value);\n */\nsds sdsfromlonglong(long long value) {\n    char buf[SDS_LLSTR_SIZE];\n    int len = sdsll2str(buf,value);\n\n    return sdsnewlen(buf,len);\n}\n\n/* Like sdscatprintf() but gets va_list instead of being variadic. */\nsds sdscatvprintf(sds s, const char *fmt, va_list ap) {\n    va_list cpy;\n    char staticbuf[1024], *buf = staticbuf, *t;\n    size_t buflen = strlen(fmt)*2;\n    int bufstrlen;\n\n    /* We try to start using a static buffer for speed.\n     * If not possible we revert to heap allocation. */\n    if (buflen > sizeof(staticbuf)) {\n        buf = s_malloc(buflen);\n        if (buf == NULL) return NULL;\n    } else {\n        buflen = sizeof(staticbuf);\n    }\n\n    /* Alloc enough space for buffer and \\0 after failing to\n     * fit the string in the current buffer size. */\n    while(1) {\n        va_copy(cpy,ap);\n        bufstrlen = vsnprintf(buf, buflen, fmt, cpy);\n        va_end(cpy);\n        if (bufstrlen < 0) {\n            if (buf != staticbuf) s_free(buf);\n            return NULL;\n        }\n        if (((size_t)bufstrlen) >= buflen) {\n            if (buf != staticbuf) s_free(buf);\n            buflen = ((size_t)bufstrlen) + 1;\n            buf = s_malloc(buflen);\n            if (buf == NULL) return NULL;\n            continue;\n        }\n        break;\n    }\n\n    /* Finally concat the obtained string to the SDS string and return it. */\n    t = sdscatlen(s, buf, bufstrlen);\n    if (buf != staticbuf) s_free(buf);\n    return t;\n}\n\n/* Append to the sds string 's' a string obtained using printf-alike format\n * specifier.\n *\n * After the call, the modified sds string is no longer valid and all the\n * references must be substituted with the new pointer returned by the call.\n *\n * Example:\n *\n * s = sdsnew(\"Sum is: \");\n * s = sdscatprintf(s,\"%d+%d = %d\",a,b,a+b).\n *\n * Often you need to create a string from scratch with the printf-alike\n * format. When this is the need, just use sdsempty() as the target string:\n *\n * s = sdscatprintf(sdsempty(), \"... your format ...\", args);\n */\nsds sdscatprintf(sds s, const char *fmt, ...) {\n    va_list ap;\n    char *t;\n    va_start(ap, fmt);\n    t = sdscatvprintf(s,fmt,ap);\n    va_end(ap);\n    return t;\n}\n\n/* This function is similar to sdscatprintf, but much faster as it does\n * not rely on sprintf() family functions implemented by the libc that\n * are often very slow. Moreover directly handling the sds string as\n * new data is concatenated provides a performance improvement.\n *\n * However this function only handles an incompatible subset of printf-alike\n * format specifiers:\n *\n * %s - C String\n * %S - SDS string\n * %i - signed int\n * %I - 64 bit signed integer (long long, int64_t)\n * %u - unsigned int\n * %U - 64 bit unsigned integer (unsigned long long, uint64_t)\n * %% - Verbatim \"%\" character.\n */\nsds sdscatfmt(sds s, char const *fmt, ...) {\n    size_t initlen = sdslen(s);\n    const char *f = fmt;\n    long i;\n    va_list ap;\n\n    /* To avoid continuous reallocations, let's start with a buffer that\n     * can hold at least two times the format string itself. It's not the\n     * best heuristic but seems to work in practice. */\n    s = sdsMakeRoomFor(s, initlen + strlen(fmt)*2);\n    va_start(ap,fmt);\n    f = fmt;    /* Next format specifier byte to process. */\n    i = initlen; /* Position of the next byte to write to dest str. */\n    while(*f) {\n        char next, *str;\n        size_t l;\n        long long num;\n        unsigned long long unum;\n\n        /* Make sure there is always space for at least 1 char. */\n        if (sdsavail(s)==0) {\n            s = sdsMakeRoomFor(s,1);\n        }\n\n        switch(*f) {\n        case '%':\n            next = *(f+1);\n            if (next == '\\0') break;\n            f++;\n            switch(next) {\n            case 's':\n            case 'S':\n                str = va_arg(ap,char*);\n                l = (next == 's') ? strlen(str) : sdslen(str);\n                if (sdsavail(s) < l) {\n                    s = sdsMakeRoomFor(s,l);\n                }\n                memcpy(s+i,str,l);\n                sdsinclen(s,l);\n                i += l;\n                break;\n            case 'i':\n            case 'I':\n                if (next == 'i')\n                    num = va_arg(ap,int);\n                else\n                    num = va_arg(ap,long long);\n                {\n                    char buf[SDS_LLSTR_SIZE];\n                    l = sdsll2str(buf,num);\n                    if (sdsavail(s) < l) {\n                        s = sdsMakeRoomFor(s,l);\n                    }\n                    memcpy(s+i,buf,l);\n                    sdsinclen(s,l);\n                    i += l;\n                }\n                break;\n            case 'u':\n            case 'U':\n                if (next == 'u')\n                    unum = va_arg(ap,unsigned int);\n                else\n                    unum = va_arg(ap,unsigned long long);\n                {\n                    char buf[SDS_LLSTR_SIZE];\n                    l = sdsull2str(buf,unum);\n                    if (sdsavail(s) < l) {\n                        s = sdsMakeRoomFor(s,l);\n                    }\n                    memcpy(s+i,buf,l);\n                    sdsinclen(s,l);\n                    i += l;\n                }\n                break;\n            default: /* Handle %% and generally %<unknown>. */\n                s[i++] = next;\n                sdsinclen(s,1);\n                break;\n            }\n            break;\n        default:\n            s[i++] = *f;\n            sdsinclen(s,1);\n            break;\n        }\n        f++;\n    }\n    va_end(ap);\n\n    /* Add null-term */\n    s[i] = '\\0';\n    return s;\n}\n\n/* Remove the part of the string from left and from right composed just of\n * contiguous characters found in 'cset', that is a null terminated C string.\n *\n * After the call, the modified sds string is no longer valid and all the\n * references must be substituted with the new pointer returned by the call.\n *\n * Example:\n *\n * s = sdsnew(\"AA...AA.a.aa.aHelloWorld     :::\");\n * s = sdstrim(s,\"Aa. :\");\n * printf(\"%s\\n\", s);\n *\n * Output will be just \"HelloWorld\".\n */\nsds sdstrim(sds s, const char *cset) {\n    char *end, *sp, *ep;\n    size_t len;\n\n    if (SDS_IS_STATIC(s)) s = sdsdup(s);\n    sp = s;\n    ep = end = s+sdslen(s)-1;\n    while(sp <= end && strchr(cset, *sp)) sp++;\n    while(ep > sp && strchr(cset, *ep)) ep--;\n    len = (ep-sp)+1;\n    if (s != sp) memmove(s, sp, len);\n    s[len] = '\\0';\n    sdssetlen(s,len);\n    return s;\n}\n\n/* Turn the string into a smaller (or equal) string containing only the\n * substring specified by the 'start' and 'end' indexes.\n *\n * start and end can be negative, where -1 means the last character of the\n * string, -2 the penultimate character, and so forth.\n *\n * The interval is inclusive, so the start and end characters will be part\n * of the resulting string.\n *\n * The string is modified in-place.\n *\n * Example:\n *\n * s = sdsnew(\"Hello World\");\n * sdsrange(s,1,-1); => \"ello World\"\n */\nvoid sdsrange(sds s, ssize_t start, ssize_t end) {\n    size_t newlen, len = sdslen(s);\n\n    if (len == 0) return;\n    if (start < 0) {\n        start = len+start;\n        if (start < 0) start = 0;\n    }\n    if (end < 0) {\n        end = len+end;\n        if (end < 0) end = 0;\n    }\n    newlen = (start > end) ? 0 : (end-start)+1;\n    if (newlen != 0) {\n        if (start >= (ssize_t)len) {\n            newlen = 0;\n        } else if (end >= (ssize_t)len) {\n            end = len-1;\n            newlen = (end-start)+1;\n        }\n    }\n    if (start && newlen) memmove(s, s+start, newlen);\n    s[newlen] = 0;\n    sdssetlen(s,newlen);\n}\n\n/* Apply tolower() to every character of the sds string 's'. */\nvoid sdstolower(sds s) {\n    size_t len = sdslen(s), j;\n\n    for (j = 0; j < len; j++) s[j] = tolower(s[j]);\n}\n\n/* Apply toupper() to every character of the sds string 's'. */\nvoid sdstoupper(sds s) {\n    size_t len = sdslen(s), j;\n\n    for (j = 0; j < len; j++) s[j] = toupper(s[j]);\n}\n\n/* Compare two sds strings s1 and s2 with memcmp().\n *\n * Return value:\n *\n *     positive if s1 > s2.\n *     negative if s1 < s2.\n *     0 if s1 and s2 are exactly the same binary string.\n *\n * If two strings share exactly the same prefix, but one of the two has\n * additional characters, the longer string is considered to be greater than\n * the smaller one. */\nint sdscmp(const sds s1, const sds s2) {\n    size_t l1, l2, minlen;\n    int cmp;\n\n    l1 = sdslen(s1);\n    l2 = sdslen(s2);\n    minlen = (l1 < l2) ? l1 : l2;\n    cmp = memcmp(s1,s2,minlen);\n    if (cmp == 0) return l1>l2? 1: (l1<l2? -1: 0);\n    return cmp;\n}\n\n/* Split 's' with separator in 'sep'. An array\n * of sds strings is returned. *count will be set\n * by reference to the number of tokens returned.\n *\n * On out of memory, zero length string, zero length\n * separator, NULL is returned.\n *\n * Note that 'sep' is able to split a string using\n * a multi-character separator. For example\n * sdssplit(\"foo_-_bar\",\"_-_\"); will return two\n * elements \"foo\" and \"bar\".\n *\n * This version of the function is binary-safe but\n * requires length arguments. sdssplit() is just the\n * same function but for zero-terminated strings.\n */\nsds *sdssplitlen(const char *s, ssize_t len, const char *sep, int seplen, int *count) {\n    int elements = 0, slots = 5;\n    long start = 0, j;\n    sds *tokens;\n\n    if (seplen < 1 || len <= 0) {\n        *count = 0;\n        return NULL;\n    }\n\n    tokens = s_malloc(sizeof(sds)*slots);\n    if (tokens == NULL) return NULL;\n\n    for (j = 0; j < (len-(seplen-1)); j++) {\n        /* make sure there is room for the next element and the final one */\n        if (slots < elements+2) {\n            sds *newtokens;\n\n            slots *= 2;\n            newtokens = s_realloc(tokens,sizeof(sds)*slots);\n            if (newtokens == NULL) goto cleanup;\n            tokens = newtokens;\n        }\n        /* search the separator */\n        if ((seplen == 1 && *(s+j) == sep[0]) || (memcmp(s+j,sep,seplen) == 0)) {\n            tokens[elements] = sdsnewlen(s+start,j-start);\n            if (tokens[elements] == NULL) goto cleanup;\n            elements++;\n            start = j+seplen;\n            j = j+seplen-1; /* skip the separator */\n        }\n    }\n    /* Add the final element. We are sure there is room in the tokens array. */\n    tokens[elements] = sdsnewlen(s+start,len-start);\n    if (tokens[elements] == NULL) goto cleanup;\n    elements++;\n    *count = elements;\n    return tokens;\n\ncleanup:\n    {\n        int i;\n        for (i = 0; i < elements; i++) sdsfree(tokens[i]);\n        s_free(tokens);\n        *count = 0;\n        return NULL;\n    }\n}\n\n/* Free the result returned by sdssplitlen(), or do nothing if 'tokens' is NULL. */\nvoid sdsfreesplitres(sds *tokens, int count) {\n    if (!tokens) return;\n    while(count--)\n        sdsfree(tokens[count]);\n    s_free(tokens);\n}\n\n/* Append to the sds string \"s\" an escaped string representation where\n * all the non-printable characters (tested with isprint()) are turned into\n * escapes in the form \"\\n\\r\\a....\" or \"\\x<hex-number>\".\n *\n * After the call, the modified sds string is no longer valid and all the\n * references must be substituted with the new pointer returned by the call. */\nsds sdscatrepr(sds s, const char *p, size_t len) {\n    s = sdscatlen(s,\"\\\"\",1);\n    while(len--) {\n        switch(*p) {\n        case '\\\\':\n        case '\"':\n            s = sdscatprintf(s,\"\\\\%c\",*p);\n            break;\n        case '\\n': s = sdscatlen(s,\"\\\\n\",2); break;\n        case '\\r': s = sdscatlen(s,\"\\\\r\",2); break;\n        case '\\t': s = sdscatlen(s,\"\\\\t\",2); break;\n        case '\\a': s = sdscatlen(s,\"\\\\a\",2); break;\n        case '\\b': s = sdscatlen(s,\"\\\\b\",2); break;\n        default:\n            if (isprint(*p))\n                s = sdscatprintf(s,\"%c\",*p);\n            else\n                s = sdscatprintf(s,\"\\\\x%02x\",(unsigned char)*p);\n            break;\n        }\n        p++;\n    }\n    return sdscatlen(s,\"\\\"\",1);\n}\n\n/* Helper function for sdssplitargs() that returns non zero if 'c'\n * is a valid hex digit. */\nint is_hex_digit(char c) {\n    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') ||\n           (c >= 'A' && c <= 'F');\n}\n\n/* Helper function for sdssplitargs() that converts a hex digit into an\n * integer from 0 to 15 */\nint hex_digit_to_int(char c) {\n    switch(c) {\n    case '0': return 0;\n    case '1': return 1;\n    case '2': return 2;\n    case '3': return 3;\n    case '4': return 4;\n    case '5': return 5;\n    case '6': return 6;\n    case '7': return 7;\n    case '8': return 8;\n    case '9': return 9;\n    case 'a': case 'A': return 10;\n    case 'b': case 'B': return 11;\n    case 'c': case 'C': return 12;\n    case 'd': case 'D': return 13;\n    case 'e': case 'E': return 14;\n    case 'f': case 'F': return 15;\n    default: return 0;\n    }\n}\n\n/* Split a line into arguments, where every argument can be in the\n * following programming-language REPL-alike form:\n *\n * foo bar \"newline are supported\\n\" and \"\\xff\\x00otherstuff\"\n *\n * The number of arguments is stored into *argc, and an array\n * of sds is returned.\n *\n * The caller should free the resulting array of sds strings with\n * sdsfreesplitres().\n *\n * Note that sdscatrepr() is able to convert back a string into\n * a quoted string in the same format sdssplitargs() is able to parse.\n *\n * The function returns the allocated tokens on success, even when the\n * input string is empty, or NULL if the input contains unbalanced\n * quotes or closed quotes followed by non space characters\n * as in: \"foo\"bar or \"foo'\n */\nsds *sdssplitargs(const char *line, int *argc) {\n    const char *p = line;\n    char *current = NULL;\n    char **vector = NULL;\n\n    *argc = 0;\n    while(1) {\n        /* skip blanks */\n        while(*p && isspace(*p)) p++;\n        if (*p) {\n            /* get a token */\n            int inq=0;  /* set to 1 if we are in \"quotes\" */\n            int insq=0; /* set to 1 if we are in 'single quotes' */\n            int done=0;\n\n            if (current == NULL) current = sdsempty();\n            while(!done) {\n                if (inq) {\n                    if (*p == '\\\\' && *(p+1) == 'x' &&\n                                             is_hex_digit(*(p+2)) &&\n                                             is_hex_digit(*(p+3)))\n                    {\n                        unsigned char byte;\n\n                        byte = (hex_digit_to_int(*(p+2))*16)+\n                                hex_digit_to_int(*(p+3));\n                        current = sdscatlen(current,(char*)&byte,1);\n                        p += 3;\n                    } else if (*p == '\\\\' && *(p+1)) {\n                        char c;\n\n                        p++;\n                        switch(*p) {\n                        case 'n': c = '\\n'; break;\n                        case 'r': c = '\\r'; break;\n                        case 't': c = '\\t'; break;\n                        case 'b': c = '\\b'; break;\n                        case 'a': c = '\\a'; break;\n                        default: c = *p; break;\n                        }\n                        current = sdscatlen(current,&c,1);\n                    } else if (*p == '\"') {\n                        /* closing quote must be followed by a space or\n                         * nothing at all. */\n                        if (*(p+1) && !isspace(*(p+1))) goto err;\n                        done=1;\n                    } else if (!*p) {\n                        /* unterminated quotes */\n                        goto err;\n                    } else {\n                        current = sdscatlen(current,p,1);\n                    }\n                } else if (insq) {\n                    if (*p == '\\\\' && *(p+1) == '\\'') {\n                        p++;\n                        current = sdscatlen(current,\"'\",1);\n                    } else if (*p == '\\'') {\n                        /* closing quote must be followed by a space or\n                         * nothing at all. */\n                        if (*(p+1) && !isspace(*(p+1))) goto err;\n                        done=1;\n                    } else if (!*p) {\n                        /* unterminated quotes */\n                        goto err;\n                    } else {\n                        current = sdscatlen(current,p,1);\n                    }\n                } else {\n                    switch(*p) {\n                    case ' ':\n                    case '\\n':\n                    case '\\r':\n                    case '\\t':\n                    case '\\0':\n                        done=1;\n                        break;\n                    case '\"':\n                        inq=1;\n                        break;\n                    case '\\'':\n                        insq=1;\n                        break;\n                    default:\n                        current = sdscatlen(current,p,1);\n                        break;\n                    }\n                }\n                if (*p) p++;\n            }\n            /* add the token to the vector */\n            vector = s_realloc(vector,((*argc)+1)*sizeof(char*));\n            vector[*argc] = current;\n            (*argc)++;\n            current = NULL;\n        } else {\n            /* Even on empty input string return something not NULL. */\n            if (vector == NULL) vector = s_malloc(sizeof(void*));\n            return vector;\n        }\n    }\n\nerr:\n    while((*argc)--)\n        sdsfree(vector[*argc]);\n    s_free(vector);\n    if (current) sdsfree(current);\n    *argc = 0;\n    return NULL;\n}\n\n/* Modify the string substituting all the occurrences of the set of\n * characters specified in the 'from' string to the corresponding character\n * in the 'to' array.\n *\n * For instance: sdsmapchars(mystring, \"ho\", \"01\", 2)\n * will have the effect of turning the string \"hello\" into \"0ell1\".\n *\n * The function returns the sds string pointer, that is always the same\n * as the input pointer since no resize is needed. */\nsds sdsmapchars(sds s, const char *from, const char *to, size_t setlen) {\n    size_t j, i, l = sdslen(s);\n\n    if (SDS_IS_STATIC(s)) s = sdsdup(s);\n    for (j = 0; j < l; j++) {\n        for (i = 0; i < setlen; i++) {\n            if (s[j] == from[i]) {\n                s[j] = to[i];\n                break;\n            }\n        }\n    }\n    return s;\n}\n\n/* Join an array of C strings using the specified separator (also a C string).\n * Returns the result as an sds string. */\nsds sdsjoin(char **argv, int argc, char *sep) {\n    sds join = sdsempty();\n    int j;\n\n    for (j = 0; j < argc; j++) {\n        join = sdscat(join, argv[j]);\n        if (j != argc-1) join = sdscat(join,sep);\n    }\n    return join;\n}\n\n/* Like sdsjoin, but joins an array of SDS strings. */\nsds sdsjoinsds(sds *argv, int argc, const char *sep, size_t seplen) {\n    sds join = sdsempty();\n    int j;\n\n    for (j = 0; j < argc; j++) {\n        join = sdscatsds(join, argv[j]);\n        if (j != argc-1) join = sdscatlen(join,sep,seplen);\n    }\n    return join;\n}\n\n/* Wrappers to the allocators used by SDS. Note that SDS will actually\n * just use the macros defined into sdsalloc.h in order to avoid to pay\n * the overhead of function calls. Here we define these wrappers only for\n * the programs SDS is linked to, if they want to touch the SDS internals\n * even if they use a different allocator. */\nvoid *sds_malloc(size_t size) { return s_malloc(size); }\nvoid *sds_realloc(void *ptr, size_t size) { return s_realloc(ptr,size); }\nvoid sds_free(void *ptr) { s_free(ptr); }\n\n#if defined(SDS_TEST_MAIN)\n#include <stdio.h>\n#include \"testhelp.h\"\n#include \"limits.h\"\n\n#define UNUSED(x) (void)(x)\nint sdsTest(void) {\n    {\n        sds x = sdsnew(\"foo\"), y;\n\n        test_cond(\"Create a string and obtain the length\",\n            sdslen(x) == 3 && memcmp(x,\"foo\\0\",4) == 0)\n\n        sdsfree(x);\n        x = sdsnewlen(\"foo\",2);\n        test_cond(\"Create a string with specified length\",\n            sdslen(x) == 2 && memcmp(x,\"fo\\0\",3) == 0)\n\n        x = sdscat(x,\"bar\");\n        test_cond(\"Strings concatenation\",\n            sdslen(x) == 5 && memcmp(x,\"fobar\\0\",6) == 0);\n\n        x = sdscpy(x,\"a\");\n        test_cond(\"sdscpy() against an originally longer string\",\n            sdslen(x) == 1 && memcmp(x,\"a\\0\",2) == 0)\n\n        x = sdscpy(x,\"xyzxxxxxxxxxxyyyyyyyyyykkkkkkkkkk\");\n        test_cond(\"sdscpy() against an originally shorter string\",\n            sdslen(x) == 33 &&\n            memcmp(x,\"xyzxxxxxxxxxxyyyyyyyyyykkkkkkkkkk\\0\",33) == 0)\n\n        sdsfree(x);\n        x = sdscatprintf(sdsempty(),\"%d\",123);\n        test_cond(\"sdscatprintf() seems working in the base case\",\n            sdslen(x) == 3 && memcmp(x,\"123\\0\",4) == 0)\n\n        sdsfree(x);\n        x = sdscatprintf(sdsempty(),\"a%cb\",0);\n        test_cond(\"sdscatprintf() seems working with \\\\0 inside of result\",\n            sdslen(x) == 3 && memcmp(x,\"a\\0\"\"b\\0\",4) == 0)\n\n        {\n            sdsfree(x);\n            char etalon[1024*1024];\n            for (size_t i = 0; i < sizeof(etalon); i++) {\n                etalon[i] = '0';\n            }\n            x = sdscatprintf(sdsempty(),\"%0*d\",(int)sizeof(etalon),0);\n            test_cond(\"sdscatprintf() can print 1MB\",\n                sdslen(x) == sizeof(etalon) && memcmp(x,etalon,sizeof(etalon)) == 0)\n        }\n\n        sdsfree(x);\n        x = sdsnew(\"--\");\n        x = sdscatfmt(x, \"Hello %s World %I,%I--\", \"Hi!\", LLONG_MIN,LLONG_MAX);\n        test_cond(\"sdscatfmt() seems working in the base case\",\n            sdslen(x) == 60 &&\n            memcmp(x,\"--Hello Hi! World -9223372036854775808,\"\n                     \"9223372036854775807--\",60) == 0)\n        printf(\"[%s]\\n\",x);\n\n        sdsfree(x);\n        x = sdsnew(\"--\");\n        x = sdscatfmt(x, \"%u,%U--\", UINT_MAX, ULLONG_MAX);\n        test_cond(\"sdscatfmt() seems working with unsigned numbers\",\n            sdslen(x) == 35 &&\n            memcmp(x,\"--4294967295,18446744073709551615--\",35) == 0)\n\n        sdsfree(x);\n        x = sdsnew(\" x \");\n        sdstrim(x,\" x\");\n        test_cond(\"sdstrim() works when all chars match\",\n            sdslen(x) == 0)\n\n        sdsfree(x);\n        x = sdsnew(\" x \");\n        sdstrim(x,\" \");\n        test_cond(\"sdstrim() works when a single char remains\",\n            sdslen(x) == 1 && x[0] == 'x')\n\n        sdsfree(x);\n        x = sdsnew(\"xxciaoyyy\");\n        sdstrim(x,\"xy\");\n        test_cond(\"sdstrim() correctly trims characters\",\n            sdslen(x) == 4 && memcmp(x,\"ciao\\0\",5) == 0)\n\n        y = sdsdup(x);\n        sdsrange(y,1,1);\n        test_cond(\"sdsrange(...,1,1)\",\n            sdslen(y) == 1 && memcmp(y,\"i\\0\",2) == 0)\n\n        sdsfree(y);\n        y = sdsdup(x);\n        sdsrange(y,1,-1);\n        test_cond(\"sdsrange(...,1,-1)\",\n            sdslen(y) == 3 && memcmp(y,\"iao\\0\",4) == 0)\n\n        sdsfree(y);\n        y = sdsdup(x);\n        sdsrange(y,-2,-1);\n        test_cond(\"sdsrange(...,-2,-1)\",\n            sdslen(y) == 2 && memcmp(y,\"ao\\0\",3) == 0)\n\n        sdsfree(y);\n        y = sdsdup(x);\n        sdsrange(y,2,1);\n        test_cond(\"sdsrange(...,2,1)\",\n            sdslen(y) == 0 && memcmp(y,\"\\0\",1) == 0)\n\n        sdsfree(y);\n        y = sdsdup(x);\n        sdsrange(y,1,100);\n        test_cond(\"sdsrange(...,1,100)\",\n            sdslen(y) == 3 && memcmp(y,\"iao\\0\",4) == 0)\n\n        sdsfree(y);\n        y = sdsdup(x);\n        sdsrange(y,100,100);\n        test_cond(\"sdsrange(...,100,100)\",\n            sdslen(y) == 0 && memcmp(y,\"\\0\",1) == 0)\n\n        sdsfree(y);\n        sdsfree(x);\n        x = sdsnew(\"foo\");\n        y = sdsnew(\"foa\");\n        test_cond(\"sdscmp(foo,foa)\", sdscmp(x,y) > 0)\n\n        sdsfree(y);\n        sdsfree(x);\n        x = sdsnew(\"bar\");\n        y = sdsnew(\"bar\");\n        test_cond(\"sdscmp(bar,bar)\", sdscmp(x,y) == 0)\n\n        sdsfree(y);\n        sdsfree(x);\n        x = sdsnew(\"aar\");\n        y = sdsnew(\"bar\");\n        test_cond(\"sdscmp(bar,bar)\", sdscmp(x,y) < 0)\n\n        sdsfree(y);\n        sdsfree(x);\n        x = sdsnewlen(\"\\a\\n\\0foo\\r\",7);\n        y = sdscatrepr(sdsempty(),x,sdslen(x));\n        test_cond(\"sdscatrepr(...data...)\",\n            memcmp(y,\"\\\"\\\\a\\\\n\\\\x00foo\\\\r\\\"\",15) == 0)\n\n        {\n            char *p;\n            int step = 10, j, i;\n\n            sdsfree(x);\n            sdsfree(y);\n            x = sdsnew(\"0\");\n            test_cond(\"sdsnew() free/len buffers\", sdslen(x) == 1 && sdsavail(x) == 0);\n\n            /* Run the test a few times in order to hit the first two\n             * SDS header types. */\n            for (i = 0; i < 10; i++) {\n                int oldlen = sdslen(x);\n                x = sdsMakeRoomFor(x,step);\n                int type = x[-1]&SDS_TYPE_MASK;\n\n                test_cond(\"sdsMakeRoomFor() len\", sdslen(x) == oldlen);\n                if (type != SDS_TYPE_5) {\n                    test_cond(\"sdsMakeRoomFor() free\", sdsavail(x) >= step);\n                }\n                p = x+oldlen;\n                for (j = 0; j < step; j++) {\n                    p[j] = 'A'+j;\n                }\n                sdsIncrLen(x,step);\n            }\n            test_cond(\"sdsMakeRoomFor() content\",\n                memcmp(\"0ABCDEFGHIJABCDEFGHIJABCDEFGHIJABCDEFGHIJABCDEFGHIJABCDEFGHIJABCDEFGHIJABCDEFGHIJABCDEFGHIJABCDEFGHIJ\",x,101) == 0);\n            test_cond(\"sdsMakeRoomFor() final length\",sdslen(x)==101);\n\n            sdsfree(x);\n        }\n    }\n    test_report()\n    return 0;\n}\n#endif\n\n#ifdef SDS_TEST_MAIN\nint main(void) {\n    return sdsTest();\n}\n#endif\n";
 
-const char *SRC_SDSALLOC_H = "/* SDSLib 2.0 -- A C dynamic strings library\n *\n * Copyright (c) 2006-2015, Salvatore Sanfilippo <antirez at gmail dot com>\n * Copyright (c) 2015, Oran Agra\n * Copyright (c) 2015, Redis Labs, Inc\n * All rights reserved.\n *\n * Redistribution and use in source and binary forms, with or without\n * modification, are permitted provided that the following conditions are met:\n *\n *   * Redistributions of source code must retain the above copyright notice,\n *     this list of conditions and the following disclaimer.\n *   * Redistributions in binary form must reproduce the above copyright\n *     notice, this list of conditions and the following disclaimer in the\n *     documentation and/or other materials provided with the distribution.\n *   * Neither the name of Redis nor the names of its contributors may be used\n *     to endorse or promote products derived from this software without\n *     specific prior written permission.\n *\n * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS \"AS IS\"\n * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE\n * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE\n * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE\n * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR\n * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF\n * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS\n * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)\n * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE\n * POSSIBILITY OF SUCH DAMAGE.\n */\n\n/* SDS allocator selection.\n *\n * This file is used in order to change the SDS allocator at compile time.\n * Just define the following defines to what you want to use. Also add\n * the include of your alternate allocator if needed (not needed in order\n * to use the default libc allocator). */\n\n#define s_malloc malloc\n#define s_realloc realloc\n#define s_free free\n";
+const char *SRC_STB_DS_H = "/* stb_ds.h - v0.67 - public domain data structures - Sean Barrett 2019\n\n   This is a single-header-file library that provides easy-to-use\n   dynamic arrays and hash tables for C (also works in C++).\n\n   For a gentle introduction:\n      http://nothings.org/stb_ds\n\n   To use this library, do this in *one* C or C++ file:\n      #define STB_DS_IMPLEMENTATION\n      #include \"stb_ds.h\"\n\nTABLE OF CONTENTS\n\n  Table of Contents\n  Compile-time options\n  License\n  Documentation\n  Notes\n  Notes - Dynamic arrays\n  Notes - Hash maps\n  Credits\n\nCOMPILE-TIME OPTIONS\n\n  #define STBDS_NO_SHORT_NAMES\n\n     This flag needs to be set globally.\n\n     By default stb_ds exposes shorter function names that are not qualified\n     with the \"stbds_\" prefix. If these names conflict with the names in your\n     code, define this flag.\n\n  #define STBDS_SIPHASH_2_4\n\n     This flag only needs to be set in the file containing #define STB_DS_IMPLEMENTATION.\n\n     By default stb_ds.h hashes using a weaker variant of SipHash and a custom hash for\n     4- and 8-byte keys. On 64-bit platforms, you can define the above flag to force\n     stb_ds.h to use specification-compliant SipHash-2-4 for all keys. Doing so makes\n     hash table insertion about 20% slower on 4- and 8-byte keys, 5% slower on\n     64-byte keys, and 10% slower on 256-byte keys on my test computer.\n\n  #define STBDS_REALLOC(context,ptr,size) better_realloc\n  #define STBDS_FREE(context,ptr)         better_free\n\n     These defines only need to be set in the file containing #define STB_DS_IMPLEMENTATION.\n\n     By default stb_ds uses stdlib realloc() and free() for memory management. You can\n     substitute your own functions instead by defining these symbols. You must either\n     define both, or neither. Note that at the moment, 'context' will always be NULL.\n     @TODO add an array/hash initialization function that takes a memory context pointer.\n\n  #define STBDS_UNIT_TESTS\n\n     Defines a function stbds_unit_tests() that checks the functioning of the data structures.\n\n  Note that on older versions of gcc (e.g. 5.x.x) you may need to build with '-std=c++0x'\n     (or equivalentally '-std=c++11') when using anonymous structures as seen on the web\n     page or in STBDS_UNIT_TESTS.\n\nLICENSE\n\n  Placed in the public domain and also MIT licensed.\n  See end of file for detailed license information.\n\nDOCUMENTATION\n\n  Dynamic Arrays\n\n    Non-function interface:\n\n      Declare an empty dynamic array of type T\n        T* foo = NULL;\n\n      Access the i'th item of a dynamic array 'foo' of type T, T* foo:\n        foo[i]\n\n    Functions (actually macros)\n\n      arrfree:\n        void arrfree(T*);\n          Frees the array.\n\n      arrlen:\n        ptrdiff_t arrlen(T*);\n          Returns the number of elements in the array.\n\n      arrlenu:\n        size_t arrlenu(T*);\n          Returns the number of elements in the array as an unsigned type.\n\n      arrpop:\n        T arrpop(T* a)\n          Removes the final element of the array and returns it.\n\n      arrput:\n        T arrput(T* a, T b);\n          Appends the item b to the end of array a. Returns b.\n\n      arrins:\n        T arrins(T* a, int p, T b);\n          Inserts the item b into the middle of array a, into a[p],\n          moving the rest of the array over. Returns b.\n\n      arrinsn:\n        void arrinsn(T* a, int p, int n);\n          Inserts n uninitialized items into array a starting at a[p],\n          moving the rest of the array over.\n\n      arraddnptr:\n        T* arraddnptr(T* a, int n)\n          Appends n uninitialized items onto array at the end.\n          Returns a pointer to the first uninitialized item added.\n\n      arraddnindex:\n        size_t arraddnindex(T* a, int n)\n          Appends n uninitialized items onto array at the end.\n          Returns the index of the first uninitialized item added.\n\n      arrdel:\n        void arrdel(T* a, int p);\n          Deletes the element at a[p], moving the rest of the array over.\n\n      arrdeln:\n        void arrdeln(T* a, int p, int n);\n          Deletes n elements starting at a[p], moving the rest of the array over.\n\n      arrdelswap:\n        void arrdelswap(T* a, int p);\n          Deletes the element at a[p], replacing it with the element from\n          the end of the array. O(1) performance.\n\n      arrsetlen:\n        void arrsetlen(T* a, int n);\n          Changes the length of the array to n. Allocates uninitialized\n          slots at the end if necessary.\n\n      arrsetcap:\n        size_t arrsetcap(T* a, int n);\n          Sets the length of allocated storage to at least n. It will not\n          change the length of the array.\n\n      arrcap:\n        size_t arrcap(T* a);\n          Returns the number of total elements the array can contain without\n          needing to be reallocated.\n\n  Hash maps & String hash maps\n\n    Given T is a structure type: struct { TK key; TV value; }. Note that some\n    functions do not require TV value and can have other fields. For string\n    hash maps, TK must be 'char *'.\n\n    Special interface:\n\n      stbds_rand_seed:\n        void stbds_rand_seed(size_t seed);\n          For security against adversarially chosen data, you should seed the\n          library with a strong random number. Or at least seed it with time().\n\n      stbds_hash_string:\n        size_t stbds_hash_string(char *str, size_t seed);\n          Returns a hash value for a string.\n\n      stbds_hash_bytes:\n        size_t stbds_hash_bytes(void *p, size_t len, size_t seed);\n          These functions hash an arbitrary number of bytes. The function\n          uses a custom hash for 4- and 8-byte data, and a weakened version\n          of SipHash for everything else. On 64-bit platforms you can get\n          specification-compliant SipHash-2-4 on all data by defining\n          STBDS_SIPHASH_2_4, at a significant cost in speed.\n\n    Non-function interface:\n\n      Declare an empty hash map of type T\n        T* foo = NULL;\n\n      Access the i'th entry in a hash table T* foo:\n        foo[i]\n\n    Function interface (actually macros):\n\n      hmfree\n      shfree\n        void hmfree(T*);\n        void shfree(T*);\n          Frees the hashmap and sets the pointer to NULL.\n\n      hmlen\n      shlen\n        ptrdiff_t hmlen(T*)\n        ptrdiff_t shlen(T*)\n          Returns the number of elements in the hashmap.\n\n      hmlenu\n      shlenu\n        size_t hmlenu(T*)\n        size_t shlenu(T*)\n          Returns the number of elements in the hashmap.\n\n      hmgeti\n      shgeti\n      hmgeti_ts\n        ptrdiff_t hmgeti(T*, TK key)\n        ptrdiff_t shgeti(T*, char* key)\n        ptrdiff_t hmgeti_ts(T*, TK key, ptrdiff_t tempvar)\n          Returns the index in the hashmap which has the key 'key', or -1\n          if the key is not present.\n\n      hmget\n      hmget_ts\n      shget\n        TV hmget(T*, TK key)\n        TV shget(T*, char* key)\n        TV hmget_ts(T*, TK key, ptrdiff_t tempvar)\n          Returns the value corresponding to 'key' in the hashmap.\n          The structure must have a 'value' field\n\n      hmgets\n      shgets\n        T hmgets(T*, TK key)\n        T shgets(T*, char* key)\n          Returns the structure corresponding to 'key' in the hashmap.\n\n      hmgetp\n      shgetp\n      hmgetp_ts\n      hmgetp_null\n      shgetp_null\n        T* hmgetp(T*, TK key)\n        T* shgetp(T*, char* key)\n        T* hmgetp_ts(T*, TK key, ptrdiff_t tempvar)\n        T* hmgetp_null(T*, TK key)\n        T* shgetp_null(T*, char *key)\n          Returns a pointer to the structure corresponding to 'key' in\n          the hashmap. Functions ending in \"_null\" return NULL if the key\n          is not present in the hashmap; the others return a pointer to a\n          structure holding the default value (but not the searched-for key).\n\n      hmdefault\n      shdefault\n        TV hmdefault(T*, TV value)\n        TV shdefault(T*, TV value)\n          Sets the default value for the hashmap, the value which will be\n          returned by hmget/shget if the key is not present.\n\n      hmdefaults\n      shdefaults\n        TV hmdefaults(T*, T item)\n        TV shdefaults(T*, T item)\n          Sets the default struct for the hashmap, the contents which will be\n          returned by hmgets/shgets if the key is not present.\n\n      hmput\n      shput\n        TV hmput(T*, TK key, TV value)\n        TV shput(T*, char* key, TV value)\n          Inserts a <key,value> pair into the hashmap. If the key is already\n          present in the hashmap, updates its value.\n\n      hmputs\n      shputs\n        T hmputs(T*, T item)\n        T shputs(T*, T item)\n          Inserts a struct with T.key into the hashmap. If the struct is already\n          present in the hashmap, updates it.\n\n      hmdel\n      shdel\n        int hmdel(T*, TK key)\n        int shdel(T*, char* key)\n          If 'key' is in the hashmap, deletes its entry and returns 1.\n          Otherwise returns 0.\n\n    Function interface (actually macros) for strings only:\n\n      sh_new_strdup\n        void sh_new_strdup(T*);\n          Overwrites the existing pointer with a newly allocated\n          string hashmap which will automatically allocate and free\n          each string key using realloc/free\n\n      sh_new_arena\n        void sh_new_arena(T*);\n          Overwrites the existing pointer with a newly allocated\n          string hashmap which will automatically allocate each string\n          key to a string arena. Every string key ever used by this\n          hash table remains in the arena until the arena is freed.\n          Additionally, any key which is deleted and reinserted will\n          be allocated multiple times in the string arena.\n\nNOTES\n\n  * These data structures are realloc'd when they grow, and the macro\n    \"functions\" write to the provided pointer. This means: (a) the pointer\n    must be an lvalue, and (b) the pointer to the data structure is not\n    stable, and you must maintain it the same as you would a realloc'd\n    pointer. For example, if you pass a pointer to a dynamic array to a\n    function which updates it, the function must return back the new\n    pointer to the caller. This is the price of trying to do this in C.\n\n  * The following are the only functions that are thread-safe on a single data\n    structure, i.e. can be run in multiple threads simultaneously on the same\n    data structure\n        hmlen        shlen\n        hmlenu       shlenu\n        hmget_ts     shget_ts\n        hmgeti_ts    shgeti_ts\n        hmgets_ts    shgets_ts\n\n  * You iterate over the contents of a dynamic array and a hashmap in exactly\n    the same way, using arrlen/hmlen/shlen:\n\n      for (i=0; i < arrlen(foo); ++i)\n         ... foo[i] ...\n\n  * All operations except arrins/arrdel are O(1) amortized, but individual\n    operations can be slow, so these data structures may not be suitable\n    for real time use. Dynamic arrays double in capacity as needed, so\n    elements are copied an average of once. Hash tables double/halve\n    their size as needed, with appropriate hysteresis to maintain O(1)\n    performance.\n\nNOTES - DYNAMIC ARRAY\n\n  * If you know how long a dynamic array is going to be in advance, you can avoid\n    extra memory allocations by using arrsetlen to allocate it to that length in\n    advance and use foo[n] while filling it out, or arrsetcap to allocate the memory\n    for that length and use arrput/arrpush as normal.\n\n  * Unlike some other versions of the dynamic array, this version should\n    be safe to use with strict-aliasing optimizations.\n\nNOTES - HASH MAP\n\n  * For compilers other than GCC and clang (e.g. Visual Studio), for hmput/hmget/hmdel\n    and variants, the key must be an lvalue (so the macro can take the address of it).\n    Extensions are used that eliminate this requirement if you're using C99 and later\n    in GCC or clang, or if you're using C++ in GCC. But note that this can make your\n    code less portable.\n\n  * To test for presence of a key in a hashmap, just do 'hmgeti(foo,key) >= 0'.\n\n  * The iteration order of your data in the hashmap is determined solely by the\n    order of insertions and deletions. In particular, if you never delete, new\n    keys are always added at the end of the array. This will be consistent\n    across all platforms and versions of the library. However, you should not\n    attempt to serialize the internal hash table, as the hash is not consistent\n    between different platforms, and may change with future versions of the library.\n\n  * Use sh_new_arena() for string hashmaps that you never delete from. Initialize\n    with NULL if you're managing the memory for your strings, or your strings are\n    never freed (at least until the hashmap is freed). Otherwise, use sh_new_strdup().\n    @TODO: make an arena variant that garbage collects the strings with a trivial\n    copy collector into a new arena whenever the table shrinks / rebuilds. Since\n    current arena recommendation is to only use arena if it never deletes, then\n    this can just replace current arena implementation.\n\n  * If adversarial input is a serious concern and you're on a 64-bit platform,\n    enable STBDS_SIPHASH_2_4 (see the 'Compile-time options' section), and pass\n    a strong random number to stbds_rand_seed.\n\n  * The default value for the hash table is stored in foo[-1], so if you\n    use code like 'hmget(T,k)->value = 5' you can accidentally overwrite\n    the value stored by hmdefault if 'k' is not present.\n\nCREDITS\n\n  Sean Barrett -- library, idea for dynamic array API/implementation\n  Per Vognsen  -- idea for hash table API/implementation\n  Rafael Sachetto -- arrpop()\n  github:HeroicKatora -- arraddn() reworking\n\n  Bugfixes:\n    Andy Durdin\n    Shane Liesegang\n    Vinh Truong\n    Andreas Molzer\n    github:hashitaku\n    github:srdjanstipic\n    Macoy Madson\n    Andreas Vennstrom\n    Tobias Mansfield-Williams\n*/\n\n#ifdef STBDS_UNIT_TESTS\n#define _CRT_SECURE_NO_WARNINGS\n#endif\n\n#ifndef INCLUDE_STB_DS_H\n#define INCLUDE_STB_DS_H\n\n#include <stddef.h>\n#include <string.h>\n\n#ifndef STBDS_NO_SHORT_NAMES\n#define arrlen      stbds_arrlen\n#define arrlenu     stbds_arrlenu\n#define arrput      stbds_arrput\n#define arrpush     stbds_arrput\n#define arrpop      stbds_arrpop\n#define arrfree     stbds_arrfree\n#define arraddn     stbds_arraddn // deprecated, use one of the following instead:\n#define arraddnptr  stbds_arraddnptr\n#define arraddnindex stbds_arraddnindex\n#define arrsetlen   stbds_arrsetlen\n#define arrlast     stbds_arrlast\n#define arrins      stbds_arrins\n#define arrinsn     stbds_arrinsn\n#define arrdel      stbds_arrdel\n#define arrdeln     stbds_arrdeln\n#define arrdelswap  stbds_arrdelswap\n#define arrcap      stbds_arrcap\n#define arrsetcap   stbds_arrsetcap\n\n#define hmput       stbds_hmput\n#define hmputs      stbds_hmputs\n#define hmget       stbds_hmget\n#define hmget_ts    stbds_hmget_ts\n#define hmgets      stbds_hmgets\n#define hmgetp      stbds_hmgetp\n#define hmgetp_ts   stbds_hmgetp_ts\n#define hmgetp_null stbds_hmgetp_null\n#define hmgeti      stbds_hmgeti\n#define hmgeti_ts   stbds_hmgeti_ts\n#define hmdel       stbds_hmdel\n#define hmlen       stbds_hmlen\n#define hmlenu      stbds_hmlenu\n#define hmfree      stbds_hmfree\n#define hmdefault   stbds_hmdefault\n#define hmdefaults  stbds_hmdefaults\n\n#define shput       stbds_shput\n#define shputi      stbds_shputi\n#define shputs      stbds_shputs\n#define shget       stbds_shget\n#define shgeti      stbds_shgeti\n#define shgets      stbds_shgets\n#define shgetp      stbds_shgetp\n#define shgetp_null stbds_shgetp_null\n#define shdel       stbds_shdel\n#define shlen       stbds_shlen\n#define shlenu      stbds_shlenu\n#define shfree      stbds_shfree\n#define shdefault   stbds_shdefault\n#define shdefaults  stbds_shdefaults\n#define sh_new_arena  stbds_sh_new_arena\n#define sh_new_strdup stbds_sh_new_strdup\n\n#define stralloc    stbds_stralloc\n#define strreset    stbds_strreset\n#endif\n\n#if defined(STBDS_REALLOC) && !defined(STBDS_FREE) || !defined(STBDS_REALLOC) && defined(STBDS_FREE)\n#error \"You must define both STBDS_REALLOC and STBDS_FREE, or neither.\"\n#endif\n#if !defined(STBDS_REALLOC) && !defined(STBDS_FREE)\n#include <stdlib.h>\n#define STBDS_REALLOC(c,p,s) realloc(p,s)\n#define STBDS_FREE(c,p)      free(p)\n#endif\n\n#ifdef _MSC_VER\n#define STBDS_NOTUSED(v)  (void)(v)\n#else\n#define STBDS_NOTUSED(v)  (void)sizeof(v)\n#endif\n\n#ifdef __cplusplus\nextern \"C\" {\n#endif\n\n// for security against attackers, seed the library with a random number, at least time() but stronger is better\nextern void stbds_rand_seed(size_t seed);\n\n// these are the hash functions used internally if you want to test them or use them for other purposes\nextern size_t stbds_hash_bytes(void *p, size_t len, size_t seed);\nextern size_t stbds_hash_string(char *str, size_t seed);\n\n// this is a simple string arena allocator, initialize with e.g. 'stbds_string_arena my_arena={0}'.\ntypedef struct stbds_string_arena stbds_string_arena;\nextern char * stbds_stralloc(stbds_string_arena *a, char *str);\nextern void   stbds_strreset(stbds_string_arena *a);\n\n// have to #define STBDS_UNIT_TESTS to call this\nextern void stbds_unit_tests(void);\n\n///////////////\n//\n// Everything below here is implementation details\n//\n\nextern void * stbds_arrgrowf(void *a, size_t elemsize, size_t addlen, size_t min_cap);\nextern void   stbds_arrfreef(void *a);\nextern void   stbds_hmfree_func(void *p, size_t elemsize);\nextern void * stbds_hmget_key(void *a, size_t elemsize, void *key, size_t keysize, int mode);\nextern void * stbds_hmget_key_ts(void *a, size_t elemsize, void *key, size_t keysize, ptrdiff_t *temp, int mode);\nextern void * stbds_hmput_default(void *a, size_t elemsize);\nextern void * stbds_hmput_key(void *a, size_t elemsize, void *key, size_t keysize, int mode);\nextern void * stbds_hmdel_key(void *a, size_t elemsize, void *key, size_t keysize, size_t keyoffset, int mode);\nextern void * stbds_shmode_func(size_t elemsize, int mode);\n\n#ifdef __cplusplus\n}\n#endif\n\n#if defined(__GNUC__) || defined(__clang__)\n#define STBDS_HAS_TYPEOF\n#ifdef __cplusplus\n//#define STBDS_HAS_LITERAL_ARRAY  // this is currently broken for clang\n#endif\n#endif\n\n#if !defined(__cplusplus)\n#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L\n#define STBDS_HAS_LITERAL_ARRAY\n#endif\n#endif\n\n// this macro takes the address of the argument, but on gcc/clang can accept rvalues\n#if defined(STBDS_HAS_LITERAL_ARRAY) && defined(STBDS_HAS_TYPEOF)\n  #if __clang__\n  #define STBDS_ADDRESSOF(typevar, value)     ((__typeof__(typevar)[1]){value}) // literal array decays to pointer to value\n  #else\n  #define STBDS_ADDRESSOF(typevar, value)     ((typeof(typevar)[1]){value}) // literal array decays to pointer to value\n  #endif\n#else\n#define STBDS_ADDRESSOF(typevar, value)     &(value)\n#endif\n\n#define STBDS_OFFSETOF(var,field)           ((char *) &(var)->field - (char *) (var))\n\n#define stbds_header(t)  ((stbds_array_header *) (t) - 1)\n#define stbds_temp(t)    stbds_header(t)->temp\n#define stbds_temp_key(t) (*(char **) stbds_header(t)->hash_table)\n\n#define stbds_arrsetcap(a,n)   (stbds_arrgrow(a,0,n))\n#define stbds_arrsetlen(a,n)   ((stbds_arrcap(a) < (size_t) (n) ? stbds_arrsetcap((a),(size_t)(n)),0 : 0), (a) ? stbds_header(a)->length = (size_t) (n) : 0)\n#define stbds_arrcap(a)        ((a) ? stbds_header(a)->capacity : 0)\n#define stbds_arrlen(a)        ((a) ? (ptrdiff_t) stbds_header(a)->length : 0)\n#define stbds_arrlenu(a)       ((a) ?             stbds_header(a)->length : 0)\n#define stbds_arrput(a,v)      (stbds_arrmaybegrow(a,1), (a)[stbds_header(a)->length++] = (v))\n#define stbds_arrpush          stbds_arrput  // synonym\n#define stbds_arrpop(a)        (stbds_header(a)->length--, (a)[stbds_header(a)->length])\n#define stbds_arraddn(a,n)     ((void)(stbds_arraddnindex(a, n)))    // deprecated, use one of the following instead:\n#define stbds_arraddnptr(a,n)  (stbds_arrmaybegrow(a,n), (n) ? (stbds_header(a)->length += (n), &(a)[stbds_header(a)->length-(n)]) : (a))\n#define stbds_arraddnindex(a,n)(stbds_arrmaybegrow(a,n), (n) ? (stbds_header(a)->length += (n), stbds_header(a)->length-(n)) : stbds_arrlen(a))\n#define stbds_arraddnoff       stbds_arraddnindex\n#define stbds_arrlast(a)       ((a)[stbds_header(a)->length-1])\n#define stbds_arrfree(a)       ((void) ((a) ? STBDS_FREE(NULL,stbds_header(a)) : (void)0), (a)=NULL)\n#define stbds_arrdel(a,i)      stbds_arrdeln(a,i,1)\n#define stbds_arrdeln(a,i,n)   (memmove(&(a)[i], &(a)[(i)+(n)], sizeof *(a) * (stbds_header(a)->length-(n)-(i))), stbds_header(a)->length -= (n))\n#define stbds_arrdelswap(a,i)  ((a)[i] = stbds_arrlast(a), stbds_header(a)->length -= 1)\n#define stbds_arrinsn(a,i,n)   (stbds_arraddn((a),(n)), memmove(&(a)[(i)+(n)], &(a)[i], sizeof *(a) * (stbds_header(a)->length-(n)-(i))))\n#define stbds_arrins(a,i,v)    (stbds_arrinsn((a),(i),1), (a)[i]=(v))\n\n#define stbds_arrmaybegrow(a,n)  ((!(a) || stbds_header(a)->length + (n) > stbds_header(a)->capacity) \\\n                                  ? (stbds_arrgrow(a,n,0),0) : 0)\n\n#define stbds_arrgrow(a,b,c)   ((a) = stbds_arrgrowf_wrapper((a), sizeof *(a), (b), (c)))\n\n#define stbds_hmput(t, k, v) \\\n    ((t) = stbds_hmput_key_wrapper((t), sizeof *(t), (void*) STBDS_ADDRESSOF((t)->key, (k)), sizeof (t)->key, 0),   \\\n     (t)[stbds_temp((t)-1)].key = (k),    \\\n     (t)[stbds_temp((t)-1)].value = (v))\n\n#define stbds_hmputs(t, s) \\\n    ((t) = stbds_hmput_key_wrapper((t), sizeof *(t), &(s).key, sizeof (s).key, STBDS_HM_BINARY), \\\n     (t)[stbds_temp((t)-1)] = (s))\n\n#define stbds_hmgeti(t,k) \\\n    ((t) = stbds_hmget_key_wrapper((t), sizeof *(t), (void*) STBDS_ADDRESSOF((t)->key, (k)), sizeof (t)->key, STBDS_HM_BINARY), \\\n      stbds_temp((t)-1))\n\n#define stbds_hmgeti_ts(t,k,temp) \\\n    ((t) = stbds_hmget_key_ts_wrapper((t), sizeof *(t), (void*) STBDS_ADDRESSOF((t)->key, (k)), sizeof (t)->key, &(temp), STBDS_HM_BINARY), \\\n      (temp))\n\n#define stbds_hmgetp(t, k) \\\n    ((void) stbds_hmgeti(t,k), &(t)[stbds_temp((t)-1)])\n\n#define stbds_hmgetp_ts(t, k, temp) \\\n    ((void) stbds_hmgeti_ts(t,k,temp), &(t)[temp])\n\n#define stbds_hmdel(t,k) \\\n    (((t) = stbds_hmdel_key_wrapper((t),sizeof *(t), (void*) STBDS_ADDRESSOF((t)->key, (k)), sizeof (t)->key, STBDS_OFFSETOF((t),key), STBDS_HM_BINARY)),(t)?stbds_temp((t)-1):0)\n\n#define stbds_hmdefault(t, v) \\\n    ((t) = stbds_hmput_default_wrapper((t), sizeof *(t)), (t)[-1].value = (v))\n\n#define stbds_hmdefaults(t, s) \\\n    ((t) = stbds_hmput_default_wrapper((t), sizeof *(t)), (t)[-1] = (s))\n\n#define stbds_hmfree(p)        \\\n    ((void) ((p) != NULL ? stbds_hmfree_func((p)-1,sizeof*(p)),0 : 0),(p)=NULL)\n\n#define stbds_hmgets(t, k)    (*stbds_hmgetp(t,k))\n#define stbds_hmget(t, k)     (stbds_hmgetp(t,k)->value)\n#define stbds_hmget_ts(t, k, temp)  (stbds_hmgetp_ts(t,k,temp)->value)\n#define stbds_hmlen(t)        ((t) ? (ptrdiff_t) stbds_header((t)-1)->length-1 : 0)\n#define stbds_hmlenu(t)       ((t) ?             stbds_header((t)-1)->length-1 : 0)\n#define stbds_hmgetp_null(t,k)  (stbds_hmgeti(t,k) == -1 ? NULL : &(t)[stbds_temp((t)-1)])\n\n#define stbds_shput(t, k, v) \\\n    ((t) = stbds_hmput_key_wrapper((t), sizeof *(t), (void*) (k), sizeof (t)->key, STBDS_HM_STRING),   \\\n     (t)[stbds_temp((t)-1)].value = (v))\n\n#define stbds_shputi(t, k, v) \\\n    ((t) = stbds_hmput_key_wrapper((t), sizeof *(t), (void*) (k), sizeof (t)->key, STBDS_HM_STRING),   \\\n     (t)[stbds_temp((t)-1)].value = (v), stbds_temp((t)-1))\n\n#define stbds_shputs(t, s) \\\n    ((t) = stbds_hmput_key_wrapper((t), sizeof *(t), (void*) (s).key, sizeof (s).key, STBDS_HM_STRING), \\\n     (t)[stbds_temp((t)-1)] = (s), \\\n     (t)[stbds_temp((t)-1)].key = stbds_temp_key((t)-1)) // above line overwrites whole structure, so must rewrite key here if it was allocated internally\n\n#define stbds_pshput(t, p) \\\n    ((t) = stbds_hmput_key_wrapper((t), sizeof *(t), (void*) (p)->key, sizeof (p)->key, STBDS_HM_PTR_TO_STRING), \\\n     (t)[stbds_temp((t)-1)] = (p))\n\n#define stbds_shgeti(t,k) \\\n     ((t) = stbds_hmget_key_wrapper((t), sizeof *(t), (void*) (k), sizeof (t)->key, STBDS_HM_STRING), \\\n      stbds_temp((t)-1))\n\n#define stbds_pshgeti(t,k) \\\n     ((t) = stbds_hmget_key_wrapper((t), sizeof *(t), (void*) (k), sizeof (*(t))->key, STBDS_HM_PTR_TO_STRING), \\\n      stbds_temp((t)-1))\n\n#define stbds_shgetp(t, k) \\\n    ((void) stbds_shgeti(t,k), &(t)[stbds_temp((t)-1)])\n\n#define stbds_pshget(t, k) \\\n    ((void) stbds_pshgeti(t,k), (t)[stbds_temp((t)-1)])\n\n#define stbds_shdel(t,k) \\\n    (((t) = stbds_hmdel_key_wrapper((t),sizeof *(t), (void*) (k), sizeof (t)->key, STBDS_OFFSETOF((t),key), STBDS_HM_STRING)),(t)?stbds_temp((t)-1):0)\n#define stbds_pshdel(t,k) \\\n    (((t) = stbds_hmdel_key_wrapper((t),sizeof *(t), (void*) (k), sizeof (*(t))->key, STBDS_OFFSETOF(*(t),key), STBDS_HM_PTR_TO_STRING)),(t)?stbds_temp((t)-1):0)\n\n#define stbds_sh_new_arena(t)  \\\n    ((t) = stbds_shmode_func_wrapper(t, sizeof *(t), STBDS_SH_ARENA))\n#define stbds_sh_new_strdup(t) \\\n    ((t) = stbds_shmode_func_wrapper(t, sizeof *(t), STBDS_SH_STRDUP))\n\n#define stbds_shdefault(t, v)  stbds_hmdefault(t,v)\n#define stbds_shdefaults(t, s) stbds_hmdefaults(t,s)\n\n#define stbds_shfree       stbds_hmfree\n#define stbds_shlenu       stbds_hmlenu\n\n#define stbds_shgets(t, k) (*stbds_shgetp(t,k))\n#define stbds_shget(t, k)  (stbds_shgetp(t,k)->value)\n#define stbds_shgetp_null(t,k)  (stbds_shgeti(t,k) == -1 ? NULL : &(t)[stbds_temp((t)-1)])\n#define stbds_shlen        stbds_hmlen\n\ntypedef struct\n{\n  size_t      length;\n  size_t      capacity;\n  void      * hash_table;\n  ptrdiff_t   temp;\n} stbds_array_header;\n\ntypedef struct stbds_string_block\n{\n  struct stbds_string_block *next;\n  char storage[8];\n} stbds_string_block;\n\nstruct stbds_string_arena\n{\n  stbds_string_block *storage;\n  size_t remaining;\n  unsigned char block;\n  unsigned char mode;  // this isn't used by the string arena itself\n};\n\n#define STBDS_HM_BINARY         0\n#define STBDS_HM_STRING         1\n\nenum\n{\n   STBDS_SH_NONE,\n   STBDS_SH_DEFAULT,\n   STBDS_SH_STRDUP,\n   STBDS_SH_ARENA\n};\n\n#ifdef __cplusplus\n// in C we use implicit assignment from these void*-returning functions to T*.\n// in C++ these templates make the same code work\ntemplate<class T> static T * stbds_arrgrowf_wrapper(T *a, size_t elemsize, size_t addlen, size_t min_cap) {\n  return (T*)stbds_arrgrowf((void *)a, elemsize, addlen, min_cap);\n}\ntemplate<class T> static T * stbds_hmget_key_wrapper(T *a, size_t elemsize, void *key, size_t keysize, int mode) {\n  return (T*)stbds_hmget_key((void*)a, elemsize, key, keysize, mode);\n}\ntemplate<class T> static T * stbds_hmget_key_ts_wrapper(T *a, size_t elemsize, void *key, size_t keysize, ptrdiff_t *temp, int mode) {\n  return (T*)stbds_hmget_key_ts((void*)a, elemsize, key, keysize, temp, mode);\n}\ntemplate<class T> static T * stbds_hmput_default_wrapper(T *a, size_t elemsize) {\n  return (T*)stbds_hmput_default((void *)a, elemsize);\n}\ntemplate<class T> static T * stbds_hmput_key_wrapper(T *a, size_t elemsize, void *key, size_t keysize, int mode) {\n  return (T*)stbds_hmput_key((void*)a, elemsize, key, keysize, mode);\n}\ntemplate<class T> static T * stbds_hmdel_key_wrapper(T *a, size_t elemsize, void *key, size_t keysize, size_t keyoffset, int mode){\n  return (T*)stbds_hmdel_key((void*)a, elemsize, key, keysize, keyoffset, mode);\n}\ntemplate<class T> static T * stbds_shmode_func_wrapper(T *, size_t elemsize, int mode) {\n  return (T*)stbds_shmode_func(elemsize, mode);\n}\n#else\n#define stbds_arrgrowf_wrapper            stbds_arrgrowf\n#define stbds_hmget_key_wrapper           stbds_hmget_key\n#define stbds_hmget_key_ts_wrapper        stbds_hmget_key_ts\n#define stbds_hmput_default_wrapper       stbds_hmput_default\n#define stbds_hmput_key_wrapper           stbds_hmput_key\n#define stbds_hmdel_key_wrapper           stbds_hmdel_key\n#define stbds_shmode_func_wrapper(t,e,m)  stbds_shmode_func(e,m)\n#endif\n\n#endif // INCLUDE_STB_DS_H\n\n\n//////////////////////////////////////////////////////////////////////////////\n//\n//   IMPLEMENTATION\n//\n\n#ifdef STB_DS_IMPLEMENTATION\n#include <assert.h>\n#include <string.h>\n\n#ifndef STBDS_ASSERT\n#define STBDS_ASSERT_WAS_UNDEFINED\n#define STBDS_ASSERT(x)   ((void) 0)\n#endif\n\n#ifdef STBDS_STATISTICS\n#define STBDS_STATS(x)   x\nsize_t stbds_array_grow;\nsize_t stbds_hash_grow;\nsize_t stbds_hash_shrink;\nsize_t stbds_hash_rebuild;\nsize_t stbds_hash_probes;\nsize_t stbds_hash_alloc;\nsize_t stbds_rehash_probes;\nsize_t stbds_rehash_items;\n#else\n#define STBDS_STATS(x)\n#endif\n\n//\n// stbds_arr implementation\n//\n\n//int *prev_allocs[65536];\n//int num_prev;\n\nvoid *stbds_arrgrowf(void *a, size_t elemsize, size_t addlen, size_t min_cap)\n{\n  stbds_array_header temp={0}; // force debugging\n  void *b;\n  size_t min_len = stbds_arrlen(a) + addlen;\n  (void) sizeof(temp);\n\n  // compute the minimum capacity needed\n  if (min_len > min_cap)\n    min_cap = min_len;\n\n  if (min_cap <= stbds_arrcap(a))\n    return a;\n\n  // increase needed capacity to guarantee O(1) amortized\n  if (min_cap < 2 * stbds_arrcap(a))\n    min_cap = 2 * stbds_arrcap(a);\n  else if (min_cap < 4)\n    min_cap = 4;\n\n  //if (num_prev < 65536) if (a) prev_allocs[num_prev++] = (int *) ((char *) a+1);\n  //if (num_prev == 2201)\n  //  num_prev = num_prev;\n  b = STBDS_REALLOC(NULL, (a) ? stbds_header(a) : 0, elemsize * min_cap + sizeof(stbds_array_header));\n  //if (num_prev < 65536) prev_allocs[num_prev++] = (int *) (char *) b;\n  b = (char *) b + sizeof(stbds_array_header);\n  if (a == NULL) {\n    stbds_header(b)->length = 0;\n    stbds_header(b)->hash_table = 0;\n    stbds_header(b)->temp = 0;\n  } else {\n    STBDS_STATS(++stbds_array_grow);\n  }\n  stbds_header(b)->capacity = min_cap;\n\n  return b;\n}\n\nvoid stbds_arrfreef(void *a)\n{\n  STBDS_FREE(NULL, stbds_header(a));\n}\n\n//\n// stbds_hm hash table implementation\n//\n\n#ifdef STBDS_INTERNAL_SMALL_BUCKET\n#define STBDS_BUCKET_LENGTH      4\n#else\n#define STBDS_BUCKET_LENGTH      8\n#endif\n\n#define STBDS_BUCKET_SHIFT      (STBDS_BUCKET_LENGTH == 8 ? 3 : 2)\n#define STBDS_BUCKET_MASK       (STBDS_BUCKET_LENGTH-1)\n#define STBDS_CACHE_LINE_SIZE   64\n\n#define STBDS_ALIGN_FWD(n,a)   (((n) + (a) - 1) & ~((a)-1))\n\ntypedef struct\n{\n   size_t    hash [STBDS_BUCKET_LENGTH];\n   ptrdiff_t index[STBDS_BUCKET_LENGTH];\n} stbds_hash_bucket; // in 32-bit, this is one 64-byte cache line; in 64-bit, each array is one 64-byte cache line\n\ntypedef struct\n{\n  char * temp_key; // this MUST be the first field of the hash table\n  size_t slot_count;\n  size_t used_count;\n  size_t used_count_threshold;\n  size_t used_count_shrink_threshold;\n  size_t tombstone_count;\n  size_t tombstone_count_threshold;\n  size_t seed;\n  size_t slot_count_log2;\n  stbds_string_arena string;\n  stbds_hash_bucket *storage; // not a separate allocation, just 64-byte aligned storage after this struct\n} stbds_hash_index;\n\n#define STBDS_INDEX_EMPTY    -1\n#define STBDS_INDEX_DELETED  -2\n#define STBDS_INDEX_IN_USE(x)  ((x) >= 0)\n\n#define STBDS_HASH_EMPTY      0\n#define STBDS_HASH_DELETED    1\n\nstatic size_t stbds_hash_seed=0x31415926;\n\nvoid stbds_rand_seed(size_t seed)\n{\n  stbds_hash_seed = seed;\n}\n\n#define stbds_load_32_or_64(var, temp, v32, v64_hi, v64_lo)                                          \\\n  temp = v64_lo ^ v32, temp <<= 16, temp <<= 16, temp >>= 16, temp >>= 16, /* discard if 32-bit */   \\\n  var = v64_hi, var <<= 16, var <<= 16,                                    /* discard if 32-bit */   \\\n  var ^= temp ^ v32\n\n#define STBDS_SIZE_T_BITS           ((sizeof (size_t)) * 8)\n\nstatic size_t stbds_probe_position(size_t hash, size_t slot_count, size_t slot_log2)\n{\n  size_t pos;\n  STBDS_NOTUSED(slot_log2);\n  pos = hash & (slot_count-1);\n  #ifdef STBDS_INTERNAL_BUCKET_START\n  pos &= ~STBDS_BUCKET_MASK;\n  #endif\n  return pos;\n}\n\nstatic size_t stbds_log2(size_t slot_count)\n{\n  size_t n=0;\n  while (slot_count > 1) {\n    slot_count >>= 1;\n    ++n;\n  }\n  return n;\n}\n\nstatic stbds_hash_index *stbds_make_hash_index(size_t slot_count, stbds_hash_index *ot)\n{\n  stbds_hash_index *t;\n  t = (stbds_hash_index *) STBDS_REALLOC(NULL,0,(slot_count >> STBDS_BUCKET_SHIFT) * sizeof(stbds_hash_bucket) + sizeof(stbds_hash_index) + STBDS_CACHE_LINE_SIZE-1);\n  t->storage = (stbds_hash_bucket *) STBDS_ALIGN_FWD((size_t) (t+1), STBDS_CACHE_LINE_SIZE);\n  t->slot_count = slot_count;\n  t->slot_count_log2 = stbds_log2(slot_count);\n  t->tombstone_count = 0;\n  t->used_count = 0;\n\n  #if 0 // A1\n  t->used_count_threshold        = slot_count*12/16; // if 12/16th of table is occupied, grow\n  t->tombstone_count_threshold   = slot_count* 2/16; // if tombstones are 2/16th of table, rebuild\n  t->used_count_shrink_threshold = slot_count* 4/16; // if table is only 4/16th full, shrink\n  #elif 1 // A2\n  //t->used_count_threshold        = slot_count*12/16; // if 12/16th of table is occupied, grow\n  //t->tombstone_count_threshold   = slot_count* 3/16; // if tombstones are 3/16th of table, rebuild\n  //t->used_count_shrink_threshold = slot_count* 4/16; // if table is only 4/16th full, shrink\n\n  // compute without overflowing\n  t->used_count_threshold        = slot_count - (slot_count>>2);\n  t->tombstone_count_threshold   = (slot_count>>3) + (slot_count>>4);\n  t->used_count_shrink_threshold = slot_count >> 2;\n\n  #elif 0 // B1\n  t->used_count_threshold        = slot_count*13/16; // if 13/16th of table is occupied, grow\n  t->tombstone_count_threshold   = slot_count* 2/16; // if tombstones are 2/16th of table, rebuild\n  t->used_count_shrink_threshold = slot_count* 5/16; // if table is only 5/16th full, shrink\n  #else // C1\n  t->used_count_threshold        = slot_count*14/16; // if 14/16th of table is occupied, grow\n  t->tombstone_count_threshold   = slot_count* 2/16; // if tombstones are 2/16th of table, rebuild\n  t->used_count_shrink_threshold = slot_count* 6/16; // if table is only 6/16th full, shrink\n  #endif\n  // Following statistics were measured on a Core i7-6700 @ 4.00Ghz, compiled with clang 7.0.1 -O2\n    // Note that the larger tables have high variance as they were run fewer times\n  //     A1            A2          B1           C1\n  //    0.10ms :     0.10ms :     0.10ms :     0.11ms :      2,000 inserts creating 2K table\n  //    0.96ms :     0.95ms :     0.97ms :     1.04ms :     20,000 inserts creating 20K table\n  //   14.48ms :    14.46ms :    10.63ms :    11.00ms :    200,000 inserts creating 200K table\n  //  195.74ms :   196.35ms :   203.69ms :   214.92ms :  2,000,000 inserts creating 2M table\n  // 2193.88ms :  2209.22ms :  2285.54ms :  2437.17ms : 20,000,000 inserts creating 20M table\n  //   65.27ms :    53.77ms :    65.33ms :    65.47ms : 500,000 inserts & deletes in 2K table\n  //   72.78ms :    62.45ms :    71.95ms :    72.85ms : 500,000 inserts & deletes in 20K table\n  //   89.47ms :    77.72ms :    96.49ms :    96.75ms : 500,000 inserts & deletes in 200K table\n  //   97.58ms :    98.14ms :    97.18ms :    97.53ms : 500,000 inserts & deletes in 2M table\n  //  118.61ms :   119.62ms :   120.16ms :   118.86ms : 500,000 inserts & deletes in 20M table\n  //  192.11ms :   194.39ms :   196.38ms :   195.73ms : 500,000 inserts & deletes in 200M table\n\n  if (slot_count <= STBDS_BUCKET_LENGTH)\n    t->used_count_shrink_threshold = 0;\n  // to avoid infinite loop, we need to guarantee that at least one slot is empty and will terminate probes\n  STBDS_ASSERT(t->used_count_threshold + t->tombstone_count_threshold < t->slot_count);\n  STBDS_STATS(++stbds_hash_alloc);\n  if (ot) {\n    t->string = ot->string;\n    // reuse old seed so we can reuse old hashes so below \"copy out old data\" doesn't do any hashing\n    t->seed = ot->seed;\n  } else {\n    size_t a,b,temp;\n    memset(&t->string, 0, sizeof(t->string));\n    t->seed = stbds_hash_seed;\n    // LCG\n    // in 32-bit, a =          2147001325   b =  715136305\n    // in 64-bit, a = 2862933555777941757   b = 3037000493\n    stbds_load_32_or_64(a,temp, 2147001325, 0x27bb2ee6, 0x87b0b0fd);\n    stbds_load_32_or_64(b,temp,  715136305,          0, 0xb504f32d);\n    stbds_hash_seed = stbds_hash_seed  * a + b;\n  }\n\n  {\n    size_t i,j;\n    for (i=0; i < slot_count >> STBDS_BUCKET_SHIFT; ++i) {\n      stbds_hash_bucket *b = &t->storage[i];\n      for (j=0; j < STBDS_BUCKET_LENGTH; ++j)\n        b->hash[j] = STBDS_HASH_EMPTY;\n      for (j=0; j < STBDS_BUCKET_LENGTH; ++j)\n        b->index[j] = STBDS_INDEX_EMPTY;\n    }\n  }\n\n  // copy out the old data, if any\n  if (ot) {\n    size_t i,j;\n    t->used_count = ot->used_count;\n    for (i=0; i < ot->slot_count >> STBDS_BUCKET_SHIFT; ++i) {\n      stbds_hash_bucket *ob = &ot->storage[i];\n      for (j=0; j < STBDS_BUCKET_LENGTH; ++j) {\n        if (STBDS_INDEX_IN_USE(ob->index[j])) {\n          size_t hash = ob->hash[j];\n          size_t pos = stbds_probe_position(hash, t->slot_count, t->slot_count_log2);\n          size_t step = STBDS_BUCKET_LENGTH;\n          STBDS_STATS(++stbds_rehash_items);\n          for (;;) {\n            size_t limit,z;\n            stbds_hash_bucket *bucket;\n            bucket = &t->storage[pos >> STBDS_BUCKET_SHIFT];\n            STBDS_STATS(++stbds_rehash_probes);\n\n            for (z=pos & STBDS_BUCKET_MASK; z < STBDS_BUCKET_LENGTH; ++z) {\n              if (bucket->hash[z] == 0) {\n                bucket->hash[z] = hash;\n                bucket->index[z] = ob->index[j];\n                goto done;\n              }\n            }\n\n            limit = pos & STBDS_BUCKET_MASK;\n            for (z = 0; z < limit; ++z) {\n              if (bucket->hash[z] == 0) {\n                bucket->hash[z] = hash;\n                bucket->index[z] = ob->index[j];\n                goto done;\n              }\n            }\n\n            pos += step;                  // quadratic probing\n            step += STBDS_BUCKET_LENGTH;\n            pos &= (t->slot_count-1);\n          }\n        }\n       done:\n        ;\n      }\n    }\n  }\n\n  return t;\n}\n\n#define STBDS_ROTATE_LEFT(val, n)   (((val) << (n)) | ((val) >> (STBDS_SIZE_T_BITS - (n))))\n#define STBDS_ROTATE_RIGHT(val, n)  (((val) >> (n)) | ((val) << (STBDS_SIZE_T_BITS - (n))))\n\nsize_t stbds_hash_string(char *str, size_t seed)\n{\n#ifdef STBDS_HASH_STRING\n  return STBDS_HASH_STRING(str, seed);\n#else\n  size_t hash = seed;\n  while (*str)\n     hash = STBDS_ROTATE_LEFT(hash, 9) + (unsigned char) *str++;\n\n  // Thomas Wang 64-to-32 bit mix function, hopefully also works in 32 bits\n  hash ^= seed;\n  hash = (~hash) + (hash << 18);\n  hash ^= hash ^ STBDS_ROTATE_RIGHT(hash,31);\n  hash = hash * 21;\n  hash ^= hash ^ STBDS_ROTATE_RIGHT(hash,11);\n  hash += (hash << 6);\n  hash ^= STBDS_ROTATE_RIGHT(hash,22);\n  return hash+seed;\n#endif\n}\n\n#ifdef STBDS_SIPHASH_2_4\n#define STBDS_SIPHASH_C_ROUNDS 2\n#define STBDS_SIPHASH_D_ROUNDS 4\ntypedef int STBDS_SIPHASH_2_4_can_only_be_used_in_64_bit_builds[sizeof(size_t) == 8 ? 1 : -1];\n#endif\n\n#ifndef STBDS_SIPHASH_C_ROUNDS\n#define STBDS_SIPHASH_C_ROUNDS 1\n#endif\n#ifndef STBDS_SIPHASH_D_ROUNDS\n#define STBDS_SIPHASH_D_ROUNDS 1\n#endif\n\n#ifdef _MSC_VER\n#pragma warning(push)\n#pragma warning(disable:4127) // conditional expression is constant, for do..while(0) and sizeof()==\n#endif\n\nstatic size_t stbds_siphash_bytes(void *p, size_t len, size_t seed)\n{\n  unsigned char *d = (unsigned char *) p;\n  size_t i,j;\n  size_t v0,v1,v2,v3, data;\n\n  // hash that works on 32- or 64-bit registers without knowing which we have\n  // (computes different results on 32-bit and 64-bit platform)\n  // derived from siphash, but on 32-bit platforms very different as it uses 4 32-bit state not 4 64-bit\n  v0 = ((((size_t) 0x736f6d65 << 16) << 16) + 0x70736575) ^  seed;\n  v1 = ((((size_t) 0x646f7261 << 16) << 16) + 0x6e646f6d) ^ ~seed;\n  v2 = ((((size_t) 0x6c796765 << 16) << 16) + 0x6e657261) ^  seed;\n  v3 = ((((size_t) 0x74656462 << 16) << 16) + 0x79746573) ^ ~seed;\n\n  #ifdef STBDS_TEST_SIPHASH_2_4\n  // hardcoded with key material in the siphash test vectors\n  v0 ^= 0x0706050403020100ull ^  seed;\n  v1 ^= 0x0f0e0d0c0b0a0908ull ^ ~seed;\n  v2 ^= 0x0706050403020100ull ^  seed;\n  v3 ^= 0x0f0e0d0c0b0a0908ull ^ ~seed;\n  #endif\n\n  #define STBDS_SIPROUND() \\\n    do {                   \\\n      v0 += v1; v1 = STBDS_ROTATE_LEFT(v1, 13);  v1 ^= v0; v0 = STBDS_ROTATE_LEFT(v0,STBDS_SIZE_T_BITS/2); \\\n      v2 += v3; v3 = STBDS_ROTATE_LEFT(v3, 16);  v3 ^= v2;                                                 \\\n      v2 += v1; v1 = STBDS_ROTATE_LEFT(v1, 17);  v1 ^= v2; v2 = STBDS_ROTATE_LEFT(v2,STBDS_SIZE_T_BITS/2); \\\n      v0 += v3; v3 = STBDS_ROTATE_LEFT(v3, 21);  v3 ^= v0;                                                 \\\n    } while (0)\n\n  for (i=0; i+sizeof(size_t) <= len; i += sizeof(size_t), d += sizeof(size_t)) {\n    data = d[0] | (d[1] << 8) | (d[2] << 16) | (d[3] << 24);\n    data |= (size_t) (d[4] | (d[5] << 8) | (d[6] << 16) | (d[7] << 24)) << 16 << 16; // discarded if size_t == 4\n\n    v3 ^= data;\n    for (j=0; j < STBDS_SIPHASH_C_ROUNDS; ++j)\n      STBDS_SIPROUND();\n    v0 ^= data;\n  }\n  data = len << (STBDS_SIZE_T_BITS-8);\n  switch (len - i) {\n    case 7: data |= ((size_t) d[6] << 24) << 24; // fall through\n    case 6: data |= ((size_t) d[5] << 20) << 20; // fall through\n    case 5: data |= ((size_t) d[4] << 16) << 16; // fall through\n    case 4: data |= (d[3] << 24); // fall through\n    case 3: data |= (d[2] << 16); // fall through\n    case 2: data |= (d[1] << 8); // fall through\n    case 1: data |= d[0]; // fall through\n    case 0: break;\n  }\n  v3 ^= data;\n  for (j=0; j < STBDS_SIPHASH_C_ROUNDS; ++j)\n    STBDS_SIPROUND();\n  v0 ^= data;\n  v2 ^= 0xff;\n  for (j=0; j < STBDS_SIPHASH_D_ROUNDS; ++j)\n    STBDS_SIPROUND();\n\n#ifdef STBDS_SIPHASH_2_4\n  return v0^v1^v2^v3;\n#else\n  return v1^v2^v3; // slightly stronger since v0^v3 in above cancels out final round operation? I tweeted at the authors of SipHash about this but they didn't reply\n#endif\n}\n\nsize_t stbds_hash_bytes(void *p, size_t len, size_t seed)\n{\n#ifdef STBDS_SIPHASH_2_4\n  return stbds_siphash_bytes(p,len,seed);\n#else\n  unsigned char *d = (unsigned char *) p;\n\n  if (len == 4) {\n    unsigned int hash = d[0] | (d[1] << 8) | (d[2] << 16) | (d[3] << 24);\n    #if 0\n    // HASH32-A  Bob Jenkin's hash function w/o large constants\n    hash ^= seed;\n    hash -= (hash<<6);\n    hash ^= (hash>>17);\n    hash -= (hash<<9);\n    hash ^= seed;\n    hash ^= (hash<<4);\n    hash -= (hash<<3);\n    hash ^= (hash<<10);\n    hash ^= (hash>>15);\n    #elif 1\n    // HASH32-BB  Bob Jenkin's presumably-accidental version of Thomas Wang hash with rotates turned into shifts.\n    // Note that converting these back to rotates makes it run a lot slower, presumably due to collisions, so I'm\n    // not really sure what's going on.\n    hash ^= seed;\n    hash = (hash ^ 61) ^ (hash >> 16);\n    hash = hash + (hash << 3);\n    hash = hash ^ (hash >> 4);\n    hash = hash * 0x27d4eb2d;\n    hash ^= seed;\n    hash = hash ^ (hash >> 15);\n    #else  // HASH32-C   -  Murmur3\n    hash ^= seed;\n    hash *= 0xcc9e2d51;\n    hash = (hash << 17) | (hash >> 15);\n    hash *= 0x1b873593;\n    hash ^= seed;\n    hash = (hash << 19) | (hash >> 13);\n    hash = hash*5 + 0xe6546b64;\n    hash ^= hash >> 16;\n    hash *= 0x85ebca6b;\n    hash ^= seed;\n    hash ^= hash >> 13;\n    hash *= 0xc2b2ae35;\n    hash ^= hash >> 16;\n    #endif\n    // Following statistics were measured on a Core i7-6700 @ 4.00Ghz, compiled with clang 7.0.1 -O2\n    // Note that the larger tables have high variance as they were run fewer times\n    //  HASH32-A   //  HASH32-BB  //  HASH32-C\n    //    0.10ms   //    0.10ms   //    0.10ms :      2,000 inserts creating 2K table\n    //    0.96ms   //    0.95ms   //    0.99ms :     20,000 inserts creating 20K table\n    //   14.69ms   //   14.43ms   //   14.97ms :    200,000 inserts creating 200K table\n    //  199.99ms   //  195.36ms   //  202.05ms :  2,000,000 inserts creating 2M table\n    // 2234.84ms   // 2187.74ms   // 2240.38ms : 20,000,000 inserts creating 20M table\n    //   55.68ms   //   53.72ms   //   57.31ms : 500,000 inserts & deletes in 2K table\n    //   63.43ms   //   61.99ms   //   65.73ms : 500,000 inserts & deletes in 20K table\n    //   80.04ms   //   77.96ms   //   81.83ms : 500,000 inserts & deletes in 200K table\n    //  100.42ms   //   97.40ms   //  102.39ms : 500,000 inserts & deletes in 2M table\n    //  119.71ms   //  120.59ms   //  121.63ms : 500,000 inserts & deletes in 20M table\n    //  185.28ms   //  195.15ms   //  187.74ms : 500,000 inserts & deletes in 200M table\n    //   15.58ms   //   14.79ms   //   15.52ms : 200,000 inserts creating 200K table with varying key spacing\n\n    return (((size_t) hash << 16 << 16) | hash) ^ seed;\n  } else if (len == 8 && sizeof(size_t) == 8) {\n    size_t hash = d[0] | (d[1] << 8) | (d[2] << 16) | (d[3] << 24);\n    hash |= (size_t) (d[4] | (d[5] << 8) | (d[6] << 16) | (d[7] << 24)) << 16 << 16; // avoid warning if size_t == 4\n    hash ^= seed;\n    hash = (~hash) + (hash << 21);\n    hash ^= STBDS_ROTATE_RIGHT(hash,24);\n    hash *= 265;\n    hash ^= STBDS_ROTATE_RIGHT(hash,14);\n    hash ^= seed;\n    hash *= 21;\n    hash ^= STBDS_ROTATE_RIGHT(hash,28);\n    hash += (hash << 31);\n    hash = (~hash) + (hash << 18);\n    return hash;\n  } else {\n    return stbds_siphash_bytes(p,len,seed);\n  }\n#endif\n}\n#ifdef _MSC_VER\n#pragma warning(pop)\n#endif\n\n\nstatic int stbds_is_key_equal(void *a, size_t elemsize, void *key, size_t keysize, size_t keyoffset, int mode, size_t i)\n{\n  if (mode >= STBDS_HM_STRING)\n    return 0==strcmp((char *) key, * (char **) ((char *) a + elemsize*i + keyoffset));\n  else\n    return 0==memcmp(key, (char *) a + elemsize*i + keyoffset, keysize);\n}\n\n#define STBDS_HASH_TO_ARR(x,elemsize) ((char*) (x) - (elemsize))\n#define STBDS_ARR_TO_HASH(x,elemsize) ((char*) (x) + (elemsize))\n\n#define stbds_hash_table(a)  ((stbds_hash_index *) stbds_header(a)->hash_table)\n\nvoid stbds_hmfree_func(void *a, size_t elemsize)\n{\n  if (a == NULL) return;\n  if (stbds_hash_table(a) != NULL) {\n    if (stbds_hash_table(a)->string.mode == STBDS_SH_STRDUP) {\n      size_t i;\n      // skip 0th element, which is default\n      for (i=1; i < stbds_header(a)->length; ++i)\n        STBDS_FREE(NULL, *(char**) ((char *) a + elemsize*i));\n    }\n    stbds_strreset(&stbds_hash_table(a)->string);\n  }\n  STBDS_FREE(NULL, stbds_header(a)->hash_table);\n  STBDS_FREE(NULL, stbds_header(a));\n}\n\nstatic ptrdiff_t stbds_hm_find_slot(void *a, size_t elemsize, void *key, size_t keysize, size_t keyoffset, int mode)\n{\n  void *raw_a = STBDS_HASH_TO_ARR(a,elemsize);\n  stbds_hash_index *table = stbds_hash_table(raw_a);\n  size_t hash = mode >= STBDS_HM_STRING ? stbds_hash_string((char*)key,table->seed) : stbds_hash_bytes(key, keysize,table->seed);\n  size_t step = STBDS_BUCKET_LENGTH;\n  size_t limit,i;\n  size_t pos;\n  stbds_hash_bucket *bucket;\n\n  if (hash < 2) hash += 2; // stored hash values are forbidden from being 0, so we can detect empty slots\n\n  pos = stbds_probe_position(hash, table->slot_count, table->slot_count_log2);\n\n  for (;;) {\n    STBDS_STATS(++stbds_hash_probes);\n    bucket = &table->storage[pos >> STBDS_BUCKET_SHIFT];\n\n    // start searching from pos to end of bucket, this should help performance on small hash tables that fit in cache\n    for (i=pos & STBDS_BUCKET_MASK; i < STBDS_BUCKET_LENGTH; ++i) {\n      if (bucket->hash[i] == hash) {\n        if (stbds_is_key_equal(a, elemsize, key, keysize, keyoffset, mode, bucket->index[i])) {\n          return (pos & ~STBDS_BUCKET_MASK)+i;\n        }\n      } else if (bucket->hash[i] == STBDS_HASH_EMPTY) {\n        return -1;\n      }\n    }\n\n    // search from beginning of bucket to pos\n    limit = pos & STBDS_BUCKET_MASK;\n    for (i = 0; i < limit; ++i) {\n      if (bucket->hash[i] == hash) {\n        if (stbds_is_key_equal(a, elemsize, key, keysize, keyoffset, mode, bucket->index[i])) {\n          return (pos & ~STBDS_BUCKET_MASK)+i;\n        }\n      } else if (bucket->hash[i] == STBDS_HASH_EMPTY) {\n        return -1;\n      }\n    }\n\n    // quadratic probing\n    pos += step;\n    step += STBDS_BUCKET_LENGTH;\n    pos &= (table->slot_count-1);\n  }\n  /* NOTREACHED */\n}\n\nvoid * stbds_hmget_key_ts(void *a, size_t elemsize, void *key, size_t keysize, ptrdiff_t *temp, int mode)\n{\n  size_t keyoffset = 0;\n  if (a == NULL) {\n    // make it non-empty so we can return a temp\n    a = stbds_arrgrowf(0, elemsize, 0, 1);\n    stbds_header(a)->length += 1;\n    memset(a, 0, elemsize);\n    *temp = STBDS_INDEX_EMPTY;\n    // adjust a to point after the default element\n    return STBDS_ARR_TO_HASH(a,elemsize);\n  } else {\n    stbds_hash_index *table;\n    void *raw_a = STBDS_HASH_TO_ARR(a,elemsize);\n    // adjust a to point to the default element\n    table = (stbds_hash_index *) stbds_header(raw_a)->hash_table;\n    if (table == 0) {\n      *temp = -1;\n    } else {\n      ptrdiff_t slot = stbds_hm_find_slot(a, elemsize, key, keysize, keyoffset, mode);\n      if (slot < 0) {\n        *temp = STBDS_INDEX_EMPTY;\n      } else {\n        stbds_hash_bucket *b = &table->storage[slot >> STBDS_BUCKET_SHIFT];\n        *temp = b->index[slot & STBDS_BUCKET_MASK];\n      }\n    }\n    return a;\n  }\n}\n\nvoid * stbds_hmget_key(void *a, size_t elemsize, void *key, size_t keysize, int mode)\n{\n  ptrdiff_t temp;\n  void *p = stbds_hmget_key_ts(a, elemsize, key, keysize, &temp, mode);\n  stbds_temp(STBDS_HASH_TO_ARR(p,elemsize)) = temp;\n  return p;\n}\n\nvoid * stbds_hmput_default(void *a, size_t elemsize)\n{\n  // three cases:\n  //   a is NULL <- allocate\n  //   a has a hash table but no entries, because of shmode <- grow\n  //   a has entries <- do nothing\n  if (a == NULL || stbds_header(STBDS_HASH_TO_ARR(a,elemsize))->length == 0) {\n    a = stbds_arrgrowf(a ? STBDS_HASH_TO_ARR(a,elemsize) : NULL, elemsize, 0, 1);\n    stbds_header(a)->length += 1;\n    memset(a, 0, elemsize);\n    a=STBDS_ARR_TO_HASH(a,elemsize);\n  }\n  return a;\n}\n\nstatic char *stbds_strdup(char *str);\n\nvoid *stbds_hmput_key(void *a, size_t elemsize, void *key, size_t keysize, int mode)\n{\n  size_t keyoffset=0;\n  void *raw_a;\n  stbds_hash_index *table;\n\n  if (a == NULL) {\n    a = stbds_arrgrowf(0, elemsize, 0, 1);\n    memset(a, 0, elemsize);\n    stbds_header(a)->length += 1;\n    // adjust a to point AFTER the default element\n    a = STBDS_ARR_TO_HASH(a,elemsize);\n  }\n\n  // adjust a to point to the default element\n  raw_a = a;\n  a = STBDS_HASH_TO_ARR(a,elemsize);\n\n  table = (stbds_hash_index *) stbds_header(a)->hash_table;\n\n  if (table == NULL || table->used_count >= table->used_count_threshold) {\n    stbds_hash_index *nt;\n    size_t slot_count;\n\n    slot_count = (table == NULL) ? STBDS_BUCKET_LENGTH : table->slot_count*2;\n    nt = stbds_make_hash_index(slot_count, table);\n    if (table)\n      STBDS_FREE(NULL, table);\n    else\n      nt->string.mode = mode >= STBDS_HM_STRING ? STBDS_SH_DEFAULT : 0;\n    stbds_header(a)->hash_table = table = nt;\n    STBDS_STATS(++stbds_hash_grow);\n  }\n\n  // we iterate hash table explicitly because we want to track if we saw a tombstone\n  {\n    size_t hash = mode >= STBDS_HM_STRING ? stbds_hash_string((char*)key,table->seed) : stbds_hash_bytes(key, keysize,table->seed);\n    size_t step = STBDS_BUCKET_LENGTH;\n    size_t pos;\n    ptrdiff_t tombstone = -1;\n    stbds_hash_bucket *bucket;\n\n    // stored hash values are forbidden from being 0, so we can detect empty slots to early out quickly\n    if (hash < 2) hash += 2;\n\n    pos = stbds_probe_position(hash, table->slot_count, table->slot_count_log2);\n\n    for (;;) {\n      size_t limit, i;\n      STBDS_STATS(++stbds_hash_probes);\n      bucket = &table->storage[pos >> STBDS_BUCKET_SHIFT];\n\n      // start searching from pos to end of bucket\n      for (i=pos & STBDS_BUCKET_MASK; i < STBDS_BUCKET_LENGTH; ++i) {\n        if (bucket->hash[i] == hash) {\n          if (stbds_is_key_equal(raw_a, elemsize, key, keysize, keyoffset, mode, bucket->index[i])) {\n            stbds_temp(a) = bucket->index[i];\n            if (mode >= STBDS_HM_STRING)\n              stbds_temp_key(a) = * (char **) ((char *) raw_a + elemsize*bucket->index[i] + keyoffset);\n            return STBDS_ARR_TO_HASH(a,elemsize);\n          }\n        } else if (bucket->hash[i] == 0) {\n          pos = (pos & ~STBDS_BUCKET_MASK) + i;\n          goto found_empty_slot;\n        } else if (tombstone < 0) {\n          if (bucket->index[i] == STBDS_INDEX_DELETED)\n            tombstone = (ptrdiff_t) ((pos & ~STBDS_BUCKET_MASK) + i);\n        }\n      }\n\n      // search from beginning of bucket to pos\n      limit = pos & STBDS_BUCKET_MASK;\n      for (i = 0; i < limit; ++i) {\n        if (bucket->hash[i] == hash) {\n          if (stbds_is_key_equal(raw_a, elemsize, key, keysize, keyoffset, mode, bucket->index[i])) {\n            stbds_temp(a) = bucket->index[i];\n            return STBDS_ARR_TO_HASH(a,elemsize);\n          }\n        } else if (bucket->hash[i] == 0) {\n          pos = (pos & ~STBDS_BUCKET_MASK) + i;\n          goto found_empty_slot;\n        } else if (tombstone < 0) {\n          if (bucket->index[i] == STBDS_INDEX_DELETED)\n            tombstone = (ptrdiff_t) ((pos & ~STBDS_BUCKET_MASK) + i);\n        }\n      }\n\n      // quadratic probing\n      pos += step;\n      step += STBDS_BUCKET_LENGTH;\n      pos &= (table->slot_count-1);\n    }\n   found_empty_slot:\n    if (tombstone >= 0) {\n      pos = tombstone;\n      --table->tombstone_count;\n    }\n    ++table->used_count;\n\n    {\n      ptrdiff_t i = (ptrdiff_t) stbds_arrlen(a);\n      // we want to do stbds_arraddn(1), but we can't use the macros since we don't have something of the right type\n      if ((size_t) i+1 > stbds_arrcap(a))\n        *(void **) &a = stbds_arrgrowf(a, elemsize, 1, 0);\n      raw_a = STBDS_ARR_TO_HASH(a,elemsize);\n\n      STBDS_ASSERT((size_t) i+1 <= stbds_arrcap(a));\n      stbds_header(a)->length = i+1;\n      bucket = &table->storage[pos >> STBDS_BUCKET_SHIFT];\n      bucket->hash[pos & STBDS_BUCKET_MASK] = hash;\n      bucket->index[pos & STBDS_BUCKET_MASK] = i-1;\n      stbds_temp(a) = i-1;\n\n      switch (table->string.mode) {\n         case STBDS_SH_STRDUP:  stbds_temp_key(a) = *(char **) ((char *) a + elemsize*i) = stbds_strdup((char*) key); break;\n         case STBDS_SH_ARENA:   stbds_temp_key(a) = *(char **) ((char *) a + elemsize*i) = stbds_stralloc(&table->string, (char*)key); break;\n         case STBDS_SH_DEFAULT: stbds_temp_key(a) = *(char **) ((char *) a + elemsize*i) = (char *) key; break;\n         default:                memcpy((char *) a + elemsize*i, key, keysize); break;\n      }\n    }\n    return STBDS_ARR_TO_HASH(a,elemsize);\n  }\n}\n\nvoid * stbds_shmode_func(size_t elemsize, int mode)\n{\n  void *a = stbds_arrgrowf(0, elemsize, 0, 1);\n  stbds_hash_index *h;\n  memset(a, 0, elemsize);\n  stbds_header(a)->length = 1;\n  stbds_header(a)->hash_table = h = (stbds_hash_index *) stbds_make_hash_index(STBDS_BUCKET_LENGTH, NULL);\n  h->string.mode = (unsigned char) mode;\n  return STBDS_ARR_TO_HASH(a,elemsize);\n}\n\nvoid * stbds_hmdel_key(void *a, size_t elemsize, void *key, size_t keysize, size_t keyoffset, int mode)\n{\n  if (a == NULL) {\n    return 0;\n  } else {\n    stbds_hash_index *table;\n    void *raw_a = STBDS_HASH_TO_ARR(a,elemsize);\n    table = (stbds_hash_index *) stbds_header(raw_a)->hash_table;\n    stbds_temp(raw_a) = 0;\n    if (table == 0) {\n      return a;\n    } else {\n      ptrdiff_t slot;\n      slot = stbds_hm_find_slot(a, elemsize, key, keysize, keyoffset, mode);\n      if (slot < 0)\n        return a;\n      else {\n        stbds_hash_bucket *b = &table->storage[slot >> STBDS_BUCKET_SHIFT];\n        int i = slot & STBDS_BUCKET_MASK;\n        ptrdiff_t old_index = b->index[i];\n        ptrdiff_t final_index = (ptrdiff_t) stbds_arrlen(raw_a)-1-1; // minus one for the raw_a vs a, and minus one for 'last'\n        STBDS_ASSERT(slot < (ptrdiff_t) table->slot_count);\n        --table->used_count;\n        ++table->tombstone_count;\n        stbds_temp(raw_a) = 1;\n        STBDS_ASSERT(table->used_count >= 0);\n        //STBDS_ASSERT(table->tombstone_count < table->slot_count/4);\n        b->hash[i] = STBDS_HASH_DELETED;\n        b->index[i] = STBDS_INDEX_DELETED;\n\n        if (mode == STBDS_HM_STRING && table->string.mode == STBDS_SH_STRDUP)\n          STBDS_FREE(NULL, *(char**) ((char *) a+elemsize*old_index));\n\n        // if indices are the same, memcpy is a no-op, but back-pointer-fixup will fail, so skip\n        if (old_index != final_index) {\n          // swap delete\n          memmove((char*) a + elemsize*old_index, (char*) a + elemsize*final_index, elemsize);\n\n          // now find the slot for the last element\n          if (mode == STBDS_HM_STRING)\n            slot = stbds_hm_find_slot(a, elemsize, *(char**) ((char *) a+elemsize*old_index + keyoffset), keysize, keyoffset, mode);\n          else\n            slot = stbds_hm_find_slot(a, elemsize,  (char* ) a+elemsize*old_index + keyoffset, keysize, keyoffset, mode);\n          STBDS_ASSERT(slot >= 0);\n          b = &table->storage[slot >> STBDS_BUCKET_SHIFT];\n          i = slot & STBDS_BUCKET_MASK;\n          STBDS_ASSERT(b->index[i] == final_index);\n          b->index[i] = old_index;\n        }\n        stbds_header(raw_a)->length -= 1;\n\n        if (table->used_count < table->used_count_shrink_threshold && table->slot_count > STBDS_BUCKET_LENGTH) {\n          stbds_header(raw_a)->hash_table = stbds_make_hash_index(table->slot_count>>1, table);\n          STBDS_FREE(NULL, table);\n          STBDS_STATS(++stbds_hash_shrink);\n        } else if (table->tombstone_count > table->tombstone_count_threshold) {\n          stbds_header(raw_a)->hash_table = stbds_make_hash_index(table->slot_count   , table);\n          STBDS_FREE(NULL, table);\n          STBDS_STATS(++stbds_hash_rebuild);\n        }\n\n        return a;\n      }\n    }\n  }\n  /* NOTREACHED */\n}\n\nstatic char *stbds_strdup(char *str)\n{\n  // to keep replaceable allocator simple, we don't want to use strdup.\n  // rolling our own also avoids problem of strdup vs _strdup\n  size_t len = strlen(str)+1;\n  char *p = (char*) STBDS_REALLOC(NULL, 0, len);\n  memmove(p, str, len);\n  return p;\n}\n\n#ifndef STBDS_STRING_ARENA_BLOCKSIZE_MIN\n#define STBDS_STRING_ARENA_BLOCKSIZE_MIN  512u\n#endif\n#ifndef STBDS_STRING_ARENA_BLOCKSIZE_MAX\n#define STBDS_STRING_ARENA_BLOCKSIZE_MAX  (1u<<20)\n#endif\n\nchar *stbds_stralloc(stbds_string_arena *a, char *str)\n{\n  char *p;\n  size_t len = strlen(str)+1;\n  if (len > a->remaining) {\n    // compute the next blocksize\n    size_t blocksize = a->block;\n\n    // size is 512, 512, 1024, 1024, 2048, 2048, 4096, 4096, etc., so that\n    // there are log(SIZE) allocations to free when we destroy the table\n    blocksize = (size_t) (STBDS_STRING_ARENA_BLOCKSIZE_MIN) << (blocksize>>1);\n\n    // if size is under 1M, advance to next blocktype\n    if (blocksize < (size_t)(STBDS_STRING_ARENA_BLOCKSIZE_MAX))\n      ++a->block;\n\n    if (len > blocksize) {\n      // if string is larger than blocksize, then just allocate the full size.\n      // note that we still advance string_block so block size will continue\n      // increasing, so e.g. if somebody only calls this with 1000-long strings,\n      // eventually the arena will start doubling and handling those as well\n      stbds_string_block *sb = (stbds_string_block *) STBDS_REALLOC(NULL, 0, sizeof(*sb)-8 + len);\n      memmove(sb->storage, str, len);\n      if (a->storage) {\n        // insert it after the first element, so that we don't waste the space there\n        sb->next = a->storage->next;\n        a->storage->next = sb;\n      } else {\n        sb->next = 0;\n        a->storage = sb;\n        a->remaining = 0; // this is redundant, but good for clarity\n      }\n      return sb->storage;\n    } else {\n      stbds_string_block *sb = (stbds_string_block *) STBDS_REALLOC(NULL, 0, sizeof(*sb)-8 + blocksize);\n      sb->next = a->storage;\n      a->storage = sb;\n      a->remaining = blocksize;\n    }\n  }\n\n  STBDS_ASSERT(len <= a->remaining);\n  p = a->storage->storage + a->remaining - len;\n  a->remaining -= len;\n  memmove(p, str, len);\n  return p;\n}\n\nvoid stbds_strreset(stbds_string_arena *a)\n{\n  stbds_string_block *x,*y;\n  x = a->storage;\n  while (x) {\n    y = x->next;\n    STBDS_FREE(NULL, x);\n    x = y;\n  }\n  memset(a, 0, sizeof(*a));\n}\n\n#endif\n\n//////////////////////////////////////////////////////////////////////////////\n//\n//   UNIT TESTS\n//\n\n#ifdef STBDS_UNIT_TESTS\n#include <stdio.h>\n#ifdef STBDS_ASSERT_WAS_UNDEFINED\n#undef STBDS_ASSERT\n#endif\n#ifndef STBDS_ASSERT\n#define STBDS_ASSERT assert\n#include <assert.h>\n#endif\n\ntypedef struct { int key,b,c,d; } stbds_struct;\ntypedef struct { int key[2],b,c,d; } stbds_struct2;\n\nstatic char buffer[256];\nchar *strkey(int n)\n{\n#if defined(_WIN32) && defined(__STDC_WANT_SECURE_LIB__)\n   sprintf_s(buffer, sizeof(buffer), \"test_%d\", n);\n#else\n   sprintf(buffer, \"test_%d\", n);\n#endif\n   return buffer;\n}\n\nvoid stbds_unit_tests(void)\n{\n#if defined(_MSC_VER) && _MSC_VER <= 1200 && defined(__cplusplus)\n  // VC6 C++ doesn't like the template<> trick on unnamed structures, so do nothing!\n  STBDS_ASSERT(0);\n#else\n  const int testsize = 100000;\n  const int testsize2 = testsize/20;\n  int *arr=NULL;\n  struct { int   key;        int value; }  *intmap  = NULL;\n  struct { char *key;        int value; }  *strmap  = NULL, s;\n  struct { stbds_struct key; int value; }  *map     = NULL;\n  stbds_struct                             *map2    = NULL;\n  stbds_struct2                            *map3    = NULL;\n  stbds_string_arena                        sa      = { 0 };\n  int key3[2] = { 1,2 };\n  ptrdiff_t temp;\n\n  int i,j;\n\n  STBDS_ASSERT(arrlen(arr)==0);\n  for (i=0; i < 20000; i += 50) {\n    for (j=0; j < i; ++j)\n      arrpush(arr,j);\n    arrfree(arr);\n  }\n\n  for (i=0; i < 4; ++i) {\n    arrpush(arr,1); arrpush(arr,2); arrpush(arr,3); arrpush(arr,4);\n    arrdel(arr,i);\n    arrfree(arr);\n    arrpush(arr,1); arrpush(arr,2); arrpush(arr,3); arrpush(arr,4);\n    arrdelswap(arr,i);\n    arrfree(arr);\n  }\n\n  for (i=0; i < 5; ++i) {\n    arrpush(arr,1); arrpush(arr,2); arrpush(arr,3); arrpush(arr,4);\n    stbds_arrins(arr,i,5);\n    STBDS_ASSERT(arr[i] == 5);\n    if (i < 4)\n      STBDS_ASSERT(arr[4] == 4);\n    arrfree(arr);\n  }\n\n  i = 1;\n  STBDS_ASSERT(hmgeti(intmap,i) == -1);\n  hmdefault(intmap, -2);\n  STBDS_ASSERT(hmgeti(intmap, i) == -1);\n  STBDS_ASSERT(hmget (intmap, i) == -2);\n  for (i=0; i < testsize; i+=2)\n    hmput(intmap, i, i*5);\n  for (i=0; i < testsize; i+=1) {\n    if (i & 1) STBDS_ASSERT(hmget(intmap, i) == -2 );\n    else       STBDS_ASSERT(hmget(intmap, i) == i*5);\n    if (i & 1) STBDS_ASSERT(hmget_ts(intmap, i, temp) == -2 );\n    else       STBDS_ASSERT(hmget_ts(intmap, i, temp) == i*5);\n  }\n  for (i=0; i < testsize; i+=2)\n    hmput(intmap, i, i*3);\n  for (i=0; i < testsize; i+=1)\n    if (i & 1) STBDS_ASSERT(hmget(intmap, i) == -2 );\n    else       STBDS_ASSERT(hmget(intmap, i) == i*3);\n  for (i=2; i < testsize; i+=4)\n    hmdel(intmap, i); // delete half the entries\n  for (i=0; i < testsize; i+=1)\n    if (i & 3) STBDS_ASSERT(hmget(intmap, i) == -2 );\n    else       STBDS_ASSERT(hmget(intmap, i) == i*3);\n  for (i=0; i < testsize; i+=1)\n    hmdel(intmap, i); // delete the rest of the entries\n  for (i=0; i < testsize; i+=1)\n    STBDS_ASSERT(hmget(intmap, i) == -2 );\n  hmfree(intmap);\n  for (i=0; i < testsize; i+=2)\n    hmput(intmap, i, i*3);\n  hmfree(intmap);\n\n  #if defined(__clang__) || defined(__GNUC__)\n  #ifndef __cplusplus\n  intmap = NULL;\n  hmput(intmap, 15, 7);\n  hmput(intmap, 11, 3);\n  hmput(intmap,  9, 5);\n  STBDS_ASSERT(hmget(intmap, 9) == 5);\n  STBDS_ASSERT(hmget(intmap, 11) == 3);\n  STBDS_ASSERT(hmget(intmap, 15) == 7);\n  #endif\n  #endif\n\n  for (i=0; i < testsize; ++i)\n    stralloc(&sa, strkey(i));\n  strreset(&sa);\n\n  {\n    s.key = \"a\", s.value = 1;\n    shputs(strmap, s);\n    STBDS_ASSERT(*strmap[0].key == 'a');\n    STBDS_ASSERT(strmap[0].key == s.key);\n    STBDS_ASSERT(strmap[0].value == s.value);\n    shfree(strmap);\n  }\n\n  {\n    s.key = \"a\", s.value = 1;\n    sh_new_strdup(strmap);\n    shputs(strmap, s);\n    STBDS_ASSERT(*strmap[0].key == 'a');\n    STBDS_ASSERT(strmap[0].key != s.key);\n    STBDS_ASSERT(strmap[0].value == s.value);\n    shfree(strmap);\n  }\n\n  {\n    s.key = \"a\", s.value = 1;\n    sh_new_arena(strmap);\n    shputs(strmap, s);\n    STBDS_ASSERT(*strmap[0].key == 'a');\n    STBDS_ASSERT(strmap[0].key != s.key);\n    STBDS_ASSERT(strmap[0].value == s.value);\n    shfree(strmap);\n  }\n\n  for (j=0; j < 2; ++j) {\n    STBDS_ASSERT(shgeti(strmap,\"foo\") == -1);\n    if (j == 0)\n      sh_new_strdup(strmap);\n    else\n      sh_new_arena(strmap);\n    STBDS_ASSERT(shgeti(strmap,\"foo\") == -1);\n    shdefault(strmap, -2);\n    STBDS_ASSERT(shgeti(strmap,\"foo\") == -1);\n    for (i=0; i < testsize; i+=2)\n      shput(strmap, strkey(i), i*3);\n    for (i=0; i < testsize; i+=1)\n      if (i & 1) STBDS_ASSERT(shget(strmap, strkey(i)) == -2 );\n      else       STBDS_ASSERT(shget(strmap, strkey(i)) == i*3);\n    for (i=2; i < testsize; i+=4)\n      shdel(strmap, strkey(i)); // delete half the entries\n    for (i=0; i < testsize; i+=1)\n      if (i & 3) STBDS_ASSERT(shget(strmap, strkey(i)) == -2 );\n      else       STBDS_ASSERT(shget(strmap, strkey(i)) == i*3);\n    for (i=0; i < testsize; i+=1)\n      shdel(strmap, strkey(i)); // delete the rest of the entries\n    for (i=0; i < testsize; i+=1)\n      STBDS_ASSERT(shget(strmap, strkey(i)) == -2 );\n    shfree(strmap);\n  }\n\n  {\n    struct { char *key; char value; } *hash = NULL;\n    char name[4] = \"jen\";\n    shput(hash, \"bob\"   , 'h');\n    shput(hash, \"sally\" , 'e');\n    shput(hash, \"fred\"  , 'l');\n    shput(hash, \"jen\"   , 'x');\n    shput(hash, \"doug\"  , 'o');\n\n    shput(hash, name    , 'l');\n    shfree(hash);\n  }\n\n  for (i=0; i < testsize; i += 2) {\n    stbds_struct s = { i,i*2,i*3,i*4 };\n    hmput(map, s, i*5);\n  }\n\n  for (i=0; i < testsize; i += 1) {\n    stbds_struct s = { i,i*2,i*3  ,i*4 };\n    stbds_struct t = { i,i*2,i*3+1,i*4 };\n    if (i & 1) STBDS_ASSERT(hmget(map, s) == 0);\n    else       STBDS_ASSERT(hmget(map, s) == i*5);\n    if (i & 1) STBDS_ASSERT(hmget_ts(map, s, temp) == 0);\n    else       STBDS_ASSERT(hmget_ts(map, s, temp) == i*5);\n    //STBDS_ASSERT(hmget(map, t.key) == 0);\n  }\n\n  for (i=0; i < testsize; i += 2) {\n    stbds_struct s = { i,i*2,i*3,i*4 };\n    hmputs(map2, s);\n  }\n  hmfree(map);\n\n  for (i=0; i < testsize; i += 1) {\n    stbds_struct s = { i,i*2,i*3,i*4 };\n    stbds_struct t = { i,i*2,i*3+1,i*4 };\n    if (i & 1) STBDS_ASSERT(hmgets(map2, s.key).d == 0);\n    else       STBDS_ASSERT(hmgets(map2, s.key).d == i*4);\n    //STBDS_ASSERT(hmgetp(map2, t.key) == 0);\n  }\n  hmfree(map2);\n\n  for (i=0; i < testsize; i += 2) {\n    stbds_struct2 s = { { i,i*2 }, i*3,i*4, i*5 };\n    hmputs(map3, s);\n  }\n  for (i=0; i < testsize; i += 1) {\n    stbds_struct2 s = { { i,i*2}, i*3, i*4, i*5 };\n    stbds_struct2 t = { { i,i*2}, i*3+1, i*4, i*5 };\n    if (i & 1) STBDS_ASSERT(hmgets(map3, s.key).d == 0);\n    else       STBDS_ASSERT(hmgets(map3, s.key).d == i*5);\n    //STBDS_ASSERT(hmgetp(map3, t.key) == 0);\n  }\n#endif\n}\n#endif\n\n\n/*\n------------------------------------------------------------------------------\nThis software is available under 2 licenses -- choose whichever you prefer.\n------------------------------------------------------------------------------\nALTERNATIVE A - MIT License\nCopyright (c) 2019 Sean Barrett\nPermission is hereby granted, free of charge, to any person obtaining a copy of\nthis software and associated documentation files (the \"Software\"), to deal in\nthe Software without restriction, including without limitation the rights to\nuse, copy, modify, merge, publish, distribute, sublicense, and/or sell copies\nof the Software, and to permit persons to whom the Software is furnished to do\nso, subject to the following conditions:\nThe above copyright notice and this permission notice shall be included in all\ncopies or substantial portions of the Software.\nTHE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR\nIMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,\nFITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE\nAUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER\nLIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,\nOUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE\nSOFTWARE.\n------------------------------------------------------------------------------\nALTERNATIVE B - Public Domain (www.unlicense.org)\nThis is free and unencumbered software released into the public domain.\nAnyone is free to copy, modify, publish, use, compile, sell, or distribute this\nsoftware, either in source code form or as a compiled binary, for any purpose,\ncommercial or non-commercial, and by any means.\nIn jurisdictions that recognize copyright laws, the author or authors of this\nsoftware dedicate any and all copyright interest in the software to the public\ndomain. We make this dedication for the benefit of the public at large and to\nthe detriment of our heirs and successors. We intend this dedication to be an\novert act of relinquishment in perpetuity of all present and future rights to\nthis software under copyright law.\nTHE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR\nIMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,\nFITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE\nAUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN\nACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION\nWITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.\n------------------------------------------------------------------------------\n*/";
+
+const char *SRC_SDSALLOC_H = "/* SDSLib 2.0 -- A C dynamic strings library\n *\n * Copyright (c) 2006-2015, Salvatore Sanfilippo <antirez at gmail dot com>\n * Copyright (c) 2015, Oran Agra\n * Copyright (c) 2015, Redis Labs, Inc\n * All rights reserved.\n *\n * Redistribution and use in source and binary forms, with or without\n * modification, are permitted provided that the following conditions are met:\n *\n *   * Redistributions of source code must retain the above copyright notice,\n *     this list of conditions and the following disclaimer.\n *   * Redistributions in binary form must reproduce the above copyright\n *     notice, this list of conditions and the following disclaimer in the\n *     documentation and/or other materials provided with the distribution.\n *   * Neither the name of Redis nor the names of its contributors may be used\n *     to endorse or promote products derived from this software without\n *     specific prior written permission.\n *\n * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS \"AS IS\"\n * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE\n * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE\n * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE\n * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR\n * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF\n * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS\n * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN\n * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)\n * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE\n * POSSIBILITY OF SUCH DAMAGE.\n */\n\n/* SDS allocator selection.\n *\n * This file is used in order to change the SDS allocator at compile time.\n * Just define the following defines to what you want to use. Also add\n * the include of your alternate allocator if needed (not needed in order\n * to use the default libc allocator). */\n\n#ifdef BASALTO_GC\n/* Basalto --gc: strings live in the collector's heap (see runtime/gc.c). */\nvoid *bs_gc_malloc_leaf(size_t size);\nvoid *bs_gc_realloc_leaf(void *ptr, size_t size);\nvoid bs_gc_free(void *ptr);\n#define s_malloc bs_gc_malloc_leaf\n#define s_realloc bs_gc_realloc_leaf\n#define s_free bs_gc_free\n#else\n#define s_malloc malloc\n#define s_realloc realloc\n#define s_free free\n#endif\n";
 
 #endif
@@ -13,6 +13,7 @@
 extern int yyparse();
 extern FILE* yyin;
 extern ASTNode* root_node;
+extern void parse_interpolations(ASTNode* node);
 
 // Declaration from codegen.c
 void codegen(ASTNode* node, FILE* file, FILE* asm_file, const char* source_file_path);
@@ -31,6 +32,12 @@ void write_embedded_file(const char* path, const char* content) {
 // Global debug flag (accessible from lexer)
 bool debug_mode = false;
 
+// Global GC flag (accessible from codegen): 'nova', sds and stb_ds use the tracing collector
+bool gc_mode = false;
+
+// Global layout report flag (accessible from codegen): --relatorio-layout
+bool layout_report = false;
+
 int main(int argc, char** argv) {
     const char* input_filename = NULL;
     const char* output_filename = NULL; // Specified via -o
@@ -49,11 +56,19 @@ int main(int argc, char** argv) {
             printf("  --emit-c      Generate C code only (skip GCC)\n");
             printf("  --run, -r     Run the compiled program immediately\n");
             printf("  --debug, -d   Enable debug output\n");
+            printf("  --gc          Use the tracing garbage collector for 'nova', texto and arrays\n");
+            printf("  --relatorio-layout  Print each struct's size, padding and cache-line footprint\n");
             return 0;
         } 
         else if (strcmp(argv[i], "--emit-c") == 0) {
             transpile_only = true;
         }
+        else if (strcmp(argv[i], "--gc") == 0) {
+            gc_mode = true;
+        }
+        else if (strcmp(argv[i], "--relatorio-layout") == 0) {
+            layout_report = true;
+        }
         else if (strcmp(argv[i], "--run") == 0 || strcmp(argv[i], "-r") == 0) {
             run_after_compile = true;
         }
@@ -94,6 +109,9 @@ int main(int argc, char** argv) {
     sprintf(path_buf, "%s/core.c", tmp_dir);
     write_embedded_file(path_buf, SRC_CORE_C);
 
+    sprintf(path_buf, "%s/gc.c", tmp_dir);
+    write_embedded_file(path_buf, SRC_GC_C);
+
     sprintf(path_buf, "%s/sds.h", tmp_dir);
     write_embedded_file(path_buf, SRC_SDS_H);
 
@@ -126,6 +144,9 @@ int main(int argc, char** argv) {
         return EXIT_FAILURE;
     }
 
+    // "${...}" pieces of string literals become expression nodes
+    parse_interpolations(root_node);
+
     // Debug: Print AST tree
     if (debug_mode) {
         print_ast(root_node);
@@ -135,6 +156,12 @@ int main(int argc, char** argv) {
     // Priority: CLI Flag (-o) > Program/Library Name > Default "output"
     const char* final_name = "output";
     int is_library = (root_node->type == NODE_LIBRARY);
+
+    // The collector scans the stack of 'main'; a library has no such frame to anchor to
+    if (gc_mode && is_library) {
+        fprintf(stderr, "[Basalto] Aviso: --gc ignorado para bibliotecas.\n");
+        gc_mode = false;
+    }
     
     if (output_filename) {
         final_name = output_filename;
@@ -178,14 +205,15 @@ int main(int argc, char** argv) {
             // LIBRARY MODE: Output .so, add -shared -fPIC
             printf("[Basalto] Compiling Library '%s.so'...\n", final_name);
             snprintf(cmd, sizeof(cmd), 
-                "gcc %s %s %s/core.c %s/sds.c -o %s.so -shared -fPIC -I %s -Wall -ldl -lm", 
-                c_filename, asm_filename, tmp_dir, tmp_dir, final_name, tmp_dir);
+                "gcc %s %s %s/core.c %s/gc.c %s/sds.c -o %s.so -shared -fPIC -I %s -Wall -ldl -lm", 
+                c_filename, asm_filename, tmp_dir, tmp_dir, tmp_dir, final_name, tmp_dir);
         } else {
             // PROGRAM MODE: Output executable
             printf("[Basalto] Compiling Executable '%s'...\n", final_name);
             snprintf(cmd, sizeof(cmd), 
-                "gcc %s %s %s/core.c %s/sds.c -o %s -I %s -Wall -ldl -lm", 
-                c_filename, asm_filename, tmp_dir, tmp_dir, final_name, tmp_dir);
+                "gcc %s %s %s/core.c %s/gc.c %s/sds.c -o %s -I %s -Wall -ldl -lm%s", 
+                c_filename, asm_filename, tmp_dir, tmp_dir, tmp_dir, final_name, tmp_dir,
+                gc_mode ? " -DBASALTO_GC" : "");
         }
         
         if (debug_mode) printf("[CMD] %s\n", cmd);
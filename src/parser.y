@@ -13,6 +13,42 @@ extern FILE* yyin;
 void yyerror(const char *s);
 
 ASTNode* root_node = NULL;
+
+// Source of the "${...}" piece being parsed (for error messages), NULL for the file
+static const char* interp_piece = NULL;
+
+// Struct attributes (@soa, @compacto, @alinhado(64) ...) -> symbol table flags
+static void apply_struct_attrs(ASTNode* def, ASTNode* attrs) {
+    const char* struct_name = def->name;
+    for (int i = 0; i < arrlen(attrs->children); i++) {
+        ASTNode* attr_node = attrs->children[i];
+        const char* attr = attr_node->name;
+        int has_arg = arrlen(attr_node->children) > 0;
+        if (strcmp(attr, "alinhado") == 0) {
+            int n = has_arg ? attr_node->children[0]->int_value : 0;
+            if (!has_arg || n <= 0 || (n & (n - 1)) != 0) {
+                fprintf(stderr, "[Basalto] Erro: @alinhado(n) na estrutura '%s' exige uma potencia de 2.\n", struct_name);
+                exit(1);
+            }
+            def->int_value = n; // Minimum alignment in bytes
+            continue;
+        }
+        if (has_arg) {
+            fprintf(stderr, "[Basalto] Erro: atributo '@%s' nao recebe argumentos.\n", attr);
+            exit(1);
+        }
+        if (strcmp(attr, "soa") == 0) {
+            set_struct_flag(struct_name, STRUCT_FLAG_SOA);
+        } else if (strcmp(attr, "ordem_fixa") == 0) {
+            set_struct_flag(struct_name, STRUCT_FLAG_FIXED_ORDER);
+        } else if (strcmp(attr, "compacto") == 0) {
+            set_struct_flag(struct_name, STRUCT_FLAG_PACKED);
+        } else {
+            fprintf(stderr, "[Basalto] Erro: atributo desconhecido '@%s' na estrutura '%s'.\n", attr, struct_name);
+            exit(1);
+        }
+    }
+}
 %}
 
 %define parse.error verbose
@@ -32,6 +68,7 @@ ASTNode* root_node = NULL;
 %token TOKEN_PROGRAMA TOKEN_BIBLIOTECA TOKEN_VAR TOKEN_SE TOKEN_SENAO TOKEN_EXTERNO TOKEN_FUNCAO TOKEN_SEMICOLON
 %token TOKEN_ENQUANTO TOKEN_CADA TOKEN_INFINITO TOKEN_PARAR TOKEN_CONTINUAR TOKEN_DOTDOT TOKEN_LER
 %token TOKEN_ESTRUTURA TOKEN_ASSERT TOKEN_RETORNE TOKEN_NULL TOKEN_NEW TOKEN_TRUE TOKEN_FALSE TOKEN_EMBED
+%token TOKEN_INTERP /* Injected by the lexer before a "${...}" piece (parse_interp_expr) */
 
 %left '+' '-'
 %left '*' '/'
@@ -42,13 +79,14 @@ ASTNode* root_node = NULL;
 %left '('
 
 /* Types for non-terminals */
-%type <node> root program library block statements statement var_decl assign_stmt if_stmt enquanto_stmt expr logical_expr comparison_expr term factor cada_stmt infinito_stmt flow_stmt input_stmt type_def array_literal expr_list arg_list method_call struct_def field_list field_decl prop_access lvalue assert_stmt func_def param_list param return_stmt extern_block extern_func_list extern_func opt_symbol_map
+%type <node> root program library block statements statement var_decl assign_stmt if_stmt enquanto_stmt expr logical_expr comparison_expr term factor cada_stmt infinito_stmt flow_stmt input_stmt type_def array_literal expr_list arg_list method_call struct_def struct_attrs field_list field_decl prop_access lvalue assert_stmt func_def param_list param return_stmt extern_block extern_func_list extern_func opt_symbol_map
 
 %%
 
 root:
     program { root_node = $1; }
     | library { root_node = $1; }
+    | TOKEN_INTERP expr { root_node = $2; }
     ;
 
 program:
@@ -170,6 +208,27 @@ var_decl:
         $$->data_type = $4->string_value ? sdsnew($4->string_value) : sdsnew("void");
         ast_add_child($$, $6);
     }
+    | TOKEN_VAR TOKEN_ID ':' type_def '(' expr ',' expr ')' {
+        /* Sized declaration: var m: matriz[real64](linhas, colunas) */
+        $$ = ast_new(NODE_VAR_DECL);
+        $$->name = sdsnew($2);
+        $$->data_type = $4->string_value ? sdsnew($4->string_value) : sdsnew("void");
+        ASTNode* dims = ast_new(NODE_FUNC_CALL);
+        dims->name = sdsnew("matriz");
+        ast_add_child(dims, $6);
+        ast_add_child(dims, $8);
+        ast_add_child($$, dims);
+    }
+    | TOKEN_VAR TOKEN_ID ':' type_def '(' expr ')' {
+        /* Sized declaration: var b: bits(n) */
+        $$ = ast_new(NODE_VAR_DECL);
+        $$->name = sdsnew($2);
+        $$->data_type = $4->string_value ? sdsnew($4->string_value) : sdsnew("void");
+        ASTNode* size = ast_new(NODE_FUNC_CALL);
+        size->name = sdsnew($4->string_value ? $4->string_value : "bits");
+        ast_add_child(size, $6);
+        ast_add_child($$, size);
+    }
     | TOKEN_VAR TOKEN_ID ':' type_def {
         /* Uninitialized variable declaration: var p: Player */
         $$ = ast_new(NODE_VAR_DECL);
@@ -179,21 +238,62 @@ var_decl:
     ;
 
 struct_def:
-    TOKEN_ESTRUTURA TOKEN_ID '{' field_list '}' {
+    struct_attrs TOKEN_ESTRUTURA TOKEN_ID '{' field_list '}' {
         $$ = ast_new(NODE_STRUCT_DEF);
-        $$->name = sdsnew($2);
-        register_struct($2); // SymTable
+        $$->name = sdsnew($3);
+        register_struct($3); // SymTable
+        apply_struct_attrs($$, $1);
         // Add fields as children
-        if ($4 && arrlen($4->children) > 0) {
-            for(int i=0; i<arrlen($4->children); i++) {
-                ASTNode* field = $4->children[i];
+        if ($5 && arrlen($5->children) > 0) {
+            for(int i=0; i<arrlen($5->children); i++) {
+                ASTNode* field = $5->children[i];
+                ast_add_child($$, field);
+                register_field($3, field->name, field->data_type); // SymTable
+            }
+        }
+    }
+    | struct_attrs TOKEN_ESTRUTURA TOKEN_ID TOKEN_ID '{' field_list '}' {
+        /* Struct kind modifier: estrutura valor Ponto { ... } */
+        if (strcmp($3, "valor") != 0) {
+            yyerror("expected 'valor' or a struct name after 'estrutura'");
+        }
+        $$ = ast_new(NODE_STRUCT_DEF);
+        $$->name = sdsnew($4);
+        $$->string_value = sdsnew($3); // Kind ("valor")
+        register_struct($4); // SymTable
+        set_struct_flag($4, STRUCT_FLAG_VALUE);
+        apply_struct_attrs($$, $1);
+        if ($6 && arrlen($6->children) > 0) {
+            for(int i=0; i<arrlen($6->children); i++) {
+                ASTNode* field = $6->children[i];
                 ast_add_child($$, field);
-                register_field($2, field->name, field->data_type); // SymTable
+                register_field($4, field->name, field->data_type); // SymTable
             }
         }
     }
     ;
 
+struct_attrs:
+    struct_attrs '@' TOKEN_ID {
+        /* @soa */
+        $$ = $1;
+        ASTNode* attr = ast_new(NODE_VAR_REF);
+        attr->name = sdsnew($3);
+        ast_add_child($$, attr);
+    }
+    | struct_attrs '@' TOKEN_ID '(' TOKEN_LIT_INT ')' {
+        /* @alinhado(64) */
+        $$ = $1;
+        ASTNode* attr = ast_new(NODE_VAR_REF);
+        attr->name = sdsnew($3);
+        ASTNode* arg = ast_new(NODE_LITERAL_INT);
+        arg->int_value = $5;
+        ast_add_child(attr, arg);
+        ast_add_child($$, attr);
+    }
+    | /* empty */ { $$ = ast_new(NODE_BLOCK); }
+    ;
+
 field_list:
     field_list field_decl {
         $$ = $1;
@@ -222,6 +322,50 @@ type_def:
         $$->string_value = sdscat(sdsnew("["), inner);
         $$->string_value = sdscat($$->string_value, "]");
     }
+    | '[' type_def TOKEN_SEMICOLON TOKEN_LIT_INT ']' {
+        // Fixed-size array: [inteiro32; 16] (stored as "fixo[inteiro32;16]")
+        if ($4 <= 0) {
+            fprintf(stderr, "[Basalto] Erro: o tamanho de um array fixo deve ser positivo (recebeu %d).\n", $4);
+            exit(1);
+        }
+        $$ = ast_new(NODE_VAR_REF);
+        $$->string_value = sdscatprintf(sdsempty(), "fixo[%s;%d]", $2->string_value ? $2->string_value : "", $4);
+    }
+    | '[' type_def TOKEN_SEMICOLON TOKEN_ID TOKEN_LIT_INT ']' {
+        // Small array: [Pessoa; ate 4] (stored as "pequeno[Pessoa;4]")
+        if (strcmp($4, "ate") != 0) {
+            fprintf(stderr, "[Basalto] Erro: esperado '[T; N]' ou '[T; ate N]', encontrado '%s'.\n", $4);
+            exit(1);
+        }
+        if ($5 <= 0) {
+            fprintf(stderr, "[Basalto] Erro: o tamanho de um array pequeno deve ser positivo (recebeu %d).\n", $5);
+            exit(1);
+        }
+        $$ = ast_new(NODE_VAR_REF);
+        $$->string_value = sdscatprintf(sdsempty(), "pequeno[%s;%d]", $2->string_value ? $2->string_value : "", $5);
+    }
+    | '[' type_def TOKEN_SEMICOLON TOKEN_ID ']' {
+        // Packed string array: [texto; compacto] (stored as "compacto[texto]")
+        if (strcmp($4, "compacto") != 0 || !$2->string_value || strcmp($2->string_value, "texto") != 0) {
+            fprintf(stderr, "[Basalto] Erro: so '[texto; compacto]' e suportado, encontrado '[%s; %s]'.\n",
+                    $2->string_value ? $2->string_value : "", $4);
+            exit(1);
+        }
+        $$ = ast_new(NODE_VAR_REF);
+        $$->string_value = sdsnew("compacto[texto]");
+    }
+    | TOKEN_ID '[' type_def ']' {
+        // Parameterized type: fatia[inteiro32]
+        $$ = ast_new(NODE_VAR_REF);
+        $$->string_value = sdscatprintf(sdsempty(), "%s[%s]", $1, $3->string_value ? $3->string_value : "");
+    }
+    | TOKEN_ID '[' type_def ',' type_def ']' {
+        // Two parameters: mapa[texto, inteiro32]
+        $$ = ast_new(NODE_VAR_REF);
+        $$->string_value = sdscatprintf(sdsempty(), "%s[%s,%s]", $1,
+                                        $3->string_value ? $3->string_value : "",
+                                        $5->string_value ? $5->string_value : "");
+    }
     ;
 
 assign_stmt:
@@ -269,6 +413,13 @@ lvalue:
         obj->name = sdsnew($1);
         ast_add_child($$, obj);
     }
+    | factor '.' TOKEN_ID {
+        /* Nested property access as lvalue: pts[i].x or a.pos.x */
+        $$ = ast_new(NODE_PROP_ACCESS);
+        $$->name = NULL;
+        $$->data_type = sdsnew($3);
+        ast_add_child($$, $1); // Object
+    }
     ;
 
 if_stmt:
@@ -476,6 +627,23 @@ factor:
         ast_add_child($$, $3); // Start index
         ast_add_child($$, $5); // End index
     }
+    | TOKEN_ID '[' expr TOKEN_DOTDOT expr ':' expr ']' {
+        /* Slice with step: arr[0..8:2] */
+        $$ = ast_new(NODE_ARRAY_ACCESS);
+        $$->name = sdsnew($1);
+        ast_add_child($$, $3); // Start index
+        ast_add_child($$, $5); // End index
+        $$->step = $7;
+    }
+    | factor '[' expr TOKEN_DOTDOT expr ':' expr ']' {
+        /* Nested slice with step: m[0][0..8:2] */
+        $$ = ast_new(NODE_ARRAY_ACCESS);
+        $$->name = NULL;
+        ast_add_child($$, $1);
+        ast_add_child($$, $3);
+        ast_add_child($$, $5);
+        $$->step = $7;
+    }
     | TOKEN_ID '[' expr ']' {
         /* Array access: arr[0] */
         $$ = ast_new(NODE_ARRAY_ACCESS);
@@ -586,6 +754,21 @@ cada_stmt:
         $$->step = $11; // Step expression
         ast_add_child($$, $13); // Block
     }
+    /* 5. Map entries: cada (chave, valor : mapa) */
+    | TOKEN_CADA '(' TOKEN_ID ',' TOKEN_ID ':' expr ')' block {
+        $$ = ast_new(NODE_CADA);
+        $$->cada_var = sdsnew($3); // Key
+        $$->name = sdsnew($5);     // Value
+        $$->start = $7;            // Map
+        ast_add_child($$, $9);     // Block
+    }
+    /* 6. Set elements: cada (x : conjunto) */
+    | TOKEN_CADA '(' TOKEN_ID ':' expr ')' block {
+        $$ = ast_new(NODE_CADA);
+        $$->cada_var = sdsnew($3);
+        $$->start = $5;            // Set
+        ast_add_child($$, $7);     // Block
+    }
     ;
 
 infinito_stmt:
@@ -788,6 +971,19 @@ method_call:
         ast_add_child($$, obj); // Base expression
         ast_add_child($$, $5); // Argument
     }
+    | TOKEN_ID '.' TOKEN_ID '(' expr ',' arg_list ')' {
+        /* Method call with several arguments: arr.inserir(i, x) or p.mover(dx, dy) */
+        $$ = ast_new(NODE_METHOD_CALL);
+        $$->name = sdsnew($1);
+        $$->data_type = sdsnew($3); // Method name
+        ASTNode* obj = ast_new(NODE_VAR_REF);
+        obj->name = sdsnew($1);
+        ast_add_child($$, obj); // Base expression
+        ast_add_child($$, $5); // First argument
+        for (int i = 0; i < arrlen($7->children); i++) {
+            ast_add_child($$, $7->children[i]);
+        }
+    }
     | factor '.' TOKEN_ID '(' ')' {
         /* Method call on complex expression: arr[0].pop() */
         $$ = ast_new(NODE_METHOD_CALL);
@@ -803,11 +999,64 @@ method_call:
         ast_add_child($$, $1); // Base expression
         ast_add_child($$, $5); // Argument
     }
+    | factor '.' TOKEN_ID '(' expr ',' arg_list ')' {
+        /* Method call on complex expression with several arguments: p.xs.inserir(i, x) */
+        $$ = ast_new(NODE_METHOD_CALL);
+        $$->name = NULL;
+        $$->data_type = sdsnew($3); // Method name
+        ast_add_child($$, $1); // Base expression
+        ast_add_child($$, $5); // First argument
+        for (int i = 0; i < arrlen($7->children); i++) {
+            ast_add_child($$, $7->children[i]);
+        }
+    }
     ;
 
 %%
 
+// Interpolated literals: each "${expr}" / "${expr:fmt}" piece of 'node' is
+// parsed as an expression and appended to its children, in order, so codegen
+// and every analysis see the calls, accesses and names inside the string.
+static void parse_literal_pieces(ASTNode* node) {
+    extern ASTNode* parse_interp_expr(const char* text);
+    for (const char* p = strstr(node->string_value, "${"); p; p = strstr(p, "${")) {
+        const char* start = p + 2;
+        const char* end = start;
+        int depth = 0;
+        while (*end && *end != '}' && !(*end == ':' && depth == 0)) {
+            if (*end == '[' || *end == '(') depth++;
+            if (*end == ']' || *end == ')') depth--;
+            end++;
+        }
+        sds text = sdsnewlen(start, end - start);
+        interp_piece = text;
+        ast_add_child(node, parse_interp_expr(text));
+        interp_piece = NULL;
+        sdsfree(text);
+        while (*end && *end != '}') end++;
+        p = end;
+    }
+}
+
+void parse_interpolations(ASTNode* node) {
+    if (!node) return;
+    if (node->type == NODE_LITERAL_STRING && node->string_value && arrlen(node->children) == 0) {
+        parse_literal_pieces(node);
+        return;
+    }
+    for (int i = 0; i < arrlen(node->children); i++) {
+        parse_interpolations(node->children[i]);
+    }
+    parse_interpolations(node->start);
+    parse_interpolations(node->end);
+    parse_interpolations(node->step);
+}
+
 void yyerror(const char *msg) {
+    if (interp_piece) {
+        fprintf(stderr, "[Basalto] Erro: expressao invalida em '${%s}': %s\n", interp_piece, msg);
+        exit(1);
+    }
     extern int yycol;
     fprintf(stderr, "\033[1;31mError:\033[0m %s\n", msg);
     fprintf(stderr, "   at line %d, column %d\n", yylineno, yycol);
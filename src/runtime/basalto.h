@@ -5,6 +5,9 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <limits.h>
 #include <dlfcn.h>
 #include "sds.h"
 
@@ -15,6 +18,8 @@
     long long: "%lld", \
     unsigned int: "%u", \
     unsigned long: "%lu", \
+    unsigned long long: "%llu", \
+    long double: "%Lf", \
     short: "%hd", \
     float: "%f", \
     double: "%lf", \
@@ -22,7 +27,7 @@
     char: "%c", \
     default: "%d")
 
-// Input
+// Input (buffered stdin, see INPUT HELPERS in core.c)
 void flush_input();
 int read_int();
 long long read_long();
@@ -30,6 +35,9 @@ float read_float();
 double read_double();
 char* read_string();
 void wait_enter();
+long long* bs_ler_inteiros(long long n);
+double* bs_ler_reais(long long n);
+char** bs_ler_linhas(void);
 
 // Conversions
 sds int8_to_string(signed char x);
@@ -42,9 +50,534 @@ sds float64_to_string(double x);
 sds float_ext_to_string(long double x);
 sds char_to_string(char* x);
 sds array_int_to_string(int* arr);
+sds array_int64_to_string(long long* arr);
+sds array_natural_to_string(unsigned long long* arr);
+sds array_double_to_string(double* arr);
+sds array_float_to_string(float* arr);
 sds array_string_to_string(char** arr);
+sds array_bool_to_string(_Bool* arr);
 
-// String Parsing
+// --- NUMBER FORMATTING ---
+// Hand-written %lld / %llu / %f: the same text printf produces, without parsing
+// a format string. bs_formatar_* write into 'buf' (BS_NUMERO_MAX bytes) and
+// return the length; the sds forms append in place, the escrever forms go to
+// stdout. Used by '.texto()', interpolation, array printing and escreva(l).
+#define BS_NUMERO_MAX 320
+int bs_formatar_inteiro(char* buf, long long x);
+int bs_formatar_natural(char* buf, unsigned long long x);
+int bs_formatar_real(char* buf, double x);
+
+sds bs_sds_anexar_inteiro(sds s, long long x);
+sds bs_sds_anexar_natural(sds s, unsigned long long x);
+sds bs_sds_anexar_real(sds s, double x);
+sds bs_sds_anexar_real_ext(sds s, long double x);
+sds bs_sds_anexar_texto(sds s, const char* x);
+sds bs_sds_anexar_caractere(sds s, char x);
+
+void bs_escrever_inteiro(long long x);
+void bs_escrever_natural(unsigned long long x);
+void bs_escrever_real(double x);
+void bs_escrever_real_ext(long double x);
+void bs_escrever_texto(const char* x);
+void bs_escrever_caractere(char x);
+
+// "${x}" for a primitive x (same dispatch as print_any)
+#define bs_sds_anexar_valor(s, x) _Generic((x), \
+    char*: bs_sds_anexar_texto, \
+    char: bs_sds_anexar_caractere, \
+    unsigned int: bs_sds_anexar_natural, \
+    unsigned long: bs_sds_anexar_natural, \
+    unsigned long long: bs_sds_anexar_natural, \
+    float: bs_sds_anexar_real, \
+    double: bs_sds_anexar_real, \
+    long double: bs_sds_anexar_real_ext, \
+    default: bs_sds_anexar_inteiro)((s), (x))
+
+// escreva(x) for a primitive x
+#define bs_escrever_valor(x) _Generic((x), \
+    char*: bs_escrever_texto, \
+    char: bs_escrever_caractere, \
+    unsigned int: bs_escrever_natural, \
+    unsigned long: bs_escrever_natural, \
+    unsigned long long: bs_escrever_natural, \
+    float: bs_escrever_real, \
+    double: bs_escrever_real, \
+    long double: bs_escrever_real_ext, \
+    default: bs_escrever_inteiro)(x)
+
+// --- STATIC STRING LITERALS ---
+// A texto literal without "${}": sds header and bytes emitted once, in .rodata.
+// The layout is sds's sdshdr32; SDS_STATIC (sds.h) keeps sdsfree and appends
+// from ever writing to it. Codegen refers to it as (sds)NAME.buf.
+#define BS_TEXTO_FIXO(nome, literal) \
+    static const struct __attribute__((__packed__)) { \
+        uint32_t len; \
+        uint32_t alloc; \
+        unsigned char flags; \
+        char buf[sizeof(literal)]; \
+    } nome = { sizeof(literal) - 1, sizeof(literal) - 1, SDS_TYPE_32 | SDS_STATIC, literal }
+
+// Before a store into the bytes (s[i] = c): a static literal is copied to the
+// heap first, so the write never lands in .rodata.
+static inline void bs_texto_possuir(sds* s)
+{
+    if (*s && SDS_IS_STATIC(*s))
+        *s = sdsdup(*s);
+}
+
+// --- SLICE VIEWS (fatia[T]) ---
+// Borrowed window into an array, created in O(1): element i lives at
+// ((T*)dados)[i * passo]. Writes go to the underlying array.
+typedef struct BsFatia {
+    void* dados;
+    long long len;
+    long long passo;
+} BsFatia;
+
+// View of [inicio, fim) over 'len' elements of 'tam' bytes (bounds are clamped)
+static inline BsFatia bs_fatia(void* dados, long long len, long long passo, size_t tam, long long inicio, long long fim)
+{
+    if (fim > len) fim = len;
+    if (inicio < 0) inicio = 0;
+    if (inicio > fim) inicio = fim;
+    BsFatia f = { (char*)dados + inicio * passo * (long long)tam, fim - inicio, passo };
+    return f;
+}
+
+// Every 'passo'-th element of a view (xs[a..b:p]), still without copying
+static inline BsFatia bs_fatia_passo(BsFatia f, long long passo)
+{
+    if (passo < 1)
+    {
+        fprintf(stderr, "[Basalto] Erro: o passo de uma fatia deve ser positivo (recebeu %lld).\n", passo);
+        exit(1);
+    }
+    BsFatia r = { f.dados, (f.len + passo - 1) / passo, f.passo * passo };
+    return r;
+}
+
+// Elements of a view as a plain C array (sorting needs passo == 1)
+static inline void* bs_fatia_contigua(BsFatia f)
+{
+    if (f.passo != 1 && f.len > 1)
+    {
+        fprintf(stderr, "[Basalto] Erro: a fatia precisa ser contigua (passo 1).\n");
+        exit(1);
+    }
+    return f.dados;
+}
+
+sds fatia_int_to_string(BsFatia f);
+sds fatia_int64_to_string(BsFatia f);
+sds fatia_natural_to_string(BsFatia f);
+sds fatia_double_to_string(BsFatia f);
+sds fatia_float_to_string(BsFatia f);
+sds fatia_bool_to_string(BsFatia f);
+sds fatia_string_to_string(BsFatia f);
+
+// --- MATRICES (matriz[T]) ---
+// One row-major buffer: element (i, j) lives at ((T*)dados)[i * colunas + j].
+// Copies share the buffer; row i is a BsFatia over it.
+typedef struct BsMatriz {
+    void* dados;
+    long long linhas;
+    long long colunas;
+} BsMatriz;
+
+// Zeroed linhas x colunas matrix of 'tam'-byte elements ('folha': elements hold no pointers)
+BsMatriz bs_matriz(long long linhas, long long colunas, size_t tam, int folha);
+sds matriz_int8_to_string(BsMatriz m);
+sds matriz_int16_to_string(BsMatriz m);
+sds matriz_int_to_string(BsMatriz m);
+sds matriz_int64_to_string(BsMatriz m);
+sds matriz_int_arq_to_string(BsMatriz m);
+sds matriz_byte_to_string(BsMatriz m);
+sds matriz_natural16_to_string(BsMatriz m);
+sds matriz_natural32_to_string(BsMatriz m);
+sds matriz_natural_to_string(BsMatriz m);
+sds matriz_natural_arq_to_string(BsMatriz m);
+sds matriz_float_to_string(BsMatriz m);
+sds matriz_double_to_string(BsMatriz m);
+sds matriz_real_ext_to_string(BsMatriz m);
+sds matriz_bool_to_string(BsMatriz m);
+
+// --- BITSETS (bits) ---
+// Packed booleans: bit i is bit (i % 64) of palavras[i / 64]. Set operations
+// run a 64-bit word at a time; bits past 'len' in the last word stay zero.
+// Copies share the buffer (like BsMatriz).
+typedef struct BsBits {
+    uint64_t* palavras;
+    long long len;
+} BsBits;
+
+// 'len' zeroed bits
+BsBits bs_bits(long long len);
+
+static inline _Bool bs_bits_ler(BsBits b, long long i)
+{
+    return (b.palavras[i >> 6] >> (i & 63)) & 1;
+}
+
+static inline void bs_bits_escrever(BsBits b, long long i, _Bool v)
+{
+    uint64_t mascara = (uint64_t)1 << (i & 63);
+    b.palavras[i >> 6] = (b.palavras[i >> 6] & ~mascara) | (-(uint64_t)v & mascara);
+}
+
+long long bs_bits_contar(BsBits b);
+// Index of the first set bit at or after 'inicio', -1 if none
+long long bs_bits_proximo(BsBits b, long long inicio);
+// In place: a = a & b, a | b, a ^ b (same length required)
+void bs_bits_e(BsBits a, BsBits b);
+void bs_bits_ou(BsBits a, BsBits b);
+void bs_bits_xou(BsBits a, BsBits b);
+void bs_bits_inverter(BsBits b);
+void bs_bits_preencher(BsBits b, _Bool v);
+BsBits bs_bits_copiar(BsBits b);
+sds bits_to_string(BsBits b);
+
+// --- DEQUES (fila[T]) ---
+// Ring buffer: element i lives at ((T*)dados)[(cabeca + i) & (cap - 1)].
+// cap is 0 or a power of two, so wrapping is a mask instead of a division.
+typedef struct BsFila {
+    char* dados;
+    size_t cabeca;
+    size_t len;
+    size_t cap;
+} BsFila;
+
+// Room for 'n' elements of 'tam' bytes (allocates the queue when NULL)
+BsFila* bs_fila_reservar(BsFila* f, size_t n, size_t tam);
+// Room for one more element
+BsFila* bs_fila_crescer(BsFila* f, size_t tam);
+// Aborts: pop/peek on an empty queue
+void bs_fila_vazia(void);
+
+// --- SMALL ARRAYS ([T; ate N]) ---
+// Codegen emits one struct per (T, N): { BsPequeno h; T local[N]; }. Up to N
+// elements stay inline in 'local'; growing past that moves them to a heap
+// buffer once, and 'heap' then holds them until the array is shrunk.
+typedef struct BsPequeno {
+    void* heap;      // NULL while the elements are inline
+    long long len;
+    long long cap;   // Elements that fit in 'heap'
+} BsPequeno;
+
+static inline long long bs_pequeno_cap(const BsPequeno* h, long long n_local)
+{
+    return h->heap ? h->cap : n_local;
+}
+
+// Room for 'n' elements of 'tam' bytes ('local' holds 'n_local' of them)
+void bs_pequeno_reservar(BsPequeno* h, void* local, long long n_local, long long n, size_t tam);
+// Trim the heap buffer to the length, moving back inline when it fits
+void bs_pequeno_encolher(BsPequeno* h, void* local, long long n_local, size_t tam);
+
+// --- STRING VIEWS (fatia_texto) ---
+// Borrowed bytes of a string: not NUL-terminated and never freed. '.texto()'
+// copies them into an owned sds. A view of a texto is valid until that texto
+// is modified.
+typedef struct BsFatiaTexto {
+    const char* dados;
+    long long len;
+} BsFatiaTexto;
+
+sds fatia_texto_to_string(BsFatiaTexto v);
+sds array_fatia_texto_to_string(BsFatiaTexto* arr);
+
+// Whole texto as a view (nulo is the empty string)
+static inline BsFatiaTexto bs_fatia_texto_de(sds s)
+{
+    BsFatiaTexto v = { s ? s : "", s ? (long long)sdslen(s) : 0 };
+    return v;
+}
+
+// v.sub(a, b): bytes [a, b) (bounds are clamped)
+static inline BsFatiaTexto bs_texto_sub(BsFatiaTexto v, long long inicio, long long fim)
+{
+    if (fim > v.len) fim = v.len;
+    if (inicio < 0) inicio = 0;
+    if (inicio > fim) inicio = fim;
+    BsFatiaTexto r = { v.dados + inicio, fim - inicio };
+    return r;
+}
+
+static inline _Bool bs_texto_comeca_com(BsFatiaTexto v, BsFatiaTexto p)
+{
+    return p.len <= v.len && memcmp(v.dados, p.dados, (size_t)p.len) == 0;
+}
+
+static inline _Bool bs_texto_termina_com(BsFatiaTexto v, BsFatiaTexto p)
+{
+    return p.len <= v.len && memcmp(v.dados + (v.len - p.len), p.dados, (size_t)p.len) == 0;
+}
+
+// a == b: lengths first (O(1) for texto), bytes only when they match
+static inline _Bool bs_texto_igual(BsFatiaTexto a, BsFatiaTexto b)
+{
+    return a.len == b.len && (a.dados == b.dados || memcmp(a.dados, b.dados, (size_t)a.len) == 0);
+}
+
+// --- STRING HASHING ---
+// wyhash-style 64-bit hash: each step folds a 64x64->128 bit multiply, 16
+// bytes at a time. '.hash()' uses seed 0 (stable across runs); the texto-keyed
+// maps use it with their own seed through STBDS_HASH_STRING. codegen.c folds
+// the hash of literals with a copy of this function: keep the two in sync.
+static inline uint64_t bs_hash_mix(uint64_t a, uint64_t b)
+{
+    __uint128_t r = (__uint128_t)a * b;
+    return (uint64_t)r ^ (uint64_t)(r >> 64);
+}
+
+static inline uint64_t bs_hash_ler64(const unsigned char* p)
+{
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+static inline uint64_t bs_hash_ler32(const unsigned char* p)
+{
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+static inline uint64_t bs_hash_bytes(const void* dados, size_t len, uint64_t seed)
+{
+    const unsigned char* p = (const unsigned char*)dados;
+    uint64_t a, b;
+    seed ^= bs_hash_mix(seed ^ 0xa0761d6478bd642full, 0xe7037ed1a0b428dbull);
+    if (len <= 16)
+    {
+        if (len >= 4)
+        {
+            // Two overlapping 4-byte reads from each end cover 4..16 bytes
+            size_t meio = (len >> 3) << 2;
+            a = (bs_hash_ler32(p) << 32) | bs_hash_ler32(p + meio);
+            b = (bs_hash_ler32(p + len - 4) << 32) | bs_hash_ler32(p + len - 4 - meio);
+        }
+        else if (len > 0)
+        {
+            a = ((uint64_t)p[0] << 16) | ((uint64_t)p[len >> 1] << 8) | p[len - 1];
+            b = 0;
+        }
+        else
+        {
+            a = b = 0;
+        }
+    }
+    else
+    {
+        size_t i = len;
+        while (i > 16)
+        {
+            seed = bs_hash_mix(bs_hash_ler64(p) ^ 0xe7037ed1a0b428dbull, bs_hash_ler64(p + 8) ^ seed);
+            p += 16;
+            i -= 16;
+        }
+        // Last 16 bytes (may overlap the final block)
+        a = bs_hash_ler64(p + i - 16);
+        b = bs_hash_ler64(p + i - 8);
+    }
+    __uint128_t r = (__uint128_t)(a ^ 0xe7037ed1a0b428dbull) * (b ^ seed);
+    return bs_hash_mix((uint64_t)r ^ 0xa0761d6478bd642full ^ len, (uint64_t)(r >> 64) ^ 0xe7037ed1a0b428dbull);
+}
+
+// s.hash()
+static inline unsigned long long bs_texto_hash(BsFatiaTexto v)
+{
+    return bs_hash_bytes(v.dados, (size_t)v.len, 0);
+}
+
+// Texto-keyed maps ('sh' tables in stb_ds) hash their keys with bs_hash_bytes
+#define STBDS_HASH_STRING(str, seed) ((size_t)bs_hash_bytes((str), strlen(str), (seed)))
+
+// a + b + c: the pieces copied into one exact-size sds (no operand is modified)
+sds bs_texto_juntar(int n, const BsFatiaTexto* partes);
+// Without leading and trailing whitespace
+BsFatiaTexto bs_texto_aparar(BsFatiaTexto v);
+// Index of the first occurrence of 'agulha', -1 if none (SIMD, see core.c)
+long long bs_texto_encontrar(BsFatiaTexto v, BsFatiaTexto agulha);
+// Non-overlapping occurrences of 'agulha'
+long long bs_texto_contar(BsFatiaTexto v, BsFatiaTexto agulha);
+// Owned copy with every 'de' replaced by 'para'
+sds bs_texto_substituir(BsFatiaTexto v, BsFatiaTexto de, BsFatiaTexto para);
+// Views of the pieces between each 'sep' (a [fatia_texto]; the bytes are not copied)
+BsFatiaTexto* bs_texto_dividir(BsFatiaTexto v, BsFatiaTexto sep);
+
+// --- PACKED STRING ARRAYS ([texto; compacto]) ---
+// Every element lives back to back in one byte pool; element i is
+// bytes[fim[i - 1] .. fim[i]) (fim[-1] = 0). A push appends to the pool and
+// one offset, so n strings cost two growable buffers instead of n sds
+// allocations. Views of elements stay valid until the next push.
+typedef struct BsTextos {
+    char* bytes;
+    long long* fim;
+    long long len;
+    long long cap;       // Offsets that fit in 'fim'
+    long long cap_bytes; // Bytes that fit in 'bytes'
+} BsTextos;
+
+static inline long long bs_textos_len(const BsTextos* t)
+{
+    return t ? t->len : 0;
+}
+
+static inline BsFatiaTexto bs_textos_em(const BsTextos* t, long long i)
+{
+    long long inicio = i > 0 ? t->fim[i - 1] : 0;
+    BsFatiaTexto v = { t->bytes + inicio, t->fim[i] - inicio };
+    return v;
+}
+
+// Room for 'n' elements and 'bytes' bytes of text (allocates the array when NULL)
+BsTextos* bs_textos_reservar(BsTextos* t, long long n, long long bytes);
+// Append 'n' bytes of 's' as a new element
+BsTextos* bs_textos_push(BsTextos* t, const char* s, long long n);
+// Packed copy of a [texto]
+BsTextos* bs_textos_de(char** arr);
+// Independent copy (xs.copiar())
+BsTextos* bs_textos_copiar(const BsTextos* t);
+// Unpacked copy: a [texto] with its own sds per element
+char** bs_textos_para_array(const BsTextos* t);
+// Remove the last element; the view stays valid until the next push
+BsFatiaTexto bs_textos_pop(BsTextos* t);
+sds textos_to_string(const BsTextos* t);
+
+static inline BsTextos* bs_textos_push_texto(BsTextos* t, sds s)
+{
+    return bs_textos_push(t, s, s ? (long long)sdslen(s) : 0);
+}
+
+static inline BsTextos* bs_textos_push_fatia(BsTextos* t, BsFatiaTexto v)
+{
+    return bs_textos_push(t, v.dados, v.len);
+}
+
+static inline void bs_textos_limpar(BsTextos* t)
+{
+    if (t)
+        t->len = 0;
+}
+
+// --- STRING BUILDERS (construtor_texto) ---
+// One growable byte buffer for building a texto piece by piece. The capacity
+// doubles, so n appends copy O(n) bytes in total, and numbers are formatted
+// straight into the free tail instead of through a temporary sds. '.texto()'
+// copies the bytes into an exact-size sds; the builder stays usable.
+typedef struct BsConstrutor {
+    char* dados;
+    long long len;
+    long long cap;
+} BsConstrutor;
+
+// Room for 'n' bytes in total (allocates the builder when NULL)
+BsConstrutor* bs_construtor_reservar(BsConstrutor* c, long long n);
+// Room for 'n' more bytes, doubling the capacity
+BsConstrutor* bs_construtor_crescer(BsConstrutor* c, long long n);
+// Builder holding a copy of 'v', with room to grow
+BsConstrutor* bs_construtor_de(BsFatiaTexto v);
+sds bs_construtor_texto(const BsConstrutor* c);
+void bs_construtor_liberar(BsConstrutor* c);
+BsConstrutor* bs_construtor_anexar_inteiro(BsConstrutor* c, long long x);
+BsConstrutor* bs_construtor_anexar_natural(BsConstrutor* c, unsigned long long x);
+BsConstrutor* bs_construtor_anexar_real(BsConstrutor* c, double x);
+BsConstrutor* bs_construtor_anexar_real_ext(BsConstrutor* c, long double x);
+
+static inline long long bs_construtor_len(const BsConstrutor* c)
+{
+    return c ? c->len : 0;
+}
+
+// The bytes built so far, valid until the next append
+static inline BsFatiaTexto bs_construtor_vista(const BsConstrutor* c)
+{
+    BsFatiaTexto v = { c ? c->dados : "", c ? c->len : 0 };
+    return v;
+}
+
+static inline BsConstrutor* bs_construtor_anexar(BsConstrutor* c, const char* s, long long n)
+{
+    if (!c || c->len + n > c->cap)
+        c = bs_construtor_crescer(c, n);
+    if (n > 0)
+        memcpy(c->dados + c->len, s, (size_t)n);
+    c->len += n;
+    return c;
+}
+
+static inline BsConstrutor* bs_construtor_anexar_texto(BsConstrutor* c, sds s)
+{
+    return bs_construtor_anexar(c, s, s ? (long long)sdslen(s) : 0);
+}
+
+static inline BsConstrutor* bs_construtor_anexar_fatia(BsConstrutor* c, BsFatiaTexto v)
+{
+    return bs_construtor_anexar(c, v.dados, v.len);
+}
+
+static inline BsConstrutor* bs_construtor_anexar_caractere(BsConstrutor* c, char x)
+{
+    return bs_construtor_anexar(c, &x, 1);
+}
+
+static inline void bs_construtor_limpar(BsConstrutor* c)
+{
+    if (c)
+        c->len = 0;
+}
+
+// sb.anexar(x) for any primitive: formatted like the interpolation does
+#define bs_construtor_anexar_valor(c, x) _Generic((x), \
+    char*: bs_construtor_anexar_texto, \
+    BsFatiaTexto: bs_construtor_anexar_fatia, \
+    char: bs_construtor_anexar_caractere, \
+    unsigned long: bs_construtor_anexar_natural, \
+    unsigned long long: bs_construtor_anexar_natural, \
+    float: bs_construtor_anexar_real, \
+    double: bs_construtor_anexar_real, \
+    long double: bs_construtor_anexar_real_ext, \
+    default: bs_construtor_anexar_inteiro)((c), (x))
+
+// --- DYNAMIC ARRAYS ---
+// xs.encolher(): trim the stb_ds buffer to its length (returns the new array)
+void* bs_arr_encolher(void* arr, size_t tam);
+
+// --- STRING TO PRIMITIVE ---
+// s.inteiro32(), s.real64(), ...: decimal parsing on a view (8 digits per step,
+// see core.c). Whitespace around the number is allowed. Each conversion leaves
+// its outcome in bs_erro_conversao ('erro_conversao()' in Basalto).
+#define BS_CONVERSAO_OK 0
+#define BS_CONVERSAO_INVALIDO 1 // Not a number: the value is the parsed prefix
+#define BS_CONVERSAO_ESTOURO 2  // Out of range: the value is the nearest limit
+extern int bs_erro_conversao;
+
+long long bs_texto_para_inteiro(BsFatiaTexto v, long long min, long long max);
+double bs_texto_para_real(BsFatiaTexto v);
+long double bs_texto_para_real_ext(BsFatiaTexto v);
+float bs_texto_real32(BsFatiaTexto v);
+
+static inline signed char bs_texto_inteiro8(BsFatiaTexto v) { return (signed char)bs_texto_para_inteiro(v, INT8_MIN, INT8_MAX); }
+static inline short bs_texto_inteiro16(BsFatiaTexto v) { return (short)bs_texto_para_inteiro(v, INT16_MIN, INT16_MAX); }
+static inline int bs_texto_inteiro32(BsFatiaTexto v) { return (int)bs_texto_para_inteiro(v, INT32_MIN, INT32_MAX); }
+static inline long long bs_texto_inteiro64(BsFatiaTexto v) { return bs_texto_para_inteiro(v, INT64_MIN, INT64_MAX); }
+static inline long bs_texto_inteiro_arq(BsFatiaTexto v) { return (long)bs_texto_para_inteiro(v, LONG_MIN, LONG_MAX); }
+static inline double bs_texto_real64(BsFatiaTexto v) { return bs_texto_para_real(v); }
+static inline long double bs_texto_real_ext(BsFatiaTexto v) { return bs_texto_para_real_ext(v); }
+
+// Bulk: s.inteiros(sep) / s.reais(sep) split and parse in one pass; on string
+// arrays, xs.inteiros() / xs.reais() parse every element. New stb_ds arrays.
+long long* bs_texto_inteiros(BsFatiaTexto v, BsFatiaTexto sep);
+double* bs_texto_reais(BsFatiaTexto v, BsFatiaTexto sep);
+long long* bs_array_texto_inteiros(char** xs);
+double* bs_array_texto_reais(char** xs);
+long long* bs_array_fatia_texto_inteiros(BsFatiaTexto* xs);
+double* bs_array_fatia_texto_reais(BsFatiaTexto* xs);
+long long* bs_textos_inteiros(const BsTextos* t);
+double* bs_textos_reais(const BsTextos* t);
+
+// C strings
 signed char string_to_int8(char* s);
 short string_to_int16(char* s);
 int string_to_int32(char* s);
@@ -56,6 +589,33 @@ long double string_to_real_ext(char* s);
 
 // --- MEMORY MANAGEMENT (Arena) ---
 void* bs_alloc(size_t size);
+// Zeroed, untracked, beyond malloc's alignment
+void* bs_alloc_aligned(size_t size, size_t alignment);
 void bs_free_all();
 
+// --- MEMORY MANAGEMENT (Tracing GC, basalto --gc) ---
+// Pointer-field offsets of a struct, emitted by codegen for every 'estrutura'
+typedef struct BsGcLayout {
+    const char* name;
+    size_t count;
+    const size_t* offsets;
+} BsGcLayout;
+
+extern const BsGcLayout bs_gc_leaf;
+
+void bs_gc_init(void* stack_bottom);
+void bs_gc_collect(void);
+void* bs_gc_alloc(size_t size, const BsGcLayout* layout);
+void* bs_gc_alloc_aligned(size_t size, size_t align, const BsGcLayout* layout);
+void* bs_gc_realloc(void* ptr, size_t size);
+void* bs_gc_malloc_leaf(size_t size);
+void* bs_gc_realloc_leaf(void* ptr, size_t size);
+void bs_gc_free(void* ptr);
+
+#ifdef BASALTO_GC
+// Route stb_ds buffers through the collector (must precede stb_ds.h)
+#define STBDS_REALLOC(c, p, s) bs_gc_realloc(p, s)
+#define STBDS_FREE(c, p) bs_gc_free(p)
+#endif
+
 #endif
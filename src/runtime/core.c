@@ -1,9 +1,15 @@
+#define _GNU_SOURCE // memmem
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdarg.h>
 #include <math.h>
+#include <errno.h>
+#include <float.h>
+#include <limits.h>
+#include <unistd.h>
 
+#include "basalto.h"
 #include "stb_ds.h"
 #include "sds.h"
 
@@ -16,6 +22,21 @@ typedef struct Allocation
 
 static Allocation *arena_head = NULL;
 
+// Link 'ptr' into the arena so bs_free_all releases it
+static void arena_track(void *ptr)
+{
+    Allocation *node = malloc(sizeof(Allocation));
+    if (!node)
+    {
+        free(ptr);
+        fprintf(stderr, "[Basalto] Out of memory (tracker)!\n");
+        exit(1);
+    }
+    node->ptr = ptr;
+    node->next = arena_head;
+    arena_head = node;
+}
+
 void *bs_alloc(size_t size)
 {
     // 1. Allocate object (zero-initialized)
@@ -27,19 +48,22 @@ void *bs_alloc(size_t size)
     }
 
     // 2. Track it
-    Allocation *node = malloc(sizeof(Allocation));
-    if (!node)
+    arena_track(ptr);
+    return ptr;
+}
+
+// nova on an @alinhado(n) struct, n > 16 (size is already a multiple of n)
+void *bs_alloc_aligned(size_t size, size_t alignment)
+{
+    void *ptr = aligned_alloc(alignment, size);
+    if (!ptr)
     {
-        free(ptr);
-        fprintf(stderr, "[Basalto] Out of memory (tracker)!\n");
+        fprintf(stderr, "[Basalto] Out of memory!\n");
         exit(1);
     }
-    node->ptr = ptr;
-    node->next = arena_head;
-
-    // 3. Link it
-    arena_head = node;
-
+    memset(ptr, 0, size);
+    // aligned_alloc memory is released with free() like the rest of the arena
+    arena_track(ptr);
     return ptr;
 }
 
@@ -56,77 +80,205 @@ void bs_free_all()
     arena_head = NULL;
 }
 
-// --- INPUT HELPERS ---
+// --- NUMBER FORMATTING ---
 
-void flush_input()
-{
-    int c;
-    while ((c = getchar()) != '\n' && c != EOF)
-        ;
-}
+// "00" "01" ... "99": two digits per division
+static const char digitos_pares[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
 
-int read_int()
+static int contar_digitos(unsigned long long x)
 {
-    int x;
-    scanf("%d", &x);
-    flush_input();
-    return x;
+    int n = 1;
+    while (x >= 100)
+    {
+        x /= 100;
+        n += 2;
+    }
+    return n + (x >= 10);
 }
 
-long long read_long()
+// Writes the digits of x back to front, ending just before 'fim'
+static void escrever_digitos(char *fim, unsigned long long x)
 {
-    long long x;
-    scanf("%lld", &x);
-    flush_input();
-    return x;
+    while (x >= 100)
+    {
+        unsigned i = (unsigned)(x % 100) * 2;
+        x /= 100;
+        *--fim = digitos_pares[i + 1];
+        *--fim = digitos_pares[i];
+    }
+    if (x >= 10)
+    {
+        *--fim = digitos_pares[x * 2 + 1];
+        *--fim = digitos_pares[x * 2];
+    }
+    else
+    {
+        *--fim = (char)('0' + x);
+    }
 }
 
-float read_float()
+int bs_formatar_natural(char *buf, unsigned long long x)
 {
-    float x;
-    scanf("%f", &x);
-    flush_input();
-    return x;
+    int n = contar_digitos(x);
+    escrever_digitos(buf + n, x);
+    buf[n] = '\0';
+    return n;
 }
 
-double read_double()
+int bs_formatar_inteiro(char *buf, long long x)
 {
-    double x;
-    scanf("%lf", &x);
-    flush_input();
-    return x;
+    if (x >= 0)
+        return bs_formatar_natural(buf, (unsigned long long)x);
+    buf[0] = '-';
+    return 1 + bs_formatar_natural(buf + 1, 0ull - (unsigned long long)x);
 }
 
-char *read_string()
+// printf("%f"): six decimals, rounded half to even from the exact binary value.
+// Below 2^63 the integer part fits a 64-bit word and the fraction m / 2^k is
+// scaled by 10^6 exactly in 128 bits; NaN, infinities and larger values go
+// through snprintf.
+int bs_formatar_real(char *buf, double x)
 {
-    sds s = sdsempty();
-    int c;
-    while ((c = getchar()) != '\n' && c != EOF)
+    double a = fabs(x);
+    if (!(a < 9.2e18))
+        return snprintf(buf, BS_NUMERO_MAX, "%f", x);
+
+    char *p = buf;
+    if (signbit(x))
+        *p++ = '-';
+    unsigned long long inteiro = (unsigned long long)a;
+    double fracao = a - (double)inteiro; // Exact
+    unsigned long long micro = 0;
+    int e;
+    double m = frexp(fracao, &e);
+    if (fracao > 0 && e >= -30) // Below 2^-31 the six decimals round to 0
+    {
+        unsigned long long mantissa = (unsigned long long)(m * 9007199254740992.0); // m * 2^53, exact
+        int k = 53 - e;
+        __uint128_t v = (__uint128_t)mantissa * 1000000u;
+        __uint128_t resto = v & (((__uint128_t)1 << k) - 1);
+        __uint128_t meio = (__uint128_t)1 << (k - 1);
+        micro = (unsigned long long)(v >> k);
+        if (resto > meio || (resto == meio && (micro & 1)))
+            micro++;
+        if (micro == 1000000)
+        {
+            micro = 0;
+            inteiro++;
+        }
+    }
+    p += bs_formatar_natural(p, inteiro);
+    *p++ = '.';
+    for (int i = 5; i >= 0; i--)
     {
-        char ch = c;
-        s = sdscatlen(s, &ch, 1);
+        p[i] = (char)('0' + micro % 10);
+        micro /= 10;
     }
+    p[6] = '\0';
+    return (int)(p + 6 - buf);
+}
+
+sds bs_sds_anexar_natural(sds s, unsigned long long x)
+{
+    s = sdsMakeRoomFor(s, 20);
+    int n = bs_formatar_natural(s + sdslen(s), x);
+    sdsIncrLen(s, n);
     return s;
 }
 
-void wait_enter()
+sds bs_sds_anexar_inteiro(sds s, long long x)
 {
-    flush_input();
+    s = sdsMakeRoomFor(s, 21);
+    int n = bs_formatar_inteiro(s + sdslen(s), x);
+    sdsIncrLen(s, n);
+    return s;
+}
+
+sds bs_sds_anexar_real(sds s, double x)
+{
+    char buf[BS_NUMERO_MAX];
+    int n = bs_formatar_real(buf, x);
+    return sdscatlen(s, buf, (size_t)n);
+}
+
+sds bs_sds_anexar_real_ext(sds s, long double x) { return sdscatprintf(s, "%Lf", x); }
+sds bs_sds_anexar_texto(sds s, const char *x) { return sdscat(s, x ? x : "(null)"); }
+sds bs_sds_anexar_caractere(sds s, char x) { return sdscatlen(s, &x, 1); }
+
+void bs_escrever_natural(unsigned long long x)
+{
+    char buf[BS_NUMERO_MAX];
+    fwrite(buf, 1, (size_t)bs_formatar_natural(buf, x), stdout);
+}
+
+void bs_escrever_inteiro(long long x)
+{
+    char buf[BS_NUMERO_MAX];
+    fwrite(buf, 1, (size_t)bs_formatar_inteiro(buf, x), stdout);
+}
+
+void bs_escrever_real(double x)
+{
+    char buf[BS_NUMERO_MAX];
+    fwrite(buf, 1, (size_t)bs_formatar_real(buf, x), stdout);
 }
 
+void bs_escrever_real_ext(long double x) { printf("%Lf", x); }
+void bs_escrever_texto(const char *x) { fputs(x ? x : "(null)", stdout); }
+void bs_escrever_caractere(char x) { putchar(x); }
+
 // --- CONVERSION HELPERS ---
 
-sds int8_to_string(signed char x) { return sdscatprintf(sdsempty(), "%d", x); }
-sds int16_to_string(short x) { return sdscatprintf(sdsempty(), "%d", x); }
-sds int32_to_string(int x) { return sdscatprintf(sdsempty(), "%d", x); }
-sds int64_to_string(long long x) { return sdscatprintf(sdsempty(), "%lld", x); }
-sds int_arq_to_string(long x) { return sdscatprintf(sdsempty(), "%ld", x); }
-sds float32_to_string(float x) { return sdscatprintf(sdsempty(), "%f", x); }
-sds float64_to_string(double x) { return sdscatprintf(sdsempty(), "%f", x); }
+static sds inteiro_texto(long long x)
+{
+    char buf[BS_NUMERO_MAX];
+    return sdsnewlen(buf, (size_t)bs_formatar_inteiro(buf, x));
+}
+
+static sds real_texto(double x)
+{
+    char buf[BS_NUMERO_MAX];
+    return sdsnewlen(buf, (size_t)bs_formatar_real(buf, x));
+}
+
+sds int8_to_string(signed char x) { return inteiro_texto(x); }
+sds int16_to_string(short x) { return inteiro_texto(x); }
+sds int32_to_string(int x) { return inteiro_texto(x); }
+sds int64_to_string(long long x) { return inteiro_texto(x); }
+sds int_arq_to_string(long x) { return inteiro_texto(x); }
+sds float32_to_string(float x) { return real_texto(x); }
+sds float64_to_string(double x) { return real_texto(x); }
 sds float_ext_to_string(long double x) { return sdscatprintf(sdsempty(), "%Lf", x); }
 sds char_to_string(char *x) { return sdsnew(x); }
 
-sds array_int_to_string(int *arr)
+// '[a, b, c]' for a [T] of numbers (or booleans, printed as 0/1)
+#define ARRAY_TO_STRING(nome, tipo, anexar)          \
+    sds nome(tipo *arr)                              \
+    {                                                \
+        if (!arr || arrlen(arr) == 0)                \
+            return sdsnew("[]");                     \
+        sds result = sdsnew("[");                    \
+        for (ptrdiff_t i = 0; i < arrlen(arr); i++)  \
+        {                                            \
+            if (i > 0)                               \
+                result = sdscat(result, ", ");       \
+            result = anexar(result, arr[i]);         \
+        }                                            \
+        result = sdscat(result, "]");                \
+        return result;                               \
+    }
+
+ARRAY_TO_STRING(array_int_to_string, int, bs_sds_anexar_inteiro)
+ARRAY_TO_STRING(array_int64_to_string, long long, bs_sds_anexar_inteiro)
+ARRAY_TO_STRING(array_natural_to_string, unsigned long long, bs_sds_anexar_natural)
+ARRAY_TO_STRING(array_double_to_string, double, bs_sds_anexar_real)
+ARRAY_TO_STRING(array_float_to_string, float, bs_sds_anexar_real)
+ARRAY_TO_STRING(array_bool_to_string, _Bool, bs_sds_anexar_inteiro)
+
+sds array_string_to_string(char **arr)
 {
     if (!arr || arrlen(arr) == 0)
         return sdsnew("[]");
@@ -135,40 +287,1309 @@ sds array_int_to_string(int *arr)
     {
         if (i > 0)
             result = sdscat(result, ", ");
-        result = sdscatprintf(result, "%d", arr[i]);
+        result = sdscat(result, "\"");
+        if (arr[i])
+            result = sdscat(result, arr[i]);
+        result = sdscat(result, "\"");
     }
     result = sdscat(result, "]");
     return result;
 }
 
-sds array_string_to_string(char **arr)
+// The same for a view: element i at ((T *)dados)[i * passo]
+#define FATIA_TO_STRING(nome, tipo, anexar)                                 \
+    sds nome(BsFatia f)                                                     \
+    {                                                                       \
+        sds result = sdsnew("[");                                           \
+        for (long long i = 0; i < f.len; i++)                               \
+        {                                                                   \
+            if (i > 0)                                                      \
+                result = sdscat(result, ", ");                              \
+            result = anexar(result, ((tipo *)f.dados)[i * f.passo]);        \
+        }                                                                   \
+        result = sdscat(result, "]");                                       \
+        return result;                                                      \
+    }
+
+FATIA_TO_STRING(fatia_int_to_string, int, bs_sds_anexar_inteiro)
+FATIA_TO_STRING(fatia_int64_to_string, long long, bs_sds_anexar_inteiro)
+FATIA_TO_STRING(fatia_natural_to_string, unsigned long long, bs_sds_anexar_natural)
+FATIA_TO_STRING(fatia_double_to_string, double, bs_sds_anexar_real)
+FATIA_TO_STRING(fatia_float_to_string, float, bs_sds_anexar_real)
+FATIA_TO_STRING(fatia_bool_to_string, _Bool, bs_sds_anexar_inteiro)
+
+sds fatia_string_to_string(BsFatia f)
 {
-    if (!arr || arrlen(arr) == 0)
-        return sdsnew("[]");
     sds result = sdsnew("[");
-    for (int i = 0; i < arrlen(arr); i++)
+    for (long long i = 0; i < f.len; i++)
     {
+        char *item = ((char **)f.dados)[i * f.passo];
         if (i > 0)
             result = sdscat(result, ", ");
         result = sdscat(result, "\"");
-        if (arr[i])
-            result = sdscat(result, arr[i]);
+        if (item)
+            result = sdscat(result, item);
         result = sdscat(result, "\"");
     }
     result = sdscat(result, "]");
     return result;
 }
 
-// --- STRING TO PRIMITIVE ---
+// --- MATRICES ---
+
+BsMatriz bs_matriz(long long linhas, long long colunas, size_t tam, int folha)
+{
+    if (linhas < 0 || colunas < 0)
+    {
+        fprintf(stderr, "[Basalto] Erro: matriz com dimensoes invalidas (%lld x %lld).\n", linhas, colunas);
+        exit(1);
+    }
+    if (colunas > 0 && (size_t)linhas > SIZE_MAX / tam / (size_t)colunas)
+    {
+        fprintf(stderr, "[Basalto] Erro: matriz grande demais (%lld x %lld).\n", linhas, colunas);
+        exit(1);
+    }
+    size_t bytes = (size_t)linhas * (size_t)colunas * tam;
+#ifdef BASALTO_GC
+    void *dados = bs_gc_alloc(bytes ? bytes : 1, folha ? &bs_gc_leaf : NULL);
+#else
+    (void)folha;
+    void *dados = bs_alloc(bytes ? bytes : 1);
+#endif
+    BsMatriz m = {dados, linhas, colunas};
+    return m;
+}
+
+// One row per line: "[1, 2]\n[3, 4]"
+#define MATRIZ_TO_STRING(nome, tipo, anexar)                                \
+    sds nome(BsMatriz m)                                                    \
+    {                                                                       \
+        sds result = sdsempty();                                            \
+        for (long long i = 0; i < m.linhas; i++)                            \
+        {                                                                   \
+            result = sdscat(result, i > 0 ? "\n[" : "[");                   \
+            for (long long j = 0; j < m.colunas; j++)                       \
+            {                                                               \
+                if (j > 0)                                                  \
+                    result = sdscat(result, ", ");                          \
+                result = anexar(result, ((tipo *)m.dados)[i * m.colunas + j]); \
+            }                                                               \
+            result = sdscat(result, "]");                                   \
+        }                                                                   \
+        return result;                                                      \
+    }
+
+MATRIZ_TO_STRING(matriz_int8_to_string, signed char, bs_sds_anexar_inteiro)
+MATRIZ_TO_STRING(matriz_int16_to_string, short, bs_sds_anexar_inteiro)
+MATRIZ_TO_STRING(matriz_int_to_string, int, bs_sds_anexar_inteiro)
+MATRIZ_TO_STRING(matriz_int64_to_string, long long, bs_sds_anexar_inteiro)
+MATRIZ_TO_STRING(matriz_int_arq_to_string, long, bs_sds_anexar_inteiro)
+MATRIZ_TO_STRING(matriz_byte_to_string, unsigned char, bs_sds_anexar_natural)
+MATRIZ_TO_STRING(matriz_natural16_to_string, unsigned short, bs_sds_anexar_natural)
+MATRIZ_TO_STRING(matriz_natural32_to_string, unsigned int, bs_sds_anexar_natural)
+MATRIZ_TO_STRING(matriz_natural_to_string, unsigned long long, bs_sds_anexar_natural)
+MATRIZ_TO_STRING(matriz_natural_arq_to_string, unsigned long, bs_sds_anexar_natural)
+MATRIZ_TO_STRING(matriz_float_to_string, float, bs_sds_anexar_real)
+MATRIZ_TO_STRING(matriz_double_to_string, double, bs_sds_anexar_real)
+MATRIZ_TO_STRING(matriz_real_ext_to_string, long double, bs_sds_anexar_real_ext)
+MATRIZ_TO_STRING(matriz_bool_to_string, _Bool, bs_sds_anexar_inteiro)
+
+// --- BITSETS ---
+
+#define BITS_PALAVRAS(len) (((len) + 63) / 64)
+
+BsBits bs_bits(long long len)
+{
+    if (len < 0)
+    {
+        fprintf(stderr, "[Basalto] Erro: bits com tamanho invalido (%lld).\n", len);
+        exit(1);
+    }
+    size_t bytes = (size_t)BITS_PALAVRAS(len) * sizeof(uint64_t);
+#ifdef BASALTO_GC
+    uint64_t *palavras = bs_gc_alloc(bytes ? bytes : 1, &bs_gc_leaf);
+#else
+    uint64_t *palavras = bs_alloc(bytes ? bytes : 1);
+#endif
+    BsBits b = {palavras, len};
+    return b;
+}
+
+long long bs_bits_contar(BsBits b)
+{
+    long long total = 0;
+    for (long long w = 0; w < BITS_PALAVRAS(b.len); w++)
+        total += __builtin_popcountll(b.palavras[w]);
+    return total;
+}
+
+long long bs_bits_proximo(BsBits b, long long inicio)
+{
+    if (inicio < 0)
+        inicio = 0;
+    if (inicio >= b.len)
+        return -1;
+    long long w = inicio >> 6;
+    // Drop the bits below 'inicio' in its own word, then skip whole empty words
+    uint64_t palavra = b.palavras[w] & (~(uint64_t)0 << (inicio & 63));
+    while (palavra == 0)
+    {
+        if (++w >= BITS_PALAVRAS(b.len))
+            return -1;
+        palavra = b.palavras[w];
+    }
+    return w * 64 + __builtin_ctzll(palavra);
+}
+
+static void bits_mesmo_tamanho(BsBits a, BsBits b)
+{
+    if (a.len != b.len)
+    {
+        fprintf(stderr, "[Basalto] Erro: operacao entre bits de tamanhos diferentes (%lld e %lld).\n", a.len, b.len);
+        exit(1);
+    }
+}
+
+// Clear the bits of the last word that lie past 'len'
+static void bits_aparar(BsBits b)
+{
+    if (b.len & 63)
+        b.palavras[b.len >> 6] &= ((uint64_t)1 << (b.len & 63)) - 1;
+}
+
+void bs_bits_e(BsBits a, BsBits b)
+{
+    bits_mesmo_tamanho(a, b);
+    for (long long w = 0; w < BITS_PALAVRAS(a.len); w++)
+        a.palavras[w] &= b.palavras[w];
+}
+
+void bs_bits_ou(BsBits a, BsBits b)
+{
+    bits_mesmo_tamanho(a, b);
+    for (long long w = 0; w < BITS_PALAVRAS(a.len); w++)
+        a.palavras[w] |= b.palavras[w];
+}
+
+void bs_bits_xou(BsBits a, BsBits b)
+{
+    bits_mesmo_tamanho(a, b);
+    for (long long w = 0; w < BITS_PALAVRAS(a.len); w++)
+        a.palavras[w] ^= b.palavras[w];
+}
+
+void bs_bits_inverter(BsBits b)
+{
+    for (long long w = 0; w < BITS_PALAVRAS(b.len); w++)
+        b.palavras[w] = ~b.palavras[w];
+    bits_aparar(b);
+}
+
+void bs_bits_preencher(BsBits b, _Bool v)
+{
+    memset(b.palavras, v ? 0xff : 0, (size_t)BITS_PALAVRAS(b.len) * sizeof(uint64_t));
+    bits_aparar(b);
+}
+
+BsBits bs_bits_copiar(BsBits b)
+{
+    BsBits c = bs_bits(b.len);
+    memcpy(c.palavras, b.palavras, (size_t)BITS_PALAVRAS(b.len) * sizeof(uint64_t));
+    return c;
+}
+
+// "0110..." (bit 0 first)
+sds bits_to_string(BsBits b)
+{
+    sds result = sdsnewlen(NULL, (size_t)b.len);
+    for (long long i = 0; i < b.len; i++)
+        result[i] = bs_bits_ler(b, i) ? '1' : '0';
+    return result;
+}
+
+// --- DYNAMIC ARRAYS ---
+
+// stb_ds only ever grows a buffer; reallocate it down to exactly 'length' elements
+void *bs_arr_encolher(void *arr, size_t tam)
+{
+    if (!arr || stbds_header(arr)->capacity == stbds_header(arr)->length)
+        return arr;
+    size_t len = stbds_header(arr)->length;
+    stbds_array_header *h = STBDS_REALLOC(NULL, stbds_header(arr), sizeof(stbds_array_header) + len * tam);
+    if (!h)
+    {
+        fprintf(stderr, "[Basalto] Out of memory!\n");
+        exit(1);
+    }
+    h->capacity = len;
+    return h + 1;
+}
+
+// --- SMALL ARRAYS ---
+
+void bs_pequeno_reservar(BsPequeno *h, void *local, long long n_local, long long n, size_t tam)
+{
+    long long cap = bs_pequeno_cap(h, n_local);
+    if (n <= cap)
+        return;
+    // Same growth as stb_ds: at least double
+    if (n < 2 * cap)
+        n = 2 * cap;
+    void *heap = STBDS_REALLOC(NULL, h->heap, (size_t)n * tam);
+    if (!heap)
+    {
+        fprintf(stderr, "[Basalto] Out of memory!\n");
+        exit(1);
+    }
+    if (!h->heap)
+        memcpy(heap, local, (size_t)h->len * tam);
+    h->heap = heap;
+    h->cap = n;
+}
+
+void bs_pequeno_encolher(BsPequeno *h, void *local, long long n_local, size_t tam)
+{
+    if (!h->heap || h->cap == h->len)
+        return;
+    if (h->len <= n_local)
+    {
+        memcpy(local, h->heap, (size_t)h->len * tam);
+        STBDS_FREE(NULL, h->heap);
+        h->heap = NULL;
+        h->cap = 0;
+        return;
+    }
+    void *heap = STBDS_REALLOC(NULL, h->heap, (size_t)h->len * tam);
+    if (!heap)
+    {
+        fprintf(stderr, "[Basalto] Out of memory!\n");
+        exit(1);
+    }
+    h->heap = heap;
+    h->cap = h->len;
+}
+
+// --- DEQUES ---
+
+BsFila *bs_fila_reservar(BsFila *f, size_t n, size_t tam)
+{
+    if (!f)
+    {
+        f = STBDS_REALLOC(NULL, NULL, sizeof(BsFila));
+        if (!f)
+        {
+            fprintf(stderr, "[Basalto] Out of memory!\n");
+            exit(1);
+        }
+        memset(f, 0, sizeof(BsFila));
+    }
+    if (n <= f->cap)
+        return f;
+
+    size_t cap = f->cap ? f->cap : 8;
+    while (cap < n)
+        cap *= 2;
+    char *dados = STBDS_REALLOC(NULL, f->dados, cap * tam);
+    if (!dados)
+    {
+        fprintf(stderr, "[Basalto] Out of memory!\n");
+        exit(1);
+    }
+    // The part that wrapped around to the front moves just past the old end
+    size_t fim = f->cabeca + f->len;
+    if (fim > f->cap)
+        memcpy(dados + f->cap * tam, dados, (fim - f->cap) * tam);
+    f->dados = dados;
+    f->cap = cap;
+    return f;
+}
+
+BsFila *bs_fila_crescer(BsFila *f, size_t tam)
+{
+    return bs_fila_reservar(f, f ? f->len + 1 : 1, tam);
+}
+
+void bs_fila_vazia(void)
+{
+    fprintf(stderr, "[Basalto] Erro: fila vazia.\n");
+    exit(1);
+}
+
+// --- STRING VIEWS ---
+
+sds fatia_texto_to_string(BsFatiaTexto v) { return sdsnewlen(v.dados, (size_t)v.len); }
+
+sds array_fatia_texto_to_string(BsFatiaTexto *arr)
+{
+    sds result = sdsnew("[");
+    for (long long i = 0; i < arrlen(arr); i++)
+    {
+        if (i > 0)
+            result = sdscat(result, ", ");
+        result = sdscat(result, "\"");
+        result = sdscatlen(result, arr[i].dados, (size_t)arr[i].len);
+        result = sdscat(result, "\"");
+    }
+    result = sdscat(result, "]");
+    return result;
+}
+
+sds bs_texto_juntar(int n, const BsFatiaTexto *partes)
+{
+    size_t total = 0;
+    for (int i = 0; i < n; i++)
+        total += (size_t)partes[i].len;
+    sds result = sdsnewlen(NULL, total);
+    char *p = result;
+    for (int i = 0; i < n; i++)
+    {
+        memcpy(p, partes[i].dados, (size_t)partes[i].len);
+        p += partes[i].len;
+    }
+    return result;
+}
+
+static int texto_espaco(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+BsFatiaTexto bs_texto_aparar(BsFatiaTexto v)
+{
+    while (v.len > 0 && texto_espaco(v.dados[0]))
+    {
+        v.dados++;
+        v.len--;
+    }
+    while (v.len > 0 && texto_espaco(v.dados[v.len - 1]))
+        v.len--;
+    return v;
+}
+
+// --- STRING SEARCH ---
+// Needles of 2..BUSCA_CURTA bytes use the first/last byte filter: compare
+// p[0] and p[m - 1] against 16 (SSE2) or 32 (AVX2) positions at once and
+// memcmp only the candidates where both match. Single bytes go to memchr and
+// longer needles to memmem (two-way, linear in the worst case). AVX2 is picked
+// at run time through cpuid; other targets use the scalar loops.
+
+#define BUSCA_CURTA 32
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+
+static int busca_avx2(void)
+{
+    static int suportado = -1;
+    if (suportado < 0)
+        suportado = __builtin_cpu_supports("avx2") ? 1 : 0;
+    return suportado;
+}
+#endif
+
+// First/last byte filter without SIMD (tail of the vector loops, other targets)
+static long long busca_escalar(const char *s, long long n, const char *p, long long m)
+{
+    for (long long i = 0; i + m <= n; i++)
+    {
+        const char *c = memchr(s + i, p[0], (size_t)(n - m + 1 - i));
+        if (!c)
+            return -1;
+        i = c - s;
+        if (s[i + m - 1] == p[m - 1] && memcmp(s + i + 1, p + 1, (size_t)(m - 2)) == 0)
+            return i;
+    }
+    return -1;
+}
+
+#if defined(__x86_64__)
+static long long busca_sse2(const char *s, long long n, const char *p, long long m)
+{
+    const __m128i primeiro = _mm_set1_epi8(p[0]);
+    const __m128i ultimo = _mm_set1_epi8(p[m - 1]);
+    long long i = 0;
+    for (; i + m - 1 + 16 <= n; i += 16)
+    {
+        __m128i a = _mm_loadu_si128((const __m128i *)(s + i));
+        __m128i b = _mm_loadu_si128((const __m128i *)(s + i + m - 1));
+        unsigned mascara = (unsigned)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, primeiro), _mm_cmpeq_epi8(b, ultimo)));
+        while (mascara)
+        {
+            int bit = __builtin_ctz(mascara);
+            if (memcmp(s + i + bit + 1, p + 1, (size_t)(m - 2)) == 0)
+                return i + bit;
+            mascara &= mascara - 1;
+        }
+    }
+    long long resto = busca_escalar(s + i, n - i, p, m);
+    return resto < 0 ? -1 : i + resto;
+}
+
+__attribute__((target("avx2"))) static long long busca_avx2_filtro(const char *s, long long n, const char *p, long long m)
+{
+    const __m256i primeiro = _mm256_set1_epi8(p[0]);
+    const __m256i ultimo = _mm256_set1_epi8(p[m - 1]);
+    long long i = 0;
+    for (; i + m - 1 + 32 <= n; i += 32)
+    {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(s + i));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(s + i + m - 1));
+        unsigned mascara = (unsigned)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, primeiro), _mm256_cmpeq_epi8(b, ultimo)));
+        while (mascara)
+        {
+            int bit = __builtin_ctz(mascara);
+            if (memcmp(s + i + bit + 1, p + 1, (size_t)(m - 2)) == 0)
+                return i + bit;
+            mascara &= mascara - 1;
+        }
+    }
+    long long resto = busca_sse2(s + i, n - i, p, m);
+    return resto < 0 ? -1 : i + resto;
+}
+
+// Occurrences of byte 'c', 16 or 32 at a time (popcount of the match masks)
+static long long conta_byte_sse2(const char *s, long long n, char c)
+{
+    const __m128i alvo = _mm_set1_epi8(c);
+    long long total = 0, i = 0;
+    for (; i + 16 <= n; i += 16)
+        total += __builtin_popcount((unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(s + i)), alvo)));
+    for (; i < n; i++)
+        total += s[i] == c;
+    return total;
+}
 
-signed char string_to_int8(char *s) { return (signed char)atoi(s); }
-short string_to_int16(char *s) { return (short)atoi(s); }
-int string_to_int32(char *s) { return atoi(s); }
-long long string_to_int64(char *s) { return atoll(s); }
-long string_to_int_arq(char *s) { return atol(s); }
-float string_to_real32(char *s) { return (float)atof(s); }
-double string_to_real64(char *s) { return atof(s); }
-long double string_to_real_ext(char *s) { return (long double)atof(s); }
+__attribute__((target("avx2,popcnt"))) static long long conta_byte_avx2(const char *s, long long n, char c)
+{
+    const __m256i alvo = _mm256_set1_epi8(c);
+    long long total = 0, i = 0;
+    for (; i + 32 <= n; i += 32)
+        total += __builtin_popcount((unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(s + i)), alvo)));
+    return total + conta_byte_sse2(s + i, n - i, c);
+}
+#endif
+
+static long long busca(const char *s, long long n, const char *p, long long m)
+{
+    if (m == 0)
+        return 0;
+    if (m > n)
+        return -1;
+    if (m == 1)
+    {
+        const char *c = memchr(s, p[0], (size_t)n);
+        return c ? c - s : -1;
+    }
+    if (m > BUSCA_CURTA)
+    {
+        const char *c = memmem(s, (size_t)n, p, (size_t)m);
+        return c ? c - s : -1;
+    }
+#if defined(__x86_64__)
+    if (busca_avx2())
+        return busca_avx2_filtro(s, n, p, m);
+    return busca_sse2(s, n, p, m);
+#else
+    return busca_escalar(s, n, p, m);
+#endif
+}
+
+static long long conta_byte(const char *s, long long n, char c)
+{
+#if defined(__x86_64__)
+    if (busca_avx2())
+        return conta_byte_avx2(s, n, c);
+    return conta_byte_sse2(s, n, c);
+#else
+    long long total = 0;
+    for (long long i = 0; i < n; i++)
+        total += s[i] == c;
+    return total;
+#endif
+}
+
+long long bs_texto_encontrar(BsFatiaTexto v, BsFatiaTexto agulha)
+{
+    return busca(v.dados, v.len, agulha.dados, agulha.len);
+}
+
+long long bs_texto_contar(BsFatiaTexto v, BsFatiaTexto agulha)
+{
+    if (agulha.len == 0)
+        return 0;
+    if (agulha.len == 1)
+        return conta_byte(v.dados, v.len, agulha.dados[0]);
+    long long total = 0;
+    for (long long i = busca(v.dados, v.len, agulha.dados, agulha.len); i >= 0;)
+    {
+        total++;
+        v = bs_texto_sub(v, i + agulha.len, v.len);
+        i = busca(v.dados, v.len, agulha.dados, agulha.len);
+    }
+    return total;
+}
+
+sds bs_texto_substituir(BsFatiaTexto v, BsFatiaTexto de, BsFatiaTexto para)
+{
+    long long vezes = bs_texto_contar(v, de);
+    if (vezes == 0)
+        return sdsnewlen(v.dados, (size_t)v.len);
+    // Exact size up front: one allocation, no regrowth
+    sds result = sdsnewlen(NULL, (size_t)(v.len + vezes * (para.len - de.len)));
+    char *fim = result;
+    for (long long i = busca(v.dados, v.len, de.dados, de.len); i >= 0; i = busca(v.dados, v.len, de.dados, de.len))
+    {
+        memcpy(fim, v.dados, (size_t)i);
+        memcpy(fim + i, para.dados, (size_t)para.len);
+        fim += i + para.len;
+        v = bs_texto_sub(v, i + de.len, v.len);
+    }
+    memcpy(fim, v.dados, (size_t)v.len);
+    return result;
+}
+
+BsFatiaTexto *bs_texto_dividir(BsFatiaTexto v, BsFatiaTexto sep)
+{
+    BsFatiaTexto *partes = NULL;
+    if (sep.len == 0)
+    {
+        arrput(partes, v);
+        return partes;
+    }
+    for (;;)
+    {
+        long long i = bs_texto_encontrar(v, sep);
+        if (i < 0)
+            break;
+        arrput(partes, bs_texto_sub(v, 0, i));
+        v = bs_texto_sub(v, i + sep.len, v.len);
+    }
+    arrput(partes, v);
+    return partes;
+}
+
+// --- PACKED STRING ARRAYS ---
+
+// Byte pools and offsets hold no pointers: leaves for the collector
+static void *bytes_realloc(void *ptr, size_t size)
+{
+#ifdef BASALTO_GC
+    return bs_gc_realloc_leaf(ptr, size);
+#else
+    void *fresh = realloc(ptr, size);
+    if (!fresh)
+    {
+        fprintf(stderr, "[Basalto] Out of memory!\n");
+        exit(1);
+    }
+    return fresh;
+#endif
+}
+
+BsTextos *bs_textos_reservar(BsTextos *t, long long n, long long bytes)
+{
+    if (!t)
+    {
+        t = STBDS_REALLOC(NULL, NULL, sizeof(BsTextos));
+        if (!t)
+        {
+            fprintf(stderr, "[Basalto] Out of memory!\n");
+            exit(1);
+        }
+        memset(t, 0, sizeof(BsTextos));
+    }
+    if (n > t->cap)
+    {
+        long long cap = t->cap ? t->cap : 16;
+        while (cap < n)
+            cap *= 2;
+        t->fim = bytes_realloc(t->fim, (size_t)cap * sizeof(long long));
+        t->cap = cap;
+    }
+    if (bytes > t->cap_bytes || !t->bytes)
+    {
+        long long cap = t->cap_bytes ? t->cap_bytes : 256;
+        while (cap < bytes)
+            cap *= 2;
+        t->bytes = bytes_realloc(t->bytes, (size_t)cap);
+        t->cap_bytes = cap;
+    }
+    return t;
+}
+
+BsTextos *bs_textos_push(BsTextos *t, const char *s, long long n)
+{
+    long long usados = t && t->len > 0 ? t->fim[t->len - 1] : 0;
+    if (!t || t->len == t->cap || usados + n > t->cap_bytes)
+    {
+        // xs.push(xs[i]): the source lives in the pool that is about to move
+        long long dentro = t && t->bytes && s >= t->bytes && s < t->bytes + usados ? s - t->bytes : -1;
+        t = bs_textos_reservar(t, t ? t->len + 1 : 1, usados + n);
+        if (dentro >= 0)
+            s = t->bytes + dentro;
+    }
+    if (n > 0)
+        memcpy(t->bytes + usados, s, (size_t)n);
+    t->fim[t->len++] = usados + n;
+    return t;
+}
+
+BsTextos *bs_textos_de(char **arr)
+{
+    long long bytes = 0;
+    for (long long i = 0; i < arrlen(arr); i++)
+        bytes += arr[i] ? (long long)sdslen(arr[i]) : 0;
+    BsTextos *t = bs_textos_reservar(NULL, arrlen(arr), bytes);
+    for (long long i = 0; i < arrlen(arr); i++)
+        t = bs_textos_push_texto(t, arr[i]);
+    return t;
+}
+
+BsTextos *bs_textos_copiar(const BsTextos *t)
+{
+    long long n = bs_textos_len(t);
+    long long bytes = n > 0 ? t->fim[n - 1] : 0;
+    BsTextos *c = bs_textos_reservar(NULL, n, bytes);
+    if (n > 0)
+    {
+        memcpy(c->bytes, t->bytes, (size_t)bytes);
+        memcpy(c->fim, t->fim, (size_t)n * sizeof(long long));
+    }
+    c->len = n;
+    return c;
+}
+
+char **bs_textos_para_array(const BsTextos *t)
+{
+    char **arr = NULL;
+    long long n = bs_textos_len(t);
+    arrsetcap(arr, n);
+    for (long long i = 0; i < n; i++)
+    {
+        BsFatiaTexto v = bs_textos_em(t, i);
+        arrput(arr, sdsnewlen(v.dados, (size_t)v.len));
+    }
+    return arr;
+}
+
+BsFatiaTexto bs_textos_pop(BsTextos *t)
+{
+    if (bs_textos_len(t) == 0)
+    {
+        fprintf(stderr, "[Basalto] Erro: pop em '[texto; compacto]' vazio.\n");
+        exit(1);
+    }
+    BsFatiaTexto v = bs_textos_em(t, t->len - 1);
+    t->len--;
+    return v;
+}
+
+sds textos_to_string(const BsTextos *t)
+{
+    sds result = sdsnew("[");
+    for (long long i = 0; i < bs_textos_len(t); i++)
+    {
+        BsFatiaTexto v = bs_textos_em(t, i);
+        if (i > 0)
+            result = sdscat(result, ", ");
+        result = sdscat(result, "\"");
+        result = sdscatlen(result, v.dados, (size_t)v.len);
+        result = sdscat(result, "\"");
+    }
+    result = sdscat(result, "]");
+    return result;
+}
+
+// --- STRING BUILDERS ---
+
+BsConstrutor *bs_construtor_reservar(BsConstrutor *c, long long n)
+{
+    if (!c)
+    {
+        c = STBDS_REALLOC(NULL, NULL, sizeof(BsConstrutor));
+        if (!c)
+        {
+            fprintf(stderr, "[Basalto] Out of memory!\n");
+            exit(1);
+        }
+        memset(c, 0, sizeof(BsConstrutor));
+    }
+    if (n > c->cap)
+    {
+        c->dados = bytes_realloc(c->dados, (size_t)n);
+        c->cap = n;
+    }
+    return c;
+}
+
+BsConstrutor *bs_construtor_crescer(BsConstrutor *c, long long n)
+{
+    long long usados = c ? c->len : 0;
+    long long cap = c && c->cap ? c->cap : 64;
+    while (cap < usados + n)
+        cap *= 2;
+    return bs_construtor_reservar(c, cap);
+}
+
+BsConstrutor *bs_construtor_de(BsFatiaTexto v)
+{
+    BsConstrutor *c = bs_construtor_crescer(NULL, v.len * 2);
+    return bs_construtor_anexar(c, v.dados, v.len);
+}
+
+sds bs_construtor_texto(const BsConstrutor *c)
+{
+    return c && c->len > 0 ? sdsnewlen(c->dados, (size_t)c->len) : sdsempty();
+}
+
+void bs_construtor_liberar(BsConstrutor *c)
+{
+    if (!c)
+        return;
+#ifdef BASALTO_GC
+    bs_gc_free(c->dados);
+#else
+    free(c->dados);
+#endif
+    STBDS_FREE(NULL, c);
+}
+
+// Numbers are formatted straight into the free tail (see NUMBER FORMATTING)
+BsConstrutor *bs_construtor_anexar_inteiro(BsConstrutor *c, long long x)
+{
+    if (!c || c->cap - c->len < 21)
+        c = bs_construtor_crescer(c, 21);
+    c->len += bs_formatar_inteiro(c->dados + c->len, x);
+    return c;
+}
+
+BsConstrutor *bs_construtor_anexar_natural(BsConstrutor *c, unsigned long long x)
+{
+    if (!c || c->cap - c->len < 21)
+        c = bs_construtor_crescer(c, 21);
+    c->len += bs_formatar_natural(c->dados + c->len, x);
+    return c;
+}
+
+BsConstrutor *bs_construtor_anexar_real(BsConstrutor *c, double x)
+{
+    char buf[BS_NUMERO_MAX];
+    int n = bs_formatar_real(buf, x);
+    return bs_construtor_anexar(c, buf, n);
+}
+
+// printf straight into the free tail, growing once if it does not fit
+static BsConstrutor *construtor_printf(BsConstrutor *c, const char *fmt, ...)
+{
+    if (!c || c->cap - c->len < 32)
+        c = bs_construtor_crescer(c, 32);
+    for (;;)
+    {
+        long long livre = c->cap - c->len;
+        va_list args;
+        va_start(args, fmt);
+        int n = vsnprintf(c->dados + c->len, (size_t)livre, fmt, args);
+        va_end(args);
+        if (n < livre)
+        {
+            c->len += n;
+            return c;
+        }
+        c = bs_construtor_crescer(c, n + 1);
+    }
+}
+
+BsConstrutor *bs_construtor_anexar_real_ext(BsConstrutor *c, long double x) { return construtor_printf(c, "%Lf", x); }
+
+// --- STRING TO PRIMITIVE ---
+// Hand-rolled decimal parsing on views (no NUL terminator, no copy). Leading
+// and trailing whitespace is skipped. The outcome of the last conversion is
+// left in bs_erro_conversao (BS_CONVERSAO_*): on invalid input the value is
+// the parsed prefix (as atoi did), on overflow the nearest representable one.
+
+int bs_erro_conversao = BS_CONVERSAO_OK;
+
+static inline int e_espaco(char c)
+{
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+static inline int e_digito(char c)
+{
+    return (unsigned char)(c - '0') < 10;
+}
+
+// SWAR: are the 8 bytes in 'v' all ASCII digits?
+static inline int oito_digitos(uint64_t v)
+{
+    return (((v & 0xF0F0F0F0F0F0F0F0ull) | (((v + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) ==
+            0x3333333333333333ull);
+}
+
+// SWAR: value of 8 ASCII digits (little-endian load), three multiplies
+static inline uint32_t valor_oito_digitos(uint64_t v)
+{
+    v -= 0x3030303030303030ull;
+    v = (v * 10) + (v >> 8);
+    v = (((v & 0x000000FF000000FFull) * (100 + (1000000ull << 32))) +
+         (((v >> 16) & 0x000000FF000000FFull) * (1 + (10000ull << 32)))) >> 32;
+    return (uint32_t)v;
+}
+
+// Accumulates the digits at *p into *x (8 at a time while it can); returns
+// how many were read. *estouro is set once *x no longer fits 64 bits.
+static long long ler_digitos(const char **p, const char *fim, unsigned long long *x, int *estouro)
+{
+    const char *inicio = *p;
+    const char *q = *p;
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    while (fim - q >= 8)
+    {
+        uint64_t v;
+        memcpy(&v, q, 8);
+        if (!oito_digitos(v))
+            break;
+        uint32_t d = valor_oito_digitos(v);
+        if (*x > (ULLONG_MAX - d) / 100000000ull)
+            *estouro = 1;
+        else
+            *x = *x * 100000000ull + d;
+        q += 8;
+    }
+#endif
+    while (q < fim && e_digito(*q))
+    {
+        unsigned d = (unsigned)(*q - '0');
+        if (*x > (ULLONG_MAX - d) / 10)
+            *estouro = 1;
+        else
+            *x = *x * 10 + d;
+        q++;
+    }
+    *p = q;
+    return q - inicio;
+}
+
+long long bs_texto_para_inteiro(BsFatiaTexto v, long long min, long long max)
+{
+    const char *p = v.dados;
+    const char *fim = v.dados + v.len;
+    while (p < fim && e_espaco(*p))
+        p++;
+    int negativo = 0;
+    if (p < fim && (*p == '-' || *p == '+'))
+        negativo = *p++ == '-';
+
+    unsigned long long x = 0;
+    int estouro = 0;
+    long long digitos = ler_digitos(&p, fim, &x, &estouro);
+    while (p < fim && e_espaco(*p))
+        p++;
+    bs_erro_conversao = (digitos == 0 || p != fim) ? BS_CONVERSAO_INVALIDO : BS_CONVERSAO_OK;
+
+    // Range check in unsigned: |min| does not fit a long long when min is INT64_MIN
+    unsigned long long limite = negativo ? (unsigned long long)(-(min + 1)) + 1 : (unsigned long long)max;
+    if (estouro || x > limite)
+    {
+        bs_erro_conversao = BS_CONVERSAO_ESTOURO;
+        return negativo ? min : max;
+    }
+    return negativo ? (long long)(0ull - x) : (long long)x;
+}
+
+// A plain decimal [sign] digits [. digits] [e [sign] digits] read into an integer
+// mantissa and a power of ten. 'exato' is 0 once the mantissa overflows 64 bits.
+typedef struct
+{
+    unsigned long long mantissa;
+    long long expoente;
+    int negativo;
+    int exato;
+} Decimal;
+
+static int ler_decimal(const char *p, const char *fim, Decimal *d)
+{
+    d->mantissa = 0;
+    d->expoente = 0;
+    d->negativo = 0;
+    d->exato = 1;
+    if (p < fim && (*p == '-' || *p == '+'))
+        d->negativo = *p++ == '-';
+
+    int estouro = 0;
+    long long inteiros = ler_digitos(&p, fim, &d->mantissa, &estouro);
+    long long fracao = 0;
+    if (p < fim && *p == '.')
+    {
+        p++;
+        fracao = ler_digitos(&p, fim, &d->mantissa, &estouro);
+    }
+    if (inteiros + fracao == 0)
+        return 0;
+    d->expoente = -fracao;
+    if (p < fim && (*p == 'e' || *p == 'E'))
+    {
+        p++;
+        int negativo = 0;
+        if (p < fim && (*p == '-' || *p == '+'))
+            negativo = *p++ == '-';
+        unsigned long long e = 0;
+        int grande = 0;
+        if (ler_digitos(&p, fim, &e, &grande) == 0)
+            return 0;
+        if (grande || e > 100000)
+            d->exato = 0;
+        else
+            d->expoente += negativo ? -(long long)e : (long long)e;
+    }
+    if (estouro)
+        d->exato = 0;
+    return p == fim;
+}
+
+static const double potencias_dez[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                       1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+// Everything off the fast path: strtod/strtold on a NUL-terminated copy
+static long double real_lento(const char *p, long long n, int estendido)
+{
+    char pilha[128];
+    char *buf = n < (long long)sizeof(pilha) ? pilha : malloc((size_t)n + 1);
+    memcpy(buf, p, (size_t)n);
+    buf[n] = '\0';
+    char *fim;
+    errno = 0;
+    long double r = estendido ? strtold(buf, &fim) : (long double)strtod(buf, &fim);
+    if (fim == buf || *fim != '\0')
+        bs_erro_conversao = BS_CONVERSAO_INVALIDO;
+    else if (errno == ERANGE && isinf(r))
+        bs_erro_conversao = BS_CONVERSAO_ESTOURO;
+    else
+        bs_erro_conversao = BS_CONVERSAO_OK;
+    if (buf != pilha)
+        free(buf);
+    return r;
+}
+
+static long double texto_para_real(BsFatiaTexto v, int estendido)
+{
+    const char *p = v.dados;
+    const char *fim = v.dados + v.len;
+    while (p < fim && e_espaco(*p))
+        p++;
+    while (fim > p && e_espaco(fim[-1]))
+        fim--;
+
+    // Clinger's fast path: a mantissa below 2^53 times an exact power of ten
+    // (<= 10^22) is one correctly rounded multiply or divide
+    Decimal d;
+    if (!estendido && ler_decimal(p, fim, &d) && d.exato && d.mantissa <= (1ull << 53) &&
+        d.expoente >= -22 && d.expoente <= 22)
+    {
+        double m = (double)d.mantissa;
+        double r = d.expoente < 0 ? m / potencias_dez[-d.expoente] : m * potencias_dez[d.expoente];
+        bs_erro_conversao = BS_CONVERSAO_OK;
+        return d.negativo ? -r : r;
+    }
+    return real_lento(p, fim - p, estendido);
+}
+
+double bs_texto_para_real(BsFatiaTexto v) { return (double)texto_para_real(v, 0); }
+long double bs_texto_para_real_ext(BsFatiaTexto v) { return texto_para_real(v, 1); }
+
+float bs_texto_real32(BsFatiaTexto v)
+{
+    double r = bs_texto_para_real(v);
+    if (bs_erro_conversao == BS_CONVERSAO_OK && isfinite(r) && fabs(r) > FLT_MAX)
+        bs_erro_conversao = BS_CONVERSAO_ESTOURO;
+    return (float)r;
+}
+
+// C strings (FFI and older generated code)
+static BsFatiaTexto fatia_c(const char *s)
+{
+    BsFatiaTexto v = { s ? s : "", s ? (long long)strlen(s) : 0 };
+    return v;
+}
+
+signed char string_to_int8(char *s) { return bs_texto_inteiro8(fatia_c(s)); }
+short string_to_int16(char *s) { return bs_texto_inteiro16(fatia_c(s)); }
+int string_to_int32(char *s) { return bs_texto_inteiro32(fatia_c(s)); }
+long long string_to_int64(char *s) { return bs_texto_inteiro64(fatia_c(s)); }
+long string_to_int_arq(char *s) { return bs_texto_inteiro_arq(fatia_c(s)); }
+float string_to_real32(char *s) { return bs_texto_real32(fatia_c(s)); }
+double string_to_real64(char *s) { return bs_texto_para_real(fatia_c(s)); }
+long double string_to_real_ext(char *s) { return bs_texto_para_real_ext(fatia_c(s)); }
+
+// --- BULK PARSING ---
+// One call per buffer or array; bs_erro_conversao keeps the first error.
+
+static long long inteiro64_de(BsFatiaTexto v) { return bs_texto_para_inteiro(v, INT64_MIN, INT64_MAX); }
+
+// Next piece of 'v' up to 'sep' (a trailing empty piece, as after a final newline, is not one)
+static int proxima_peca(BsFatiaTexto *v, BsFatiaTexto sep, BsFatiaTexto *peca)
+{
+    if (v->len == 0)
+        return 0;
+    long long i = sep.len ? bs_texto_encontrar(*v, sep) : -1;
+    *peca = i < 0 ? *v : bs_texto_sub(*v, 0, i);
+    *v = i < 0 ? bs_texto_sub(*v, v->len, v->len) : bs_texto_sub(*v, i + sep.len, v->len);
+    return 1;
+}
+
+// Parses every element into a new stb_ds array of 'tipo'
+#define ANALISAR_TODOS(nome, tipo, param, n, elemento, converter) \
+    tipo *nome(param) \
+    { \
+        tipo *r = NULL; \
+        int erro = BS_CONVERSAO_OK; \
+        arrsetlen(r, (n)); \
+        for (long long i = 0; i < (long long)(n); i++) \
+        { \
+            r[i] = converter(elemento); \
+            if (erro == BS_CONVERSAO_OK) \
+                erro = bs_erro_conversao; \
+        } \
+        bs_erro_conversao = erro; \
+        return r; \
+    }
+
+ANALISAR_TODOS(bs_array_texto_inteiros, long long, char **xs, arrlen(xs), bs_fatia_texto_de(xs[i]), inteiro64_de)
+ANALISAR_TODOS(bs_array_texto_reais, double, char **xs, arrlen(xs), bs_fatia_texto_de(xs[i]), bs_texto_para_real)
+ANALISAR_TODOS(bs_array_fatia_texto_inteiros, long long, BsFatiaTexto *xs, arrlen(xs), xs[i], inteiro64_de)
+ANALISAR_TODOS(bs_array_fatia_texto_reais, double, BsFatiaTexto *xs, arrlen(xs), xs[i], bs_texto_para_real)
+ANALISAR_TODOS(bs_textos_inteiros, long long, const BsTextos *t, bs_textos_len(t), bs_textos_em(t, i), inteiro64_de)
+ANALISAR_TODOS(bs_textos_reais, double, const BsTextos *t, bs_textos_len(t), bs_textos_em(t, i), bs_texto_para_real)
+
+long long *bs_texto_inteiros(BsFatiaTexto v, BsFatiaTexto sep)
+{
+    long long *r = NULL;
+    int erro = BS_CONVERSAO_OK;
+    BsFatiaTexto peca;
+    while (proxima_peca(&v, sep, &peca))
+    {
+        arrput(r, inteiro64_de(peca));
+        if (erro == BS_CONVERSAO_OK)
+            erro = bs_erro_conversao;
+    }
+    bs_erro_conversao = erro;
+    return r;
+}
+
+double *bs_texto_reais(BsFatiaTexto v, BsFatiaTexto sep)
+{
+    double *r = NULL;
+    int erro = BS_CONVERSAO_OK;
+    BsFatiaTexto peca;
+    while (proxima_peca(&v, sep, &peca))
+    {
+        arrput(r, bs_texto_para_real(peca));
+        if (erro == BS_CONVERSAO_OK)
+            erro = bs_erro_conversao;
+    }
+    bs_erro_conversao = erro;
+    return r;
+}
+
+// --- INPUT HELPERS ---
+// ler() reads stdin through one 64 KiB block buffer filled with read(2):
+// tokens and lines are parsed straight out of it, and the unread tail moves
+// to the front before each refill so a token never straddles two reads.
+// stdout is flushed before blocking, so prompts without '\n' still show up.
+
+#define ENTRADA_BLOCO (1 << 16)
+
+static char entrada[ENTRADA_BLOCO];
+static size_t entrada_inicio = 0; // Next unread byte
+static size_t entrada_fim = 0;    // End of the buffered bytes
+static int entrada_eof = 0;
+
+// Reads more input behind the unread bytes; 0 at EOF (or when the buffer is full)
+static int entrada_encher(void)
+{
+    if (entrada_eof)
+        return 0;
+    if (entrada_inicio > 0)
+    {
+        memmove(entrada, entrada + entrada_inicio, entrada_fim - entrada_inicio);
+        entrada_fim -= entrada_inicio;
+        entrada_inicio = 0;
+    }
+    if (entrada_fim == sizeof(entrada))
+        return 0;
+    fflush(stdout);
+    ssize_t n;
+    do
+        n = read(STDIN_FILENO, entrada + entrada_fim, sizeof(entrada) - entrada_fim);
+    while (n < 0 && errno == EINTR);
+    if (n <= 0)
+    {
+        entrada_eof = 1;
+        return 0;
+    }
+    entrada_fim += (size_t)n;
+    return 1;
+}
+
+// Next whitespace-separated token, as a view valid until the next read (empty at EOF)
+static BsFatiaTexto entrada_token(void)
+{
+    for (;;)
+    {
+        while (entrada_inicio < entrada_fim && e_espaco(entrada[entrada_inicio]))
+            entrada_inicio++;
+        if (entrada_inicio < entrada_fim || !entrada_encher())
+            break;
+    }
+    size_t i = entrada_inicio;
+    for (;;)
+    {
+        while (i < entrada_fim && !e_espaco(entrada[i]))
+            i++;
+        if (i < entrada_fim)
+            break;
+        size_t lidos = i - entrada_inicio;
+        if (!entrada_encher())
+            break;
+        i = entrada_inicio + lidos;
+    }
+    BsFatiaTexto token = { entrada + entrada_inicio, (long long)(i - entrada_inicio) };
+    entrada_inicio = i;
+    return token;
+}
+
+// Next line without its '\n' appended to 's'; 0 at EOF with nothing read
+static int entrada_linha(sds *s)
+{
+    if (entrada_inicio == entrada_fim && !entrada_encher())
+        return 0;
+    for (;;)
+    {
+        char *nl = memchr(entrada + entrada_inicio, '\n', entrada_fim - entrada_inicio);
+        size_t fim = nl ? (size_t)(nl - entrada) : entrada_fim;
+        *s = sdscatlen(*s, entrada + entrada_inicio, fim - entrada_inicio);
+        entrada_inicio = fim;
+        if (nl)
+        {
+            entrada_inicio++;
+            return 1;
+        }
+        if (!entrada_encher())
+            return 1;
+    }
+}
+
+void flush_input()
+{
+    for (;;)
+    {
+        char *nl = memchr(entrada + entrada_inicio, '\n', entrada_fim - entrada_inicio);
+        if (nl)
+        {
+            entrada_inicio = (size_t)(nl - entrada) + 1;
+            return;
+        }
+        entrada_inicio = entrada_fim;
+        if (!entrada_encher())
+            return;
+    }
+}
+
+// A number per line, as with scanf + flush_input: the rest of the line is dropped
+int read_int()
+{
+    int x = bs_texto_inteiro32(entrada_token());
+    flush_input();
+    return x;
+}
+
+long long read_long()
+{
+    long long x = bs_texto_inteiro64(entrada_token());
+    flush_input();
+    return x;
+}
+
+float read_float()
+{
+    float x = bs_texto_real32(entrada_token());
+    flush_input();
+    return x;
+}
+
+double read_double()
+{
+    double x = bs_texto_para_real(entrada_token());
+    flush_input();
+    return x;
+}
+
+char *read_string()
+{
+    sds s = sdsempty();
+    entrada_linha(&s);
+    return s;
+}
+
+void wait_enter()
+{
+    flush_input();
+}
+
+// ler_inteiros(n) / ler_reais(n): the next n tokens (n < 0: up to EOF), fewer at EOF
+long long *bs_ler_inteiros(long long n)
+{
+    long long *r = NULL;
+    int erro = BS_CONVERSAO_OK;
+    if (n > 0)
+        arrsetcap(r, n);
+    for (long long i = 0; n < 0 || i < n; i++)
+    {
+        BsFatiaTexto token = entrada_token();
+        if (token.len == 0)
+            break;
+        arrput(r, bs_texto_inteiro64(token));
+        if (erro == BS_CONVERSAO_OK)
+            erro = bs_erro_conversao;
+    }
+    bs_erro_conversao = erro;
+    return r;
+}
+
+double *bs_ler_reais(long long n)
+{
+    double *r = NULL;
+    int erro = BS_CONVERSAO_OK;
+    if (n > 0)
+        arrsetcap(r, n);
+    for (long long i = 0; n < 0 || i < n; i++)
+    {
+        BsFatiaTexto token = entrada_token();
+        if (token.len == 0)
+            break;
+        arrput(r, bs_texto_para_real(token));
+        if (erro == BS_CONVERSAO_OK)
+            erro = bs_erro_conversao;
+    }
+    bs_erro_conversao = erro;
+    return r;
+}
+
+// ler_linhas(): every remaining line
+char **bs_ler_linhas(void)
+{
+    char **linhas = NULL;
+    for (;;)
+    {
+        sds s = sdsempty();
+        if (!entrada_linha(&s))
+        {
+            sdsfree(s);
+            return linhas;
+        }
+        arrput(linhas, s);
+    }
+}
 
 // --- MATH IMPLEMENTATION ---
 double bs_sin(double x) { return sin(x); }
@@ -0,0 +1,366 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <time.h>
+
+#include "basalto.h"
+
+// --- TRACING GARBAGE COLLECTOR (--gc) ---
+// Mark-sweep collector used when a program is compiled with `basalto --gc`.
+// - 'nova' objects carry a layout emitted by codegen, so only their pointer
+//   fields (structs, arrays, texto) are traced.
+// - stb_ds buffers are scanned conservatively (element types are unknown here).
+// - sds buffers are leaves: they never hold pointers.
+// - Roots come from a conservative scan of the C stack and the registers.
+
+typedef struct GcObject
+{
+    struct GcObject *next;
+    struct GcObject *prev;
+    const BsGcLayout *layout; // NULL = scan every word, &bs_gc_leaf = never scan
+    size_t size;
+    void *block; // Start of the underlying allocation (differs for over-aligned objects)
+    int marked;
+} GcObject;
+
+// Payloads keep malloc's alignment guarantees
+#define GC_HEADER_SIZE ((sizeof(GcObject) + 15) & ~(size_t)15)
+#define GC_PAYLOAD(obj) ((void *)((char *)(obj) + GC_HEADER_SIZE))
+#define GC_OBJECT(ptr) ((GcObject *)((char *)(ptr) - GC_HEADER_SIZE))
+
+const BsGcLayout bs_gc_leaf = {"leaf", 0, NULL};
+
+static GcObject *gc_objects = NULL;
+static void *gc_stack_bottom = NULL;
+static void *gc_pinned = NULL; // Buffer being resized, kept alive during a collection
+
+// Heap accounting & triggers
+static size_t gc_live_bytes = 0;       // Bytes owned by the collector right now
+static size_t gc_since_collect = 0;    // Bytes allocated since the last cycle
+static size_t gc_threshold = 0;        // Next cycle starts past this many new bytes
+static size_t gc_heap_min = 8u << 20;  // BASALTO_GC_HEAP_MIN (bytes)
+static size_t gc_growth = 100;         // BASALTO_GC_GROWTH (% of live heap)
+
+// Pause-time statistics (BASALTO_GC_STATS=1 prints them at exit)
+static size_t gc_cycles = 0;
+static size_t gc_freed_bytes = 0;
+static double gc_pause_total_ms = 0.0;
+static double gc_pause_max_ms = 0.0;
+
+// Sorted view of the heap, rebuilt at each cycle to resolve interior pointers
+static GcObject **gc_index = NULL;
+static size_t gc_index_len = 0;
+
+// Explicit mark stack (avoids recursion on long linked lists)
+static GcObject **gc_mark_stack = NULL;
+static size_t gc_mark_len = 0;
+static size_t gc_mark_cap = 0;
+
+static void gc_report(void)
+{
+    fprintf(stderr, "[Basalto GC] ciclos: %zu | pausa total: %.3f ms | pausa max: %.3f ms | vivo: %zu bytes | liberado: %zu bytes\n",
+            gc_cycles, gc_pause_total_ms, gc_pause_max_ms, gc_live_bytes, gc_freed_bytes);
+}
+
+static size_t gc_env_size(const char *name, size_t fallback)
+{
+    const char *value = getenv(name);
+    if (!value || !*value)
+        return fallback;
+    return (size_t)strtoull(value, NULL, 10);
+}
+
+void bs_gc_init(void *stack_bottom)
+{
+    gc_stack_bottom = stack_bottom;
+    gc_heap_min = gc_env_size("BASALTO_GC_HEAP_MIN", gc_heap_min);
+    gc_growth = gc_env_size("BASALTO_GC_GROWTH", gc_growth);
+    gc_threshold = gc_heap_min;
+
+    const char *stats = getenv("BASALTO_GC_STATS");
+    if (stats && *stats && strcmp(stats, "0") != 0)
+        atexit(gc_report);
+}
+
+// --- MARK PHASE ---
+
+static int gc_compare_objects(const void *a, const void *b)
+{
+    uintptr_t x = (uintptr_t) * (GcObject *const *)a;
+    uintptr_t y = (uintptr_t) * (GcObject *const *)b;
+    return (x > y) - (x < y);
+}
+
+static void gc_build_index(void)
+{
+    size_t count = 0;
+    for (GcObject *obj = gc_objects; obj; obj = obj->next)
+        count++;
+
+    free(gc_index);
+    gc_index = malloc(count * sizeof(GcObject *) + 1);
+    if (!gc_index)
+    {
+        fprintf(stderr, "[Basalto] Out of memory (gc index)!\n");
+        exit(1);
+    }
+    gc_index_len = 0;
+    for (GcObject *obj = gc_objects; obj; obj = obj->next)
+        gc_index[gc_index_len++] = obj;
+    qsort(gc_index, gc_index_len, sizeof(GcObject *), gc_compare_objects);
+}
+
+// Find the object whose payload contains 'ptr' (interior pointers included)
+static GcObject *gc_find(const void *ptr)
+{
+    uintptr_t p = (uintptr_t)ptr;
+    size_t lo = 0, hi = gc_index_len;
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        if ((uintptr_t)GC_PAYLOAD(gc_index[mid]) <= p)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (lo == 0)
+        return NULL;
+
+    GcObject *obj = gc_index[lo - 1];
+    uintptr_t start = (uintptr_t)GC_PAYLOAD(obj);
+    if (p < start + obj->size)
+        return obj;
+    return NULL;
+}
+
+static void gc_mark_value(const void *ptr)
+{
+    if (!ptr)
+        return;
+    GcObject *obj = gc_find(ptr);
+    if (!obj || obj->marked)
+        return;
+
+    obj->marked = 1;
+    if (obj->layout == &bs_gc_leaf)
+        return;
+
+    if (gc_mark_len == gc_mark_cap)
+    {
+        gc_mark_cap = gc_mark_cap ? gc_mark_cap * 2 : 256;
+        gc_mark_stack = realloc(gc_mark_stack, gc_mark_cap * sizeof(GcObject *));
+        if (!gc_mark_stack)
+        {
+            fprintf(stderr, "[Basalto] Out of memory (gc mark stack)!\n");
+            exit(1);
+        }
+    }
+    gc_mark_stack[gc_mark_len++] = obj;
+}
+
+static void gc_scan_range(const void *from, const void *to)
+{
+    uintptr_t lo = (uintptr_t)from & ~(uintptr_t)(sizeof(void *) - 1);
+    for (uintptr_t p = lo; p + sizeof(void *) <= (uintptr_t)to; p += sizeof(void *))
+        gc_mark_value(*(void **)p);
+}
+
+static void gc_drain(void)
+{
+    while (gc_mark_len > 0)
+    {
+        GcObject *obj = gc_mark_stack[--gc_mark_len];
+        char *payload = GC_PAYLOAD(obj);
+
+        if (obj->layout)
+        {
+            // Precise: only the pointer fields known by the compiler
+            for (size_t i = 0; i < obj->layout->count; i++)
+                gc_mark_value(*(void **)(payload + obj->layout->offsets[i]));
+        }
+        else
+        {
+            gc_scan_range(payload, payload + obj->size);
+        }
+    }
+}
+
+static void __attribute__((noinline)) gc_mark_roots(void)
+{
+    // Spill callee-saved registers onto the stack so the scan sees them
+    jmp_buf regs;
+    setjmp(regs);
+
+    volatile char marker = 0;
+    const void *top = (const void *)&marker;
+    if ((uintptr_t)top < (uintptr_t)gc_stack_bottom)
+        gc_scan_range(top, gc_stack_bottom);
+    else
+        gc_scan_range(gc_stack_bottom, top);
+    gc_scan_range(&regs, (char *)&regs + sizeof(regs));
+
+    gc_mark_value(gc_pinned);
+    gc_drain();
+}
+
+// --- SWEEP PHASE ---
+
+static void gc_unlink(GcObject *obj)
+{
+    if (obj->prev)
+        obj->prev->next = obj->next;
+    else
+        gc_objects = obj->next;
+    if (obj->next)
+        obj->next->prev = obj->prev;
+    gc_live_bytes -= obj->size;
+}
+
+static void gc_sweep(void)
+{
+    GcObject *obj = gc_objects;
+    while (obj)
+    {
+        GcObject *next = obj->next;
+        if (obj->marked)
+        {
+            obj->marked = 0;
+        }
+        else
+        {
+            gc_unlink(obj);
+            gc_freed_bytes += obj->size;
+            free(obj->block);
+        }
+        obj = next;
+    }
+}
+
+void bs_gc_collect(void)
+{
+    if (!gc_stack_bottom)
+        return; // bs_gc_init not called (library mode): nothing is safe to free
+
+    clock_t start = clock();
+
+    gc_build_index();
+    gc_mark_roots();
+    gc_sweep();
+
+    free(gc_index);
+    gc_index = NULL;
+    gc_index_len = 0;
+
+    // Next trigger grows with the surviving heap
+    size_t next = gc_live_bytes / 100 * gc_growth;
+    gc_threshold = next > gc_heap_min ? next : gc_heap_min;
+    gc_since_collect = 0;
+
+    double pause_ms = (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+    gc_cycles++;
+    gc_pause_total_ms += pause_ms;
+    if (pause_ms > gc_pause_max_ms)
+        gc_pause_max_ms = pause_ms;
+}
+
+// --- ALLOCATION ---
+
+static void gc_maybe_collect(size_t size)
+{
+    if (gc_since_collect + size > gc_threshold)
+        bs_gc_collect();
+}
+
+static GcObject *gc_new_object(size_t size, const BsGcLayout *layout, size_t align)
+{
+    void *block;
+    GcObject *obj;
+    if (align <= 16)
+    {
+        block = calloc(1, GC_HEADER_SIZE + size);
+        obj = block;
+    }
+    else
+    {
+        // @alinhado(n): pad in front of the header so the payload lands on 'align'
+        size_t front = (GC_HEADER_SIZE + align - 1) / align * align;
+        size_t total = (front + size + align - 1) / align * align;
+        block = aligned_alloc(align, total);
+        if (block)
+            memset(block, 0, total);
+        obj = (GcObject *)((char *)block + front - GC_HEADER_SIZE);
+    }
+    if (!block)
+    {
+        fprintf(stderr, "[Basalto] Out of memory!\n");
+        exit(1);
+    }
+    obj->block = block;
+    obj->layout = layout;
+    obj->size = size;
+    obj->next = gc_objects;
+    if (gc_objects)
+        gc_objects->prev = obj;
+    gc_objects = obj;
+
+    gc_live_bytes += size;
+    gc_since_collect += size;
+    return obj;
+}
+
+void *bs_gc_alloc(size_t size, const BsGcLayout *layout)
+{
+    gc_maybe_collect(size);
+    return GC_PAYLOAD(gc_new_object(size, layout, 16));
+}
+
+// 'nova' of an @alinhado(n) struct with n > 16
+void *bs_gc_alloc_aligned(size_t size, size_t align, const BsGcLayout *layout)
+{
+    gc_maybe_collect(size);
+    return GC_PAYLOAD(gc_new_object(size, layout, align));
+}
+
+static void *gc_resize(void *ptr, size_t size, const BsGcLayout *layout)
+{
+    if (!ptr)
+        return bs_gc_alloc(size, layout);
+
+    gc_pinned = ptr;
+    gc_maybe_collect(size);
+    gc_pinned = NULL;
+
+    GcObject *old = GC_OBJECT(ptr);
+    void *fresh = GC_PAYLOAD(gc_new_object(size, old->layout, 16));
+    memcpy(fresh, ptr, old->size < size ? old->size : size);
+    bs_gc_free(ptr);
+    return fresh;
+}
+
+// stb_ds buffers: traced conservatively
+void *bs_gc_realloc(void *ptr, size_t size)
+{
+    return gc_resize(ptr, size, NULL);
+}
+
+// sds buffers: never contain pointers
+void *bs_gc_malloc_leaf(size_t size)
+{
+    return bs_gc_alloc(size, &bs_gc_leaf);
+}
+
+void *bs_gc_realloc_leaf(void *ptr, size_t size)
+{
+    return gc_resize(ptr, size, &bs_gc_leaf);
+}
+
+void bs_gc_free(void *ptr)
+{
+    if (!ptr)
+        return;
+    GcObject *obj = GC_OBJECT(ptr);
+    gc_unlink(obj);
+    free(obj->block);
+}
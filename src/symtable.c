@@ -22,7 +22,8 @@ void scope_exit(void) {
 void scope_bind(const char* name, const char* type) {
     if (arrlen(scope_stack) == 0) scope_enter(); // Safety for globals
     SymbolEntry **top = &arrlast(scope_stack);
-    shput(*top, name, type);
+    // Copy: callers often pass temporary buffers ("Player*" built on the stack)
+    shput(*top, name, type ? sdsnew(type) : NULL);
 }
 
 char* scope_lookup(const char* name) {
@@ -112,3 +113,26 @@ int is_struct_type(const char* type_name) {
     return (shget(type_registry, type_name) != NULL);
 }
 
+// --- PART 3: STRUCT FLAGS (Kinds & Attributes) ---
+
+StructFlagEntry *struct_flags = NULL; // Global Hash Map: struct_name -> STRUCT_FLAG_* bits
+
+void set_struct_flag(const char* struct_name, int flag) {
+    int current = shget(struct_flags, struct_name);
+    shput(struct_flags, struct_name, current | flag);
+}
+
+int has_struct_flag(const char* struct_name, int flag) {
+    if (!struct_name) return 0;
+    return (shget(struct_flags, struct_name) & flag) != 0;
+}
+
+// Helper: Check if a type string refers to a value struct (estrutura valor)
+int is_value_struct(const char* type_name) {
+    return is_struct_type(type_name) && has_struct_flag(type_name, STRUCT_FLAG_VALUE);
+}
+
+// Helper: Check if a type string refers to a @soa struct
+int is_soa_struct(const char* type_name) {
+    return is_struct_type(type_name) && has_struct_flag(type_name, STRUCT_FLAG_SOA);
+}
@@ -47,5 +47,29 @@ int get_array_depth(const char* type);
 // Helper: Check if a type string refers to a Struct
 int is_struct_type(const char* type_name);
 
+// --- PART 3: STRUCT FLAGS (Kinds & Attributes) ---
+
+// Bit flags attached to a struct name
+#define STRUCT_FLAG_VALUE 0x1 // estrutura valor: copied by value, stored inline
+#define STRUCT_FLAG_SOA 0x2 // @soa: [T] arrays store one column per field
+#define STRUCT_FLAG_FIXED_ORDER 0x4 // @ordem_fixa: keep declaration order (FFI)
+#define STRUCT_FLAG_PACKED 0x8 // @compacto: no padding between fields
+
+typedef struct {
+    char *key;  // Struct Name ("Ponto")
+    int value;  // STRUCT_FLAG_* bits
+} StructFlagEntry;
+
+extern StructFlagEntry *struct_flags;
+
+void set_struct_flag(const char* struct_name, int flag);
+int has_struct_flag(const char* struct_name, int flag);
+
+// Helper: Check if a type string refers to a value struct (estrutura valor)
+int is_value_struct(const char* type_name);
+
+// Helper: Check if a type string refers to a @soa struct
+int is_soa_struct(const char* type_name);
+
 #endif
 